@@ -0,0 +1,137 @@
+#include "active_notification_set.hpp"
+
+
+ActiveNotificationSet::ActiveNotificationSet()
+    : m_acknowledgedCount(0)
+{
+}
+
+void ActiveNotificationSet::insert(const NotificationData &notification)
+{
+    remove(notification.id);
+
+    m_slotById.insert(notification.id, m_slots.size());
+    Slot slot;
+    slot.data = notification;
+    slot.live = true;
+    m_slots.append(std::move(slot));
+
+    if (notification.acknowledged) {
+        m_acknowledgedCount++;
+    } else if (!notification.sourceEventId.isEmpty()) {
+        m_unacknowledgedBySource[notification.sourceEventId]++;
+    }
+}
+
+bool ActiveNotificationSet::remove(const QString &id)
+{
+    auto it = m_slotById.find(id);
+    if (it == m_slotById.end()) return false;
+
+    Slot &slot = m_slots[it.value()];
+    if (slot.data.acknowledged) {
+        m_acknowledgedCount--;
+    } else {
+        releaseSource(slot.data.sourceEventId);
+    }
+    slot.live = false;
+    slot.data = NotificationData();
+    m_slotById.erase(it);
+
+    if (m_slots.size() > 2 * m_slotById.size() + 16) {
+        compact();
+    }
+    return true;
+}
+
+void ActiveNotificationSet::clear()
+{
+    m_slots.clear();
+    m_slotById.clear();
+    m_unacknowledgedBySource.clear();
+    m_acknowledgedCount = 0;
+}
+
+const NotificationData *ActiveNotificationSet::find(const QString &id) const
+{
+    auto it = m_slotById.constFind(id);
+    return it == m_slotById.constEnd() ? nullptr : &m_slots[it.value()].data;
+}
+
+bool ActiveNotificationSet::acknowledge(const QString &id)
+{
+    auto it = m_slotById.constFind(id);
+    if (it == m_slotById.constEnd()) return false;
+
+    Slot &slot = m_slots[it.value()];
+    if (slot.data.acknowledged) return false;
+    markAcknowledged(slot);
+    return true;
+}
+
+QStringList ActiveNotificationSet::acknowledgeAll()
+{
+    QStringList ids;
+    if (m_acknowledgedCount == size()) return ids;
+
+    for (Slot &slot : m_slots) {
+        if (slot.live && !slot.data.acknowledged) {
+            markAcknowledged(slot);
+            ids.append(slot.data.id);
+        }
+    }
+    return ids;
+}
+
+bool ActiveNotificationSet::hasUnacknowledged(const QString &sourceEventId) const
+{
+    return m_unacknowledgedBySource.contains(sourceEventId);
+}
+
+QVector<NotificationData> ActiveNotificationSet::toVector() const
+{
+    QVector<NotificationData> result;
+    result.reserve(size());
+    for (const Slot &slot : m_slots) {
+        if (slot.live) result.append(slot.data);
+    }
+    return result;
+}
+
+QVector<NotificationData> ActiveNotificationSet::unacknowledged() const
+{
+    QVector<NotificationData> result;
+    result.reserve(size() - m_acknowledgedCount);
+    for (const Slot &slot : m_slots) {
+        if (slot.live && !slot.data.acknowledged) result.append(slot.data);
+    }
+    return result;
+}
+
+void ActiveNotificationSet::markAcknowledged(Slot &slot)
+{
+    slot.data.acknowledged = true;
+    m_acknowledgedCount++;
+    releaseSource(slot.data.sourceEventId);
+}
+
+void ActiveNotificationSet::releaseSource(const QString &source)
+{
+    if (source.isEmpty()) return;
+    auto it = m_unacknowledgedBySource.find(source);
+    if (it != m_unacknowledgedBySource.end() && --it.value() == 0) {
+        m_unacknowledgedBySource.erase(it);
+    }
+}
+
+void ActiveNotificationSet::compact()
+{
+    int next = 0;
+    for (int i = 0; i < m_slots.size(); ++i) {
+        if (!m_slots[i].live) continue;
+        if (i != next) m_slots[next] = std::move(m_slots[i]);
+        m_slotById[m_slots[next].data.id] = next;
+        next++;
+    }
+    m_slots.resize(next);
+}
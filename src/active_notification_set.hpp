@@ -0,0 +1,55 @@
+#pragma once
+
+#include "notification_types.hpp"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+
+// Active notifications with O(1) lookup by id and O(1) "is there an
+// unacknowledged notification for this event" checks. Storage is a slot
+// vector in insertion order; removals leave a hole that is compacted once
+// holes outnumber live entries. Expiry is not tracked here; NotificationManager
+// schedules each notification's removal on its timing wheel.
+// Not thread-safe; NotificationManager guards it with its mutex.
+class ActiveNotificationSet
+{
+public:
+    ActiveNotificationSet();
+
+    // Replaces an existing notification with the same id
+    void insert(const NotificationData &notification);
+    bool remove(const QString &id);
+    void clear();
+
+    const NotificationData *find(const QString &id) const;
+
+    // Return true if the notification existed and was unacknowledged
+    bool acknowledge(const QString &id);
+    QStringList acknowledgeAll();
+
+    bool hasUnacknowledged(const QString &sourceEventId) const;
+    int size() const { return m_slotById.size(); }
+    int acknowledgedCount() const { return m_acknowledgedCount; }
+
+    // Live notifications in insertion order
+    QVector<NotificationData> toVector() const;
+    QVector<NotificationData> unacknowledged() const;
+
+private:
+    struct Slot {
+        NotificationData data;
+        bool live = false;
+    };
+
+    void markAcknowledged(Slot &slot);
+    void releaseSource(const QString &sourceEventId);
+    void compact();
+
+    QVector<Slot> m_slots;
+    QHash<QString, int> m_slotById;
+    QHash<QString, int> m_unacknowledgedBySource;
+    int m_acknowledgedCount;
+};
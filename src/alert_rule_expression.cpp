@@ -0,0 +1,758 @@
+#include "alert_rule_expression.hpp"
+#include "ground_motion.hpp"
+#include "spatial_utils.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+
+namespace {
+
+enum class Field {
+    Magnitude,
+    Depth,
+    Latitude,
+    Longitude,
+    AlertLevel,
+    Uncertainty,
+    Tsunami
+};
+
+enum class Function {
+    WithinRegion,
+    WithinRadius,
+    DistanceTo,
+    MmiAt,
+    Abs,
+    Min,
+    Max
+};
+
+enum class NodeKind {
+    Constant,
+    Field,
+    User,
+    Unary,
+    Binary,
+    And,
+    Or,
+    Call
+};
+
+struct Token {
+    enum Type { Number, Identifier, String, Symbol, End };
+    Type type;
+    QString text;
+    double number;
+    int position;
+};
+
+struct Node {
+    NodeKind kind;
+    AlertRuleExpression::OpCode op = AlertRuleExpression::OpCode::LoadConst;
+    double value = 0.0;
+    int index = 0; // Field or Function
+    QVector<int> children;
+    QVector<int> regions; // Region ids
+    int position = 0;
+};
+
+using OpCode = AlertRuleExpression::OpCode;
+
+double applyUnary(OpCode op, double x)
+{
+    switch (op) {
+        case OpCode::Neg: return -x;
+        case OpCode::Not: return x == 0.0 ? 1.0 : 0.0;
+        case OpCode::ToBool: return x != 0.0 ? 1.0 : 0.0;
+        case OpCode::Abs: return std::fabs(x);
+        default: return x;
+    }
+}
+
+double applyBinary(OpCode op, double x, double y)
+{
+    switch (op) {
+        case OpCode::Add: return x + y;
+        case OpCode::Sub: return x - y;
+        case OpCode::Mul: return x * y;
+        case OpCode::Div: return x / y;
+        case OpCode::Min: return qMin(x, y);
+        case OpCode::Max: return qMax(x, y);
+        case OpCode::Less: return x < y ? 1.0 : 0.0;
+        case OpCode::LessEqual: return x <= y ? 1.0 : 0.0;
+        case OpCode::Greater: return x > y ? 1.0 : 0.0;
+        case OpCode::GreaterEqual: return x >= y ? 1.0 : 0.0;
+        case OpCode::Equal: return x == y ? 1.0 : 0.0;
+        case OpCode::NotEqual: return x != y ? 1.0 : 0.0;
+        default: return 0.0;
+    }
+}
+
+} // namespace
+
+// Lexer, parser, constant folder and code generator for one expression
+class AlertRuleExpressionCompiler
+{
+public:
+    AlertRuleExpressionCompiler(const QString &source, const AlertRuleExpression::RegionResolver &resolveRegion)
+        : m_source(source)
+        , m_resolveRegion(resolveRegion)
+        , m_current(0)
+        , m_nextRegister(0)
+        , m_maxRegister(0)
+    {
+    }
+
+    AlertRuleExpression compile()
+    {
+        tokenize();
+
+        int root = parseOr();
+        if (peek().type != Token::End) {
+            fail("Unexpected '" + peek().text + "'", peek().position);
+        }
+        root = fold(root);
+
+        m_result.m_source = m_source;
+        m_nextRegister = 1;
+        m_maxRegister = 1;
+        generate(root, 0);
+        m_result.m_registerCount = m_maxRegister;
+        return m_result;
+    }
+
+private:
+    [[noreturn]] void fail(const QString &message, int position) const
+    {
+        throw std::runtime_error(QString("%1 at position %2 in alert expression \"%3\"")
+                                     .arg(message, QString::number(position), m_source).toStdString());
+    }
+
+    // Lexer
+
+    void tokenize()
+    {
+        const int length = m_source.size();
+        int pos = 0;
+        while (pos < length) {
+            const QChar c = m_source[pos];
+            if (c.isSpace()) {
+                ++pos;
+                continue;
+            }
+
+            Token token{Token::Symbol, QString(), 0.0, pos};
+            if (c.isDigit() || (c == '.' && pos + 1 < length && m_source[pos + 1].isDigit())) {
+                int end = pos;
+                while (end < length && (m_source[end].isDigit() || m_source[end] == '.')) ++end;
+                if (end < length && (m_source[end] == 'e' || m_source[end] == 'E')) {
+                    int exponent = end + 1;
+                    if (exponent < length && (m_source[exponent] == '+' || m_source[exponent] == '-')) ++exponent;
+                    if (exponent < length && m_source[exponent].isDigit()) {
+                        end = exponent;
+                        while (end < length && m_source[end].isDigit()) ++end;
+                    }
+                }
+                bool ok = false;
+                token.type = Token::Number;
+                token.text = m_source.mid(pos, end - pos);
+                token.number = token.text.toDouble(&ok);
+                if (!ok) fail("Invalid number '" + token.text + "'", pos);
+                pos = end;
+            } else if (c.isLetter() || c == '_') {
+                int end = pos;
+                while (end < length && (m_source[end].isLetterOrNumber() || m_source[end] == '_')) ++end;
+                token.type = Token::Identifier;
+                token.text = m_source.mid(pos, end - pos);
+                pos = end;
+            } else if (c == '"') {
+                int end = pos + 1;
+                while (end < length && m_source[end] != '"') {
+                    if (m_source[end] == '\\' && end + 1 < length) ++end;
+                    token.text.append(m_source[end]);
+                    ++end;
+                }
+                if (end >= length) fail("Unterminated string", pos);
+                token.type = Token::String;
+                pos = end + 1;
+            } else {
+                static const char *const twoCharSymbols[] = {"&&", "||", "<=", ">=", "==", "!="};
+                const QString pair = m_source.mid(pos, 2);
+                for (const char *symbol : twoCharSymbols) {
+                    if (pair == QLatin1String(symbol)) token.text = pair;
+                }
+                if (token.text.isEmpty()) {
+                    if (!QString("<>!+-*/(),:").contains(c)) {
+                        fail(QString("Unexpected character '%1'").arg(c), pos);
+                    }
+                    token.text = c;
+                }
+                pos += token.text.size();
+            }
+            m_tokens.append(token);
+        }
+        m_tokens.append(Token{Token::End, QStringLiteral("end of input"), 0.0, length});
+    }
+
+    const Token &peek(int ahead = 0) const
+    {
+        return m_tokens[qMin(m_current + ahead, m_tokens.size() - 1)];
+    }
+
+    const Token &advance()
+    {
+        const Token &token = m_tokens[m_current];
+        if (token.type != Token::End) ++m_current;
+        return token;
+    }
+
+    bool matchSymbol(const char *symbol)
+    {
+        if (peek().type == Token::Symbol && peek().text == QLatin1String(symbol)) {
+            ++m_current;
+            return true;
+        }
+        return false;
+    }
+
+    bool matchKeyword(const char *keyword)
+    {
+        if (peek().type == Token::Identifier && peek().text == QLatin1String(keyword)) {
+            ++m_current;
+            return true;
+        }
+        return false;
+    }
+
+    void expectSymbol(const char *symbol)
+    {
+        if (!matchSymbol(symbol)) {
+            fail(QString("Expected '%1' but found '%2'").arg(QString::fromLatin1(symbol), peek().text), peek().position);
+        }
+    }
+
+    // Parser (precedence climbing from || down to primaries)
+
+    int addNode(Node node)
+    {
+        m_nodes.append(std::move(node));
+        return m_nodes.size() - 1;
+    }
+
+    int makeNode(NodeKind kind, OpCode op, QVector<int> children, int position)
+    {
+        Node node;
+        node.kind = kind;
+        node.op = op;
+        node.children = std::move(children);
+        node.position = position;
+        return addNode(std::move(node));
+    }
+
+    int parseOr()
+    {
+        int left = parseAnd();
+        for (;;) {
+            int position = peek().position;
+            if (!matchSymbol("||") && !matchKeyword("or")) return left;
+            left = makeNode(NodeKind::Or, OpCode::JumpIfTrue, {left, parseAnd()}, position);
+        }
+    }
+
+    int parseAnd()
+    {
+        int left = parseNot();
+        for (;;) {
+            int position = peek().position;
+            if (!matchSymbol("&&") && !matchKeyword("and")) return left;
+            left = makeNode(NodeKind::And, OpCode::JumpIfFalse, {left, parseNot()}, position);
+        }
+    }
+
+    int parseNot()
+    {
+        int position = peek().position;
+        if (matchSymbol("!") || matchKeyword("not")) {
+            return makeNode(NodeKind::Unary, OpCode::Not, {parseNot()}, position);
+        }
+        return parseComparison();
+    }
+
+    int parseComparison()
+    {
+        static const struct { const char *symbol; OpCode op; } comparisons[] = {
+            {"<", OpCode::Less}, {"<=", OpCode::LessEqual}, {">", OpCode::Greater},
+            {">=", OpCode::GreaterEqual}, {"==", OpCode::Equal}, {"!=", OpCode::NotEqual}
+        };
+
+        int left = parseSum();
+        int position = peek().position;
+        for (const auto &comparison : comparisons) {
+            if (matchSymbol(comparison.symbol)) {
+                return makeNode(NodeKind::Binary, comparison.op, {left, parseSum()}, position);
+            }
+        }
+        return left;
+    }
+
+    int parseSum()
+    {
+        int left = parseProduct();
+        for (;;) {
+            int position = peek().position;
+            if (matchSymbol("+")) {
+                left = makeNode(NodeKind::Binary, OpCode::Add, {left, parseProduct()}, position);
+            } else if (matchSymbol("-")) {
+                left = makeNode(NodeKind::Binary, OpCode::Sub, {left, parseProduct()}, position);
+            } else {
+                return left;
+            }
+        }
+    }
+
+    int parseProduct()
+    {
+        int left = parseUnary();
+        for (;;) {
+            int position = peek().position;
+            if (matchSymbol("*")) {
+                left = makeNode(NodeKind::Binary, OpCode::Mul, {left, parseUnary()}, position);
+            } else if (matchSymbol("/")) {
+                left = makeNode(NodeKind::Binary, OpCode::Div, {left, parseUnary()}, position);
+            } else {
+                return left;
+            }
+        }
+    }
+
+    int parseUnary()
+    {
+        int position = peek().position;
+        if (matchSymbol("-")) {
+            return makeNode(NodeKind::Unary, OpCode::Neg, {parseUnary()}, position);
+        }
+        if (matchSymbol("+")) {
+            return parseUnary();
+        }
+        return parsePrimary();
+    }
+
+    int parsePrimary()
+    {
+        const Token token = advance();
+
+        switch (token.type) {
+            case Token::Number: {
+                Node node;
+                node.kind = NodeKind::Constant;
+                node.value = token.number;
+                node.position = token.position;
+                return addNode(node);
+            }
+            case Token::Identifier:
+                return parseIdentifier(token);
+            case Token::Symbol:
+                if (token.text == "(") {
+                    int inner = parseOr();
+                    expectSymbol(")");
+                    return inner;
+                }
+                break;
+            case Token::String:
+                fail("String literals are only allowed as within() regions", token.position);
+            case Token::End:
+                break;
+        }
+        fail("Unexpected '" + token.text + "'", token.position);
+    }
+
+    int parseIdentifier(const Token &token)
+    {
+        static const struct { const char *name; Field field; } fields[] = {
+            {"mag", Field::Magnitude}, {"magnitude", Field::Magnitude}, {"depth", Field::Depth},
+            {"lat", Field::Latitude}, {"latitude", Field::Latitude},
+            {"lon", Field::Longitude}, {"longitude", Field::Longitude},
+            {"alert_level", Field::AlertLevel}, {"uncertainty", Field::Uncertainty},
+            {"tsunami", Field::Tsunami}
+        };
+
+        Node node;
+        node.position = token.position;
+
+        if (peek().type == Token::Symbol && peek().text == "(") {
+            return parseCall(token);
+        }
+        if (token.text == "true" || token.text == "false") {
+            node.kind = NodeKind::Constant;
+            node.value = token.text == "true" ? 1.0 : 0.0;
+            return addNode(node);
+        }
+        if (token.text == "user") {
+            node.kind = NodeKind::User;
+            return addNode(node);
+        }
+        for (const auto &field : fields) {
+            if (token.text == QLatin1String(field.name)) {
+                node.kind = NodeKind::Field;
+                node.index = static_cast<int>(field.field);
+                return addNode(node);
+            }
+        }
+        fail("Unknown field '" + token.text + "'", token.position);
+    }
+
+    int resolveRegion(const Token &token) const
+    {
+        const int id = m_resolveRegion ? m_resolveRegion(token.text) : -1;
+        if (id < 0) fail("Unknown region '" + token.text + "'", token.position);
+        return id;
+    }
+
+    int parseCall(const Token &name)
+    {
+        expectSymbol("(");
+
+        Node node;
+        node.kind = NodeKind::Call;
+        node.position = name.position;
+
+        if (!matchSymbol(")")) {
+            do {
+                if (peek().type == Token::Identifier && peek(1).type == Token::Symbol && peek(1).text == ":") {
+                    // Named argument; only region:"..." is defined
+                    const Token key = advance();
+                    advance();
+                    if (key.text != "region") fail("Unknown argument '" + key.text + "'", key.position);
+                    if (peek().type != Token::String) fail("Expected a region name", peek().position);
+                    node.regions.append(resolveRegion(advance()));
+                } else if (peek().type == Token::String) {
+                    node.regions.append(resolveRegion(advance()));
+                } else {
+                    node.children.append(parseOr());
+                }
+            } while (matchSymbol(","));
+            expectSymbol(")");
+        }
+
+        const int argc = node.children.size();
+        const bool userArgument = argc == 1 && m_nodes[node.children[0]].kind == NodeKind::User;
+
+        if (name.text == "within") {
+            if (!node.regions.isEmpty() && argc == 0) {
+                node.index = static_cast<int>(Function::WithinRegion);
+            } else if (node.regions.isEmpty() && argc == 3) {
+                node.index = static_cast<int>(Function::WithinRadius);
+            } else {
+                fail("within() takes region names or (lat, lon, radius_km)", name.position);
+            }
+        } else if (name.text == "distance_to" || name.text == "mmi_at") {
+            if (!node.regions.isEmpty() || (argc != 2 && !userArgument)) {
+                fail(name.text + "() takes user or (lat, lon)", name.position);
+            }
+            node.index = static_cast<int>(name.text == "mmi_at" ? Function::MmiAt : Function::DistanceTo);
+        } else if (name.text == "abs" && argc == 1 && node.regions.isEmpty()) {
+            node.index = static_cast<int>(Function::Abs);
+        } else if ((name.text == "min" || name.text == "max") && argc == 2 && node.regions.isEmpty()) {
+            node.index = static_cast<int>(name.text == "min" ? Function::Min : Function::Max);
+        } else {
+            fail("Unknown function or wrong arguments: " + name.text + "()", name.position);
+        }
+
+        return addNode(std::move(node));
+    }
+
+    // Constant folding
+
+    bool isConstant(int n) const { return m_nodes[n].kind == NodeKind::Constant; }
+
+    void makeConstant(int n, double value)
+    {
+        Node &node = m_nodes[n];
+        node.kind = NodeKind::Constant;
+        node.value = value;
+        node.children.clear();
+    }
+
+    int fold(int n)
+    {
+        for (int i = 0; i < m_nodes[n].children.size(); ++i) {
+            int child = fold(m_nodes[n].children[i]);
+            m_nodes[n].children[i] = child;
+        }
+
+        Node &node = m_nodes[n];
+        switch (node.kind) {
+            case NodeKind::Unary:
+                if (isConstant(node.children[0])) {
+                    makeConstant(n, applyUnary(node.op, m_nodes[node.children[0]].value));
+                }
+                break;
+
+            case NodeKind::Binary:
+                if (isConstant(node.children[0]) && isConstant(node.children[1])) {
+                    makeConstant(n, applyBinary(node.op, m_nodes[node.children[0]].value,
+                                                m_nodes[node.children[1]].value));
+                }
+                break;
+
+            case NodeKind::And:
+            case NodeKind::Or: {
+                // Expressions are side-effect free, so a constant on either side
+                // decides the result or reduces it to the other operand's truth
+                const bool isAnd = node.kind == NodeKind::And;
+                for (int side = 0; side < 2; ++side) {
+                    const int operand = node.children[side];
+                    if (!isConstant(operand)) continue;
+                    const bool truth = m_nodes[operand].value != 0.0;
+                    if (truth != isAnd) {
+                        makeConstant(n, truth ? 1.0 : 0.0);
+                    } else {
+                        const int other = node.children[1 - side];
+                        node.kind = NodeKind::Unary;
+                        node.op = OpCode::ToBool;
+                        node.children = {other};
+                        if (isConstant(other)) makeConstant(n, applyUnary(OpCode::ToBool, m_nodes[other].value));
+                    }
+                    break;
+                }
+                break;
+            }
+
+            case NodeKind::Call: {
+                const Function function = static_cast<Function>(node.index);
+                if (function == Function::Abs && isConstant(node.children[0])) {
+                    makeConstant(n, applyUnary(OpCode::Abs, m_nodes[node.children[0]].value));
+                } else if ((function == Function::Min || function == Function::Max)
+                           && isConstant(node.children[0]) && isConstant(node.children[1])) {
+                    makeConstant(n, applyBinary(function == Function::Min ? OpCode::Min : OpCode::Max,
+                                                m_nodes[node.children[0]].value, m_nodes[node.children[1]].value));
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+        return n;
+    }
+
+    // Code generation: stack-discipline register allocation, result in r[dst]
+
+    int allocateRegister(int position)
+    {
+        if (m_nextRegister >= AlertRuleExpression::MAX_REGISTERS) {
+            fail("Expression is nested too deeply", position);
+        }
+        m_maxRegister = qMax(m_maxRegister, m_nextRegister + 1);
+        return m_nextRegister++;
+    }
+
+    void releaseRegister(int reg)
+    {
+        m_nextRegister = reg;
+    }
+
+    int emit(OpCode op, int dst, int a = 0, int b = 0, int operand = 0)
+    {
+        m_result.m_code.append({op, static_cast<quint8>(dst), static_cast<quint8>(a), static_cast<quint8>(b), operand});
+        return m_result.m_code.size() - 1;
+    }
+
+    void generateLocation(const Node &node, int latitudeReg, int longitudeReg)
+    {
+        if (m_nodes[node.children[0]].kind == NodeKind::User) {
+            emit(OpCode::LoadUser, latitudeReg, 0, 0, 0);
+            emit(OpCode::LoadUser, longitudeReg, 0, 0, 1);
+        } else {
+            generate(node.children[0], latitudeReg);
+            generate(node.children[1], longitudeReg);
+        }
+    }
+
+    void generate(int n, int dst)
+    {
+        const Node &node = m_nodes[n];
+
+        switch (node.kind) {
+            case NodeKind::Constant: {
+                int index = m_result.m_constants.indexOf(node.value);
+                if (index < 0) {
+                    index = m_result.m_constants.size();
+                    m_result.m_constants.append(node.value);
+                }
+                emit(OpCode::LoadConst, dst, 0, 0, index);
+                break;
+            }
+
+            case NodeKind::Field:
+                emit(OpCode::LoadField, dst, 0, 0, node.index);
+                break;
+
+            case NodeKind::User:
+                fail("'user' is only valid as a location argument", node.position);
+
+            case NodeKind::Unary:
+                generate(node.children[0], dst);
+                emit(node.op, dst, dst);
+                break;
+
+            case NodeKind::Binary: {
+                generate(node.children[0], dst);
+                int temp = allocateRegister(node.position);
+                generate(node.children[1], temp);
+                emit(node.op, dst, dst, temp);
+                releaseRegister(temp);
+                break;
+            }
+
+            case NodeKind::And:
+            case NodeKind::Or: {
+                generate(node.children[0], dst);
+                int jump = emit(node.op, 0, dst);
+                generate(node.children[1], dst);
+                m_result.m_code[jump].operand = m_result.m_code.size();
+                emit(OpCode::ToBool, dst, dst);
+                break;
+            }
+
+            case NodeKind::Call:
+                generateCall(node, dst);
+                break;
+        }
+    }
+
+    void generateCall(const Node &node, int dst)
+    {
+        switch (static_cast<Function>(node.index)) {
+            case Function::WithinRegion:
+                emit(OpCode::Within, dst, 0, 0, m_result.m_regionArgs.size());
+                m_result.m_regionArgs.append(node.regions);
+                break;
+
+            case Function::WithinRadius: {
+                int longitude = allocateRegister(node.position);
+                int radius = allocateRegister(node.position);
+                generate(node.children[0], dst);
+                generate(node.children[1], longitude);
+                generate(node.children[2], radius);
+                emit(OpCode::WithinRadius, dst, dst, longitude, radius);
+                releaseRegister(longitude);
+                break;
+            }
+
+            case Function::DistanceTo:
+            case Function::MmiAt: {
+                int temp = allocateRegister(node.position);
+                generateLocation(node, dst, temp);
+                bool intensity = static_cast<Function>(node.index) == Function::MmiAt;
+                emit(intensity ? OpCode::Intensity : OpCode::Distance, dst, dst, temp);
+                releaseRegister(temp);
+                break;
+            }
+
+            case Function::Abs:
+                generate(node.children[0], dst);
+                emit(OpCode::Abs, dst, dst);
+                break;
+
+            case Function::Min:
+            case Function::Max: {
+                generate(node.children[0], dst);
+                int temp = allocateRegister(node.position);
+                generate(node.children[1], temp);
+                bool isMin = static_cast<Function>(node.index) == Function::Min;
+                emit(isMin ? OpCode::Min : OpCode::Max, dst, dst, temp);
+                releaseRegister(temp);
+                break;
+            }
+        }
+    }
+
+    QString m_source;
+    const AlertRuleExpression::RegionResolver &m_resolveRegion;
+    QVector<Token> m_tokens;
+    int m_current;
+    QVector<Node> m_nodes;
+    int m_nextRegister;
+    int m_maxRegister;
+    AlertRuleExpression m_result;
+};
+
+AlertRuleExpression AlertRuleExpression::compile(const QString &source, const RegionResolver &resolveRegion)
+{
+    return AlertRuleExpressionCompiler(source, resolveRegion).compile();
+}
+
+bool AlertRuleExpression::evaluate(const EarthquakeData &earthquake, const Context &context) const
+{
+    // An empty expression places no constraint on the rule
+    if (m_code.isEmpty()) return true;
+    return evaluateValue(earthquake, context) != 0.0;
+}
+
+double AlertRuleExpression::evaluateValue(const EarthquakeData &eq, const Context &context) const
+{
+    if (m_code.isEmpty()) return 0.0;
+
+    double r[MAX_REGISTERS];
+    const Instruction *code = m_code.constData();
+    const double *constants = m_constants.constData();
+    const int length = m_code.size();
+
+    for (int pc = 0; pc < length; ++pc) {
+        const Instruction &in = code[pc];
+        switch (in.op) {
+            case OpCode::LoadConst: r[in.dst] = constants[in.operand]; break;
+            case OpCode::LoadField:
+                switch (static_cast<Field>(in.operand)) {
+                    case Field::Magnitude: r[in.dst] = eq.magnitude; break;
+                    case Field::Depth: r[in.dst] = eq.depth; break;
+                    case Field::Latitude: r[in.dst] = eq.latitude; break;
+                    case Field::Longitude: r[in.dst] = eq.longitude; break;
+                    case Field::AlertLevel: r[in.dst] = eq.alertLevel; break;
+                    case Field::Uncertainty: r[in.dst] = eq.uncertainty; break;
+                    case Field::Tsunami: r[in.dst] = eq.tsunamiFlag == QLatin1String("Yes") ? 1.0 : 0.0; break;
+                }
+                break;
+            case OpCode::LoadUser:
+                r[in.dst] = in.operand == 0 ? context.userLatitude : context.userLongitude;
+                break;
+            case OpCode::Neg: r[in.dst] = -r[in.a]; break;
+            case OpCode::Not: r[in.dst] = r[in.a] == 0.0 ? 1.0 : 0.0; break;
+            case OpCode::ToBool: r[in.dst] = r[in.a] != 0.0 ? 1.0 : 0.0; break;
+            case OpCode::Abs: r[in.dst] = std::fabs(r[in.a]); break;
+            case OpCode::Add: r[in.dst] = r[in.a] + r[in.b]; break;
+            case OpCode::Sub: r[in.dst] = r[in.a] - r[in.b]; break;
+            case OpCode::Mul: r[in.dst] = r[in.a] * r[in.b]; break;
+            case OpCode::Div: r[in.dst] = r[in.a] / r[in.b]; break;
+            case OpCode::Min: r[in.dst] = qMin(r[in.a], r[in.b]); break;
+            case OpCode::Max: r[in.dst] = qMax(r[in.a], r[in.b]); break;
+            case OpCode::Less: r[in.dst] = r[in.a] < r[in.b] ? 1.0 : 0.0; break;
+            case OpCode::LessEqual: r[in.dst] = r[in.a] <= r[in.b] ? 1.0 : 0.0; break;
+            case OpCode::Greater: r[in.dst] = r[in.a] > r[in.b] ? 1.0 : 0.0; break;
+            case OpCode::GreaterEqual: r[in.dst] = r[in.a] >= r[in.b] ? 1.0 : 0.0; break;
+            case OpCode::Equal: r[in.dst] = r[in.a] == r[in.b] ? 1.0 : 0.0; break;
+            case OpCode::NotEqual: r[in.dst] = r[in.a] != r[in.b] ? 1.0 : 0.0; break;
+            case OpCode::Distance:
+                r[in.dst] = SpatialUtils::haversineDistance(r[in.a], r[in.b], eq.latitude, eq.longitude);
+                break;
+            case OpCode::Intensity:
+                r[in.dst] = GroundMotionModel::intensity(
+                    eq.magnitude, GroundMotionModel::hypocentralDistance(
+                        SpatialUtils::haversineDistance(r[in.a], r[in.b], eq.latitude, eq.longitude), eq.depth));
+                break;
+            case OpCode::Within:
+                r[in.dst] = context.inRegion && (*context.inRegion)(eq, m_regionArgs[in.operand]) ? 1.0 : 0.0;
+                break;
+            case OpCode::WithinRadius:
+                r[in.dst] = SpatialUtils::isWithinDistance(r[in.a], r[in.b], eq.latitude, eq.longitude, r[in.operand])
+                          ? 1.0 : 0.0;
+                break;
+            case OpCode::JumpIfFalse: if (r[in.a] == 0.0) pc = in.operand - 1; break;
+            case OpCode::JumpIfTrue: if (r[in.a] != 0.0) pc = in.operand - 1; break;
+        }
+    }
+
+    return r[0];
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "earthquake_data.hpp"
+
+#include <QtCore/QString>
+#include <QVector>
+#include <functional>
+
+
+// Alert rule condition written in a small expression language, e.g.
+//
+//   mag >= 5 && depth < 70 && within(region:"Japan") && mmi_at(user) >= 4
+//
+// Fields: mag, depth, lat, lon, alert_level, uncertainty, tsunami.
+// Functions: within(region:"name", ...), within(lat, lon, radius_km),
+// distance_to(user | lat, lon), mmi_at(user | lat, lon), abs, min, max.
+// Operators: || && ! < <= > >= == != + - * / and parentheses; `and`, `or`
+// and `not` are accepted as keywords.
+//
+// The source is parsed once, constant-folded and lowered to register
+// bytecode in which && and || short-circuit through conditional jumps.
+// evaluate() runs on a fixed register file and does not allocate.
+class AlertRuleExpression
+{
+public:
+    // Region names are resolved to ids at compile time; -1 means unknown
+    using RegionResolver = std::function<int(const QString &)>;
+    using RegionPredicate = std::function<bool(const EarthquakeData &, const QVector<int> &)>;
+
+    struct Context {
+        double userLatitude = 0.0;
+        double userLongitude = 0.0;
+        const RegionPredicate *inRegion = nullptr;
+    };
+
+    enum class OpCode : quint8 {
+        LoadConst,      // r[dst] = constants[operand]
+        LoadField,      // r[dst] = event field #operand
+        LoadUser,       // r[dst] = user latitude (operand 0) or longitude (operand 1)
+        Neg,
+        Not,
+        ToBool,
+        Abs,
+        Add,
+        Sub,
+        Mul,
+        Div,
+        Min,
+        Max,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal,
+        NotEqual,
+        Distance,       // r[dst] = great-circle km from (r[a], r[b]) to the event
+        Intensity,      // r[dst] = predicted intensity at (r[a], r[b])
+        Within,         // r[dst] = event in any region of regionArgs[operand]
+        WithinRadius,   // r[dst] = event within r[operand] km (geodesic) of (r[a], r[b])
+        JumpIfFalse,    // if r[a] == 0 goto operand
+        JumpIfTrue      // if r[a] != 0 goto operand
+    };
+
+    struct Instruction {
+        OpCode op;
+        quint8 dst;
+        quint8 a;
+        quint8 b;
+        qint32 operand;
+    };
+
+    AlertRuleExpression() = default;
+
+    // Throws std::runtime_error describing the first syntax error or unknown region
+    static AlertRuleExpression compile(const QString &source, const RegionResolver &resolveRegion = {});
+
+    bool isEmpty() const { return m_code.isEmpty(); }
+    const QString &source() const { return m_source; }
+    int instructionCount() const { return m_code.size(); }
+    int registerCount() const { return m_registerCount; }
+
+    bool evaluate(const EarthquakeData &earthquake, const Context &context) const;
+    double evaluateValue(const EarthquakeData &earthquake, const Context &context) const;
+
+    static constexpr int MAX_REGISTERS = 32;
+
+private:
+    friend class AlertRuleExpressionCompiler;
+
+    QString m_source;
+    QVector<Instruction> m_code;
+    QVector<double> m_constants;
+    QVector<QVector<int>> m_regionArgs;
+    int m_registerCount = 0;
+};
@@ -0,0 +1,238 @@
+#include "alert_rule_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+// Constants
+const double AlertRuleIndex::CELL_SIZE_DEGREES = 1.0;
+const int AlertRuleIndex::MAX_CELLS_PER_RULE = 4096;
+
+namespace {
+
+// Slack so that events on a bounding box edge never fall outside it through rounding
+const double CAP_BOUNDS_EPSILON_DEGREES = 1e-9;
+
+struct CellRange {
+    int rule;
+    int row0;
+    int row1;
+    int column0;
+    int columnCount;
+};
+
+} // namespace
+
+void IntervalTree::clear()
+{
+    m_nodes.clear();
+    m_byLow.clear();
+    m_byHigh.clear();
+    m_root = -1;
+}
+
+void IntervalTree::build(QVector<Interval> intervals)
+{
+    clear();
+    m_byLow.reserve(intervals.size());
+    m_byHigh.reserve(intervals.size());
+    m_root = buildNode(intervals);
+}
+
+int IntervalTree::buildNode(QVector<Interval> &intervals)
+{
+    if (intervals.isEmpty()) return -1;
+
+    // Median endpoint keeps both subtrees at most half the size
+    QVector<double> endpoints;
+    endpoints.reserve(intervals.size() * 2);
+    for (const Interval &interval : intervals) {
+        endpoints.append(interval.low);
+        endpoints.append(interval.high);
+    }
+    auto middle = endpoints.begin() + endpoints.size() / 2;
+    std::nth_element(endpoints.begin(), middle, endpoints.end());
+    const double center = *middle;
+
+    QVector<Interval> left, right, here;
+    for (const Interval &interval : intervals) {
+        if (interval.high < center) left.append(interval);
+        else if (interval.low > center) right.append(interval);
+        else here.append(interval);
+    }
+    intervals.clear();
+    intervals.squeeze();
+
+    Node node;
+    node.center = center;
+    node.begin = m_byLow.size();
+    node.end = node.begin + here.size();
+
+    std::sort(here.begin(), here.end(), [](const Interval &a, const Interval &b) { return a.low < b.low; });
+    m_byLow.append(here);
+    std::sort(here.begin(), here.end(), [](const Interval &a, const Interval &b) { return a.high > b.high; });
+    m_byHigh.append(here);
+
+    const int index = m_nodes.size();
+    m_nodes.append(node);
+    const int leftChild = buildNode(left);
+    const int rightChild = buildNode(right);
+    m_nodes[index].left = leftChild;
+    m_nodes[index].right = rightChild;
+    return index;
+}
+
+void AlertRuleIndex::clear()
+{
+    m_ruleCount = 0;
+    m_bucketedRules = 0;
+    m_rows = 0;
+    m_columns = 0;
+    m_cellOffsets.clear();
+    m_cellRules.clear();
+    m_magnitudeTree.clear();
+    m_depthTree.clear();
+}
+
+int AlertRuleIndex::cellRow(double latitude) const
+{
+    int row = static_cast<int>(std::floor((latitude + 90.0) / CELL_SIZE_DEGREES));
+    return qBound(0, row, m_rows - 1);
+}
+
+int AlertRuleIndex::cellColumn(double longitude) const
+{
+    int column = static_cast<int>(std::floor((longitude + 180.0) / CELL_SIZE_DEGREES)) % m_columns;
+    return column < 0 ? column + m_columns : column;
+}
+
+void AlertRuleIndex::build(const CompiledAlertRules &rules)
+{
+    clear();
+    m_ruleCount = rules.size();
+    m_rows = static_cast<int>(std::ceil(180.0 / CELL_SIZE_DEGREES));
+    m_columns = static_cast<int>(std::ceil(360.0 / CELL_SIZE_DEGREES));
+
+    QVector<CellRange> ranges;
+    QVector<IntervalTree::Interval> magnitudes;
+    QVector<IntervalTree::Interval> depths;
+
+    for (int c = 0; c < m_ruleCount; ++c) {
+        // Empty bounds can never match; leave such rules out entirely
+        if (rules.minMagnitude(c) > rules.maxMagnitude(c) || rules.minDepth(c) > rules.maxDepth(c)) continue;
+
+        if (rules.hasCap(c)) {
+            double latitude, longitude;
+            rules.capCenter(c, latitude, longitude);
+            const double angle = rules.capAngularRadius(c);
+            const double angleDegrees = angle * 180.0 / M_PI + CAP_BOUNDS_EPSILON_DEGREES;
+
+            const double minLatitude = latitude - angleDegrees;
+            const double maxLatitude = latitude + angleDegrees;
+
+            // A cap reaching a pole spans every longitude; otherwise its
+            // longitude half-width is asin(sin(r) / cos(lat))
+            int columnCount = m_columns;
+            int column0 = 0;
+            if (minLatitude > -90.0 && maxLatitude < 90.0) {
+                double ratio = std::sin(angle) / std::cos(latitude * M_PI / 180.0);
+                if (ratio < 1.0) {
+                    double halfWidth = std::asin(ratio) * 180.0 / M_PI + CAP_BOUNDS_EPSILON_DEGREES;
+                    int first = static_cast<int>(std::floor((longitude - halfWidth + 180.0) / CELL_SIZE_DEGREES));
+                    int last = static_cast<int>(std::floor((longitude + halfWidth + 180.0) / CELL_SIZE_DEGREES));
+                    if (last - first + 1 < m_columns) {
+                        columnCount = last - first + 1;
+                        column0 = ((first % m_columns) + m_columns) % m_columns;
+                    }
+                }
+            }
+
+            CellRange range{c, cellRow(minLatitude), cellRow(maxLatitude), column0, columnCount};
+            if ((range.row1 - range.row0 + 1) * columnCount <= MAX_CELLS_PER_RULE) {
+                ranges.append(range);
+                continue;
+            }
+            // Caps covering a large part of the globe go through the trees
+        }
+
+        magnitudes.append({rules.minMagnitude(c), rules.maxMagnitude(c), c});
+        depths.append({rules.minDepth(c), rules.maxDepth(c), c});
+    }
+
+    // Two-pass CSR fill: count rules per cell, then place them
+    m_cellOffsets.fill(0, m_rows * m_columns + 1);
+    for (const CellRange &range : ranges) {
+        for (int row = range.row0; row <= range.row1; ++row) {
+            for (int k = 0; k < range.columnCount; ++k) {
+                int column = (range.column0 + k) % m_columns;
+                m_cellOffsets[row * m_columns + column + 1]++;
+            }
+        }
+    }
+    for (int cell = 0; cell < m_rows * m_columns; ++cell) {
+        m_cellOffsets[cell + 1] += m_cellOffsets[cell];
+    }
+
+    m_cellRules.resize(m_cellOffsets.last());
+    QVector<int> cursor(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+    for (const CellRange &range : ranges) {
+        for (int row = range.row0; row <= range.row1; ++row) {
+            for (int k = 0; k < range.columnCount; ++k) {
+                int column = (range.column0 + k) % m_columns;
+                m_cellRules[cursor[row * m_columns + column]++] = range.rule;
+            }
+        }
+    }
+
+    m_bucketedRules = ranges.size();
+    m_magnitudeTree.build(std::move(magnitudes));
+    m_depthTree.build(std::move(depths));
+}
+
+void AlertRuleIndex::candidates(double latitude, double longitude, double magnitude, double depth,
+                                QVector<int> &out, QVector<int> &stamp, int stampValue) const
+{
+    if (!m_cellOffsets.isEmpty()) {
+        const int cell = cellRow(latitude) * m_columns + cellColumn(longitude);
+        for (int i = m_cellOffsets[cell]; i < m_cellOffsets[cell + 1]; ++i) {
+            out.append(m_cellRules[i]);
+        }
+    }
+
+    // Rules in both the magnitude and the depth hit lists
+    m_magnitudeTree.stab(magnitude, [&](int c) { stamp[c] = stampValue; });
+    m_depthTree.stab(depth, [&](int c) {
+        if (stamp[c] == stampValue) out.append(c);
+    });
+}
+
+QVector<AlertMatch> AlertRuleIndex::evaluate(const CompiledAlertRules &rules, const QVector<EarthquakeData> &events,
+                                             const CompiledAlertRules::RegionPredicate &inRegion) const
+{
+    QVector<AlertMatch> result;
+    if (m_ruleCount == 0) return result;
+    Q_ASSERT(rules.size() == m_ruleCount);
+
+    QVector<int> stamp(m_ruleCount, -1);
+    QVector<int> candidateRules;
+
+    for (int e = 0; e < events.size(); ++e) {
+        const EarthquakeData &eq = events[e];
+        candidateRules.clear();
+        candidates(eq.latitude, eq.longitude, eq.magnitude, eq.depth, candidateRules, stamp, e);
+        if (candidateRules.isEmpty()) continue;
+
+        // Keep the rule order of the linear scan
+        std::sort(candidateRules.begin(), candidateRules.end());
+
+        double x, y, z;
+        CompiledAlertRules::toUnitVector(eq.latitude, eq.longitude, x, y, z);
+        for (int c : candidateRules) {
+            if (!rules.matches(c, eq.magnitude, eq.depth, x, y, z)) continue;
+            if (!rules.accepts(c, eq, inRegion)) continue;
+            result.append({e, rules.ruleIndex(c)});
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "alert_rules.hpp"
+
+#include <QVector>
+
+
+// Static centered interval tree over closed intervals [low, high].
+// Stabbing queries visit every interval containing a point in
+// O(log n + k); nodes and interval lists are stored in flat arrays.
+class IntervalTree
+{
+public:
+    struct Interval {
+        double low;
+        double high;
+        int id;
+    };
+
+    void build(QVector<Interval> intervals);
+    void clear();
+    bool isEmpty() const { return m_nodes.isEmpty(); }
+
+    template<typename Visitor>
+    void stab(double x, Visitor &&visit) const
+    {
+        int node = m_root;
+        while (node >= 0) {
+            const Node &n = m_nodes[node];
+            if (x < n.center) {
+                // Ascending by low: stop at the first interval starting after x
+                for (int i = n.begin; i < n.end && m_byLow[i].low <= x; ++i) visit(m_byLow[i].id);
+                node = n.left;
+            } else if (x > n.center) {
+                // Descending by high: stop at the first interval ending before x
+                for (int i = n.begin; i < n.end && m_byHigh[i].high >= x; ++i) visit(m_byHigh[i].id);
+                node = n.right;
+            } else {
+                for (int i = n.begin; i < n.end; ++i) visit(m_byLow[i].id);
+                return;
+            }
+        }
+    }
+
+private:
+    struct Node {
+        double center;
+        int left;
+        int right;
+        int begin; // range in m_byLow / m_byHigh
+        int end;
+    };
+
+    int buildNode(QVector<Interval> &intervals);
+
+    QVector<Node> m_nodes;
+    QVector<Interval> m_byLow;
+    QVector<Interval> m_byHigh;
+    int m_root = -1;
+};
+
+// Candidate index over compiled alert rules. Location-constrained rules are
+// bucketed into a latitude/longitude cell grid by the bounding box of their
+// cap; the remaining rules (and caps too large to bucket) are found through
+// magnitude and depth interval trees. Each event is then tested only against
+// the rules in its own cell plus the interval hits.
+class AlertRuleIndex
+{
+public:
+    void build(const CompiledAlertRules &rules);
+    void clear();
+
+    // Same result and ordering as CompiledAlertRules::evaluate
+    QVector<AlertMatch> evaluate(const CompiledAlertRules &rules, const QVector<EarthquakeData> &events,
+                                 const CompiledAlertRules::RegionPredicate &inRegion) const;
+
+    int ruleCount() const { return m_ruleCount; }
+    int bucketedRuleCount() const { return m_bucketedRules; }
+
+    static const double CELL_SIZE_DEGREES;
+    static const int MAX_CELLS_PER_RULE;
+
+private:
+    // Compiled indices of the rules that may match; `stamp` (one slot per
+    // compiled rule) de-duplicates the magnitude and depth tree hits
+    void candidates(double latitude, double longitude, double magnitude, double depth,
+                    QVector<int> &out, QVector<int> &stamp, int stampValue) const;
+
+    int cellRow(double latitude) const;
+    int cellColumn(double longitude) const;
+
+    int m_ruleCount = 0;
+    int m_bucketedRules = 0;
+    int m_rows = 0;
+    int m_columns = 0;
+
+    // Cell contents in CSR layout: rules of cell c are m_cellRules[m_cellOffsets[c] .. m_cellOffsets[c + 1])
+    QVector<int> m_cellOffsets;
+    QVector<int> m_cellRules;
+
+    // Rules not bucketed by location
+    IntervalTree m_magnitudeTree;
+    IntervalTree m_depthTree;
+};
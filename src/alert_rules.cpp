@@ -0,0 +1,184 @@
+#include "alert_rules.hpp"
+#include "spatial_utils.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <QtCore/QDebug>
+
+
+void CompiledAlertRules::clear()
+{
+    m_ruleIndex.clear();
+    m_minMagnitude.clear();
+    m_maxMagnitude.clear();
+    m_minDepth.clear();
+    m_maxDepth.clear();
+    m_hasCap.clear();
+    m_capX.clear();
+    m_capY.clear();
+    m_capZ.clear();
+    m_capCosRadius.clear();
+    m_capCosInner.clear();
+    m_capRadiusKm.clear();
+    m_regionSlot.clear();
+    m_regions.clear();
+    m_expressionSlot.clear();
+    m_expressions.clear();
+}
+
+void CompiledAlertRules::setUserLocation(double latitude, double longitude)
+{
+    m_userLatitude = latitude;
+    m_userLongitude = longitude;
+}
+
+void CompiledAlertRules::setRegionResolver(const RegionResolver &resolveRegion)
+{
+    m_resolveRegion = resolveRegion;
+}
+
+void CompiledAlertRules::compile(const QVector<AlertRule> &rules)
+{
+    clear();
+
+    for (int i = 0; i < rules.size(); ++i) {
+        const AlertRule &rule = rules[i];
+        if (!rule.enabled) continue;
+
+        AlertRuleExpression expression;
+        if (!rule.expression.trimmed().isEmpty()) {
+            try {
+                expression = AlertRuleExpression::compile(rule.expression, m_resolveRegion);
+            } catch (const std::exception &e) {
+                qWarning() << "Alert rule" << rule.name << "disabled:" << e.what();
+                continue;
+            }
+        }
+
+        QVector<int> regionIds;
+        for (const QString &region : rule.regions) {
+            int id = m_resolveRegion ? m_resolveRegion(region) : -1;
+            if (id >= 0) {
+                regionIds.append(id);
+            } else {
+                qWarning() << "Alert rule" << rule.name << "refers to unknown region" << region;
+            }
+        }
+        if (!rule.regions.isEmpty() && regionIds.isEmpty()) {
+            qWarning() << "Alert rule" << rule.name << "disabled: none of its regions are known";
+            continue;
+        }
+
+        m_ruleIndex.append(i);
+        m_minMagnitude.append(rule.minMagnitude);
+        m_maxMagnitude.append(rule.maxMagnitude);
+        m_minDepth.append(rule.minDepth);
+        m_maxDepth.append(rule.maxDepth);
+
+        double x = 0.0, y = 0.0, z = 0.0;
+        if (rule.useLocation) {
+            toUnitVector(rule.centerLatitude, rule.centerLongitude, x, y, z);
+        }
+        // Caps wider than a hemisphere are still valid: cos() just goes negative
+        double cosInner = 1.0, cosOuter = 1.0;
+        SpatialUtils::sphericalCapBounds(rule.radiusKm, cosInner, cosOuter);
+        m_hasCap.append(rule.useLocation ? 1 : 0);
+        m_capX.append(x);
+        m_capY.append(y);
+        m_capZ.append(z);
+        m_capCosRadius.append(cosOuter);
+        m_capCosInner.append(cosInner);
+        m_capRadiusKm.append(rule.radiusKm);
+
+        if (regionIds.isEmpty()) {
+            m_regionSlot.append(-1);
+        } else {
+            m_regionSlot.append(m_regions.size());
+            m_regions.append(regionIds);
+        }
+
+        if (expression.isEmpty()) {
+            m_expressionSlot.append(-1);
+        } else {
+            m_expressionSlot.append(m_expressions.size());
+            m_expressions.append(std::move(expression));
+        }
+    }
+}
+
+void CompiledAlertRules::toUnitVector(double latitude, double longitude, double &x, double &y, double &z)
+{
+    double lat = latitude * M_PI / 180.0;
+    double lon = longitude * M_PI / 180.0;
+    double cosLat = std::cos(lat);
+    x = cosLat * std::cos(lon);
+    y = cosLat * std::sin(lon);
+    z = std::sin(lat);
+}
+
+void CompiledAlertRules::capCenter(int c, double &latitude, double &longitude) const
+{
+    latitude = std::asin(qBound(-1.0, m_capZ[c], 1.0)) * 180.0 / M_PI;
+    longitude = std::atan2(m_capY[c], m_capX[c]) * 180.0 / M_PI;
+}
+
+double CompiledAlertRules::capAngularRadius(int c) const
+{
+    return std::acos(qBound(-1.0, m_capCosRadius[c], 1.0));
+}
+
+bool CompiledAlertRules::matches(int c, double magnitude, double depth, double x, double y, double z) const
+{
+    if (magnitude < m_minMagnitude[c] || magnitude > m_maxMagnitude[c]) return false;
+    if (depth < m_minDepth[c] || depth > m_maxDepth[c]) return false;
+    if (m_hasCap[c]) {
+        double dot = x * m_capX[c] + y * m_capY[c] + z * m_capZ[c];
+        if (dot < m_capCosRadius[c]) return false;
+        if (dot < m_capCosInner[c]) {
+            // Near the edge, where the sphere and the ellipsoid can disagree
+            double latitude, longitude;
+            capCenter(c, latitude, longitude);
+            const double eventLatitude = std::asin(qBound(-1.0, z, 1.0)) * 180.0 / M_PI;
+            const double eventLongitude = std::atan2(y, x) * 180.0 / M_PI;
+            if (SpatialUtils::geodesicDistance(latitude, longitude, eventLatitude, eventLongitude) > m_capRadiusKm[c]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool CompiledAlertRules::accepts(int c, const EarthquakeData &earthquake, const RegionPredicate &inRegion) const
+{
+    if (m_regionSlot[c] >= 0 && !inRegion(earthquake, m_regions[m_regionSlot[c]])) return false;
+    if (m_expressionSlot[c] >= 0) {
+        AlertRuleExpression::Context context;
+        context.userLatitude = m_userLatitude;
+        context.userLongitude = m_userLongitude;
+        context.inRegion = &inRegion;
+        if (!m_expressions[m_expressionSlot[c]].evaluate(earthquake, context)) return false;
+    }
+    return true;
+}
+
+QVector<AlertMatch> CompiledAlertRules::evaluate(const QVector<EarthquakeData> &events,
+                                                 const RegionPredicate &inRegion) const
+{
+    QVector<AlertMatch> result;
+    const int ruleCount = size();
+    if (ruleCount == 0) return result;
+
+    for (int e = 0; e < events.size(); ++e) {
+        const EarthquakeData &eq = events[e];
+        double x, y, z;
+        toUnitVector(eq.latitude, eq.longitude, x, y, z);
+
+        for (int c = 0; c < ruleCount; ++c) {
+            if (!matches(c, eq.magnitude, eq.depth, x, y, z)) continue;
+            if (!accepts(c, eq, inRegion)) continue;
+            result.append({e, m_ruleIndex[c]});
+        }
+    }
+
+    return result;
+}
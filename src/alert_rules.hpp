@@ -0,0 +1,95 @@
+#pragma once
+
+#include "alert_rule_expression.hpp"
+#include "earthquake_data.hpp"
+#include "notification_types.hpp"
+
+#include <QtCore/QMetaType>
+#include <QtCore/QTypeInfo>
+#include <QVector>
+
+
+// One (event, rule) hit produced by batch evaluation. Indices refer to the
+// evaluated event batch and to the manager's alert rule list.
+struct AlertMatch {
+    int eventIndex;
+    int ruleIndex;
+};
+Q_DECLARE_TYPEINFO(AlertMatch, Q_PRIMITIVE_TYPE);
+Q_DECLARE_METATYPE(AlertMatch)
+
+// Enabled alert rules flattened into parallel arrays so a batch of events can
+// be tested against every rule without copying AlertRule objects. Location caps
+// are stored as unit vectors and compared by dot product against cos(radius),
+// which avoids trigonometry per (event, rule) pair. Rule expressions are
+// compiled and region names resolved to ids once here; rules whose
+// expression does not compile or whose regions are all unknown are dropped.
+class CompiledAlertRules
+{
+public:
+    using RegionPredicate = AlertRuleExpression::RegionPredicate;
+    using RegionResolver = AlertRuleExpression::RegionResolver;
+
+    CompiledAlertRules() = default;
+
+    void compile(const QVector<AlertRule> &rules);
+    void clear();
+
+    // Location that mmi_at(user) and distance_to(user) refer to
+    void setUserLocation(double latitude, double longitude);
+    // Maps rule and expression region names to the ids passed to RegionPredicate
+    void setRegionResolver(const RegionResolver &resolveRegion);
+
+    int size() const { return m_ruleIndex.size(); }
+    bool isEmpty() const { return m_ruleIndex.isEmpty(); }
+
+    // Tests every event against every compiled rule. Matches are ordered by
+    // event, then by rule; ruleIndex is the position in the compiled-from list.
+    QVector<AlertMatch> evaluate(const QVector<EarthquakeData> &events,
+                                 const RegionPredicate &inRegion) const;
+
+    // Single-rule test on precomputed event data (used by evaluate and the rule index)
+    bool matches(int compiledIndex, double magnitude, double depth,
+                 double x, double y, double z) const;
+    // Region and expression checks that follow a successful matches()
+    bool accepts(int compiledIndex, const EarthquakeData &earthquake, const RegionPredicate &inRegion) const;
+    int ruleIndex(int compiledIndex) const { return m_ruleIndex[compiledIndex]; }
+
+    // Raw bounds, used to build the rule index
+    double minMagnitude(int compiledIndex) const { return m_minMagnitude[compiledIndex]; }
+    double maxMagnitude(int compiledIndex) const { return m_maxMagnitude[compiledIndex]; }
+    double minDepth(int compiledIndex) const { return m_minDepth[compiledIndex]; }
+    double maxDepth(int compiledIndex) const { return m_maxDepth[compiledIndex]; }
+    bool hasCap(int compiledIndex) const { return m_hasCap[compiledIndex] != 0; }
+    void capCenter(int compiledIndex, double &latitude, double &longitude) const;
+    double capAngularRadius(int compiledIndex) const; // Outer bound; see sphericalCapBounds
+
+    static void toUnitVector(double latitude, double longitude, double &x, double &y, double &z);
+
+private:
+    QVector<int> m_ruleIndex;
+    QVector<double> m_minMagnitude;
+    QVector<double> m_maxMagnitude;
+    QVector<double> m_minDepth;
+    QVector<double> m_maxDepth;
+
+    // Location caps (m_hasCap == 0 for rules without a location constraint)
+    QVector<quint8> m_hasCap;
+    QVector<double> m_capX;
+    QVector<double> m_capY;
+    QVector<double> m_capZ;
+    QVector<double> m_capCosRadius; // Beyond is outside, even on the ellipsoid
+    QVector<double> m_capCosInner;  // Within is inside; in between takes the geodesic
+    QVector<double> m_capRadiusKm;
+
+    // Region id lists are rare; most rules keep slot -1
+    QVector<int> m_regionSlot;
+    QVector<QVector<int>> m_regions;
+    RegionResolver m_resolveRegion;
+
+    // Likewise for expressions
+    QVector<int> m_expressionSlot;
+    QVector<AlertRuleExpression> m_expressions;
+    double m_userLatitude = 0.0;
+    double m_userLongitude = 0.0;
+};
@@ -0,0 +1,401 @@
+#include "async_log_writer.hpp"
+
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTimeZone>
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// Constants
+const QString AsyncLogWriter::TIMESTAMP_KEY = "ts";
+const QString AsyncLogWriter::COMPRESSED_SUFFIX = ".qz";
+
+namespace {
+
+const char SEGMENT_TIME_FORMAT[] = "yyyyMMdd-HHmmss-zzz";
+const char SEGMENT_EXTENSION[] = ".jsonl";
+
+} // namespace
+
+
+AsyncLogWriter::AsyncLogWriter(const Options &options, QObject *parent)
+    : QThread(parent)
+    , m_options(options)
+    , m_pending(qMax(16, options.bufferCapacity))
+    , m_activeBytes(0)
+    , m_appendedSequence(0)
+    , m_syncedSequence(0)
+    , m_flushRequested(false)
+    , m_stopping(false)
+    , m_written(0)
+    , m_dropped(0)
+    , m_unsynced(false)
+{
+    QDir().mkpath(m_options.directory);
+    setObjectName("AsyncLogWriter");
+
+    // A segment left by a previous run is queryable before the writer starts
+    m_activeBytes = QFileInfo(currentSegmentPath()).size();
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wakeWriter.wakeOne();
+    }
+    wait();
+}
+
+bool AsyncLogWriter::append(const QJsonObject &record)
+{
+    // Serialize outside the lock; the critical section is a ring buffer push
+    QJsonObject stamped = record;
+    if (!stamped.contains(TIMESTAMP_KEY)) {
+        stamped.insert(TIMESTAMP_KEY, QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs));
+    }
+    QByteArray line = QJsonDocument(stamped).toJson(QJsonDocument::Compact);
+    line.append('\n');
+
+    QMutexLocker locker(&m_mutex);
+    if (!m_pending.push(std::move(line))) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_appendedSequence++;
+
+    // Otherwise the writer picks the record up on its next interval
+    if (m_pending.size() >= m_pending.capacity() * 3 / 4) {
+        m_wakeWriter.wakeOne();
+    }
+    return true;
+}
+
+void AsyncLogWriter::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    const quint64 target = m_appendedSequence;
+    m_flushRequested = true;
+    m_wakeWriter.wakeOne();
+
+    while (m_syncedSequence < target && isRunning()) {
+        m_flushed.wait(&m_mutex, 1000);
+    }
+}
+
+void AsyncLogWriter::run()
+{
+    openSegment();
+    m_sinceSync.start();
+
+    QVector<QByteArray> batch;
+    for (;;) {
+        quint64 sequence;
+        bool flushRequested;
+        bool stopping;
+        {
+            QMutexLocker locker(&m_mutex);
+            if (!m_flushRequested && !m_stopping && m_pending.size() < m_pending.capacity() * 3 / 4) {
+                m_wakeWriter.wait(&m_mutex, m_options.flushIntervalMs);
+            }
+
+            batch.reserve(m_pending.size());
+            QByteArray line;
+            while (m_pending.pop(line)) {
+                batch.append(std::move(line));
+            }
+            m_inFlight = batch;
+            sequence = m_appendedSequence;
+            flushRequested = m_flushRequested;
+            m_flushRequested = false;
+            stopping = m_stopping;
+        }
+
+        if (!batch.isEmpty()) {
+            writeBatch(batch);
+            batch.clear();
+
+            QMutexLocker locker(&m_mutex);
+            m_inFlight.clear();
+            m_activeBytes = m_segment.isOpen() ? m_segment.size() : 0;
+        }
+
+        if (m_unsynced && (flushRequested || stopping || m_sinceSync.elapsed() >= m_options.syncIntervalMs)) {
+            syncSegment();
+        }
+        if (segmentNeedsRotation()) {
+            rotateSegment();
+        }
+
+        if (!m_unsynced) {
+            QMutexLocker locker(&m_mutex);
+            m_syncedSequence = sequence;
+            m_flushed.wakeAll();
+        }
+        if (stopping) break;
+    }
+
+    m_segment.close();
+}
+
+QString AsyncLogWriter::currentSegmentPath() const
+{
+    return QDir(m_options.directory).filePath(m_options.baseName + SEGMENT_EXTENSION);
+}
+
+QStringList AsyncLogWriter::rotatedSegmentPaths() const
+{
+    // Names embed the segment start time and, for segments started within the
+    // same millisecond, a "-N" suffix that must not sort lexically ("-10" < "-2")
+    QDir dir(m_options.directory);
+    const QString prefix = m_options.baseName + "-*" + SEGMENT_EXTENSION;
+    QStringList names = dir.entryList({prefix, prefix + COMPRESSED_SUFFIX}, QDir::Files, QDir::NoSort);
+    std::sort(names.begin(), names.end(), [this](const QString &a, const QString &b) {
+        const QDateTime startA = segmentStart(a);
+        const QDateTime startB = segmentStart(b);
+        if (startA != startB) return startA < startB;
+        const int sequenceA = segmentSequence(a);
+        const int sequenceB = segmentSequence(b);
+        if (sequenceA != sequenceB) return sequenceA < sequenceB;
+        return a < b;
+    });
+
+    QStringList paths;
+    for (const QString &name : names) {
+        paths.append(dir.filePath(name));
+    }
+    return paths;
+}
+
+void AsyncLogWriter::openSegment()
+{
+    const QString path = currentSegmentPath();
+    m_segment.setFileName(path);
+    if (!m_segment.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "Failed to open log segment:" << path << m_segment.errorString();
+        return;
+    }
+
+    m_segmentStartedAt = QDateTime::currentDateTimeUtc();
+    m_unsynced = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_activeBytes = m_segment.size();
+    }
+
+    // Continuing a segment from a previous run: it started at its first record
+    if (m_segment.size() > 0) {
+        QFile existing(path);
+        if (existing.open(QIODevice::ReadOnly)) {
+            QDateTime firstRecord = recordTime(QJsonDocument::fromJson(existing.readLine()).object());
+            if (firstRecord.isValid()) m_segmentStartedAt = firstRecord;
+        }
+    }
+}
+
+void AsyncLogWriter::writeBatch(const QVector<QByteArray> &batch)
+{
+    if (batch.isEmpty()) return;
+
+    if (!m_segment.isOpen()) {
+        openSegment();
+        if (!m_segment.isOpen()) {
+            m_dropped.fetch_add(batch.size(), std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    // One write call per batch
+    qsizetype bytes = 0;
+    for (const QByteArray &line : batch) bytes += line.size();
+    QByteArray buffer;
+    buffer.reserve(bytes);
+    for (const QByteArray &line : batch) buffer.append(line);
+
+    if (m_segment.write(buffer) != buffer.size()) {
+        qWarning() << "Failed to write log segment:" << m_segment.errorString();
+    }
+    m_segment.flush(); // Readable by query() from here on; syncSegment() makes it durable
+    m_written.fetch_add(batch.size(), std::memory_order_relaxed);
+    m_unsynced = true;
+}
+
+void AsyncLogWriter::syncSegment()
+{
+    if (m_segment.isOpen()) {
+        m_segment.flush();
+#ifdef Q_OS_WIN
+        _commit(m_segment.handle());
+#else
+        ::fsync(m_segment.handle());
+#endif
+    }
+    m_unsynced = false;
+    m_sinceSync.restart();
+}
+
+bool AsyncLogWriter::segmentNeedsRotation() const
+{
+    if (!m_segment.isOpen() || m_segment.size() == 0) return false;
+    return m_segment.size() >= m_options.maxSegmentBytes
+        || m_segmentStartedAt.secsTo(QDateTime::currentDateTimeUtc()) >= m_options.maxSegmentAgeSecs;
+}
+
+void AsyncLogWriter::rotateSegment()
+{
+    syncSegment();
+
+    QDir dir(m_options.directory);
+    const QString stem = m_options.baseName + "-" + m_segmentStartedAt.toString(SEGMENT_TIME_FORMAT);
+    QString rotated = dir.filePath(stem + SEGMENT_EXTENSION);
+    for (int n = 1; QFile::exists(rotated) || QFile::exists(rotated + COMPRESSED_SUFFIX); ++n) {
+        rotated = dir.filePath(QString("%1-%2%3").arg(stem).arg(n).arg(SEGMENT_EXTENSION));
+    }
+
+    {
+        QWriteLocker segmentLocker(&m_segmentLock);
+        m_segment.close();
+        if (!QFile::rename(currentSegmentPath(), rotated)) {
+            qWarning() << "Failed to rotate log segment to" << rotated;
+            openSegment();
+            return;
+        }
+        openSegment();
+    }
+
+    // Compression happens after the new segment is open; producers are never
+    // affected because they only touch the ring buffer, and queries keep
+    // reading the uncompressed file until the compressed one replaces it
+    QString result = rotated;
+    QFile source(rotated);
+    if (source.open(QIODevice::ReadOnly)) {
+        QByteArray compressed = qCompress(source.readAll());
+        source.close();
+
+        QWriteLocker segmentLocker(&m_segmentLock);
+        QSaveFile target(rotated + COMPRESSED_SUFFIX);
+        if (target.open(QIODevice::WriteOnly) && target.write(compressed) == compressed.size() && target.commit()) {
+            QFile::remove(rotated);
+            result = rotated + COMPRESSED_SUFFIX;
+        } else {
+            qWarning() << "Failed to compress log segment" << rotated;
+        }
+    }
+
+    emit segmentRotated(result);
+    QWriteLocker segmentLocker(&m_segmentLock);
+    pruneSegments();
+}
+
+void AsyncLogWriter::pruneSegments()
+{
+    QStringList paths = rotatedSegmentPaths();
+    while (paths.size() > qMax(0, m_options.keepSegments)) {
+        QFile::remove(paths.takeFirst());
+    }
+}
+
+QDateTime AsyncLogWriter::segmentStart(const QString &path) const
+{
+    const QString name = QFileInfo(path).fileName();
+    const int prefixLength = m_options.baseName.size() + 1;
+    const int timeLength = static_cast<int>(sizeof(SEGMENT_TIME_FORMAT)) - 1;
+
+    QDateTime start = QDateTime::fromString(name.mid(prefixLength, timeLength), SEGMENT_TIME_FORMAT);
+    if (start.isValid()) start.setTimeZone(QTimeZone::UTC);
+    return start;
+}
+
+int AsyncLogWriter::segmentSequence(const QString &path) const
+{
+    // "<base>-<start>-<N>.jsonl[.qz]"; plain "<base>-<start>.jsonl[.qz]" is 0
+    const QString name = QFileInfo(path).fileName();
+    const int suffixStart = m_options.baseName.size() + 1 + static_cast<int>(sizeof(SEGMENT_TIME_FORMAT)) - 1;
+    if (name.size() <= suffixStart || name.at(suffixStart) != '-') return 0;
+
+    const int end = name.indexOf('.', suffixStart);
+    return name.mid(suffixStart + 1, end < 0 ? -1 : end - suffixStart - 1).toInt();
+}
+
+QDateTime AsyncLogWriter::recordTime(const QJsonObject &record)
+{
+    return QDateTime::fromString(record.value(TIMESTAMP_KEY).toString(), Qt::ISODateWithMs);
+}
+
+QVector<QJsonObject> AsyncLogWriter::query(const QDateTime &from, const QDateTime &to,
+                                           const std::function<bool(const QJsonObject &)> &filter,
+                                           int limit) const
+{
+    QVector<QJsonObject> result;
+
+    // Returns false once the limit is reached
+    auto scan = [&](const QByteArray &data) {
+        qsizetype start = 0;
+        while (start < data.size()) {
+            qsizetype end = data.indexOf('\n', start);
+            if (end < 0) end = data.size(); // Partial last line of a segment fails to parse below
+
+            QJsonParseError error;
+            QJsonDocument doc = QJsonDocument::fromJson(
+                QByteArray::fromRawData(data.constData() + start, end - start), &error);
+            start = end + 1;
+            if (error.error != QJsonParseError::NoError || !doc.isObject()) continue;
+
+            const QJsonObject record = doc.object();
+            const QDateTime time = recordTime(record);
+            if (from.isValid() && time < from) continue;
+            if (to.isValid() && time > to) continue;
+            if (filter && !filter(record)) continue;
+
+            result.append(record);
+            if (limit >= 0 && result.size() >= limit) return false;
+        }
+        return true;
+    };
+
+    // Segments stay put while we read them; the writer keeps appending past
+    // activeBytes, and what it has not written yet is copied from memory
+    QReadLocker segmentLocker(&m_segmentLock);
+    qint64 activeBytes;
+    QByteArray unwritten;
+    {
+        QMutexLocker locker(&m_mutex);
+        activeBytes = m_activeBytes;
+        for (const QByteArray &line : m_inFlight) unwritten.append(line);
+        for (int i = 0; i < m_pending.size(); ++i) unwritten.append(m_pending.at(i));
+    }
+
+    const QStringList rotated = rotatedSegmentPaths();
+    for (int i = 0; i < rotated.size(); ++i) {
+        // Every record in a rotated segment was stamped before the next segment started
+        if (from.isValid() && i + 1 < rotated.size()) {
+            QDateTime nextStart = segmentStart(rotated[i + 1]);
+            if (nextStart.isValid() && nextStart < from) continue;
+        }
+
+        QFile file(rotated[i]);
+        if (!file.open(QIODevice::ReadOnly)) continue;
+        QByteArray data = file.readAll();
+        if (rotated[i].endsWith(COMPRESSED_SUFFIX)) {
+            data = qUncompress(data);
+        }
+        if (!scan(data)) return result;
+    }
+
+    QFile active(currentSegmentPath());
+    if (activeBytes > 0 && active.open(QIODevice::ReadOnly)) {
+        if (!scan(active.read(activeBytes))) return result;
+    }
+
+    scan(unwritten);
+    return result;
+}
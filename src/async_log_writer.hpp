@@ -0,0 +1,110 @@
+#pragma once
+
+#include "ring_buffer.hpp"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+#include <atomic>
+#include <functional>
+
+
+// Append-only JSON Lines log written by a background thread.
+//
+// append() serializes the record and puts it in an in-memory ring buffer;
+// it never touches the disk and never waits for the writer. The writer
+// thread collects whatever accumulated every flush interval, writes it in
+// one go and fsyncs at most once per sync interval. When the active segment
+// exceeds the size or age limit it is renamed after its start time,
+// compressed with qCompress (.jsonl.qz) and old segments beyond the
+// retention count are deleted. query() reads rotated and active segments
+// plus the records not written yet, without waiting for the writer.
+class AsyncLogWriter : public QThread
+{
+    Q_OBJECT
+public:
+    struct Options {
+        QString directory;
+        QString baseName = "log";
+        qint64 maxSegmentBytes = 8 * 1024 * 1024;
+        qint64 maxSegmentAgeSecs = 24 * 3600;
+        int flushIntervalMs = 200;
+        int syncIntervalMs = 2000;
+        int bufferCapacity = 8192;
+        int keepSegments = 30;
+    };
+
+    explicit AsyncLogWriter(const Options &options, QObject *parent = nullptr);
+    ~AsyncLogWriter() override;
+
+    // Thread-safe. Adds a "ts" field (UTC, ms) if the record has none.
+    // Returns false and counts a drop when the buffer is full.
+    bool append(const QJsonObject &record);
+
+    // Blocks until everything appended so far is written and synced
+    void flush();
+
+    // Records with from <= ts <= to (invalid bounds are open), oldest first
+    QVector<QJsonObject> query(const QDateTime &from, const QDateTime &to,
+                               const std::function<bool(const QJsonObject &)> &filter = {},
+                               int limit = -1) const;
+
+    QString currentSegmentPath() const;
+    QStringList rotatedSegmentPaths() const; // Oldest first, "-N" duplicates in numeric order
+    quint64 writtenRecords() const { return m_written.load(std::memory_order_relaxed); }
+    quint64 droppedRecords() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    static const QString TIMESTAMP_KEY;
+    static const QString COMPRESSED_SUFFIX;
+
+signals:
+    void segmentRotated(const QString &path);
+
+protected:
+    void run() override;
+
+private:
+    void openSegment();
+    void writeBatch(const QVector<QByteArray> &batch);
+    void syncSegment();
+    bool segmentNeedsRotation() const;
+    void rotateSegment();
+    void pruneSegments();
+
+    QDateTime segmentStart(const QString &fileName) const;
+    int segmentSequence(const QString &fileName) const;
+    static QDateTime recordTime(const QJsonObject &record);
+
+    Options m_options;
+
+    // Shared with producers
+    mutable QMutex m_mutex;
+    QWaitCondition m_wakeWriter;
+    QWaitCondition m_flushed;
+    RingBuffer<QByteArray> m_pending;
+    QVector<QByteArray> m_inFlight; // Popped by the writer, maybe not on disk yet
+    qint64 m_activeBytes;           // Active segment bytes readable from disk
+    quint64 m_appendedSequence;
+    quint64 m_syncedSequence;
+    bool m_flushRequested;
+    bool m_stopping;
+    std::atomic<quint64> m_written;
+    std::atomic<quint64> m_dropped;
+
+    // Held for writing while segments are renamed or removed, for reading by query()
+    mutable QReadWriteLock m_segmentLock;
+
+    // Writer thread only
+    QFile m_segment;
+    QDateTime m_segmentStartedAt;
+    QElapsedTimer m_sinceSync;
+    bool m_unsynced;
+};
@@ -0,0 +1,305 @@
+#include "catalog_stream_parser.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonParseError>
+#include <QtCore/QTimeZone>
+
+
+CatalogStreamParser::CatalogStreamParser(FeatureParser featureParser, BatchHandler batchHandler, int batchSize)
+    : m_featureParser(std::move(featureParser))
+    , m_batchHandler(std::move(batchHandler))
+    , m_batchSize(qMax(1, batchSize))
+    , m_recordCount(0)
+    , m_skippedRecords(0)
+{
+    m_batch.reserve(m_batchSize);
+}
+
+CatalogStreamParser::Format CatalogStreamParser::detectFormat(const char *data, qint64 size)
+{
+    for (qint64 i = 0; i < size; ++i) {
+        char c = data[i];
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') continue;
+        if (c == '{') return Format::GeoJson;
+        return Format::Delimited;
+    }
+    return Format::Unknown;
+}
+
+qint64 CatalogStreamParser::parseFile(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error(QString("Cannot open catalog file %1").arg(filePath).toStdString());
+    }
+
+    qint64 size = file.size();
+    if (size == 0) return 0;
+
+    // Pages are faulted in on demand and can be dropped by the kernel again,
+    // so resident memory stays bounded for arbitrarily large files
+    uchar *mapped = file.map(0, size);
+    if (!mapped) {
+        throw std::runtime_error(QString("Cannot map catalog file %1").arg(filePath).toStdString());
+    }
+
+    qint64 count = 0;
+    try {
+        count = parse(reinterpret_cast<const char*>(mapped), size);
+    } catch (...) {
+        file.unmap(mapped);
+        throw;
+    }
+    file.unmap(mapped);
+    return count;
+}
+
+qint64 CatalogStreamParser::parse(const char *data, qint64 size)
+{
+    m_recordCount = 0;
+    m_skippedRecords = 0;
+    m_batch.clear();
+
+    qint64 count = 0;
+    switch (detectFormat(data, size)) {
+        case Format::GeoJson:
+            count = parseGeoJson(data, size);
+            break;
+        case Format::Delimited:
+            count = parseDelimited(data, size);
+            break;
+        case Format::Unknown:
+            return 0;
+    }
+
+    flush();
+    qDebug() << "Streamed" << count << "catalog events," << m_skippedRecords << "skipped";
+    return count;
+}
+
+qint64 CatalogStreamParser::skipString(const char *data, qint64 size, qint64 pos)
+{
+    // pos points at the opening quote; returns the index just past the closing quote
+    for (++pos; pos < size; ++pos) {
+        if (data[pos] == '\\') {
+            ++pos;
+        } else if (data[pos] == '"') {
+            return pos + 1;
+        }
+    }
+    return size;
+}
+
+qint64 CatalogStreamParser::findFeaturesArray(const char *data, qint64 size) const
+{
+    // Walk the top-level object looking for the "features" key; nested
+    // objects (metadata, bbox) and string contents are skipped
+    static const char key[] = "\"features\"";
+    const qint64 keyLength = sizeof(key) - 1;
+
+    int depth = 0;
+    qint64 pos = 0;
+    while (pos < size) {
+        char c = data[pos];
+        if (c == '"') {
+            qint64 end = skipString(data, size, pos);
+            if (depth == 1 && end - pos == keyLength && std::memcmp(data + pos, key, keyLength) == 0) {
+                qint64 next = end;
+                while (next < size && std::isspace(static_cast<unsigned char>(data[next]))) ++next;
+                if (next < size && data[next] == ':') {
+                    ++next;
+                    while (next < size && std::isspace(static_cast<unsigned char>(data[next]))) ++next;
+                    if (next < size && data[next] == '[') return next;
+                }
+            }
+            pos = end;
+            continue;
+        }
+        if (c == '{' || c == '[') ++depth;
+        else if (c == '}' || c == ']') --depth;
+        ++pos;
+    }
+    return -1;
+}
+
+qint64 CatalogStreamParser::parseGeoJson(const char *data, qint64 size)
+{
+    qint64 pos = findFeaturesArray(data, size);
+    if (pos < 0) {
+        throw std::runtime_error("GeoJSON catalog has no features array");
+    }
+    ++pos; // Past '['
+
+    while (pos < size) {
+        char c = data[pos];
+        if (c == ']') break;
+        if (c != '{') {
+            ++pos;
+            continue;
+        }
+
+        // Find the matching closing brace of this feature
+        qint64 start = pos;
+        int depth = 0;
+        while (pos < size) {
+            char ch = data[pos];
+            if (ch == '"') {
+                pos = skipString(data, size, pos);
+                continue;
+            }
+            if (ch == '{' || ch == '[') ++depth;
+            else if ((ch == '}' || ch == ']') && --depth == 0) break;
+            ++pos;
+        }
+        if (pos >= size) {
+            throw std::runtime_error("GeoJSON catalog is truncated");
+        }
+        ++pos; // Past '}'
+
+        // fromRawData does not copy: the bytes stay in the mapped file
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(
+            QByteArray::fromRawData(data + start, static_cast<qsizetype>(pos - start)), &parseError);
+        if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+            m_skippedRecords++;
+            continue;
+        }
+
+        try {
+            addRecord(m_featureParser(doc.object()));
+        } catch (const std::exception &e) {
+            qDebug() << "Error parsing earthquake feature:" << e.what();
+            m_skippedRecords++;
+        }
+    }
+
+    return m_recordCount;
+}
+
+qint64 CatalogStreamParser::parseDelimited(const char *data, qint64 size)
+{
+    m_columns.clear();
+    char delimiter = ',';
+
+    qint64 pos = 0;
+    while (pos < size) {
+        const char *lineStart = data + pos;
+        const char *newline = static_cast<const char*>(std::memchr(lineStart, '\n', size - pos));
+        qint64 length = newline ? newline - lineStart : size - pos;
+        pos += length + 1;
+
+        if (length > 0 && lineStart[length - 1] == '\r') --length;
+        if (length == 0) continue;
+
+        if (m_columns.isEmpty()) {
+            // Header line: FDSN text starts with '#' and uses '|'
+            QByteArray header(lineStart, length);
+            delimiter = header.contains('|') ? '|' : ',';
+            if (header.startsWith('#')) header.remove(0, 1);
+
+            const QList<QByteArray> names = header.split(delimiter);
+            for (int i = 0; i < names.size(); ++i) {
+                m_columns.insert(names[i].trimmed().toLower(), i);
+            }
+            if (!m_columns.contains("latitude") || !m_columns.contains("longitude")) {
+                throw std::runtime_error("Catalog header has no latitude/longitude columns");
+            }
+            continue;
+        }
+        if (lineStart[0] == '#') continue;
+
+        EarthquakeData eq;
+        if (parseDelimitedRecord(splitFields(lineStart, length, delimiter), eq)) {
+            addRecord(std::move(eq));
+        } else {
+            m_skippedRecords++;
+        }
+    }
+
+    return m_recordCount;
+}
+
+QVector<QByteArray> CatalogStreamParser::splitFields(const char *line, qint64 length, char delimiter)
+{
+    QVector<QByteArray> fields;
+    QByteArray current;
+    bool quoted = false;
+
+    for (qint64 i = 0; i < length; ++i) {
+        char c = line[i];
+        if (c == '"') {
+            if (quoted && i + 1 < length && line[i + 1] == '"') {
+                current.append('"');
+                ++i;
+            } else {
+                quoted = !quoted;
+            }
+        } else if (c == delimiter && !quoted) {
+            fields.append(current);
+            current.clear();
+        } else {
+            current.append(c);
+        }
+    }
+    fields.append(current);
+    return fields;
+}
+
+bool CatalogStreamParser::parseDelimitedRecord(const QVector<QByteArray> &fields, EarthquakeData &eq) const
+{
+    auto field = [&](std::initializer_list<const char*> names) -> QByteArray {
+        for (const char *name : names) {
+            int index = m_columns.value(name, -1);
+            if (index >= 0 && index < fields.size()) return fields[index].trimmed();
+        }
+        return QByteArray();
+    };
+
+    bool latOk = false;
+    bool lonOk = false;
+    eq.latitude = field({"latitude"}).toDouble(&latOk);
+    eq.longitude = field({"longitude"}).toDouble(&lonOk);
+    if (!latOk || !lonOk) return false;
+
+    eq.depth = field({"depth", "depth/km"}).toDouble();
+    eq.magnitude = field({"mag", "magnitude"}).toDouble();
+    eq.eventId = QString::fromUtf8(field({"id", "eventid"}));
+    eq.place = QString::fromUtf8(field({"place", "eventlocationname"}));
+    eq.type = QString::fromUtf8(field({"type", "eventtype"}));
+    eq.uncertainty = field({"magerror"}).toDouble();
+    eq.reviewStatus = QString::fromUtf8(field({"status"}));
+    eq.dataSource = QString::fromUtf8(field({"catalog", "contributor", "net"})); // FDSN text, then USGS CSV
+    eq.location = QGeoCoordinate(eq.latitude, eq.longitude);
+    eq.alertLevel = 0;
+
+    // FDSN text times carry no zone designator but are UTC
+    eq.timestamp = QDateTime::fromString(QString::fromLatin1(field({"time"})), Qt::ISODateWithMs);
+    if (eq.timestamp.isValid() && eq.timestamp.timeSpec() == Qt::LocalTime) {
+        eq.timestamp.setTimeZone(QTimeZone::UTC);
+    }
+
+    return eq.timestamp.isValid();
+}
+
+void CatalogStreamParser::addRecord(EarthquakeData &&eq)
+{
+    m_batch.append(std::move(eq));
+    m_recordCount++;
+    if (m_batch.size() >= m_batchSize) {
+        flush();
+    }
+}
+
+void CatalogStreamParser::flush()
+{
+    if (m_batch.isEmpty()) return;
+
+    m_batchHandler(m_batch);
+    m_batch.clear();
+    m_batch.reserve(m_batchSize);
+}
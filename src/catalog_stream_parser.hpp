@@ -0,0 +1,64 @@
+#pragma once
+
+#include "earthquake_data.hpp"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QVector>
+#include <functional>
+
+
+// Incremental parser for large catalog exports held in memory-mapped files.
+// GeoJSON FeatureCollections are split into individual features by brace
+// matching, so only one feature is materialised as a QJsonDocument at a time;
+// FDSN text ('|' separated) and USGS CSV exports are parsed line by line.
+// Parsed events are handed out in fixed-size batches.
+class CatalogStreamParser
+{
+public:
+    enum class Format {
+        Unknown,
+        GeoJson,
+        Delimited
+    };
+
+    using FeatureParser = std::function<EarthquakeData(const QJsonObject &feature)>;
+    using BatchHandler = std::function<void(QVector<EarthquakeData> &batch)>;
+
+    CatalogStreamParser(FeatureParser featureParser, BatchHandler batchHandler, int batchSize = 5000);
+
+    // Parses the whole buffer; throws std::runtime_error on structural errors.
+    // Returns the number of events handed to the batch handler.
+    qint64 parse(const char *data, qint64 size);
+
+    // Maps the file and parses it without copying it into memory
+    qint64 parseFile(const QString &filePath);
+
+    int skippedRecords() const { return m_skippedRecords; }
+
+    static Format detectFormat(const char *data, qint64 size);
+
+private:
+    qint64 parseGeoJson(const char *data, qint64 size);
+    qint64 parseDelimited(const char *data, qint64 size);
+
+    qint64 findFeaturesArray(const char *data, qint64 size) const;
+    static qint64 skipString(const char *data, qint64 size, qint64 pos);
+    static QVector<QByteArray> splitFields(const char *line, qint64 length, char delimiter);
+    bool parseDelimitedRecord(const QVector<QByteArray> &fields, EarthquakeData &eq) const;
+
+    void addRecord(EarthquakeData &&eq);
+    void flush();
+
+    FeatureParser m_featureParser;
+    BatchHandler m_batchHandler;
+    int m_batchSize;
+    QVector<EarthquakeData> m_batch;
+    qint64 m_recordCount;
+    int m_skippedRecords;
+
+    // Delimited format column mapping (lower-case header name -> index)
+    QHash<QByteArray, int> m_columns;
+};
@@ -1,17 +1,22 @@
 #include "earthquake_api_client.hpp"
 #include "earthquake_api_client.moc"
 #include "geojson_parser.hpp"
+#include "catalog_stream_parser.hpp"
+#include "streaming_download.hpp"
 
 #include <chrono>
-#include <future>
 #include <string>
-#include <thread>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QJsonParseError>
 #include <QtCore/QUrlQuery>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
 #include <QtNetwork/QSslSocket>
 #include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
 #include <QByteArray>
 #include <QTimer>
 using std::chrono::milliseconds;
@@ -23,6 +28,18 @@ const int EarthquakeApiClient::DEFAULT_RATE_LIMIT_MS = 1000;
 const int EarthquakeApiClient::DEFAULT_CACHE_EXPIRY_MINUTES = 5;
 const int EarthquakeApiClient::DEFAULT_MAX_CACHE_SIZE = 100;
 const int EarthquakeApiClient::DEFAULT_MAX_CALLS_PER_MINUTE = 60;
+const qint64 EarthquakeApiClient::MAX_CACHEABLE_RESPONSE_BYTES = 8 * 1024 * 1024;
+
+namespace {
+
+// Quotes a catalog export CSV field when it needs it
+QString csvField(const QString &value)
+{
+    if (!value.contains(',') && !value.contains('"') && !value.contains('\n')) return value;
+    return QString("\"%1\"").arg(QString(value).replace("\"", "\"\""));
+}
+
+} // namespace
 
 EarthquakeApiClient::EarthquakeApiClient(QObject *parent)
     : QObject(parent)
@@ -47,12 +64,15 @@ EarthquakeApiClient::EarthquakeApiClient(QObject *parent)
     , m_maxCallsPerMinute(DEFAULT_MAX_CALLS_PER_MINUTE)
 {
     qRegisterMetaType<EarthquakeApiClient>("EarthquakeApiClient");
-
-    // Initialize network manager
-    //     void sslErrors(QNetworkReply* reply, const QList<QSslError>& errors);
+    qRegisterMetaType<EarthquakeData>("EarthquakeData");
+    qRegisterMetaType<QVector<EarthquakeData>>("QVector<EarthquakeData>");
+    qRegisterMetaType<ApiRequestType>("ApiRequestType");
+    qRegisterMetaType<ApiDataSource>("ApiDataSource");
+
+    // Initialize network manager. The client is normally moved to a dedicated
+    // network thread, so the manager and all timers are children of this object
+    // and replies are wired per request in executeRequest().
     m_networkManager = new QNetworkAccessManager(this);
-    connect(m_networkManager, &QNetworkAccessManager::finished,
-            this, &EarthquakeApiClient::onNetworkReplyFinished);
     connect(m_networkManager, &QNetworkAccessManager::sslErrors,
             this, &EarthquakeApiClient::onSslErrors);
     
@@ -80,9 +100,10 @@ EarthquakeApiClient::EarthquakeApiClient(QObject *parent)
     
     // Initialize data sources
     initializeDataSources();
+    initializeMetrics();
     
-    // Start with network status check
-    updateNetworkStatus();
+    // Start with network status check once the owning thread's event loop runs
+    QTimer::singleShot(0, this, &EarthquakeApiClient::updateNetworkStatus);
 }
 
 EarthquakeApiClient::~EarthquakeApiClient()
@@ -108,6 +129,22 @@ void EarthquakeApiClient::initializeDataSources()
         "https://www.jma.go.jp/bosai/forecast/data/earthquake/";
 }
 
+void EarthquakeApiClient::initializeMetrics()
+{
+    m_clock.start();
+
+    m_metrics.describe("earthquake_api_request_stage_seconds",
+                       "Time spent in each request stage (connect includes DNS and TLS)");
+    m_metrics.describe("earthquake_api_requests_total", "API requests by data source and result");
+    m_metrics.describe("earthquake_api_retries_total", "Requests retried after a transient network error");
+    m_metrics.describe("earthquake_api_cache_lookups_total", "Response cache lookups by result");
+    m_metrics.describe("earthquake_api_response_bytes_total",
+                       "Response payload bytes, on the wire (compressed) and after decoding");
+    m_metrics.describe("earthquake_api_events_total", "Events parsed and accepted after validation");
+    m_metrics.describe("earthquake_api_queue_depth", "Requests waiting in the request queue");
+    m_metrics.describe("earthquake_api_active_requests", "Requests currently in flight");
+}
+
 void EarthquakeApiClient::setApiKey(const QString &apiKey)
 {
     m_apiKey = apiKey;
@@ -252,6 +289,28 @@ void EarthquakeApiClient::fetchSignificantEarthquakes()
     enqueueRequest(request);
 }
 
+void EarthquakeApiClient::fetchBackgroundImage(const QString &url)
+{
+    QNetworkRequest request(url);
+    request.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
+    
+    QNetworkReply *reply = m_networkManager->get(request);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, url]() {
+        if (reply->error() == QNetworkReply::NoError) {
+            // Decode off the GUI thread; QImage (unlike QPixmap) is safe to use here
+            QImage image;
+            if (image.loadFromData(reply->readAll())) {
+                emit backgroundImageReceived(url, image);
+            } else {
+                qDebug() << "Failed to decode background image from:" << url;
+            }
+        } else {
+            qDebug() << "Background image request failed:" << reply->errorString();
+        }
+        reply->deleteLater();
+    });
+}
+
 void EarthquakeApiClient::startAutoRefresh(int intervalMinutes)
 {
     m_refreshIntervalMinutes = qMax(1, intervalMinutes); // Minimum 1 minute
@@ -267,21 +326,20 @@ void EarthquakeApiClient::stopAutoRefresh()
 
 void EarthquakeApiClient::cancelAllRequests()
 {
-    QMutexLocker locker(&m_requestMutex);
+    QVector<ApiRequest> activeRequests;
+    {
+        QMutexLocker locker(&m_requestMutex);
+        activeRequests.swap(m_activeRequests);
+        m_requestQueue.clear();
+    }
     
-    // Cancel active requests
-    for (auto &request : m_activeRequests) {
+    // Abort outside the lock: abort() emits finished() synchronously
+    for (auto &request : activeRequests) {
         if (request.reply) {
             request.reply->abort();
             request.reply->deleteLater();
         }
     }
-    m_activeRequests.clear();
-    
-    // Clear queue
-    while (!m_requestQueue.isEmpty()) {
-        m_requestQueue.dequeue();
-    }
     
     qDebug() << "All API requests cancelled";
 }
@@ -294,11 +352,13 @@ void EarthquakeApiClient::clearCache()
 
 bool EarthquakeApiClient::isConnected() const
 {
+    QMutexLocker locker(&m_statusMutex);
     return m_isConnected;
 }
 
 QDateTime EarthquakeApiClient::getLastUpdateTime() const
 {
+    QMutexLocker locker(&m_statusMutex);
     return m_lastUpdateTime;
 }
 
@@ -310,6 +370,7 @@ int EarthquakeApiClient::getPendingRequestsCount() const
 
 QString EarthquakeApiClient::getLastError() const
 {
+    QMutexLocker locker(&m_statusMutex);
     return m_lastError;
 }
 
@@ -331,7 +392,10 @@ void EarthquakeApiClient::enqueueRequest(const ApiRequest &request)
         }
     }
     
-    m_requestQueue.enqueue(request);
+    ApiRequest queuedRequest = request;
+    queuedRequest.enqueuedAtUs = nowUs();
+    m_requestQueue.enqueue(queuedRequest);
+    m_metrics.setGauge("earthquake_api_queue_depth", QString(), m_requestQueue.size());
     emit requestStarted(request.type);
     
     qDebug() << "Request enqueued, type:" << static_cast<int>(request.type) 
@@ -342,14 +406,9 @@ void EarthquakeApiClient::executeRequest(const ApiRequest &request)
 {
     if (isRateLimited()) {
         // Re-queue the request to be processed later
-        // QTimer::singleShot(milliseconds(m_rateLimitDelayMs), Qt::PreciseTimer, [this, request]() {
-        //     enqueueRequest(request);
-        // });
-        const auto ftr = std::async(std::launch::async, [this, request]() {
-            std::this_thread::sleep_for(milliseconds(m_rateLimitDelayMs));
+        QTimer::singleShot(milliseconds(m_rateLimitDelayMs), Qt::PreciseTimer, this, [this, request]() {
             enqueueRequest(request);
         });
-        (void)ftr;
         return;
     }
     
@@ -378,10 +437,17 @@ void EarthquakeApiClient::executeRequest(const ApiRequest &request)
         return;
     }
     
+    if (request.enqueuedAtUs > 0) {
+        recordStage(request, ApiRequestStage::QueueWait, nowUs() - request.enqueuedAtUs);
+    }
+    
     // Check cache first
+    const QString sourceLabels = MetricsRegistry::formatLabels({{"source", dataSourceLabel(request.source)}});
     QByteArray cachedData = getCachedResponse(url);
     if (!cachedData.isEmpty()) {
         qDebug() << "Using cached response for:" << url;
+        m_metrics.incrementCounter("earthquake_api_cache_lookups_total",
+                                   sourceLabels + ",result=\"hit\"");
         
         QVector<EarthquakeData> earthquakes;
         if (request.source == ApiDataSource::EMSC_Latest) {
@@ -396,6 +462,8 @@ void EarthquakeApiClient::executeRequest(const ApiRequest &request)
         emit requestFinished(request.type, true);
         return;
     }
+    m_metrics.incrementCounter("earthquake_api_cache_lookups_total",
+                               sourceLabels + ",result=\"miss\"");
     
     // Create network request
     QNetworkRequest netRequest(url);
@@ -412,16 +480,29 @@ void EarthquakeApiClient::executeRequest(const ApiRequest &request)
     
     // Execute request
     QNetworkReply *reply = m_networkManager->get(netRequest);
+    connect(reply, &QNetworkReply::finished, this, &EarthquakeApiClient::onNetworkReplyFinished);
     
     // Store request context
     ApiRequest activeRequest = request;
     activeRequest.reply = reply;
+    activeRequest.sentAtUs = nowUs();
     
     {
         QMutexLocker locker(&m_requestMutex);
         m_activeRequests.append(activeRequest);
+        m_metrics.setGauge("earthquake_api_active_requests", QString(), m_activeRequests.size());
     }
     
+    // Stage boundaries: requestSent() follows the connection being
+    // established, after the TLS handshake for https and for plain http alike;
+    // the first response bytes arrive with metaDataChanged()
+    connect(reply, &QNetworkReply::requestSent, this, [this, reply]() {
+        markReplyStage(reply, ApiRequestStage::Connect);
+    });
+    connect(reply, &QNetworkReply::metaDataChanged, this, [this, reply]() {
+        markReplyStage(reply, ApiRequestStage::FirstByte);
+    });
+    
     // Start timeout timer
     m_timeoutTimer->start(m_timeoutMs);
     
@@ -452,6 +533,7 @@ void EarthquakeApiClient::onNetworkReplyFinished()
                 break;
             }
         }
+        m_metrics.setGauge("earthquake_api_active_requests", QString(), m_activeRequests.size());
     }
     
     if (!requestFound) {
@@ -461,14 +543,33 @@ void EarthquakeApiClient::onNetworkReplyFinished()
     
     m_timeoutTimer->stop();
     
+    const QString sourceLabels = MetricsRegistry::formatLabels({{"source", dataSourceLabel(request.source)}});
+    
     if (reply->error() == QNetworkReply::NoError) {
         QByteArray data = reply->readAll();
         
+        if (request.firstByteAtUs > 0) {
+            recordStage(request, ApiRequestStage::Download, nowUs() - request.firstByteAtUs);
+        }
+        
+        // QNAM decodes gzip/deflate transparently; Content-Length still reports the wire size
+        qint64 wireBytes = data.size();
+        if (reply->hasRawHeader("Content-Encoding")) {
+            bool ok = false;
+            qint64 contentLength = reply->header(QNetworkRequest::ContentLengthHeader).toLongLong(&ok);
+            if (ok) wireBytes = contentLength;
+        }
+        m_metrics.incrementCounter("earthquake_api_response_bytes_total",
+                                   sourceLabels + ",encoding=\"compressed\"", wireBytes);
+        m_metrics.incrementCounter("earthquake_api_response_bytes_total",
+                                   sourceLabels + ",encoding=\"decompressed\"", data.size());
+        
         // Cache successful response
         cacheResponse(reply->url().toString(), data);
         
         try {
             QVector<EarthquakeData> earthquakes;
+            qint64 stageStartUs = nowUs();
             
             switch (request.source) {
                 case ApiDataSource::EMSC_Latest:
@@ -481,6 +582,8 @@ void EarthquakeApiClient::onNetworkReplyFinished()
                     earthquakes = parseUsgsGeoJson(data, request.type);
                     break;
             }
+            recordStage(request, ApiRequestStage::Parse, nowUs() - stageStartUs);
+            stageStartUs = nowUs();
             
             // Validate and filter data
             QVector<EarthquakeData> validEarthquakes;
@@ -492,10 +595,19 @@ void EarthquakeApiClient::onNetworkReplyFinished()
                     validEarthquakes.append(eq);
                 }
             }
+            recordStage(request, ApiRequestStage::Validate, nowUs() - stageStartUs);
+            m_metrics.incrementCounter("earthquake_api_events_total",
+                                       sourceLabels + ",result=\"parsed\"", earthquakes.size());
+            m_metrics.incrementCounter("earthquake_api_events_total",
+                                       sourceLabels + ",result=\"accepted\"", validEarthquakes.size());
             
-            m_lastUpdateTime = QDateTime::currentDateTimeUtc();
-            m_successfulRequests++;
-            m_isConnected = true;
+            {
+                QMutexLocker statusLocker(&m_statusMutex);
+                m_lastUpdateTime = QDateTime::currentDateTimeUtc();
+                m_successfulRequests++;
+                m_isConnected = true;
+            }
+            m_metrics.incrementCounter("earthquake_api_requests_total", sourceLabels + ",result=\"success\"");
             
             emit earthquakeDataReceived(validEarthquakes, request.type);
             emit requestFinished(request.type, true);
@@ -549,11 +661,18 @@ void EarthquakeApiClient::onTimeout()
 {
     qDebug() << "Request timeout occurred";
     
-    // Find and cancel timed-out requests
-    QMutexLocker locker(&m_requestMutex);
-    for (auto &request : m_activeRequests) {
+    // Find and cancel timed-out requests; abort() re-enters onNetworkReplyFinished,
+    // so take the requests out of the active list before releasing the lock
+    QVector<ApiRequest> timedOut;
+    {
+        QMutexLocker locker(&m_requestMutex);
+        timedOut.swap(m_activeRequests);
+    }
+    
+    for (auto &request : timedOut) {
         if (request.reply) {
             request.reply->abort();
+            request.reply->deleteLater();
             handleRequestError(request, "Request timeout");
         }
     }
@@ -576,6 +695,7 @@ void EarthquakeApiClient::processRequestQueue()
     }
     
     ApiRequest request = m_requestQueue.dequeue();
+    m_metrics.setGauge("earthquake_api_queue_depth", QString(), m_requestQueue.size());
     locker.unlock();
     
     executeRequest(request);
@@ -659,28 +779,39 @@ void EarthquakeApiClient::retryRequest(const ApiRequest &request)
     ApiRequest retryRequest = request;
     retryRequest.retryCount++;
     retryRequest.reply = nullptr;
+    retryRequest.sentAtUs = 0;
+    retryRequest.connectedAtUs = 0;
+    retryRequest.firstByteAtUs = 0;
+    
+    m_metrics.incrementCounter("earthquake_api_retries_total",
+                               MetricsRegistry::formatLabels({{"source", dataSourceLabel(request.source)}}));
     
     // Add exponential backoff delay
     int delay = m_rateLimitDelayMs * (1 << retryRequest.retryCount); // 2^retry * base delay
     delay = qMin(delay, 30000); // Maximum 30 second delay
 
-    // QTimer::singleShot(milliseconds(delay), Qt::PreciseTimer, [this, retryRequest]() {
-    //     enqueueRequest(retryRequest);
-    // });
-    const auto ftr = std::async(std::launch::async, [this, delay, request]() {
-        std::this_thread::sleep_for(milliseconds(delay));
-        enqueueRequest(request);
+    QTimer::singleShot(milliseconds(delay), Qt::PreciseTimer, this, [this, retryRequest]() {
+        enqueueRequest(retryRequest);
     });
-    (void)ftr;
 }
 
 void EarthquakeApiClient::handleRequestError(const ApiRequest &request, const QString &error)
 {
-    m_lastError = error;
-    m_failedRequests++;
+    bool disconnected = false;
+    {
+        QMutexLocker locker(&m_statusMutex);
+        m_lastError = error;
+        m_failedRequests++;
+        if (m_successfulRequests == 0) {
+            m_isConnected = false;
+            disconnected = true;
+        }
+    }
+    m_metrics.incrementCounter("earthquake_api_requests_total",
+                               MetricsRegistry::formatLabels({{"source", dataSourceLabel(request.source)},
+                                                              {"result", "failure"}}));
     
-    if (m_successfulRequests == 0) {
-        m_isConnected = false;
+    if (disconnected) {
         emit networkStatusChanged(false);
     }
     
@@ -815,26 +946,137 @@ EarthquakeData EarthquakeApiClient::parseUsgsFeature(const QJsonObject &feature,
     eq.uncertainty = properties["magError"].toDouble();
     eq.tsunamiFlag = properties["tsunami"].toInt() > 0 ? "Yes" : "No";
     eq.reviewStatus = properties["status"].toString();
+    eq.alertLevel = calculateAlertLevel(eq);
     
+    return eq;
+}
+
+int EarthquakeApiClient::calculateAlertLevel(const EarthquakeData &eq)
+{
     // Calculate alert level based on magnitude and other factors
+    int alertLevel;
     double mag = eq.magnitude;
-    if (mag < 2.5) eq.alertLevel = 0;      // Info
-    else if (mag < 4.0) eq.alertLevel = 1; // Minor
-    else if (mag < 5.0) eq.alertLevel = 2; // Moderate
-    else if (mag < 6.0) eq.alertLevel = 3; // Major
-    else eq.alertLevel = 4;                // Critical
+    if (mag < 2.5) alertLevel = 0;      // Info
+    else if (mag < 4.0) alertLevel = 1; // Minor
+    else if (mag < 5.0) alertLevel = 2; // Moderate
+    else if (mag < 6.0) alertLevel = 3; // Major
+    else alertLevel = 4;                // Critical
     
     // Increase alert level for shallow earthquakes
     if (eq.depth < 10.0 && eq.magnitude >= 4.0) {
-        eq.alertLevel = qMin(4, eq.alertLevel + 1);
+        alertLevel = qMin(4, alertLevel + 1);
     }
     
     // Increase alert level for tsunami potential
     if (eq.tsunamiFlag == "Yes") {
-        eq.alertLevel = qMin(4, eq.alertLevel + 1);
+        alertLevel = qMin(4, alertLevel + 1);
     }
     
-    return eq;
+    return alertLevel;
+}
+
+void EarthquakeApiClient::fetchCatalogExport(const QString &url, const QString &outputPath, int batchSize)
+{
+    // Large exports are streamed to disk and parsed from a memory map; they
+    // deliberately bypass m_responseCache so nothing holds the whole body
+    QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QDir().mkpath(cacheDir);
+    // qHash() is seeded per process; a stable digest lets a restart find its partial file
+    const QByteArray urlDigest = QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Sha1).toHex();
+    QString targetPath = QString("%1/catalog_%2.dat").arg(cacheDir, QString::fromLatin1(urlDigest));
+    
+    ApiRequest request;
+    request.type = ApiRequestType::HistoricalData;
+    request.source = ApiDataSource::Custom;
+    request.sentAtUs = nowUs();
+    
+    auto *download = new StreamingDownload(m_networkManager, QUrl(url), targetPath, this);
+    download->setUserAgent(m_userAgent);
+    download->setMaxRetries(m_maxRetries);
+    download->setRetryDelay(m_rateLimitDelayMs);
+    
+    const QString sourceLabels = MetricsRegistry::formatLabels({{"source", dataSourceLabel(request.source)}});
+    
+    connect(download, &StreamingDownload::progress, this, &EarthquakeApiClient::catalogExportProgress);
+    connect(download, &StreamingDownload::resumed, this, [this, sourceLabels](qint64 offset, int attempt) {
+        m_metrics.incrementCounter("earthquake_api_retries_total", sourceLabels);
+        qDebug() << "Resuming catalog export at byte" << offset << "attempt" << attempt;
+    });
+    connect(download, &StreamingDownload::failed, this, [this, download, request, url, outputPath](const QString &error) {
+        download->deleteLater();
+        handleRequestError(request, QString("Catalog export failed: %1").arg(error));
+        emit catalogExportFinished(url, outputPath, 0, false);
+    });
+    connect(download, &StreamingDownload::finished, this,
+            [this, download, request, url, outputPath, batchSize, sourceLabels](const QString &filePath) {
+        download->deleteLater();
+        recordStage(request, ApiRequestStage::Download, nowUs() - request.sentAtUs);
+        m_metrics.incrementCounter("earthquake_api_response_bytes_total",
+                                   sourceLabels + ",encoding=\"decompressed\"", QFileInfo(filePath).size());
+        
+        QSaveFile output(outputPath);
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            handleRequestError(request, QString("Cannot write catalog export to %1").arg(outputPath));
+            emit catalogExportFinished(url, outputPath, 0, false);
+            QFile::remove(filePath);
+            return;
+        }
+        QTextStream out(&output);
+        out << "Timestamp,EventId,Latitude,Longitude,Magnitude,Depth,Place,Source,AlertLevel\n";
+        
+        // Records without their own catalog column are credited to the export's host
+        const QString sourceName = catalogSourceName(QUrl(url));
+        qint64 accepted = 0;
+        CatalogStreamParser parser(
+            [this, sourceName](const QJsonObject &feature) { return parseUsgsFeature(feature, sourceName); },
+            [this, &accepted, &out, sourceName](QVector<EarthquakeData> &batch) {
+                for (auto &eq : batch) {
+                    if (eq.dataSource.isEmpty()) {
+                        eq.dataSource = sourceName;
+                    }
+                    eq.alertLevel = calculateAlertLevel(eq);
+                    if (!validateEarthquakeData(eq)) continue;
+                    
+                    out << eq.timestamp.toUTC().toString(Qt::ISODateWithMs) << ','
+                        << csvField(eq.eventId) << ','
+                        << QString::number(eq.latitude, 'f', 4) << ','
+                        << QString::number(eq.longitude, 'f', 4) << ','
+                        << QString::number(eq.magnitude, 'f', 1) << ','
+                        << QString::number(eq.depth, 'f', 2) << ','
+                        << csvField(eq.place) << ','
+                        << csvField(eq.dataSource) << ','
+                        << eq.alertLevel << '\n';
+                    accepted++;
+                }
+            },
+            batchSize);
+        
+        try {
+            qint64 parseStartUs = nowUs();
+            qint64 parsed = parser.parseFile(filePath);
+            out.flush();
+            if (out.status() != QTextStream::Ok || !output.commit()) {
+                throw std::runtime_error(output.errorString().toStdString());
+            }
+            recordStage(request, ApiRequestStage::Parse, nowUs() - parseStartUs);
+            m_metrics.incrementCounter("earthquake_api_events_total", sourceLabels + ",result=\"parsed\"", parsed);
+            m_metrics.incrementCounter("earthquake_api_events_total", sourceLabels + ",result=\"accepted\"", accepted);
+            m_metrics.incrementCounter("earthquake_api_requests_total", sourceLabels + ",result=\"success\"");
+            
+            emit requestFinished(request.type, true);
+            emit catalogExportFinished(url, outputPath, static_cast<int>(accepted), true);
+        } catch (const std::exception &e) {
+            output.cancelWriting();
+            handleRequestError(request, QString("Failed to parse catalog export: %1").arg(e.what()));
+            emit catalogExportFinished(url, outputPath, static_cast<int>(accepted), false);
+        }
+        
+        QFile::remove(filePath);
+    });
+    
+    emit requestStarted(request.type);
+    logApiCall(url, request.type);
+    download->start();
 }
 
 void EarthquakeApiClient::updateNetworkStatus()
@@ -844,10 +1086,15 @@ void EarthquakeApiClient::updateNetworkStatus()
     request.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
     
     QNetworkReply *reply = m_networkManager->head(request);
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
         bool connected = (reply->error() == QNetworkReply::NoError);
-        if (m_isConnected != connected) {
+        bool changed = false;
+        {
+            QMutexLocker locker(&m_statusMutex);
+            changed = (m_isConnected != connected);
             m_isConnected = connected;
+        }
+        if (changed) {
             emit networkStatusChanged(connected);
         }
         reply->deleteLater();
@@ -908,7 +1155,108 @@ void EarthquakeApiClient::updateStatistics(int earthquakeCount, ApiRequestType t
 {
     qDebug() << "Statistics update: Type" << static_cast<int>(type) 
              << "Count:" << earthquakeCount 
-             << "Success rate:" << (double)m_successfulRequests / (m_successfulRequests + m_failedRequests) * 100.0 << "%";
+             << "Success rate:" << (double)m_successfulRequests / (m_successfulRequests + m_failedRequests) * 100.0 << "%"
+             << "Cache hit ratio:" << getCacheHitRatio() * 100.0 << "%";
+}
+
+const MetricsRegistry &EarthquakeApiClient::metrics() const
+{
+    return m_metrics;
+}
+
+LatencyHistogram EarthquakeApiClient::getStageLatency(ApiDataSource source, ApiRequestStage stage) const
+{
+    return m_metrics.histogram("earthquake_api_request_stage_seconds",
+                               MetricsRegistry::formatLabels({{"source", dataSourceLabel(source)},
+                                                              {"stage", stageLabel(stage)}}));
+}
+
+double EarthquakeApiClient::getCacheHitRatio() const
+{
+    qint64 hits = 0;
+    qint64 total = 0;
+    for (const QString &labels : m_metrics.labelSets("earthquake_api_cache_lookups_total")) {
+        qint64 value = m_metrics.counter("earthquake_api_cache_lookups_total", labels);
+        total += value;
+        if (labels.contains("result=\"hit\"")) {
+            hits += value;
+        }
+    }
+    return total > 0 ? static_cast<double>(hits) / total : 0.0;
+}
+
+QString EarthquakeApiClient::exportMetricsPrometheus() const
+{
+    return m_metrics.toPrometheusText();
+}
+
+void EarthquakeApiClient::recordStage(const ApiRequest &request, ApiRequestStage stage, qint64 durationUs)
+{
+    m_metrics.recordLatency("earthquake_api_request_stage_seconds",
+                            MetricsRegistry::formatLabels({{"source", dataSourceLabel(request.source)},
+                                                           {"stage", stageLabel(stage)}}),
+                            durationUs);
+}
+
+void EarthquakeApiClient::markReplyStage(QNetworkReply *reply, ApiRequestStage stage)
+{
+    QMutexLocker locker(&m_requestMutex);
+    for (auto &request : m_activeRequests) {
+        if (request.reply != reply) continue;
+
+        qint64 now = nowUs();
+        // requestSent() repeats for redirects and resent requests; only the first counts
+        if (stage == ApiRequestStage::Connect && request.connectedAtUs == 0) {
+            request.connectedAtUs = now;
+            recordStage(request, stage, now - request.sentAtUs);
+        } else if (stage == ApiRequestStage::FirstByte && request.firstByteAtUs == 0) {
+            request.firstByteAtUs = now;
+            recordStage(request, stage, now - request.sentAtUs);
+        }
+        break;
+    }
+}
+
+qint64 EarthquakeApiClient::nowUs() const
+{
+    return m_clock.nsecsElapsed() / 1000;
+}
+
+QString EarthquakeApiClient::dataSourceLabel(ApiDataSource source)
+{
+    switch (source) {
+        case ApiDataSource::USGS_All_Hour: return "usgs_all_hour";
+        case ApiDataSource::USGS_All_Day: return "usgs_all_day";
+        case ApiDataSource::USGS_All_Week: return "usgs_all_week";
+        case ApiDataSource::USGS_All_Month: return "usgs_all_month";
+        case ApiDataSource::USGS_Significant_Month: return "usgs_significant_month";
+        case ApiDataSource::EMSC_Latest: return "emsc";
+        case ApiDataSource::JMA_Latest: return "jma";
+        case ApiDataSource::Custom: return "custom";
+    }
+    return "unknown";
+}
+
+QString EarthquakeApiClient::catalogSourceName(const QUrl &url)
+{
+    const QString host = url.host().toLower();
+    if (host.endsWith("usgs.gov")) return "USGS";
+    if (host.endsWith("emsc-csem.org") || host.endsWith("seismicportal.eu")) return "EMSC";
+    if (host.endsWith("iris.edu")) return "IRIS";
+    return host.isEmpty() ? QString("Custom") : host;
+}
+
+QString EarthquakeApiClient::stageLabel(ApiRequestStage stage)
+{
+    switch (stage) {
+        case ApiRequestStage::QueueWait: return "queue";
+        case ApiRequestStage::Connect: return "connect";
+        case ApiRequestStage::FirstByte: return "first_byte";
+        case ApiRequestStage::Download: return "download";
+        case ApiRequestStage::Parse: return "parse";
+        case ApiRequestStage::Validate: return "validate";
+    }
+    return "unknown";
 }
 
 bool EarthquakeApiClient::validateEarthquakeData(const EarthquakeData &earthquake) const
@@ -938,6 +1286,12 @@ bool EarthquakeApiClient::isValidDepth(double depth) const
 
 void EarthquakeApiClient::cacheResponse(const QString &url, const QByteArray &data)
 {
+    // Large bodies are not worth pinning in memory; use fetchCatalogExport() for those
+    if (data.size() > MAX_CACHEABLE_RESPONSE_BYTES) {
+        qDebug() << "Response too large to cache:" << url << data.size() << "bytes";
+        return;
+    }
+    
     // Clean expired cache entries first
     cleanExpiredCache();
     
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "earthquake_data.hpp"
+#include "metrics_registry.hpp"
 
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
@@ -10,6 +11,8 @@
 #include <QtCore/QJsonArray>
 #include <QtCore/QUrlQuery>
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtGui/QImage>
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkRequest>
 #include <QtNetwork/QNetworkReply>
@@ -40,6 +43,19 @@ enum class ApiRequestType {
     RegionalData
 };
 
+// Request lifecycle stages tracked by the latency histograms.
+// Connect covers DNS lookup, TCP connect and the TLS handshake up to the
+// request being written, since QNetworkAccessManager does not expose them
+// separately; a reused connection makes it close to zero.
+enum class ApiRequestStage {
+    QueueWait,
+    Connect,
+    FirstByte,
+    Download,
+    Parse,
+    Validate
+};
+
 struct ApiRequest {
     ApiRequestType type;
     ApiDataSource source;
@@ -54,6 +70,12 @@ struct ApiRequest {
     QString eventId;
     QNetworkReply *reply;
     int retryCount;
+
+    // Timing (microseconds on the client's monotonic clock)
+    qint64 enqueuedAtUs = 0;
+    qint64 sentAtUs = 0;
+    qint64 connectedAtUs = 0;
+    qint64 firstByteAtUs = 0;
 };
 
 class EarthquakeApiClient : public QObject
@@ -79,6 +101,12 @@ public:
     void fetchEarthquakesByTimeRange(const QDateTime &start, const QDateTime &end);
     void fetchSpecificEarthquake(const QString &eventId);
     void fetchSignificantEarthquakes();
+    void fetchBackgroundImage(const QString &url);
+
+    // Streams very large catalog exports (FDSN text, USGS CSV or GeoJSON) to disk
+    // and parses them from a memory map on this client's thread; accepted events
+    // are appended to outputPath as CSV batch by batch and never reach the GUI
+    void fetchCatalogExport(const QString &url, const QString &outputPath, int batchSize = 5000);
 
     // Control methods
     void startAutoRefresh(int intervalMinutes = 5);
@@ -93,6 +121,12 @@ public:
     QString getLastError() const;
     QVector<QString> getAvailableDataSources() const;
 
+    // Metrics
+    const MetricsRegistry &metrics() const;
+    LatencyHistogram getStageLatency(ApiDataSource source, ApiRequestStage stage) const;
+    double getCacheHitRatio() const;
+    QString exportMetricsPrometheus() const;
+
 signals:
     void earthquakeDataReceived(const QVector<EarthquakeData> &earthquakes, ApiRequestType requestType);
     void singleEarthquakeReceived(const EarthquakeData &earthquake);
@@ -102,6 +136,9 @@ signals:
     void errorOccurred(const QString &error, ApiRequestType requestType);
     void networkStatusChanged(bool connected);
     void rateLimitReached(int waitTimeMs);
+    void backgroundImageReceived(const QString &url, const QImage &image);
+    void catalogExportProgress(qint64 bytesReceived, qint64 bytesTotal);
+    void catalogExportFinished(const QString &url, const QString &outputPath, int earthquakeCount, bool success);
 
 private slots:
     void onNetworkReplyFinished();
@@ -127,6 +164,7 @@ private:
     QVector<EarthquakeData> parseEmscData(const QByteArray& data);
     QVector<EarthquakeData> parseJmaData(const QByteArray& data);
     EarthquakeData parseUsgsFeature(const QJsonObject& feature, const QString& source = "USGS");
+    static int calculateAlertLevel(const EarthquakeData& earthquake);
 
     // Utility methods
     void updateNetworkStatus();
@@ -136,6 +174,13 @@ private:
     void logApiCall(const QString &url, ApiRequestType type);
     void updateStatistics(int earthquakeCount, ApiRequestType type);
     void initializeDataSources();
+    void initializeMetrics();
+    void recordStage(const ApiRequest &request, ApiRequestStage stage, qint64 durationUs);
+    void markReplyStage(QNetworkReply *reply, ApiRequestStage stage);
+    qint64 nowUs() const;
+    static QString dataSourceLabel(ApiDataSource source);
+    static QString catalogSourceName(const QUrl &url); // For records that do not name their catalog
+    static QString stageLabel(ApiRequestStage stage);
     
     // Validation methods
     bool validateEarthquakeData(const EarthquakeData &earthquake) const;
@@ -170,7 +215,8 @@ private:
     QVector<ApiRequest> m_activeRequests;
     mutable QMutex m_requestMutex;
     
-    // Status tracking
+    // Status tracking (read from the GUI thread, written on the network thread)
+    mutable QMutex m_statusMutex;
     bool m_isConnected;
     QDateTime m_lastUpdateTime;
     QDateTime m_lastRequestTime;
@@ -178,6 +224,10 @@ private:
     int m_totalRequestsToday;
     int m_successfulRequests;
     int m_failedRequests;
+
+    // Metrics
+    MetricsRegistry m_metrics;
+    QElapsedTimer m_clock;
     
     // Data sources configuration
     QMap<ApiDataSource, QString> m_dataSources;
@@ -200,6 +250,9 @@ private:
     static const int DEFAULT_CACHE_EXPIRY_MINUTES;
     static const int DEFAULT_MAX_CACHE_SIZE;
     static const int DEFAULT_MAX_CALLS_PER_MINUTE;
+    static const qint64 MAX_CACHEABLE_RESPONSE_BYTES;
 };
 
 Q_DECLARE_METATYPE(EarthquakeApiClient)
+Q_DECLARE_METATYPE(ApiRequestType)
+Q_DECLARE_METATYPE(ApiDataSource)
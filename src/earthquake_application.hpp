@@ -19,6 +19,7 @@
 #include <QtCore/QDir>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtCore/QTranslator>
 #include <QtCore/QLibraryInfo>
@@ -148,19 +149,17 @@ private slots:
     {
         qDebug() << "Received" << earthquakes.size() << "earthquakes, type:" << static_cast<int>(requestType);
         
-        // Forward to main window
-        if (m_mainWindow) {
-            for (const auto &earthquake : earthquakes) {
-                m_mainWindow->addEarthquake(earthquake);
-            }
-            m_mainWindow->updateDataTimestamp();
+        // One seen-event set decides what is new for every alert path; only
+        // refreshes raise notifications for it
+        QVector<EarthquakeData> fresh;
+        if (m_notificationManager) {
+            fresh = m_notificationManager->ingestEarthquakes(earthquakes, requestType == ApiRequestType::Refresh);
         }
         
-        // Trigger notifications for new earthquakes
-        if (m_notificationManager && requestType == ApiRequestType::Refresh) {
-            for (const auto &earthquake : earthquakes) {
-                m_notificationManager->showEarthquakeAlert(earthquake);
-            }
+        // Forward to main window as one batch; it schedules a single UI refresh
+        if (m_mainWindow) {
+            m_mainWindow->addEarthquakes(earthquakes);
+            m_mainWindow->addAlertCandidates(fresh);
         }
         
         // Show data update notification for large updates
@@ -210,6 +209,23 @@ private slots:
         }
     }
 
+    void onAlertRulesChanged(const QVector<AlertRule> &rules)
+    {
+        if (!m_mainWindow) return;
+        
+        QVector<DistanceRing> rings;
+        for (const AlertRule &rule : rules) {
+            if (!rule.enabled || !rule.useLocation) continue;
+            DistanceRing ring;
+            ring.latitude = rule.centerLatitude;
+            ring.longitude = rule.centerLongitude;
+            ring.radiusKm = rule.radiusKm;
+            ring.label = rule.name;
+            rings.append(ring);
+        }
+        m_mainWindow->mapWidget()->setDistanceRings(rings);
+    }
+
 private:
     struct CommandLineArgs {
         bool noSplash = false;
@@ -466,9 +482,10 @@ private:
     bool initializeApiClient()
     {
         try {
-            m_apiClient = new EarthquakeApiClient(this);
+            // No parent: the client is moved to the network thread and deleted there
+            m_apiClient = new EarthquakeApiClient();
             
-            // Configure API client
+            // Configure API client (before it leaves the GUI thread)
             m_apiClient->setUserAgent(QString("%1/%2").arg(APP_NAME, APP_VERSION));
             m_apiClient->setTimeout(30000); // 30 second timeout
             m_apiClient->setMaxRetries(3);
@@ -479,6 +496,13 @@ private:
                 m_apiClient->setCustomApiUrl(m_commandLineArgs.dataSource);
             }
             
+            // Run the client, its QNetworkAccessManager and timers on a dedicated
+            // I/O thread so TLS handshakes and reply processing never block painting
+            m_networkThread.setObjectName("EarthquakeNetworkThread");
+            m_apiClient->moveToThread(&m_networkThread);
+            connect(&m_networkThread, &QThread::finished, m_apiClient, &QObject::deleteLater);
+            m_networkThread.start();
+            
             qDebug() << "API client initialized successfully";
             return true;
             
@@ -551,24 +575,76 @@ private:
 
     void connectComponents()
     {
-        // Connect API client to main window
+        // Connect API client to main window (client lives on the network thread)
         connect(m_apiClient, &EarthquakeApiClient::earthquakeDataReceived,
-                this, &EarthquakeApplication::onEarthquakeDataReceived);
+                this, &EarthquakeApplication::onEarthquakeDataReceived, Qt::QueuedConnection);
         connect(m_apiClient, &EarthquakeApiClient::errorOccurred,
-                this, &EarthquakeApplication::onApiError);
+                this, &EarthquakeApplication::onApiError, Qt::QueuedConnection);
         connect(m_apiClient, &EarthquakeApiClient::networkStatusChanged,
-                this, &EarthquakeApplication::onNetworkStatusChanged);
+                this, &EarthquakeApplication::onNetworkStatusChanged, Qt::QueuedConnection);
+        
+        if (m_mainWindow) {
+            // Refresh requests from the UI run on the network thread
+            EarthquakeApiClient *apiClient = m_apiClient;
+            connect(m_mainWindow, &EarthquakeMainWindow::refreshDataRequested,
+                    apiClient, [apiClient]() { apiClient->fetchAllEarthquakes(); }, Qt::QueuedConnection);
+            
+            // Catalog exports are written to disk there too; the window only sees progress
+            connect(m_mainWindow, &EarthquakeMainWindow::catalogExportRequested, apiClient,
+                    [apiClient](const QString &url, const QString &outputPath) {
+                apiClient->fetchCatalogExport(url, outputPath);
+            }, Qt::QueuedConnection);
+            connect(apiClient, &EarthquakeApiClient::catalogExportProgress,
+                    m_mainWindow, &EarthquakeMainWindow::onCatalogExportProgress, Qt::QueuedConnection);
+            connect(apiClient, &EarthquakeApiClient::catalogExportFinished,
+                    m_mainWindow, &EarthquakeMainWindow::onCatalogExportFinished, Qt::QueuedConnection);
+            
+            // Background map tiles are downloaded and decoded off the GUI thread
+            EarthquakeMapWidget *mapWidget = m_mainWindow->mapWidget();
+            connect(mapWidget, &EarthquakeMapWidget::backgroundMapRequested,
+                    apiClient, &EarthquakeApiClient::fetchBackgroundImage, Qt::QueuedConnection);
+            connect(apiClient, &EarthquakeApiClient::backgroundImageReceived,
+                    mapWidget, &EarthquakeMapWidget::setBackgroundImage, Qt::QueuedConnection);
+        }
         
         // Connect notification manager
         connect(m_notificationManager, &NotificationManager::alertRuleTriggered,
                 this, &EarthquakeApplication::onNotificationTriggered);
+        
+        if (m_mainWindow) {
+            // Live S-wave countdown for the user location, with the fronts on the map
+            EarthquakeMainWindow *mainWindow = m_mainWindow;
+            connect(m_notificationManager, &NotificationManager::shakingCountdownUpdated,
+                    mainWindow, [mainWindow](const QVector<ShakingCountdown> &countdowns) {
+                QVector<SeismicWavefront> wavefronts;
+                for (const ShakingCountdown &countdown : countdowns) {
+                    wavefronts.append(SeismicWavefront{countdown.eventId, countdown.latitude, countdown.longitude,
+                                                       countdown.depth, countdown.originTime});
+                }
+                mainWindow->mapWidget()->setWavefronts(wavefronts);
+                
+                if (countdowns.isEmpty()) {
+                    mainWindow->statusBar()->clearMessage();
+                    return;
+                }
+                const ShakingCountdown &next = countdowns.first();
+                mainWindow->statusBar()->showMessage(
+                    QString("Shaking expected in %1 s: M%2, %3 km away")
+                        .arg(qMax(0.0, next.secondsToShaking), 0, 'f', 1)
+                        .arg(next.magnitude, 0, 'f', 1)
+                        .arg(next.distanceKm, 0, 'f', 0));
+            });
+            
+            // Radius of each location-based alert rule, kept in step with rule edits
+            connect(m_notificationManager, &NotificationManager::alertRulesChanged,
+                    this, &EarthquakeApplication::onAlertRulesChanged);
+            onAlertRulesChanged(m_notificationManager->getAlertRules());
+        }
 
         // TODO
         // Connect main window to components
         // if (m_mainWindow) {
         //     // Allow main window to control API client
-        //     connect(m_mainWindow, &EarthquakeMainWindow::refreshDataRequested,
-        //             m_apiClient, QOverload<>::of(&EarthquakeApiClient::fetchAllEarthquakes));
         //     connect(m_mainWindow, &EarthquakeMainWindow::customDataRequested,
         //             m_apiClient, &EarthquakeApiClient::fetchEarthquakesByRegion);
         //
@@ -589,15 +665,13 @@ private:
             return;
         }
         
-        // Start with recent earthquake data
-        m_apiClient->fetchRecentEarthquakes(24); // Last 24 hours
-        
-        // Start auto-refresh
-        if (!m_commandLineArgs.debugMode) {
-            m_apiClient->startAutoRefresh(5); // Every 5 minutes
-        } else {
-            m_apiClient->startAutoRefresh(1); // Every minute for testing
-        }
+        // Start with recent earthquake data and auto-refresh, on the network thread
+        EarthquakeApiClient *apiClient = m_apiClient;
+        const int refreshMinutes = m_commandLineArgs.debugMode ? 1 : 5; // Every minute for testing
+        QMetaObject::invokeMethod(apiClient, [apiClient, refreshMinutes]() {
+            apiClient->fetchRecentEarthquakes(24); // Last 24 hours
+            apiClient->startAutoRefresh(refreshMinutes);
+        }, Qt::QueuedConnection);
         
         qDebug() << "Initial data load started";
     }
@@ -701,10 +775,17 @@ private:
     {
         qDebug() << "Application cleanup starting...";
 
-        // Stop all timers and network requests
-        if (m_apiClient) {
-            m_apiClient->stopAutoRefresh();
-            m_apiClient->cancelAllRequests();
+        // Stop all timers and network requests, then shut down the network thread
+        if (m_apiClient && m_networkThread.isRunning()) {
+            EarthquakeApiClient *apiClient = m_apiClient;
+            QMetaObject::invokeMethod(apiClient, [apiClient]() {
+                apiClient->stopAutoRefresh();
+                apiClient->cancelAllRequests();
+            }, Qt::BlockingQueuedConnection);
+            
+            m_networkThread.quit();
+            m_networkThread.wait();
+            m_apiClient = nullptr; // deleted on the network thread when it finished
         }
 
         // Save all settings
@@ -724,6 +805,7 @@ private:
 private:
     EarthquakeMainWindow* m_mainWindow;
     EarthquakeApiClient* m_apiClient;
+    QThread m_networkThread;
     NotificationManager* m_notificationManager;
     QSplashScreen* m_splashScreen;
     CommandLineArgs m_commandLineArgs;
@@ -840,8 +922,7 @@ namespace EarthquakeAppUtils {
             ":/icons/earthquake_large.png", 
             ":/icons/earthquake_alert.png",
             ":/sounds/alert.wav",
-            ":/sounds/warning.wav",
-            ":/sounds/emergency.wav"
+            ":/sounds/alert01.wav"
         };
         
         bool allFound = true;
@@ -4,6 +4,8 @@
 #include <QDateTime>
 #include <QtPositioning/QGeoCoordinate>
 #include <QJsonObject>
+#include <QMetaType>
+#include <QVector>
 
 struct EarthquakeData {
     QString eventId;
@@ -37,3 +39,5 @@ struct EarthquakeData {
         return magnitude > other.magnitude;
     }
 };
+
+Q_DECLARE_METATYPE(EarthquakeData)
@@ -2,10 +2,13 @@
 #include "geojson_parser.hpp"
 #include "spatial_utils.hpp"
 
+#include <algorithm>
 #include <ranges>
+#include <utility>
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QFileDialog>
+#include <QtWidgets/QInputDialog>
 #include <QtWidgets/QHeaderView>
 #include <QtWidgets/QSizePolicy>
 #include <QtCore/QStandardPaths>
@@ -19,14 +22,18 @@
 #include <QTimer>
 #include <QUrlQuery>
 
+namespace {
+
+const int MAX_INTENSITY_OVERLAYS = 20;
+
+} // namespace
 
 EarthquakeMainWindow::EarthquakeMainWindow(QWidget *parent)
     : QMainWindow(parent)
     , m_mapWidget(nullptr)
-    , m_networkManager(nullptr)
-    , m_currentReply(nullptr)
     , m_refreshTimer(nullptr)
     , m_alertTimer(nullptr)
+    , m_ingestRefreshTimer(nullptr)
     , m_trayIcon(nullptr)
     , m_alertSound(nullptr)
     , m_refreshIntervalMinutes(5)
@@ -45,11 +52,6 @@ EarthquakeMainWindow::EarthquakeMainWindow(QWidget *parent)
     connectSignals();
     loadSettings();
     
-    // Initialize network manager
-    m_networkManager = new QNetworkAccessManager(this);
-    connect(m_networkManager, &QNetworkAccessManager::finished,
-            this, &EarthquakeMainWindow::onDataReceived);
-    
     // Setup timers
     m_refreshTimer = new QTimer(this);
     connect(m_refreshTimer, &QTimer::timeout, this, &EarthquakeMainWindow::fetchEarthquakeData);
@@ -59,8 +61,10 @@ EarthquakeMainWindow::EarthquakeMainWindow(QWidget *parent)
     connect(m_alertTimer, &QTimer::timeout, this, &EarthquakeMainWindow::checkForAlerts);
     m_alertTimer->start(30000); // Check every 30 seconds
     
-    // Load initial data
-    fetchEarthquakeData();
+    m_ingestRefreshTimer = new QTimer(this);
+    m_ingestRefreshTimer->setSingleShot(true);
+    m_ingestRefreshTimer->setInterval(50); // Coalesce batches arriving within 50 ms
+    connect(m_ingestRefreshTimer, &QTimer::timeout, this, &EarthquakeMainWindow::refreshAfterIngest);
     
     setWindowTitle("Earthquake Alert System v2.1");
     resize(1400, 900);
@@ -69,9 +73,6 @@ EarthquakeMainWindow::EarthquakeMainWindow(QWidget *parent)
 EarthquakeMainWindow::~EarthquakeMainWindow()
 {
     saveSettings();
-    if (m_currentReply) {
-        m_currentReply->abort();
-    }
 }
 
 void EarthquakeMainWindow::setupUI()
@@ -210,11 +211,13 @@ void EarthquakeMainWindow::setupControlPanels()
     m_totalEarthquakesLabel = new QLabel("Total: 0");
     m_recentEarthquakesLabel = new QLabel("Last 24h: 0");
     m_highestMagnitudeLabel = new QLabel("Highest: N/A");
+    m_bValueLabel = new QLabel("b-value (30d): N/A");
     m_lastUpdateLabel = new QLabel("Last Update: Never");
     
     statsLayout->addWidget(m_totalEarthquakesLabel);
     statsLayout->addWidget(m_recentEarthquakesLabel);
     statsLayout->addWidget(m_highestMagnitudeLabel);
+    statsLayout->addWidget(m_bValueLabel);
     statsLayout->addWidget(m_lastUpdateLabel);
     
     layout->addWidget(statsGroup);
@@ -279,6 +282,9 @@ void EarthquakeMainWindow::setupMenuBar()
     importAction->setShortcut(QKeySequence::Open);
     connect(importAction, &QAction::triggered, this, &EarthquakeMainWindow::importData);
     
+    auto *catalogAction = fileMenu->addAction("Download &Catalog Export...");
+    connect(catalogAction, &QAction::triggered, this, &EarthquakeMainWindow::downloadCatalogExport);
+    
     fileMenu->addSeparator();
     
     auto *exitAction = fileMenu->addAction("E&xit");
@@ -432,78 +438,8 @@ void EarthquakeMainWindow::connectSignals()
 
 void EarthquakeMainWindow::fetchEarthquakeData()
 {
-    if (m_currentReply) {
-        m_currentReply->abort();
-        m_currentReply = nullptr;
-    }
-    
     statusBar()->showMessage("Fetching earthquake data...");
-    
-    // Example URL - replace with actual earthquake data service
-    QString url = "https://earthquake.usgs.gov/earthquakes/feed/v1.0/summary/all_month.geojson";
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::UserAgentHeader, "EarthquakeAlertSystem/2.1");
-    
-    m_currentReply = m_networkManager->get(request);
-}
-
-void EarthquakeMainWindow::onDataReceived(QNetworkReply* reply)
-{
-    if (!reply)
-        return;
-    
-    if (reply->error() == QNetworkReply::NoError) {
-        QByteArray data = reply->readAll();
-        try {
-            QJsonDocument doc = QJsonDocument::fromJson(data);
-            QJsonObject root = doc.object();
-            QJsonArray features = root["features"].toArray();
-            
-            QVector<EarthquakeData> newEarthquakes;
-            
-            for (const auto &value : features) {
-                QJsonObject feature = value.toObject();
-                QJsonObject properties = feature["properties"].toObject();
-                QJsonArray coordinates = feature["geometry"].toObject()["coordinates"].toArray();
-                
-                if (coordinates.size() >= 2) {
-                    EarthquakeData eq;
-                    eq.longitude = coordinates[0].toDouble();
-                    eq.latitude = coordinates[1].toDouble();
-                    eq.depth = coordinates.size() > 2 ? coordinates[2].toDouble() : 0.0;
-                    eq.magnitude = properties["mag"].toDouble();
-                    eq.location = GeoJsonParser::parseCoordinate(properties["place"].toString());
-                    eq.timestamp = QDateTime::fromMSecsSinceEpoch(properties["time"].toVariant().toLongLong());
-                    
-                    // Calculate alert level based on magnitude
-                    if (eq.magnitude < 3.0) eq.alertLevel = 0;
-                    else if (eq.magnitude < 4.0) eq.alertLevel = 1;
-                    else if (eq.magnitude < 5.0) eq.alertLevel = 2;
-                    else if (eq.magnitude < 6.0) eq.alertLevel = 3;
-                    else eq.alertLevel = 4;
-                    
-                    newEarthquakes.append(eq);
-                }
-            }
-            
-            m_allEarthquakes = newEarthquakes;
-            applyFilters();
-            updateStatistics();
-            
-            statusBar()->showMessage(QString("Loaded %1 earthquakes").arg(newEarthquakes.size()), 3000);
-            m_lastUpdateLabel->setText(QString("Last Update: %1").arg(QDateTime::currentDateTime().toString("hh:mm:ss")));
-            
-        } catch (const std::exception &e) {
-            statusBar()->showMessage("Error parsing earthquake data", 5000);
-            qDebug() << "JSON parsing error:" << e.what();
-        }
-        
-    } else {
-        onNetworkError(reply->error());
-    }
-    
-    reply->deleteLater();
-    m_currentReply = nullptr;
+    emit refreshDataRequested();
 }
 
 void EarthquakeMainWindow::onNetworkError(int error)
@@ -598,6 +534,51 @@ void EarthquakeMainWindow::importData()
     statusBar()->showMessage("Import functionality would be implemented here", 3000);
 }
 
+void EarthquakeMainWindow::downloadCatalogExport()
+{
+    // Any FDSN event service works; text, CSV and GeoJSON exports are all understood
+    const QString defaultUrl = QString("https://earthquake.usgs.gov/fdsnws/event/1/query?format=csv"
+                                       "&starttime=%1&minmagnitude=2.5")
+                                   .arg(QDate::currentDate().addYears(-1).toString(Qt::ISODate));
+    bool ok = false;
+    const QString url = QInputDialog::getText(this, "Download Catalog Export", "Catalog query URL:",
+                                              QLineEdit::Normal, defaultUrl, &ok).trimmed();
+    if (!ok || url.isEmpty()) return;
+    
+    const QString fileName = QFileDialog::getSaveFileName(this,
+        "Save Catalog Export",
+        QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/catalog.csv",
+        "CSV Files (*.csv)");
+    if (fileName.isEmpty()) return;
+    
+    // Downloaded, parsed and written on the network thread; only progress comes back
+    emit catalogExportRequested(url, fileName);
+    statusBar()->showMessage("Downloading catalog export...");
+}
+
+void EarthquakeMainWindow::onCatalogExportProgress(qint64 bytesReceived, qint64 bytesTotal)
+{
+    if (bytesTotal > 0) {
+        statusBar()->showMessage(QString("Downloading catalog export: %1 of %2 MB")
+                                     .arg(bytesReceived / 1048576.0, 0, 'f', 1)
+                                     .arg(bytesTotal / 1048576.0, 0, 'f', 1));
+    } else {
+        statusBar()->showMessage(QString("Downloading catalog export: %1 MB")
+                                     .arg(bytesReceived / 1048576.0, 0, 'f', 1));
+    }
+}
+
+void EarthquakeMainWindow::onCatalogExportFinished(const QString &url, const QString &outputPath,
+                                                   int earthquakeCount, bool success)
+{
+    if (success) {
+        statusBar()->showMessage(QString("Exported %1 earthquakes to %2").arg(earthquakeCount).arg(outputPath), 5000);
+    } else {
+        statusBar()->showMessage("Catalog export failed", 5000);
+        QMessageBox::warning(this, "Catalog Export", QString("Could not export the catalog from\n%1").arg(url));
+    }
+}
+
 void EarthquakeMainWindow::onMapCenterChanged()
 {
     m_mapWidget->setCenter(m_latSpinBox->value(), m_lonSpinBox->value());
@@ -639,6 +620,7 @@ void EarthquakeMainWindow::onEarthquakeSelected()
     int currentRow = m_earthquakeTable->currentRow();
     if (currentRow >= 0 && currentRow < m_filteredEarthquakes.size()) {
         const EarthquakeData &eq = m_filteredEarthquakes[currentRow];
+        const double epicentralIntensity = m_groundMotion.intensityAt(eq, eq.latitude, eq.longitude);
         
         // Update details pane
         QString details = QString(
@@ -651,8 +633,9 @@ void EarthquakeMainWindow::onEarthquakeSelected()
             "Alert Level: %5\n"
             "Coordinates: %6°, %7°\n\n"
             "Estimated Effects:\n"
-            "Seismic Energy: %.2e J\n"
-            "Mercalli Intensity: %8\n"
+            "Seismic Energy: %8 J\n"
+            "Predicted Epicentral Intensity: %9 (MMI %10)\n"
+            "Predicted Peak Ground Acceleration: %11 %g\n"
         ).arg(GeoJsonParser::coordinateToString(eq.location))
          .arg(formatMagnitude(eq.magnitude))
          .arg(formatDepth(eq.depth))
@@ -660,8 +643,10 @@ void EarthquakeMainWindow::onEarthquakeSelected()
          .arg(getAlertLevelText(eq.alertLevel))
          .arg(eq.latitude, 0, 'f', 4)
          .arg(eq.longitude, 0, 'f', 4)
-         .arg(SpatialUtils::calculateSeismicEnergy(eq.magnitude))
-         .arg(SpatialUtils::mercalliIntensity(eq.magnitude, 50.0)); // Assume 50km distance
+         .arg(SpatialUtils::calculateSeismicEnergy(eq.magnitude), 0, 'e', 2)
+         .arg(epicentralIntensity, 0, 'f', 1)
+         .arg(GroundMotionModel::mercalliClass(epicentralIntensity))
+         .arg(GroundMotionModel::pgaFromIntensity(epicentralIntensity), 0, 'f', 1);
         
         m_detailsPane->setPlainText(details);
         
@@ -693,12 +678,16 @@ void EarthquakeMainWindow::sortEarthquakeList()
 
 void EarthquakeMainWindow::checkForAlerts()
 {
+    // Only events that are new or revised since the last check are candidates
+    const QVector<EarthquakeData> pending = std::exchange(m_pendingAlerts, {});
+    QDateTime now = QDateTime::currentDateTime();
+    
     if (!m_alertsEnabled) return;
     
-    QDateTime cutoff = QDateTime::currentDateTime().addSecs(-300); // 5 minutes ago
+    QDateTime cutoff = now.addSecs(-300); // 5 minutes ago
     double threshold = m_alertThresholdCombo->currentText().left(3).toDouble();
     
-    for (const auto &eq : m_allEarthquakes) {
+    for (const auto &eq : pending) {
         if (eq.timestamp > cutoff && eq.magnitude >= threshold) {
             showAlert(eq);
         }
@@ -899,6 +888,9 @@ void EarthquakeMainWindow::showHelpDialog()
 
 void EarthquakeMainWindow::updateEarthquakeList()
 {
+    // With sorting enabled every setItem() would re-sort the table
+    m_earthquakeTable->setUpdatesEnabled(false);
+    m_earthquakeTable->setSortingEnabled(false);
     m_earthquakeTable->setRowCount(m_filteredEarthquakes.size());
     
     for (int i = 0; i < m_filteredEarthquakes.size(); ++i) {
@@ -939,7 +931,9 @@ void EarthquakeMainWindow::updateEarthquakeList()
         m_earthquakeTable->setItem(i, 5, distanceItem);
     }
     
+    m_earthquakeTable->setSortingEnabled(true);
     sortEarthquakeList();
+    m_earthquakeTable->setUpdatesEnabled(true);
 }
 
 void EarthquakeMainWindow::updateStatistics()
@@ -968,6 +962,20 @@ void EarthquakeMainWindow::updateStatistics()
     } else {
         m_highestMagnitudeLabel->setText("Highest: N/A");
     }
+    
+    // Global Gutenberg-Richter fit over the last 30 days
+    SeismicityStatistics::Window window;
+    window.endMs = QDateTime::currentMSecsSinceEpoch();
+    window.startMs = window.endMs - 30LL * 24 * 3600 * 1000;
+    const SeismicityStatistics::GutenbergRichter fit = m_seismicity.gutenbergRichter(window);
+    if (fit.valid) {
+        m_bValueLabel->setText(QString("b-value (30d): %1 ± %2, Mc %3")
+                               .arg(fit.bValue, 0, 'f', 2)
+                               .arg(fit.bError, 0, 'f', 2)
+                               .arg(fit.completeness, 0, 'f', 1));
+    } else {
+        m_bValueLabel->setText("b-value (30d): N/A");
+    }
 }
 
 void EarthquakeMainWindow::updateStatusBar()
@@ -979,9 +987,50 @@ void EarthquakeMainWindow::updateStatusBar()
 
 void EarthquakeMainWindow::addEarthquake(const EarthquakeData& earthquake)
 {
-    m_allEarthquakes.append(earthquake);
-    updateEarthquakeList();
-    updateStatusBar();
+    addEarthquakes({earthquake});
+}
+
+void EarthquakeMainWindow::addEarthquakes(const QVector<EarthquakeData>& earthquakes)
+{
+    if (earthquakes.isEmpty()) return;
+    
+    // Merge by event id: updated events replace the stored revision
+    m_allEarthquakes.reserve(m_allEarthquakes.size() + earthquakes.size());
+    for (const auto &eq : earthquakes) {
+        m_seismicity.add(eq);
+        
+        auto existing = m_eventIndex.constFind(eq.eventId);
+        if (!eq.eventId.isEmpty() && existing != m_eventIndex.constEnd()) {
+            m_allEarthquakes[*existing] = eq;
+        } else {
+            if (!eq.eventId.isEmpty()) {
+                m_eventIndex.insert(eq.eventId, m_allEarthquakes.size());
+            }
+            m_allEarthquakes.append(eq);
+        }
+    }
+    
+    // Batches arriving in quick succession share one table/map rebuild
+    if (!m_ingestRefreshTimer->isActive()) {
+        m_ingestRefreshTimer->start();
+    }
+}
+
+void EarthquakeMainWindow::addAlertCandidates(const QVector<EarthquakeData>& earthquakes)
+{
+    m_pendingAlerts += earthquakes;
+}
+
+void EarthquakeMainWindow::refreshAfterIngest()
+{
+    applyFilters();
+    updateStatistics();
+    m_lastUpdateLabel->setText(QString("Last Update: %1").arg(QDateTime::currentDateTime().toString("hh:mm:ss")));
+}
+
+EarthquakeMapWidget* EarthquakeMainWindow::mapWidget() const
+{
+    return m_mapWidget;
 }
 
 void EarthquakeMainWindow::updateDataTimestamp()
@@ -1006,14 +1055,37 @@ void EarthquakeMainWindow::applyFilters()
     
     // Update map with filtered data
     m_mapWidget->clearEarthquakes();
-    for (const auto& eq : m_filteredEarthquakes) {
-        m_mapWidget->addEarthquake(eq);
-    }
+    m_mapWidget->addEarthquakes(m_filteredEarthquakes);
+    updateIntensityOverlay();
 
     updateEarthquakeList();
     updateStatusBar();
 }
 
+void EarthquakeMainWindow::updateIntensityOverlay()
+{
+    // Largest events first; smaller grids would barely show at map scale
+    QVector<const EarthquakeData *> significant;
+    for (const auto &eq : m_filteredEarthquakes) {
+        if (eq.magnitude >= GroundMotionEngine::MIN_GRID_MAGNITUDE) {
+            significant.append(&eq);
+        }
+    }
+    std::sort(significant.begin(), significant.end(),
+              [](const EarthquakeData *a, const EarthquakeData *b) { return a->magnitude > b->magnitude; });
+    if (significant.size() > MAX_INTENSITY_OVERLAYS) {
+        significant.resize(MAX_INTENSITY_OVERLAYS);
+    }
+
+    QVector<std::shared_ptr<const ShakeGrid>> grids;
+    for (const EarthquakeData *eq : significant) {
+        if (auto grid = m_groundMotion.gridFor(*eq)) {
+            grids.append(grid);
+        }
+    }
+    m_mapWidget->setIntensityGrids(grids);
+}
+
 QString EarthquakeMainWindow::formatMagnitude(double magnitude) const
 {
     return QString("M%1").arg(magnitude, 0, 'f', 1);
@@ -2,6 +2,8 @@
 #pragma once
 
 #include "earthquake_map_widget.hpp"
+#include "ground_motion.hpp"
+#include "seismicity_statistics.hpp"
 
 #include <QtWidgets/QMainWindow>
 #include <QtWidgets/QVBoxLayout>
@@ -26,8 +28,7 @@
 #include <QtWidgets/QSlider>
 #include <QtCore/QTimer>
 #include <QtCore/QSettings>
-#include <QtNetwork/QNetworkAccessManager>
-#include <QtNetwork/QNetworkReply>
+#include <QtCore/QHash>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonArray>
@@ -43,7 +44,17 @@ public:
     ~EarthquakeMainWindow();
 
     void addEarthquake(const EarthquakeData& earthquake);
+    void addEarthquakes(const QVector<EarthquakeData>& earthquakes);
+    // New and revised events, as picked out by NotificationManager's seen-event
+    // set; shown as alerts at the next check if recent and strong enough
+    void addAlertCandidates(const QVector<EarthquakeData>& earthquakes);
     void updateDataTimestamp();
+    EarthquakeMapWidget* mapWidget() const;
+
+signals:
+    // Data is fetched by EarthquakeApiClient on the network thread
+    void refreshDataRequested();
+    void catalogExportRequested(const QString &url, const QString &outputPath);
 
 protected:
     void closeEvent(QCloseEvent* event) override;
@@ -51,11 +62,13 @@ protected:
 public slots:
     // Data management
     void fetchEarthquakeData();
-    void onDataReceived(QNetworkReply* reply);
     void onNetworkError(int error);
     void refreshData();
     void exportData();
     void importData();
+    void downloadCatalogExport();
+    void onCatalogExportProgress(qint64 bytesReceived, qint64 bytesTotal);
+    void onCatalogExportFinished(const QString &url, const QString &outputPath, int earthquakeCount, bool success);
     
     // Map controls
     void onMapCenterChanged();
@@ -85,6 +98,9 @@ public slots:
     void showAboutDialog();
     void showHelpDialog();
 
+private slots:
+    void refreshAfterIngest();
+
 private:
     void setupUI();
     void setupMenuBar();
@@ -101,6 +117,7 @@ private:
     void updateStatistics();
     void updateStatusBar();
     void applyFilters();
+    void updateIntensityOverlay();
     
     QString formatMagnitude(double magnitude) const;
     QString formatDepth(double depth) const;
@@ -151,13 +168,13 @@ private:
     QLabel* m_totalEarthquakesLabel;
     QLabel* m_recentEarthquakesLabel;
     QLabel* m_highestMagnitudeLabel;
+    QLabel* m_bValueLabel;
     QLabel* m_lastUpdateLabel;
 
-    // Network and data
-    QNetworkAccessManager* m_networkManager;
-    QNetworkReply* m_currentReply;
+    // Data refresh
     QTimer* m_refreshTimer;
     QTimer* m_alertTimer;
+    QTimer* m_ingestRefreshTimer;
 
     // System tray and notifications
     QSystemTrayIcon* m_trayIcon;
@@ -166,6 +183,14 @@ private:
     // Data storage
     QVector<EarthquakeData> m_allEarthquakes;
     QVector<EarthquakeData> m_filteredEarthquakes;
+    QHash<QString, int> m_eventIndex; // eventId -> index in m_allEarthquakes
+    
+    // Magnitude-frequency and moment statistics, kept up to date per event
+    SeismicityStatistics m_seismicity;
+    QVector<EarthquakeData> m_pendingAlerts; // New or revised since the last alert check
+
+    // Predicted shaking for the details pane and the map overlay
+    GroundMotionEngine m_groundMotion;
     
     // Settings
     QSettings* m_settings;
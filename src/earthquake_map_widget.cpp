@@ -1,8 +1,11 @@
 #include "earthquake_map_widget.hpp"
 #include "spatial_utils.hpp"
+#include "travel_times.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <future>
+#include <iterator>
 #include <thread>
 #include <QApplication>
 #include <QBuffer>
@@ -32,6 +35,91 @@ const int EarthquakeMapWidget::MAX_TOOLTIP_WIDTH = 300;
 const double EarthquakeMapWidget::EARTH_RADIUS_KM = 6371.0;
 const double EarthquakeMapWidget::DEFAULT_EARTHQUAKE_SIZE = 8.0;
 const int EarthquakeMapWidget::CLUSTER_EXPAND_DURATION_MS = 300;
+const double EarthquakeMapWidget::INTENSITY_OVERLAY_OPACITY = 0.45;
+const int EarthquakeMapWidget::INTENSITY_OVERLAY_STRIPS = 16;
+const double EarthquakeMapWidget::GEODESIC_TOLERANCE_PX = 0.5;
+const int EarthquakeMapWidget::GEODESIC_MAX_DEPTH = 12;
+const int EarthquakeMapWidget::GEODESIC_MIN_SEGMENTS = 8;
+
+namespace {
+
+// A point of a curve on the globe and where it lands on screen
+struct CurveSample {
+    double t;
+    double latitude;
+    double longitude;
+    QPointF screen;
+    bool visible;
+};
+
+double distanceToChord(const QPointF &point, const QPointF &a, const QPointF &b)
+{
+    const QPointF chord = b - a;
+    const double length2 = QPointF::dotProduct(chord, chord);
+    const double f = length2 > 0.0 ? qBound(0.0, QPointF::dotProduct(point - a, chord) / length2, 1.0) : 0.0;
+    const QPointF offset = point - (a + f * chord);
+    return std::hypot(offset.x(), offset.y());
+}
+
+// Recursive midpoint subdivision of a curve between two samples. A span
+// is split while its projected midpoint is off the screen chord by more
+// than the tolerance; spans holding a break (antimeridian seam, horizon)
+// are split down to maxDepth to pin the break, then the line restarts.
+struct CurveTessellation {
+    std::function<CurveSample(double)> sample;
+    bool wrapsAtAntimeridian = true;
+    QRectF viewport; // Spans wholly off one side of it are not refined
+    double tolerance = 0.5;
+    int maxDepth = 12;
+    QVector<QPolygonF> polylines;
+    bool open = false; // Whether the last polyline ends at the last sample
+
+    void lineTo(const CurveSample &from, const CurveSample &to)
+    {
+        if (!open) {
+            polylines.append(QPolygonF{from.screen});
+            open = true;
+        }
+        polylines.last().append(to.screen);
+    }
+
+    bool offscreen(const CurveSample &a, const CurveSample &m, const CurveSample &b) const
+    {
+        return (a.screen.x() < viewport.left() && m.screen.x() < viewport.left() && b.screen.x() < viewport.left())
+            || (a.screen.x() > viewport.right() && m.screen.x() > viewport.right() && b.screen.x() > viewport.right())
+            || (a.screen.y() < viewport.top() && m.screen.y() < viewport.top() && b.screen.y() < viewport.top())
+            || (a.screen.y() > viewport.bottom() && m.screen.y() > viewport.bottom() && b.screen.y() > viewport.bottom());
+    }
+
+    void refine(const CurveSample &a, const CurveSample &b, int depth)
+    {
+        const bool seam = wrapsAtAntimeridian && qAbs(b.longitude - a.longitude) > 180.0;
+        const bool continuous = a.visible && b.visible && !seam;
+        if (depth >= maxDepth) {
+            if (continuous) {
+                lineTo(a, b);
+            } else {
+                open = false;
+            }
+            return;
+        }
+
+        const CurveSample m = sample((a.t + b.t) / 2.0);
+        if (!a.visible && !b.visible && !m.visible) {
+            open = false;
+            return;
+        }
+        if (continuous && m.visible
+            && (offscreen(a, m, b) || distanceToChord(m.screen, a.screen, b.screen) <= tolerance)) {
+            lineTo(a, b);
+            return;
+        }
+        refine(a, m, depth + 1);
+        refine(m, b, depth + 1);
+    }
+};
+
+} // namespace
 
 EarthquakeMapWidget::EarthquakeMapWidget(QWidget *parent)
     : QWidget(parent)
@@ -50,7 +138,7 @@ EarthquakeMapWidget::EarthquakeMapWidget(QWidget *parent)
     , m_animationEnabled(true)
     , m_backgroundCacheValid(false)
     , m_layerCacheValid(false)
-    , m_networkManager(nullptr)
+    , m_geodesicCacheValid(false)
     , m_minMagnitude(0.0)
     , m_maxMagnitude(10.0)
     , m_minDepth(0.0)
@@ -93,11 +181,6 @@ void EarthquakeMapWidget::initializeWidget()
     // Initialize bounds
     updateVisibleBounds();
     
-    // Initialize network manager
-    m_networkManager = new QNetworkAccessManager(this);
-    connect(m_networkManager, &QNetworkAccessManager::finished,
-            this, &EarthquakeMapWidget::onNetworkReplyFinished);
-    
     // Setup rendering
     setupRenderingHints();
     
@@ -329,6 +412,10 @@ void EarthquakeMapWidget::renderDynamicContent(QPainter& painter)
     // Save painter state for dynamic content
     painter.save();
     
+    // Predicted shaking goes underneath the event markers
+    renderIntensityOverlay(painter);
+    renderGeodesicOverlays(painter);
+    
     // Set opacity for animation effects
     painter.setOpacity(m_animationOpacity);
     
@@ -366,6 +453,100 @@ void EarthquakeMapWidget::renderUIOverlays(QPainter& painter)
     renderStatusOverlays(painter);
 }
 
+void EarthquakeMapWidget::renderIntensityOverlay(QPainter& painter)
+{
+    // A grid image only maps onto cylindrical projections
+    if (m_intensityOverlays.isEmpty()
+        || m_settings.projection == MapProjection::OrthographicNorthPole
+        || m_settings.projection == MapProjection::OrthographicSouthPole) {
+        return;
+    }
+
+    painter.save();
+    painter.setOpacity(INTENSITY_OVERLAY_OPACITY);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+
+    const QRectF viewport = rect();
+    for (const IntensityOverlay &overlay : m_intensityOverlays) {
+        const ShakeGrid &grid = *overlay.grid;
+        const double west = grid.westLongitude - grid.longitudeStep / 2.0;
+        const double east = grid.eastLongitude() + grid.longitudeStep / 2.0;
+        const double north = grid.northLatitude() + grid.latitudeStep / 2.0;
+
+        // Horizontal strips follow the projection's latitude scaling
+        const int rows = overlay.image.height();
+        for (int strip = 0; strip < INTENSITY_OVERLAY_STRIPS; ++strip) {
+            const int top = strip * rows / INTENSITY_OVERLAY_STRIPS;
+            const int bottom = (strip + 1) * rows / INTENSITY_OVERLAY_STRIPS;
+            if (bottom <= top) continue;
+
+            const QPointF topLeft = latLonToScreen(north - top * grid.latitudeStep, west);
+            const QPointF bottomRight = latLonToScreen(north - bottom * grid.latitudeStep, east);
+            const QRectF target = QRectF(topLeft, bottomRight).normalized();
+            if (!target.intersects(viewport)) continue;
+
+            painter.drawImage(target, overlay.image, QRectF(0, top, overlay.image.width(), bottom - top));
+        }
+    }
+
+    painter.restore();
+}
+
+void EarthquakeMapWidget::renderGeodesicOverlays(QPainter& painter)
+{
+    if (m_distanceRings.isEmpty() && m_greatCirclePaths.isEmpty() && m_wavefronts.isEmpty()) {
+        return;
+    }
+    updateGeodesicCache();
+
+    painter.save();
+    painter.setBrush(Qt::NoBrush);
+
+    for (int i = 0; i < m_distanceRings.size(); ++i) {
+        const DistanceRing &ring = m_distanceRings[i];
+        painter.setPen(QPen(ring.color, 1.5, Qt::DashLine));
+        for (const QPolygonF &polyline : m_ringPolylines[i]) {
+            painter.drawPolyline(polyline);
+        }
+
+        // Label at the northernmost point of the ring
+        if (!ring.label.isEmpty()) {
+            const QPointF north = SpatialUtils::calculateDestination(ring.latitude, ring.longitude, 0.0, ring.radiusKm);
+            const QPointF anchor = latLonToScreen(north.x(), north.y());
+            if (isOnVisibleHemisphere(north.x()) && rect().contains(anchor.toPoint())) {
+                painter.drawText(anchor + QPointF(4, -4), ring.label);
+            }
+        }
+    }
+
+    for (int i = 0; i < m_greatCirclePaths.size(); ++i) {
+        painter.setPen(QPen(m_greatCirclePaths[i].color, 1.5));
+        for (const QPolygonF &polyline : m_pathPolylines[i]) {
+            painter.drawPolyline(polyline);
+        }
+    }
+
+    // Fronts grow every frame, so they skip the cache
+    const QDateTime now = QDateTime::currentDateTime();
+    const double halfCircumferenceKm = M_PI * EARTH_RADIUS_KM;
+    const QPen pPen(QColor(90, 170, 255), 2.0);
+    const QPen sPen(QColor(255, 90, 60), 2.0);
+    for (const SeismicWavefront &wavefront : m_wavefronts) {
+        const double elapsed = wavefront.originTime.msecsTo(now) / 1000.0;
+        for (TravelTimes::Phase phase : {TravelTimes::Phase::P, TravelTimes::Phase::S}) {
+            const double radius = TravelTimes::distanceReached(phase, elapsed, wavefront.depth);
+            if (radius <= 0.0 || radius >= halfCircumferenceKm) continue;
+
+            painter.setPen(phase == TravelTimes::Phase::P ? pPen : sPen);
+            for (const QPolygonF &polyline : tessellateRing(wavefront.latitude, wavefront.longitude, radius)) {
+                painter.drawPolyline(polyline);
+            }
+        }
+    }
+
+    painter.restore();
+}
+
 void EarthquakeMapWidget::renderEarthquakesOptimized(QPainter& painter)
 {
     QMutexLocker locker(&m_dataMutex);
@@ -775,23 +956,19 @@ void EarthquakeMapWidget::renderGrid(QPainter &painter) const
     
     double spacing = m_settings.gridSpacing;
     
-    // Latitude lines
+    // Parallels and meridians curve in most projections, so they are
+    // tessellated like any other line on the globe
     for (double lat = -90; lat <= 90; lat += spacing) {
-        QPointF start = latLonToScreen(lat, -180);
-        QPointF end = latLonToScreen(lat, 180);
-        
-        if (rect().intersects(QRectF(start, end).normalized().toRect())) {
-            painter.drawLine(start, end);
+        const auto parallel = [lat](double t) { return QPointF(lat, -180.0 + 360.0 * t); };
+        for (const QPolygonF &polyline : tessellateCurve(parallel, GEODESIC_MIN_SEGMENTS)) {
+            painter.drawPolyline(polyline);
         }
     }
     
-    // Longitude lines  
     for (double lon = -180; lon <= 180; lon += spacing) {
-        QPointF start = latLonToScreen(-90, lon);
-        QPointF end = latLonToScreen(90, lon);
-        
-        if (rect().intersects(QRectF(start, end).normalized().toRect())) {
-            painter.drawLine(start, end);
+        const auto meridian = [lon](double t) { return QPointF(-90.0 + 180.0 * t, lon); };
+        for (const QPolygonF &polyline : tessellateCurve(meridian, GEODESIC_MIN_SEGMENTS)) {
+            painter.drawPolyline(polyline);
         }
     }
 }
@@ -1626,6 +1803,81 @@ QPointF EarthquakeMapWidget::robinsonProjection(double lat, double lon) const
     return QPointF(x, y);
 }
 
+bool EarthquakeMapWidget::isOnVisibleHemisphere(double latitude) const
+{
+    // A polar view shows one hemisphere; the other would project on top of it
+    switch (m_settings.projection) {
+        case MapProjection::OrthographicNorthPole:
+            return latitude >= 0.0;
+        case MapProjection::OrthographicSouthPole:
+            return latitude <= 0.0;
+        default:
+            return true;
+    }
+}
+
+QVector<QPolygonF> EarthquakeMapWidget::tessellateCurve(const std::function<QPointF(double)> &curve, int segments) const
+{
+    // The curve maps t in [0, 1] to (lat, lon)
+    CurveTessellation tessellation;
+    tessellation.sample = [this, &curve](double t) {
+        const QPointF point = curve(t);
+        return CurveSample{t, point.x(), point.y(), latLonToScreen(point.x(), point.y()),
+                           isOnVisibleHemisphere(point.x())};
+    };
+    tessellation.wrapsAtAntimeridian = m_settings.projection != MapProjection::OrthographicNorthPole
+                                       && m_settings.projection != MapProjection::OrthographicSouthPole;
+    tessellation.viewport = QRectF(rect()).adjusted(-width() / 2.0, -height() / 2.0, width() / 2.0, height() / 2.0);
+    tessellation.tolerance = GEODESIC_TOLERANCE_PX;
+    tessellation.maxDepth = GEODESIC_MAX_DEPTH;
+
+    // Evenly spaced seeds keep the midpoint test from missing an S-bend
+    CurveSample previous = tessellation.sample(0.0);
+    for (int i = 1; i <= segments; ++i) {
+        const CurveSample next = tessellation.sample(double(i) / segments);
+        tessellation.refine(previous, next, 0);
+        previous = next;
+    }
+    return tessellation.polylines;
+}
+
+QVector<QPolygonF> EarthquakeMapWidget::tessellateRing(double latitude, double longitude, double radiusKm) const
+{
+    // Past half the circumference the ring would fold back on itself
+    const double radius = qMin(radiusKm, M_PI * EARTH_RADIUS_KM);
+    return tessellateCurve([=](double t) {
+        return SpatialUtils::calculateDestination(latitude, longitude, 360.0 * t, radius);
+    }, GEODESIC_MIN_SEGMENTS);
+}
+
+QVector<QPolygonF> EarthquakeMapWidget::tessellateGreatCircle(double lat1, double lon1, double lat2, double lon2) const
+{
+    return tessellateCurve([=](double t) {
+        return SpatialUtils::interpolateGreatCircle(lat1, lon1, lat2, lon2, t);
+    }, GEODESIC_MIN_SEGMENTS);
+}
+
+void EarthquakeMapWidget::updateGeodesicCache() const
+{
+    const GeodesicView view{m_centerLatitude, m_centerLongitude, m_zoomLevel, size(), m_settings.projection};
+    if (m_geodesicCacheValid && view == m_geodesicView) {
+        return;
+    }
+
+    m_ringPolylines.clear();
+    for (const DistanceRing &ring : m_distanceRings) {
+        m_ringPolylines.append(tessellateRing(ring.latitude, ring.longitude, ring.radiusKm));
+    }
+    m_pathPolylines.clear();
+    for (const GreatCirclePath &path : m_greatCirclePaths) {
+        m_pathPolylines.append(tessellateGreatCircle(path.startLatitude, path.startLongitude,
+                                                     path.endLatitude, path.endLongitude));
+    }
+
+    m_geodesicView = view;
+    m_geodesicCacheValid = true;
+}
+
 // Color and styling methods
 QColor EarthquakeMapWidget::getEarthquakeColor(const EarthquakeData &earthquake) const
 {
@@ -1803,6 +2055,41 @@ void EarthquakeMapWidget::updateVisibleEarthquakes()
     }
 }
 
+QColor EarthquakeMapWidget::intensityColor(double mmi)
+{
+    // USGS ShakeMap intensity scale, I to X+, blended between levels
+    static const QColor levels[] = {
+        QColor(255, 255, 255), QColor(191, 204, 255), QColor(160, 230, 255), QColor(128, 255, 255),
+        QColor(122, 255, 147), QColor(255, 255, 0), QColor(255, 200, 0), QColor(255, 145, 0),
+        QColor(255, 0, 0), QColor(200, 0, 0)
+    };
+    const int last = static_cast<int>(std::size(levels)) - 1;
+    const double position = qBound(0.0, mmi - 1.0, static_cast<double>(last));
+    const int lower = qMin(static_cast<int>(position), last - 1);
+    const double t = position - lower;
+
+    const QColor &a = levels[lower];
+    const QColor &b = levels[lower + 1];
+    return QColor(qRound(a.red() + t * (b.red() - a.red())),
+                  qRound(a.green() + t * (b.green() - a.green())),
+                  qRound(a.blue() + t * (b.blue() - a.blue())));
+}
+
+QImage EarthquakeMapWidget::intensityImage(const ShakeGrid &grid)
+{
+    QImage image(grid.columns, grid.rows, QImage::Format_ARGB32);
+    for (int r = 0; r < grid.rows; ++r) {
+        // Grid row 0 is the southern edge
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(grid.rows - 1 - r));
+        const float *cells = grid.intensity.constData() + r * grid.columns;
+        for (int c = 0; c < grid.columns; ++c) {
+            line[c] = cells[c] < GroundMotionEngine::MIN_GRID_INTENSITY ? qRgba(0, 0, 0, 0)
+                                                                         : intensityColor(cells[c]).rgb();
+        }
+    }
+    return image;
+}
+
 QString EarthquakeMapWidget::formatEarthquakeTooltip(const EarthquakeData &earthquake) const
 {
     QString tooltip = QString("<b>M%1 Earthquake</b><br>").arg(earthquake.magnitude, 0, 'f', 1);
@@ -2290,25 +2577,6 @@ int EarthquakeMapWidget::getEarthquakeCount() const
     return m_earthquakes.size();
 }
 
-// Network slots
-void EarthquakeMapWidget::onNetworkReplyFinished()
-{
-    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
-    
-    if (reply->error() == QNetworkReply::NoError) {
-        QByteArray data = reply->readAll();
-        // Process downloaded map data
-        QPixmap mapImage;
-        if (mapImage.loadFromData(data)) {
-            setBackgroundMap(mapImage);
-            emit backgroundMapLoaded();
-        }
-    }
-    
-    reply->deleteLater();
-}
-
 void EarthquakeMapWidget::onAnimationFinished()
 {
     // Animation finished - could trigger follow-up actions
@@ -2437,20 +2705,22 @@ void EarthquakeMapWidget::addEarthquakes(const QVector<EarthquakeData> &earthqua
 {
     // QMutexLocker locker(&m_dataMutex);
     
+    // Index existing events once so a large batch merges in linear time
+    QHash<QString, int> indexById;
+    indexById.reserve(m_earthquakes.size() + earthquakes.size());
+    for (int i = 0; i < m_earthquakes.size(); ++i) {
+        indexById.insert(m_earthquakes[i].data.eventId, i);
+    }
+    m_earthquakes.reserve(m_earthquakes.size() + earthquakes.size());
+    
     for (const auto &earthquake : earthquakes) {
         // Check if earthquake already exists
-        bool found = false;
-        for (int i = 0; i < m_earthquakes.size(); ++i) {
-            if (m_earthquakes[i].data.eventId == earthquake.eventId) {
-                // Update existing earthquake
-                m_earthquakes[i].data = earthquake;
-                m_earthquakes[i].lastUpdate = QDateTime::currentDateTime();
-                found = true;
-                break;
-            }
-        }
-        
-        if (!found) {
+        auto existing = indexById.constFind(earthquake.eventId);
+        if (existing != indexById.constEnd()) {
+            // Update existing earthquake
+            m_earthquakes[*existing].data = earthquake;
+            m_earthquakes[*existing].lastUpdate = QDateTime::currentDateTime();
+        } else {
             // Add new earthquake
             VisualEarthquake visualEq;
             visualEq.data = earthquake;
@@ -2466,6 +2736,7 @@ void EarthquakeMapWidget::addEarthquakes(const QVector<EarthquakeData> &earthqua
             visualEq.clusterId = -1;
             visualEq.isClusterCenter = false;
             
+            indexById.insert(earthquake.eventId, m_earthquakes.size());
             m_earthquakes.append(visualEq);
         }
     }
@@ -2525,6 +2796,48 @@ void EarthquakeMapWidget::updateEarthquake(const EarthquakeData &earthquake)
     update();
 }
 
+void EarthquakeMapWidget::setIntensityGrids(const QVector<std::shared_ptr<const ShakeGrid>> &grids)
+{
+    QVector<IntensityOverlay> overlays;
+    overlays.reserve(grids.size());
+
+    for (const auto &grid : grids) {
+        if (!grid) continue;
+
+        // Grids come from a cache, so unchanged events keep their image
+        auto existing = std::find_if(m_intensityOverlays.cbegin(), m_intensityOverlays.cend(),
+                                     [&grid](const IntensityOverlay &overlay) { return overlay.grid == grid; });
+        if (existing != m_intensityOverlays.cend()) {
+            overlays.append(*existing);
+        } else {
+            overlays.append({grid, intensityImage(*grid)});
+        }
+    }
+
+    m_intensityOverlays = std::move(overlays);
+    update();
+}
+
+void EarthquakeMapWidget::setDistanceRings(const QVector<DistanceRing> &rings)
+{
+    m_distanceRings = rings;
+    m_geodesicCacheValid = false;
+    update();
+}
+
+void EarthquakeMapWidget::setGreatCirclePaths(const QVector<GreatCirclePath> &paths)
+{
+    m_greatCirclePaths = paths;
+    m_geodesicCacheValid = false;
+    update();
+}
+
+void EarthquakeMapWidget::setWavefronts(const QVector<SeismicWavefront> &wavefronts)
+{
+    m_wavefronts = wavefronts;
+    update();
+}
+
 void EarthquakeMapWidget::zoomIn()
 {
     double newZoom = qBound(MIN_ZOOM, m_zoomLevel * ZOOM_FACTOR, MAX_ZOOM);
@@ -2593,25 +2906,21 @@ void EarthquakeMapWidget::setBackgroundMap(const QPixmap &map)
 
 void EarthquakeMapWidget::loadBackgroundMapFromUrl(const QString &url)
 {
-    if (!m_networkManager) {
+    // Downloading and decoding happen on the network thread; the result
+    // comes back through setBackgroundImage()
+    m_pendingBackgroundUrl = url;
+    emit backgroundMapRequested(url);
+}
+
+void EarthquakeMapWidget::setBackgroundImage(const QString &url, const QImage &image)
+{
+    if (url != m_pendingBackgroundUrl || image.isNull()) {
         return;
     }
     
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::UserAgentHeader, "EarthquakeMapWidget/1.0");
-    
-    QNetworkReply *reply = m_networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray data = reply->readAll();
-            QPixmap mapImage;
-            if (mapImage.loadFromData(data)) {
-                setBackgroundMap(mapImage);
-                emit backgroundMapLoaded();
-            }
-        }
-        reply->deleteLater();
-    });
+    m_pendingBackgroundUrl.clear();
+    setBackgroundMap(QPixmap::fromImage(image));
+    emit backgroundMapLoaded();
 }
 
 EarthquakeData EarthquakeMapWidget::getEarthquakeAt(const QPoint &point) const
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "earthquake_data.hpp"
+#include "ground_motion.hpp"
 
 #include <QtWidgets/QWidget>
 #include <QtGui/QPainter>
 #include <QtGui/QPixmap>
+#include <QtGui/QImage>
 #include <QtGui/QMouseEvent>
 #include <QtGui/QWheelEvent>
 #include <QtGui/QKeyEvent>
@@ -22,14 +24,14 @@
 #include <QAction>
 #include <QtWidgets/QToolTip>
 #include <QtWidgets/QRubberBand>
-#include <QtNetwork/QNetworkAccessManager>
-#include <QtNetwork/QNetworkRequest>
-#include <QtNetwork/QNetworkReply>
 #include <QVector>
 #include <QMap>
+#include <QHash>
 #include <QMutex>
 #include <QMutexLocker>
 #include <cmath>
+#include <functional>
+#include <memory>
 #include <QByteArray>
 
 // Forward declarations
@@ -113,6 +115,33 @@ struct MapBounds {
     }
 };
 
+// Circle of constant great-circle distance around a point, e.g. an alert radius
+struct DistanceRing {
+    double latitude = 0.0;
+    double longitude = 0.0;
+    double radiusKm = 0.0;
+    QColor color = QColor(255, 200, 80);
+    QString label;
+};
+
+// Shortest route between two points, drawn along the great circle
+struct GreatCirclePath {
+    double startLatitude = 0.0;
+    double startLongitude = 0.0;
+    double endLatitude = 0.0;
+    double endLongitude = 0.0;
+    QColor color = QColor(220, 220, 220);
+};
+
+// P and S fronts spreading from a hypocenter since its origin time
+struct SeismicWavefront {
+    QString eventId;
+    double latitude = 0.0;
+    double longitude = 0.0;
+    double depth = 0.0;
+    QDateTime originTime;
+};
+
 struct MapSettings {
     MapProjection projection = MapProjection::Mercator;
     QVector<MapLayer> enabledLayers = {MapLayer::Continents, MapLayer::Countries};
@@ -184,6 +213,13 @@ public:
     void removeEarthquake(const QString &eventId);
     void clearEarthquakes();
     void updateEarthquake(const EarthquakeData &earthquake);
+    // Predicted intensity drawn beneath the events; replaces the previous grids
+    void setIntensityGrids(const QVector<std::shared_ptr<const ShakeGrid>> &grids);
+    // Geodesic overlays, each replacing the previous set; drawn as curves
+    // true to the current projection
+    void setDistanceRings(const QVector<DistanceRing> &rings);
+    void setGreatCirclePaths(const QVector<GreatCirclePath> &paths);
+    void setWavefronts(const QVector<SeismicWavefront> &wavefronts);
     
     // Map control
     void setCenter(double latitude, double longitude);
@@ -270,8 +306,13 @@ signals:
     void selectionChanged(const QVector<EarthquakeData> &selected);
     void contextMenuRequested(const QPoint &position, const EarthquakeData &earthquake);
     void backgroundMapLoaded();
+    void backgroundMapRequested(const QString &url);
     void animationFrameUpdated(int frame);
 
+public slots:
+    // Receives images fetched and decoded on the network thread
+    void setBackgroundImage(const QString &url, const QImage &image);
+
 protected:
     // Event handling
     void paintEvent(QPaintEvent* event) override;
@@ -287,6 +328,8 @@ protected:
 
     void renderBackgroundWithCache(QPainter& painter);
     void renderDynamicContent(QPainter& painter);
+    void renderIntensityOverlay(QPainter& painter);
+    void renderGeodesicOverlays(QPainter& painter);
     void renderUIOverlays(QPainter& painter);
     void renderEarthquakesOptimized(QPainter& painter);
     void renderSingleEarthquake(QPainter& painter, const VisualEarthquake& eq);
@@ -309,7 +352,6 @@ protected:
 
 private slots:
     void updateAnimation();
-    void onNetworkReplyFinished();
     void onAnimationFinished();
     void onSelectionAnimationFinished();
 
@@ -333,6 +375,15 @@ private:
     QPointF orthographicProjection(double lat, double lon, bool northPole) const;
     QPointF robinsonProjection(double lat, double lon) const;
     
+    // Geodesic tessellation: screen polylines for curves on the globe,
+    // subdivided until each segment is within GEODESIC_TOLERANCE_PX of the
+    // projected curve, and split at the antimeridian and the horizon
+    bool isOnVisibleHemisphere(double latitude) const;
+    QVector<QPolygonF> tessellateCurve(const std::function<QPointF(double)> &curve, int segments) const;
+    QVector<QPolygonF> tessellateRing(double latitude, double longitude, double radiusKm) const;
+    QVector<QPolygonF> tessellateGreatCircle(double lat1, double lon1, double lat2, double lon2) const;
+    void updateGeodesicCache() const;
+    
     // Rendering methods
     void renderBackground(QPainter &painter) const;
     void renderMapLayers(QPainter &painter) const;
@@ -411,6 +462,8 @@ private:
     double calculateOptimalZoom(const MapBounds &bounds) const;
     QString formatCoordinate(double value, bool isLatitude) const;
     QString formatEarthquakeTooltip(const EarthquakeData &earthquake) const;
+    static QColor intensityColor(double mmi);
+    static QImage intensityImage(const ShakeGrid &grid);
     void showTooltip(const QPoint &pos, const QString &text);
     void hideTooltip();
 
@@ -461,9 +514,32 @@ private:
     QVector<QPolygonF> m_continentPolygons;
     QVector<QPolygonF> m_countryPolygons;
     QMap<MapBounds, QPixmap> m_mapTileCache;
-    
-    // Network for map loading
-    QNetworkAccessManager *m_networkManager;
+    QString m_pendingBackgroundUrl;
+
+    // Predicted intensity overlay, one image per grid with north at the top
+    struct IntensityOverlay {
+        std::shared_ptr<const ShakeGrid> grid;
+        QImage image;
+    };
+    QVector<IntensityOverlay> m_intensityOverlays;
+
+    // Geodesic overlays. Rings and paths are tessellated once per view;
+    // wavefronts grow every frame and are tessellated as they are drawn.
+    struct GeodesicView {
+        double centerLatitude;
+        double centerLongitude;
+        double zoomLevel;
+        QSize size;
+        MapProjection projection;
+        bool operator==(const GeodesicView &other) const = default;
+    };
+    QVector<DistanceRing> m_distanceRings;
+    QVector<GreatCirclePath> m_greatCirclePaths;
+    QVector<SeismicWavefront> m_wavefronts;
+    mutable QVector<QVector<QPolygonF>> m_ringPolylines;
+    mutable QVector<QVector<QPolygonF>> m_pathPolylines;
+    mutable GeodesicView m_geodesicView;
+    mutable bool m_geodesicCacheValid;
     
     // Filtering
     double m_minMagnitude;
@@ -500,6 +576,11 @@ private:
     static const double EARTH_RADIUS_KM;
     static const double DEFAULT_EARTHQUAKE_SIZE;
     static const int CLUSTER_EXPAND_DURATION_MS;
+    static const double INTENSITY_OVERLAY_OPACITY;
+    static const int INTENSITY_OVERLAY_STRIPS;
+    static const double GEODESIC_TOLERANCE_PX;
+    static const int GEODESIC_MAX_DEPTH;
+    static const int GEODESIC_MIN_SEGMENTS;
 };
 
 Q_DECLARE_METATYPE(EarthquakeMapWidget)
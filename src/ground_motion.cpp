@@ -0,0 +1,290 @@
+#include "ground_motion.hpp"
+#include "spatial_utils.hpp"
+
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
+#include <algorithm>
+#include <cmath>
+
+// Constants
+const double GroundMotionEngine::MIN_GRID_MAGNITUDE = 4.5;
+const double GroundMotionEngine::MIN_GRID_INTENSITY = 2.0; // II: felt by few
+const double GroundMotionEngine::MAX_GRID_RADIUS_KM = 1500.0;
+const int GroundMotionEngine::GRID_SIZE = 201;
+const int GroundMotionEngine::PROFILE_SIZE = 2048;
+
+namespace {
+
+// Atkinson, Worden & Wald (2014), BSSA 104(6)
+const double IPE_C1 = 0.309;
+const double IPE_C2 = 1.864;
+const double IPE_C3 = -1.672;
+const double IPE_C4 = -0.00219;
+const double IPE_C5 = 1.77;
+const double IPE_C6 = -0.383;
+
+// Worden, Gerstenberger, Rhoades & Wald (2012), BSSA 102(1), PGA in cm/s^2
+const double GMICE_C1 = 1.78;
+const double GMICE_C2 = 1.55;
+const double GMICE_C3 = -1.60;
+const double GMICE_C4 = 3.70;
+const double GMICE_T2 = 4.22;
+
+const double KM_PER_DEGREE = M_PI * SpatialUtils::EARTH_RADIUS_KM / 180.0;
+const int ROWS_PER_TASK = 16;
+
+double wrapLongitudeFrom(double longitude, double west)
+{
+    double offset = std::fmod(longitude - west, 360.0);
+    if (offset < 0.0) offset += 360.0;
+    return west + offset;
+}
+
+} // namespace
+
+
+double GroundMotionModel::intensity(double magnitude, double hypocentralKm)
+{
+    // Near-source saturation: effective depth grows with magnitude
+    const double h = qMax(1.0, std::pow(10.0, -1.72 + 0.43 * magnitude));
+    const double r = std::sqrt(hypocentralKm * hypocentralKm + h * h);
+    const double logR = std::log10(r);
+    const double b = qMax(0.0, std::log10(r / 50.0));
+
+    const double mmi = IPE_C1 + IPE_C2 * magnitude + IPE_C3 * logR + IPE_C4 * r
+                     + IPE_C5 * b + IPE_C6 * magnitude * logR;
+    return qMax(0.0, mmi);
+}
+
+double GroundMotionModel::hypocentralDistance(double epicentralKm, double depthKm)
+{
+    // Straight line through the Earth, not the flat-Earth sqrt(e^2 + h^2)
+    return SpatialUtils::hypocentralDistance(epicentralKm, depthKm);
+}
+
+double GroundMotionModel::pgaFromIntensity(double mmi)
+{
+    const double logPga = mmi <= GMICE_T2 ? (mmi - GMICE_C1) / GMICE_C2
+                                          : (mmi - GMICE_C3) / GMICE_C4;
+    return std::pow(10.0, logPga) / 9.80665; // cm/s^2 to %g
+}
+
+int GroundMotionModel::mercalliClass(double mmi)
+{
+    return qBound(1, static_cast<int>(std::lround(mmi)), 12);
+}
+
+
+bool ShakeGrid::contains(double lat, double lon) const
+{
+    if (rows < 2 || columns < 2) return false;
+    if (lat < southLatitude || lat > northLatitude()) return false;
+    return wrapLongitudeFrom(lon, westLongitude) <= eastLongitude();
+}
+
+double ShakeGrid::intensityAt(double lat, double lon) const
+{
+    if (!contains(lat, lon)) return 0.0;
+
+    const double y = (lat - southLatitude) / latitudeStep;
+    const double x = (wrapLongitudeFrom(lon, westLongitude) - westLongitude) / longitudeStep;
+    const int row = qBound(0, static_cast<int>(y), rows - 2);
+    const int column = qBound(0, static_cast<int>(x), columns - 2);
+    const double fy = y - row;
+    const double fx = x - column;
+
+    const float *cell = intensity.constData() + row * columns + column;
+    const double south = cell[0] + fx * (cell[1] - cell[0]);
+    const double north = cell[columns] + fx * (cell[columns + 1] - cell[columns]);
+    return south + fy * (north - south);
+}
+
+double ShakeGrid::pgaAt(double lat, double lon) const
+{
+    return contains(lat, lon) ? GroundMotionModel::pgaFromIntensity(intensityAt(lat, lon)) : 0.0;
+}
+
+
+GroundMotionEngine::GroundMotionEngine(int maxCachedGrids)
+    : m_useCounter(0)
+    , m_maxCachedGrids(qMax(1, maxCachedGrids))
+{
+}
+
+std::shared_ptr<const ShakeGrid> GroundMotionEngine::gridFor(const EarthquakeData &earthquake)
+{
+    if (earthquake.magnitude < MIN_GRID_MAGNITUDE) return nullptr;
+
+    if (!earthquake.eventId.isEmpty()) {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_cache.find(earthquake.eventId);
+        if (it != m_cache.end() && isCurrent(*it->grid, earthquake)) {
+            it->lastUse = ++m_useCounter;
+            return it->grid;
+        }
+    }
+
+    // Computed outside the lock; a concurrent caller may compute the same grid
+    std::shared_ptr<const ShakeGrid> grid = computeGrid(earthquake);
+    if (!grid || earthquake.eventId.isEmpty()) return grid;
+
+    QMutexLocker locker(&m_mutex);
+    m_cache.insert(earthquake.eventId, CacheEntry{grid, ++m_useCounter});
+    if (m_cache.size() > m_maxCachedGrids) {
+        auto oldest = std::min_element(m_cache.begin(), m_cache.end(),
+                                       [](const CacheEntry &a, const CacheEntry &b) { return a.lastUse < b.lastUse; });
+        m_cache.erase(oldest);
+    }
+    return grid;
+}
+
+double GroundMotionEngine::intensityAt(const EarthquakeData &earthquake, double latitude, double longitude)
+{
+    std::shared_ptr<const ShakeGrid> grid = gridFor(earthquake);
+    if (grid && grid->contains(latitude, longitude)) {
+        return grid->intensityAt(latitude, longitude);
+    }
+
+    double epicentral = SpatialUtils::haversineDistance(latitude, longitude, earthquake.latitude, earthquake.longitude);
+    return GroundMotionModel::intensity(earthquake.magnitude,
+                                        GroundMotionModel::hypocentralDistance(epicentral, earthquake.depth));
+}
+
+int GroundMotionEngine::cachedGridCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_cache.size();
+}
+
+void GroundMotionEngine::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.clear();
+}
+
+bool GroundMotionEngine::isCurrent(const ShakeGrid &grid, const EarthquakeData &earthquake)
+{
+    return grid.magnitude == earthquake.magnitude && grid.depth == earthquake.depth
+        && grid.latitude == earthquake.latitude && grid.longitude == earthquake.longitude;
+}
+
+double GroundMotionEngine::gridRadiusKm(double magnitude, double depth)
+{
+    auto intensityAt = [&](double km) {
+        return GroundMotionModel::intensity(magnitude, GroundMotionModel::hypocentralDistance(km, depth));
+    };
+    if (intensityAt(0.0) < MIN_GRID_INTENSITY) return 0.0;
+    if (intensityAt(MAX_GRID_RADIUS_KM) >= MIN_GRID_INTENSITY) return MAX_GRID_RADIUS_KM;
+
+    // Intensity decreases monotonically with distance
+    double inside = 0.0;
+    double outside = MAX_GRID_RADIUS_KM;
+    while (outside - inside > 1.0) {
+        double middle = (inside + outside) / 2.0;
+        (intensityAt(middle) >= MIN_GRID_INTENSITY ? inside : outside) = middle;
+    }
+    return outside;
+}
+
+std::shared_ptr<ShakeGrid> GroundMotionEngine::computeGrid(const EarthquakeData &eq)
+{
+    const double radiusKm = gridRadiusKm(eq.magnitude, eq.depth);
+    if (radiusKm <= 0.0) return nullptr;
+
+    auto grid = std::make_shared<ShakeGrid>();
+    grid->eventId = eq.eventId;
+    grid->magnitude = eq.magnitude;
+    grid->depth = eq.depth;
+    grid->latitude = eq.latitude;
+    grid->longitude = eq.longitude;
+
+    const double halfLatitude = radiusKm / KM_PER_DEGREE;
+    const double halfLongitude = qMin(180.0, radiusKm / (KM_PER_DEGREE * qMax(0.01, std::cos(eq.latitude * M_PI / 180.0))));
+    const double south = qMax(-90.0, eq.latitude - halfLatitude);
+    const double north = qMin(90.0, eq.latitude + halfLatitude);
+
+    grid->rows = GRID_SIZE;
+    grid->columns = GRID_SIZE;
+    grid->southLatitude = south;
+    grid->latitudeStep = (north - south) / (GRID_SIZE - 1);
+    grid->westLongitude = eq.longitude - halfLongitude;
+    grid->longitudeStep = 2.0 * halfLongitude / (GRID_SIZE - 1);
+    grid->intensity.resize(GRID_SIZE * GRID_SIZE);
+
+    // Haversine split: h = sin^2(dlat/2) + cos(lat0) cos(lat) sin^2(dlon/2),
+    // the first two factors per row and the last per column
+    const double lat0 = eq.latitude * M_PI / 180.0;
+    QVector<float> rowA(GRID_SIZE);
+    QVector<float> rowB(GRID_SIZE);
+    QVector<float> columnS(GRID_SIZE);
+    double maxColumnS = 0.0;
+    for (int c = 0; c < GRID_SIZE; ++c) {
+        double dlon = (grid->westLongitude + c * grid->longitudeStep - eq.longitude) * M_PI / 180.0;
+        double s = std::sin(dlon / 2.0);
+        columnS[c] = static_cast<float>(s * s);
+        maxColumnS = qMax(maxColumnS, s * s);
+    }
+    double maxH = 0.0;
+    for (int r = 0; r < GRID_SIZE; ++r) {
+        double lat = (south + r * grid->latitudeStep) * M_PI / 180.0;
+        double s = std::sin((lat - lat0) / 2.0);
+        rowA[r] = static_cast<float>(s * s);
+        rowB[r] = static_cast<float>(std::cos(lat0) * std::cos(lat));
+        maxH = qMax(maxH, s * s + std::cos(lat0) * std::cos(lat) * maxColumnS);
+    }
+
+    // Intensity against s = sqrt(h) = sin(d / 2R), nearly linear in distance
+    const double maxS = qMin(1.0, std::sqrt(maxH));
+    const double profileStep = maxS > 0.0 ? maxS / (PROFILE_SIZE - 1) : 1.0;
+    QVector<float> profile(PROFILE_SIZE);
+    for (int i = 0; i < PROFILE_SIZE; ++i) {
+        double epicentral = 2.0 * SpatialUtils::EARTH_RADIUS_KM * std::asin(qMin(1.0, i * profileStep));
+        profile[i] = static_cast<float>(GroundMotionModel::intensity(
+            eq.magnitude, GroundMotionModel::hypocentralDistance(epicentral, eq.depth)));
+    }
+    grid->maxIntensity = profile[0];
+
+    const float *a = rowA.constData();
+    const float *b = rowB.constData();
+    const float *columns = columnS.constData();
+    const float *table = profile.constData();
+    float *cells = grid->intensity.data();
+    const float invStep = static_cast<float>(1.0 / profileStep);
+    const float maxX = static_cast<float>(PROFILE_SIZE - 1);
+    const int lastIndex = PROFILE_SIZE - 2;
+
+    auto fillRows = [=](int firstRow, int endRow) {
+        for (int r = firstRow; r < endRow; ++r) {
+            const float rowOffset = a[r];
+            const float rowScale = b[r];
+            float *out = cells + r * GRID_SIZE;
+            for (int c = 0; c < GRID_SIZE; ++c) {
+                const float x = std::min(std::sqrt(rowOffset + rowScale * columns[c]) * invStep, maxX);
+                const int i = std::min(static_cast<int>(x), lastIndex);
+                const float f = x - static_cast<float>(i);
+                out[c] = table[i] + f * (table[i + 1] - table[i]);
+            }
+        }
+    };
+
+    // Tasks the pool cannot take right away run inline, so this never waits
+    // on a saturated pool
+    QSemaphore done;
+    int tasks = 0;
+    for (int first = ROWS_PER_TASK; first < GRID_SIZE; first += ROWS_PER_TASK) {
+        const int end = qMin(first + ROWS_PER_TASK, GRID_SIZE);
+        auto task = [&done, fillRows, first, end]() {
+            fillRows(first, end);
+            done.release();
+        };
+        if (!QThreadPool::globalInstance()->tryStart(task)) {
+            task();
+        }
+        tasks++;
+    }
+    fillRows(0, qMin(ROWS_PER_TASK, GRID_SIZE));
+    done.acquire(tasks);
+
+    return grid;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "earthquake_data.hpp"
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QVector>
+#include <memory>
+
+
+// Ground-motion prediction for a point source.
+//
+// Intensity uses the Atkinson, Worden & Wald (2014) intensity prediction
+// equation with hypocentral distance and magnitude-dependent near-source
+// saturation. PGA is derived from intensity with the Worden et al. (2012)
+// ground-motion/intensity conversion, inverted.
+class GroundMotionModel
+{
+public:
+    // Modified Mercalli intensity (continuous, >= 0)
+    static double intensity(double magnitude, double hypocentralKm);
+    static double hypocentralDistance(double epicentralKm, double depthKm);
+    // Peak ground acceleration in %g
+    static double pgaFromIntensity(double mmi);
+    // Rounded Roman-numeral class, 1 (I) to 12 (XII)
+    static int mercalliClass(double mmi);
+};
+
+// Predicted intensity on a regular latitude/longitude grid centered on an
+// event. Row 0 is the southern edge; cells are stored row-major.
+struct ShakeGrid {
+    QString eventId;
+    double magnitude = 0.0;
+    double depth = 0.0;
+    double latitude = 0.0;
+    double longitude = 0.0;
+
+    double southLatitude = 0.0;
+    double westLongitude = 0.0;
+    double latitudeStep = 0.0;
+    double longitudeStep = 0.0;
+    int rows = 0;
+    int columns = 0;
+    QVector<float> intensity;
+    float maxIntensity = 0.0f;
+
+    bool contains(double latitude, double longitude) const;
+    // Bilinear interpolation; 0 outside the grid
+    double intensityAt(double latitude, double longitude) const;
+    double pgaAt(double latitude, double longitude) const;
+    double northLatitude() const { return southLatitude + (rows - 1) * latitudeStep; }
+    double eastLongitude() const { return westLongitude + (columns - 1) * longitudeStep; }
+};
+
+// Computes and caches shake grids for significant events. A grid covers the
+// area where predicted intensity reaches MIN_GRID_INTENSITY. Intensity only
+// depends on epicentral distance, so it is tabulated once per event against
+// s = sin(d / 2R); each cell then needs one multiply-add, a square root and a
+// table interpolation, in a branch-free float loop over a row that the
+// compiler vectorizes. Rows are split across the global thread pool. Grids
+// are cached by event id and recomputed when the event is revised.
+class GroundMotionEngine
+{
+public:
+    explicit GroundMotionEngine(int maxCachedGrids = 64);
+
+    // Thread-safe. Null for events below MIN_GRID_MAGNITUDE.
+    std::shared_ptr<const ShakeGrid> gridFor(const EarthquakeData &earthquake);
+    // From the cached grid when there is one, otherwise from the model directly
+    double intensityAt(const EarthquakeData &earthquake, double latitude, double longitude);
+
+    int cachedGridCount() const;
+    void clear();
+
+    static std::shared_ptr<ShakeGrid> computeGrid(const EarthquakeData &earthquake);
+
+    static const double MIN_GRID_MAGNITUDE;
+    static const double MIN_GRID_INTENSITY;
+    static const double MAX_GRID_RADIUS_KM;
+    static const int GRID_SIZE;
+    static const int PROFILE_SIZE;
+
+private:
+    struct CacheEntry {
+        std::shared_ptr<const ShakeGrid> grid;
+        quint64 lastUse;
+    };
+
+    static bool isCurrent(const ShakeGrid &grid, const EarthquakeData &earthquake);
+    static double gridRadiusKm(double magnitude, double depth);
+
+    mutable QMutex m_mutex;
+    QHash<QString, CacheEntry> m_cache;
+    quint64 m_useCounter;
+    int m_maxCachedGrids;
+};
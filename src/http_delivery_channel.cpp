@@ -0,0 +1,404 @@
+#include "http_delivery_channel.hpp"
+#include "metrics_registry.hpp"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QSet>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+#include <algorithm>
+
+// Constants
+const QString HttpDeliveryChannel::METRIC_REQUESTS = "earthquake_outbound_requests_total";
+const QString HttpDeliveryChannel::METRIC_MESSAGES = "earthquake_outbound_messages_total";
+const QString HttpDeliveryChannel::METRIC_PENDING = "earthquake_outbound_pending";
+const QString HttpDeliveryChannel::METRIC_REQUEST_SECONDS = "earthquake_outbound_request_seconds";
+
+
+namespace {
+
+bool isTransient(int httpStatus)
+{
+    // No status means the request never got a reply: connection refused, reset or timed out
+    return httpStatus == 0 || httpStatus == 408 || httpStatus == 429 || httpStatus >= 500;
+}
+
+// Retry-After as delay-seconds or an HTTP date; 0 when absent or unparsable
+qint64 retryAfterMs(QNetworkReply *reply, qint64 nowMs)
+{
+    const QByteArray value = reply->rawHeader("Retry-After").trimmed();
+    if (value.isEmpty()) {
+        return 0;
+    }
+
+    bool ok = false;
+    const qint64 seconds = value.toLongLong(&ok);
+    if (ok) {
+        return std::max<qint64>(0, seconds * 1000);
+    }
+
+    const QDateTime at = QDateTime::fromString(QString::fromLatin1(value), Qt::RFC2822Date);
+    return at.isValid() ? std::max<qint64>(0, at.toMSecsSinceEpoch() - nowMs) : 0;
+}
+
+} // namespace
+
+
+HttpDeliveryChannel::HttpDeliveryChannel(const Config &config, MetricsRegistry *metrics, QObject *parent)
+    : QObject(parent)
+    , m_config(config)
+    , m_metrics(metrics)
+    , m_network(new QNetworkAccessManager(this))
+    , m_pumpTimer(new QTimer(this))
+    , m_inFlight(0)
+    , m_inFlightMessages(0)
+{
+    m_config.batchSize = std::max(1, m_config.batchSize);
+    m_config.maxInFlight = std::max(1, m_config.maxInFlight);
+    m_config.maxAttempts = std::max(1, m_config.maxAttempts);
+
+    m_pumpTimer->setSingleShot(true);
+    connect(m_pumpTimer, &QTimer::timeout, this, &HttpDeliveryChannel::pump);
+
+    if (m_metrics) {
+        m_metrics->describe(METRIC_REQUESTS, "Outbound delivery requests, by channel and result");
+        m_metrics->describe(METRIC_MESSAGES, "Outbound messages, by channel and result");
+        m_metrics->describe(METRIC_PENDING, "Outbound messages queued or waiting to retry, by channel");
+        m_metrics->describe(METRIC_REQUEST_SECONDS, "Outbound delivery request latency, by channel");
+    }
+}
+
+HttpDeliveryChannel::~HttpDeliveryChannel()
+{
+    // Aborting emits finished; detach first so no handler runs on a half-destroyed channel
+    const QList<QNetworkReply *> replies = m_network->findChildren<QNetworkReply *>();
+    for (QNetworkReply *reply : replies) {
+        reply->disconnect(this);
+        reply->abort();
+    }
+
+    const int lost = pendingCount() + m_inFlightMessages;
+    if (lost > 0) {
+        qWarning() << "Delivery channel" << m_config.name << "discarded" << lost << "undelivered messages";
+    }
+}
+
+bool HttpDeliveryChannel::enqueue(const OutboundMessage &message)
+{
+    if (pendingCount() + m_inFlightMessages >= m_config.maxQueued) {
+        countMessages("dropped", 1);
+        return false;
+    }
+
+    m_pending.enqueue(message);
+    schedulePump(m_config.flushDelayMs);
+    return true;
+}
+
+int HttpDeliveryChannel::enqueue(const QVector<OutboundMessage> &messages)
+{
+    const int room = std::max(0, m_config.maxQueued - pendingCount() - m_inFlightMessages);
+    const int accepted = std::min(room, int(messages.size()));
+
+    for (int i = 0; i < accepted; ++i) {
+        m_pending.enqueue(messages[i]);
+    }
+    if (accepted < messages.size()) {
+        countMessages("dropped", messages.size() - accepted);
+    }
+    if (accepted > 0) {
+        schedulePump(m_config.flushDelayMs);
+    }
+    return accepted;
+}
+
+void HttpDeliveryChannel::setEndpoint(const QUrl &endpoint)
+{
+    m_config.endpoint = endpoint;
+    if (!m_pending.isEmpty()) {
+        schedulePump(0);
+    }
+}
+
+void HttpDeliveryChannel::pump()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    promoteDueRetries(now);
+
+    if (m_config.endpoint.isValid()) {
+        while (m_inFlight < m_config.maxInFlight && !m_pending.isEmpty()) {
+            QVector<OutboundMessage> batch;
+            batch.reserve(std::min(m_config.batchSize, int(m_pending.size())));
+            while (batch.size() < m_config.batchSize && !m_pending.isEmpty()) {
+                batch.append(m_pending.dequeue());
+            }
+            send(batch);
+        }
+    } else if (!m_pending.isEmpty()) {
+        qWarning() << "Delivery channel" << m_config.name << "has no endpoint;"
+                   << m_pending.size() << "messages held";
+    }
+
+    if (!m_retrying.isEmpty()) {
+        qint64 nextRetry = m_retrying.first().notBeforeMs;
+        for (const OutboundMessage &message : m_retrying) {
+            nextRetry = std::min(nextRetry, message.notBeforeMs);
+        }
+        schedulePump(int(std::clamp<qint64>(nextRetry - now, 0, m_config.maxBackoffMs)));
+    }
+
+    updatePendingGauge();
+    if (m_inFlight == 0 && pendingCount() == 0) {
+        emit idle();
+    }
+}
+
+void HttpDeliveryChannel::send(const QVector<OutboundMessage> &batch)
+{
+    QVector<OutboundMessage> sent = batch;
+    for (OutboundMessage &message : sent) {
+        ++message.attempts;
+    }
+
+    QNetworkRequest request(m_config.endpoint);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    request.setTransferTimeout(m_config.requestTimeoutMs);
+
+    ++m_inFlight;
+    m_inFlightMessages += sent.size();
+
+    const qint64 startedMs = QDateTime::currentMSecsSinceEpoch();
+    QNetworkReply *reply = m_network->post(request, buildBody(sent));
+    connect(reply, &QNetworkReply::finished, this, [this, reply, sent, startedMs]() {
+        onReplyFinished(reply, sent, startedMs);
+    });
+}
+
+void HttpDeliveryChannel::onReplyFinished(QNetworkReply *reply, const QVector<OutboundMessage> &batch, qint64 startedMs)
+{
+    reply->deleteLater();
+    --m_inFlight;
+    m_inFlightMessages -= batch.size();
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const bool success = status >= 200 && status < 300;
+
+    if (m_metrics) {
+        const QString channel = MetricsRegistry::formatLabels({{"channel", m_config.name}});
+        m_metrics->recordLatency(METRIC_REQUEST_SECONDS, channel, (now - startedMs) * 1000);
+        const QString result = success ? "ok" : (status == 0 ? "network_error" : QString::number(status));
+        m_metrics->incrementCounter(METRIC_REQUESTS, MetricsRegistry::formatLabels(
+            {{"channel", m_config.name}, {"result", result}}));
+    }
+
+    QVector<OutboundMessage> retry;
+    QVector<OutboundMessage> rejected;
+    QString error;
+    int delivered = 0;
+
+    if (success) {
+        // Recipients the service could not take this time, e.g. a throttled SMS route
+        QSet<QString> failed;
+        const QJsonObject body = QJsonDocument::fromJson(reply->readAll()).object();
+        for (const QJsonValue &recipient : body.value("failed").toArray()) {
+            failed.insert(recipient.toString());
+        }
+        for (const OutboundMessage &message : batch) {
+            if (failed.contains(message.recipient)) {
+                retry.append(message);
+            } else {
+                ++delivered;
+            }
+        }
+        error = "Rejected by service";
+    } else {
+        error = status > 0 ? QString("HTTP %1").arg(status) : reply->errorString();
+        if (isTransient(status)) {
+            retry = batch;
+        } else {
+            rejected = batch;
+        }
+    }
+
+    const qint64 delayFloor = retry.isEmpty() ? 0 : retryAfterMs(reply, now);
+    int retried = 0;
+    for (OutboundMessage &message : retry) {
+        if (message.attempts >= m_config.maxAttempts) {
+            rejected.append(message);
+            continue;
+        }
+        message.notBeforeMs = now + std::max(backoffMs(message.attempts), delayFloor);
+        m_retrying.append(message);
+        ++retried;
+        emit messageRetrying(message.notificationId, message.recipient, message.attempts);
+    }
+
+    if (delivered > 0) {
+        countMessages("delivered", delivered);
+        emit batchDelivered(delivered);
+    }
+    if (retried > 0) {
+        countMessages("retried", retried);
+        qDebug() << "Delivery channel" << m_config.name << "retrying" << retried << "messages:" << error;
+    }
+    if (!rejected.isEmpty()) {
+        deadLetter(rejected, error);
+    }
+
+    pump();
+}
+
+void HttpDeliveryChannel::deadLetter(const QVector<OutboundMessage> &messages, const QString &error)
+{
+    countMessages("dead_letter", messages.size());
+    qWarning() << "Delivery channel" << m_config.name << "gave up on" << messages.size() << "messages:" << error;
+
+    if (!m_config.deadLetterPath.isEmpty()) {
+        QDir().mkpath(QFileInfo(m_config.deadLetterPath).absolutePath());
+        QFile file(m_config.deadLetterPath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            const QString timestamp = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+            QByteArray lines;
+            for (const OutboundMessage &message : messages) {
+                QJsonObject record;
+                record["ts"] = timestamp;
+                record["channel"] = m_config.name;
+                record["notificationId"] = message.notificationId;
+                record["recipient"] = message.recipient;
+                record["attempts"] = message.attempts;
+                record["error"] = error;
+                record["payload"] = message.payload;
+                lines += QJsonDocument(record).toJson(QJsonDocument::Compact);
+                lines += '\n';
+            }
+            file.write(lines);
+        } else {
+            qWarning() << "Cannot write dead letters to" << m_config.deadLetterPath << ":" << file.errorString();
+        }
+    }
+
+    for (const OutboundMessage &message : messages) {
+        emit messageFailed(message.notificationId, message.recipient, error);
+    }
+}
+
+int HttpDeliveryChannel::replayDeadLetters(QString *errorMessage)
+{
+    QFile file(m_config.deadLetterPath);
+    if (m_config.deadLetterPath.isEmpty() || !file.exists()) {
+        return 0;
+    }
+    if (!file.open(QIODevice::ReadWrite)) {
+        if (errorMessage) {
+            *errorMessage = file.errorString();
+        }
+        return 0;
+    }
+
+    QVector<OutboundMessage> messages;
+    QByteArray kept; // Lines that do not fit in the queue stay in the file
+    int room = std::max(0, m_config.maxQueued - pendingCount() - m_inFlightMessages);
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        const QJsonObject record = QJsonDocument::fromJson(line).object();
+        if (record.isEmpty()) {
+            continue;
+        }
+        if (room == 0) {
+            kept += line;
+            continue;
+        }
+
+        OutboundMessage message;
+        message.notificationId = record.value("notificationId").toString();
+        message.recipient = record.value("recipient").toString();
+        message.payload = record.value("payload").toObject();
+        messages.append(message);
+        --room;
+    }
+
+    file.resize(0);
+    file.write(kept);
+    file.close();
+
+    return enqueue(messages);
+}
+
+void HttpDeliveryChannel::promoteDueRetries(qint64 nowMs)
+{
+    // Retries keep their relative order and go behind messages already waiting
+    auto due = std::stable_partition(m_retrying.begin(), m_retrying.end(),
+                                     [nowMs](const OutboundMessage &message) {
+                                         return message.notBeforeMs > nowMs;
+                                     });
+    for (auto it = due; it != m_retrying.end(); ++it) {
+        m_pending.enqueue(*it);
+    }
+    m_retrying.erase(due, m_retrying.end());
+}
+
+void HttpDeliveryChannel::schedulePump(int delayMs)
+{
+    if (!m_pumpTimer->isActive() || m_pumpTimer->remainingTime() > delayMs) {
+        m_pumpTimer->start(delayMs);
+    }
+}
+
+void HttpDeliveryChannel::countMessages(const QString &result, int count)
+{
+    if (m_metrics && count > 0) {
+        m_metrics->incrementCounter(METRIC_MESSAGES, MetricsRegistry::formatLabels(
+            {{"channel", m_config.name}, {"result", result}}), count);
+    }
+}
+
+void HttpDeliveryChannel::updatePendingGauge()
+{
+    if (m_metrics) {
+        m_metrics->setGauge(METRIC_PENDING, MetricsRegistry::formatLabels({{"channel", m_config.name}}),
+                            pendingCount() + m_inFlightMessages);
+    }
+}
+
+QByteArray HttpDeliveryChannel::buildBody(const QVector<OutboundMessage> &batch) const
+{
+    QJsonArray messages;
+    int i = 0;
+    while (i < batch.size()) {
+        const OutboundMessage &first = batch[i];
+        QJsonArray recipients;
+        while (i < batch.size() && batch[i].notificationId == first.notificationId) {
+            recipients.append(batch[i].recipient);
+            ++i;
+        }
+
+        QJsonObject entry;
+        entry["notificationId"] = first.notificationId;
+        entry["recipients"] = recipients;
+        entry["payload"] = first.payload;
+        messages.append(entry);
+    }
+
+    QJsonObject body;
+    body["channel"] = m_config.name;
+    body["messages"] = messages;
+    return QJsonDocument(body).toJson(QJsonDocument::Compact);
+}
+
+qint64 HttpDeliveryChannel::backoffMs(int attempts) const
+{
+    // Exponential with "equal jitter": half fixed, half random, so retries
+    // from one failed fan-out do not come back as a single burst
+    const int shift = std::clamp(attempts - 1, 0, 20);
+    const qint64 ceiling = std::min<qint64>(qint64(m_config.initialBackoffMs) << shift, m_config.maxBackoffMs);
+    const qint64 half = ceiling / 2;
+    return half + (half > 0 ? QRandomGenerator::global()->bounded(half + 1) : 0);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QQueue>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <QtCore/QUrl>
+#include <QObject>
+#include <QVector>
+
+class MetricsRegistry;
+class QNetworkAccessManager;
+class QNetworkReply;
+
+
+// One notification addressed to one recipient. Messages for the same
+// notification share a payload and are sent together in one request.
+struct OutboundMessage {
+    QString notificationId;
+    QString recipient;
+    QJsonObject payload;
+    int attempts = 0;
+    qint64 notBeforeMs = 0; // Earliest retry time, ms since epoch
+};
+
+// Batched HTTP delivery to an external email/SMS/push service.
+//
+// Messages are queued and sent in batches of up to batchSize recipients per
+// POST, with at most maxInFlight requests outstanding. The body is
+//   {"channel": name, "messages": [{"notificationId", "recipients": [...],
+//                                   "payload": {...}}, ...]}
+// where consecutive messages for the same notification are grouped. Requests
+// go through one QNetworkAccessManager, which keeps connections to the
+// service alive between batches; maxInFlight should stay within its six
+// connections per host.
+//
+// A 2xx reply delivers the batch, except for recipients listed in an optional
+// "failed" array in the reply, which are retried. Network errors, timeouts,
+// 408, 429 and 5xx are retried with exponential backoff and jitter, honoring
+// Retry-After. Other 4xx replies, and messages that run out of attempts, are
+// appended to the dead-letter file as JSON Lines.
+class HttpDeliveryChannel : public QObject
+{
+    Q_OBJECT
+public:
+    struct Config {
+        QString name;
+        QUrl endpoint;
+        int batchSize = 100;
+        int maxInFlight = 4;
+        int maxAttempts = 5;
+        int initialBackoffMs = 1000;
+        int maxBackoffMs = 60000;
+        int requestTimeoutMs = 30000;
+        int flushDelayMs = 50; // Lets a fan-out fill its batches before sending
+        int maxQueued = 100000;
+        QString deadLetterPath; // Empty disables dead-letter persistence
+    };
+
+    explicit HttpDeliveryChannel(const Config &config, MetricsRegistry *metrics = nullptr,
+                                 QObject *parent = nullptr);
+    ~HttpDeliveryChannel() override;
+
+    // Returns false when the channel already holds maxQueued messages
+    bool enqueue(const OutboundMessage &message);
+    // Number of messages accepted; the rest are dropped
+    int enqueue(const QVector<OutboundMessage> &messages);
+
+    void setEndpoint(const QUrl &endpoint);
+    QUrl endpoint() const { return m_config.endpoint; }
+    QString name() const { return m_config.name; }
+
+    int pendingCount() const { return m_pending.size() + m_retrying.size(); }
+    int inFlightCount() const { return m_inFlight; }
+    int inFlightMessageCount() const { return m_inFlightMessages; }
+
+    // Moves dead letters back into the queue with their attempts reset and
+    // truncates the file. Returns the number requeued.
+    int replayDeadLetters(QString *errorMessage = nullptr);
+
+    static const QString METRIC_REQUESTS;
+    static const QString METRIC_MESSAGES;
+    static const QString METRIC_PENDING;
+    static const QString METRIC_REQUEST_SECONDS;
+
+signals:
+    void batchDelivered(int messageCount);
+    void messageRetrying(const QString &notificationId, const QString &recipient, int attempts);
+    void messageFailed(const QString &notificationId, const QString &recipient, const QString &error);
+    void idle();
+
+private slots:
+    void pump();
+
+private:
+    void send(const QVector<OutboundMessage> &batch);
+    void onReplyFinished(QNetworkReply *reply, const QVector<OutboundMessage> &batch, qint64 startedMs);
+    void deadLetter(const QVector<OutboundMessage> &messages, const QString &error);
+    void promoteDueRetries(qint64 nowMs);
+    void schedulePump(int delayMs);
+    void countMessages(const QString &result, int count);
+    void updatePendingGauge();
+    QByteArray buildBody(const QVector<OutboundMessage> &batch) const;
+    qint64 backoffMs(int attempts) const;
+
+    Config m_config;
+    MetricsRegistry *m_metrics;
+    QNetworkAccessManager *m_network;
+    QTimer *m_pumpTimer;
+    QQueue<OutboundMessage> m_pending;
+    QVector<OutboundMessage> m_retrying; // Waiting for notBeforeMs
+    int m_inFlight;
+    int m_inFlightMessages;
+};
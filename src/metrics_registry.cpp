@@ -0,0 +1,251 @@
+#include "metrics_registry.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <QtCore/QTextStream>
+
+// Constants
+const int LatencyHistogram::SUB_BUCKET_COUNT = 32;
+const qint64 LatencyHistogram::MAX_TRACKABLE_US = (qint64(1) << 36) - 1;
+
+const QVector<qint64> MetricsRegistry::EXPORT_BUCKET_BOUNDS_US = {
+    1000, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+    1000000, 2500000, 5000000, 10000000, 30000000, 60000000
+};
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+int LatencyHistogram::bucketIndex(qint64 valueUs)
+{
+    // Values below SUB_BUCKET_COUNT get exact buckets; above that each power of two
+    // is split into 16 linear sub-buckets, which bounds the relative error to 1/16
+    quint64 v = static_cast<quint64>(qBound<qint64>(0, valueUs, MAX_TRACKABLE_US));
+    if (v < static_cast<quint64>(SUB_BUCKET_COUNT)) {
+        return static_cast<int>(v);
+    }
+
+    int msb = std::bit_width(v) - 1;
+    int shift = msb - 4;
+    int sub = static_cast<int>(v >> shift) - 16;
+    return SUB_BUCKET_COUNT + (shift - 1) * 16 + sub;
+}
+
+qint64 LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    int shift = (index - SUB_BUCKET_COUNT) / 16 + 1;
+    qint64 sub = (index - SUB_BUCKET_COUNT) % 16 + 16;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(qint64 valueUs)
+{
+    valueUs = qMax<qint64>(0, valueUs);
+    m_buckets[bucketIndex(valueUs)]++;
+    m_count++;
+    m_sum += valueUs;
+    m_min = qMin(m_min, valueUs);
+    m_max = qMax(m_max, valueUs);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = qMin(m_min, other.m_min);
+    m_max = qMax(m_max, other.m_max);
+}
+
+void LatencyHistogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_sum = 0;
+    m_min = std::numeric_limits<qint64>::max();
+    m_max = 0;
+}
+
+double LatencyHistogram::mean() const
+{
+    return m_count > 0 ? static_cast<double>(m_sum) / m_count : 0.0;
+}
+
+qint64 LatencyHistogram::percentile(double percent) const
+{
+    if (m_count == 0) return 0;
+
+    qint64 target = static_cast<qint64>(qBound(0.0, percent, 100.0) / 100.0 * m_count + 0.5);
+    target = qBound<qint64>(1, target, m_count);
+
+    qint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += m_buckets[i];
+        if (seen >= target) {
+            return qMin(bucketUpperBound(i), m_max);
+        }
+    }
+    return m_max;
+}
+
+qint64 LatencyHistogram::countAtOrBelow(qint64 upperBoundUs) const
+{
+    if (upperBoundUs < 0) return 0;
+
+    qint64 total = 0;
+    const int last = bucketIndex(upperBoundUs);
+    for (int i = 0; i <= last; ++i) {
+        total += m_buckets[i];
+    }
+    return total;
+}
+
+void MetricsRegistry::describe(const QString &name, const QString &help)
+{
+    QMutexLocker locker(&m_mutex);
+    m_help[name] = help;
+}
+
+void MetricsRegistry::incrementCounter(const QString &name, const QString &labels, qint64 delta)
+{
+    QMutexLocker locker(&m_mutex);
+    m_counters[name][labels] += delta;
+}
+
+void MetricsRegistry::setGauge(const QString &name, const QString &labels, double value)
+{
+    QMutexLocker locker(&m_mutex);
+    m_gauges[name][labels] = value;
+}
+
+void MetricsRegistry::recordLatency(const QString &name, const QString &labels, qint64 microseconds)
+{
+    QMutexLocker locker(&m_mutex);
+    m_histograms[name][labels].record(microseconds);
+}
+
+qint64 MetricsRegistry::counter(const QString &name, const QString &labels) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_counters.value(name).value(labels, 0);
+}
+
+qint64 MetricsRegistry::counterTotal(const QString &name) const
+{
+    QMutexLocker locker(&m_mutex);
+    qint64 total = 0;
+    for (qint64 value : m_counters.value(name)) {
+        total += value;
+    }
+    return total;
+}
+
+double MetricsRegistry::gauge(const QString &name, const QString &labels) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_gauges.value(name).value(labels, 0.0);
+}
+
+LatencyHistogram MetricsRegistry::histogram(const QString &name, const QString &labels) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_histograms.value(name).value(labels);
+}
+
+QStringList MetricsRegistry::labelSets(const QString &name) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_histograms.contains(name)) return m_histograms.value(name).keys();
+    if (m_counters.contains(name)) return m_counters.value(name).keys();
+    return m_gauges.value(name).keys();
+}
+
+QString MetricsRegistry::toPrometheusText() const
+{
+    QMutexLocker locker(&m_mutex);
+    QString output;
+    QTextStream out(&output);
+
+    auto writeHeader = [&](const QString &name, const char *type) {
+        if (m_help.contains(name)) {
+            out << "# HELP " << name << " " << m_help.value(name) << "\n";
+        }
+        out << "# TYPE " << name << " " << type << "\n";
+    };
+
+    for (auto it = m_counters.cbegin(); it != m_counters.cend(); ++it) {
+        writeHeader(it.key(), "counter");
+        for (auto series = it->cbegin(); series != it->cend(); ++series) {
+            out << it.key() << joinLabels(series.key(), QString()) << " " << series.value() << "\n";
+        }
+    }
+
+    for (auto it = m_gauges.cbegin(); it != m_gauges.cend(); ++it) {
+        writeHeader(it.key(), "gauge");
+        for (auto series = it->cbegin(); series != it->cend(); ++series) {
+            out << it.key() << joinLabels(series.key(), QString()) << " " << series.value() << "\n";
+        }
+    }
+
+    for (auto it = m_histograms.cbegin(); it != m_histograms.cend(); ++it) {
+        writeHeader(it.key(), "histogram");
+        for (auto series = it->cbegin(); series != it->cend(); ++series) {
+            const LatencyHistogram &hist = series.value();
+            for (qint64 bound : EXPORT_BUCKET_BOUNDS_US) {
+                QString le = QString("le=\"%1\"").arg(formatSeconds(bound));
+                out << it.key() << "_bucket" << joinLabels(series.key(), le) << " "
+                    << hist.countAtOrBelow(bound) << "\n";
+            }
+            out << it.key() << "_bucket" << joinLabels(series.key(), "le=\"+Inf\"") << " "
+                << hist.count() << "\n";
+            out << it.key() << "_sum" << joinLabels(series.key(), QString()) << " "
+                << formatSeconds(hist.sum()) << "\n";
+            out << it.key() << "_count" << joinLabels(series.key(), QString()) << " "
+                << hist.count() << "\n";
+        }
+    }
+
+    out.flush();
+    return output;
+}
+
+void MetricsRegistry::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_counters.clear();
+    m_gauges.clear();
+    m_histograms.clear();
+}
+
+QString MetricsRegistry::formatLabels(const QList<QPair<QString, QString>> &labels)
+{
+    QStringList parts;
+    for (const auto &label : labels) {
+        QString value = label.second;
+        value.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n");
+        parts.append(QString("%1=\"%2\"").arg(label.first, value));
+    }
+    return parts.join(',');
+}
+
+QString MetricsRegistry::formatSeconds(qint64 microseconds)
+{
+    return QString::number(microseconds / 1000000.0, 'g', 10);
+}
+
+QString MetricsRegistry::joinLabels(const QString &labels, const QString &extra)
+{
+    if (labels.isEmpty() && extra.isEmpty()) return QString();
+    if (labels.isEmpty()) return "{" + extra + "}";
+    if (extra.isEmpty()) return "{" + labels + "}";
+    return "{" + labels + "," + extra + "}";
+}
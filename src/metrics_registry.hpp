@@ -0,0 +1,92 @@
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QMap>
+#include <QtCore/QHash>
+#include <QtCore/QPair>
+#include <QVector>
+#include <QMutex>
+#include <QMutexLocker>
+#include <array>
+
+
+// Log-linear (HDR-style) latency histogram.
+// Values are recorded in microseconds with ~6% relative precision up to ~19 hours.
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void record(qint64 valueUs);
+    void merge(const LatencyHistogram &other);
+    void reset();
+
+    qint64 count() const { return m_count; }
+    qint64 sum() const { return m_sum; }
+    qint64 min() const { return m_count > 0 ? m_min : 0; }
+    qint64 max() const { return m_max; }
+    double mean() const;
+    qint64 percentile(double percent) const;
+
+    // Number of recorded values <= upperBoundUs. The bucket containing
+    // upperBoundUs counts whole, so values up to ~6% above it may be included
+    // but none below it are missed.
+    qint64 countAtOrBelow(qint64 upperBoundUs) const;
+
+    static int bucketIndex(qint64 valueUs);
+    static qint64 bucketUpperBound(int index);
+
+    static const int SUB_BUCKET_COUNT;
+    static const int BUCKET_COUNT = 528; // Exact buckets, then 16 per power of two up to MAX_TRACKABLE_US
+    static const qint64 MAX_TRACKABLE_US;
+
+private:
+    std::array<qint64, BUCKET_COUNT> m_buckets;
+    qint64 m_count;
+    qint64 m_sum;
+    qint64 m_min;
+    qint64 m_max;
+};
+
+// Thread-safe registry of counters, gauges and latency histograms keyed by
+// metric name and a preformatted Prometheus label set (e.g. source="usgs",stage="parse")
+class MetricsRegistry
+{
+public:
+    MetricsRegistry() = default;
+
+    // Metric metadata for the exposition format
+    void describe(const QString &name, const QString &help);
+
+    // Recording
+    void incrementCounter(const QString &name, const QString &labels = QString(), qint64 delta = 1);
+    void setGauge(const QString &name, const QString &labels, double value);
+    void recordLatency(const QString &name, const QString &labels, qint64 microseconds);
+
+    // Queries
+    qint64 counter(const QString &name, const QString &labels = QString()) const;
+    qint64 counterTotal(const QString &name) const;
+    double gauge(const QString &name, const QString &labels = QString()) const;
+    LatencyHistogram histogram(const QString &name, const QString &labels = QString()) const;
+    QStringList labelSets(const QString &name) const;
+
+    // Export and maintenance
+    QString toPrometheusText() const;
+    void reset();
+
+    static QString formatLabels(const QList<QPair<QString, QString>> &labels);
+
+private:
+    static QString formatSeconds(qint64 microseconds);
+    static QString joinLabels(const QString &labels, const QString &extra);
+
+    mutable QMutex m_mutex;
+    QMap<QString, QMap<QString, qint64>> m_counters;
+    QMap<QString, QMap<QString, double>> m_gauges;
+    QMap<QString, QMap<QString, LatencyHistogram>> m_histograms;
+    QHash<QString, QString> m_help;
+
+    // Prometheus histogram bucket bounds (microseconds)
+    static const QVector<qint64> EXPORT_BUCKET_BOUNDS_US;
+};
@@ -0,0 +1,213 @@
+#include "notification_coalescer.hpp"
+#include "spatial_utils.hpp"
+
+#include <QDateTime>
+#include <QJsonObject>
+
+// Constants
+const double NotificationCoalescer::DEFAULT_CLUSTER_RADIUS_KM = 100.0;
+const qint64 NotificationCoalescer::DEFAULT_WINDOW_MS = 3600 * 1000;
+const qint64 NotificationCoalescer::DEFAULT_DIGEST_INTERVAL_MS = 60 * 1000;
+
+namespace {
+
+// Channels that interrupt the user or cost money; only the first digest uses them
+bool isLoudChannel(DeliveryChannel channel)
+{
+    return channel == DeliveryChannel::SoundAlert || channel == DeliveryChannel::EmailAlert
+        || channel == DeliveryChannel::SMSAlert || channel == DeliveryChannel::PushNotification;
+}
+
+} // namespace
+
+
+NotificationCoalescer::NotificationCoalescer(double clusterRadiusKm, qint64 windowMs, qint64 digestIntervalMs)
+    : m_clusterRadiusKm(clusterRadiusKm)
+    , m_windowMs(qMax<qint64>(1, windowMs))
+    , m_digestIntervalMs(qMax<qint64>(0, digestIntervalMs))
+{
+}
+
+QVector<NotificationData> NotificationCoalescer::add(const NotificationData &notification,
+                                                     const EarthquakeData &earthquake,
+                                                     qint64 nowMs, bool rateLimited, QString *digestId)
+{
+    QVector<NotificationData> deliveries;
+    const bool emergency = notification.priority == NotificationPriority::Emergency;
+    const bool canDeliver = !rateLimited || emergency;
+
+    const int index = findCluster(earthquake, nowMs);
+    if (index < 0) {
+        Cluster cluster;
+        cluster.digestId = notification.id + "-digest";
+        cluster.latitude = earthquake.latitude;
+        cluster.longitude = earthquake.longitude;
+        cluster.anchor = SpatialUtils::toEcef(earthquake.latitude, earthquake.longitude, earthquake.depth);
+        cluster.eventCount = 1;
+        cluster.maxMagnitude = earthquake.magnitude;
+        cluster.maxEventId = earthquake.eventId;
+        cluster.maxPlace = placeOf(earthquake);
+        cluster.maxPriority = notification.priority;
+        cluster.channels = notification.channels;
+        cluster.firstMs = nowMs;
+        cluster.lastMs = nowMs;
+        cluster.lastDigestMs = -1;
+        cluster.digestPending = !canDeliver;
+        m_clusters.append(cluster);
+        if (digestId) *digestId = cluster.digestId;
+
+        if (canDeliver) {
+            deliveries.append(notification);
+        } else {
+            deliveries.append(takeDigest(m_clusters.last(), nowMs));
+        }
+        return deliveries;
+    }
+
+    Cluster &cluster = m_clusters[index];
+    if (digestId) *digestId = cluster.digestId;
+    cluster.eventCount++;
+    cluster.lastMs = nowMs;
+    cluster.maxPriority = qMax(cluster.maxPriority, notification.priority);
+    for (DeliveryChannel channel : notification.channels) {
+        if (!cluster.channels.contains(channel)) cluster.channels.append(channel);
+    }
+
+    const bool mostSevere = earthquake.magnitude > cluster.maxMagnitude;
+    if (mostSevere) {
+        cluster.maxMagnitude = earthquake.magnitude;
+        cluster.maxEventId = earthquake.eventId;
+        cluster.maxPlace = placeOf(earthquake);
+    }
+    if ((mostSevere || emergency) && canDeliver) {
+        deliveries.append(notification);
+    }
+
+    cluster.digestPending = true;
+    if (isDigestDue(cluster, nowMs)) {
+        deliveries.append(takeDigest(cluster, nowMs));
+    }
+    return deliveries;
+}
+
+QVector<NotificationData> NotificationCoalescer::takeDueDigest(const QString &digestId, qint64 nowMs)
+{
+    QVector<NotificationData> digests;
+    const int index = indexOf(digestId);
+    if (index < 0) return digests;
+
+    Cluster &cluster = m_clusters[index];
+    if (isDigestDue(cluster, nowMs)) {
+        digests.append(takeDigest(cluster, nowMs));
+    } else if (isExpired(cluster, nowMs)) {
+        m_clusters.removeAt(index);
+    }
+    return digests;
+}
+
+qint64 NotificationCoalescer::nextDueMs(const QString &digestId) const
+{
+    const int index = indexOf(digestId);
+    if (index < 0) return -1;
+
+    const Cluster &cluster = m_clusters[index];
+    if (!cluster.digestPending) return cluster.lastMs + m_windowMs + 1;
+    return cluster.lastDigestMs < 0 ? cluster.lastMs : cluster.lastDigestMs + m_digestIntervalMs;
+}
+
+void NotificationCoalescer::clear()
+{
+    m_clusters.clear();
+}
+
+bool NotificationCoalescer::isDigest(const NotificationData &notification)
+{
+    return notification.metadata.value("digest").toBool();
+}
+
+int NotificationCoalescer::findCluster(const EarthquakeData &earthquake, qint64 nowMs) const
+{
+    const EcefPoint hypocenter = SpatialUtils::toEcef(earthquake.latitude, earthquake.longitude, earthquake.depth);
+    int nearest = -1;
+    double nearestKm = m_clusterRadiusKm;
+    for (int i = 0; i < m_clusters.size(); ++i) {
+        const Cluster &cluster = m_clusters[i];
+        if (nowMs - cluster.lastMs > m_windowMs) continue;
+
+        const double km = SpatialUtils::distance3D(cluster.anchor, hypocenter);
+        if (km <= nearestKm) {
+            nearest = i;
+            nearestKm = km;
+        }
+    }
+    return nearest;
+}
+
+int NotificationCoalescer::indexOf(const QString &digestId) const
+{
+    for (int i = 0; i < m_clusters.size(); ++i) {
+        if (m_clusters[i].digestId == digestId) return i;
+    }
+    return -1;
+}
+
+bool NotificationCoalescer::isDigestDue(const Cluster &cluster, qint64 nowMs) const
+{
+    return cluster.digestPending
+        && (cluster.lastDigestMs < 0 || nowMs - cluster.lastDigestMs >= m_digestIntervalMs);
+}
+
+bool NotificationCoalescer::isExpired(const Cluster &cluster, qint64 nowMs) const
+{
+    return !cluster.digestPending && nowMs - cluster.lastMs > m_windowMs;
+}
+
+NotificationData NotificationCoalescer::takeDigest(Cluster &cluster, qint64 nowMs)
+{
+    const QDateTime now = QDateTime::fromMSecsSinceEpoch(nowMs);
+    const qint64 spanMinutes = (cluster.lastMs - cluster.firstMs) / 60000;
+
+    NotificationData digest;
+    digest.id = cluster.digestId;
+    digest.title = "Earthquake Activity";
+    digest.message = QString(cluster.eventCount == 1 ? "%1 event near %2, M%3" : "%1 events near %2, max M%3")
+                     .arg(cluster.eventCount)
+                     .arg(cluster.maxPlace)
+                     .arg(cluster.maxMagnitude, 0, 'f', 1);
+    if (spanMinutes > 0) {
+        digest.message += QString("\nOver the last %1 min").arg(spanMinutes);
+    }
+    digest.type = cluster.maxPriority >= NotificationPriority::Critical ? NotificationType::Critical
+                                                                        : NotificationType::Warning;
+    digest.priority = cluster.maxPriority;
+    digest.timestamp = now;
+    digest.persistent = cluster.maxPriority >= NotificationPriority::Critical;
+    digest.expiryTime = now.addMSecs(m_windowMs);
+
+    // Later updates replace the digest quietly
+    for (DeliveryChannel channel : cluster.channels) {
+        if (cluster.lastDigestMs < 0 || !isLoudChannel(channel)) {
+            digest.channels.append(channel);
+        }
+    }
+
+    QJsonObject metadata;
+    metadata["digest"] = true;
+    metadata["eventCount"] = cluster.eventCount;
+    metadata["maxMagnitude"] = cluster.maxMagnitude;
+    metadata["maxEventId"] = cluster.maxEventId;
+    metadata["latitude"] = cluster.latitude;
+    metadata["longitude"] = cluster.longitude;
+    metadata["location"] = cluster.maxPlace;
+    digest.metadata = metadata;
+
+    cluster.lastDigestMs = nowMs;
+    cluster.digestPending = false;
+    return digest;
+}
+
+QString NotificationCoalescer::placeOf(const EarthquakeData &earthquake)
+{
+    if (!earthquake.place.isEmpty()) return earthquake.place;
+    return QString("%1, %2").arg(earthquake.latitude, 0, 'f', 2).arg(earthquake.longitude, 0, 'f', 2);
+}
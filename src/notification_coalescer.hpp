@@ -0,0 +1,82 @@
+#pragma once
+
+#include "earthquake_data.hpp"
+#include "notification_types.hpp"
+#include "spatial_utils.hpp"
+
+#include <QString>
+#include <QVector>
+
+
+// Folds bursts of earthquake alerts (swarms, aftershock sequences) into one
+// digest notification per spatial cluster, e.g. "14 events near X, max M5.8".
+// An alert joins the nearest cluster whose anchor hypocenter is within the
+// cluster radius in 3D, so shallow and deep sequences under the same
+// epicenter stay apart, and whose last event is within the time window.
+// The first alert of a cluster and any alert larger than everything before
+// it are delivered individually, so the most severe event is never hidden;
+// the others only update the digest. A digest keeps its id, so each update
+// replaces the previous one, and is re-delivered at most once per digest
+// interval and without sound, email, SMS or push after the first time. The
+// owner wakes each cluster at nextDueMs() and calls takeDueDigest() for it.
+// Not thread-safe; NotificationManager uses it from the GUI thread.
+class NotificationCoalescer
+{
+public:
+    explicit NotificationCoalescer(double clusterRadiusKm = DEFAULT_CLUSTER_RADIUS_KM,
+                                   qint64 windowMs = DEFAULT_WINDOW_MS,
+                                   qint64 digestIntervalMs = DEFAULT_DIGEST_INTERVAL_MS);
+
+    // Notifications to deliver now for this alert: the alert itself and/or
+    // its cluster's digest. A rate-limited alert is never delivered on its
+    // own; it is folded into the digest instead. The id of the alert's
+    // cluster digest is stored in digestId if given.
+    QVector<NotificationData> add(const NotificationData &notification, const EarthquakeData &earthquake,
+                                  qint64 nowMs, bool rateLimited, QString *digestId = nullptr);
+
+    // The cluster's digest if its update interval has passed; drops the
+    // cluster once it is idle
+    QVector<NotificationData> takeDueDigest(const QString &digestId, qint64 nowMs);
+    // When takeDueDigest() next has work for the cluster: its pending digest,
+    // otherwise its expiry; -1 once the cluster is gone
+    qint64 nextDueMs(const QString &digestId) const;
+
+    int clusterCount() const { return m_clusters.size(); }
+    void clear();
+
+    static bool isDigest(const NotificationData &notification);
+
+    static const double DEFAULT_CLUSTER_RADIUS_KM;
+    static const qint64 DEFAULT_WINDOW_MS;
+    static const qint64 DEFAULT_DIGEST_INTERVAL_MS;
+
+private:
+    struct Cluster {
+        QString digestId;
+        double latitude;
+        double longitude;
+        EcefPoint anchor; // Hypocenter of the first event
+        int eventCount;
+        double maxMagnitude;
+        QString maxEventId;
+        QString maxPlace;
+        NotificationPriority maxPriority;
+        QVector<DeliveryChannel> channels;
+        qint64 firstMs;
+        qint64 lastMs;
+        qint64 lastDigestMs; // -1 until the first digest
+        bool digestPending;
+    };
+
+    int findCluster(const EarthquakeData &earthquake, qint64 nowMs) const;
+    int indexOf(const QString &digestId) const;
+    bool isDigestDue(const Cluster &cluster, qint64 nowMs) const;
+    bool isExpired(const Cluster &cluster, qint64 nowMs) const;
+    NotificationData takeDigest(Cluster &cluster, qint64 nowMs);
+    static QString placeOf(const EarthquakeData &earthquake);
+
+    double m_clusterRadiusKm;
+    qint64 m_windowMs;
+    qint64 m_digestIntervalMs;
+    QVector<Cluster> m_clusters;
+};
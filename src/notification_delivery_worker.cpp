@@ -0,0 +1,100 @@
+#include "notification_delivery_worker.hpp"
+
+#include <QtCore/QDebug>
+#include <QtCore/QMetaObject>
+
+// Constants
+const int NotificationDeliveryWorker::MAX_BATCH_SIZE = 64;
+
+
+NotificationDeliveryWorker::NotificationDeliveryWorker(NotificationQueue *queue, MetricsRegistry *metrics, QObject *parent)
+    : QObject(parent)
+    , m_queue(queue)
+    , m_metrics(metrics)
+    , m_drainScheduled(false)
+{
+    for (int lane = 0; lane < NotificationQueue::LANE_COUNT; ++lane) {
+        m_reportedPushed[lane] = 0;
+        m_reportedRejected[lane] = 0;
+    }
+}
+
+void NotificationDeliveryWorker::scheduleDrain()
+{
+    if (!m_drainScheduled.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(this, &NotificationDeliveryWorker::drain, Qt::QueuedConnection);
+    }
+}
+
+void NotificationDeliveryWorker::drain()
+{
+    // Cleared before popping: anything pushed from now on schedules another drain
+    m_drainScheduled.store(false, std::memory_order_release);
+
+    QVector<NotificationData> batch;
+    batch.reserve(MAX_BATCH_SIZE);
+
+    const qint64 now = NotificationQueue::nowUs();
+    NotificationData notification;
+    qint64 enqueuedAtUs = 0;
+    while (batch.size() < MAX_BATCH_SIZE && m_queue->tryPop(notification, enqueuedAtUs)) {
+        m_metrics->recordLatency("earthquake_notification_queue_wait_seconds",
+                                 priorityLabel(notification.priority), qMax<qint64>(0, now - enqueuedAtUs));
+        batch.append(std::move(notification));
+    }
+
+    publishQueueMetrics();
+    if (batch.isEmpty()) return;
+
+    m_metrics->incrementCounter("earthquake_notification_batches_total");
+    m_metrics->incrementCounter("earthquake_notifications_drained_total", QString(), batch.size());
+    emit batchReady(batch);
+
+    // Remaining work goes behind other queued events instead of looping here
+    if (m_queue->size() > 0) {
+        scheduleDrain();
+    }
+}
+
+void NotificationDeliveryWorker::discardPending()
+{
+    int discarded = m_queue->clear();
+    publishQueueMetrics();
+    if (discarded > 0) {
+        qDebug() << "Discarded" << discarded << "pending notifications";
+    }
+}
+
+void NotificationDeliveryWorker::publishQueueMetrics()
+{
+    for (int lane = 0; lane < NotificationQueue::LANE_COUNT; ++lane) {
+        const QString labels = priorityLabel(NotificationQueue::priorityOf(lane));
+        m_metrics->setGauge("earthquake_notification_queue_depth", labels, m_queue->size(lane));
+
+        const quint64 pushed = m_queue->pushedCount(lane);
+        const quint64 rejected = m_queue->rejectedCount(lane);
+        if (pushed > m_reportedPushed[lane]) {
+            m_metrics->incrementCounter("earthquake_notifications_enqueued_total", labels,
+                                        static_cast<qint64>(pushed - m_reportedPushed[lane]));
+            m_reportedPushed[lane] = pushed;
+        }
+        if (rejected > m_reportedRejected[lane]) {
+            m_metrics->incrementCounter("earthquake_notifications_dropped_total", labels,
+                                        static_cast<qint64>(rejected - m_reportedRejected[lane]));
+            m_reportedRejected[lane] = rejected;
+        }
+    }
+}
+
+QString NotificationDeliveryWorker::priorityLabel(NotificationPriority priority)
+{
+    QString name;
+    switch (priority) {
+        case NotificationPriority::Low: name = "low"; break;
+        case NotificationPriority::Normal: name = "normal"; break;
+        case NotificationPriority::High: name = "high"; break;
+        case NotificationPriority::Critical: name = "critical"; break;
+        case NotificationPriority::Emergency: name = "emergency"; break;
+    }
+    return MetricsRegistry::formatLabels({qMakePair(QString("priority"), name)});
+}
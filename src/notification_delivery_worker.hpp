@@ -0,0 +1,48 @@
+#pragma once
+
+#include "metrics_registry.hpp"
+#include "notification_queue.hpp"
+#include "notification_types.hpp"
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+
+// Drains the notification queue on the delivery thread. Wake-ups are
+// coalesced, so a burst of enqueues costs one queued drain call; each drain
+// takes up to MAX_BATCH_SIZE notifications in priority order and hands the
+// batch to the manager's thread for the channels that need the GUI or the
+// network.
+class NotificationDeliveryWorker : public QObject
+{
+    Q_OBJECT
+public:
+    NotificationDeliveryWorker(NotificationQueue *queue, MetricsRegistry *metrics, QObject *parent = nullptr);
+
+    // Thread-safe: requests a drain unless one is already pending
+    void scheduleDrain();
+
+    static QString priorityLabel(NotificationPriority priority);
+
+    static const int MAX_BATCH_SIZE;
+
+public slots:
+    void drain();
+    void discardPending();
+
+signals:
+    void batchReady(const QVector<NotificationData> &batch);
+
+private:
+    void publishQueueMetrics();
+
+    NotificationQueue *m_queue;
+    MetricsRegistry *m_metrics;
+    std::atomic<bool> m_drainScheduled;
+
+    // Queue totals already reported, to turn them into counter increments
+    quint64 m_reportedPushed[NotificationQueue::LANE_COUNT];
+    quint64 m_reportedRejected[NotificationQueue::LANE_COUNT];
+};
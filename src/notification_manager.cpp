@@ -2,23 +2,33 @@
 #include "notification_manager.moc"
 #include "geojson_parser.hpp"
 #include "spatial_utils.hpp" // For distance calculations
+#include "travel_times.hpp"
 
 #include <QtWidgets/QMessageBox>
 #include <QtCore/QUuid>
 #include <QtCore/QJsonArray>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QFileInfo>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QStandardPaths>
 #include <QByteArray>
+#include <QElapsedTimer>
 #include <QTimer>
 #include <QUrlQuery>
+#include <algorithm>
+#include <limits>
 
 // Constants
 const int NotificationManager::MAX_QUEUE_SIZE = 100;
-const int NotificationManager::CLEANUP_INTERVAL_MS = 300000; // 5 minutes
+const int NotificationManager::SNAPSHOT_INTERVAL_MS = 300000; // 5 minutes
 const int NotificationManager::STATISTICS_UPDATE_INTERVAL_MS = 60000; // 1 minute
+const int NotificationManager::TIMING_WHEEL_RESOLUTION_MS = 10;
 const int NotificationManager::MAX_NOTIFICATION_HISTORY = 1000;
 const int NotificationManager::DEFAULT_NOTIFICATION_TIMEOUT_MS = 10000;
+const int NotificationManager::INDEXED_RULE_THRESHOLD = 64;
+const int NotificationManager::COUNTDOWN_INTERVAL_MS = 250;
+const QString NotificationManager::EMAIL_SERVICE_URL = "https://api.emailservice.com/send";
+const QString NotificationManager::SMS_SERVICE_URL = "https://api.smsservice.com/send";
 
 NotificationManager::NotificationManager(QObject *parent)
     : QObject(parent)
@@ -26,22 +36,33 @@ NotificationManager::NotificationManager(QObject *parent)
     , m_userLatitude(0.0)
     , m_userLongitude(0.0)
     , m_hasUserLocation(false)
+    , m_compiledRulesValid(false)
+    , m_notificationQueue(MAX_QUEUE_SIZE)
+    , m_notificationHistory(MAX_NOTIFICATION_HISTORY)
     , m_systemTray(nullptr)
     , m_trayMenu(nullptr)
-    , m_soundEffect(nullptr)
+    , m_soundBank(nullptr)
     , m_mediaPlayer(nullptr)
     , m_audioOutput(nullptr)
-    , m_networkManager(nullptr)
-    , m_queueTimer(nullptr)
-    , m_cleanupTimer(nullptr)
-    , m_statisticsTimer(nullptr)
-    , m_quietHoursTimer(nullptr)
+    , m_emailChannel(nullptr)
+    , m_smsChannel(nullptr)
+    , m_pushChannel(nullptr)
+    , m_deliveryWorker(nullptr)
+    , m_logWriter(nullptr)
+    , m_timingWheelTimer(nullptr)
+    , m_countdownTimer(nullptr)
+    , m_timingWheel(QDateTime::currentMSecsSinceEpoch(), TIMING_WHEEL_RESOLUTION_MS)
+    , m_quietHoursBoundary(0)
+    , m_inQuietHours(false)
     , m_notificationsToday(0)
     , m_notificationsThisHour(0)
     , m_initialized(false)
     , m_systemTrayAvailable(false)
 {
     qRegisterMetaType<NotificationManager>("NotificationManager");
+    qRegisterMetaType<QVector<AlertMatch>>("QVector<AlertMatch>");
+    qRegisterMetaType<QVector<NotificationData>>("QVector<NotificationData>");
+    qRegisterMetaType<QVector<ShakingCountdown>>("QVector<ShakingCountdown>");
 
     // Initialize settings
     m_qsettings = new QSettings("EarthquakeAlertSystem", "NotificationManager", this);
@@ -49,25 +70,24 @@ NotificationManager::NotificationManager(QObject *parent)
     // Initialize components
     // initializeSystemTray();
     initializeAudioSystem();
-    initializeNetworkManager();
+    initializeDeliveryChannels();
     createNotificationDirectory();
+    initializeRegions();
+    initializeSubscribers();
+    initializeLogWriter();
+    initializeDeliveryWorker();
 
     // Setup timers
-    m_queueTimer = new QTimer(this);
-    connect(m_queueTimer, &QTimer::timeout, this, &NotificationManager::processNotificationQueue);
-    m_queueTimer->start(1000); // Process queue every second
+    // Everything time-based runs off the timing wheel, woken exactly when due
+    m_timingWheelTimer = new QTimer(this);
+    m_timingWheelTimer->setSingleShot(true);
+    m_timingWheelTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_timingWheelTimer, &QTimer::timeout, this, &NotificationManager::onTimingWheelTimeout);
 
-    m_cleanupTimer = new QTimer(this);
-    connect(m_cleanupTimer, &QTimer::timeout, this, &NotificationManager::cleanupExpiredNotifications);
-    m_cleanupTimer->start(CLEANUP_INTERVAL_MS);
-
-    m_statisticsTimer = new QTimer(this);
-    connect(m_statisticsTimer, &QTimer::timeout, this, &NotificationManager::updateStatistics);
-    m_statisticsTimer->start(STATISTICS_UPDATE_INTERVAL_MS);
-
-    m_quietHoursTimer = new QTimer(this);
-    connect(m_quietHoursTimer, &QTimer::timeout, this, &NotificationManager::checkQuietHours);
-    m_quietHoursTimer->start(60000); // Check quiet hours every minute
+    // Runs only while a countdown is active
+    m_countdownTimer = new QTimer(this);
+    m_countdownTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_countdownTimer, &QTimer::timeout, this, &NotificationManager::updateShakingCountdowns);
 
     // Initialize rate limiting
     m_lastHourReset = QDateTime::currentDateTime();
@@ -76,8 +96,29 @@ NotificationManager::NotificationManager(QObject *parent)
     
     // Load settings and data
     loadSettings();
-    loadDefaultAlertRules();
-    loadPersistentNotifications();
+    if (!loadSnapshot()) {
+        loadDefaultAlertRules();
+        loadPersistentNotifications();
+    }
+    
+    // The main window kept its own seen-event file before the set moved here
+    const QString legacySeenEventsFile =
+        QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/seen_events.dat";
+    if (QFile::exists(legacySeenEventsFile)) {
+        if (m_seenEvents.size() == 0) {
+            m_seenEvents.loadFromFile(legacySeenEventsFile);
+        }
+        QFile::remove(legacySeenEventsFile);
+    }
+    
+    // Counter resets are due relative to the (possibly restored) last resets
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    scheduleTask(m_lastHourReset.toMSecsSinceEpoch() + 3600000LL, TimedTask::HourlyReset);
+    scheduleTask(QDateTime(m_lastDayReset.date().addDays(1), QTime(0, 0)).toMSecsSinceEpoch(), TimedTask::DailyReset);
+    scheduleTask(now + STATISTICS_UPDATE_INTERVAL_MS, TimedTask::StatisticsUpdate);
+    scheduleTask(now + SNAPSHOT_INTERVAL_MS, TimedTask::SnapshotSave);
+    m_inQuietHours = isInQuietHours();
+    scheduleQuietHoursBoundary();
     
     m_initialized = true;
     
@@ -86,8 +127,11 @@ NotificationManager::NotificationManager(QObject *parent)
 
 NotificationManager::~NotificationManager()
 {
+    m_deliveryThread.quit();
+    m_deliveryThread.wait();
+    
     saveSettings();
-    savePersistentNotifications();
+    saveSnapshot();
     stopAllSounds();
 }
 
@@ -113,8 +157,8 @@ void NotificationManager::initializeSystemTray()
 
 void NotificationManager::initializeAudioSystem()
 {
-    // Initialize sound effect for short alerts
-    m_soundEffect = new QSoundEffect(this);
+    // Short alerts are decoded once up front and played from a voice pool
+    m_soundBank = new SoundBank(this);
     
     // Initialize media player for longer sounds
     m_audioOutput = new QAudioOutput(this);
@@ -126,23 +170,94 @@ void NotificationManager::initializeAudioSystem()
     m_soundPaths[SoundType::Beep] = m_soundsDirectory + "beep.wav";
     m_soundPaths[SoundType::Chime] = m_soundsDirectory + "chime.wav";
     m_soundPaths[SoundType::Alert] = m_soundsDirectory + "alert.wav";
-    m_soundPaths[SoundType::Warning] = m_soundsDirectory + "warning.wav";
-    m_soundPaths[SoundType::Emergency] = m_soundsDirectory + "emergency.wav";
+    m_soundPaths[SoundType::Warning] = m_soundsDirectory + "alert01.wav";
+    m_soundPaths[SoundType::Emergency] = m_soundsDirectory + "alert01.wav";
+    for (auto it = m_soundPaths.constBegin(); it != m_soundPaths.constEnd(); ++it) {
+        m_soundBank->setSource(it.key(), it.value());
+    }
     
     qDebug() << "Audio system initialized";
 }
 
-void NotificationManager::initializeNetworkManager()
+void NotificationManager::initializeDeliveryChannels()
+{
+    const QString deadLetterDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/notifications";
+    auto createChannel = [this, &deadLetterDir](const QString &name, const QUrl &endpoint, DeliveryChannel type) {
+        HttpDeliveryChannel::Config config;
+        config.name = name;
+        config.endpoint = endpoint;
+        config.deadLetterPath = QString("%1/outbound-%2.deadletter.jsonl").arg(deadLetterDir, name);
+        
+        auto *channel = new HttpDeliveryChannel(config, &m_metrics, this);
+        connect(channel, &HttpDeliveryChannel::messageFailed, this,
+                [this, type](const QString &id, const QString &recipient, const QString &error) {
+                    emit deliveryFailed(id, type, QString("%1: %2").arg(recipient, error));
+                });
+        return channel;
+    };
+    
+    m_emailChannel = createChannel("email", QUrl(EMAIL_SERVICE_URL), DeliveryChannel::EmailAlert);
+    m_smsChannel = createChannel("sms", QUrl(SMS_SERVICE_URL), DeliveryChannel::SMSAlert);
+    m_pushChannel = createChannel("push", QUrl(m_settings.pushServiceUrl), DeliveryChannel::PushNotification);
+    
+    qDebug() << "Delivery channels initialized";
+}
+
+void NotificationManager::initializeDeliveryWorker()
 {
-    m_networkManager = new QNetworkAccessManager(this);
+    m_metrics.describe("earthquake_notification_queue_depth", "Notifications waiting for delivery, by priority");
+    m_metrics.describe("earthquake_notification_queue_wait_seconds", "Time from enqueue to drain, by priority");
+    m_metrics.describe("earthquake_notification_delivery_seconds", "Time to deliver one notification to its channels");
+    m_metrics.describe("earthquake_notifications_enqueued_total", "Notifications accepted by the queue");
+    m_metrics.describe("earthquake_notifications_dropped_total", "Notifications rejected because their lane was full");
+    m_metrics.describe("earthquake_notifications_drained_total", "Notifications taken off the queue by the worker");
+    m_metrics.describe("earthquake_notification_batches_total", "Drain batches handed to the manager");
+    m_metrics.describe("earthquake_notification_emergency_bypass_total", "Emergency notifications delivered without queueing");
+    
+    // The worker has no parent so it can live on the delivery thread
+    m_deliveryWorker = new NotificationDeliveryWorker(&m_notificationQueue, &m_metrics);
+    m_deliveryWorker->moveToThread(&m_deliveryThread);
+    connect(&m_deliveryThread, &QThread::finished, m_deliveryWorker, &QObject::deleteLater);
+    connect(m_deliveryWorker, &NotificationDeliveryWorker::batchReady,
+            this, &NotificationManager::onNotificationBatch, Qt::QueuedConnection);
     
-    connect(m_networkManager, &QNetworkAccessManager::finished,
-            this, [this](QNetworkReply *reply) {
-                // Handle network replies for email/SMS/push notifications
-                reply->deleteLater();
-            });
+    m_deliveryThread.setObjectName("NotificationDelivery");
+    m_deliveryThread.start();
+}
+
+void NotificationManager::initializeLogWriter()
+{
+    AsyncLogWriter::Options options;
+    options.directory = QFileInfo(m_persistentDataFile).absolutePath();
+    options.baseName = "notifications";
     
-    qDebug() << "Network manager initialized";
+    m_logWriter = new AsyncLogWriter(options, this);
+    m_notificationLogFile = m_logWriter->currentSegmentPath();
+    m_logWriter->start(QThread::LowPriority);
+}
+
+void NotificationManager::initializeRegions()
+{
+    m_regionRegistry.addDefaultRegions();
+    m_compiledRules.setRegionResolver([this](const QString &name) {
+        return m_regionRegistry.regionId(name);
+    });
+    
+    // Optional user polygons; same-named regions replace the default boxes
+    QString regionFile = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/regions.geojson";
+    if (QFile::exists(regionFile)) {
+        loadRegionFile(regionFile);
+    }
+}
+
+void NotificationManager::initializeSubscribers()
+{
+    m_metrics.describe("earthquake_subscriber_alerts_total", "Subscriber alerts fanned out, one per matched subscriber");
+    
+    QString subscriberFile = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/subscribers.json";
+    if (QFile::exists(subscriberFile)) {
+        loadSubscriberFile(subscriberFile);
+    }
 }
 
 void NotificationManager::createNotificationDirectory()
@@ -150,8 +265,8 @@ void NotificationManager::createNotificationDirectory()
     QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir().mkpath(appDataPath + "/notifications");
     
-    m_notificationLogFile = appDataPath + "/notifications/notifications.log";
     m_persistentDataFile = appDataPath + "/notifications/persistent.json";
+    m_snapshotFile = appDataPath + "/notifications/state.snapshot";
     
     qDebug() << "Notification directory created:" << appDataPath;
 }
@@ -203,6 +318,7 @@ void NotificationManager::loadDefaultAlertRules()
     proximityRule.customMessage = "Earthquake near you: M{magnitude} - {distance}km away";
     
     m_alertRules = {significantRule, majorRule, emergencyRule, proximityRule};
+    invalidateCompiledRules();
     
     qDebug() << "Default alert rules loaded:" << m_alertRules.size();
 }
@@ -210,6 +326,10 @@ void NotificationManager::loadDefaultAlertRules()
 void NotificationManager::setSettings(const NotificationSettings &settings)
 {
     m_settings = settings;
+    m_soundBank->setSource(SoundType::Custom, m_settings.customSoundPath);
+    m_pushChannel->setEndpoint(QUrl(m_settings.pushServiceUrl));
+    checkQuietHours();
+    scheduleQuietHoursBoundary();
     emit settingsChanged(settings);
     saveSettings();
 }
@@ -295,6 +415,8 @@ void NotificationManager::loadSettings()
     m_settings.pushServiceUrl = m_qsettings->value("pushServiceUrl").toString();
     m_settings.customSoundPath = m_qsettings->value("customSoundPath").toString();
     m_qsettings->endGroup();
+    m_soundBank->setSource(SoundType::Custom, m_settings.customSoundPath);
+    m_pushChannel->setEndpoint(QUrl(m_settings.pushServiceUrl));
     
     m_qsettings->beginGroup("Behavior");
     m_settings.defaultSoundType = static_cast<SoundType>(m_qsettings->value("defaultSoundType", 
@@ -320,13 +442,19 @@ void NotificationManager::addAlertRule(const AlertRule &rule)
     for (int i = 0; i < m_alertRules.size(); ++i) {
         if (m_alertRules[i].name == rule.name) {
             m_alertRules[i] = rule;
+            invalidateCompiledRules();
+            startRuleCooldownLocked(rule);
             qDebug() << "Updated alert rule:" << rule.name;
+            emitAlertRulesChanged(locker);
             return;
         }
     }
     
     m_alertRules.append(rule);
+    invalidateCompiledRules();
+    startRuleCooldownLocked(rule);
     qDebug() << "Added new alert rule:" << rule.name;
+    emitAlertRulesChanged(locker);
 }
 
 void NotificationManager::removeAlertRule(const QString &name)
@@ -336,7 +464,10 @@ void NotificationManager::removeAlertRule(const QString &name)
     for (int i = 0; i < m_alertRules.size(); ++i) {
         if (m_alertRules[i].name == name) {
             m_alertRules.removeAt(i);
+            invalidateCompiledRules();
+            cancelRuleCooldownLocked(name);
             qDebug() << "Removed alert rule:" << name;
+            emitAlertRulesChanged(locker);
             return;
         }
     }
@@ -349,7 +480,11 @@ void NotificationManager::updateAlertRule(const QString &name, const AlertRule &
     for (int i = 0; i < m_alertRules.size(); ++i) {
         if (m_alertRules[i].name == name) {
             m_alertRules[i] = rule;
+            invalidateCompiledRules();
+            cancelRuleCooldownLocked(name);
+            startRuleCooldownLocked(rule);
             qDebug() << "Updated alert rule:" << name;
+            emitAlertRulesChanged(locker);
             return;
         }
     }
@@ -365,6 +500,57 @@ void NotificationManager::setAlertRules(const QVector<AlertRule> &rules)
 {
     QMutexLocker locker(&m_rulesMutex);
     m_alertRules = rules;
+    invalidateCompiledRules();
+    restartRuleCooldownsLocked();
+    emitAlertRulesChanged(locker);
+}
+
+bool NotificationManager::loadRegionFile(const QString &path)
+{
+    QMutexLocker locker(&m_rulesMutex);
+    
+    QString error;
+    if (!m_regionRegistry.loadFromFile(path, &error)) {
+        qWarning() << "Failed to load regions:" << error;
+        return false;
+    }
+    invalidateCompiledRules();
+    
+    qDebug() << "Loaded regions from" << path << "- total regions:" << m_regionRegistry.size();
+    return true;
+}
+
+bool NotificationManager::loadSubscriberFile(const QString &path)
+{
+    QString error;
+    if (!m_subscribers.loadFromFile(path, &error)) {
+        qWarning() << "Failed to load subscribers:" << error;
+        return false;
+    }
+    
+    qDebug() << "Loaded subscribers from" << path << "- total subscribers:" << m_subscribers.size();
+    return true;
+}
+
+void NotificationManager::addSubscriber(const Subscriber &subscriber)
+{
+    m_subscribers.add(subscriber);
+}
+
+bool NotificationManager::removeSubscriber(const QString &id)
+{
+    return m_subscribers.remove(id);
+}
+
+int NotificationManager::getSubscriberCount() const
+{
+    return m_subscribers.size();
+}
+
+QStringList NotificationManager::getRegionNames() const
+{
+    QMutexLocker locker(&m_rulesMutex);
+    return m_regionRegistry.regionNames();
 }
 
 void NotificationManager::setUserLocation(double latitude, double longitude)
@@ -382,8 +568,10 @@ void NotificationManager::setUserLocation(double latitude, double longitude)
             rule.centerLongitude = longitude;
         }
     }
+    invalidateCompiledRules();
     
     qDebug() << "User location set:" << latitude << longitude;
+    emitAlertRulesChanged(locker);
 }
 
 QPair<double, double> NotificationManager::getUserLocation() const
@@ -391,15 +579,20 @@ QPair<double, double> NotificationManager::getUserLocation() const
     return qMakePair(m_userLatitude, m_userLongitude);
 }
 
-void NotificationManager::showNotification(const NotificationData &notification)
+QVector<ShakingCountdown> NotificationManager::getShakingCountdowns() const
+{
+    return m_shakingCountdowns;
+}
+
+bool NotificationManager::showNotification(const NotificationData &notification)
 {
     if (!m_settings.enabled || !shouldShowNotification(notification)) {
-        return;
+        return false;
     }
     
     if (isRateLimited()) {
         qDebug() << "Rate limited, skipping notification:" << notification.title;
-        return;
+        return false;
     }
     
     // Create a copy with generated ID if needed
@@ -413,11 +606,17 @@ void NotificationManager::showNotification(const NotificationData &notification)
     
     enqueueNotification(processedNotification);
     updateRateLimit();
+    return true;
 }
 
 void NotificationManager::showEarthquakeAlert(const EarthquakeData &earthquake)
 {
     if (!m_settings.enabled) return;
+    if (m_seenEvents.observe(earthquake, QDateTime::currentMSecsSinceEpoch()) == SeenEventSet::Status::Unchanged) {
+        return;
+    }
+    
+    fanOutToSubscribers({earthquake});
     
     // Check alert rules
     QVector<AlertRule> triggeredRules = getTriggeredRules(earthquake);
@@ -434,10 +633,146 @@ void NotificationManager::showEarthquakeAlert(const EarthquakeData &earthquake)
     }
     
     // Check cooldown
-    if (isRuleInCooldown(activeRule)) {
-        return;
+    {
+        QMutexLocker locker(&m_rulesMutex);
+        if (isRuleInCooldown(activeRule)) {
+            return;
+        }
     }
     
+    raiseEarthquakeAlert(earthquake, activeRule);
+    
+    // Update rule cooldown
+    updateRuleCooldown(activeRule.name);
+}
+
+QVector<EarthquakeData> NotificationManager::ingestEarthquakes(const QVector<EarthquakeData> &earthquakes, bool live)
+{
+    if (earthquakes.isEmpty()) return {};
+    
+    // Feeds repeat their events on every refresh; only new and revised ones
+    // may alert, including after a restart or once a rule's cooldown ends
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QVector<EarthquakeData> added;
+    m_seenEvents.evictExpired(nowMs);
+    const QVector<EarthquakeData> fresh = m_seenEvents.observe(earthquakes, nowMs, &added);
+    
+    // Rates are tracked from every batch, history and backfill included, and
+    // even while notifications are off, so the background stays current; each
+    // event is counted once, on its first revision. Only events within a day
+    // of now can raise an anomaly, so old batches do not.
+    const QVector<SeismicityRateDetector::Anomaly> anomalies = m_rateDetector.observe(added, nowMs);
+    if (!m_settings.enabled) return fresh;
+    
+    for (const SeismicityRateDetector::Anomaly &anomaly : anomalies) {
+        raiseSeismicityAnomaly(anomaly);
+    }
+    if (!live) return fresh;
+    
+    // Persist right away so a crash cannot re-alert these events
+    if (alertOnEvents(fresh) > 0) {
+        saveSnapshot();
+    }
+    return fresh;
+}
+
+void NotificationManager::showEarthquakeAlerts(const QVector<EarthquakeData> &earthquakes)
+{
+    ingestEarthquakes(earthquakes, true);
+}
+
+int NotificationManager::alertOnEvents(const QVector<EarthquakeData> &earthquakes)
+{
+    fanOutToSubscribers(earthquakes);
+    if (earthquakes.isEmpty()) return 0;
+    
+    QVector<AlertMatch> matches;
+    QVector<QPair<int, AlertRule>> alerts;
+    {
+        QMutexLocker locker(&m_rulesMutex);
+        matches = evaluateRulesLocked(earthquakes);
+        
+        // Matches are grouped by event: keep the highest priority rule of each group
+        QDateTime now = QDateTime::currentDateTime();
+        int i = 0;
+        while (i < matches.size()) {
+            const int eventIndex = matches[i].eventIndex;
+            int best = matches[i].ruleIndex;
+            for (++i; i < matches.size() && matches[i].eventIndex == eventIndex; ++i) {
+                if (m_alertRules[matches[i].ruleIndex].priority > m_alertRules[best].priority) {
+                    best = matches[i].ruleIndex;
+                }
+            }
+            
+            // Cooldown is updated in place so later events in the batch see it
+            AlertRule &rule = m_alertRules[best];
+            if (isRuleInCooldown(rule)) continue;
+            rule.lastTriggered = now;
+            startRuleCooldownLocked(rule);
+            alerts.append(qMakePair(eventIndex, rule));
+        }
+    }
+    
+    emit alertBatchEvaluated(matches, earthquakes.size());
+    
+    for (const auto &alert : alerts) {
+        raiseEarthquakeAlert(earthquakes[alert.first], alert.second);
+    }
+    return alerts.size();
+}
+
+QVector<AlertMatch> NotificationManager::evaluateBatch(const QVector<EarthquakeData> &earthquakes)
+{
+    QVector<AlertMatch> matches;
+    {
+        QMutexLocker locker(&m_rulesMutex);
+        matches = evaluateRulesLocked(earthquakes);
+    }
+    
+    emit alertBatchEvaluated(matches, earthquakes.size());
+    return matches;
+}
+
+QVector<AlertMatch> NotificationManager::evaluateRulesLocked(const QVector<EarthquakeData> &earthquakes)
+{
+    // Rules are compiled lazily after any change and reused across batches
+    if (!m_compiledRulesValid) {
+        m_compiledRules.setUserLocation(m_userLatitude, m_userLongitude);
+        m_compiledRules.compile(m_alertRules);
+        if (m_compiledRules.size() >= INDEXED_RULE_THRESHOLD) {
+            m_ruleIndex.build(m_compiledRules);
+        } else {
+            m_ruleIndex.clear();
+        }
+        m_compiledRulesValid = true;
+    }
+    
+    auto inRegion = [this](const EarthquakeData &eq, const QVector<int> &regionIds) {
+        return isInRegion(eq, regionIds);
+    };
+    
+    // Small rule sets are cheaper to scan than to index
+    if (m_ruleIndex.ruleCount() > 0) {
+        return m_ruleIndex.evaluate(m_compiledRules, earthquakes, inRegion);
+    }
+    return m_compiledRules.evaluate(earthquakes, inRegion);
+}
+
+void NotificationManager::invalidateCompiledRules()
+{
+    m_compiledRulesValid = false;
+}
+
+void NotificationManager::emitAlertRulesChanged(QMutexLocker<QMutex> &locker)
+{
+    // Listeners may call back into the rule API
+    const QVector<AlertRule> rules = m_alertRules;
+    locker.unlock();
+    emit alertRulesChanged(rules);
+}
+
+void NotificationManager::raiseEarthquakeAlert(const EarthquakeData &earthquake, const AlertRule &activeRule)
+{
     // Create notification
     NotificationData notification;
     notification.id = generateNotificationId();
@@ -465,19 +800,51 @@ void NotificationManager::showEarthquakeAlert(const EarthquakeData &earthquake)
     metadata["ruleName"] = activeRule.name;
     metadata["soundType"] = static_cast<int>(activeRule.soundType);
     
+    ShakingCountdown countdown;
     if (m_hasUserLocation) {
         double distance = calculateDistanceToUser(earthquake.latitude, earthquake.longitude);
         metadata["distanceKm"] = distance;
         notification.message += QString("\nDistance: %1 km").arg(distance, 0, 'f', 0);
+        
+        countdown.eventId = earthquake.eventId;
+        countdown.magnitude = earthquake.magnitude;
+        countdown.latitude = earthquake.latitude;
+        countdown.longitude = earthquake.longitude;
+        countdown.depth = earthquake.depth;
+        countdown.originTime = earthquake.timestamp;
+        countdown.distanceKm = distance;
+        countdown.pArrival = earthquake.timestamp.addMSecs(
+            qRound64(TravelTimes::travelTime(TravelTimes::Phase::P, distance, earthquake.depth) * 1000.0));
+        countdown.sArrival = earthquake.timestamp.addMSecs(
+            qRound64(TravelTimes::travelTime(TravelTimes::Phase::S, distance, earthquake.depth) * 1000.0));
+        metadata["pArrivalTime"] = countdown.pArrival.toString(Qt::ISODateWithMs);
+        metadata["sArrivalTime"] = countdown.sArrival.toString(Qt::ISODateWithMs);
+        
+        // Feeds usually lag the origin time, so nearby S waves have often passed
+        const qint64 remainingMs = QDateTime::currentDateTime().msecsTo(countdown.sArrival);
+        if (remainingMs > 0) {
+            countdown.secondsToShaking = remainingMs / 1000.0;
+            notification.message += QString("\nShaking expected in %1 s").arg(countdown.secondsToShaking, 0, 'f', 0);
+        }
     }
     
     notification.metadata = metadata;
     
-    // Show notification
-    showNotification(notification);
+    // Bursts near one place are folded into a digest instead of being rate-limited away
+    bool shown = false;
+    if (m_settings.groupSimilarEvents) {
+        QString digestId;
+        shown = deliverCoalesced(m_coalescer.add(notification, earthquake,
+                                                 QDateTime::currentMSecsSinceEpoch(), isRateLimited(), &digestId));
+        scheduleDigest(digestId);
+    } else {
+        shown = showNotification(notification);
+    }
     
-    // Update rule cooldown
-    updateRuleCooldown(activeRule.name);
+    // Only an alert the user actually sees counts down; a digest does not
+    if (shown && countdown.secondsToShaking > 0.0) {
+        startShakingCountdown(countdown);
+    }
     
     // Emit signal
     emit alertRuleTriggered(activeRule.name, earthquake);
@@ -486,6 +853,113 @@ void NotificationManager::showEarthquakeAlert(const EarthquakeData &earthquake)
              << "M" << earthquake.magnitude << earthquake.location;
 }
 
+void NotificationManager::fanOutToSubscribers(const QVector<EarthquakeData> &earthquakes)
+{
+    if (m_subscribers.size() == 0) return;
+    
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (const EarthquakeData &earthquake : earthquakes) {
+        const QVector<SubscriberRegistry::Match> matches = m_subscribers.match(earthquake, now);
+        if (matches.isEmpty()) continue;
+        
+        QStringList emails;
+        QStringList phones;
+        QStringList pushTokens;
+        for (const SubscriberRegistry::Match &match : matches) {
+            const QString email = m_subscribers.contact(match.index, DeliveryChannel::EmailAlert);
+            const QString phone = m_subscribers.contact(match.index, DeliveryChannel::SMSAlert);
+            const QString pushToken = m_subscribers.contact(match.index, DeliveryChannel::PushNotification);
+            if (!email.isEmpty()) emails.append(email);
+            if (!phone.isEmpty()) phones.append(phone);
+            if (!pushToken.isEmpty()) pushTokens.append(pushToken);
+        }
+        
+        // One notification shared by all recipients, so the channels batch them together
+        NotificationData notification;
+        notification.id = generateNotificationId();
+        notification.title = "Earthquake Alert";
+        notification.message = formatEarthquakeMessage(earthquake);
+        notification.timestamp = QDateTime::currentDateTime();
+        notification.sourceEventId = earthquake.eventId;
+        notification.metadata["eventId"] = earthquake.eventId;
+        notification.metadata["magnitude"] = earthquake.magnitude;
+        notification.metadata["depth"] = earthquake.depth;
+        notification.metadata["latitude"] = earthquake.latitude;
+        notification.metadata["longitude"] = earthquake.longitude;
+        
+        const QString headline = notification.message.section('\n', 0, 0);
+        if (!emails.isEmpty()) {
+            sendEmail(notification, emails, QString("[Earthquake Alert] %1").arg(headline), notification.message);
+        }
+        if (!phones.isEmpty()) {
+            sendSms(notification, phones, QString("%1: %2").arg(notification.title, headline).left(160));
+        }
+        if (!pushTokens.isEmpty()) {
+            sendPushNotification(notification, pushTokens);
+        }
+        
+        m_metrics.incrementCounter("earthquake_subscriber_alerts_total", QString(), matches.size());
+        qDebug() << "Fanned out" << earthquake.eventId << "to" << matches.size() << "subscribers";
+    }
+}
+
+void NotificationManager::raiseSeismicityAnomaly(const SeismicityRateDetector::Anomaly &anomaly)
+{
+    const QString location = GeoJsonParser::coordinateToString(QGeoCoordinate(anomaly.latitude, anomaly.longitude));
+    
+    NotificationData notification;
+    notification.id = generateNotificationId();
+    notification.title = "Unusual Seismic Activity";
+    notification.message = QString("About %1 events near %2 in the last day, %3 times the usual rate")
+                           .arg(qRound(anomaly.observed))
+                           .arg(location)
+                           .arg(anomaly.observed / anomaly.expected, 0, 'f', 0);
+    notification.type = NotificationType::SeismicityAnomaly;
+    notification.priority = NotificationPriority::High;
+    notification.timestamp = QDateTime::currentDateTime();
+    notification.channels = {DeliveryChannel::DesktopNotification, DeliveryChannel::SystemTray, DeliveryChannel::LogFile};
+    notification.sourceEventId = anomaly.eventId;
+    notification.expiryTime = QDateTime::currentDateTime().addSecs(24 * 3600);
+    
+    QJsonObject metadata;
+    metadata["latitude"] = anomaly.latitude;
+    metadata["longitude"] = anomaly.longitude;
+    metadata["location"] = location;
+    metadata["observedEvents"] = anomaly.observed;
+    metadata["expectedEvents"] = anomaly.expected;
+    metadata["logLikelihoodRatio"] = anomaly.logLikelihoodRatio;
+    metadata["eventId"] = anomaly.eventId;
+    notification.metadata = metadata;
+    
+    showNotification(notification);
+    m_metrics.incrementCounter("earthquake_seismicity_anomalies_total");
+    
+    qDebug() << "Seismicity anomaly near" << location << "observed" << anomaly.observed
+             << "expected" << anomaly.expected;
+}
+
+void NotificationManager::startShakingCountdown(const ShakingCountdown &countdown)
+{
+    // A revised event replaces its earlier countdown
+    for (int i = 0; i < m_shakingCountdowns.size(); ++i) {
+        if (m_shakingCountdowns[i].eventId == countdown.eventId) {
+            m_shakingCountdowns.removeAt(i);
+            break;
+        }
+    }
+    
+    auto position = std::upper_bound(m_shakingCountdowns.begin(), m_shakingCountdowns.end(), countdown,
+                                     [](const ShakingCountdown &a, const ShakingCountdown &b) {
+                                         return a.sArrival < b.sArrival;
+                                     });
+    m_shakingCountdowns.insert(position, countdown);
+    
+    if (!m_countdownTimer->isActive()) {
+        m_countdownTimer->start(COUNTDOWN_INTERVAL_MS);
+    }
+    emit shakingCountdownUpdated(m_shakingCountdowns);
+}
+
 void NotificationManager::showSystemNotification(const QString &title, const QString &message, NotificationType type)
 {
     NotificationData notification;
@@ -519,13 +993,9 @@ void NotificationManager::acknowledgeNotification(const QString &id)
 {
     QMutexLocker locker(&m_notificationMutex);
     
-    for (auto &notification : m_activeNotifications) {
-        if (notification.id == id) {
-            notification.acknowledged = true;
-            emit notificationAcknowledged(id);
-            qDebug() << "Notification acknowledged:" << id;
-            return;
-        }
+    if (m_activeNotifications.acknowledge(id)) {
+        emit notificationAcknowledged(id);
+        qDebug() << "Notification acknowledged:" << id;
     }
 }
 
@@ -533,37 +1003,12 @@ void NotificationManager::acknowledgeAllNotifications()
 {
     QMutexLocker locker(&m_notificationMutex);
     
-    int count = 0;
-    for (auto &notification : m_activeNotifications) {
-        if (!notification.acknowledged) {
-            notification.acknowledged = true;
-            emit notificationAcknowledged(notification.id);
-            count++;
-        }
-    }
-    
-    qDebug() << "Acknowledged all notifications, count:" << count;
-}
-
-void NotificationManager::clearExpiredNotifications()
-{
-    QMutexLocker locker(&m_notificationMutex);
-    QDateTime now = QDateTime::currentDateTime();
-    
-    int removed = 0;
-    auto it = m_activeNotifications.begin();
-    while (it != m_activeNotifications.end()) {
-        if (it->expiryTime.isValid() && now > it->expiryTime) {
-            it = m_activeNotifications.erase(it);
-            removed++;
-        } else {
-            ++it;
-        }
+    const QStringList acknowledged = m_activeNotifications.acknowledgeAll();
+    for (const QString &id : acknowledged) {
+        emit notificationAcknowledged(id);
     }
     
-    if (removed > 0) {
-        qDebug() << "Cleared" << removed << "expired notifications";
-    }
+    qDebug() << "Acknowledged all notifications, count:" << acknowledged.size();
 }
 
 void NotificationManager::clearAllNotifications()
@@ -572,7 +1017,14 @@ void NotificationManager::clearAllNotifications()
     
     int count = m_activeNotifications.size();
     m_activeNotifications.clear();
-    m_notificationQueue.clear();
+    m_coalescer.clear();
+    for (TimingWheel::TimerId id : std::as_const(m_digestTasks)) {
+        m_timingWheel.cancel(id);
+    }
+    m_digestTasks.clear();
+    
+    // Only the worker may pop from the queue
+    QMetaObject::invokeMethod(m_deliveryWorker, &NotificationDeliveryWorker::discardPending, Qt::QueuedConnection);
     
     qDebug() << "Cleared all notifications, count:" << count;
 }
@@ -597,6 +1049,8 @@ void NotificationManager::enableSounds(bool enabled)
 void NotificationManager::enableQuietHours(bool enabled)
 {
     m_settings.respectQuietHours = enabled;
+    checkQuietHours();
+    scheduleQuietHoursBoundary();
     saveSettings();
     emit settingsChanged(m_settings);
 }
@@ -673,17 +1127,16 @@ bool NotificationManager::isInQuietHours() const
     QTime startTime(m_settings.quietHoursStart, 0);
     QTime endTime(m_settings.quietHoursEnd, 0);
     
-    // Handle overnight quiet hours (e.g., 22:00 to 07:00)
+    // Handle overnight quiet hours (e.g., 22:00 to 07:00); the end hour is not quiet
     if (startTime > endTime) {
-        return currentTime >= startTime || currentTime <= endTime;
+        return currentTime >= startTime || currentTime < endTime;
     } else {
-        return currentTime >= startTime && currentTime <= endTime;
+        return currentTime >= startTime && currentTime < endTime;
     }
 }
 
 int NotificationManager::getPendingNotificationsCount() const
 {
-    QMutexLocker locker(&m_notificationMutex);
     return m_notificationQueue.size();
 }
 
@@ -698,7 +1151,8 @@ QVector<NotificationData> NotificationManager::getRecentNotifications(int hours)
     QDateTime cutoff = QDateTime::currentDateTime().addSecs(-hours * 3600);
     
     QVector<NotificationData> recent;
-    for (const auto &notification : m_notificationHistory) {
+    for (int i = 0; i < m_notificationHistory.size(); ++i) {
+        const NotificationData &notification = m_notificationHistory.at(i);
         if (notification.timestamp >= cutoff) {
             recent.append(notification);
         }
@@ -711,14 +1165,7 @@ QVector<NotificationData> NotificationManager::getUnacknowledgedNotifications()
 {
     QMutexLocker locker(&m_notificationMutex);
     
-    QVector<NotificationData> unacknowledged;
-    for (const auto &notification : m_activeNotifications) {
-        if (!notification.acknowledged) {
-            unacknowledged.append(notification);
-        }
-    }
-    
-    return unacknowledged;
+    return m_activeNotifications.unacknowledged();
 }
 
 void NotificationManager::onSystemTrayActivated(QSystemTrayIcon::ActivationReason reason)
@@ -736,56 +1183,186 @@ void NotificationManager::onSystemTrayActivated(QSystemTrayIcon::ActivationReaso
     }
 }
 
-void NotificationManager::processNotificationQueue()
+const MetricsRegistry &NotificationManager::metrics() const
 {
-    if (m_notificationQueue.isEmpty()) {
-        return;
+    return m_metrics;
+}
+
+QString NotificationManager::exportMetricsPrometheus() const
+{
+    return m_metrics.toPrometheusText();
+}
+
+void NotificationManager::onNotificationBatch(const QVector<NotificationData> &batch)
+{
+    for (const NotificationData &notification : batch) {
+        processNotification(notification);
+    }
+}
+
+void NotificationManager::onTimingWheelTimeout()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    const QVector<TimingWheel::Timer> due = m_timingWheel.advance(now.toMSecsSinceEpoch());
+    
+    for (const TimingWheel::Timer &timer : due) {
+        switch (static_cast<TimedTask>(timer.kind)) {
+        case TimedTask::RuleCooldown: {
+            QMutexLocker locker(&m_rulesMutex);
+            // A re-trigger cancels the old entry, so a mismatch means the rule was replaced
+            auto it = m_ruleCooldowns.find(timer.key);
+            if (it != m_ruleCooldowns.end() && it.value() == timer.id) {
+                m_ruleCooldowns.erase(it);
+            }
+            break;
+        }
+        case TimedTask::NotificationExpiry: {
+            QMutexLocker locker(&m_notificationMutex);
+            // The notification may have been replaced with a later expiry
+            const NotificationData *notification = m_activeNotifications.find(timer.key);
+            if (notification && notification->expiryTime.isValid() && notification->expiryTime <= now) {
+                m_activeNotifications.remove(timer.key);
+            }
+            break;
+        }
+        case TimedTask::HourlyReset:
+            resetHourlyCounter();
+            break;
+        case TimedTask::DailyReset:
+            resetDailyCounters();
+            break;
+        case TimedTask::QuietHoursBoundary:
+            checkQuietHours();
+            scheduleQuietHoursBoundary();
+            break;
+        case TimedTask::StatisticsUpdate:
+            updateStatistics();
+            scheduleTask(now.toMSecsSinceEpoch() + STATISTICS_UPDATE_INTERVAL_MS, TimedTask::StatisticsUpdate);
+            break;
+        case TimedTask::SnapshotSave:
+            // A crash loses at most one interval of alert state
+            saveSnapshot();
+            scheduleTask(now.toMSecsSinceEpoch() + SNAPSHOT_INTERVAL_MS, TimedTask::SnapshotSave);
+            break;
+        case TimedTask::ClusterDigest: {
+            // Every alert joining the cluster reschedules it; a mismatch means this entry was replaced
+            auto it = m_digestTasks.find(timer.key);
+            if (it == m_digestTasks.end() || it.value() != timer.id) break;
+            m_digestTasks.erase(it);
+            deliverCoalesced(m_coalescer.takeDueDigest(timer.key, now.toMSecsSinceEpoch()));
+            scheduleDigest(timer.key);
+            break;
+        }
+        }
     }
     
-    QMutexLocker locker(&m_notificationMutex);
-    NotificationData notification = m_notificationQueue.dequeue();
-    locker.unlock();
+    armTimingWheel();
+}
+
+TimingWheel::TimerId NotificationManager::scheduleTask(qint64 dueMs, TimedTask task, const QString &key)
+{
+    const TimingWheel::TimerId id = m_timingWheel.schedule(dueMs, static_cast<int>(task), key);
     
-    processNotification(notification);
+    // The wheel timer belongs to this thread; callers may be on another
+    QMetaObject::invokeMethod(this, &NotificationManager::armTimingWheel, Qt::AutoConnection);
+    return id;
 }
 
-void NotificationManager::cleanupExpiredNotifications()
+void NotificationManager::armTimingWheel()
 {
-    clearExpiredNotifications();
+    const qint64 wakeMs = m_timingWheel.nextWakeMs();
+    if (wakeMs < 0) {
+        m_timingWheelTimer->stop();
+        return;
+    }
     
-    // Cleanup history if too large
-    QMutexLocker locker(&m_notificationMutex);
-    if (m_notificationHistory.size() > MAX_NOTIFICATION_HISTORY) {
-        int toRemove = m_notificationHistory.size() - MAX_NOTIFICATION_HISTORY;
-        m_notificationHistory.remove(0, toRemove);
+    const qint64 delayMs = qMax<qint64>(0, wakeMs - QDateTime::currentMSecsSinceEpoch());
+    m_timingWheelTimer->start(int(qMin<qint64>(delayMs, std::numeric_limits<int>::max())));
+}
+
+void NotificationManager::scheduleNotificationExpiry(const NotificationData &notification)
+{
+    if (notification.expiryTime.isValid()) {
+        scheduleTask(notification.expiryTime.toMSecsSinceEpoch(), TimedTask::NotificationExpiry, notification.id);
     }
 }
 
-void NotificationManager::updateStatistics()
+void NotificationManager::scheduleDigest(const QString &digestId)
 {
-    resetDailyCounters();
+    auto it = m_digestTasks.find(digestId);
+    if (it != m_digestTasks.end()) {
+        m_timingWheel.cancel(it.value());
+        m_digestTasks.erase(it);
+    }
     
-    QMutexLocker locker(&m_notificationMutex);
-    int pending = m_notificationQueue.size();
-    int acknowledged = 0;
+    // The cluster's pending digest, or its expiry once nothing is pending
+    const qint64 dueMs = m_coalescer.nextDueMs(digestId);
+    if (dueMs >= 0) {
+        m_digestTasks.insert(digestId, scheduleTask(dueMs, TimedTask::ClusterDigest, digestId));
+    }
+}
+
+void NotificationManager::scheduleQuietHoursBoundary()
+{
+    if (m_quietHoursBoundary != 0) {
+        m_timingWheel.cancel(m_quietHoursBoundary);
+        m_quietHoursBoundary = 0;
+    }
+    if (!m_settings.respectQuietHours || m_settings.quietHoursStart == m_settings.quietHoursEnd) {
+        return;
+    }
     
-    for (const auto &notification : m_activeNotifications) {
-        if (notification.acknowledged) {
-            acknowledged++;
+    // Next local start or end of quiet hours, today or tomorrow
+    const QDateTime now = QDateTime::currentDateTime();
+    QDateTime next;
+    for (int days = 0; days <= 1; ++days) {
+        const QDate date = now.date().addDays(days);
+        for (int hour : {m_settings.quietHoursStart, m_settings.quietHoursEnd}) {
+            const QDateTime boundary(date, QTime(hour, 0));
+            if (boundary > now && (!next.isValid() || boundary < next)) {
+                next = boundary;
+            }
         }
     }
+    m_quietHoursBoundary = scheduleTask(next.toMSecsSinceEpoch(), TimedTask::QuietHoursBoundary);
+}
+
+void NotificationManager::updateStatistics()
+{
+    int pending = m_notificationQueue.size();
+    QMutexLocker locker(&m_notificationMutex);
+    int acknowledged = m_activeNotifications.acknowledgedCount();
     
     emit statisticsUpdated(m_notificationsToday, pending, acknowledged);
     updateSystemTrayTooltip();
 }
 
+void NotificationManager::updateShakingCountdowns()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    
+    // Sorted by arrival, so arrived entries are at the front
+    while (!m_shakingCountdowns.isEmpty() && m_shakingCountdowns.first().sArrival <= now) {
+        const QString eventId = m_shakingCountdowns.takeFirst().eventId;
+        emit shakingArrived(eventId);
+    }
+    for (auto &countdown : m_shakingCountdowns) {
+        countdown.secondsToShaking = now.msecsTo(countdown.sArrival) / 1000.0;
+    }
+    
+    if (m_shakingCountdowns.isEmpty()) {
+        m_countdownTimer->stop();
+    }
+    emit shakingCountdownUpdated(m_shakingCountdowns);
+    updateSystemTrayTooltip();
+}
+
 void NotificationManager::checkQuietHours()
 {
-    // This runs every minute to check if we've entered/exited quiet hours
-    static bool wasInQuietHours = false;
+    // Runs at each quiet-hours boundary and after settings changes
     bool nowInQuietHours = isInQuietHours();
     
-    if (wasInQuietHours != nowInQuietHours) {
+    if (m_inQuietHours != nowInQuietHours) {
         QString message = nowInQuietHours ? "Entered quiet hours - notifications muted" : 
                                           "Exited quiet hours - notifications resumed";
         qDebug() << message;
@@ -797,7 +1374,7 @@ void NotificationManager::checkQuietHours()
         }
     }
     
-    wasInQuietHours = nowInQuietHours;
+    m_inQuietHours = nowInQuietHours;
 }
 
 void NotificationManager::processNotification(const NotificationData &notification)
@@ -808,6 +1385,9 @@ void NotificationManager::processNotification(const NotificationData &notificati
         return;
     }
     
+    QElapsedTimer deliveryTimer;
+    deliveryTimer.start();
+    
     // Deliver to all specified channels
     for (DeliveryChannel channel : notification.channels) {
         try {
@@ -844,10 +1424,15 @@ void NotificationManager::processNotification(const NotificationData &notificati
         }
     }
     
+    m_metrics.recordLatency("earthquake_notification_delivery_seconds",
+                            NotificationDeliveryWorker::priorityLabel(notification.priority),
+                            deliveryTimer.nsecsElapsed() / 1000);
+    
     // Add to active notifications and history
     QMutexLocker locker(&m_notificationMutex);
-    m_activeNotifications.append(notification);
-    m_notificationHistory.append(notification);
+    m_activeNotifications.insert(notification);
+    m_notificationHistory.pushOverwrite(notification);
+    scheduleNotificationExpiry(notification);
     
     emit notificationShown(notification.id, notification.type);
     
@@ -874,10 +1459,8 @@ bool NotificationManager::shouldShowNotification(const NotificationData &notific
     // Check for duplicate notifications (grouping)
     if (m_settings.groupSimilarEvents && !notification.sourceEventId.isEmpty()) {
         QMutexLocker locker(&m_notificationMutex);
-        for (const auto &existing : m_activeNotifications) {
-            if (existing.sourceEventId == notification.sourceEventId && !existing.acknowledged) {
-                return false; // Skip duplicate
-            }
+        if (m_activeNotifications.hasUnacknowledged(notification.sourceEventId)) {
+            return false; // Skip duplicate
         }
     }
     
@@ -891,24 +1474,41 @@ QString NotificationManager::generateNotificationId() const
 
 void NotificationManager::enqueueNotification(const NotificationData &notification)
 {
-    QMutexLocker locker(&m_notificationMutex);
-    
-    if (m_notificationQueue.size() >= MAX_QUEUE_SIZE) {
-        // Remove oldest non-critical notification
-        for (int i = 0; i < m_notificationQueue.size(); ++i) {
-            if (m_notificationQueue[i].priority < NotificationPriority::Critical) {
-                m_notificationQueue.removeAt(i);
-                break;
-            }
-        }
-        
-        // If still full, remove oldest
-        if (m_notificationQueue.size() >= MAX_QUEUE_SIZE) {
-            m_notificationQueue.dequeue();
+    // Emergency notifications are delivered immediately, ahead of any backlog
+    if (NotificationQueue::bypassesQueue(notification.priority)) {
+        m_metrics.incrementCounter("earthquake_notification_emergency_bypass_total");
+        if (QThread::currentThread() == thread()) {
+            processNotification(notification);
+        } else {
+            QMetaObject::invokeMethod(this, [this, notification]() {
+                processNotification(notification);
+            }, Qt::QueuedConnection);
         }
+        return;
     }
     
-    m_notificationQueue.enqueue(notification);
+    // Lock-free; a full priority lane drops the new notification (counted by the worker)
+    if (!m_notificationQueue.tryPush(notification, NotificationQueue::nowUs())) {
+        qWarning() << "Notification queue full, dropping:" << notification.title;
+        return;
+    }
+    m_deliveryWorker->scheduleDrain();
+}
+
+bool NotificationManager::deliverCoalesced(const QVector<NotificationData> &notifications)
+{
+    bool shown = false;
+    for (const NotificationData &notification : notifications) {
+        if (!NotificationCoalescer::isDigest(notification)) {
+            shown = showNotification(notification) || shown;
+        } else if (m_settings.enabled) {
+            // Digests are throttled by the coalescer and replace each other, so
+            // the hourly limit and the duplicate check do not apply
+            enqueueNotification(notification);
+            updateRateLimit();
+        }
+    }
+    return shown;
 }
 
 void NotificationManager::deliverToSystemTray(const NotificationData &notification)
@@ -969,7 +1569,7 @@ void NotificationManager::deliverEmailAlert(const NotificationData &notification
                    .arg(notification.details)
                    .arg(notification.timestamp.toString("yyyy-MM-dd hh:mm:ss UTC"));
     
-    sendEmail(m_settings.emailAddress, subject, body);
+    sendEmail(notification, splitRecipients(m_settings.emailAddress), subject, body);
 }
 
 void NotificationManager::deliverSmsAlert(const NotificationData &notification)
@@ -984,7 +1584,7 @@ void NotificationManager::deliverSmsAlert(const NotificationData &notification)
         message = message.left(157) + "...";
     }
     
-    sendSms(m_settings.smsNumber, message);
+    sendSms(notification, splitRecipients(m_settings.smsNumber), message);
 }
 
 void NotificationManager::deliverPushNotification(const NotificationData &notification)
@@ -993,7 +1593,8 @@ void NotificationManager::deliverPushNotification(const NotificationData &notifi
         return;
     }
     
-    sendPushNotification(notification.title, notification.message, notification.metadata);
+    // The push service fans out to its registered devices itself
+    sendPushNotification(notification, QStringList{"all"});
 }
 
 void NotificationManager::deliverToLogFile(const NotificationData &notification)
@@ -1024,46 +1625,33 @@ void NotificationManager::deliverToConsole(const NotificationData &notification)
 
 void NotificationManager::playSound(SoundType soundType, NotificationPriority priority)
 {
-    if (soundType == SoundType::None || !m_soundEffect) {
+    if (soundType == SoundType::None || !m_soundBank) {
         return;
     }
     
-    QString soundPath;
-    if (soundType == SoundType::Custom && !m_settings.customSoundPath.isEmpty()) {
-        soundPath = m_settings.customSoundPath;
-    } else {
-        soundPath = getSoundFilePath(soundType);
-    }
-    
-    if (soundPath.isEmpty() || !QFile::exists(soundPath)) {
-        qWarning() << "Sound file not found:" << soundPath;
+    float volume = calculateSoundVolume(priority);
+    if (!m_soundBank->play(soundType, priority, volume)) {
+        qWarning() << "No sound loaded for type" << static_cast<int>(soundType);
         return;
     }
     
-    float volume = calculateSoundVolume(priority);
-    
-    m_soundEffect->setSource(QUrl::fromLocalFile(soundPath));
-    m_soundEffect->setVolume(volume);
-    m_soundEffect->play();
-    
-    qDebug() << "Playing sound:" << soundPath << "Volume:" << volume;
+    qDebug() << "Playing sound:" << m_soundBank->source(soundType) << "Volume:" << volume;
 }
 
 void NotificationManager::playCustomSound(const QString &filePath, float volume)
 {
-    if (!m_soundEffect || !QFile::exists(filePath)) {
+    if (!m_soundBank || !QFile::exists(filePath)) {
         return;
     }
     
-    m_soundEffect->setSource(QUrl::fromLocalFile(filePath));
-    m_soundEffect->setVolume(volume);
-    m_soundEffect->play();
+    // On a voice of its own, so the configured custom sound stays as it is
+    m_soundBank->playPreview(filePath, volume);
 }
 
 void NotificationManager::stopAllSounds()
 {
-    if (m_soundEffect) {
-        m_soundEffect->stop();
+    if (m_soundBank) {
+        m_soundBank->stopAll();
     }
     if (m_mediaPlayer) {
         m_mediaPlayer->stop();
@@ -1087,58 +1675,24 @@ float NotificationManager::calculateSoundVolume(NotificationPriority priority) c
     }
 }
 
-QVector<AlertRule> NotificationManager::getTriggeredRules(const EarthquakeData &earthquake) const
+QVector<AlertRule> NotificationManager::getTriggeredRules(const EarthquakeData &earthquake)
 {
     QMutexLocker locker(&m_rulesMutex);
     QVector<AlertRule> triggered;
     
-    for (const auto &rule : m_alertRules) {
-        if (rule.enabled && evaluateAlertRule(rule, earthquake)) {
-            triggered.append(rule);
-        }
+    // Same compiled rules (and expressions) as the batch path
+    const QVector<AlertMatch> matches = evaluateRulesLocked(QVector<EarthquakeData>{earthquake});
+    for (const AlertMatch &match : matches) {
+        triggered.append(m_alertRules[match.ruleIndex]);
     }
     
     return triggered;
 }
 
-bool NotificationManager::evaluateAlertRule(const AlertRule &rule, const EarthquakeData &earthquake) const
-{
-    // Check magnitude range
-    if (earthquake.magnitude < rule.minMagnitude || earthquake.magnitude > rule.maxMagnitude) {
-        return false;
-    }
-    
-    // Check depth range
-    if (earthquake.depth < rule.minDepth || earthquake.depth > rule.maxDepth) {
-        return false;
-    }
-    
-    // Check location-based rules
-    if (rule.useLocation && m_hasUserLocation) {
-        double distance = calculateDistanceToUser(earthquake.latitude, earthquake.longitude);
-        if (distance > rule.radiusKm) {
-            return false;
-        }
-    }
-    
-    // Check specific regions
-    if (!rule.regions.isEmpty()) {
-        if (!isInRegion(earthquake, rule.regions)) {
-            return false;
-        }
-    }
-    
-    return true;
-}
-
 bool NotificationManager::isRuleInCooldown(const AlertRule &rule) const
 {
-    if (rule.cooldownMinutes <= 0) {
-        return false;
-    }
-    
-    QDateTime cooldownEnd = rule.lastTriggered.addSecs(rule.cooldownMinutes * 60);
-    return QDateTime::currentDateTime() < cooldownEnd;
+    // Entries are removed by the timing wheel when the cooldown ends
+    return m_ruleCooldowns.contains(rule.name);
 }
 
 void NotificationManager::updateRuleCooldown(const QString &ruleName)
@@ -1148,11 +1702,45 @@ void NotificationManager::updateRuleCooldown(const QString &ruleName)
     for (auto &rule : m_alertRules) {
         if (rule.name == ruleName) {
             rule.lastTriggered = QDateTime::currentDateTime();
+            startRuleCooldownLocked(rule);
             break;
         }
     }
 }
 
+void NotificationManager::startRuleCooldownLocked(const AlertRule &rule)
+{
+    cancelRuleCooldownLocked(rule.name);
+    if (rule.cooldownMinutes <= 0 || !rule.lastTriggered.isValid()) {
+        return;
+    }
+    
+    const qint64 endMs = rule.lastTriggered.toMSecsSinceEpoch() + rule.cooldownMinutes * 60000LL;
+    if (endMs > QDateTime::currentMSecsSinceEpoch()) {
+        m_ruleCooldowns.insert(rule.name, scheduleTask(endMs, TimedTask::RuleCooldown, rule.name));
+    }
+}
+
+void NotificationManager::cancelRuleCooldownLocked(const QString &ruleName)
+{
+    auto it = m_ruleCooldowns.find(ruleName);
+    if (it != m_ruleCooldowns.end()) {
+        m_timingWheel.cancel(it.value());
+        m_ruleCooldowns.erase(it);
+    }
+}
+
+void NotificationManager::restartRuleCooldownsLocked()
+{
+    for (TimingWheel::TimerId id : std::as_const(m_ruleCooldowns)) {
+        m_timingWheel.cancel(id);
+    }
+    m_ruleCooldowns.clear();
+    for (const AlertRule &rule : std::as_const(m_alertRules)) {
+        startRuleCooldownLocked(rule);
+    }
+}
+
 QString NotificationManager::formatEarthquakeMessage(const EarthquakeData& earthquake) const
 {
     QString message = QString("M%1 earthquake - %2")
@@ -1226,14 +1814,9 @@ double NotificationManager::calculateDistanceToUser(double lat, double lon) cons
     return SpatialUtils::haversineDistance(m_userLatitude, m_userLongitude, lat, lon);
 }
 
-bool NotificationManager::isInRegion(const EarthquakeData& earthquake, const QStringList& regions) const
+bool NotificationManager::isInRegion(const EarthquakeData& earthquake, const QVector<int>& regionIds) const
 {
-    for (const QString& region : regions) {
-        if (region.contains(earthquake.location.toString(), Qt::CaseInsensitive)) {
-            return true;
-        }
-    }
-    return false;
+    return m_regionRegistry.containsAny(regionIds, earthquake.latitude, earthquake.longitude);
 }
 
 bool NotificationManager::isRateLimited() const
@@ -1243,42 +1826,50 @@ bool NotificationManager::isRateLimited() const
 
 void NotificationManager::updateRateLimit()
 {
+    // Reset by the HourlyReset and DailyReset tasks
     m_notificationsThisHour++;
     m_notificationsToday++;
-    
-    QDateTime now = QDateTime::currentDateTime();
-    if (m_lastHourReset.secsTo(now) >= 3600) {
-        m_notificationsThisHour = 0;
-        m_lastHourReset = now;
-    }
+}
+
+void NotificationManager::resetHourlyCounter()
+{
+    QMutexLocker locker(&m_notificationMutex);
+    m_notificationsThisHour = 0;
+    m_lastHourReset = QDateTime::currentDateTime();
+    scheduleTask(m_lastHourReset.toMSecsSinceEpoch() + 3600000LL, TimedTask::HourlyReset);
 }
 
 void NotificationManager::resetDailyCounters()
 {
-    QDateTime now = QDateTime::currentDateTime();
-    if (m_lastDayReset.daysTo(now) >= 1) {
-        m_notificationsToday = 0;
-        m_lastDayReset = now;
-    }
+    QMutexLocker locker(&m_notificationMutex);
+    m_notificationsToday = 0;
+    m_lastDayReset = QDateTime::currentDateTime();
+    
+    // Next local midnight
+    scheduleTask(QDateTime(m_lastDayReset.date().addDays(1), QTime(0, 0)).toMSecsSinceEpoch(), TimedTask::DailyReset);
 }
 
 void NotificationManager::saveNotificationToFile(const NotificationData &notification)
 {
-    QFile logFile(m_notificationLogFile);
-    if (!logFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
-        qWarning() << "Failed to open notification log file:" << m_notificationLogFile;
-        return;
+    QJsonArray channels;
+    for (DeliveryChannel channel : notification.channels) {
+        channels.append(static_cast<int>(channel));
     }
     
-    QTextStream stream(&logFile);
-    stream << notification.timestamp.toString(Qt::ISODate) << " | "
-           << static_cast<int>(notification.type) << " | "
-           << static_cast<int>(notification.priority) << " | "
-           << notification.title << " | "
-           << notification.message << " | "
-           << notification.id << "\n";
+    QJsonObject record;
+    record["id"] = notification.id;
+    record["title"] = notification.title;
+    record["message"] = notification.message;
+    record["type"] = static_cast<int>(notification.type);
+    record["priority"] = static_cast<int>(notification.priority);
+    record["timestamp"] = notification.timestamp.toString(Qt::ISODate);
+    record["sourceEventId"] = notification.sourceEventId;
+    record["channels"] = channels;
     
-    stream.flush();
+    // Buffered; the writer thread batches, syncs and rotates the file
+    if (!m_logWriter->append(record)) {
+        qWarning() << "Notification log buffer full, dropped:" << notification.id;
+    }
 }
 
 void NotificationManager::loadPersistentNotifications()
@@ -1315,49 +1906,127 @@ void NotificationManager::loadPersistentNotifications()
         notification.metadata = obj["metadata"].toObject();
         
         if (notification.persistent && !notification.acknowledged) {
-            m_activeNotifications.append(notification);
+            m_activeNotifications.insert(notification);
+            scheduleNotificationExpiry(notification);
         }
     }
     
     qDebug() << "Loaded" << notifications.size() << "persistent notifications";
 }
 
-void NotificationManager::savePersistentNotifications()
+bool NotificationManager::loadSnapshot()
 {
-    QJsonArray notifications;
+    if (!QFile::exists(m_snapshotFile)) {
+        return false;
+    }
     
-    QMutexLocker locker(&m_notificationMutex);
-    for (const auto &notification : m_activeNotifications) {
-        if (notification.persistent) {
-            QJsonObject obj;
-            obj["id"] = notification.id;
-            obj["title"] = notification.title;
-            obj["message"] = notification.message;
-            obj["type"] = static_cast<int>(notification.type);
-            obj["priority"] = static_cast<int>(notification.priority);
-            obj["timestamp"] = notification.timestamp.toString(Qt::ISODate);
-            obj["acknowledged"] = notification.acknowledged;
-            obj["persistent"] = notification.persistent;
-            obj["sourceEventId"] = notification.sourceEventId;
-            obj["metadata"] = notification.metadata;
-            
-            notifications.append(obj);
+    QElapsedTimer timer;
+    timer.start();
+    
+    NotificationSnapshot snapshot;
+    QString error;
+    if (!snapshot.load(m_snapshotFile, &error)) {
+        qWarning() << "Ignoring notification snapshot:" << error;
+        return false;
+    }
+    
+    {
+        QMutexLocker locker(&m_rulesMutex);
+        m_alertRules = snapshot.rules;
+        invalidateCompiledRules();
+        restartRuleCooldownsLocked();
+    }
+    
+    {
+        QMutexLocker locker(&m_notificationMutex);
+        const QDateTime now = QDateTime::currentDateTime();
+        for (const NotificationData &notification : snapshot.activeNotifications) {
+            if (!notification.expiryTime.isValid() || notification.expiryTime > now) {
+                m_activeNotifications.insert(notification);
+                scheduleNotificationExpiry(notification);
+            }
         }
+        m_notificationsToday = snapshot.notificationsToday;
+        m_notificationsThisHour = snapshot.notificationsThisHour;
+        m_lastHourReset = QDateTime::fromMSecsSinceEpoch(snapshot.lastHourResetMs);
+        m_lastDayReset = QDateTime::fromMSecsSinceEpoch(snapshot.lastDayResetMs);
     }
     
-    QJsonObject root;
-    root["notifications"] = notifications;
-    root["saveTime"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    QDataStream seenStream(snapshot.seenEvents);
+    seenStream.setVersion(QDataStream::Qt_6_0);
+    if (!m_seenEvents.readFrom(seenStream)) {
+        qWarning() << "Snapshot has no readable seen-event set";
+    }
     
-    QJsonDocument doc(root);
+    QDataStream subscriberStream(snapshot.subscriberState);
+    subscriberStream.setVersion(QDataStream::Qt_6_0);
+    if (!m_subscribers.readStateFrom(subscriberStream)) {
+        qWarning() << "Snapshot has no readable subscriber state";
+    }
     
-    QFile dataFile(m_persistentDataFile);
-    if (dataFile.open(QIODevice::WriteOnly)) {
-        dataFile.write(doc.toJson());
-        qDebug() << "Saved" << notifications.size() << "persistent notifications";
-    } else {
-        qWarning() << "Failed to save persistent notifications to:" << m_persistentDataFile;
+    QDataStream detectorStream(snapshot.rateDetectorState);
+    detectorStream.setVersion(QDataStream::Qt_6_0);
+    if (!snapshot.rateDetectorState.isEmpty() && !m_rateDetector.readFrom(detectorStream)) {
+        qWarning() << "Snapshot has no readable seismicity rate state";
     }
+    
+    qDebug() << "Restored" << snapshot.rules.size() << "rules and" << m_activeNotifications.size()
+             << "active notifications from snapshot in" << timer.elapsed() << "ms";
+    return true;
+}
+
+bool NotificationManager::saveSnapshot()
+{
+    QElapsedTimer timer;
+    timer.start();
+    
+    NotificationSnapshot snapshot;
+    snapshot.savedAtMs = QDateTime::currentMSecsSinceEpoch();
+    {
+        QMutexLocker locker(&m_rulesMutex);
+        snapshot.rules = m_alertRules;
+    }
+    {
+        QMutexLocker locker(&m_notificationMutex);
+        snapshot.activeNotifications = m_activeNotifications.toVector();
+        snapshot.notificationsToday = m_notificationsToday;
+        snapshot.notificationsThisHour = m_notificationsThisHour;
+        snapshot.lastHourResetMs = m_lastHourReset.toMSecsSinceEpoch();
+        snapshot.lastDayResetMs = m_lastDayReset.toMSecsSinceEpoch();
+    }
+    {
+        QDataStream stream(&snapshot.seenEvents, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_6_0);
+        m_seenEvents.writeTo(stream);
+    }
+    {
+        QDataStream stream(&snapshot.subscriberState, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_6_0);
+        m_subscribers.writeStateTo(stream);
+    }
+    {
+        QDataStream stream(&snapshot.rateDetectorState, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_6_0);
+        m_rateDetector.writeTo(stream);
+    }
+    
+    QString error;
+    if (!snapshot.save(m_snapshotFile, &error)) {
+        qWarning() << "Failed to save notification snapshot:" << error;
+        return false;
+    }
+    
+    // Superseded by the snapshot
+    QFile::remove(m_persistentDataFile);
+    
+    qDebug() << "Saved notification snapshot with" << snapshot.activeNotifications.size()
+             << "active notifications in" << timer.elapsed() << "ms";
+    return true;
+}
+
+QVector<QJsonObject> NotificationManager::queryNotificationLog(const QDateTime &from, const QDateTime &to, int limit) const
+{
+    return m_logWriter->query(from, to, {}, limit);
 }
 
 QString NotificationManager::getNotificationLogPath() const
@@ -1365,118 +2034,75 @@ QString NotificationManager::getNotificationLogPath() const
     return m_notificationLogFile;
 }
 
-void NotificationManager::sendEmail(const QString &to, const QString &subject, const QString &body)
+void NotificationManager::sendEmail(const NotificationData &notification, const QStringList &recipients,
+                                    const QString &subject, const QString &body)
 {
-    // This is a simplified email implementation
-    // In a real application, you would integrate with an email service like SMTP
-    
     QJsonObject emailData;
-    emailData["to"] = to;
     emailData["subject"] = subject;
     emailData["body"] = body;
     emailData["from"] = "earthquake-alerts@example.com";
     emailData["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
     
-    // Example: Send to email service API
-    QNetworkRequest request(QUrl("https://api.emailservice.com/send"));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    
-    QJsonDocument doc(emailData);
-    QNetworkReply *reply = m_networkManager->post(request, doc.toJson());
-    
-    connect(reply, &QNetworkReply::finished, this, &NotificationManager::onEmailSent);
-    
-    qDebug() << "Email queued for sending to:" << to;
+    enqueueOutbound(m_emailChannel, DeliveryChannel::EmailAlert, notification, recipients, emailData);
 }
 
-void NotificationManager::sendSms(const QString &number, const QString &message)
+void NotificationManager::sendSms(const NotificationData &notification, const QStringList &recipients,
+                                  const QString &message)
 {
-    // This is a simplified SMS implementation
-    // In a real application, you would integrate with an SMS service like Twilio
-    
     QJsonObject smsData;
-    smsData["to"] = number;
     smsData["message"] = message;
     smsData["from"] = "+1234567890"; // Your SMS service number
     smsData["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
     
-    // Example: Send to SMS service API
-    QNetworkRequest request(QUrl("https://api.smsservice.com/send"));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    
-    QJsonDocument doc(smsData);
-    QNetworkReply *reply = m_networkManager->post(request, doc.toJson());
-    
-    connect(reply, &QNetworkReply::finished, this, &NotificationManager::onSmsSent);
-    
-    qDebug() << "SMS queued for sending to:" << number;
+    enqueueOutbound(m_smsChannel, DeliveryChannel::SMSAlert, notification, recipients, smsData);
 }
 
-void NotificationManager::sendPushNotification(const QString &title, const QString &message, const QJsonObject &data)
+void NotificationManager::sendPushNotification(const NotificationData &notification, const QStringList &recipients)
 {
-    // This is a simplified push notification implementation
-    // In a real application, you would integrate with a push service like Firebase
-    
     QJsonObject pushData;
-    pushData["title"] = title;
-    pushData["message"] = message;
-    pushData["data"] = data;
+    pushData["title"] = notification.title;
+    pushData["message"] = notification.message;
+    pushData["data"] = notification.metadata;
     pushData["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
     
-    QNetworkRequest request(QUrl(m_settings.pushServiceUrl));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    
-    QJsonDocument doc(pushData);
-    QNetworkReply *reply = m_networkManager->post(request, doc.toJson());
-    
-    connect(reply, &QNetworkReply::finished, this, &NotificationManager::onPushNotificationSent);
-    
-    qDebug() << "Push notification queued for sending";
+    enqueueOutbound(m_pushChannel, DeliveryChannel::PushNotification, notification, recipients, pushData);
 }
 
-void NotificationManager::onEmailSent()
+void NotificationManager::enqueueOutbound(HttpDeliveryChannel *channel, DeliveryChannel type,
+                                          const NotificationData &notification,
+                                          const QStringList &recipients, const QJsonObject &payload)
 {
-    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
-    
-    if (reply->error() == QNetworkReply::NoError) {
-        qDebug() << "Email sent successfully";
-    } else {
-        qWarning() << "Failed to send email:" << reply->errorString();
-        emit deliveryFailed("", DeliveryChannel::EmailAlert, reply->errorString());
+    QVector<OutboundMessage> messages;
+    messages.reserve(recipients.size());
+    for (const QString &recipient : recipients) {
+        OutboundMessage message;
+        message.notificationId = notification.id;
+        message.recipient = recipient;
+        message.payload = payload;
+        message.attempts = notification.retryCount; // Attempts made before a restart count too
+        messages.append(message);
     }
     
-    reply->deleteLater();
-}
-
-void NotificationManager::onSmsSent()
-{
-    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
-    
-    if (reply->error() == QNetworkReply::NoError) {
-        qDebug() << "SMS sent successfully";
-    } else {
-        qWarning() << "Failed to send SMS:" << reply->errorString();
-        emit deliveryFailed("", DeliveryChannel::SMSAlert, reply->errorString());
+    const int accepted = channel->enqueue(messages);
+    if (accepted < messages.size()) {
+        qWarning() << "Outbound" << channel->name() << "queue full, dropped" << messages.size() - accepted << "messages";
+        emit deliveryFailed(notification.id, type, QString("Outbound %1 queue full").arg(channel->name()));
     }
     
-    reply->deleteLater();
+    qDebug() << "Queued" << accepted << channel->name() << "messages for" << notification.id;
 }
 
-void NotificationManager::onPushNotificationSent()
+QStringList NotificationManager::splitRecipients(const QString &list)
 {
-    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
-    
-    if (reply->error() == QNetworkReply::NoError) {
-        qDebug() << "Push notification sent successfully";
-    } else {
-        qWarning() << "Failed to send push notification:" << reply->errorString();
-        emit deliveryFailed("", DeliveryChannel::PushNotification, reply->errorString());
+    static const QRegularExpression separators("[,;]");
+    QStringList recipients;
+    for (const QString &part : list.split(separators, Qt::SkipEmptyParts)) {
+        const QString recipient = part.trimmed();
+        if (!recipient.isEmpty()) {
+            recipients.append(recipient);
+        }
     }
-    
-    reply->deleteLater();
+    return recipients;
 }
 
 QSystemTrayIcon::MessageIcon NotificationManager::getSystemTrayIcon(NotificationType type) const
@@ -1488,6 +2114,7 @@ QSystemTrayIcon::MessageIcon NotificationManager::getSystemTrayIcon(Notification
             return QSystemTrayIcon::Information;
         case NotificationType::Warning:
         case NotificationType::NetworkStatus:
+        case NotificationType::SeismicityAnomaly:
             return QSystemTrayIcon::Warning;
         case NotificationType::Critical:
         case NotificationType::Emergency:
@@ -1514,6 +2141,8 @@ QString NotificationManager::getNotificationTitle(NotificationType type) const
             return "Network Status";
         case NotificationType::DataUpdate:
             return "Data Update";
+        case NotificationType::SeismicityAnomaly:
+            return "Unusual Activity";
         default:
             return "Notification";
     }
@@ -1531,6 +2160,14 @@ void NotificationManager::updateSystemTrayTooltip()
         tooltip += QString("\n%1 unacknowledged alerts").arg(unacknowledged);
     }
     
+    if (!m_shakingCountdowns.isEmpty()) {
+        const ShakingCountdown &next = m_shakingCountdowns.first();
+        tooltip += QString("\nShaking in %1 s (M%2, %3 km away)")
+                   .arg(qMax(0.0, next.secondsToShaking), 0, 'f', 0)
+                   .arg(next.magnitude, 0, 'f', 1)
+                   .arg(next.distanceKm, 0, 'f', 0);
+    }
+    
     if (!m_settings.enabled) {
         tooltip += "\n(Notifications disabled)";
     } else if (isInQuietHours()) {
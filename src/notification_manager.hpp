@@ -1,13 +1,31 @@
 
 #pragma once
 
+#include "active_notification_set.hpp"
+#include "alert_rule_index.hpp"
+#include "alert_rules.hpp"
+#include "async_log_writer.hpp"
 #include "earthquake_data.hpp"
+#include "http_delivery_channel.hpp"
+#include "metrics_registry.hpp"
+#include "notification_coalescer.hpp"
+#include "notification_delivery_worker.hpp"
+#include "notification_queue.hpp"
+#include "notification_snapshot.hpp"
+#include "notification_types.hpp"
+#include "region_registry.hpp"
+#include "ring_buffer.hpp"
+#include "seen_event_set.hpp"
+#include "seismicity_rate_detector.hpp"
+#include "sound_bank.hpp"
+#include "subscriber_registry.hpp"
+#include "timing_wheel.hpp"
 
 #include <QObject>
 #include <QTimer>
+#include <QThread>
 #include <QDateTime>
 #include <QSettings>
-#include <QQueue>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QJsonObject>
@@ -30,110 +48,6 @@
 // Forward declaration
 struct EarthquakeData;
 
-enum class NotificationType {
-    Info,
-    Warning,
-    Critical,
-    Emergency,
-    SystemUpdate,
-    NetworkStatus,
-    DataUpdate
-};
-
-enum class NotificationPriority {
-    Low = 1,
-    Normal = 2,
-    High = 3,
-    Critical = 4,
-    Emergency = 5
-};
-
-enum class DeliveryChannel {
-    SystemTray,
-    DesktopNotification,
-    SoundAlert,
-    EmailAlert,
-    SMSAlert,
-    PushNotification,
-    LogFile,
-    Console
-};
-
-enum class SoundType {
-    None,
-    Beep,
-    Chime,
-    Alert,
-    Warning,
-    Emergency,
-    Custom
-};
-
-struct NotificationSettings {
-    bool enabled = true;
-    bool soundEnabled = true;
-    bool systemTrayEnabled = false;
-    bool desktopNotificationsEnabled = true;
-    bool emailEnabled = false;
-    bool smsEnabled = false;
-    bool pushEnabled = false;
-    
-    double magnitudeThreshold = 5.0;
-    int depthThreshold = 100; // km
-    int proximityRadius = 500; // km from user location
-    int quietHoursStart = 22; // 10 PM
-    int quietHoursEnd = 7; // 7 AM
-    bool respectQuietHours = true;
-    
-    QString emailAddress;
-    QString smsNumber;
-    QString pushServiceUrl;
-    QString customSoundPath;
-    
-    SoundType defaultSoundType = SoundType::Alert;
-    int notificationTimeout = 10000; // ms
-    int maxNotificationsPerHour = 20;
-    bool groupSimilarEvents = true;
-    bool showPreview = true;
-};
-
-struct NotificationData {
-    QString id;
-    QString title;
-    QString message;
-    QString details;
-    NotificationType type;
-    NotificationPriority priority;
-    QDateTime timestamp;
-    QVector<DeliveryChannel> channels;
-    QJsonObject metadata;
-    bool acknowledged = false;
-    bool persistent = false;
-    int retryCount = 0;
-    QDateTime expiryTime;
-    QString sourceEventId;
-};
-
-struct AlertRule {
-    QString name;
-    bool enabled = true;
-    double minMagnitude = 0.0;
-    double maxMagnitude = 10.0;
-    double minDepth = 0.0;
-    double maxDepth = 1000.0;
-    double centerLatitude = 0.0;
-    double centerLongitude = 0.0;
-    double radiusKm = 1000.0;
-    bool useLocation = false;
-    QStringList regions;
-    NotificationPriority priority = NotificationPriority::Normal;
-    QVector<DeliveryChannel> channels;
-    QString customMessage;
-    SoundType soundType = SoundType::Alert;
-    int cooldownMinutes = 5;
-    QDateTime lastTriggered;
-};
-
 class NotificationManager : public QObject
 {
     Q_OBJECT
@@ -154,13 +68,36 @@ public:
     QVector<AlertRule> getAlertRules() const;
     void setAlertRules(const QVector<AlertRule> &rules);
     
+    // Regions that alert rules refer to by name
+    bool loadRegionFile(const QString &path);
+    QStringList getRegionNames() const;
+    
+    // Subscribers of the regional alerting service; every incoming event is
+    // matched against all of them and fanned out over email/SMS/push
+    bool loadSubscriberFile(const QString &path);
+    void addSubscriber(const Subscriber &subscriber);
+    bool removeSubscriber(const QString &id);
+    int getSubscriberCount() const;
+    
     // User location for proximity alerts
     void setUserLocation(double latitude, double longitude);
     QPair<double, double> getUserLocation() const;
     
+    // S-wave arrival countdowns at the user location, soonest first
+    QVector<ShakingCountdown> getShakingCountdowns() const;
+    
     // Notification methods
-    void showNotification(const NotificationData &notification);
+    bool showNotification(const NotificationData &notification); // Returns whether it was queued
+    // Records every fetched batch in the seen-event set shared by all alert
+    // paths and feeds its new events to the rate detector; returns its new
+    // and revised events. Only live batches raise rule alerts for them.
+    // Events alert once, and again only when revised, across restarts too
+    QVector<EarthquakeData> ingestEarthquakes(const QVector<EarthquakeData> &earthquakes, bool live);
     void showEarthquakeAlert(const EarthquakeData &earthquake);
+    void showEarthquakeAlerts(const QVector<EarthquakeData> &earthquakes);
+    
+    // Batch rule evaluation: every event against every enabled rule in one pass
+    QVector<AlertMatch> evaluateBatch(const QVector<EarthquakeData> &earthquakes);
     void showSystemNotification(const QString &title, const QString &message, 
                               NotificationType type = NotificationType::Info);
     void showNetworkStatusNotification(bool connected);
@@ -169,7 +106,6 @@ public:
     // Management methods
     void acknowledgeNotification(const QString &id);
     void acknowledgeAllNotifications();
-    void clearExpiredNotifications();
     void clearAllNotifications();
     
     // Control methods
@@ -187,30 +123,44 @@ public:
     int getTodayNotificationsCount() const;
     QVector<NotificationData> getRecentNotifications(int hours = 24) const;
     QVector<NotificationData> getUnacknowledgedNotifications() const;
+    
+    // Queue depth, queue wait and delivery latency metrics
+    const MetricsRegistry &metrics() const;
+    QString exportMetricsPrometheus() const;
+    
+    // Delivered notifications logged between from and to, oldest first. Includes
+    // records the log writer has not written yet; never waits for it
+    QVector<QJsonObject> queryNotificationLog(const QDateTime &from, const QDateTime &to, int limit = -1) const;
 
 signals:
     void notificationShown(const QString &id, NotificationType type);
     void notificationAcknowledged(const QString &id);
     void alertRuleTriggered(const QString &ruleName, const EarthquakeData &earthquake);
+    void alertBatchEvaluated(const QVector<AlertMatch> &matches, int eventCount);
+    void alertRulesChanged(const QVector<AlertRule> &rules); // Added, edited or removed, or moved with the user
     void settingsChanged(const NotificationSettings &settings);
     void deliveryFailed(const QString &id, DeliveryChannel channel, const QString &error);
     void statisticsUpdated(int totalToday, int pending, int acknowledged);
+    void shakingCountdownUpdated(const QVector<ShakingCountdown> &countdowns);
+    void shakingArrived(const QString &eventId);
 
 private slots:
     void onSystemTrayActivated(QSystemTrayIcon::ActivationReason reason);
-    void processNotificationQueue();
-    void cleanupExpiredNotifications();
+    void onNotificationBatch(const QVector<NotificationData> &batch);
+    void onTimingWheelTimeout();
     void updateStatistics();
-    void onEmailSent();
-    void onSmsSent();
-    void onPushNotificationSent();
     void checkQuietHours();
+    void updateShakingCountdowns();
 
 private:
     // Initialization methods
     void initializeSystemTray();
     void initializeAudioSystem();
-    void initializeNetworkManager();
+    void initializeDeliveryChannels();
+    void initializeDeliveryWorker();
+    void initializeLogWriter();
+    void initializeRegions();
+    void initializeSubscribers();
     void createNotificationDirectory();
     void loadDefaultAlertRules();
     
@@ -219,6 +169,7 @@ private:
     bool shouldShowNotification(const NotificationData &notification) const;
     QString generateNotificationId() const;
     void enqueueNotification(const NotificationData &notification);
+    bool deliverCoalesced(const QVector<NotificationData> &notifications); // Whether an alert itself was shown
     
     // Delivery methods
     void deliverToSystemTray(const NotificationData &notification);
@@ -238,10 +189,20 @@ private:
     float calculateSoundVolume(NotificationPriority priority) const;
     
     // Alert rule processing
-    QVector<AlertRule> getTriggeredRules(const EarthquakeData &earthquake) const;
-    bool evaluateAlertRule(const AlertRule &rule, const EarthquakeData &earthquake) const;
-    bool isRuleInCooldown(const AlertRule &rule) const;
+    QVector<AlertRule> getTriggeredRules(const EarthquakeData &earthquake);
+    bool isRuleInCooldown(const AlertRule &rule) const; // Caller holds m_rulesMutex
     void updateRuleCooldown(const QString &ruleName);
+    void startRuleCooldownLocked(const AlertRule &rule);
+    void cancelRuleCooldownLocked(const QString &ruleName);
+    void restartRuleCooldownsLocked();
+    QVector<AlertMatch> evaluateRulesLocked(const QVector<EarthquakeData> &earthquakes);
+    void invalidateCompiledRules();
+    void emitAlertRulesChanged(QMutexLocker<QMutex> &locker); // Unlocks m_rulesMutex first
+    int alertOnEvents(const QVector<EarthquakeData> &earthquakes); // Returns the number of alerts raised
+    void raiseEarthquakeAlert(const EarthquakeData &earthquake, const AlertRule &rule);
+    void fanOutToSubscribers(const QVector<EarthquakeData> &earthquakes);
+    void raiseSeismicityAnomaly(const SeismicityRateDetector::Anomaly &anomaly);
+    void startShakingCountdown(const ShakingCountdown &countdown);
     
     // Utility methods
     QString formatEarthquakeMessage(const EarthquakeData &earthquake) const;
@@ -249,23 +210,46 @@ private:
     NotificationPriority calculatePriority(const EarthquakeData &earthquake) const;
     QVector<DeliveryChannel> getChannelsForPriority(NotificationPriority priority) const;
     double calculateDistanceToUser(double lat, double lon) const;
-    bool isInRegion(const EarthquakeData &earthquake, const QStringList &regions) const;
+    bool isInRegion(const EarthquakeData &earthquake, const QVector<int> &regionIds) const;
     
     // Rate limiting
     bool isRateLimited() const;
     void updateRateLimit();
+    void resetHourlyCounter();
     void resetDailyCounters();
     
+    // Time-based work, scheduled on m_timingWheel when it becomes due
+    enum class TimedTask {
+        RuleCooldown,       // key: rule name
+        NotificationExpiry, // key: notification id
+        HourlyReset,
+        DailyReset,
+        QuietHoursBoundary,
+        StatisticsUpdate,
+        SnapshotSave,
+        ClusterDigest       // key: coalescer digest id
+    };
+    TimingWheel::TimerId scheduleTask(qint64 dueMs, TimedTask task, const QString &key = QString());
+    void scheduleNotificationExpiry(const NotificationData &notification);
+    void scheduleDigest(const QString &digestId);
+    void scheduleQuietHoursBoundary();
+    void armTimingWheel();
+    
     // Persistence methods
     void saveNotificationToFile(const NotificationData &notification);
-    void loadPersistentNotifications();
-    void savePersistentNotifications();
+    void loadPersistentNotifications(); // Pre-snapshot JSON file, read once when there is no snapshot
+    bool loadSnapshot();
+    bool saveSnapshot();
     QString getNotificationLogPath() const;
     
     // Email/SMS/Push helpers
-    void sendEmail(const QString &to, const QString &subject, const QString &body);
-    void sendSms(const QString &number, const QString &message);
-    void sendPushNotification(const QString &title, const QString &message, const QJsonObject &data);
+    void sendEmail(const NotificationData &notification, const QStringList &recipients,
+                   const QString &subject, const QString &body);
+    void sendSms(const NotificationData &notification, const QStringList &recipients, const QString &message);
+    void sendPushNotification(const NotificationData &notification, const QStringList &recipients);
+    void enqueueOutbound(HttpDeliveryChannel *channel, DeliveryChannel type, const NotificationData &notification,
+                         const QStringList &recipients, const QJsonObject &payload);
+    static QStringList splitRecipients(const QString &list);
     
     // UI helpers
     QSystemTrayIcon::MessageIcon getSystemTrayIcon(NotificationType type) const;
@@ -280,37 +264,61 @@ private:
     
     // Alert rules
     QVector<AlertRule> m_alertRules;
+    CompiledAlertRules m_compiledRules;
+    AlertRuleIndex m_ruleIndex;
+    RegionRegistry m_regionRegistry;
+    SubscriberRegistry m_subscribers;
+    SeenEventSet m_seenEvents; // Every event ingested so far; saved in the snapshot
+    SeismicityRateDetector m_rateDetector;
+    bool m_compiledRulesValid;
     mutable QMutex m_rulesMutex;
 
     // User location
     double m_userLatitude;
     double m_userLongitude;
     bool m_hasUserLocation;
+    QVector<ShakingCountdown> m_shakingCountdowns; // Sorted by S arrival
     
     // Notification management
-    QQueue<NotificationData> m_notificationQueue;
-    QVector<NotificationData> m_activeNotifications;
-    QVector<NotificationData> m_notificationHistory;
+    NotificationQueue m_notificationQueue;
+    ActiveNotificationSet m_activeNotifications;
+    RingBuffer<NotificationData> m_notificationHistory; // Oldest entries are overwritten
+    NotificationCoalescer m_coalescer; // Swarm digests when groupSimilarEvents is set
     mutable QMutex m_notificationMutex;
     
     // System integration
     QSystemTrayIcon *m_systemTray;
     QMenu *m_trayMenu;
     
-    // Audio system
-    QSoundEffect *m_soundEffect;
+    // Audio system: preloaded alert voices
+    SoundBank *m_soundBank;
     QMediaPlayer *m_mediaPlayer;
     QAudioOutput *m_audioOutput;
     QMap<SoundType, QString> m_soundPaths;
     
-    // Network for external notifications
-    QNetworkAccessManager *m_networkManager;
+    // Batched, retried delivery for external notifications
+    HttpDeliveryChannel *m_emailChannel;
+    HttpDeliveryChannel *m_smsChannel;
+    HttpDeliveryChannel *m_pushChannel;
+    
+    // Delivery worker draining m_notificationQueue
+    QThread m_deliveryThread;
+    NotificationDeliveryWorker *m_deliveryWorker;
+    MetricsRegistry m_metrics;
+    
+    // Rotating JSON Lines notification log with its own writer thread
+    AsyncLogWriter *m_logWriter;
     
     // Timers
-    QTimer *m_queueTimer;
-    QTimer *m_cleanupTimer;
-    QTimer *m_statisticsTimer;
-    QTimer *m_quietHoursTimer;
+    QTimer *m_timingWheelTimer; // Single shot, armed for the wheel's next due entry
+    QTimer *m_countdownTimer;
+    
+    // Cooldown ends, expiries, counter resets, quiet-hour boundaries and digests
+    TimingWheel m_timingWheel;
+    QHash<QString, TimingWheel::TimerId> m_ruleCooldowns; // Rules in cooldown; guarded by m_rulesMutex
+    QHash<QString, TimingWheel::TimerId> m_digestTasks; // Next digest or expiry per coalescer cluster
+    TimingWheel::TimerId m_quietHoursBoundary;
+    bool m_inQuietHours;
     
     // Statistics and rate limiting
     int m_notificationsToday;
@@ -326,14 +334,20 @@ private:
     // File paths
     QString m_notificationLogFile;
     QString m_persistentDataFile;
+    QString m_snapshotFile;
     QString m_soundsDirectory;
     
     // Constants
     static const int MAX_QUEUE_SIZE;
-    static const int CLEANUP_INTERVAL_MS;
+    static const int SNAPSHOT_INTERVAL_MS;
     static const int STATISTICS_UPDATE_INTERVAL_MS;
+    static const int TIMING_WHEEL_RESOLUTION_MS;
     static const int MAX_NOTIFICATION_HISTORY;
     static const int DEFAULT_NOTIFICATION_TIMEOUT_MS;
+    static const int INDEXED_RULE_THRESHOLD;
+    static const int COUNTDOWN_INTERVAL_MS;
+    static const QString EMAIL_SERVICE_URL;
+    static const QString SMS_SERVICE_URL;
 };
 
 Q_DECLARE_METATYPE(NotificationManager)
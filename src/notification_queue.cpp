@@ -0,0 +1,139 @@
+#include "notification_queue.hpp"
+
+#include <chrono>
+#include <utility>
+
+
+NotificationQueue::NotificationQueue(int capacityPerLane)
+    : m_mask(1)
+{
+    // Power-of-two capacity so positions map to cells with a mask
+    quint64 capacity = 2;
+    while (capacity < static_cast<quint64>(qMax(2, capacityPerLane))) capacity <<= 1;
+    m_mask = capacity - 1;
+
+    for (Lane &lane : m_lanes) {
+        lane.cells.reset(new Cell[capacity]);
+        for (quint64 i = 0; i < capacity; ++i) {
+            lane.cells[i].sequence.store(i, std::memory_order_relaxed);
+            lane.cells[i].enqueuedAtUs = 0;
+        }
+        lane.enqueuePos.store(0, std::memory_order_relaxed);
+        lane.dequeuePos.store(0, std::memory_order_relaxed);
+        lane.pushed.store(0, std::memory_order_relaxed);
+        lane.rejected.store(0, std::memory_order_relaxed);
+    }
+}
+
+NotificationQueue::~NotificationQueue() = default;
+
+qint64 NotificationQueue::nowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int NotificationQueue::laneFor(NotificationPriority priority)
+{
+    switch (priority) {
+        case NotificationPriority::Low: return 0;
+        case NotificationPriority::Normal: return 1;
+        case NotificationPriority::High: return 2;
+        case NotificationPriority::Critical:
+        case NotificationPriority::Emergency: return 3;
+    }
+    return 1;
+}
+
+NotificationPriority NotificationQueue::priorityOf(int lane)
+{
+    static const NotificationPriority priorities[LANE_COUNT] = {
+        NotificationPriority::Low, NotificationPriority::Normal,
+        NotificationPriority::High, NotificationPriority::Critical
+    };
+    return priorities[qBound(0, lane, LANE_COUNT - 1)];
+}
+
+bool NotificationQueue::bypassesQueue(NotificationPriority priority)
+{
+    return priority == NotificationPriority::Emergency;
+}
+
+bool NotificationQueue::tryPush(const NotificationData &notification, qint64 enqueuedAtUs)
+{
+    Lane &lane = m_lanes[laneFor(notification.priority)];
+
+    quint64 pos = lane.enqueuePos.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+        cell = &lane.cells[pos & m_mask];
+        const quint64 sequence = cell->sequence.load(std::memory_order_acquire);
+        const qint64 diff = static_cast<qint64>(sequence - pos);
+        if (diff == 0) {
+            // Slot is free for this position; claim it
+            if (lane.enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // The consumer has not freed this slot yet: lane is full
+            lane.rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = lane.enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->notification = notification;
+    cell->enqueuedAtUs = enqueuedAtUs;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    lane.pushed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool NotificationQueue::popLane(Lane &lane, NotificationData &notification, qint64 &enqueuedAtUs)
+{
+    const quint64 pos = lane.dequeuePos.load(std::memory_order_relaxed);
+    Cell &cell = lane.cells[pos & m_mask];
+    const quint64 sequence = cell.sequence.load(std::memory_order_acquire);
+    if (static_cast<qint64>(sequence - (pos + 1)) < 0) {
+        return false; // Empty, or the producer has not published yet
+    }
+
+    notification = std::move(cell.notification);
+    cell.notification = NotificationData();
+    enqueuedAtUs = cell.enqueuedAtUs;
+    lane.dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+}
+
+bool NotificationQueue::tryPop(NotificationData &notification, qint64 &enqueuedAtUs)
+{
+    for (int lane = LANE_COUNT - 1; lane >= 0; --lane) {
+        if (popLane(m_lanes[lane], notification, enqueuedAtUs)) return true;
+    }
+    return false;
+}
+
+int NotificationQueue::clear()
+{
+    int discarded = 0;
+    NotificationData notification;
+    qint64 enqueuedAtUs;
+    for (Lane &lane : m_lanes) {
+        while (popLane(lane, notification, enqueuedAtUs)) ++discarded;
+    }
+    return discarded;
+}
+
+int NotificationQueue::size(int lane) const
+{
+    const quint64 head = m_lanes[lane].dequeuePos.load(std::memory_order_relaxed);
+    const quint64 tail = m_lanes[lane].enqueuePos.load(std::memory_order_relaxed);
+    return tail > head ? static_cast<int>(tail - head) : 0;
+}
+
+int NotificationQueue::size() const
+{
+    int total = 0;
+    for (int lane = 0; lane < LANE_COUNT; ++lane) total += size(lane);
+    return total;
+}
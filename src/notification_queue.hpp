@@ -0,0 +1,72 @@
+#pragma once
+
+#include "notification_types.hpp"
+
+#include <QtCore/QtGlobal>
+#include <array>
+#include <atomic>
+#include <memory>
+
+
+// Bounded multi-producer / single-consumer notification queue with one lane
+// per priority below Emergency (emergency notifications bypass the queue).
+// Each lane is a ring of sequence-numbered cells: producers claim a slot with
+// one CAS and publish it with a release store, so enqueueing never takes a
+// lock and never blocks. A full lane rejects the new notification instead of
+// evicting queued ones. Only the delivery worker may pop or clear.
+class NotificationQueue
+{
+public:
+    static const int LANE_COUNT = 4; // Low, Normal, High, Critical
+
+    explicit NotificationQueue(int capacityPerLane);
+    ~NotificationQueue();
+
+    NotificationQueue(const NotificationQueue &) = delete;
+    NotificationQueue &operator=(const NotificationQueue &) = delete;
+
+    // Producer side (any thread). Returns false if the lane is full.
+    bool tryPush(const NotificationData &notification, qint64 enqueuedAtUs);
+
+    // Consumer side (delivery worker only). Pops the oldest notification of
+    // the highest non-empty priority.
+    bool tryPop(NotificationData &notification, qint64 &enqueuedAtUs);
+    int clear();
+
+    // Approximate while producers are active
+    int size() const;
+    int size(int lane) const;
+    int capacityPerLane() const { return static_cast<int>(m_mask + 1); }
+
+    // Totals since construction, per lane
+    quint64 pushedCount(int lane) const { return m_lanes[lane].pushed.load(std::memory_order_relaxed); }
+    quint64 rejectedCount(int lane) const { return m_lanes[lane].rejected.load(std::memory_order_relaxed); }
+
+    // Monotonic timestamp for enqueuedAtUs
+    static qint64 nowUs();
+
+    static int laneFor(NotificationPriority priority);
+    static NotificationPriority priorityOf(int lane);
+    // Emergency notifications are delivered by the caller at once, never queued
+    static bool bypassesQueue(NotificationPriority priority);
+
+private:
+    struct Cell {
+        std::atomic<quint64> sequence;
+        NotificationData notification;
+        qint64 enqueuedAtUs;
+    };
+
+    struct Lane {
+        std::unique_ptr<Cell[]> cells;
+        alignas(64) std::atomic<quint64> enqueuePos;
+        alignas(64) std::atomic<quint64> dequeuePos;
+        std::atomic<quint64> pushed;
+        std::atomic<quint64> rejected;
+    };
+
+    bool popLane(Lane &lane, NotificationData &notification, qint64 &enqueuedAtUs);
+
+    quint64 m_mask;
+    std::array<Lane, LANE_COUNT> m_lanes;
+};
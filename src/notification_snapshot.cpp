@@ -0,0 +1,286 @@
+#include "notification_snapshot.hpp"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QCborValue>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QJsonValue>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtEndian>
+#include <limits>
+
+// Constants
+const quint32 NotificationSnapshot::MAGIC = 0x45514e53; // "EQNS"
+const quint16 NotificationSnapshot::VERSION = 1;
+
+
+namespace {
+
+const qsizetype HEADER_SIZE = 12;
+const qint64 INVALID_TIME = std::numeric_limits<qint64>::min();
+
+void setError(QString *errorMessage, const QString &message)
+{
+    if (errorMessage) *errorMessage = message;
+}
+
+void writeString(QDataStream &out, const QString &value)
+{
+    out << value.toUtf8();
+}
+
+QString readString(QDataStream &in)
+{
+    QByteArray utf8;
+    in >> utf8;
+    return QString::fromUtf8(utf8);
+}
+
+void writeTime(QDataStream &out, const QDateTime &value)
+{
+    out << (value.isValid() ? value.toMSecsSinceEpoch() : INVALID_TIME);
+}
+
+QDateTime readTime(QDataStream &in)
+{
+    qint64 ms = INVALID_TIME;
+    in >> ms;
+    return ms == INVALID_TIME ? QDateTime() : QDateTime::fromMSecsSinceEpoch(ms);
+}
+
+void writeChannels(QDataStream &out, const QVector<DeliveryChannel> &channels)
+{
+    out << quint8(channels.size());
+    for (DeliveryChannel channel : channels) {
+        out << quint8(channel);
+    }
+}
+
+QVector<DeliveryChannel> readChannels(QDataStream &in)
+{
+    quint8 count = 0;
+    in >> count;
+    QVector<DeliveryChannel> channels;
+    channels.reserve(count);
+    for (quint8 i = 0; i < count; ++i) {
+        quint8 channel = 0;
+        in >> channel;
+        channels.append(static_cast<DeliveryChannel>(channel));
+    }
+    return channels;
+}
+
+void writeRule(QDataStream &out, const AlertRule &rule)
+{
+    writeString(out, rule.name);
+    out << quint8(rule.enabled) << rule.minMagnitude << rule.maxMagnitude << rule.minDepth << rule.maxDepth
+        << rule.centerLatitude << rule.centerLongitude << rule.radiusKm << quint8(rule.useLocation);
+    out << quint16(rule.regions.size());
+    for (const QString &region : rule.regions) {
+        writeString(out, region);
+    }
+    writeString(out, rule.expression);
+    out << quint8(rule.priority);
+    writeChannels(out, rule.channels);
+    writeString(out, rule.customMessage);
+    out << quint8(rule.soundType) << qint32(rule.cooldownMinutes);
+    writeTime(out, rule.lastTriggered);
+}
+
+AlertRule readRule(QDataStream &in)
+{
+    AlertRule rule;
+    quint8 enabled = 0;
+    quint8 useLocation = 0;
+    quint16 regionCount = 0;
+    rule.name = readString(in);
+    in >> enabled >> rule.minMagnitude >> rule.maxMagnitude >> rule.minDepth >> rule.maxDepth
+       >> rule.centerLatitude >> rule.centerLongitude >> rule.radiusKm >> useLocation >> regionCount;
+    rule.enabled = enabled != 0;
+    rule.useLocation = useLocation != 0;
+    for (quint16 i = 0; i < regionCount && in.status() == QDataStream::Ok; ++i) {
+        rule.regions.append(readString(in));
+    }
+    rule.expression = readString(in);
+
+    quint8 priority = 0;
+    quint8 soundType = 0;
+    qint32 cooldownMinutes = 0;
+    in >> priority;
+    rule.priority = static_cast<NotificationPriority>(priority);
+    rule.channels = readChannels(in);
+    rule.customMessage = readString(in);
+    in >> soundType >> cooldownMinutes;
+    rule.soundType = static_cast<SoundType>(soundType);
+    rule.cooldownMinutes = cooldownMinutes;
+    rule.lastTriggered = readTime(in);
+    return rule;
+}
+
+void writeNotification(QDataStream &out, const NotificationData &notification)
+{
+    writeString(out, notification.id);
+    writeString(out, notification.title);
+    writeString(out, notification.message);
+    writeString(out, notification.details);
+    out << quint8(notification.type) << quint8(notification.priority);
+    writeTime(out, notification.timestamp);
+    writeChannels(out, notification.channels);
+    out << QCborValue::fromJsonValue(notification.metadata).toCbor();
+    out << quint8(notification.acknowledged) << quint8(notification.persistent) << qint32(notification.retryCount);
+    writeTime(out, notification.expiryTime);
+    writeString(out, notification.sourceEventId);
+}
+
+NotificationData readNotification(QDataStream &in)
+{
+    NotificationData notification;
+    notification.id = readString(in);
+    notification.title = readString(in);
+    notification.message = readString(in);
+    notification.details = readString(in);
+
+    quint8 type = 0;
+    quint8 priority = 0;
+    in >> type >> priority;
+    notification.type = static_cast<NotificationType>(type);
+    notification.priority = static_cast<NotificationPriority>(priority);
+    notification.timestamp = readTime(in);
+    notification.channels = readChannels(in);
+
+    QByteArray metadata;
+    quint8 acknowledged = 0;
+    quint8 persistent = 0;
+    qint32 retryCount = 0;
+    in >> metadata >> acknowledged >> persistent >> retryCount;
+    notification.metadata = QCborValue::fromCbor(metadata).toJsonValue().toObject();
+    notification.acknowledged = acknowledged != 0;
+    notification.persistent = persistent != 0;
+    notification.retryCount = retryCount;
+    notification.expiryTime = readTime(in);
+    notification.sourceEventId = readString(in);
+    return notification;
+}
+
+} // namespace
+
+
+QByteArray NotificationSnapshot::serialize() const
+{
+    QByteArray payload;
+    {
+        QDataStream out(&payload, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << savedAtMs << notificationsToday << notificationsThisHour << lastHourResetMs << lastDayResetMs;
+
+        out << quint32(rules.size());
+        for (const AlertRule &rule : rules) {
+            writeRule(out, rule);
+        }
+        out << quint32(activeNotifications.size());
+        for (const NotificationData &notification : activeNotifications) {
+            writeNotification(out, notification);
+        }
+        out << seenEvents << subscriberState << rateDetectorState;
+    }
+
+    QByteArray file(HEADER_SIZE, Qt::Uninitialized);
+    uchar *header = reinterpret_cast<uchar *>(file.data());
+    qToLittleEndian<quint32>(MAGIC, header);
+    qToLittleEndian<quint16>(VERSION, header + 4);
+    qToLittleEndian<quint16>(qChecksum(payload), header + 6);
+    qToLittleEndian<quint32>(quint32(payload.size()), header + 8);
+    return file + payload;
+}
+
+bool NotificationSnapshot::deserialize(const char *data, qsizetype size, QString *errorMessage)
+{
+    if (size < HEADER_SIZE) {
+        setError(errorMessage, "Snapshot is truncated");
+        return false;
+    }
+    const uchar *header = reinterpret_cast<const uchar *>(data);
+    if (qFromLittleEndian<quint32>(header) != MAGIC) {
+        setError(errorMessage, "Not a notification snapshot");
+        return false;
+    }
+    if (qFromLittleEndian<quint16>(header + 4) != VERSION) {
+        setError(errorMessage, QString("Unsupported snapshot version %1").arg(qFromLittleEndian<quint16>(header + 4)));
+        return false;
+    }
+    const qsizetype payloadSize = qFromLittleEndian<quint32>(header + 8);
+    if (payloadSize != size - HEADER_SIZE) {
+        setError(errorMessage, "Snapshot is truncated");
+        return false;
+    }
+    const QByteArrayView payloadView(data + HEADER_SIZE, payloadSize);
+    if (qChecksum(payloadView) != qFromLittleEndian<quint16>(header + 6)) {
+        setError(errorMessage, "Snapshot checksum mismatch");
+        return false;
+    }
+
+    // Parsed straight from the caller's buffer (usually the mapped file)
+    QByteArray payload = QByteArray::fromRawData(payloadView.data(), payloadView.size());
+    QBuffer buffer(&payload);
+    buffer.open(QIODevice::ReadOnly);
+    QDataStream in(&buffer);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    NotificationSnapshot snapshot;
+    in >> snapshot.savedAtMs >> snapshot.notificationsToday >> snapshot.notificationsThisHour
+       >> snapshot.lastHourResetMs >> snapshot.lastDayResetMs;
+
+    quint32 count = 0;
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        snapshot.rules.append(readRule(in));
+    }
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        snapshot.activeNotifications.append(readNotification(in));
+    }
+    in >> snapshot.seenEvents >> snapshot.subscriberState >> snapshot.rateDetectorState;
+
+    if (in.status() != QDataStream::Ok) {
+        setError(errorMessage, "Snapshot payload is corrupt");
+        return false;
+    }
+
+    *this = std::move(snapshot);
+    return true;
+}
+
+bool NotificationSnapshot::save(const QString &path, QString *errorMessage) const
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        setError(errorMessage, "Cannot write snapshot " + path + ": " + file.errorString());
+        return false;
+    }
+    file.write(serialize());
+    if (!file.commit()) {
+        setError(errorMessage, "Cannot write snapshot " + path + ": " + file.errorString());
+        return false;
+    }
+    return true;
+}
+
+bool NotificationSnapshot::load(const QString &path, QString *errorMessage)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        setError(errorMessage, "Cannot open snapshot " + path + ": " + file.errorString());
+        return false;
+    }
+
+    const qint64 size = file.size();
+    if (uchar *mapped = file.map(0, size)) {
+        const bool ok = deserialize(reinterpret_cast<const char *>(mapped), size, errorMessage);
+        file.unmap(mapped);
+        return ok;
+    }
+
+    // Some file systems cannot be mapped
+    const QByteArray data = file.readAll();
+    return deserialize(data.constData(), data.size(), errorMessage);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "notification_types.hpp"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QVector>
+
+
+// Alert state of NotificationManager in one binary file, so a restart picks
+// up exactly where the previous run stopped: rules with their cooldowns,
+// active notifications, the shared seen-event set and the rate-limit counters.
+//
+// Layout: a 12-byte header (magic, version, CRC-16 of the payload, payload
+// size) followed by a QDataStream payload. Strings are stored as UTF-8
+// and notification metadata as CBOR. save() writes through QSaveFile, so
+// the file is replaced by rename and a crash leaves the old snapshot
+// intact. load() maps the file and parses it in place.
+struct NotificationSnapshot {
+    QVector<AlertRule> rules;
+    QVector<NotificationData> activeNotifications;
+    QByteArray seenEvents;      // SeenEventSet::writeTo
+    QByteArray subscriberState; // SubscriberRegistry::writeStateTo
+    QByteArray rateDetectorState; // SeismicityRateDetector::writeTo
+
+    qint32 notificationsToday = 0;
+    qint32 notificationsThisHour = 0;
+    qint64 lastHourResetMs = 0;
+    qint64 lastDayResetMs = 0;
+    qint64 savedAtMs = 0;
+
+    QByteArray serialize() const;
+    // Returns false and leaves the snapshot unchanged on a bad header, checksum or payload
+    bool deserialize(const char *data, qsizetype size, QString *errorMessage = nullptr);
+
+    bool save(const QString &path, QString *errorMessage = nullptr) const;
+    bool load(const QString &path, QString *errorMessage = nullptr);
+
+    static const quint32 MAGIC;
+    static const quint16 VERSION;
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <QtCore/QDateTime>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QVector>
+
+
+enum class NotificationType {
+    Info,
+    Warning,
+    Critical,
+    Emergency,
+    SystemUpdate,
+    NetworkStatus,
+    DataUpdate,
+    SeismicityAnomaly // Activity far above a cell's background rate
+};
+
+enum class NotificationPriority {
+    Low = 1,
+    Normal = 2,
+    High = 3,
+    Critical = 4,
+    Emergency = 5
+};
+
+enum class DeliveryChannel {
+    SystemTray,
+    DesktopNotification,
+    SoundAlert,
+    EmailAlert,
+    SMSAlert,
+    PushNotification,
+    LogFile,
+    Console
+};
+
+enum class SoundType {
+    None,
+    Beep,
+    Chime,
+    Alert,
+    Warning,
+    Emergency,
+    Custom
+};
+
+struct NotificationSettings {
+    bool enabled = true;
+    bool soundEnabled = true;
+    bool systemTrayEnabled = false;
+    bool desktopNotificationsEnabled = true;
+    bool emailEnabled = false;
+    bool smsEnabled = false;
+    bool pushEnabled = false;
+    
+    double magnitudeThreshold = 5.0;
+    int depthThreshold = 100; // km
+    int proximityRadius = 500; // km from user location
+    int quietHoursStart = 22; // 10 PM
+    int quietHoursEnd = 7; // 7 AM
+    bool respectQuietHours = true;
+    
+    QString emailAddress;
+    QString smsNumber;
+    QString pushServiceUrl;
+    QString customSoundPath;
+    
+    SoundType defaultSoundType = SoundType::Alert;
+    int notificationTimeout = 10000; // ms
+    int maxNotificationsPerHour = 20;
+    bool groupSimilarEvents = true;
+    bool showPreview = true;
+};
+
+struct NotificationData {
+    QString id;
+    QString title;
+    QString message;
+    QString details;
+    NotificationType type;
+    NotificationPriority priority;
+    QDateTime timestamp;
+    QVector<DeliveryChannel> channels;
+    QJsonObject metadata;
+    bool acknowledged = false;
+    bool persistent = false;
+    int retryCount = 0;
+    QDateTime expiryTime;
+    QString sourceEventId;
+};
+
+struct AlertRule {
+    QString name;
+    bool enabled = true;
+    double minMagnitude = 0.0;
+    double maxMagnitude = 10.0;
+    double minDepth = 0.0;
+    double maxDepth = 1000.0;
+    double centerLatitude = 0.0;
+    double centerLongitude = 0.0;
+    double radiusKm = 1000.0;
+    bool useLocation = false;
+    QStringList regions;
+    QString expression; // Optional condition, see AlertRuleExpression
+    NotificationPriority priority = NotificationPriority::Normal;
+    QVector<DeliveryChannel> channels;
+    QString customMessage;
+    SoundType soundType = SoundType::Alert;
+    int cooldownMinutes = 5;
+    QDateTime lastTriggered;
+};
+
+// Expected arrival of strong shaking at the user's location
+struct ShakingCountdown {
+    QString eventId;
+    double magnitude = 0.0;
+    double latitude = 0.0; // Hypocenter, for drawing the wavefronts
+    double longitude = 0.0;
+    double depth = 0.0;
+    QDateTime originTime;
+    double distanceKm = 0.0;
+    QDateTime pArrival;
+    QDateTime sArrival;
+    double secondsToShaking = 0.0; // Until sArrival, as of the last update
+};
@@ -0,0 +1,286 @@
+#include "region_registry.hpp"
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <limits>
+
+namespace {
+
+const int EDGES_PER_BAND = 4;
+const int MAX_BANDS = 1024;
+
+void setError(QString *errorMessage, const QString &message)
+{
+    if (errorMessage) *errorMessage = message;
+}
+
+QVector<QPointF> readRing(const QJsonArray &positions)
+{
+    QVector<QPointF> ring;
+    ring.reserve(positions.size());
+    for (const QJsonValue &value : positions) {
+        const QJsonArray position = value.toArray();
+        if (position.size() >= 2) {
+            ring.append(QPointF(position[0].toDouble(), position[1].toDouble()));
+        }
+    }
+    // GeoJSON rings repeat the first position at the end
+    if (ring.size() > 1 && ring.first() == ring.last()) ring.removeLast();
+    return ring;
+}
+
+void readPolygon(const QJsonArray &polygon, QVector<QVector<QPointF>> &rings)
+{
+    for (const QJsonValue &ring : polygon) {
+        rings.append(readRing(ring.toArray()));
+    }
+}
+
+} // namespace
+
+
+int RegionRegistry::addBox(const QString &name, double minLatitude, double maxLatitude,
+                           double minLongitude, double maxLongitude)
+{
+    Region region;
+    region.name = name;
+    region.minLatitude = qMin(minLatitude, maxLatitude);
+    region.maxLatitude = qMax(minLatitude, maxLatitude);
+    region.minLongitude = minLongitude;
+    region.maxLongitude = maxLongitude < minLongitude ? maxLongitude + 360.0 : maxLongitude;
+    region.isBox = true;
+    region.bandOffset = 0;
+    region.bandCount = 0;
+    region.bandHeight = 0.0;
+    return storeRegion(region);
+}
+
+int RegionRegistry::addPolygon(const QString &name, const QVector<QVector<QPointF>> &rings)
+{
+    Region region;
+    region.name = name;
+    region.minLatitude = std::numeric_limits<double>::max();
+    region.maxLatitude = std::numeric_limits<double>::lowest();
+    region.minLongitude = std::numeric_limits<double>::max();
+    region.maxLongitude = std::numeric_limits<double>::lowest();
+    region.isBox = false;
+
+    const int firstEdge = m_edges.size();
+    for (const QVector<QPointF> &ring : rings) {
+        if (ring.size() < 3) continue;
+
+        for (int i = 0; i < ring.size(); ++i) {
+            const QPointF &p = ring[i];
+            const QPointF &q = ring[(i + 1) % ring.size()];
+            region.minLatitude = qMin(region.minLatitude, p.y());
+            region.maxLatitude = qMax(region.maxLatitude, p.y());
+            region.minLongitude = qMin(region.minLongitude, p.x());
+            region.maxLongitude = qMax(region.maxLongitude, p.x());
+
+            // Horizontal edges never cross a line of constant latitude
+            if (p.y() == q.y()) continue;
+            const QPointF &low = p.y() < q.y() ? p : q;
+            const QPointF &high = p.y() < q.y() ? q : p;
+            m_edges.append({low.y(), high.y(), low.x(), (high.x() - low.x()) / (high.y() - low.y())});
+        }
+    }
+
+    const int edgeCount = m_edges.size() - firstEdge;
+    if (edgeCount == 0) {
+        qWarning() << "Region" << name << "has no area, ignored";
+        return -1;
+    }
+
+    region.bandCount = qBound(1, edgeCount / EDGES_PER_BAND, MAX_BANDS);
+    region.bandHeight = (region.maxLatitude - region.minLatitude) / region.bandCount;
+    region.bandOffset = m_bandOffsets.size();
+
+    auto bandOf = [&region](double latitude) {
+        return qBound(0, static_cast<int>((latitude - region.minLatitude) / region.bandHeight), region.bandCount - 1);
+    };
+
+    // Counting sort of edges into every band their latitude span touches
+    QVector<int> counts(region.bandCount + 1, 0);
+    for (int e = firstEdge; e < m_edges.size(); ++e) {
+        for (int b = bandOf(m_edges[e].latitude0); b <= bandOf(m_edges[e].latitude1); ++b) {
+            counts[b + 1]++;
+        }
+    }
+    const int base = m_bandEdges.size();
+    for (int b = 0; b < region.bandCount; ++b) {
+        counts[b + 1] += counts[b];
+    }
+    for (int b = 0; b <= region.bandCount; ++b) {
+        m_bandOffsets.append(base + counts[b]);
+    }
+
+    m_bandEdges.resize(base + counts[region.bandCount]);
+    for (int e = firstEdge; e < m_edges.size(); ++e) {
+        for (int b = bandOf(m_edges[e].latitude0); b <= bandOf(m_edges[e].latitude1); ++b) {
+            m_bandEdges[base + counts[b]++] = e;
+        }
+    }
+
+    return storeRegion(region);
+}
+
+int RegionRegistry::storeRegion(Region region)
+{
+    const QString key = region.name.toCaseFolded();
+    auto it = m_idByName.constFind(key);
+    if (it != m_idByName.constEnd()) {
+        m_regions[it.value()] = std::move(region);
+        return it.value();
+    }
+
+    const int id = m_regions.size();
+    m_regions.append(std::move(region));
+    m_idByName.insert(key, id);
+    return id;
+}
+
+void RegionRegistry::addDefaultRegions()
+{
+    addBox("California", 32.0, 42.0, -125.0, -114.0);
+    addBox("Alaska", 51.0, 72.0, 172.0, -129.0); // Aleutians cross the antimeridian
+    addBox("Japan", 24.0, 46.0, 122.0, 146.0);
+    addBox("Chile", -56.0, -17.5, -76.0, -66.0);
+    addBox("Indonesia", -11.0, 6.0, 95.0, 141.0);
+}
+
+bool RegionRegistry::loadGeoJson(const QByteArray &json, QString *errorMessage)
+{
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(json, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        setError(errorMessage, "Invalid region file: " + parseError.errorString());
+        return false;
+    }
+
+    const QJsonObject root = doc.object();
+    if (root["type"].toString() != "FeatureCollection") {
+        setError(errorMessage, "Region file is not a GeoJSON FeatureCollection");
+        return false;
+    }
+
+    const QJsonArray features = root["features"].toArray();
+    for (int i = 0; i < features.size(); ++i) {
+        const QJsonObject feature = features[i].toObject();
+        const QString name = feature["properties"].toObject()["name"].toString();
+        if (name.isEmpty()) {
+            setError(errorMessage, QString("Region feature %1 has no name").arg(i));
+            return false;
+        }
+
+        const QJsonObject geometry = feature["geometry"].toObject();
+        const QString type = geometry["type"].toString();
+        const QJsonArray coordinates = geometry["coordinates"].toArray();
+
+        QVector<QVector<QPointF>> rings;
+        if (type == "Polygon") {
+            readPolygon(coordinates, rings);
+        } else if (type == "MultiPolygon") {
+            for (const QJsonValue &polygon : coordinates) {
+                readPolygon(polygon.toArray(), rings);
+            }
+        } else if (geometry.isEmpty() && feature["bbox"].toArray().size() == 4) {
+            // [west, south, east, north]; west > east crosses the antimeridian
+            const QJsonArray bbox = feature["bbox"].toArray();
+            addBox(name, bbox[1].toDouble(), bbox[3].toDouble(), bbox[0].toDouble(), bbox[2].toDouble());
+            continue;
+        } else {
+            setError(errorMessage, QString("Region '%1' has unsupported geometry '%2'").arg(name, type));
+            return false;
+        }
+
+        addPolygon(name, rings);
+    }
+
+    return true;
+}
+
+bool RegionRegistry::loadFromFile(const QString &path, QString *errorMessage)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        setError(errorMessage, "Cannot open region file " + path + ": " + file.errorString());
+        return false;
+    }
+    return loadGeoJson(file.readAll(), errorMessage);
+}
+
+int RegionRegistry::regionId(const QString &name) const
+{
+    return m_idByName.value(name.toCaseFolded(), -1);
+}
+
+QString RegionRegistry::regionName(int id) const
+{
+    return id >= 0 && id < m_regions.size() ? m_regions[id].name : QString();
+}
+
+QStringList RegionRegistry::regionNames() const
+{
+    QStringList names;
+    for (const Region &region : m_regions) {
+        names.append(region.name);
+    }
+    return names;
+}
+
+bool RegionRegistry::contains(int id, double latitude, double longitude) const
+{
+    if (id < 0 || id >= m_regions.size()) return false;
+    return containsPoint(m_regions[id], latitude, longitude);
+}
+
+bool RegionRegistry::containsAny(const QVector<int> &ids, double latitude, double longitude) const
+{
+    for (int id : ids) {
+        if (contains(id, latitude, longitude)) return true;
+    }
+    return false;
+}
+
+QVector<int> RegionRegistry::regionsAt(double latitude, double longitude) const
+{
+    QVector<int> ids;
+    for (int id = 0; id < m_regions.size(); ++id) {
+        if (containsPoint(m_regions[id], latitude, longitude)) ids.append(id);
+    }
+    return ids;
+}
+
+bool RegionRegistry::containsPoint(const Region &region, double latitude, double longitude) const
+{
+    if (latitude < region.minLatitude || latitude > region.maxLatitude) return false;
+
+    // Shapes crossing the antimeridian are stored with longitudes beyond +/-180
+    if (longitude < region.minLongitude && region.maxLongitude > 180.0) {
+        longitude += 360.0;
+    } else if (longitude > region.maxLongitude && region.minLongitude < -180.0) {
+        longitude -= 360.0;
+    }
+    if (longitude < region.minLongitude || longitude > region.maxLongitude) return false;
+    if (region.isBox) return true;
+
+    // Even-odd crossing count over the edges of the point's latitude band;
+    // the half-open latitude test counts shared vertices once
+    const int band = qBound(0, static_cast<int>((latitude - region.minLatitude) / region.bandHeight),
+                            region.bandCount - 1);
+    const int begin = m_bandOffsets[region.bandOffset + band];
+    const int end = m_bandOffsets[region.bandOffset + band + 1];
+
+    bool inside = false;
+    for (int k = begin; k < end; ++k) {
+        const Edge &edge = m_edges[m_bandEdges[k]];
+        if (latitude >= edge.latitude0 && latitude < edge.latitude1
+            && longitude < edge.longitude0 + (latitude - edge.latitude0) * edge.slope) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
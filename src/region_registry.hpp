@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QPointF>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QVector>
+
+
+// Named geographic regions tested by point-in-polygon instead of by name.
+//
+// Regions are boxes or polygons (x = longitude, y = latitude, degrees; the
+// first ring of a part is its outline, further rings are holes). Each region
+// is prepared once: its bounding box rejects most points, and its edges are
+// bucketed into latitude bands so a containment test only walks the edges
+// crossing the point's band. Regions are referenced by the integer id that
+// add*() returns; re-adding a name replaces the region but keeps its id.
+// Longitudes past +/-180 are allowed for shapes crossing the antimeridian.
+class RegionRegistry
+{
+public:
+    RegionRegistry() = default;
+
+    // minLongitude > maxLongitude wraps across the antimeridian
+    int addBox(const QString &name, double minLatitude, double maxLatitude,
+               double minLongitude, double maxLongitude);
+    int addPolygon(const QString &name, const QVector<QVector<QPointF>> &rings);
+
+    // California, Alaska, Japan, Chile and Indonesia as bounding boxes
+    void addDefaultRegions();
+
+    // GeoJSON FeatureCollection of Polygon/MultiPolygon features named by
+    // properties.name; features without geometry but with a bbox become boxes.
+    // Returns false and leaves already loaded features in place on error.
+    bool loadGeoJson(const QByteArray &json, QString *errorMessage = nullptr);
+    bool loadFromFile(const QString &path, QString *errorMessage = nullptr);
+
+    int size() const { return m_regions.size(); }
+    int regionId(const QString &name) const; // -1 if unknown; case-insensitive
+    QString regionName(int id) const;
+    QStringList regionNames() const;
+
+    bool contains(int id, double latitude, double longitude) const;
+    bool containsAny(const QVector<int> &ids, double latitude, double longitude) const;
+    QVector<int> regionsAt(double latitude, double longitude) const;
+
+private:
+    struct Edge {
+        double latitude0;
+        double latitude1;
+        double longitude0;
+        double slope; // Longitude change per degree of latitude
+    };
+
+    struct Region {
+        QString name;
+        double minLatitude;
+        double maxLatitude;
+        double minLongitude;
+        double maxLongitude;
+        bool isBox;
+        int bandOffset;    // First entry of this region in m_bandOffsets
+        int bandCount;
+        double bandHeight;
+    };
+
+    int storeRegion(Region region);
+    bool containsPoint(const Region &region, double latitude, double longitude) const;
+
+    QVector<Region> m_regions;
+    QHash<QString, int> m_idByName;
+
+    // Edges of all polygon regions, bucketed per latitude band (CSR layout)
+    QVector<Edge> m_edges;
+    QVector<int> m_bandOffsets;
+    QVector<int> m_bandEdges;
+};
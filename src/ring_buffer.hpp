@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QtCore/QtGlobal>
+#include <QVector>
+#include <utility>
+
+
+// Fixed-capacity FIFO over a preallocated array. Not thread-safe; callers
+// provide their own locking. Index 0 is the oldest element.
+template<typename T>
+class RingBuffer
+{
+public:
+    explicit RingBuffer(int capacity = 0)
+        : m_items(qMax(0, capacity))
+        , m_head(0)
+        , m_count(0)
+    {
+    }
+
+    int capacity() const { return m_items.size(); }
+    int size() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+    bool isFull() const { return m_count == m_items.size(); }
+
+    // Appends unless full
+    bool push(T value)
+    {
+        if (isFull()) return false;
+        m_items[slot(m_count)] = std::move(value);
+        ++m_count;
+        return true;
+    }
+
+    // Appends, evicting the oldest element when full. Returns true if one was evicted.
+    bool pushOverwrite(T value)
+    {
+        if (m_items.isEmpty()) return false;
+        if (!isFull()) {
+            push(std::move(value));
+            return false;
+        }
+        m_items[m_head] = std::move(value);
+        m_head = (m_head + 1) % m_items.size();
+        return true;
+    }
+
+    bool pop(T &value)
+    {
+        if (isEmpty()) return false;
+        value = std::move(m_items[m_head]);
+        m_items[m_head] = T();
+        m_head = (m_head + 1) % m_items.size();
+        --m_count;
+        return true;
+    }
+
+    // Drops the n oldest elements
+    void discard(int n)
+    {
+        n = qBound(0, n, m_count);
+        for (int i = 0; i < n; ++i) {
+            m_items[m_head] = T();
+            m_head = (m_head + 1) % m_items.size();
+        }
+        m_count -= n;
+    }
+
+    const T &at(int index) const { return m_items[slot(index)]; }
+    T &operator[](int index) { return m_items[slot(index)]; }
+    const T &first() const { return at(0); }
+    const T &last() const { return at(m_count - 1); }
+
+    void clear()
+    {
+        discard(m_count);
+        m_head = 0;
+    }
+
+    // Changes capacity, keeping the newest elements that fit
+    void setCapacity(int capacity)
+    {
+        capacity = qMax(0, capacity);
+        QVector<T> items(capacity);
+        const int keep = qMin(m_count, capacity);
+        for (int i = 0; i < keep; ++i) {
+            items[i] = std::move((*this)[m_count - keep + i]);
+        }
+        m_items = std::move(items);
+        m_head = 0;
+        m_count = keep;
+    }
+
+    QVector<T> toVector() const
+    {
+        QVector<T> result;
+        result.reserve(m_count);
+        for (int i = 0; i < m_count; ++i) result.append(at(i));
+        return result;
+    }
+
+private:
+    int slot(int index) const { return (m_head + index) % m_items.size(); }
+
+    QVector<T> m_items;
+    int m_head;
+    int m_count;
+};
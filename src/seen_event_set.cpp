@@ -0,0 +1,211 @@
+#include "seen_event_set.hpp"
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QVector>
+#include <algorithm>
+
+// Constants
+const qint64 SeenEventSet::DEFAULT_MAX_AGE_MS = 30LL * 24 * 3600 * 1000; // Longest USGS summary feed
+const int SeenEventSet::DEFAULT_MAX_ENTRIES = 200000;
+
+namespace {
+
+const quint32 STREAM_MAGIC = 0x53454556; // "SEEV"
+const quint16 STREAM_VERSION = 1;
+
+} // namespace
+
+
+SeenEventSet::SeenEventSet(qint64 maxAgeMs, int maxEntries)
+    : m_maxAgeMs(qMax<qint64>(1, maxAgeMs))
+    , m_maxEntries(qMax(1, maxEntries))
+{
+}
+
+SeenEventSet::Status SeenEventSet::observe(const QString &eventId, quint32 revision, qint64 nowMs)
+{
+    auto it = m_entries.find(eventId);
+    if (it == m_entries.end()) {
+        if (m_entries.size() >= m_maxEntries) {
+            evictOldest();
+        }
+        it = m_entries.insert(eventId, Entry{revision, nowMs, nowMs});
+        m_queue.enqueue({nowMs, eventId});
+        return Status::New;
+    }
+
+    Entry &entry = it.value();
+    const Status status = entry.revision == revision ? Status::Unchanged : Status::Updated;
+    entry.revision = revision;
+    entry.lastSeenMs = nowMs;
+
+    // Events that stay in the feed are re-queued rarely, not on every refresh
+    if (nowMs - entry.queuedAtMs >= m_maxAgeMs / 2) {
+        enqueue(eventId, entry, nowMs);
+    }
+    return status;
+}
+
+SeenEventSet::Status SeenEventSet::observe(const EarthquakeData &earthquake, qint64 nowMs)
+{
+    return observe(keyOf(earthquake), revisionOf(earthquake), nowMs);
+}
+
+QVector<EarthquakeData> SeenEventSet::observe(const QVector<EarthquakeData> &earthquakes, qint64 nowMs,
+                                              QVector<EarthquakeData> *newEvents)
+{
+    QVector<EarthquakeData> changed;
+    for (const EarthquakeData &earthquake : earthquakes) {
+        const Status status = observe(earthquake, nowMs);
+        if (status == Status::Unchanged) continue;
+        changed.append(earthquake);
+        if (status == Status::New && newEvents) {
+            newEvents->append(earthquake);
+        }
+    }
+    return changed;
+}
+
+void SeenEventSet::clear()
+{
+    m_entries.clear();
+    m_queue.clear();
+}
+
+int SeenEventSet::evictExpired(qint64 nowMs)
+{
+    const qint64 cutoff = nowMs - m_maxAgeMs;
+    int evicted = 0;
+
+    while (!m_queue.isEmpty() && m_queue.head().atMs < cutoff) {
+        const QueueItem item = m_queue.dequeue();
+
+        auto it = m_entries.find(item.eventId);
+        if (it == m_entries.end() || it->queuedAtMs != item.atMs) continue; // Superseded
+
+        if (it->lastSeenMs < cutoff) {
+            m_entries.erase(it);
+            evicted++;
+        } else {
+            enqueue(item.eventId, it.value(), nowMs);
+        }
+    }
+
+    return evicted;
+}
+
+void SeenEventSet::enqueue(const QString &eventId, Entry &entry, qint64 nowMs)
+{
+    entry.queuedAtMs = nowMs;
+    m_queue.enqueue({nowMs, eventId});
+}
+
+void SeenEventSet::evictOldest()
+{
+    while (!m_queue.isEmpty()) {
+        const QueueItem item = m_queue.dequeue();
+        auto it = m_entries.find(item.eventId);
+        if (it != m_entries.end() && it->queuedAtMs == item.atMs) {
+            m_entries.erase(it);
+            return;
+        }
+    }
+}
+
+quint32 SeenEventSet::revisionOf(const EarthquakeData &earthquake)
+{
+    // Packed rather than hashed so stored revisions stay valid across Qt versions
+    const quint32 magnitude = static_cast<quint32>(qBound(0, qRound(earthquake.magnitude * 10.0) + 100, 0xFFFF));
+    const quint32 alertLevel = static_cast<quint32>(qBound(0, earthquake.alertLevel, 0xFF));
+    const quint32 reviewed = earthquake.reviewStatus.compare("reviewed", Qt::CaseInsensitive) == 0 ? 2 : 0;
+    const quint32 tsunami = earthquake.tsunamiFlag == QLatin1String("Yes") ? 1 : 0;
+    return (magnitude << 16) | (alertLevel << 8) | reviewed | tsunami;
+}
+
+QString SeenEventSet::keyOf(const EarthquakeData &earthquake)
+{
+    if (!earthquake.eventId.isEmpty()) return earthquake.eventId;
+    return QString("@%1/%2/%3").arg(earthquake.timestamp.toMSecsSinceEpoch())
+                               .arg(earthquake.latitude, 0, 'f', 3)
+                               .arg(earthquake.longitude, 0, 'f', 3);
+}
+
+void SeenEventSet::writeTo(QDataStream &stream) const
+{
+    stream << STREAM_MAGIC << STREAM_VERSION << static_cast<qint32>(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        stream << it.key() << it->revision << it->lastSeenMs;
+    }
+}
+
+bool SeenEventSet::readFrom(QDataStream &stream)
+{
+    clear();
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    qint32 count = 0;
+    stream >> magic >> version >> count;
+    if (stream.status() != QDataStream::Ok || magic != STREAM_MAGIC || version != STREAM_VERSION || count < 0) {
+        return false;
+    }
+
+    QVector<QueueItem> items;
+    items.reserve(qMin(count, m_maxEntries));
+    m_entries.reserve(qMin(count, m_maxEntries));
+    for (qint32 i = 0; i < count; ++i) {
+        QString eventId;
+        quint32 revision = 0;
+        qint64 lastSeenMs = 0;
+        stream >> eventId >> revision >> lastSeenMs;
+        if (stream.status() != QDataStream::Ok) {
+            clear();
+            return false;
+        }
+        m_entries.insert(eventId, Entry{revision, lastSeenMs, lastSeenMs});
+        items.append({lastSeenMs, eventId});
+    }
+
+    // Rebuild the eviction order from the stored times
+    std::sort(items.begin(), items.end(), [](const QueueItem &a, const QueueItem &b) { return a.atMs < b.atMs; });
+    for (const QueueItem &item : items) {
+        m_queue.enqueue(item);
+    }
+    while (m_entries.size() > m_maxEntries) {
+        evictOldest();
+    }
+    return true;
+}
+
+bool SeenEventSet::saveToFile(const QString &path) const
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to save seen events to:" << path;
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    writeTo(stream);
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+bool SeenEventSet::loadFromFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        clear();
+        return false; // First run
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    if (!readFrom(stream)) {
+        qWarning() << "Ignoring unreadable seen-event file:" << path;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "earthquake_data.hpp"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QHash>
+#include <QtCore/QQueue>
+#include <QtCore/QString>
+#include <QVector>
+
+
+// Events that have already been considered for alerts, keyed by event id
+// and revision. A hash gives O(1) "new or changed?" checks; a time-ordered
+// queue evicts entries not seen for maxAge, and the oldest ones once
+// maxEntries is exceeded. Queue entries are pruned lazily: an event seen
+// again is re-queued at most once per half maxAge, and stale queue entries
+// are skipped on eviction.
+class SeenEventSet
+{
+public:
+    enum class Status { New, Updated, Unchanged };
+
+    explicit SeenEventSet(qint64 maxAgeMs = DEFAULT_MAX_AGE_MS, int maxEntries = DEFAULT_MAX_ENTRIES);
+
+    // Records the event as seen at nowMs and reports whether it is new or a new revision
+    Status observe(const QString &eventId, quint32 revision, qint64 nowMs);
+    Status observe(const EarthquakeData &earthquake, qint64 nowMs); // Keyed by keyOf()
+    // Records a batch; returns its new and revised events in batch order and
+    // appends the new ones alone to newEvents. A repeat within the batch
+    // counts as seen.
+    QVector<EarthquakeData> observe(const QVector<EarthquakeData> &earthquakes, qint64 nowMs,
+                                    QVector<EarthquakeData> *newEvents = nullptr);
+
+    bool contains(const QString &eventId) const { return m_entries.contains(eventId); }
+    int size() const { return m_entries.size(); }
+    void clear();
+
+    // Drops entries last seen before nowMs - maxAge
+    int evictExpired(qint64 nowMs);
+
+    // Revision from the fields that can make an event worth re-alerting:
+    // magnitude (0.1 steps), alert level, review status and tsunami flag
+    static quint32 revisionOf(const EarthquakeData &earthquake);
+    // Event id, or origin time and epicenter for feeds without ids
+    static QString keyOf(const EarthquakeData &earthquake);
+
+    void writeTo(QDataStream &stream) const;
+    bool readFrom(QDataStream &stream); // Leaves the set empty on failure
+    bool saveToFile(const QString &path) const;
+    bool loadFromFile(const QString &path);
+
+    static const qint64 DEFAULT_MAX_AGE_MS;
+    static const int DEFAULT_MAX_ENTRIES;
+
+private:
+    struct Entry {
+        quint32 revision;
+        qint64 lastSeenMs;
+        qint64 queuedAtMs; // Time of this event's newest queue entry
+    };
+
+    struct QueueItem {
+        qint64 atMs;
+        QString eventId;
+    };
+
+    void enqueue(const QString &eventId, Entry &entry, qint64 nowMs);
+    void evictOldest();
+
+    qint64 m_maxAgeMs;
+    int m_maxEntries;
+    QHash<QString, Entry> m_entries;
+    QQueue<QueueItem> m_queue;
+};
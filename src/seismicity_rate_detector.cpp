@@ -0,0 +1,174 @@
+#include "seismicity_rate_detector.hpp"
+
+#include <QtCore/QMutexLocker>
+#include <algorithm>
+#include <cmath>
+
+// Constants
+const double SeismicityRateDetector::CELL_SIZE_DEGREES = 1.0;
+const qint64 SeismicityRateDetector::SHORT_TIME_CONSTANT_MS = 24 * 3600 * 1000LL;
+const qint64 SeismicityRateDetector::LONG_TIME_CONSTANT_MS = 365 * 24 * 3600 * 1000LL;
+const double SeismicityRateDetector::BACKGROUND_FLOOR_PER_DAY = 0.01;
+const double SeismicityRateDetector::MIN_EVENTS = 5.0;
+const double SeismicityRateDetector::ALERT_LOG_LIKELIHOOD_RATIO = 10.0;
+const double SeismicityRateDetector::RESET_LOG_LIKELIHOOD_RATIO = 3.0;
+const qint64 SeismicityRateDetector::MIN_HISTORY_MS = 7 * 24 * 3600 * 1000LL;
+
+namespace {
+
+const quint32 STREAM_MAGIC = 0x53524454; // "SRDT"
+const quint16 STREAM_VERSION = 1;
+const qint64 DAY_MS = 24 * 3600 * 1000LL;
+const int GRID_ROWS = int(180.0 / SeismicityRateDetector::CELL_SIZE_DEGREES);
+const int GRID_COLUMNS = int(360.0 / SeismicityRateDetector::CELL_SIZE_DEGREES);
+
+int cellOf(double latitude, double longitude)
+{
+    const double size = SeismicityRateDetector::CELL_SIZE_DEGREES;
+    const int row = std::clamp(int(std::floor((latitude + 90.0) / size)), 0, GRID_ROWS - 1);
+    int column = int(std::floor((longitude + 180.0) / size)) % GRID_COLUMNS;
+    if (column < 0) column += GRID_COLUMNS;
+    return row * GRID_COLUMNS + column;
+}
+
+} // namespace
+
+
+QVector<SeismicityRateDetector::Anomaly> SeismicityRateDetector::observe(const QVector<EarthquakeData> &earthquakes,
+                                                                        qint64 nowMs)
+{
+    QVector<Anomaly> anomalies;
+    Anomaly anomaly;
+    for (const EarthquakeData &earthquake : earthquakes) {
+        if (observe(earthquake, nowMs, &anomaly)) {
+            anomalies.append(anomaly);
+        }
+    }
+    return anomalies;
+}
+
+bool SeismicityRateDetector::observe(const EarthquakeData &earthquake, qint64 nowMs, Anomaly *anomaly)
+{
+    if (!earthquake.timestamp.isValid()) return false;
+
+    QMutexLocker locker(&m_mutex);
+
+    const int cell = cellOf(earthquake.latitude, earthquake.longitude);
+    const qint64 timeMs = earthquake.timestamp.toMSecsSinceEpoch();
+    CellState &state = m_cells[cell];
+    m_historyStartMs = qMin(m_historyStartMs, timeMs);
+
+    // Both counts are kept as of the newest event; a late one adds its decayed weight
+    if (timeMs >= state.lastMs) {
+        const double elapsed = double(timeMs - state.lastMs);
+        state.shortCount = state.shortCount * std::exp(-elapsed / SHORT_TIME_CONSTANT_MS) + 1.0;
+        state.longCount = state.longCount * std::exp(-elapsed / LONG_TIME_CONSTANT_MS) + 1.0;
+        state.lastMs = timeMs;
+    } else {
+        const double age = double(state.lastMs - timeMs);
+        state.shortCount += std::exp(-age / SHORT_TIME_CONSTANT_MS);
+        state.longCount += std::exp(-age / LONG_TIME_CONSTANT_MS);
+    }
+
+    const double expected = expectedCountLocked(state);
+    const double ratio = logLikelihoodRatio(state.shortCount, expected);
+    if (state.anomalous) {
+        if (ratio < RESET_LOG_LIKELIHOOD_RATIO) state.anomalous = false;
+        return false;
+    }
+    if (ratio < ALERT_LOG_LIKELIHOOD_RATIO || state.shortCount < MIN_EVENTS
+        || nowMs - state.lastMs > SHORT_TIME_CONSTANT_MS || state.lastMs - m_historyStartMs < MIN_HISTORY_MS) {
+        return false;
+    }
+
+    state.anomalous = true;
+    if (anomaly) {
+        anomaly->latitude = (cell / GRID_COLUMNS + 0.5) * CELL_SIZE_DEGREES - 90.0;
+        anomaly->longitude = (cell % GRID_COLUMNS + 0.5) * CELL_SIZE_DEGREES - 180.0;
+        anomaly->observed = state.shortCount;
+        anomaly->expected = expected;
+        anomaly->logLikelihoodRatio = ratio;
+        anomaly->eventId = earthquake.eventId;
+        anomaly->timeMs = timeMs;
+    }
+    return true;
+}
+
+int SeismicityRateDetector::cellCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_cells.size();
+}
+
+bool SeismicityRateDetector::isAnomalous(double latitude, double longitude) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_cells.constFind(cellOf(latitude, longitude));
+    return it != m_cells.constEnd() && it->anomalous;
+}
+
+void SeismicityRateDetector::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_cells.clear();
+    m_historyStartMs = std::numeric_limits<qint64>::max();
+}
+
+void SeismicityRateDetector::writeTo(QDataStream &stream) const
+{
+    QMutexLocker locker(&m_mutex);
+    stream << STREAM_MAGIC << STREAM_VERSION << m_historyStartMs << static_cast<qint32>(m_cells.size());
+    for (auto it = m_cells.constBegin(); it != m_cells.constEnd(); ++it) {
+        stream << qint32(it.key()) << it->shortCount << it->longCount << it->lastMs << it->anomalous;
+    }
+}
+
+bool SeismicityRateDetector::readFrom(QDataStream &stream)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cells.clear();
+    m_historyStartMs = std::numeric_limits<qint64>::max();
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    qint64 historyStartMs = 0;
+    qint32 count = 0;
+    stream >> magic >> version >> historyStartMs >> count;
+    if (stream.status() != QDataStream::Ok || magic != STREAM_MAGIC || version != STREAM_VERSION || count < 0) {
+        return false;
+    }
+
+    for (qint32 i = 0; i < count; ++i) {
+        qint32 cell = 0;
+        CellState state;
+        stream >> cell >> state.shortCount >> state.longCount >> state.lastMs >> state.anomalous;
+        if (stream.status() != QDataStream::Ok || cell < 0 || cell >= GRID_ROWS * GRID_COLUMNS) {
+            m_cells.clear();
+            return false;
+        }
+        m_cells.insert(cell, state);
+    }
+    m_historyStartMs = historyStartMs;
+    return true;
+}
+
+double SeismicityRateDetector::logLikelihoodRatio(double observed, double expected)
+{
+    if (observed <= expected || expected <= 0.0) return 0.0;
+    return observed * std::log(observed / expected) - (observed - expected);
+}
+
+double SeismicityRateDetector::expectedCountLocked(const CellState &state) const
+{
+    // Each event of age a adds exp(-a/long) - exp(-a/short) to the
+    // difference, so recent events weigh ~0. At a steady rate the
+    // difference is that rate times the integral of this weight over the
+    // observed history.
+    const double history = double(qMax<qint64>(0, state.lastMs - m_historyStartMs));
+    const double shortSpan = double(SHORT_TIME_CONSTANT_MS);
+    const double longSpan = double(LONG_TIME_CONSTANT_MS);
+    const double weight = longSpan * -std::expm1(-history / longSpan) - shortSpan * -std::expm1(-history / shortSpan);
+    const double background = weight > 0.0 ? qMax(0.0, state.longCount - state.shortCount) / weight : 0.0;
+    const double floor = BACKGROUND_FLOOR_PER_DAY / double(DAY_MS);
+    return (background + floor) * SHORT_TIME_CONSTANT_MS;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "earthquake_data.hpp"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QVector>
+#include <limits>
+
+
+// Streaming detector for seismicity-rate spikes (swarms, sequences far
+// above background) on a 1-degree cell grid.
+//
+// Each cell keeps two exponentially decaying event counts, one with a
+// one-day and one with a one-year time constant, so an event costs a hash
+// lookup and two exp() calls. Their difference weights out the last day
+// and gives the background rate; the short count is the current activity.
+// A cell turns anomalous when the Poisson log-likelihood ratio of the
+// current count against the background expectation reaches
+// ALERT_LOG_LIKELIHOOD_RATIO, and re-arms once it falls below
+// RESET_LOG_LIKELIHOOD_RATIO. BACKGROUND_FLOOR_PER_DAY stands in for the
+// background of cells with little history. Until the observed history
+// spans MIN_HISTORY_MS the background is not known well enough to alert;
+// the background count is normalized by the span actually observed.
+//
+// Every event passed in is counted, so callers pass each one once; the
+// notification manager feeds it the events new to its seen-event set.
+// Events arriving late still update the counts, but only those within a
+// day of now can raise an anomaly. Thread-safe.
+class SeismicityRateDetector
+{
+public:
+    struct Anomaly {
+        double latitude;  // Cell center
+        double longitude;
+        double observed;  // Decayed event count over about a day
+        double expected;  // Background expectation for the same window
+        double logLikelihoodRatio;
+        QString eventId;  // The event that crossed the threshold
+        qint64 timeMs;
+    };
+
+    SeismicityRateDetector() = default;
+
+    // Counts the events; returns the cells that became anomalous, in event order
+    QVector<Anomaly> observe(const QVector<EarthquakeData> &earthquakes, qint64 nowMs);
+    bool observe(const EarthquakeData &earthquake, qint64 nowMs, Anomaly *anomaly = nullptr);
+
+    int cellCount() const;
+    bool isAnomalous(double latitude, double longitude) const;
+    void clear();
+
+    void writeTo(QDataStream &stream) const;
+    bool readFrom(QDataStream &stream); // Leaves the detector empty on failure
+
+    // n log(n / mu) - (n - mu) for n above mu, else 0
+    static double logLikelihoodRatio(double observed, double expected);
+
+    static const double CELL_SIZE_DEGREES;
+    static const qint64 SHORT_TIME_CONSTANT_MS;
+    static const qint64 LONG_TIME_CONSTANT_MS;
+    static const double BACKGROUND_FLOOR_PER_DAY;
+    static const double MIN_EVENTS;
+    static const double ALERT_LOG_LIKELIHOOD_RATIO;
+    static const double RESET_LOG_LIKELIHOOD_RATIO;
+    static const qint64 MIN_HISTORY_MS;
+
+private:
+    struct CellState {
+        double shortCount = 0.0; // Both as of lastMs
+        double longCount = 0.0;
+        qint64 lastMs = 0;
+        bool anomalous = false;
+    };
+
+    double expectedCountLocked(const CellState &state) const;
+
+    mutable QMutex m_mutex;
+    QHash<int, CellState> m_cells;
+    qint64 m_historyStartMs = std::numeric_limits<qint64>::max(); // Oldest event counted
+};
@@ -0,0 +1,422 @@
+#include "seismicity_statistics.hpp"
+#include "seen_event_set.hpp"
+
+#include <QtCore/QMutexLocker>
+#include <algorithm>
+#include <cmath>
+
+// Constants
+const double SeismicityStatistics::CELL_SIZE_DEGREES = 1.0;
+const double SeismicityStatistics::MIN_MAGNITUDE = -1.0;
+const double SeismicityStatistics::MAGNITUDE_BIN_WIDTH = 0.1;
+const double SeismicityStatistics::MAXC_CORRECTION = 0.2; // Woessner & Wiemer (2005)
+const int SeismicityStatistics::MIN_EVENTS_FOR_B_VALUE = 50;
+const int SeismicityStatistics::MIN_EVENTS_FOR_OMORI = 20;
+
+namespace {
+
+const qint64 HOUR_MS = 3600 * 1000LL;
+const double HOURS_PER_DAY = 24.0;
+const int GRID_ROWS = int(180.0 / SeismicityStatistics::CELL_SIZE_DEGREES);
+const int GRID_COLUMNS = int(360.0 / SeismicityStatistics::CELL_SIZE_DEGREES);
+
+// Bucket span per level in hours: hour, day, 32 days, 512 days
+const qint64 LEVEL_SPAN_HOURS[] = {1, 24, 24 * 32, 24 * 512};
+
+qint64 floorDiv(qint64 value, qint64 divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+int magnitudeBin(double magnitude)
+{
+    const long bin = std::lround((magnitude - SeismicityStatistics::MIN_MAGNITUDE)
+                                 / SeismicityStatistics::MAGNITUDE_BIN_WIDTH);
+    return int(std::clamp(bin, 0L, long(SeismicityStatistics::MAGNITUDE_BINS - 1)));
+}
+
+double binMagnitude(int bin)
+{
+    return SeismicityStatistics::MIN_MAGNITUDE + bin * SeismicityStatistics::MAGNITUDE_BIN_WIDTH;
+}
+
+int cellOf(double latitude, double longitude)
+{
+    const double size = SeismicityStatistics::CELL_SIZE_DEGREES;
+    const int row = std::clamp(int(std::floor((latitude + 90.0) / size)), 0, GRID_ROWS - 1);
+    int column = int(std::floor((longitude + 180.0) / size)) % GRID_COLUMNS;
+    if (column < 0) column += GRID_COLUMNS;
+    return row * GRID_COLUMNS + column;
+}
+
+// Integral of (c + t)^-p over [a, b]
+double omoriIntegral(double a, double b, double c, double p)
+{
+    if (std::abs(p - 1.0) < 1e-9) {
+        return std::log((c + b) / (c + a));
+    }
+    return (std::pow(c + b, 1.0 - p) - std::pow(c + a, 1.0 - p)) / (1.0 - p);
+}
+
+struct HourCount {
+    double startDays; // Since the mainshock
+    int count;
+};
+
+// Binned Poisson log-likelihood with K at its maximum, N / integral over
+// [startDays, endDays]; the constant N log N - N and the bin factorials are
+// left out
+double omoriProfileLikelihood(const QVector<HourCount> &bins, double startDays, double endDays,
+                              double c, double p, double &k)
+{
+    const double total = omoriIntegral(startDays, endDays, c, p);
+    double likelihood = 0.0;
+    int events = 0;
+    for (const HourCount &bin : bins) {
+        const double part = omoriIntegral(bin.startDays, bin.startDays + 1.0 / HOURS_PER_DAY, c, p);
+        likelihood += bin.count * std::log(part / total);
+        events += bin.count;
+    }
+    k = events / total;
+    return likelihood;
+}
+
+} // namespace
+
+
+void SeismicityStatistics::add(const EarthquakeData &earthquake)
+{
+    if (!earthquake.timestamp.isValid() || !std::isfinite(earthquake.magnitude)
+        || !std::isfinite(earthquake.latitude) || !std::isfinite(earthquake.longitude)) {
+        return;
+    }
+
+    Entry entry;
+    entry.cell = cellOf(earthquake.latitude, earthquake.longitude);
+    entry.hour = floorDiv(earthquake.timestamp.toMSecsSinceEpoch(), HOUR_MS);
+    entry.bin = magnitudeBin(earthquake.magnitude);
+    entry.momentNm = seismicMoment(earthquake.magnitude);
+
+    const QString key = SeenEventSet::keyOf(earthquake);
+    QMutexLocker locker(&m_mutex);
+    removeLocked(key);
+    addLocked(key, entry);
+}
+
+void SeismicityStatistics::add(const QVector<EarthquakeData> &earthquakes)
+{
+    for (const EarthquakeData &earthquake : earthquakes) {
+        add(earthquake);
+    }
+}
+
+bool SeismicityStatistics::remove(const QString &eventKey)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_entries.contains(eventKey)) return false;
+    removeLocked(eventKey);
+    return true;
+}
+
+void SeismicityStatistics::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_cells.clear();
+    m_rowColumns.clear();
+    m_entries.clear();
+}
+
+int SeismicityStatistics::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.size();
+}
+
+std::array<int, SeismicityStatistics::MAGNITUDE_BINS> SeismicityStatistics::magnitudeHistogram(const Window &window) const
+{
+    QMutexLocker locker(&m_mutex);
+    const Bucket sum = collectLocked(window);
+    std::array<int, MAGNITUDE_BINS> histogram;
+    std::copy(sum.histogram.begin(), sum.histogram.end(), histogram.begin());
+    return histogram;
+}
+
+SeismicityStatistics::GutenbergRichter SeismicityStatistics::gutenbergRichter(const Window &window, double completeness) const
+{
+    const std::array<int, MAGNITUDE_BINS> histogram = magnitudeHistogram(window);
+
+    GutenbergRichter result;
+    int mostFrequent = 0;
+    for (int bin = 0; bin < MAGNITUDE_BINS; ++bin) {
+        result.eventCount += histogram[bin];
+        if (histogram[bin] > histogram[mostFrequent]) mostFrequent = bin;
+    }
+    if (result.eventCount == 0) return result;
+
+    // Maximum curvature: the peak of the non-cumulative distribution
+    if (std::isnan(completeness)) {
+        completeness = binMagnitude(mostFrequent) + MAXC_CORRECTION;
+    }
+    const int firstBin = magnitudeBin(completeness);
+    result.completeness = binMagnitude(firstBin);
+
+    double sum = 0.0;
+    for (int bin = firstBin; bin < MAGNITUDE_BINS; ++bin) {
+        result.completeCount += histogram[bin];
+        sum += histogram[bin] * binMagnitude(bin);
+    }
+    const int n = result.completeCount;
+    if (n < MIN_EVENTS_FOR_B_VALUE) return result;
+
+    // Aki (1965) with Utsu's correction for binned magnitudes
+    const double mean = sum / n;
+    const double excess = mean - (result.completeness - MAGNITUDE_BIN_WIDTH / 2.0);
+    if (excess <= 0.0) return result;
+
+    double squares = 0.0;
+    for (int bin = firstBin; bin < MAGNITUDE_BINS; ++bin) {
+        const double deviation = binMagnitude(bin) - mean;
+        squares += histogram[bin] * deviation * deviation;
+    }
+    result.bValue = std::log10(std::exp(1.0)) / excess;
+    result.bError = 2.30 * result.bValue * result.bValue * std::sqrt(squares / (double(n) * (n - 1)));
+    result.aValue = std::log10(double(n)) + result.bValue * result.completeness;
+    result.valid = true;
+    return result;
+}
+
+SeismicityStatistics::OmoriUtsu SeismicityStatistics::omoriUtsu(const Window &window, double minMagnitude) const
+{
+    if (std::isnan(minMagnitude)) {
+        minMagnitude = gutenbergRichter(window).completeness;
+    }
+
+    // The mainshock's own hour is left out: it holds the mainshock and the
+    // early aftershocks that catalogs miss in its coda
+    const qint64 firstHour = floorDiv(window.startMs, HOUR_MS) + 1;
+    const qint64 endHour = -floorDiv(-window.endMs, HOUR_MS);
+    OmoriUtsu result;
+    if (endHour <= firstHour) return result;
+
+    QVector<int> counts;
+    {
+        QMutexLocker locker(&m_mutex);
+        counts = hourlyCountsLocked(window, firstHour, endHour, magnitudeBin(minMagnitude));
+    }
+
+    const double dayMs = HOUR_MS * HOURS_PER_DAY;
+    const double startDays = (firstHour * HOUR_MS - window.startMs) / dayMs;
+    const double endDays = (endHour * HOUR_MS - window.startMs) / dayMs;
+    QVector<HourCount> bins;
+    for (int hour = 0; hour < counts.size(); ++hour) {
+        if (counts[hour] == 0) continue;
+        bins.append(HourCount{startDays + hour / HOURS_PER_DAY, counts[hour]});
+        result.eventCount += counts[hour];
+    }
+    if (result.eventCount < MIN_EVENTS_FOR_OMORI) return result;
+
+    // Grid search over log10 c and p, narrowing twice around the best point
+    double bestLogC = -1.0, bestP = 1.0, bestLikelihood = -std::numeric_limits<double>::infinity();
+    double logCStep = 0.1, pStep = 0.05;
+    double logCLow = -3.0, logCHigh = 1.0, pLow = 0.2, pHigh = 3.0;
+    for (int pass = 0; pass < 3; ++pass) {
+        for (double logC = logCLow; logC <= logCHigh + 1e-9; logC += logCStep) {
+            for (double p = pLow; p <= pHigh + 1e-9; p += pStep) {
+                double k;
+                const double likelihood = omoriProfileLikelihood(bins, startDays, endDays,
+                                                                 std::pow(10.0, logC), p, k);
+                if (likelihood > bestLikelihood) {
+                    bestLikelihood = likelihood;
+                    bestLogC = logC;
+                    bestP = p;
+                }
+            }
+        }
+        logCLow = bestLogC - logCStep;
+        logCHigh = bestLogC + logCStep;
+        pLow = qMax(0.2, bestP - pStep);
+        pHigh = qMin(3.0, bestP + pStep);
+        logCStep /= 10.0;
+        pStep /= 10.0;
+    }
+
+    result.cDays = std::pow(10.0, bestLogC);
+    result.p = bestP;
+    result.logLikelihood = omoriProfileLikelihood(bins, startDays, endDays, result.cDays, result.p, result.k);
+    result.valid = true;
+    return result;
+}
+
+SeismicityStatistics::MomentRelease SeismicityStatistics::momentRelease(const Window &window) const
+{
+    QMutexLocker locker(&m_mutex);
+    const Bucket sum = collectLocked(window);
+
+    MomentRelease result;
+    result.eventCount = sum.count;
+    result.momentNm = sum.momentNm;
+    if (sum.momentNm > 0.0) {
+        result.equivalentMagnitude = momentMagnitude(sum.momentNm);
+    }
+    return result;
+}
+
+double SeismicityStatistics::seismicMoment(double magnitude)
+{
+    return std::pow(10.0, 1.5 * magnitude + 9.1);
+}
+
+double SeismicityStatistics::momentMagnitude(double momentNm)
+{
+    return (std::log10(momentNm) - 9.1) / 1.5;
+}
+
+void SeismicityStatistics::addLocked(const QString &key, const Entry &entry)
+{
+    CellSeries &series = m_cells[entry.cell];
+    if (series.eventCount == 0) {
+        if (m_rowColumns.isEmpty()) m_rowColumns.resize(GRID_ROWS);
+        QVector<int> &columns = m_rowColumns[entry.cell / GRID_COLUMNS];
+        const int column = entry.cell % GRID_COLUMNS;
+        columns.insert(std::lower_bound(columns.begin(), columns.end(), column), column);
+    }
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        Bucket &bucket = series.levels[level][floorDiv(entry.hour, LEVEL_SPAN_HOURS[level])];
+        ++bucket.histogram[entry.bin];
+        ++bucket.count;
+        bucket.momentNm += entry.momentNm;
+    }
+    ++series.eventCount;
+    m_entries.insert(key, entry);
+}
+
+void SeismicityStatistics::removeLocked(const QString &key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) return;
+    const Entry entry = *it;
+    m_entries.erase(it);
+
+    auto cell = m_cells.find(entry.cell);
+    if (cell == m_cells.end()) return;
+    if (--cell->eventCount == 0) {
+        m_cells.erase(cell);
+        QVector<int> &columns = m_rowColumns[entry.cell / GRID_COLUMNS];
+        columns.erase(std::lower_bound(columns.begin(), columns.end(), entry.cell % GRID_COLUMNS));
+        return;
+    }
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        QHash<qint64, Bucket> &buckets = cell->levels[level];
+        auto bucket = buckets.find(floorDiv(entry.hour, LEVEL_SPAN_HOURS[level]));
+        if (bucket == buckets.end()) continue;
+        if (--bucket->count == 0) {
+            buckets.erase(bucket);
+            continue;
+        }
+        --bucket->histogram[entry.bin];
+        bucket->momentNm = qMax(0.0, bucket->momentNm - entry.momentNm);
+    }
+}
+
+void SeismicityStatistics::forEachCellLocked(const Window &window,
+                                             const std::function<void(const CellSeries &)> &visit) const
+{
+    if (m_rowColumns.isEmpty()) return;
+
+    // Cells whose south edge is at or below maxLatitude and whose north edge
+    // is above minLatitude; likewise for west and east
+    const double size = CELL_SIZE_DEGREES;
+    const int firstRow = int(qMax(0.0, std::floor((window.minLatitude + 90.0) / size)));
+    const int lastRow = int(qMin(double(GRID_ROWS - 1), std::floor((window.maxLatitude + 90.0) / size)));
+    const double westColumn = std::floor((window.minLongitude + 180.0) / size);
+    const double eastColumn = std::floor((window.maxLongitude + 180.0) / size);
+
+    // One column range, or two across the antimeridian
+    int ranges[2][2];
+    int rangeCount = 0;
+    if (window.minLongitude <= window.maxLongitude) {
+        ranges[rangeCount][0] = int(qMax(0.0, westColumn));
+        ranges[rangeCount++][1] = int(qMin(double(GRID_COLUMNS - 1), eastColumn));
+    } else if (eastColumn >= westColumn) {
+        ranges[rangeCount][0] = 0; // Both ends in one cell: every column
+        ranges[rangeCount++][1] = GRID_COLUMNS - 1;
+    } else {
+        ranges[rangeCount][0] = 0;
+        ranges[rangeCount++][1] = int(qMin(double(GRID_COLUMNS - 1), eastColumn));
+        ranges[rangeCount][0] = int(qMax(0.0, westColumn));
+        ranges[rangeCount++][1] = GRID_COLUMNS - 1;
+    }
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        const QVector<int> &columns = m_rowColumns[row];
+        if (columns.isEmpty()) continue;
+        for (int r = 0; r < rangeCount; ++r) {
+            for (auto column = std::lower_bound(columns.cbegin(), columns.cend(), ranges[r][0]);
+                 column != columns.cend() && *column <= ranges[r][1]; ++column) {
+                visit(m_cells.constFind(row * GRID_COLUMNS + *column).value());
+            }
+        }
+    }
+}
+
+SeismicityStatistics::Bucket SeismicityStatistics::collectLocked(const Window &window) const
+{
+    Bucket sum;
+    const qint64 startHour = floorDiv(window.startMs, HOUR_MS);
+    const qint64 endHour = -floorDiv(-window.endMs, HOUR_MS);
+    if (endHour <= startHour) return sum;
+
+    forEachCellLocked(window, [&](const CellSeries &series) {
+        collectCell(series, startHour, endHour, sum);
+    });
+    return sum;
+}
+
+void SeismicityStatistics::collectCell(const CellSeries &series, qint64 startHour, qint64 endHour, Bucket &sum)
+{
+    // Greedy cover: the coarsest aligned bucket that starts here and fits
+    for (qint64 hour = startHour; hour < endHour;) {
+        int level = LEVEL_COUNT - 1;
+        while (level > 0 && (floorDiv(hour, LEVEL_SPAN_HOURS[level]) * LEVEL_SPAN_HOURS[level] != hour
+                             || hour + LEVEL_SPAN_HOURS[level] > endHour)) {
+            --level;
+        }
+
+        const QHash<qint64, Bucket> &buckets = series.levels[level];
+        auto bucket = buckets.constFind(floorDiv(hour, LEVEL_SPAN_HOURS[level]));
+        if (bucket != buckets.cend()) {
+            for (int bin = 0; bin < MAGNITUDE_BINS; ++bin) {
+                sum.histogram[bin] += bucket->histogram[bin];
+            }
+            sum.count += bucket->count;
+            sum.momentNm += bucket->momentNm;
+        }
+        hour += LEVEL_SPAN_HOURS[level];
+    }
+}
+
+QVector<int> SeismicityStatistics::hourlyCountsLocked(const Window &window, qint64 startHour, qint64 endHour,
+                                                       int minBin) const
+{
+    QVector<int> counts(int(endHour - startHour), 0);
+    forEachCellLocked(window, [&](const CellSeries &series) {
+        // Walk whichever is smaller: the window's hours or the cell's buckets
+        const QHash<qint64, Bucket> &hours = series.levels[0];
+        auto addBucket = [&](qint64 hour, const Bucket &bucket) {
+            for (int bin = minBin; bin < MAGNITUDE_BINS; ++bin) {
+                counts[int(hour - startHour)] += int(bucket.histogram[bin]);
+            }
+        };
+        if (hours.size() < counts.size()) {
+            for (auto bucket = hours.cbegin(); bucket != hours.cend(); ++bucket) {
+                if (bucket.key() >= startHour && bucket.key() < endHour) addBucket(bucket.key(), bucket.value());
+            }
+        } else {
+            for (qint64 hour = startHour; hour < endHour; ++hour) {
+                auto bucket = hours.constFind(hour);
+                if (bucket != hours.cend()) addBucket(hour, bucket.value());
+            }
+        }
+    });
+    return counts;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "earthquake_data.hpp"
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <array>
+#include <functional>
+#include <limits>
+
+
+// Catalog statistics over arbitrary space/time windows: Gutenberg-Richter
+// b-value with magnitude of completeness, Omori-Utsu aftershock decay and
+// seismic moment release.
+//
+// Events are binned by 1-degree cell and hour. Each cell keeps sufficient
+// statistics (a 0.1-unit magnitude histogram, event count and moment sum)
+// per bucket at four nested time resolutions: hour, day, 32 days and 512
+// days. A query covers its time range with the coarsest buckets that fit,
+// at most a few dozen per level. Occupied cells are indexed by grid row and
+// column, so a query visits only the occupied cells inside its window; its
+// cost depends on those and not on the rest of the map or on how much
+// history is stored.
+// Adding, revising or removing an event touches one bucket per level.
+//
+// Windows are widened to whole cells and hours. Magnitudes are treated as
+// moment magnitudes. Thread-safe.
+class SeismicityStatistics
+{
+public:
+    // Latitude/longitude bounds in degrees (minLongitude > maxLongitude
+    // crosses the antimeridian) and the time range [startMs, endMs)
+    struct Window {
+        double minLatitude = -90.0;
+        double maxLatitude = 90.0;
+        double minLongitude = -180.0;
+        double maxLongitude = 180.0;
+        qint64 startMs = 0;
+        qint64 endMs = 0;
+    };
+
+    struct GutenbergRichter {
+        bool valid = false;
+        int eventCount = 0;       // All events in the window
+        int completeCount = 0;    // Events at or above the completeness magnitude
+        double completeness = 0.0; // Mc
+        double aValue = 0.0;      // log10 N(M >= 0), extrapolated
+        double bValue = 0.0;      // Aki-Utsu maximum likelihood
+        double bError = 0.0;      // Shi & Bolt standard error
+    };
+
+    // n(t) = K / (c + t)^p, t in days after the mainshock
+    struct OmoriUtsu {
+        bool valid = false;
+        int eventCount = 0;
+        double k = 0.0;          // Events per day at t = 1 - c
+        double cDays = 0.0;
+        double p = 0.0;
+        double logLikelihood = 0.0;
+    };
+
+    struct MomentRelease {
+        int eventCount = 0;
+        double momentNm = 0.0;
+        double equivalentMagnitude = 0.0; // Mw of a single event releasing momentNm
+    };
+
+    static const int MAGNITUDE_BINS = 111; // M -1.0 to 9.9
+
+    SeismicityStatistics() = default;
+
+    // A known event (by SeenEventSet::keyOf) replaces its previous revision
+    void add(const EarthquakeData &earthquake);
+    void add(const QVector<EarthquakeData> &earthquakes);
+    bool remove(const QString &eventKey);
+    void clear();
+    int size() const;
+
+    // Counts per magnitude bin from MIN_MAGNITUDE in MAGNITUDE_BIN_WIDTH steps
+    std::array<int, MAGNITUDE_BINS> magnitudeHistogram(const Window &window) const;
+
+    // Mc by maximum curvature plus MAXC_CORRECTION unless completeness is given
+    GutenbergRichter gutenbergRichter(const Window &window,
+                                      double completeness = std::numeric_limits<double>::quiet_NaN()) const;
+
+    // Aftershocks of a mainshock at window.startMs, fitted over hourly counts
+    // from the first full hour after it. Events below minMagnitude are
+    // ignored; by default that is the window's Mc.
+    OmoriUtsu omoriUtsu(const Window &window,
+                        double minMagnitude = std::numeric_limits<double>::quiet_NaN()) const;
+
+    MomentRelease momentRelease(const Window &window) const;
+
+    // Hanks-Kanamori: M0 = 10^(1.5 Mw + 9.1) N m
+    static double seismicMoment(double magnitude);
+    static double momentMagnitude(double momentNm);
+
+    static const double CELL_SIZE_DEGREES;
+    static const double MIN_MAGNITUDE;
+    static const double MAGNITUDE_BIN_WIDTH;
+    static const double MAXC_CORRECTION;
+    static const int MIN_EVENTS_FOR_B_VALUE;
+    static const int MIN_EVENTS_FOR_OMORI;
+
+private:
+    static const int LEVEL_COUNT = 4;
+
+    struct Bucket {
+        std::array<quint32, MAGNITUDE_BINS> histogram{};
+        int count = 0;
+        double momentNm = 0.0;
+    };
+
+    struct CellSeries {
+        QHash<qint64, Bucket> levels[LEVEL_COUNT]; // Bucket index -> bucket, per resolution
+        int eventCount = 0;
+    };
+
+    struct Entry {
+        int cell;
+        qint64 hour;
+        int bin;
+        double momentNm;
+    };
+
+    void addLocked(const QString &key, const Entry &entry);
+    void removeLocked(const QString &key);
+    // Calls visit for every occupied cell in the window, walking the window's
+    // rows and, in each, the occupied columns within its longitude range
+    void forEachCellLocked(const Window &window, const std::function<void(const CellSeries &)> &visit) const;
+    // Sums the buckets of every occupied cell in the window
+    Bucket collectLocked(const Window &window) const;
+    static void collectCell(const CellSeries &series, qint64 startHour, qint64 endHour, Bucket &sum);
+    // Events at or above minBin per hour of [startHour, endHour)
+    QVector<int> hourlyCountsLocked(const Window &window, qint64 startHour, qint64 endHour, int minBin) const;
+
+    mutable QMutex m_mutex;
+    QHash<int, CellSeries> m_cells;
+    QVector<QVector<int>> m_rowColumns; // Occupied columns per grid row, ascending
+    QHash<QString, Entry> m_entries;
+};
@@ -0,0 +1,212 @@
+#include "sound_bank.hpp"
+
+#include <QDebug>
+
+// Constants
+const int SoundBank::VOICES_PER_SOUND = 2;
+const int SoundBank::MAX_ACTIVE_VOICES = 4;
+
+
+SoundBank::SoundBank(QObject *parent)
+    : QObject(parent)
+    , m_preview(nullptr)
+    , m_playSequence(0)
+{
+}
+
+void SoundBank::setSource(SoundType type, const QString &path)
+{
+    if (type == SoundType::None || m_sources.value(type) == path) {
+        return;
+    }
+    m_sources.insert(type, path);
+
+    // Drop the old voices of this type
+    for (int i = m_voices.size() - 1; i >= 0; --i) {
+        if (m_voices[i].type == type) {
+            QSoundEffect *effect = m_voices[i].effect;
+            effect->disconnect(this);
+            effect->stop();
+            effect->deleteLater();
+            m_voices.removeAt(i);
+        }
+    }
+    if (path.isEmpty()) return;
+
+    const QUrl url = sourceUrl(path);
+    for (int i = 0; i < VOICES_PER_SOUND; ++i) {
+        auto *effect = new QSoundEffect(this);
+        effect->setSource(url);
+
+        connect(effect, &QSoundEffect::playingChanged, this, [this, effect]() {
+            if (effect->isPlaying()) return;
+            for (Voice &voice : m_voices) {
+                if (voice.effect == effect) voice.active = false;
+            }
+        });
+        if (i == 0) {
+            connect(effect, &QSoundEffect::statusChanged, this, [this, effect, type, path]() {
+                if (effect->status() == QSoundEffect::Error) {
+                    qWarning() << "Failed to load sound:" << path;
+                    emit loadFailed(type, path);
+                }
+            });
+        }
+        m_voices.append(Voice{effect, type, NotificationPriority::Low, 0, false});
+    }
+}
+
+bool SoundBank::isReady(SoundType type) const
+{
+    for (const Voice &voice : m_voices) {
+        if (voice.type == type && voice.effect->isLoaded()) return true;
+    }
+    return false;
+}
+
+bool SoundBank::play(SoundType type, NotificationPriority priority, float volume)
+{
+    if (type == SoundType::None) return false;
+    if (!isReady(type)) {
+        if (type == SoundType::Alert || !isReady(SoundType::Alert)) return false;
+        type = SoundType::Alert;
+    }
+
+    const int index = findVoice(type, priority);
+    if (index < 0) {
+        qDebug() << "All alert voices are busy with higher priority sounds";
+        return false;
+    }
+
+    Voice &voice = m_voices[index];
+    voice.priority = priority;
+    voice.startedAt = ++m_playSequence;
+    voice.active = true;
+    voice.effect->setVolume(volume);
+    voice.effect->play();
+    return true;
+}
+
+bool SoundBank::playPreview(const QString &path, float volume)
+{
+    if (path.isEmpty()) return false;
+
+    if (!m_preview) {
+        m_preview = new QSoundEffect(this);
+        connect(m_preview, &QSoundEffect::statusChanged, this, [this]() {
+            if (m_preview->status() == QSoundEffect::Error) {
+                qWarning() << "Failed to load sound preview:" << m_preview->source().toString();
+            }
+        });
+    }
+
+    const QUrl url = sourceUrl(path);
+    if (m_preview->source() != url) {
+        m_preview->stop();
+        m_preview->setSource(url); // play() below starts it once decoded
+    }
+    m_preview->setVolume(volume);
+    m_preview->play();
+    return true;
+}
+
+QUrl SoundBank::previewSource() const
+{
+    return m_preview ? m_preview->source() : QUrl();
+}
+
+void SoundBank::stopAll()
+{
+    for (Voice &voice : m_voices) {
+        stopVoice(voice);
+    }
+    if (m_preview) {
+        m_preview->stop();
+    }
+}
+
+int SoundBank::activeVoiceCount() const
+{
+    int count = 0;
+    for (const Voice &voice : m_voices) {
+        if (voice.active) count++;
+    }
+    return count;
+}
+
+QUrl SoundBank::sourceUrl(const QString &path)
+{
+    if (path.startsWith(":/")) return QUrl("qrc" + path);
+    if (path.startsWith("qrc:")) return QUrl(path);
+    return QUrl::fromLocalFile(path);
+}
+
+int SoundBank::findVoice(SoundType type, NotificationPriority priority)
+{
+    QVector<VoiceState> states;
+    states.reserve(m_voices.size());
+    for (const Voice &voice : m_voices) {
+        states.append(VoiceState{voice.type, voice.priority, voice.startedAt, voice.active, voice.effect->isLoaded()});
+    }
+
+    int victim = -1;
+    const int index = selectVoice(states, type, priority, &victim);
+    if (victim >= 0) {
+        stopVoice(m_voices[victim]);
+    }
+    return index;
+}
+
+int SoundBank::selectVoice(const QVector<VoiceState> &voices, SoundType type,
+                           NotificationPriority priority, int *victim)
+{
+    *victim = -1;
+    int idle = -1;
+    int active = 0;
+    for (int i = 0; i < voices.size(); ++i) {
+        if (voices[i].active) {
+            active++;
+        } else if (idle < 0 && voices[i].type == type && voices[i].loaded) {
+            idle = i;
+        }
+    }
+    if (idle >= 0 && active < MAX_ACTIVE_VOICES) return idle;
+
+    // One playing voice goes. With an idle voice of this type it only has to
+    // free a mixer slot, so any type will do; otherwise it must be of this
+    // type to leave a voice to play on. A stolen voice of this type is reused.
+    const int lowest = lowestPriorityVoice(voices, idle < 0, type);
+    if (lowest < 0 || voices[lowest].priority > priority) return -1;
+    *victim = lowest;
+    return voices[lowest].type == type ? lowest : idle;
+}
+
+int SoundBank::lowestPriorityVoice(const QVector<VoiceState> &voices, bool sameTypeOnly, SoundType type)
+{
+    // Lowest priority, then of this type, then oldest
+    int lowest = -1;
+    for (int i = 0; i < voices.size(); ++i) {
+        const VoiceState &voice = voices[i];
+        if (!voice.active || (sameTypeOnly && voice.type != type)) continue;
+        if (lowest < 0) {
+            lowest = i;
+            continue;
+        }
+
+        const VoiceState &current = voices[lowest];
+        if (voice.priority != current.priority) {
+            if (voice.priority < current.priority) lowest = i;
+        } else if ((voice.type == type) != (current.type == type)) {
+            if (voice.type == type) lowest = i;
+        } else if (voice.startedAt < current.startedAt) {
+            lowest = i;
+        }
+    }
+    return lowest;
+}
+
+void SoundBank::stopVoice(Voice &voice)
+{
+    voice.effect->stop();
+    voice.active = false;
+}
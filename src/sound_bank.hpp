@@ -0,0 +1,80 @@
+#pragma once
+
+#include "notification_types.hpp"
+
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QUrl>
+#include <QVector>
+#include <QtMultimedia/QSoundEffect>
+
+
+// Preloaded alert sounds. Each sound type gets a few QSoundEffect voices
+// whose samples are decoded when the source is set, so play() only starts
+// a ready voice. Voices of one source share the decoded sample, and a
+// second alert plays alongside the first instead of cutting it off. When
+// MAX_ACTIVE_VOICES are busy, or all voices of the type are, exactly one
+// playing voice is stolen: the one with the lowest priority, of the same
+// type on ties, oldest first, and never one with a higher priority than the
+// new sound.
+class SoundBank : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SoundBank(QObject *parent = nullptr);
+
+    // Starts decoding now; the same path again is a no-op
+    void setSource(SoundType type, const QString &path);
+    QString source(SoundType type) const { return m_sources.value(type); }
+    bool isReady(SoundType type) const;
+
+    // Types that are not ready play the Alert sound. False if nothing could play.
+    bool play(SoundType type, NotificationPriority priority, float volume);
+    // Plays a file on a voice of its own, e.g. to try a sound before choosing
+    // it; the typed sources are left alone and the voice budget does not apply
+    bool playPreview(const QString &path, float volume);
+    QUrl previewSource() const;
+    void stopAll();
+    int activeVoiceCount() const;
+
+    struct VoiceState {
+        SoundType type;
+        NotificationPriority priority;
+        quint64 startedAt;
+        bool active;
+        bool loaded;
+    };
+
+    // The voice to play a sound of this type on, or -1. Sets *victim to the
+    // playing voice to stop first, or -1.
+    static int selectVoice(const QVector<VoiceState> &voices, SoundType type,
+                           NotificationPriority priority, int *victim);
+
+    // ":/x" and "qrc:/x" are resources; anything else is a local file
+    static QUrl sourceUrl(const QString &path);
+
+    static const int VOICES_PER_SOUND;
+    static const int MAX_ACTIVE_VOICES;
+
+signals:
+    void loadFailed(SoundType type, const QString &path);
+
+private:
+    struct Voice {
+        QSoundEffect *effect;
+        SoundType type;
+        NotificationPriority priority;
+        quint64 startedAt; // Play sequence number
+        bool active;
+    };
+
+    int findVoice(SoundType type, NotificationPriority priority);
+    static int lowestPriorityVoice(const QVector<VoiceState> &voices, bool sameTypeOnly, SoundType type);
+    void stopVoice(Voice &voice);
+
+    QVector<Voice> m_voices;
+    QSoundEffect *m_preview;
+    QMap<SoundType, QString> m_sources;
+    quint64 m_playSequence;
+};
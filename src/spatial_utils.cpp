@@ -1,11 +1,95 @@
 #include "spatial_utils.hpp"
+#include "earthquake_data.hpp"
+#include "ground_motion.hpp"
+#include "travel_times.hpp"
 #include <QtCore/QDebug>
 #include <algorithm>
+#include <numeric>
 
 const double SpatialUtils::EARTH_RADIUS_KM = 6371.0;
+const double SpatialUtils::WGS84_SEMI_MAJOR_AXIS_KM = 6378.137;
+const double SpatialUtils::WGS84_FLATTENING = 1.0 / 298.257223563;
+// Haversine with EARTH_RADIUS_KM is within -0.45%..+0.56% of the geodesic
+const double SpatialUtils::SPHERICAL_DISTANCE_TOLERANCE = 0.006;
 const double SpatialUtils::P_WAVE_SPEED_KM_S = 6.0;
 const double SpatialUtils::S_WAVE_SPEED_KM_S = 3.5;
 
+namespace {
+
+// Distance and longitude integrals of a geodesic between sigma1 and sigma2
+// on the auxiliary sphere (Karney 2013, eqs. 7 and 8), by composite Simpson.
+// Both integrands are smooth and within 0.7% of constant, so 512 intervals
+// are accurate to well under a millimeter.
+void geodesicIntegrals(double sigma1, double sigma2, double kSq, double f, double &distance, double &longitude)
+{
+    const int intervals = 512;
+    const double h = (sigma2 - sigma1) / intervals;
+    double distanceSum = 0.0;
+    double longitudeSum = 0.0;
+    for (int i = 0; i <= intervals; ++i) {
+        const double sinSigma = sin(sigma1 + i * h);
+        const double root = sqrt(1.0 + kSq * sinSigma * sinSigma);
+        const double weight = (i == 0 || i == intervals) ? 1.0 : (i % 2 ? 4.0 : 2.0);
+        distanceSum += weight * root;
+        longitudeSum += weight * (2.0 - f) / (1.0 + (1.0 - f) * root);
+    }
+    distance = distanceSum * h / 3.0;
+    longitude = longitudeSum * h / 3.0;
+}
+
+// Inverse problem for the nearly antipodal points where Vincenty's iteration
+// does not converge. With the points ordered so that beta1 <= -|beta2|, the
+// longitude the geodesic covers grows monotonically with the start azimuth
+// from 0 (due north) to pi (due south, over the pole), so bisection on the
+// azimuth always finds the geodesic.
+double nearlyAntipodalGeodesic(double lat1, double lon1, double lat2, double lon2, double a, double f)
+{
+    const double b = a * (1.0 - f);
+    const double secondEccentricitySq = f * (2.0 - f) / ((1.0 - f) * (1.0 - f));
+    const double lambda12 = qAbs(std::remainder(lon2 - lon1, 360.0)) * M_PI / 180.0;
+    double beta1 = atan((1.0 - f) * tan(lat1 * M_PI / 180.0));
+    double beta2 = atan((1.0 - f) * tan(lat2 * M_PI / 180.0));
+    if (qAbs(beta1) < qAbs(beta2)) std::swap(beta1, beta2);
+    if (beta1 > 0.0) {
+        beta1 = -beta1;
+        beta2 = -beta2;
+    }
+    // On the equator the crossing of beta2 is ambiguous; start just south of it
+    if (beta1 == 0.0) beta1 = -1e-12;
+    const double sinBeta1 = sin(beta1), cosBeta1 = cos(beta1);
+    const double sinBeta2 = sin(beta2), cosBeta2 = cos(beta2);
+
+    double low = 0.0;
+    double high = M_PI;
+    double distance = 0.0;
+    for (int iteration = 0; iteration < 64; ++iteration) {
+        const double alpha1 = 0.5 * (low + high);
+        const double sinAlpha1 = sin(alpha1), cosAlpha1 = cos(alpha1);
+        const double sinAlpha0 = sinAlpha1 * cosBeta1; // Clairaut
+        const double cosSqAlpha0 = 1.0 - sinAlpha0 * sinAlpha0;
+        // cos(alpha2) cos(beta2) where the geodesic crosses beta2 heading north
+        const double x2 = sqrt(qMax(0.0, cosAlpha1 * cosAlpha1 * cosBeta1 * cosBeta1
+                                         + cosBeta2 * cosBeta2 - cosBeta1 * cosBeta1));
+        const double sigma1 = atan2(sinBeta1, cosAlpha1 * cosBeta1);
+        const double sigma2 = atan2(sinBeta2, x2);
+        const double omega1 = atan2(sinAlpha0 * sinBeta1, cosAlpha1 * cosBeta1);
+        const double omega2 = atan2(sinAlpha0 * sinBeta2, x2);
+
+        double distanceIntegral, longitudeIntegral;
+        geodesicIntegrals(sigma1, sigma2, secondEccentricitySq * cosSqAlpha0, f, distanceIntegral, longitudeIntegral);
+        distance = b * distanceIntegral;
+        const double lambda = (omega2 - omega1) - f * sinAlpha0 * longitudeIntegral;
+        if (lambda < lambda12) {
+            low = alpha1;
+        } else {
+            high = alpha1;
+        }
+    }
+    return distance;
+}
+
+} // namespace
+
 double SpatialUtils::haversineDistance(double lat1, double lon1, double lat2, double lon2)
 {
     double lat1Rad = lat1 * M_PI / 180.0;
@@ -23,6 +107,73 @@ double SpatialUtils::haversineDistance(double lat1, double lon1, double lat2, do
     return EARTH_RADIUS_KM * c;
 }
 
+double SpatialUtils::geodesicDistance(double lat1, double lon1, double lat2, double lon2)
+{
+    const double a = WGS84_SEMI_MAJOR_AXIS_KM;
+    const double f = WGS84_FLATTENING;
+    const double b = a * (1.0 - f);
+    
+    // Reduced latitudes; L is the longitude difference on the auxiliary sphere's start
+    const double L = std::remainder(lon2 - lon1, 360.0) * M_PI / 180.0;
+    const double U1 = atan((1.0 - f) * tan(lat1 * M_PI / 180.0));
+    const double U2 = atan((1.0 - f) * tan(lat2 * M_PI / 180.0));
+    const double sinU1 = sin(U1), cosU1 = cos(U1);
+    const double sinU2 = sin(U2), cosU2 = cos(U2);
+    
+    double lambda = L;
+    double sinSigma = 0.0, cosSigma = 0.0, sigma = 0.0, cosSqAlpha = 0.0, cos2SigmaM = 0.0;
+    for (int iteration = 0; ; ++iteration) {
+        const double sinLambda = sin(lambda);
+        const double cosLambda = cos(lambda);
+        const double t = cosU1 * sinU2 - sinU1 * cosU2 * cosLambda;
+        sinSigma = sqrt(cosU2 * sinLambda * cosU2 * sinLambda + t * t);
+        if (sinSigma == 0.0) {
+            return 0.0; // Coincident points
+        }
+        cosSigma = sinU1 * sinU2 + cosU1 * cosU2 * cosLambda;
+        sigma = atan2(sinSigma, cosSigma);
+        const double sinAlpha = cosU1 * cosU2 * sinLambda / sinSigma;
+        cosSqAlpha = 1.0 - sinAlpha * sinAlpha;
+        cos2SigmaM = cosSqAlpha != 0.0 ? cosSigma - 2.0 * sinU1 * sinU2 / cosSqAlpha : 0.0; // Equatorial line
+        
+        const double C = f / 16.0 * cosSqAlpha * (4.0 + f * (4.0 - 3.0 * cosSqAlpha));
+        const double previous = lambda;
+        lambda = L + (1.0 - C) * f * sinAlpha
+                 * (sigma + C * sinSigma * (cos2SigmaM + C * cosSigma * (-1.0 + 2.0 * cos2SigmaM * cos2SigmaM)));
+        if (qAbs(lambda - previous) <= 1e-12) break;
+        if (iteration == 200) {
+            // Nearly antipodal points, where the iteration does not converge.
+            // Radii can span the globe, so solve these exactly instead.
+            return nearlyAntipodalGeodesic(lat1, lon1, lat2, lon2, a, f);
+        }
+    }
+    
+    const double uSq = cosSqAlpha * (a * a - b * b) / (b * b);
+    const double A = 1.0 + uSq / 16384.0 * (4096.0 + uSq * (-768.0 + uSq * (320.0 - 175.0 * uSq)));
+    const double B = uSq / 1024.0 * (256.0 + uSq * (-128.0 + uSq * (74.0 - 47.0 * uSq)));
+    const double deltaSigma = B * sinSigma
+        * (cos2SigmaM + B / 4.0 * (cosSigma * (-1.0 + 2.0 * cos2SigmaM * cos2SigmaM)
+                                   - B / 6.0 * cos2SigmaM * (-3.0 + 4.0 * sinSigma * sinSigma)
+                                     * (-3.0 + 4.0 * cos2SigmaM * cos2SigmaM)));
+    return b * A * (sigma - deltaSigma);
+}
+
+bool SpatialUtils::isWithinDistance(double lat1, double lon1, double lat2, double lon2, double radiusKm)
+{
+    const double spherical = haversineDistance(lat1, lon1, lat2, lon2);
+    if (spherical <= radiusKm * (1.0 - SPHERICAL_DISTANCE_TOLERANCE)) return true;
+    if (spherical > radiusKm * (1.0 + SPHERICAL_DISTANCE_TOLERANCE)) return false;
+    return geodesicDistance(lat1, lon1, lat2, lon2) <= radiusKm;
+}
+
+void SpatialUtils::sphericalCapBounds(double radiusKm, double &cosInner, double &cosOuter)
+{
+    const double inner = radiusKm * (1.0 - SPHERICAL_DISTANCE_TOLERANCE) / EARTH_RADIUS_KM;
+    const double outer = radiusKm * (1.0 + SPHERICAL_DISTANCE_TOLERANCE) / EARTH_RADIUS_KM;
+    cosInner = cos(qBound(0.0, inner, M_PI));
+    cosOuter = cos(qBound(0.0, outer, M_PI));
+}
+
 double SpatialUtils::euclideanDistance(const QPointF &p1, const QPointF &p2)
 {
     double dx = p2.x() - p1.x();
@@ -86,6 +237,28 @@ QPointF SpatialUtils::calculateDestination(double lat, double lon, double bearin
     return QPointF(lat2 * 180.0 / M_PI, normalizeLongitude(lon2 * 180.0 / M_PI));
 }
 
+QPointF SpatialUtils::interpolateGreatCircle(double lat1, double lon1, double lat2, double lon2, double fraction)
+{
+    const double phi1 = lat1 * M_PI / 180.0;
+    const double phi2 = lat2 * M_PI / 180.0;
+    const double lambda1 = lon1 * M_PI / 180.0;
+    const double lambda2 = lon2 * M_PI / 180.0;
+    const double angle = haversineDistance(lat1, lon1, lat2, lon2) / EARTH_RADIUS_KM;
+    const double sinAngle = sin(angle);
+    if (sinAngle < 1e-12) {
+        return fraction < 0.5 ? QPointF(lat1, lon1) : QPointF(lat2, lon2);
+    }
+
+    // Spherical linear interpolation between the two unit vectors
+    const double a = sin((1.0 - fraction) * angle) / sinAngle;
+    const double b = sin(fraction * angle) / sinAngle;
+    const double x = a * cos(phi1) * cos(lambda1) + b * cos(phi2) * cos(lambda2);
+    const double y = a * cos(phi1) * sin(lambda1) + b * cos(phi2) * sin(lambda2);
+    const double z = a * sin(phi1) + b * sin(phi2);
+
+    return QPointF(atan2(z, hypot(x, y)) * 180.0 / M_PI, atan2(y, x) * 180.0 / M_PI);
+}
+
 bool SpatialUtils::isPointInPolygon(const QPointF &point, const QVector<QPointF> &polygon)
 {
     bool inside = false;
@@ -134,13 +307,89 @@ QPointF SpatialUtils::polygonCentroid(const QVector<QPointF> &polygon)
     return QPointF(cx, cy);
 }
 
-double SpatialUtils::estimateShakeIntensity(double magnitude, double distance)
+void EcefPoints::reserve(int size)
+{
+    x.reserve(size);
+    y.reserve(size);
+    z.reserve(size);
+}
+
+void EcefPoints::append(const EcefPoint &point)
 {
-    // Simplified intensity estimation based on magnitude and distance
-    if (distance <= 0.0) return magnitude;
+    x.append(point.x);
+    y.append(point.y);
+    z.append(point.z);
+}
+
+EcefPoint SpatialUtils::toEcef(double lat, double lon, double depthKm)
+{
+    const double latRad = lat * M_PI / 180.0;
+    const double lonRad = lon * M_PI / 180.0;
+    const double r = EARTH_RADIUS_KM - depthKm;
     
-    double intensity = magnitude - 3.0 * log10(distance) + 2.0;
-    return qMax(0.0, intensity);
+    return EcefPoint{r * cos(latRad) * cos(lonRad), r * cos(latRad) * sin(lonRad), r * sin(latRad)};
+}
+
+EcefPoints SpatialUtils::toEcef(const QVector<EarthquakeData> &earthquakes)
+{
+    EcefPoints points;
+    points.reserve(earthquakes.size());
+    for (const EarthquakeData &eq : earthquakes) {
+        points.append(toEcef(eq.latitude, eq.longitude, eq.depth));
+    }
+    return points;
+}
+
+double SpatialUtils::distance3D(const EcefPoint &a, const EcefPoint &b)
+{
+    const double dx = a.x - b.x;
+    const double dy = a.y - b.y;
+    const double dz = a.z - b.z;
+    return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+double SpatialUtils::hypocentralDistance(double epicentralKm, double depthKm)
+{
+    // Law of cosines in the plane of the epicenter, the site and the Earth's
+    // center, with cos(theta) = 1 - 2 sin^2(theta / 2)
+    const double s = sin(epicentralKm / (2.0 * EARTH_RADIUS_KM));
+    const double innerRadius = qMax(0.0, EARTH_RADIUS_KM - depthKm);
+    return sqrt(depthKm * depthKm + 4.0 * EARTH_RADIUS_KM * innerRadius * s * s);
+}
+
+double SpatialUtils::hypocentralSeparation(double lat1, double lon1, double depth1Km,
+                                           double lat2, double lon2, double depth2Km)
+{
+    return distance3D(toEcef(lat1, lon1, depth1Km), toEcef(lat2, lon2, depth2Km));
+}
+
+void SpatialUtils::squaredDistances3D(const EcefPoint &from, const EcefPoints &points, int first, int last, double *out)
+{
+    const double *x = points.x.constData();
+    const double *y = points.y.constData();
+    const double *z = points.z.constData();
+    for (int i = first; i < last; ++i) {
+        const double dx = x[i] - from.x;
+        const double dy = y[i] - from.y;
+        const double dz = z[i] - from.z;
+        out[i - first] = dx * dx + dy * dy + dz * dz;
+    }
+}
+
+void SpatialUtils::distances3D(const EcefPoint &from, const EcefPoints &points, QVector<double> &out)
+{
+    out.resize(points.size());
+    double *d = out.data();
+    squaredDistances3D(from, points, 0, points.size(), d);
+    for (int i = 0; i < points.size(); ++i) {
+        d[i] = sqrt(d[i]);
+    }
+}
+
+double SpatialUtils::estimateShakeIntensity(double magnitude, double distance)
+{
+    // Distance is hypocentral; see GroundMotionModel
+    return GroundMotionModel::intensity(magnitude, distance);
 }
 
 double SpatialUtils::calculateSeismicEnergy(double magnitude)
@@ -151,26 +400,13 @@ double SpatialUtils::calculateSeismicEnergy(double magnitude)
 
 int SpatialUtils::mercalliIntensity(double magnitude, double distance)
 {
-    double intensity = estimateShakeIntensity(magnitude, distance);
-    
-    if (intensity < 2.0) return 1;      // I - Not felt
-    else if (intensity < 3.0) return 2; // II - Weak
-    else if (intensity < 4.0) return 3; // III - Weak
-    else if (intensity < 5.0) return 4; // IV - Light
-    else if (intensity < 6.0) return 5; // V - Moderate
-    else if (intensity < 7.0) return 6; // VI - Strong
-    else if (intensity < 8.0) return 7; // VII - Very strong
-    else if (intensity < 9.0) return 8; // VIII - Severe
-    else if (intensity < 10.0) return 9; // IX - Violent
-    else if (intensity < 11.0) return 10; // X - Extreme
-    else if (intensity < 12.0) return 11; // XI - Extreme
-    else return 12;                     // XII - Extreme
+    return GroundMotionModel::mercalliClass(estimateShakeIntensity(magnitude, distance));
 }
 
-double SpatialUtils::estimateArrivalTime(double distance, bool isPWave)
+double SpatialUtils::estimateArrivalTime(double distance, bool isPWave, double depth)
 {
-    double speed = isPWave ? P_WAVE_SPEED_KM_S : S_WAVE_SPEED_KM_S;
-    return distance / speed; // Time in seconds
+    // Epicentral distance in km; seconds after origin time (iasp91)
+    return TravelTimes::travelTime(isPWave ? TravelTimes::Phase::P : TravelTimes::Phase::S, distance, depth);
 }
 
 QVector<QVector<int>> SpatialUtils::spatialClustering(const QVector<QPointF> &points, double maxDistance)
@@ -237,3 +473,59 @@ double SpatialUtils::calculateClusterRadius(const QVector<QPointF> &points, cons
     
     return maxDistance;
 }
+
+QVector<QVector<int>> SpatialUtils::hypocentralClustering(const EcefPoints &hypocenters, double maxDistanceKm)
+{
+    // Sorted by x, the neighbors of a point lie in one contiguous window
+    // [x - maxDistanceKm, x + maxDistanceKm], scanned by the batch kernel
+    const int n = hypocenters.size();
+    QVector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return hypocenters.x[a] < hypocenters.x[b]; });
+    
+    EcefPoints sorted;
+    sorted.reserve(n);
+    for (int index : order) {
+        sorted.append(hypocenters.at(index));
+    }
+    
+    const double maxSquared = maxDistanceKm * maxDistanceKm;
+    QVector<QVector<int>> clusters;
+    QVector<bool> visited(n, false);
+    QVector<double> squared;
+    
+    for (int start = 0; start < n; ++start) {
+        if (visited[start]) continue;
+        
+        QVector<int> cluster;
+        QVector<int> toCheck;
+        toCheck.append(start);
+        visited[start] = true;
+        
+        while (!toCheck.isEmpty()) {
+            const int current = toCheck.takeLast();
+            cluster.append(order[current]);
+            
+            const double cx = sorted.x[current];
+            const int first = std::lower_bound(sorted.x.cbegin(), sorted.x.cend(), cx - maxDistanceKm) - sorted.x.cbegin();
+            const int last = std::upper_bound(sorted.x.cbegin(), sorted.x.cend(), cx + maxDistanceKm) - sorted.x.cbegin();
+            squared.resize(last - first);
+            squaredDistances3D(sorted.at(current), sorted, first, last, squared.data());
+            
+            for (int i = first; i < last; ++i) {
+                if (!visited[i] && squared[i - first] <= maxSquared) {
+                    visited[i] = true;
+                    toCheck.append(i);
+                }
+            }
+        }
+        
+        std::sort(cluster.begin(), cluster.end());
+        clusters.append(cluster);
+    }
+    
+    // Same order as spatialClustering: by each cluster's first point
+    std::sort(clusters.begin(), clusters.end(),
+              [](const QVector<int> &a, const QVector<int> &b) { return a.first() < b.first(); });
+    return clusters;
+}
@@ -3,6 +3,27 @@
 #include <QtCore/QVector>
 #include <cmath>
 
+struct EarthquakeData;
+
+// Earth-centered, Earth-fixed position in km on the spherical Earth
+// (EARTH_RADIUS_KM), so it agrees with haversineDistance at the surface
+struct EcefPoint {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+};
+
+// Positions as parallel columns, the layout the batch kernels vectorize over
+struct EcefPoints {
+    QVector<double> x;
+    QVector<double> y;
+    QVector<double> z;
+
+    int size() const { return x.size(); }
+    void reserve(int size);
+    void append(const EcefPoint &point);
+    EcefPoint at(int index) const { return EcefPoint{x[index], y[index], z[index]}; }
+};
 
 class SpatialUtils
 {
@@ -10,6 +31,17 @@ public:
     // Distance calculations
     static double haversineDistance(double lat1, double lon1, double lat2, double lon2);
     static double euclideanDistance(const QPointF &p1, const QPointF &p2);
+    // On the WGS84 ellipsoid (Vincenty's inverse formula, sub-millimeter).
+    // Nearly antipodal points, where Vincenty does not converge, are solved
+    // by bisection on the start azimuth instead.
+    static double geodesicDistance(double lat1, double lon1, double lat2, double lon2);
+    // Whether the geodesic distance is at most radiusKm. Haversine decides
+    // unless it is within SPHERICAL_DISTANCE_TOLERANCE of the radius; only
+    // that thin band at the edge pays for the geodesic.
+    static bool isWithinDistance(double lat1, double lon1, double lat2, double lon2, double radiusKm);
+    // Cosines of the angles bracketing a geodesic radius on the unit sphere:
+    // a unit-vector dot product >= cosInner is inside, < cosOuter outside
+    static void sphericalCapBounds(double radiusKm, double &cosInner, double &cosOuter);
     
     // Coordinate transformations
     static QPointF mercatorProjection(double lat, double lon);
@@ -20,6 +52,10 @@ public:
     // Geometric utilities
     static double calculateBearing(double lat1, double lon1, double lat2, double lon2);
     static QPointF calculateDestination(double lat, double lon, double bearing, double distance);
+    // Point a fraction of the way along the great circle from the first point
+    // to the second, as (lat, lon) like calculateDestination. Antipodal
+    // points have no unique great circle; the result is then the nearer end.
+    static QPointF interpolateGreatCircle(double lat1, double lon1, double lat2, double lon2, double fraction);
     static bool isPointInPolygon(const QPointF &point, const QVector<QPointF> &polygon);
     static QPointF polygonCentroid(const QVector<QPointF> &polygon);
     
@@ -27,15 +63,38 @@ public:
     static double estimateShakeIntensity(double magnitude, double distance);
     static double calculateSeismicEnergy(double magnitude);
     static int mercalliIntensity(double magnitude, double distance);
-    static double estimateArrivalTime(double distance, bool isPWave = true);
+    static double estimateArrivalTime(double distance, bool isPWave = true, double depth = 0.0);
+    
+    // Depth-aware geometry: straight-line distances between points below the
+    // surface. Depths are in km, positive down.
+    static EcefPoint toEcef(double lat, double lon, double depthKm = 0.0);
+    static EcefPoints toEcef(const QVector<EarthquakeData> &earthquakes); // Hypocenters
+    static double distance3D(const EcefPoint &a, const EcefPoint &b);
+    // From a surface point epicentralKm (great circle) from the epicenter to the hypocenter
+    static double hypocentralDistance(double epicentralKm, double depthKm);
+    static double hypocentralSeparation(double lat1, double lon1, double depth1Km,
+                                        double lat2, double lon2, double depth2Km);
+    
+    // Batch kernels over points[first, last): out[i - first] = (squared)
+    // distance from `from` to points[i]. Branch-free loops over the columns,
+    // which the compiler vectorizes; the squared form needs no square root,
+    // so it vectorizes even where sqrt must set errno.
+    static void squaredDistances3D(const EcefPoint &from, const EcefPoints &points, int first, int last, double *out);
+    static void distances3D(const EcefPoint &from, const EcefPoints &points, QVector<double> &out);
     
     // Clustering and analysis
     static QVector<QVector<int>> spatialClustering(const QVector<QPointF> &points, double maxDistance);
     static QPointF calculateClusterCenter(const QVector<QPointF> &points, const QVector<int> &indices);
     static double calculateClusterRadius(const QVector<QPointF> &points, const QVector<int> &indices, const QPointF &center);
+    // Single-linkage clusters of hypocenters no more than maxDistanceKm apart in 3D, so
+    // events stacked at different depths under one epicenter stay apart
+    static QVector<QVector<int>> hypocentralClustering(const EcefPoints &hypocenters, double maxDistanceKm);
     
     // Constants
     static const double EARTH_RADIUS_KM;
+    static const double WGS84_SEMI_MAJOR_AXIS_KM;
+    static const double WGS84_FLATTENING;
+    static const double SPHERICAL_DISTANCE_TOLERANCE;
     static const double P_WAVE_SPEED_KM_S;
     static const double S_WAVE_SPEED_KM_S;
 };
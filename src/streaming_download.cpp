@@ -0,0 +1,361 @@
+#include "streaming_download.hpp"
+
+#include <QtCore/QDebug>
+#include <QtCore/QTimer>
+
+// Constants
+const qint64 StreamingDownload::DEFAULT_CHUNK_SIZE = 256 * 1024;
+const int StreamingDownload::DEFAULT_MAX_RETRIES = 5;
+const int StreamingDownload::DEFAULT_RETRY_DELAY_MS = 1000;
+const int StreamingDownload::MAX_RETRY_DELAY_MS = 30000;
+
+StreamingDownload::StreamingDownload(QNetworkAccessManager *networkManager, const QUrl &url,
+                                     const QString &targetPath, QObject *parent)
+    : QObject(parent)
+    , m_networkManager(networkManager)
+    , m_reply(nullptr)
+    , m_url(url)
+    , m_targetPath(targetPath)
+    , m_userAgent("EarthquakeAlertSystem/2.1")
+    , m_chunkSize(DEFAULT_CHUNK_SIZE)
+    , m_requestOffset(0)
+    , m_totalBytes(-1)
+    , m_headersChecked(false)
+    , m_running(false)
+    , m_maxRetries(DEFAULT_MAX_RETRIES)
+    , m_retryDelayMs(DEFAULT_RETRY_DELAY_MS)
+    , m_retryCount(0)
+    , m_resumeCount(0)
+{
+}
+
+StreamingDownload::~StreamingDownload()
+{
+    if (m_running) {
+        abort();
+    }
+}
+
+void StreamingDownload::setUserAgent(const QString &userAgent)
+{
+    m_userAgent = userAgent;
+}
+
+void StreamingDownload::setChunkSize(qint64 bytes)
+{
+    m_chunkSize = qMax<qint64>(4096, bytes);
+}
+
+void StreamingDownload::setMaxRetries(int maxRetries)
+{
+    m_maxRetries = qMax(0, maxRetries);
+}
+
+void StreamingDownload::setRetryDelay(int delayMs)
+{
+    m_retryDelayMs = qMax(0, delayMs);
+}
+
+void StreamingDownload::start()
+{
+    if (m_running) return;
+
+    m_file.setFileName(partPath());
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        fail(QString("Cannot open %1: %2").arg(partPath(), m_file.errorString()));
+        return;
+    }
+
+    m_running = true;
+    m_totalBytes = -1;
+    m_validator.clear();
+    m_retryCount = 0;
+    m_resumeCount = 0;
+    sendRequest();
+}
+
+void StreamingDownload::abort()
+{
+    m_running = false;
+
+    if (m_reply) {
+        QNetworkReply *reply = m_reply;
+        m_reply = nullptr;
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
+
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    QFile::remove(partPath());
+}
+
+QUrl StreamingDownload::url() const
+{
+    return m_url;
+}
+
+QString StreamingDownload::targetPath() const
+{
+    return m_targetPath;
+}
+
+qint64 StreamingDownload::bytesWritten() const
+{
+    return m_file.isOpen() ? m_file.size() : 0;
+}
+
+qint64 StreamingDownload::totalBytes() const
+{
+    return m_totalBytes;
+}
+
+int StreamingDownload::resumeCount() const
+{
+    return m_resumeCount;
+}
+
+bool StreamingDownload::isRunning() const
+{
+    return m_running;
+}
+
+void StreamingDownload::sendRequest()
+{
+    QNetworkRequest request(m_url);
+    request.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
+    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
+                         QNetworkRequest::NoLessSafeRedirectPolicy);
+
+    // Byte ranges must refer to what lands on disk, so ask for the identity encoding
+    request.setRawHeader("Accept-Encoding", "identity");
+
+    m_requestOffset = m_file.size();
+    if (m_requestOffset > 0) {
+        request.setRawHeader("Range", QByteArray("bytes=") + QByteArray::number(m_requestOffset) + "-");
+        if (!m_validator.isEmpty()) {
+            request.setRawHeader("If-Range", m_validator);
+        }
+    }
+
+    m_headersChecked = false;
+    m_reply = m_networkManager->get(request);
+
+    // Cap Qt's internal buffer; the socket is throttled until we drain it
+    m_reply->setReadBufferSize(m_chunkSize);
+
+    connect(m_reply, &QNetworkReply::metaDataChanged, this, &StreamingDownload::onMetaDataChanged);
+    connect(m_reply, &QNetworkReply::readyRead, this, &StreamingDownload::onReadyRead);
+    connect(m_reply, &QNetworkReply::finished, this, &StreamingDownload::onReplyFinished);
+}
+
+void StreamingDownload::onMetaDataChanged()
+{
+    if (!m_reply || m_headersChecked) return;
+
+    int status = m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 0) return; // Headers not received yet
+    m_headersChecked = true;
+
+    if (status == 206) {
+        // Content-Range: bytes <start>-<end>/<total>
+        QByteArray contentRange = m_reply->rawHeader("Content-Range");
+        qint64 start = contentRange.mid(6, contentRange.indexOf('-') - 6).trimmed().toLongLong();
+        QByteArray total = contentRange.mid(contentRange.indexOf('/') + 1).trimmed();
+        if (total != "*") {
+            m_totalBytes = total.toLongLong();
+        }
+
+        if (start != m_requestOffset) {
+            qDebug() << "Range mismatch, restarting download of" << m_url.toString();
+            QNetworkReply *reply = m_reply;
+            m_reply = nullptr;
+            reply->disconnect(this);
+            reply->abort();
+            reply->deleteLater();
+            m_file.resize(0);
+            sendRequest();
+            return;
+        }
+    } else if (status == 200) {
+        // Fresh body: either the first request, or the server ignored the range or
+        // the resource changed (If-Range mismatch)
+        if (m_requestOffset > 0) {
+            qDebug() << "Server did not honour range request, restarting from zero";
+            m_file.resize(0);
+            m_requestOffset = 0;
+        }
+
+        bool ok = false;
+        qint64 length = m_reply->header(QNetworkRequest::ContentLengthHeader).toLongLong(&ok);
+        m_totalBytes = ok ? length : -1;
+
+        m_validator = m_reply->rawHeader("ETag");
+        if (m_validator.isEmpty() || m_validator.startsWith("W/")) {
+            m_validator = m_reply->rawHeader("Last-Modified");
+        }
+    }
+
+    m_file.seek(m_file.size());
+}
+
+void StreamingDownload::onReadyRead()
+{
+    QNetworkReply *reply = m_reply;
+    if (!reply) return;
+
+    if (!m_headersChecked) {
+        onMetaDataChanged();
+        if (m_reply != reply) return; // Restarted after a range mismatch
+    }
+    drainReply();
+}
+
+bool StreamingDownload::drainReply()
+{
+    int status = m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    bool writeBody = (status == 200 || status == 206);
+
+    while (m_reply->bytesAvailable() > 0) {
+        QByteArray chunk = m_reply->read(m_chunkSize);
+        if (!writeBody) continue; // Discard error bodies
+
+        if (m_file.write(chunk) != chunk.size()) {
+            fail(QString("Write to %1 failed: %2").arg(partPath(), m_file.errorString()));
+            return false;
+        }
+    }
+
+    if (writeBody) {
+        emit progress(m_file.size(), m_totalBytes);
+    }
+    return true;
+}
+
+void StreamingDownload::onReplyFinished()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply || reply != m_reply) return;
+
+    if (!m_headersChecked) {
+        onMetaDataChanged();
+        if (m_reply != reply) return; // Restarted after a range mismatch
+    }
+    if (!drainReply()) {
+        return; // fail() released the reply
+    }
+
+    m_reply = nullptr;
+    reply->deleteLater();
+
+    if (!m_running) return; // Aborted
+
+    QNetworkReply::NetworkError error = reply->error();
+    int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    if (error == QNetworkReply::NoError) {
+        if (m_totalBytes > 0 && m_file.size() < m_totalBytes) {
+            scheduleResume("connection closed early");
+        } else {
+            complete();
+        }
+        return;
+    }
+
+    if (status == 416) {
+        // Content-Range: bytes */<total>. Nothing left to send if the part file
+        // already holds the whole resource, e.g. after a chunked body lost its end
+        QByteArray contentRange = reply->rawHeader("Content-Range");
+        qint64 total = contentRange.mid(contentRange.indexOf('/') + 1).trimmed().toLongLong();
+        if (contentRange.startsWith("bytes */") && total > 0) {
+            m_totalBytes = total;
+        }
+        if (m_totalBytes > 0 && m_file.size() == m_totalBytes) {
+            complete();
+        } else {
+            m_file.resize(0);
+            scheduleResume("range not satisfiable");
+        }
+        return;
+    }
+
+    // Client errors will not go away by retrying (except timeouts and throttling)
+    if (status >= 400 && status < 500 && status != 408 && status != 429) {
+        fail(QString("HTTP %1: %2").arg(status).arg(reply->errorString()));
+        return;
+    }
+
+    scheduleResume(reply->errorString());
+}
+
+void StreamingDownload::scheduleResume(const QString &reason)
+{
+    // Only consecutive attempts without progress count towards the retry limit
+    if (m_file.size() > m_requestOffset) {
+        m_retryCount = 0;
+    }
+
+    if (m_retryCount >= m_maxRetries) {
+        fail(QString("Download failed after %1 retries: %2").arg(m_retryCount).arg(reason));
+        return;
+    }
+
+    m_retryCount++;
+    m_file.flush();
+
+    int delay = qMin(m_retryDelayMs * (1 << (m_retryCount - 1)), MAX_RETRY_DELAY_MS);
+    qDebug() << "Download interrupted (" << reason << "), resuming at byte" << m_file.size()
+             << "in" << delay << "ms";
+    emit resumed(m_file.size(), m_retryCount);
+
+    QTimer::singleShot(delay, this, [this]() {
+        if (m_running) {
+            m_resumeCount++;
+            sendRequest();
+        }
+    });
+}
+
+void StreamingDownload::complete()
+{
+    m_running = false;
+    m_file.flush();
+    m_file.close();
+
+    if (QFile::exists(m_targetPath)) {
+        QFile::remove(m_targetPath);
+    }
+    if (!QFile::rename(partPath(), m_targetPath)) {
+        fail(QString("Cannot move download to %1").arg(m_targetPath));
+        return;
+    }
+
+    qDebug() << "Streaming download complete:" << m_targetPath << "resumes:" << m_resumeCount;
+    emit finished(m_targetPath);
+}
+
+void StreamingDownload::fail(const QString &error)
+{
+    m_running = false;
+    if (m_reply) {
+        QNetworkReply *reply = m_reply;
+        m_reply = nullptr;
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    QFile::remove(partPath());
+
+    qDebug() << "Streaming download failed:" << error;
+    emit failed(error);
+}
+
+QString StreamingDownload::partPath() const
+{
+    return m_targetPath + ".part";
+}
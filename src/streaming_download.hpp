@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+
+
+// Downloads a response straight to disk in fixed-size chunks so memory use does
+// not grow with the response size. Data is written to "<target>.part" and the
+// file is renamed to the target path once complete. Interrupted transfers are
+// resumed with an HTTP Range request (guarded by If-Range when the server sent
+// a validator); servers that ignore the range restart from byte zero.
+class StreamingDownload : public QObject
+{
+    Q_OBJECT
+public:
+    StreamingDownload(QNetworkAccessManager *networkManager, const QUrl &url,
+                      const QString &targetPath, QObject *parent = nullptr);
+    ~StreamingDownload();
+
+    // Configuration (call before start())
+    void setUserAgent(const QString &userAgent);
+    void setChunkSize(qint64 bytes);
+    void setMaxRetries(int maxRetries);
+    void setRetryDelay(int delayMs);
+
+    void start();
+    void abort();
+
+    QUrl url() const;
+    QString targetPath() const;
+    qint64 bytesWritten() const;
+    qint64 totalBytes() const;
+    int resumeCount() const;
+    bool isRunning() const;
+
+signals:
+    void progress(qint64 bytesWritten, qint64 totalBytes);
+    void resumed(qint64 offset, int attempt);
+    void finished(const QString &filePath);
+    void failed(const QString &error);
+
+private slots:
+    void onMetaDataChanged();
+    void onReadyRead();
+    void onReplyFinished();
+
+private:
+    void sendRequest();
+    bool drainReply();
+    void scheduleResume(const QString &reason);
+    void complete();
+    void fail(const QString &error);
+    QString partPath() const;
+
+    QNetworkAccessManager *m_networkManager;
+    QNetworkReply *m_reply;
+    QUrl m_url;
+    QString m_targetPath;
+    QString m_userAgent;
+    QFile m_file;
+
+    qint64 m_chunkSize;
+    qint64 m_requestOffset;
+    qint64 m_totalBytes;
+    QByteArray m_validator;
+    bool m_headersChecked;
+    bool m_running;
+
+    int m_maxRetries;
+    int m_retryDelayMs;
+    int m_retryCount;
+    int m_resumeCount;
+
+    // Constants
+    static const qint64 DEFAULT_CHUNK_SIZE;
+    static const int DEFAULT_MAX_RETRIES;
+    static const int DEFAULT_RETRY_DELAY_MS;
+    static const int MAX_RETRY_DELAY_MS;
+};
@@ -0,0 +1,564 @@
+#include "subscriber_registry.hpp"
+#include "alert_rules.hpp"
+#include "ground_motion.hpp"
+#include "spatial_utils.hpp"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
+#include <algorithm>
+#include <cmath>
+
+// Constants
+const double SubscriberRegistry::CELL_SIZE_DEGREES = 1.0;
+const double SubscriberRegistry::MAX_BUCKETED_RADIUS_KM = 2000.0;
+const double SubscriberRegistry::COOLDOWN_OVERRIDE_MAGNITUDE = 1.0;
+const double SubscriberRegistry::QUIET_HOURS_OVERRIDE_MAGNITUDE = 7.0;
+const int SubscriberRegistry::PARALLEL_CHUNK_SIZE = 4096;
+
+
+namespace {
+
+const int MINUTES_PER_DAY = 24 * 60;
+const int GRID_ROWS = int(180.0 / SubscriberRegistry::CELL_SIZE_DEGREES);
+const int GRID_COLUMNS = int(360.0 / SubscriberRegistry::CELL_SIZE_DEGREES);
+const double KM_PER_DEGREE = M_PI * SpatialUtils::EARTH_RADIUS_KM / 180.0;
+const double FLOAT_DOT_EPSILON = 1e-6;
+
+void setError(QString *errorMessage, const QString &message)
+{
+    if (errorMessage) *errorMessage = message;
+}
+
+int cellRow(double latitude)
+{
+    return std::clamp(int(std::floor((latitude + 90.0) / SubscriberRegistry::CELL_SIZE_DEGREES)), 0, GRID_ROWS - 1);
+}
+
+int cellColumn(double longitude)
+{
+    double wrapped = std::fmod(longitude + 180.0, 360.0);
+    if (wrapped < 0.0) wrapped += 360.0;
+    return std::clamp(int(wrapped / SubscriberRegistry::CELL_SIZE_DEGREES), 0, GRID_COLUMNS - 1);
+}
+
+int toUtcMinute(int localHour, int utcOffsetMinutes)
+{
+    return ((localHour * 60 - utcOffsetMinutes) % MINUTES_PER_DAY + MINUTES_PER_DAY) % MINUTES_PER_DAY;
+}
+
+bool inWindow(int minute, int start, int end)
+{
+    if (start == end) return false;
+    return start < end ? (minute >= start && minute < end) : (minute >= start || minute < end);
+}
+
+const char *channelName(DeliveryChannel channel)
+{
+    switch (channel) {
+    case DeliveryChannel::EmailAlert: return "email";
+    case DeliveryChannel::SMSAlert: return "sms";
+    case DeliveryChannel::PushNotification: return "push";
+    default: return nullptr;
+    }
+}
+
+quint8 channelBit(DeliveryChannel channel)
+{
+    return quint8(1u << int(channel));
+}
+
+Subscriber subscriberFromJson(const QJsonObject &object)
+{
+    Subscriber subscriber;
+    subscriber.id = object.value("id").toString();
+    subscriber.latitude = object.value("latitude").toDouble();
+    subscriber.longitude = object.value("longitude").toDouble();
+    subscriber.radiusKm = object.value("radiusKm").toDouble(subscriber.radiusKm);
+    subscriber.minMagnitude = object.value("minMagnitude").toDouble(subscriber.minMagnitude);
+    subscriber.maxDepth = object.value("maxDepth").toDouble(subscriber.maxDepth);
+    subscriber.minIntensity = object.value("minIntensity").toDouble(subscriber.minIntensity);
+    for (const QJsonValue &value : object.value("channels").toArray()) {
+        const QString name = value.toString();
+        for (DeliveryChannel channel : {DeliveryChannel::EmailAlert, DeliveryChannel::SMSAlert,
+                                        DeliveryChannel::PushNotification}) {
+            if (name.compare(channelName(channel), Qt::CaseInsensitive) == 0) {
+                subscriber.channels.append(channel);
+            }
+        }
+    }
+    subscriber.email = object.value("email").toString();
+    subscriber.phone = object.value("phone").toString();
+    subscriber.pushToken = object.value("pushToken").toString();
+    const QJsonObject quiet = object.value("quietHours").toObject();
+    subscriber.quietHoursStart = quiet.value("start").toInt(0);
+    subscriber.quietHoursEnd = quiet.value("end").toInt(0);
+    subscriber.utcOffsetMinutes = object.value("utcOffsetMinutes").toInt(0);
+    subscriber.cooldownSeconds = object.value("cooldownSeconds").toInt(subscriber.cooldownSeconds);
+    subscriber.maxAlertsPerHour = object.value("maxAlertsPerHour").toInt(subscriber.maxAlertsPerHour);
+    return subscriber;
+}
+
+QJsonObject subscriberToJson(const Subscriber &subscriber)
+{
+    QJsonObject object;
+    object["id"] = subscriber.id;
+    object["latitude"] = subscriber.latitude;
+    object["longitude"] = subscriber.longitude;
+    object["radiusKm"] = subscriber.radiusKm;
+    object["minMagnitude"] = subscriber.minMagnitude;
+    object["maxDepth"] = subscriber.maxDepth;
+    object["minIntensity"] = subscriber.minIntensity;
+    QJsonArray channels;
+    for (DeliveryChannel channel : subscriber.channels) {
+        if (const char *name = channelName(channel)) channels.append(QString(name));
+    }
+    object["channels"] = channels;
+    if (!subscriber.email.isEmpty()) object["email"] = subscriber.email;
+    if (!subscriber.phone.isEmpty()) object["phone"] = subscriber.phone;
+    if (!subscriber.pushToken.isEmpty()) object["pushToken"] = subscriber.pushToken;
+    if (subscriber.quietHoursStart != subscriber.quietHoursEnd) {
+        object["quietHours"] = QJsonObject{{"start", subscriber.quietHoursStart}, {"end", subscriber.quietHoursEnd}};
+    }
+    object["utcOffsetMinutes"] = subscriber.utcOffsetMinutes;
+    object["cooldownSeconds"] = subscriber.cooldownSeconds;
+    object["maxAlertsPerHour"] = subscriber.maxAlertsPerHour;
+    return object;
+}
+
+} // namespace
+
+
+SubscriberRegistry::SubscriberRegistry()
+    : m_indexValid(false)
+    , m_maxRadiusKm(0.0)
+{
+}
+
+void SubscriberRegistry::add(const Subscriber &subscriber)
+{
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_indexById.constFind(subscriber.id);
+    if (it != m_indexById.constEnd()) {
+        // Replacing a subscriber keeps their alert state
+        store(it.value(), subscriber);
+    } else {
+        const int index = m_subscribers.size();
+        m_subscribers.resize(index + 1);
+        for (auto *column : {&m_x, &m_y, &m_z, &m_cosRadius, &m_cosRadiusInner, &m_minMagnitude,
+                             &m_maxDepth, &m_minIntensity, &m_lastAlertMagnitude}) {
+            column->append(0.0f);
+        }
+        m_channelMask.append(0);
+        m_quietStartMinute.append(0);
+        m_quietEndMinute.append(0);
+        m_cooldownMs.append(0);
+        m_maxPerHour.append(0);
+        m_lastAlertMs.append(0);
+        m_hourStartMs.append(0);
+        m_alertsThisHour.append(0);
+        m_indexById.insert(subscriber.id, index);
+        store(index, subscriber);
+    }
+    m_indexValid = false;
+}
+
+void SubscriberRegistry::store(int index, const Subscriber &subscriber)
+{
+    m_subscribers[index] = subscriber;
+
+    double x, y, z;
+    CompiledAlertRules::toUnitVector(subscriber.latitude, subscriber.longitude, x, y, z);
+    m_x[index] = float(x);
+    m_y[index] = float(y);
+    m_z[index] = float(z);
+    // Widened by the float rounding of the columns and the dot product
+    double cosInner, cosOuter;
+    SpatialUtils::sphericalCapBounds(subscriber.radiusKm, cosInner, cosOuter);
+    m_cosRadius[index] = float(cosOuter - FLOAT_DOT_EPSILON);
+    m_cosRadiusInner[index] = float(cosInner + FLOAT_DOT_EPSILON);
+    m_minMagnitude[index] = float(subscriber.minMagnitude);
+    m_maxDepth[index] = float(subscriber.maxDepth);
+    m_minIntensity[index] = float(subscriber.minIntensity);
+
+    quint8 mask = 0;
+    for (DeliveryChannel channel : subscriber.channels) {
+        mask |= channelBit(channel);
+    }
+    m_channelMask[index] = mask;
+
+    if (subscriber.quietHoursStart == subscriber.quietHoursEnd) {
+        m_quietStartMinute[index] = m_quietEndMinute[index] = 0;
+    } else {
+        m_quietStartMinute[index] = qint16(toUtcMinute(subscriber.quietHoursStart, subscriber.utcOffsetMinutes));
+        m_quietEndMinute[index] = qint16(toUtcMinute(subscriber.quietHoursEnd, subscriber.utcOffsetMinutes));
+    }
+    m_cooldownMs[index] = qint32(std::clamp(subscriber.cooldownSeconds, 0, 24 * 3600) * 1000);
+    m_maxPerHour[index] = quint16(std::clamp(subscriber.maxAlertsPerHour, 0, 0xffff));
+}
+
+bool SubscriberRegistry::remove(const QString &id)
+{
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_indexById.find(id);
+    if (it == m_indexById.end()) return false;
+    const int index = it.value();
+    m_indexById.erase(it);
+    removeAt(index);
+    m_indexValid = false;
+    return true;
+}
+
+void SubscriberRegistry::removeAt(int index)
+{
+    // Swap with the last subscriber so every column stays dense
+    const int last = m_subscribers.size() - 1;
+    auto moveLast = [index, last](auto &column) {
+        column[index] = column[last];
+        column.removeLast();
+    };
+    moveLast(m_subscribers);
+    moveLast(m_x);
+    moveLast(m_y);
+    moveLast(m_z);
+    moveLast(m_cosRadius);
+    moveLast(m_cosRadiusInner);
+    moveLast(m_minMagnitude);
+    moveLast(m_maxDepth);
+    moveLast(m_minIntensity);
+    moveLast(m_channelMask);
+    moveLast(m_quietStartMinute);
+    moveLast(m_quietEndMinute);
+    moveLast(m_cooldownMs);
+    moveLast(m_maxPerHour);
+    moveLast(m_lastAlertMs);
+    moveLast(m_lastAlertMagnitude);
+    moveLast(m_hourStartMs);
+    moveLast(m_alertsThisHour);
+    if (index < last) {
+        m_indexById[m_subscribers[index].id] = index;
+    }
+}
+
+void SubscriberRegistry::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_subscribers.clear();
+    m_indexById.clear();
+    for (auto *column : {&m_x, &m_y, &m_z, &m_cosRadius, &m_cosRadiusInner, &m_minMagnitude,
+                         &m_maxDepth, &m_minIntensity, &m_lastAlertMagnitude}) {
+        column->clear();
+    }
+    m_channelMask.clear();
+    m_quietStartMinute.clear();
+    m_quietEndMinute.clear();
+    m_cooldownMs.clear();
+    m_maxPerHour.clear();
+    m_lastAlertMs.clear();
+    m_hourStartMs.clear();
+    m_alertsThisHour.clear();
+    m_indexValid = false;
+}
+
+int SubscriberRegistry::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_subscribers.size();
+}
+
+int SubscriberRegistry::indexOf(const QString &id) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_indexById.value(id, -1);
+}
+
+Subscriber SubscriberRegistry::subscriber(int index) const
+{
+    QMutexLocker locker(&m_mutex);
+    return index >= 0 && index < m_subscribers.size() ? m_subscribers[index] : Subscriber();
+}
+
+QString SubscriberRegistry::contact(int index, DeliveryChannel channel) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (index < 0 || index >= m_subscribers.size() || !(m_channelMask[index] & channelBit(channel))) {
+        return QString();
+    }
+    const Subscriber &subscriber = m_subscribers[index];
+    switch (channel) {
+    case DeliveryChannel::EmailAlert: return subscriber.email;
+    case DeliveryChannel::SMSAlert: return subscriber.phone;
+    case DeliveryChannel::PushNotification: return subscriber.pushToken;
+    default: return QString();
+    }
+}
+
+void SubscriberRegistry::buildIndex()
+{
+    QVector<int> cellOf(m_subscribers.size(), -1);
+    m_cellOffsets.fill(0, GRID_ROWS * GRID_COLUMNS + 1);
+    m_wideSubscribers.clear();
+    m_maxRadiusKm = 0.0;
+
+    for (int i = 0; i < m_subscribers.size(); ++i) {
+        const Subscriber &subscriber = m_subscribers[i];
+        if (subscriber.radiusKm > MAX_BUCKETED_RADIUS_KM) {
+            m_wideSubscribers.append(i);
+            continue;
+        }
+        m_maxRadiusKm = std::max(m_maxRadiusKm, subscriber.radiusKm);
+        cellOf[i] = cellRow(subscriber.latitude) * GRID_COLUMNS + cellColumn(subscriber.longitude);
+        m_cellOffsets[cellOf[i] + 1]++;
+    }
+    for (int c = 0; c < GRID_ROWS * GRID_COLUMNS; ++c) {
+        m_cellOffsets[c + 1] += m_cellOffsets[c];
+    }
+
+    // Counting sort; ascending index within each cell
+    m_cellSubscribers.resize(m_cellOffsets.last());
+    QVector<int> fill(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+    for (int i = 0; i < cellOf.size(); ++i) {
+        if (cellOf[i] >= 0) {
+            m_cellSubscribers[fill[cellOf[i]]++] = i;
+        }
+    }
+    m_indexValid = true;
+}
+
+QVector<int> SubscriberRegistry::candidates(double latitude, double longitude) const
+{
+    QVector<int> result = m_wideSubscribers;
+    if (m_cellSubscribers.isEmpty()) return result;
+
+    // Cells whose subscribers could have the event within their radius
+    const double reachKm = m_maxRadiusKm * (1.0 + SpatialUtils::SPHERICAL_DISTANCE_TOLERANCE);
+    const double latitudeSpan = reachKm / KM_PER_DEGREE + CELL_SIZE_DEGREES;
+    const double south = latitude - latitudeSpan;
+    const double north = latitude + latitudeSpan;
+    const int firstRow = cellRow(south);
+    const int lastRow = cellRow(north);
+
+    const double cosLatitude = std::cos(std::min(89.0, std::max(std::abs(south), std::abs(north))) * M_PI / 180.0);
+    const double longitudeSpan = latitudeSpan / cosLatitude;
+    const bool allColumns = south <= -90.0 || north >= 90.0 || longitudeSpan >= 180.0;
+    const int firstColumn = cellColumn(longitude - longitudeSpan);
+    const int columnCount = allColumns ? GRID_COLUMNS
+                                       : std::min(GRID_COLUMNS, int(2.0 * longitudeSpan / CELL_SIZE_DEGREES) + 2);
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int k = 0; k < columnCount; ++k) {
+            const int cell = row * GRID_COLUMNS + (firstColumn + k) % GRID_COLUMNS;
+            for (int i = m_cellOffsets[cell]; i < m_cellOffsets[cell + 1]; ++i) {
+                result.append(m_cellSubscribers[i]);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+QVector<SubscriberRegistry::Match> SubscriberRegistry::match(const EarthquakeData &earthquake, qint64 nowMs)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_indexValid) {
+        buildIndex();
+    }
+
+    double x, y, z;
+    CompiledAlertRules::toUnitVector(earthquake.latitude, earthquake.longitude, x, y, z);
+    const int minuteOfDay = int((nowMs / 60000) % MINUTES_PER_DAY);
+    const QVector<int> indices = candidates(earthquake.latitude, earthquake.longitude);
+
+    auto testRange = [&](int begin, int end, QVector<Match> &out) {
+        Match match;
+        for (int k = begin; k < end; ++k) {
+            if (accept(indices[k], earthquake, x, y, z, nowMs, minuteOfDay, match)) {
+                out.append(match);
+            }
+        }
+    };
+
+    const int chunks = (indices.size() + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+    QVector<QVector<Match>> results(std::max(1, chunks));
+
+    // Tasks the pool cannot take right away run inline, so this never waits
+    // on a saturated pool
+    QSemaphore done;
+    int tasks = 0;
+    for (int chunk = 1; chunk < chunks; ++chunk) {
+        const int begin = chunk * PARALLEL_CHUNK_SIZE;
+        const int end = std::min<int>(begin + PARALLEL_CHUNK_SIZE, indices.size());
+        QVector<Match> *out = &results[chunk];
+        auto task = [&done, &testRange, begin, end, out]() {
+            testRange(begin, end, *out);
+            done.release();
+        };
+        if (!QThreadPool::globalInstance()->tryStart(task)) {
+            task();
+        }
+        tasks++;
+    }
+    testRange(0, std::min<int>(PARALLEL_CHUNK_SIZE, indices.size()), results[0]);
+    done.acquire(tasks);
+
+    QVector<Match> matches = std::move(results[0]);
+    for (int chunk = 1; chunk < results.size(); ++chunk) {
+        matches += results[chunk];
+    }
+    return matches;
+}
+
+bool SubscriberRegistry::accept(int index, const EarthquakeData &earthquake, double x, double y, double z,
+                                qint64 nowMs, int minuteOfDay, Match &match)
+{
+    const double magnitude = earthquake.magnitude;
+    if (magnitude < m_minMagnitude[index] || earthquake.depth > m_maxDepth[index]) {
+        return false;
+    }
+    const double dot = x * m_x[index] + y * m_y[index] + z * m_z[index];
+    if (dot < m_cosRadius[index] || m_channelMask[index] == 0) {
+        return false;
+    }
+
+    const Subscriber &subscriber = m_subscribers[index];
+    match.index = index;
+    if (dot < m_cosRadiusInner[index]) {
+        // Near the edge the geodesic decides
+        match.distanceKm = SpatialUtils::geodesicDistance(earthquake.latitude, earthquake.longitude,
+                                                          subscriber.latitude, subscriber.longitude);
+        if (match.distanceKm > subscriber.radiusKm) {
+            return false;
+        }
+    } else {
+        match.distanceKm = SpatialUtils::haversineDistance(earthquake.latitude, earthquake.longitude,
+                                                           subscriber.latitude, subscriber.longitude);
+    }
+    match.intensity = GroundMotionModel::intensity(
+        magnitude, GroundMotionModel::hypocentralDistance(match.distanceKm, earthquake.depth));
+    if (match.intensity < m_minIntensity[index]) {
+        return false;
+    }
+
+    if (magnitude < QUIET_HOURS_OVERRIDE_MAGNITUDE
+        && inWindow(minuteOfDay, m_quietStartMinute[index], m_quietEndMinute[index])) {
+        return false;
+    }
+
+    if (m_lastAlertMs[index] > 0 && nowMs - m_lastAlertMs[index] < m_cooldownMs[index]
+        && magnitude < m_lastAlertMagnitude[index] + COOLDOWN_OVERRIDE_MAGNITUDE) {
+        return false;
+    }
+
+    if (nowMs - m_hourStartMs[index] >= 3600 * 1000) {
+        m_hourStartMs[index] = nowMs;
+        m_alertsThisHour[index] = 0;
+    }
+    if (m_alertsThisHour[index] >= m_maxPerHour[index]) {
+        return false;
+    }
+
+    m_lastAlertMs[index] = nowMs;
+    m_lastAlertMagnitude[index] = float(magnitude);
+    m_alertsThisHour[index]++;
+    return true;
+}
+
+bool SubscriberRegistry::loadJson(const QByteArray &json, QString *errorMessage)
+{
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        setError(errorMessage, "Invalid subscriber JSON: " + parseError.errorString());
+        return false;
+    }
+    if (!document.isArray()) {
+        setError(errorMessage, "Subscriber file must contain a JSON array");
+        return false;
+    }
+
+    const QJsonArray array = document.array();
+    for (int i = 0; i < array.size(); ++i) {
+        const Subscriber subscriber = subscriberFromJson(array[i].toObject());
+        if (subscriber.id.isEmpty()) {
+            setError(errorMessage, QString("Subscriber %1 has no id").arg(i));
+            return false;
+        }
+        if (subscriber.latitude < -90.0 || subscriber.latitude > 90.0) {
+            setError(errorMessage, QString("Subscriber %1 has an invalid latitude").arg(subscriber.id));
+            return false;
+        }
+        add(subscriber);
+    }
+    return true;
+}
+
+bool SubscriberRegistry::loadFromFile(const QString &path, QString *errorMessage)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        setError(errorMessage, "Cannot open subscriber file " + path + ": " + file.errorString());
+        return false;
+    }
+    return loadJson(file.readAll(), errorMessage);
+}
+
+QByteArray SubscriberRegistry::toJson() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QJsonArray array;
+    for (const Subscriber &subscriber : m_subscribers) {
+        array.append(subscriberToJson(subscriber));
+    }
+    return QJsonDocument(array).toJson(QJsonDocument::Indented);
+}
+
+void SubscriberRegistry::writeStateTo(QDataStream &stream) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    qint32 count = 0;
+    for (int i = 0; i < m_subscribers.size(); ++i) {
+        if (m_lastAlertMs[i] > 0) count++;
+    }
+    stream << count;
+    for (int i = 0; i < m_subscribers.size(); ++i) {
+        if (m_lastAlertMs[i] > 0) {
+            stream << m_subscribers[i].id << m_lastAlertMs[i] << m_lastAlertMagnitude[i]
+                   << m_hourStartMs[i] << m_alertsThisHour[i];
+        }
+    }
+}
+
+bool SubscriberRegistry::readStateFrom(QDataStream &stream)
+{
+    QMutexLocker locker(&m_mutex);
+
+    qint32 count = 0;
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString id;
+        qint64 lastAlertMs = 0;
+        float lastAlertMagnitude = 0.0f;
+        qint64 hourStartMs = 0;
+        quint16 alertsThisHour = 0;
+        stream >> id >> lastAlertMs >> lastAlertMagnitude >> hourStartMs >> alertsThisHour;
+
+        const int index = m_indexById.value(id, -1);
+        if (index >= 0) {
+            m_lastAlertMs[index] = lastAlertMs;
+            m_lastAlertMagnitude[index] = lastAlertMagnitude;
+            m_hourStartMs[index] = hourStartMs;
+            m_alertsThisHour[index] = alertsThisHour;
+        }
+    }
+    return stream.status() == QDataStream::Ok;
+}
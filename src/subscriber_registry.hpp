@@ -0,0 +1,139 @@
+#pragma once
+
+#include "earthquake_data.hpp"
+#include "notification_types.hpp"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDataStream>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QVector>
+
+
+// One recipient of the regional alerting service: where they are, what they
+// want to hear about and how to reach them.
+struct Subscriber {
+    QString id;
+    double latitude = 0.0;
+    double longitude = 0.0;
+
+    // Alert rule: all set conditions must hold
+    double radiusKm = 500.0;
+    double minMagnitude = 5.0;
+    double maxDepth = 1000.0;
+    double minIntensity = 0.0; // Predicted MMI at the subscriber; 0 disables
+
+    QVector<DeliveryChannel> channels; // EmailAlert, SMSAlert and/or PushNotification
+    QString email;
+    QString phone;
+    QString pushToken;
+
+    // Local quiet hours; start == end disables them
+    int quietHoursStart = 0;
+    int quietHoursEnd = 0;
+    int utcOffsetMinutes = 0;
+
+    int cooldownSeconds = 600;
+    int maxAlertsPerHour = 10;
+};
+
+// Subscribers stored column-wise for matching one event against all of them.
+//
+// Hot fields (unit vector, radius cosine, thresholds, channel mask, quiet
+// hours) live in parallel float/int arrays, as does the per-subscriber
+// cooldown and hourly rate-limit state. Subscribers are bucketed by the
+// 1-degree cell of their location (CSR layout); an event only visits the
+// cells within the largest alert radius around it, plus the few subscribers
+// whose radius is too wide to bucket. Candidates are tested in chunks on the
+// global thread pool; each subscriber belongs to exactly one chunk, so state
+// updates need no locking.
+//
+// Cooldown: after an alert, further alerts are held back for cooldownSeconds
+// unless the new event is at least COOLDOWN_OVERRIDE_MAGNITUDE units larger.
+// Quiet hours are ignored from QUIET_HOURS_OVERRIDE_MAGNITUDE up.
+class SubscriberRegistry
+{
+public:
+    struct Match {
+        int index;
+        double distanceKm;
+        double intensity;
+    };
+
+    SubscriberRegistry();
+
+    // Replaces a subscriber with the same id. Thread-safe, like every method.
+    void add(const Subscriber &subscriber);
+    bool remove(const QString &id);
+    void clear();
+
+    int size() const;
+    int indexOf(const QString &id) const;
+    Subscriber subscriber(int index) const;
+    // Email address, phone number or push token; empty if not subscribed on that channel
+    QString contact(int index, DeliveryChannel channel) const;
+
+    // Subscribers to alert about this event at nowMs, in index order. Their
+    // cooldown and rate-limit state is updated as if the alerts were sent.
+    QVector<Match> match(const EarthquakeData &earthquake, qint64 nowMs);
+
+    // JSON array of subscriber objects (see README). Returns false and keeps
+    // the subscribers loaded so far on error.
+    bool loadJson(const QByteArray &json, QString *errorMessage = nullptr);
+    bool loadFromFile(const QString &path, QString *errorMessage = nullptr);
+    QByteArray toJson() const;
+
+    // Cooldown and rate-limit state by subscriber id, kept across restarts.
+    // State of ids that are no longer registered is skipped on read.
+    void writeStateTo(QDataStream &stream) const;
+    bool readStateFrom(QDataStream &stream);
+
+    static const double CELL_SIZE_DEGREES;
+    static const double MAX_BUCKETED_RADIUS_KM;
+    static const double COOLDOWN_OVERRIDE_MAGNITUDE;
+    static const double QUIET_HOURS_OVERRIDE_MAGNITUDE;
+    static const int PARALLEL_CHUNK_SIZE;
+
+private:
+    void store(int index, const Subscriber &subscriber);
+    void removeAt(int index);
+    void buildIndex();
+    QVector<int> candidates(double latitude, double longitude) const;
+    bool accept(int index, const EarthquakeData &earthquake, double x, double y, double z,
+                qint64 nowMs, int minuteOfDay, Match &match);
+
+    mutable QMutex m_mutex;
+
+    // Cold data, one entry per subscriber
+    QVector<Subscriber> m_subscribers;
+    QHash<QString, int> m_indexById;
+
+    // Hot columns
+    QVector<float> m_x;
+    QVector<float> m_y;
+    QVector<float> m_z;
+    QVector<float> m_cosRadius;      // Beyond is outside, even on the ellipsoid
+    QVector<float> m_cosRadiusInner; // Within is inside; in between takes the geodesic
+    QVector<float> m_minMagnitude;
+    QVector<float> m_maxDepth;
+    QVector<float> m_minIntensity;
+    QVector<quint8> m_channelMask;
+    QVector<qint16> m_quietStartMinute; // Minute of the UTC day; equal start and end disables
+    QVector<qint16> m_quietEndMinute;
+    QVector<qint32> m_cooldownMs;
+    QVector<quint16> m_maxPerHour;
+
+    // Per-subscriber alert state
+    QVector<qint64> m_lastAlertMs;
+    QVector<float> m_lastAlertMagnitude;
+    QVector<qint64> m_hourStartMs;
+    QVector<quint16> m_alertsThisHour;
+
+    // Spatial index, rebuilt lazily after changes
+    bool m_indexValid;
+    double m_maxRadiusKm;
+    QVector<int> m_cellOffsets;
+    QVector<int> m_cellSubscribers;
+    QVector<int> m_wideSubscribers;
+};
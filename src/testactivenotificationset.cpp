@@ -0,0 +1,152 @@
+#include "active_notification_set.hpp"
+
+#include <QTest>
+
+// Declare the test class
+class TestActiveNotificationSet : public QObject {
+    Q_OBJECT
+private slots:
+    void testReplaceById();
+    void testSourceDedup();
+    void testAcknowledge();
+    void testCompaction();
+};
+
+static NotificationData makeNotification(const QString &id, const QString &sourceEventId = QString()) {
+    NotificationData notification;
+    notification.id = id;
+    notification.type = NotificationType::Warning;
+    notification.priority = NotificationPriority::Normal;
+    notification.sourceEventId = sourceEventId;
+    return notification;
+}
+
+static QStringList ids(const QVector<NotificationData> &notifications) {
+    QStringList result;
+    for (const NotificationData &notification : notifications) result.append(notification.id);
+    return result;
+}
+
+void TestActiveNotificationSet::testReplaceById() {
+    ActiveNotificationSet set;
+    set.insert(makeNotification("a", "us1"));
+    set.insert(makeNotification("b", "us2"));
+    QCOMPARE(set.size(), 2);
+
+    // Same id: the new notification replaces the old one and moves to the end
+    NotificationData revised = makeNotification("a", "us3");
+    revised.message = "Revised";
+    set.insert(revised);
+    QCOMPARE(set.size(), 2);
+    QVERIFY(set.find("a"));
+    QCOMPARE(set.find("a")->message, QString("Revised"));
+    QCOMPARE(ids(set.toVector()), (QStringList{"b", "a"}));
+    QVERIFY(!set.hasUnacknowledged("us1"));
+    QVERIFY(set.hasUnacknowledged("us3"));
+
+    // Replacing an acknowledged notification keeps the count right
+    QVERIFY(set.acknowledge("b"));
+    QCOMPARE(set.acknowledgedCount(), 1);
+    set.insert(makeNotification("b", "us2"));
+    QCOMPARE(set.acknowledgedCount(), 0);
+    QVERIFY(set.hasUnacknowledged("us2"));
+
+    QVERIFY(set.remove("a"));
+    QVERIFY(!set.remove("a"));
+    QVERIFY(!set.find("a"));
+    QVERIFY(!set.hasUnacknowledged("us3"));
+    QCOMPARE(set.size(), 1);
+
+    set.clear();
+    QCOMPARE(set.size(), 0);
+    QVERIFY(!set.hasUnacknowledged("us2"));
+}
+
+void TestActiveNotificationSet::testSourceDedup() {
+    // shouldShowNotification() skips an event while any of its notifications
+    // is unacknowledged
+    ActiveNotificationSet set;
+    set.insert(makeNotification("x", "us1"));
+    set.insert(makeNotification("y", "us1"));
+    set.insert(makeNotification("z"));
+    QVERIFY(set.hasUnacknowledged("us1"));
+    QVERIFY(!set.hasUnacknowledged("us2"));
+    QVERIFY(!set.hasUnacknowledged(QString()));
+
+    QVERIFY(set.acknowledge("x"));
+    QVERIFY(set.hasUnacknowledged("us1"));
+    QVERIFY(set.acknowledge("y"));
+    QVERIFY(!set.hasUnacknowledged("us1"));
+
+    // An acknowledged notification never blocks its event
+    NotificationData seen = makeNotification("w", "us2");
+    seen.acknowledged = true;
+    set.insert(seen);
+    QVERIFY(!set.hasUnacknowledged("us2"));
+
+    // Removing or replacing the last unacknowledged one releases the event
+    set.insert(makeNotification("v", "us3"));
+    QVERIFY(set.hasUnacknowledged("us3"));
+    QVERIFY(set.remove("v"));
+    QVERIFY(!set.hasUnacknowledged("us3"));
+    set.insert(makeNotification("v", "us3"));
+    set.insert(makeNotification("v", "us4"));
+    QVERIFY(!set.hasUnacknowledged("us3"));
+    QVERIFY(set.hasUnacknowledged("us4"));
+}
+
+void TestActiveNotificationSet::testAcknowledge() {
+    ActiveNotificationSet set;
+    set.insert(makeNotification("a", "us1"));
+    set.insert(makeNotification("b", "us2"));
+    set.insert(makeNotification("c", "us3"));
+
+    QVERIFY(set.acknowledge("b"));
+    QVERIFY(!set.acknowledge("b"));
+    QVERIFY(!set.acknowledge("missing"));
+    QCOMPARE(set.acknowledgedCount(), 1);
+    QVERIFY(set.find("b")->acknowledged);
+    QCOMPARE(ids(set.unacknowledged()), (QStringList{"a", "c"}));
+
+    QCOMPARE(set.acknowledgeAll(), (QStringList{"a", "c"}));
+    QVERIFY(set.acknowledgeAll().isEmpty());
+    QCOMPARE(set.acknowledgedCount(), 3);
+    QVERIFY(set.unacknowledged().isEmpty());
+    QCOMPARE(ids(set.toVector()), (QStringList{"a", "b", "c"}));
+    QVERIFY(!set.hasUnacknowledged("us1"));
+
+    QVERIFY(set.remove("a"));
+    QCOMPARE(set.acknowledgedCount(), 2);
+}
+
+void TestActiveNotificationSet::testCompaction() {
+    ActiveNotificationSet set;
+    for (int i = 0; i < 100; ++i) {
+        set.insert(makeNotification(QString::number(i), QString("us%1").arg(i)));
+    }
+    for (int i = 0; i < 100; ++i) {
+        if (i % 10 != 0) QVERIFY(set.remove(QString::number(i)));
+    }
+
+    // Lookups, order and dedup survive the slot compaction
+    QCOMPARE(set.size(), 10);
+    QStringList expected;
+    for (int i = 0; i < 100; i += 10) {
+        expected.append(QString::number(i));
+        QVERIFY(set.find(QString::number(i)));
+        QCOMPARE(set.find(QString::number(i))->id, QString::number(i));
+    }
+    QCOMPARE(ids(set.toVector()), expected);
+    QVERIFY(set.hasUnacknowledged("us0"));
+    QVERIFY(!set.hasUnacknowledged("us1"));
+
+    // Later removals and inserts still find the compacted slots
+    QVERIFY(set.remove("50"));
+    set.insert(makeNotification("100", "us100"));
+    QCOMPARE(ids(set.toVector()), (QStringList{"0", "10", "20", "30", "40", "60", "70", "80", "90", "100"}));
+    QVERIFY(!set.hasUnacknowledged("us50"));
+    QVERIFY(set.hasUnacknowledged("us100"));
+}
+
+QTEST_MAIN(TestActiveNotificationSet)
+#include "testactivenotificationset.moc"
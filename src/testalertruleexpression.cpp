@@ -0,0 +1,103 @@
+#include "alert_rule_expression.hpp"
+
+#include <stdexcept>
+#include <QtCore/QStringList>
+#include <QTest>
+
+// Declare the test class
+class TestAlertRuleExpression : public QObject {
+    Q_OBJECT
+private slots:
+    void testEvaluate_data();
+    void testEvaluate();
+    void testConstantFolding();
+    void testSyntaxErrors_data();
+    void testSyntaxErrors();
+};
+
+static EarthquakeData sampleEarthquake() {
+    EarthquakeData eq;
+    eq.latitude = 35.6;
+    eq.longitude = 139.7;
+    eq.magnitude = 6.1;
+    eq.depth = 30.0;
+    eq.alertLevel = 2;
+    eq.uncertainty = 0.1;
+    eq.tsunamiFlag = "Yes";
+    return eq;
+}
+
+// Region ids as a registry would assign them
+static int resolveRegion(const QString &name) {
+    return QStringList{"Japan", "Chile"}.indexOf(name);
+}
+
+void TestAlertRuleExpression::testEvaluate_data() {
+    QTest::addColumn<QString>("source");
+    QTest::addColumn<bool>("expected");
+
+    QTest::newRow("magnitude and depth") << "mag >= 5 && depth < 70" << true;
+    QTest::newRow("region") << "within(region:\"Japan\")" << true;
+    QTest::newRow("other region") << "within(region:\"Chile\")" << false;
+    QTest::newRow("any region") << "within(region:\"Chile\", region:\"Japan\")" << true;
+    QTest::newRow("intensity at user") << "mmi_at(user) >= 4" << true;
+    QTest::newRow("full rule") << "mag >= 5 && depth < 70 && within(region:\"Japan\") && mmi_at(user) >= 4" << true;
+    QTest::newRow("radius") << "within(35.7, 139.8, 50)" << true;
+    QTest::newRow("distance") << "distance_to(user) > 100" << false;
+    QTest::newRow("keywords") << "not (depth > 100) and tsunami" << true;
+    QTest::newRow("or") << "mag > 7 || alert_level >= 2" << true;
+    QTest::newRow("arithmetic") << "mag - 2 * alert_level > 2 && uncertainty < 0.5" << true;
+    QTest::newRow("functions") << "min(mag, 3) + abs(-1) == 4 && max(depth, 10) == 30" << true;
+}
+
+void TestAlertRuleExpression::testEvaluate() {
+    QFETCH(QString, source);
+    QFETCH(bool, expected);
+
+    AlertRuleExpression::RegionPredicate inRegion = [](const EarthquakeData &, const QVector<int> &regionIds) {
+        return regionIds.contains(resolveRegion("Japan"));
+    };
+    AlertRuleExpression::Context context;
+    context.userLatitude = 35.7;
+    context.userLongitude = 139.8;
+    context.inRegion = &inRegion;
+
+    AlertRuleExpression expression = AlertRuleExpression::compile(source, resolveRegion);
+    QCOMPARE(expression.evaluate(sampleEarthquake(), context), expected);
+}
+
+void TestAlertRuleExpression::testConstantFolding() {
+    // Fully constant expressions collapse to a single load
+    QCOMPARE(AlertRuleExpression::compile("1 + 2 * 3 == 7").instructionCount(), 1);
+    QCOMPARE(AlertRuleExpression::compile("false && mag > 5").instructionCount(), 1);
+
+    // A constant true operand leaves only the other side
+    AlertRuleExpression reduced = AlertRuleExpression::compile("true && mag > 2 + 3");
+    AlertRuleExpression plain = AlertRuleExpression::compile("mag > 5");
+    QCOMPARE(reduced.instructionCount(), plain.instructionCount() + 1); // + ToBool
+
+    AlertRuleExpression::Context context;
+    QVERIFY(reduced.evaluate(sampleEarthquake(), context));
+}
+
+void TestAlertRuleExpression::testSyntaxErrors_data() {
+    QTest::addColumn<QString>("source");
+
+    QTest::newRow("missing operand") << "mag >";
+    QTest::newRow("unknown field") << "magnitude_x > 5";
+    QTest::newRow("unbalanced") << "(mag > 5";
+    QTest::newRow("bad character") << "mag $ 5";
+    QTest::newRow("unterminated string") << "within(region:\"Japan)";
+    QTest::newRow("string operand") << "mag > \"5\"";
+    QTest::newRow("user outside call") << "user > 1";
+    QTest::newRow("bad arguments") << "within(1, 2)";
+    QTest::newRow("unknown region") << "within(region:\"Atlantis\")";
+}
+
+void TestAlertRuleExpression::testSyntaxErrors() {
+    QFETCH(QString, source);
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, AlertRuleExpression::compile(source, resolveRegion));
+}
+
+QTEST_MAIN(TestAlertRuleExpression)
+#include "testalertruleexpression.moc"
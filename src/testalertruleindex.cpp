@@ -0,0 +1,259 @@
+#include "alert_rule_index.hpp"
+#include "spatial_utils.hpp"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QRandomGenerator>
+#include <QTest>
+#include <algorithm>
+#include <cmath>
+
+// Declare the test class
+class TestAlertRuleIndex : public QObject {
+    Q_OBJECT
+private slots:
+    void testIntervalTree();
+    void testRandomizedEquivalence();
+    void testEdgeCases();
+    void testBenchmarkSmoke();
+};
+
+static EarthquakeData makeEvent(double latitude, double longitude, double magnitude, double depth) {
+    EarthquakeData eq;
+    eq.latitude = latitude;
+    eq.longitude = longitude;
+    eq.magnitude = magnitude;
+    eq.depth = depth;
+    eq.alertLevel = 0;
+    return eq;
+}
+
+static double uniform(QRandomGenerator &random, double low, double high) {
+    return low + random.generateDouble() * (high - low);
+}
+
+// Uniform over the sphere rather than over latitude
+static double randomLatitude(QRandomGenerator &random) {
+    return std::asin(uniform(random, -1.0, 1.0)) * 180.0 / M_PI;
+}
+
+static AlertRule randomRule(QRandomGenerator &random, int i) {
+    AlertRule rule;
+    rule.name = QString("rule %1").arg(i);
+    rule.enabled = random.bounded(50) != 0;
+    rule.minMagnitude = uniform(random, 0.0, 7.0);
+    rule.maxMagnitude = rule.minMagnitude + uniform(random, -0.5, 4.0); // Sometimes empty
+    rule.minDepth = uniform(random, 0.0, 100.0);
+    rule.maxDepth = rule.minDepth + uniform(random, 0.0, 700.0);
+
+    switch (random.bounded(6)) {
+        case 0: // No location constraint
+            break;
+        case 1: // At or near a pole
+            rule.useLocation = true;
+            rule.centerLatitude = (random.bounded(2) ? 1.0 : -1.0) * uniform(random, 88.0, 90.0);
+            rule.centerLongitude = uniform(random, -180.0, 180.0);
+            rule.radiusKm = uniform(random, 10.0, 1500.0);
+            break;
+        case 2: // Across the antimeridian
+            rule.useLocation = true;
+            rule.centerLatitude = randomLatitude(random);
+            rule.centerLongitude = (random.bounded(2) ? 1.0 : -1.0) * uniform(random, 178.0, 180.0);
+            rule.radiusKm = uniform(random, 10.0, 800.0);
+            break;
+        case 3: // Caps covering a large part of the globe, up to all of it
+            rule.useLocation = true;
+            rule.centerLatitude = randomLatitude(random);
+            rule.centerLongitude = uniform(random, -180.0, 180.0);
+            rule.radiusKm = uniform(random, 5000.0, 21000.0);
+            break;
+        default:
+            rule.useLocation = true;
+            rule.centerLatitude = randomLatitude(random);
+            rule.centerLongitude = uniform(random, -180.0, 180.0);
+            rule.radiusKm = uniform(random, 1.0, 1000.0);
+            break;
+    }
+    return rule;
+}
+
+// A typical user rule: a local cap with magnitude and depth limits
+static AlertRule localRule(QRandomGenerator &random, int i) {
+    AlertRule rule;
+    rule.name = QString("rule %1").arg(i);
+    rule.minMagnitude = uniform(random, 2.0, 6.0);
+    rule.maxMagnitude = 10.0;
+    rule.minDepth = 0.0;
+    rule.maxDepth = uniform(random, 50.0, 700.0);
+    rule.useLocation = true;
+    rule.centerLatitude = randomLatitude(random);
+    rule.centerLongitude = uniform(random, -180.0, 180.0);
+    rule.radiusKm = uniform(random, 10.0, 500.0);
+    return rule;
+}
+
+static QVector<EarthquakeData> randomEvents(QRandomGenerator &random, const QVector<AlertRule> &rules, int count) {
+    QVector<EarthquakeData> events;
+    events.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const double magnitude = uniform(random, 0.0, 9.5);
+        const double depth = uniform(random, 0.0, 700.0);
+        const AlertRule &rule = rules[random.bounded(rules.size())];
+
+        if (rule.useLocation && random.bounded(2) == 0) {
+            // Close to the edge of a cap, where sphere and ellipsoid can disagree
+            const QPointF point = SpatialUtils::calculateDestination(rule.centerLatitude, rule.centerLongitude,
+                                                                     uniform(random, 0.0, 360.0),
+                                                                     rule.radiusKm * uniform(random, 0.98, 1.02));
+            events.append(makeEvent(point.x(), point.y(), magnitude, depth));
+        } else if (random.bounded(10) == 0) {
+            // Poles and the antimeridian themselves
+            const double latitude = random.bounded(2) ? randomLatitude(random) : (random.bounded(2) ? 90.0 : -90.0);
+            const double longitude = random.bounded(2) ? uniform(random, -180.0, 180.0) : (random.bounded(2) ? 180.0 : -180.0);
+            events.append(makeEvent(latitude, longitude, magnitude, depth));
+        } else {
+            events.append(makeEvent(randomLatitude(random), uniform(random, -180.0, 180.0), magnitude, depth));
+        }
+    }
+    return events;
+}
+
+static bool sameMatches(const QVector<AlertMatch> &a, const QVector<AlertMatch> &b) {
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i) {
+        if (a[i].eventIndex != b[i].eventIndex || a[i].ruleIndex != b[i].ruleIndex) return false;
+    }
+    return true;
+}
+
+static const auto noRegions = [](const EarthquakeData &, const QVector<int> &) { return false; };
+
+void TestAlertRuleIndex::testIntervalTree() {
+    QRandomGenerator random(7);
+    QVector<IntervalTree::Interval> intervals;
+    for (int i = 0; i < 500; ++i) {
+        const double low = uniform(random, 0.0, 10.0);
+        intervals.append({low, low + uniform(random, 0.0, 3.0), i});
+    }
+    IntervalTree tree;
+    tree.build(intervals);
+
+    for (int q = 0; q < 1000; ++q) {
+        // Interval endpoints are hit as well; the trees use closed intervals
+        const double x = q % 4 == 0 ? intervals[q % intervals.size()].high : uniform(random, -1.0, 14.0);
+        QVector<int> hits;
+        tree.stab(x, [&hits](int id) { hits.append(id); });
+        std::sort(hits.begin(), hits.end());
+
+        QVector<int> expected;
+        for (const IntervalTree::Interval &interval : intervals) {
+            if (interval.low <= x && x <= interval.high) expected.append(interval.id);
+        }
+        QCOMPARE(hits, expected);
+    }
+
+    tree.clear();
+    QVERIFY(tree.isEmpty());
+}
+
+void TestAlertRuleIndex::testRandomizedEquivalence() {
+    QRandomGenerator random(20240611);
+    for (int round = 0; round < 20; ++round) {
+        QVector<AlertRule> rules;
+        const int ruleCount = 1 + random.bounded(300);
+        for (int i = 0; i < ruleCount; ++i) {
+            rules.append(randomRule(random, i));
+        }
+        const QVector<EarthquakeData> events = randomEvents(random, rules, 2000);
+
+        CompiledAlertRules compiled;
+        compiled.compile(rules);
+        AlertRuleIndex index;
+        index.build(compiled);
+        QCOMPARE(index.ruleCount(), compiled.size());
+
+        const QVector<AlertMatch> linear = compiled.evaluate(events, noRegions);
+        const QVector<AlertMatch> indexed = index.evaluate(compiled, events, noRegions);
+        if (!sameMatches(linear, indexed)) {
+            QFAIL(qPrintable(QString("Round %1: %2 linear matches, %3 indexed")
+                                 .arg(round).arg(linear.size()).arg(indexed.size())));
+        }
+    }
+}
+
+void TestAlertRuleIndex::testEdgeCases() {
+    QVector<AlertRule> rules;
+    AlertRule northPole;
+    northPole.useLocation = true;
+    northPole.centerLatitude = 90.0;
+    northPole.radiusKm = 500.0;
+    rules.append(northPole);
+
+    AlertRule dateLine = northPole;
+    dateLine.centerLatitude = -17.0;
+    dateLine.centerLongitude = 179.8;
+    dateLine.radiusKm = 300.0;
+    rules.append(dateLine);
+
+    AlertRule world = northPole;
+    world.centerLatitude = 0.0;
+    world.radiusKm = 25000.0; // Beyond the antipode: everywhere
+    rules.append(world);
+
+    AlertRule empty;
+    empty.minMagnitude = 6.0;
+    empty.maxMagnitude = 5.0;
+    rules.append(empty);
+
+    CompiledAlertRules compiled;
+    compiled.compile(rules);
+    AlertRuleIndex index;
+    index.build(compiled);
+    QCOMPARE(index.bucketedRuleCount(), 2);
+
+    const QVector<EarthquakeData> events = {
+        makeEvent(89.0, -123.0, 5.0, 10.0),  // Near the pole on the far side
+        makeEvent(-17.0, -179.5, 5.0, 10.0), // Across the antimeridian
+        makeEvent(-17.0, 180.0, 5.0, 10.0),
+        makeEvent(-17.0, -180.0, 5.0, 10.0),
+        makeEvent(-90.0, 0.0, 5.0, 10.0)     // South pole
+    };
+    const QVector<AlertMatch> linear = compiled.evaluate(events, noRegions);
+    QVERIFY(sameMatches(linear, index.evaluate(compiled, events, noRegions)));
+
+    // Pole, world; date line and world for the other three; world alone at the south pole
+    QCOMPARE(linear.size(), 9);
+}
+
+void TestAlertRuleIndex::testBenchmarkSmoke() {
+    // The target load: 100k user rules, each a local cap, against a 1k-event refresh
+    QRandomGenerator random(42);
+    QVector<AlertRule> rules;
+    rules.reserve(100000);
+    for (int i = 0; i < 100000; ++i) {
+        rules.append(localRule(random, i));
+    }
+    const QVector<EarthquakeData> events = randomEvents(random, rules, 1000);
+
+    CompiledAlertRules compiled;
+    compiled.compile(rules);
+
+    QElapsedTimer timer;
+    timer.start();
+    AlertRuleIndex index;
+    index.build(compiled);
+    const qint64 buildMs = timer.restart();
+    const QVector<AlertMatch> indexed = index.evaluate(compiled, events, noRegions);
+    const qint64 indexMs = timer.elapsed();
+
+    qDebug() << "1k events x 100k rules:" << indexed.size() << "matches in" << indexMs << "ms plus"
+             << buildMs << "ms build," << index.bucketedRuleCount() << "rules bucketed";
+    // Generous, so that debug and sanitizer builds pass too
+    QVERIFY2(indexMs < 1000, qPrintable(QString("%1 ms").arg(indexMs)));
+
+    // The linear scan costs rules x events, so check it against a slice only
+    const QVector<EarthquakeData> slice = events.mid(0, 100);
+    QVERIFY(sameMatches(compiled.evaluate(slice, noRegions), index.evaluate(compiled, slice, noRegions)));
+}
+
+QTEST_MAIN(TestAlertRuleIndex)
+#include "testalertruleindex.moc"
@@ -0,0 +1,160 @@
+#include "async_log_writer.hpp"
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTemporaryDir>
+#include <QSignalSpy>
+#include <QTest>
+
+// Declare the test class
+class TestAsyncLogWriter : public QObject {
+    Q_OBJECT
+private slots:
+    void testSegmentOrder();
+    void testQueryRange();
+    void testQueryWithoutFlush();
+    void testRotationAndCompression();
+};
+
+static QJsonObject makeRecord(int n, const QString &ts = QString()) {
+    QJsonObject record;
+    record.insert("n", n);
+    if (!ts.isEmpty()) record.insert(AsyncLogWriter::TIMESTAMP_KEY, ts);
+    return record;
+}
+
+static void writeSegment(const QDir &dir, const QString &name, int n, const QString &ts) {
+    QByteArray line = QJsonDocument(makeRecord(n, ts)).toJson(QJsonDocument::Compact) + '\n';
+    if (name.endsWith(AsyncLogWriter::COMPRESSED_SUFFIX)) line = qCompress(line);
+    QFile file(dir.filePath(name));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(line);
+}
+
+static QList<int> numbers(const QVector<QJsonObject> &records) {
+    QList<int> result;
+    for (const QJsonObject &record : records) result.append(record.value("n").toInt());
+    return result;
+}
+
+// Rotated segments of a "log" writer, the -10 duplicate last among its start time
+static void writeSegments(const QDir &dir) {
+    writeSegment(dir, "log-20240101-000000-000-10.jsonl", 10, "2024-01-01T00:00:00.000Z");
+    writeSegment(dir, "log-20240101-000000-000-2.jsonl", 2, "2024-01-01T00:00:00.000Z");
+    writeSegment(dir, "log-20240101-000000-000.jsonl", 0, "2024-01-01T00:00:00.000Z");
+    writeSegment(dir, "log-20240101-000000-000-1.jsonl.qz", 1, "2024-01-01T00:00:00.000Z");
+    writeSegment(dir, "log-20240102-000000-000.jsonl.qz", 11, "2024-01-02T00:00:00.000Z");
+    writeSegment(dir, "log.jsonl", 12, "2024-01-03T00:00:00.000Z");
+    writeSegment(dir, "other-20240101-000000-000.jsonl", 99, "2024-01-01T00:00:00.000Z");
+}
+
+void TestAsyncLogWriter::testSegmentOrder() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    writeSegments(QDir(dir.path()));
+
+    AsyncLogWriter::Options options;
+    options.directory = dir.path();
+    AsyncLogWriter writer(options);
+
+    QStringList names;
+    for (const QString &path : writer.rotatedSegmentPaths()) names.append(QFileInfo(path).fileName());
+    const QStringList expected = {
+        "log-20240101-000000-000.jsonl", "log-20240101-000000-000-1.jsonl.qz", "log-20240101-000000-000-2.jsonl",
+        "log-20240101-000000-000-10.jsonl", "log-20240102-000000-000.jsonl.qz"
+    };
+    QCOMPARE(names, expected);
+
+    // The active segment from a previous run is read before the writer starts
+    QCOMPARE(numbers(writer.query(QDateTime(), QDateTime())), (QList<int>{0, 1, 2, 10, 11, 12}));
+}
+
+void TestAsyncLogWriter::testQueryRange() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    writeSegments(QDir(dir.path()));
+
+    AsyncLogWriter::Options options;
+    options.directory = dir.path();
+    AsyncLogWriter writer(options);
+
+    const QDateTime second = QDateTime::fromString("2024-01-02T00:00:00.000Z", Qt::ISODateWithMs);
+    const QDateTime third = QDateTime::fromString("2024-01-03T00:00:00.000Z", Qt::ISODateWithMs);
+    QCOMPARE(numbers(writer.query(second, QDateTime())), (QList<int>{11, 12}));
+    QCOMPARE(numbers(writer.query(QDateTime(), second)), (QList<int>{0, 1, 2, 10, 11}));
+    QCOMPARE(numbers(writer.query(third, third)), QList<int>{12});
+    QCOMPARE(numbers(writer.query(QDateTime(), QDateTime(), {}, 3)), (QList<int>{0, 1, 2}));
+
+    auto even = [](const QJsonObject &record) { return record.value("n").toInt() % 2 == 0; };
+    QCOMPARE(numbers(writer.query(QDateTime(), QDateTime(), even)), (QList<int>{0, 2, 10, 12}));
+}
+
+void TestAsyncLogWriter::testQueryWithoutFlush() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    AsyncLogWriter::Options options;
+    options.directory = dir.path();
+    options.flushIntervalMs = 60000; // The writer stays asleep for the whole test
+    AsyncLogWriter writer(options);
+    writer.start();
+
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(writer.append(makeRecord(i)));
+    }
+
+    // Answered from the buffer; the writer has not been woken
+    QCOMPARE(numbers(writer.query(QDateTime(), QDateTime())), (QList<int>{0, 1, 2, 3, 4}));
+    QCOMPARE(writer.writtenRecords(), quint64(0));
+
+    // Once written, the same records come from disk, exactly once
+    writer.flush();
+    QCOMPARE(writer.writtenRecords(), quint64(5));
+    QVERIFY(writer.append(makeRecord(5)));
+    QCOMPARE(numbers(writer.query(QDateTime(), QDateTime())), (QList<int>{0, 1, 2, 3, 4, 5}));
+}
+
+void TestAsyncLogWriter::testRotationAndCompression() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    AsyncLogWriter::Options options;
+    options.directory = dir.path();
+    options.maxSegmentBytes = 256;
+    options.flushIntervalMs = 60000; // One batch, and one rotation, per flush
+    options.keepSegments = 3;
+    AsyncLogWriter writer(options);
+    QSignalSpy rotations(&writer, &AsyncLogWriter::segmentRotated);
+    writer.start();
+
+    // Every flushed group overflows the segment and rotates it
+    for (int group = 0; group < 10; ++group) {
+        for (int i = 0; i < 10; ++i) {
+            QVERIFY(writer.append(makeRecord(group * 10 + i)));
+        }
+        writer.flush();
+    }
+    QTRY_COMPARE(rotations.count(), 10);
+    QCOMPARE(writer.writtenRecords(), quint64(100));
+    QCOMPARE(writer.droppedRecords(), quint64(0));
+
+    // Only the newest segments are kept, each compressed
+    const QStringList rotated = writer.rotatedSegmentPaths();
+    QCOMPARE(rotated.size(), 3);
+    for (const QString &path : rotated) {
+        QVERIFY(path.endsWith(".jsonl" + AsyncLogWriter::COMPRESSED_SUFFIX));
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        const QByteArray data = qUncompress(file.readAll());
+        QCOMPARE(data.count('\n'), 10);
+    }
+    QCOMPARE(QFileInfo(writer.currentSegmentPath()).size(), qint64(0));
+
+    QList<int> expected;
+    for (int n = 70; n < 100; ++n) expected.append(n);
+    QCOMPARE(numbers(writer.query(QDateTime(), QDateTime())), expected);
+}
+
+QTEST_MAIN(TestAsyncLogWriter)
+#include "testasynclogwriter.moc"
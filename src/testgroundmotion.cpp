@@ -0,0 +1,205 @@
+#include "ground_motion.hpp"
+#include "spatial_utils.hpp"
+
+#include <QtCore/QRandomGenerator>
+#include <QTest>
+
+// Declare the test class
+class TestGroundMotion : public QObject {
+    Q_OBJECT
+private slots:
+    void testReferenceIntensity();
+    void testReferencePga();
+    void testMercalliClass();
+    void testGridMatchesModel();
+    void testGridAcrossAntimeridian();
+    void testCacheInvalidation();
+    void testCacheEviction();
+};
+
+static EarthquakeData makeEvent(const QString &id, double magnitude, double depth, double lat, double lon) {
+    EarthquakeData eq;
+    eq.eventId = id;
+    eq.latitude = lat;
+    eq.longitude = lon;
+    eq.magnitude = magnitude;
+    eq.depth = depth;
+    eq.alertLevel = 0;
+    return eq;
+}
+
+static double modelIntensity(const EarthquakeData &eq, double lat, double lon) {
+    const double epicentral = SpatialUtils::haversineDistance(lat, lon, eq.latitude, eq.longitude);
+    return GroundMotionModel::intensity(eq.magnitude, GroundMotionModel::hypocentralDistance(epicentral, eq.depth));
+}
+
+void TestGroundMotion::testReferenceIntensity() {
+    // Atkinson, Worden & Wald (2014), equation 4 with its published coefficients
+    struct Case { double magnitude; double hypocentralKm; double mmi; };
+    const Case cases[] = {
+        {5.0, 10.0, 5.9648},
+        {6.0, 20.0, 6.1750},
+        {7.0, 50.0, 5.7644},
+        {7.0, 200.0, 3.9609},
+        {8.0, 100.0, 5.8778},
+        {6.5, 400.0, 2.3182},
+    };
+    for (const Case &c : cases) {
+        const double mmi = GroundMotionModel::intensity(c.magnitude, c.hypocentralKm);
+        QVERIFY2(qAbs(mmi - c.mmi) < 1e-3, qPrintable(QString("M%1 at %2 km: %3").arg(c.magnitude).arg(c.hypocentralKm).arg(mmi)));
+    }
+
+    // Never negative far out
+    QCOMPARE(GroundMotionModel::intensity(4.5, 1000.0), 0.0);
+
+    // Saturates toward the source instead of growing without bound
+    QVERIFY(qAbs(GroundMotionModel::intensity(7.0, 0.0) - GroundMotionModel::intensity(7.0, 1.0)) < 0.01);
+}
+
+void TestGroundMotion::testReferencePga() {
+    // Worden et al. (2012) inverted, PGA in %g
+    struct Case { double mmi; double pga; };
+    const Case cases[] = {
+        {3.0, 0.62456},
+        {4.22, 3.82536},
+        {6.0, 11.54871},
+        {8.0, 40.0935},
+    };
+    for (const Case &c : cases) {
+        const double pga = GroundMotionModel::pgaFromIntensity(c.mmi);
+        QVERIFY2(qAbs(pga - c.pga) < c.pga * 1e-4, qPrintable(QString("MMI %1: %2").arg(c.mmi).arg(pga)));
+    }
+
+    // The two segments meet at T2
+    QVERIFY(qAbs(GroundMotionModel::pgaFromIntensity(4.2199) / GroundMotionModel::pgaFromIntensity(4.2201) - 1.0) < 0.01);
+}
+
+void TestGroundMotion::testMercalliClass() {
+    QCOMPARE(GroundMotionModel::mercalliClass(0.0), 1);
+    QCOMPARE(GroundMotionModel::mercalliClass(4.49), 4);
+    QCOMPARE(GroundMotionModel::mercalliClass(4.5), 5);
+    QCOMPARE(GroundMotionModel::mercalliClass(13.0), 12);
+}
+
+void TestGroundMotion::testGridMatchesModel() {
+    const EarthquakeData events[] = {
+        makeEvent("a", 6.0, 10.0, 35.0, 139.0),
+        makeEvent("b", 7.5, 30.0, -20.0, -70.0),
+        makeEvent("c", 5.0, 5.0, 60.0, -150.0),
+    };
+    for (const EarthquakeData &eq : events) {
+        std::shared_ptr<ShakeGrid> grid = GroundMotionEngine::computeGrid(eq);
+        QVERIFY(grid);
+        QCOMPARE(grid->rows, GroundMotionEngine::GRID_SIZE);
+        QCOMPARE(int(grid->intensity.size()), GroundMotionEngine::GRID_SIZE * GroundMotionEngine::GRID_SIZE);
+        QVERIFY(qAbs(grid->maxIntensity - GroundMotionModel::intensity(eq.magnitude, eq.depth)) < 1e-4);
+
+        // Grid nodes carry the model value, up to the profile table and float rounding
+        for (int r = 0; r < grid->rows; r += 5) {
+            for (int c = 0; c < grid->columns; c += 5) {
+                const double lat = grid->southLatitude + r * grid->latitudeStep;
+                const double lon = grid->westLongitude + c * grid->longitudeStep;
+                const double cell = grid->intensity[r * grid->columns + c];
+                QVERIFY2(qAbs(cell - modelIntensity(eq, lat, lon)) < 0.01,
+                         qPrintable(QString("%1 row %2 column %3").arg(eq.eventId).arg(r).arg(c)));
+            }
+        }
+
+        // Between nodes, bilinear interpolation stays close to the model
+        QRandomGenerator rng(88);
+        for (int i = 0; i < 2000; ++i) {
+            const double lat = grid->southLatitude + rng.generateDouble() * (grid->northLatitude() - grid->southLatitude);
+            const double lon = grid->westLongitude + rng.generateDouble() * (grid->eastLongitude() - grid->westLongitude);
+            QVERIFY(grid->contains(lat, lon));
+            QVERIFY(qAbs(grid->intensityAt(lat, lon) - modelIntensity(eq, lat, lon)) < 0.05);
+            QCOMPARE(grid->pgaAt(lat, lon), GroundMotionModel::pgaFromIntensity(grid->intensityAt(lat, lon)));
+        }
+
+        // The grid covers the area reaching MIN_GRID_INTENSITY
+        const double edge = modelIntensity(eq, grid->northLatitude(), eq.longitude);
+        QVERIFY(edge < GroundMotionEngine::MIN_GRID_INTENSITY + 0.05);
+        QCOMPARE(grid->intensityAt(grid->northLatitude() + 1.0, eq.longitude), 0.0);
+        QCOMPARE(grid->pgaAt(grid->northLatitude() + 1.0, eq.longitude), 0.0);
+    }
+}
+
+void TestGroundMotion::testGridAcrossAntimeridian() {
+    const EarthquakeData eq = makeEvent("fiji", 7.0, 20.0, -18.0, 179.5);
+    std::shared_ptr<ShakeGrid> grid = GroundMotionEngine::computeGrid(eq);
+    QVERIFY(grid);
+    QVERIFY(grid->eastLongitude() > 180.0);
+
+    for (double lon : {179.0, 179.9, -179.9, -179.0, -178.0}) {
+        QVERIFY(grid->contains(eq.latitude, lon));
+        QVERIFY(qAbs(grid->intensityAt(eq.latitude, lon) - modelIntensity(eq, eq.latitude, lon)) < 0.05);
+        QVERIFY(qAbs(grid->intensityAt(eq.latitude, lon) - grid->intensityAt(eq.latitude, lon + 360.0)) < 1e-9);
+    }
+    QVERIFY(!grid->contains(eq.latitude, 0.0));
+}
+
+void TestGroundMotion::testCacheInvalidation() {
+    GroundMotionEngine engine;
+    EarthquakeData eq = makeEvent("us1", 6.2, 12.0, 38.0, 142.0);
+
+    std::shared_ptr<const ShakeGrid> first = engine.gridFor(eq);
+    QVERIFY(first);
+    QVERIFY(engine.gridFor(eq) == first);
+    QCOMPARE(engine.cachedGridCount(), 1);
+
+    // Each revised parameter replaces the cached grid under the same id
+    eq.magnitude = 6.4;
+    std::shared_ptr<const ShakeGrid> revised = engine.gridFor(eq);
+    QVERIFY(revised && revised != first);
+    QCOMPARE(revised->magnitude, 6.4);
+    QVERIFY(revised->maxIntensity > first->maxIntensity);
+    QVERIFY(engine.gridFor(eq) == revised);
+
+    eq.depth = 40.0;
+    std::shared_ptr<const ShakeGrid> deeper = engine.gridFor(eq);
+    QVERIFY(deeper != revised);
+    QCOMPARE(deeper->depth, 40.0);
+
+    eq.latitude = 38.5;
+    eq.longitude = 142.5;
+    std::shared_ptr<const ShakeGrid> moved = engine.gridFor(eq);
+    QVERIFY(moved != deeper);
+    QCOMPARE(moved->latitude, 38.5);
+    QCOMPARE(moved->longitude, 142.5);
+    QCOMPARE(engine.cachedGridCount(), 1);
+
+    // Other fields are not part of the revision
+    eq.place = "Off the east coast";
+    eq.alertLevel = 2;
+    QVERIFY(engine.gridFor(eq) == moved);
+
+    // intensityAt reads the current grid, and the model outside it
+    QCOMPARE(engine.intensityAt(eq, 38.6, 142.4), moved->intensityAt(38.6, 142.4));
+    QCOMPARE(engine.intensityAt(eq, -38.0, 142.0), modelIntensity(eq, -38.0, 142.0));
+
+    // Small events and events without an id are never cached
+    QVERIFY(!engine.gridFor(makeEvent("small", 4.0, 10.0, 0.0, 0.0)));
+    QVERIFY(engine.gridFor(makeEvent(QString(), 6.0, 10.0, 0.0, 0.0)));
+    QCOMPARE(engine.cachedGridCount(), 1);
+
+    engine.clear();
+    QCOMPARE(engine.cachedGridCount(), 0);
+    QVERIFY(engine.gridFor(eq) != moved);
+}
+
+void TestGroundMotion::testCacheEviction() {
+    GroundMotionEngine engine(2);
+    const EarthquakeData a = makeEvent("a", 5.5, 10.0, 0.0, 0.0);
+    const EarthquakeData b = makeEvent("b", 5.5, 10.0, 10.0, 10.0);
+    const EarthquakeData c = makeEvent("c", 5.5, 10.0, 20.0, 20.0);
+
+    std::shared_ptr<const ShakeGrid> gridA = engine.gridFor(a);
+    std::shared_ptr<const ShakeGrid> gridB = engine.gridFor(b);
+    QVERIFY(engine.gridFor(a) == gridA); // b is now the least recently used
+    engine.gridFor(c);
+    QCOMPARE(engine.cachedGridCount(), 2);
+    QVERIFY(engine.gridFor(a) == gridA);
+    QVERIFY(engine.gridFor(b) != gridB);
+}
+
+QTEST_MAIN(TestGroundMotion)
+#include "testgroundmotion.moc"
@@ -0,0 +1,269 @@
+#include "http_delivery_channel.hpp"
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTimer>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+#include <QSignalSpy>
+#include <QTest>
+#include <memory>
+
+// Local stand-in for an email/SMS/push service. Answers each POST with the
+// next scripted status and body, then with the defaults, after responseDelayMs.
+class StubHttpServer : public QTcpServer {
+public:
+    QList<int> script;
+    QList<QByteArray> bodyScript;
+    int defaultStatus = 200;
+    int responseDelayMs = 0;
+
+    QVector<QJsonObject> requests;
+    int connectionCount = 0;
+    int maxConcurrent = 0;
+
+    StubHttpServer() {
+        connect(this, &QTcpServer::newConnection, this, [this]() {
+            while (hasPendingConnections()) {
+                serve(nextPendingConnection());
+            }
+        });
+        listen(QHostAddress::LocalHost, 0);
+    }
+
+    QUrl url() const { return QUrl(QString("http://127.0.0.1:%1/send").arg(serverPort())); }
+
+    // Recipients of every request, in arrival order
+    QStringList recipients(int request) const {
+        QStringList result;
+        for (const QJsonValue &message : requests[request].value("messages").toArray()) {
+            for (const QJsonValue &recipient : message.toObject().value("recipients").toArray()) {
+                result.append(recipient.toString());
+            }
+        }
+        return result;
+    }
+
+private:
+    void serve(QTcpSocket *socket) {
+        ++connectionCount;
+        auto buffer = std::make_shared<QByteArray>();
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, socket, [this, socket, buffer]() {
+            buffer->append(socket->readAll());
+            for (;;) {
+                const qsizetype headerEnd = buffer->indexOf("\r\n\r\n");
+                if (headerEnd < 0) {
+                    return;
+                }
+                qsizetype length = 0;
+                for (const QByteArray &line : buffer->left(headerEnd).split('\n')) {
+                    if (line.toLower().startsWith("content-length:")) {
+                        length = line.mid(15).trimmed().toLongLong();
+                    }
+                }
+                if (buffer->size() < headerEnd + 4 + length) {
+                    return;
+                }
+                requests.append(QJsonDocument::fromJson(buffer->mid(headerEnd + 4, length)).object());
+                buffer->remove(0, headerEnd + 4 + length);
+
+                const int status = script.isEmpty() ? defaultStatus : script.takeFirst();
+                const QByteArray body = bodyScript.isEmpty() ? QByteArray("{}") : bodyScript.takeFirst();
+                maxConcurrent = std::max(maxConcurrent, ++m_open);
+                QTimer::singleShot(responseDelayMs, socket, [this, socket, status, body]() {
+                    --m_open;
+                    socket->write(QString("HTTP/1.1 %1 Stub\r\nContent-Type: application/json\r\n"
+                                          "Content-Length: %2\r\nConnection: keep-alive\r\n\r\n")
+                                      .arg(status).arg(body.size()).toLatin1() + body);
+                });
+            }
+        });
+    }
+
+    int m_open = 0;
+};
+
+class TestHttpDeliveryChannel : public QObject {
+    Q_OBJECT
+private slots:
+    void init();
+    void testBatchesRecipients();
+    void testInFlightWindow();
+    void testRetriesTransientFailures();
+    void testRetriesFailedRecipients();
+    void testDeadLettersAndReplay();
+    void testGivesUpAfterMaxAttempts();
+    void testBackpressure();
+
+private:
+    HttpDeliveryChannel::Config config(const QUrl &endpoint) const;
+    static QVector<OutboundMessage> fanOut(const QString &notificationId, int recipients);
+
+    std::unique_ptr<QTemporaryDir> m_dir;
+};
+
+void TestHttpDeliveryChannel::init() {
+    m_dir = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_dir->isValid());
+}
+
+HttpDeliveryChannel::Config TestHttpDeliveryChannel::config(const QUrl &endpoint) const {
+    HttpDeliveryChannel::Config config;
+    config.name = "test";
+    config.endpoint = endpoint;
+    config.flushDelayMs = 0;
+    config.initialBackoffMs = 20;
+    config.maxBackoffMs = 100;
+    config.deadLetterPath = m_dir->filePath("deadletter.jsonl");
+    return config;
+}
+
+QVector<OutboundMessage> TestHttpDeliveryChannel::fanOut(const QString &notificationId, int recipients) {
+    QVector<OutboundMessage> messages;
+    for (int i = 0; i < recipients; ++i) {
+        OutboundMessage message;
+        message.notificationId = notificationId;
+        message.recipient = QString("user%1@example.com").arg(i);
+        message.payload["subject"] = "M7.1 near the coast";
+        messages.append(message);
+    }
+    return messages;
+}
+
+void TestHttpDeliveryChannel::testBatchesRecipients() {
+    StubHttpServer server;
+    HttpDeliveryChannel channel(config(server.url()));
+    QSignalSpy delivered(&channel, &HttpDeliveryChannel::batchDelivered);
+
+    QCOMPARE(channel.enqueue(fanOut("quake", 250)), 250);
+    QTRY_COMPARE(delivered.count(), 3);
+    QCOMPARE(channel.pendingCount(), 0);
+
+    QCOMPARE(server.requests.size(), 3);
+    int total = 0;
+    for (int i = 0; i < server.requests.size(); ++i) {
+        // One grouped entry per notification, carrying the shared payload once
+        const QJsonArray messages = server.requests[i].value("messages").toArray();
+        QCOMPARE(messages.size(), 1);
+        QCOMPARE(messages[0].toObject().value("notificationId").toString(), QString("quake"));
+        QCOMPARE(messages[0].toObject().value("payload").toObject().value("subject").toString(),
+                 QString("M7.1 near the coast"));
+        total += server.recipients(i).size();
+    }
+    QCOMPARE(server.recipients(0).size(), 100);
+    QCOMPARE(total, 250);
+}
+
+void TestHttpDeliveryChannel::testInFlightWindow() {
+    StubHttpServer server;
+    server.responseDelayMs = 50;
+    HttpDeliveryChannel::Config cfg = config(server.url());
+    cfg.batchSize = 10;
+    cfg.maxInFlight = 2;
+    HttpDeliveryChannel channel(cfg);
+    QSignalSpy idle(&channel, &HttpDeliveryChannel::idle);
+
+    channel.enqueue(fanOut("quake", 100));
+    QTRY_VERIFY(channel.inFlightCount() > 0);
+    QVERIFY(channel.inFlightCount() <= 2);
+    QTRY_VERIFY(idle.count() > 0 && channel.pendingCount() == 0 && channel.inFlightCount() == 0);
+
+    QCOMPARE(server.requests.size(), 10);
+    QCOMPARE(server.maxConcurrent, 2);
+    // Ten requests over kept-alive connections, not one connection each
+    QVERIFY(server.connectionCount <= 2);
+}
+
+void TestHttpDeliveryChannel::testRetriesTransientFailures() {
+    StubHttpServer server;
+    server.script = {503, 429};
+    HttpDeliveryChannel channel(config(server.url()));
+    QSignalSpy delivered(&channel, &HttpDeliveryChannel::batchDelivered);
+    QSignalSpy retrying(&channel, &HttpDeliveryChannel::messageRetrying);
+    QSignalSpy failed(&channel, &HttpDeliveryChannel::messageFailed);
+
+    channel.enqueue(fanOut("quake", 5));
+    QTRY_COMPARE(delivered.count(), 1);
+    QCOMPARE(delivered.first().first().toInt(), 5);
+    QCOMPARE(server.requests.size(), 3);
+    QCOMPARE(retrying.count(), 10);
+    QCOMPARE(retrying.last().at(2).toInt(), 2);
+    QCOMPARE(failed.count(), 0);
+}
+
+void TestHttpDeliveryChannel::testRetriesFailedRecipients() {
+    StubHttpServer server;
+    server.bodyScript = {R"({"failed": ["user1@example.com"]})"};
+    HttpDeliveryChannel channel(config(server.url()));
+    QSignalSpy delivered(&channel, &HttpDeliveryChannel::batchDelivered);
+
+    channel.enqueue(fanOut("quake", 3));
+    QTRY_COMPARE(delivered.count(), 1);
+    QCOMPARE(delivered.first().first().toInt(), 2);
+
+    QTRY_COMPARE(delivered.count(), 2);
+    QCOMPARE(server.recipients(1), QStringList{"user1@example.com"});
+}
+
+void TestHttpDeliveryChannel::testDeadLettersAndReplay() {
+    StubHttpServer server;
+    server.defaultStatus = 400;
+    HttpDeliveryChannel channel(config(server.url()));
+    QSignalSpy failed(&channel, &HttpDeliveryChannel::messageFailed);
+    QSignalSpy delivered(&channel, &HttpDeliveryChannel::batchDelivered);
+
+    channel.enqueue(fanOut("quake", 3));
+    QTRY_COMPARE(failed.count(), 3);
+    // Permanent errors are not retried
+    QCOMPARE(server.requests.size(), 1);
+    QCOMPARE(failed.first().at(0).toString(), QString("quake"));
+    QCOMPARE(failed.first().at(2).toString(), QString("HTTP 400"));
+
+    QFile file(m_dir->filePath("deadletter.jsonl"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QList<QByteArray> lines = file.readAll().trimmed().split('\n');
+    file.close();
+    QCOMPARE(lines.size(), 3);
+    const QJsonObject record = QJsonDocument::fromJson(lines[0]).object();
+    QCOMPARE(record.value("recipient").toString(), QString("user0@example.com"));
+    QCOMPARE(record.value("attempts").toInt(), 1);
+    QCOMPARE(record.value("payload").toObject().value("subject").toString(), QString("M7.1 near the coast"));
+
+    server.defaultStatus = 200;
+    QCOMPARE(channel.replayDeadLetters(), 3);
+    QTRY_COMPARE(delivered.count(), 1);
+    QCOMPARE(server.recipients(1).size(), 3);
+    QCOMPARE(QFileInfo(file).size(), 0);
+}
+
+void TestHttpDeliveryChannel::testGivesUpAfterMaxAttempts() {
+    StubHttpServer server;
+    server.defaultStatus = 503;
+    HttpDeliveryChannel::Config cfg = config(server.url());
+    cfg.maxAttempts = 3;
+    HttpDeliveryChannel channel(cfg);
+    QSignalSpy failed(&channel, &HttpDeliveryChannel::messageFailed);
+
+    channel.enqueue(fanOut("quake", 2));
+    QTRY_COMPARE(failed.count(), 2);
+    QCOMPARE(server.requests.size(), 3);
+    QCOMPARE(channel.pendingCount(), 0);
+}
+
+void TestHttpDeliveryChannel::testBackpressure() {
+    // No endpoint: nothing leaves the queue
+    HttpDeliveryChannel::Config cfg = config(QUrl());
+    cfg.maxQueued = 10;
+    HttpDeliveryChannel channel(cfg);
+
+    QCOMPARE(channel.enqueue(fanOut("quake", 15)), 10);
+    QVERIFY(!channel.enqueue(fanOut("aftershock", 1).first()));
+    QCOMPARE(channel.pendingCount(), 10);
+}
+
+QTEST_MAIN(TestHttpDeliveryChannel)
+#include "testhttpdeliverychannel.moc"
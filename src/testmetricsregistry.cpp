@@ -0,0 +1,173 @@
+#include "metrics_registry.hpp"
+
+#include <QtCore/QRandomGenerator>
+#include <QTest>
+#include <limits>
+
+// Declare the test class
+class TestMetricsRegistry : public QObject {
+    Q_OBJECT
+private slots:
+    void testExactBuckets();
+    void testBucketBoundaries();
+    void testRelativePrecision();
+    void testPercentiles();
+    void testCountAtOrBelow();
+    void testPrometheusText();
+    void testLabelEscaping();
+};
+
+void TestMetricsRegistry::testExactBuckets() {
+    for (int v = 0; v < LatencyHistogram::SUB_BUCKET_COUNT; ++v) {
+        QCOMPARE(LatencyHistogram::bucketIndex(v), v);
+        QCOMPARE(LatencyHistogram::bucketUpperBound(v), qint64(v));
+    }
+
+    // Then 16 linear sub-buckets per power of two: 32 and 33 share a bucket
+    QCOMPARE(LatencyHistogram::bucketIndex(32), 32);
+    QCOMPARE(LatencyHistogram::bucketIndex(33), 32);
+    QCOMPARE(LatencyHistogram::bucketIndex(34), 33);
+    QCOMPARE(LatencyHistogram::bucketUpperBound(32), qint64(33));
+    QCOMPARE(LatencyHistogram::bucketIndex(64), 48);
+    QCOMPARE(LatencyHistogram::bucketUpperBound(48), qint64(67));
+
+    // Out of range values are clamped to the first and last bucket
+    QCOMPARE(LatencyHistogram::bucketIndex(-5), 0);
+    QCOMPARE(LatencyHistogram::bucketIndex(LatencyHistogram::MAX_TRACKABLE_US), LatencyHistogram::BUCKET_COUNT - 1);
+    QCOMPARE(LatencyHistogram::bucketIndex(std::numeric_limits<qint64>::max()), LatencyHistogram::BUCKET_COUNT - 1);
+    QCOMPARE(LatencyHistogram::bucketUpperBound(LatencyHistogram::BUCKET_COUNT - 1), LatencyHistogram::MAX_TRACKABLE_US);
+}
+
+void TestMetricsRegistry::testBucketBoundaries() {
+    // Buckets tile the range: each upper bound maps back to its own bucket
+    // and the next value starts the following one
+    for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+        const qint64 upper = LatencyHistogram::bucketUpperBound(i);
+        QCOMPARE(LatencyHistogram::bucketIndex(upper), i);
+        if (i + 1 < LatencyHistogram::BUCKET_COUNT) {
+            QCOMPARE(LatencyHistogram::bucketIndex(upper + 1), i + 1);
+            QVERIFY(LatencyHistogram::bucketUpperBound(i + 1) > upper);
+        }
+    }
+}
+
+void TestMetricsRegistry::testRelativePrecision() {
+    QRandomGenerator rng(76);
+    for (int i = 0; i < 100000; ++i) {
+        const qint64 v = qint64(rng.bounded(quint64(LatencyHistogram::MAX_TRACKABLE_US) + 1));
+        const int index = LatencyHistogram::bucketIndex(v);
+        const qint64 upper = LatencyHistogram::bucketUpperBound(index);
+        const qint64 lower = index == 0 ? 0 : LatencyHistogram::bucketUpperBound(index - 1) + 1;
+        QVERIFY(lower <= v && v <= upper);
+        QVERIFY(double(upper - lower) <= double(lower) / 16.0 + 1.0);
+    }
+}
+
+void TestMetricsRegistry::testPercentiles() {
+    LatencyHistogram histogram;
+    QCOMPARE(histogram.percentile(50.0), qint64(0));
+    QCOMPARE(histogram.min(), qint64(0));
+
+    for (qint64 v = 1; v <= 1000; ++v) histogram.record(v * 1000);
+    QCOMPARE(histogram.count(), qint64(1000));
+    QCOMPARE(histogram.min(), qint64(1000));
+    QCOMPARE(histogram.max(), qint64(1000000));
+    QCOMPARE(histogram.mean(), 500500.0);
+
+    // Reported as bucket upper bounds, never beyond the maximum
+    for (double percent : {1.0, 50.0, 90.0, 99.0}) {
+        const double exact = percent * 10000.0;
+        const qint64 reported = histogram.percentile(percent);
+        QVERIFY2(reported >= exact && reported <= exact * 1.07, qPrintable(QString::number(reported)));
+    }
+    QCOMPARE(histogram.percentile(100.0), qint64(1000000));
+
+    LatencyHistogram other;
+    other.record(5);
+    histogram.merge(other);
+    QCOMPARE(histogram.count(), qint64(1001));
+    QCOMPARE(histogram.min(), qint64(5));
+    QCOMPARE(histogram.countAtOrBelow(31), qint64(1));
+
+    histogram.reset();
+    QCOMPARE(histogram.count(), qint64(0));
+    QCOMPARE(histogram.countAtOrBelow(LatencyHistogram::MAX_TRACKABLE_US), qint64(0));
+}
+
+void TestMetricsRegistry::testCountAtOrBelow() {
+    // 4864..5119 share a bucket with 5000; 4863 and 5120 are outside it
+    LatencyHistogram histogram;
+    for (qint64 v : {4863, 4864, 5000, 5119, 5120}) histogram.record(v);
+    QCOMPARE(LatencyHistogram::bucketIndex(4864), LatencyHistogram::bucketIndex(5000));
+    QCOMPARE(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(5000)), qint64(5119));
+
+    // Nothing at or below the bound is missed; the rest of its bucket comes along
+    QCOMPARE(histogram.countAtOrBelow(4862), qint64(0));
+    QCOMPARE(histogram.countAtOrBelow(4863), qint64(1));
+    QCOMPARE(histogram.countAtOrBelow(4999), qint64(4));
+    QCOMPARE(histogram.countAtOrBelow(5000), qint64(4));
+    QCOMPARE(histogram.countAtOrBelow(5120), qint64(5));
+    QCOMPARE(histogram.countAtOrBelow(-1), qint64(0));
+}
+
+void TestMetricsRegistry::testPrometheusText() {
+    MetricsRegistry registry;
+    registry.describe("api_requests_total", "Requests sent");
+    registry.describe("api_latency_seconds", "Request latency");
+    registry.incrementCounter("api_requests_total", MetricsRegistry::formatLabels({{"source", "usgs"}}), 3);
+    registry.setGauge("api_active", QString(), 2);
+
+    const QString labels = MetricsRegistry::formatLabels({{"stage", "parse"}});
+    // 4990 sits just below the 5 ms bound, in the bucket that straddles it
+    for (qint64 us : {500, 3000, 3000, 4990, 2000000, 100000000}) {
+        registry.recordLatency("api_latency_seconds", labels, us);
+    }
+
+    const QString expected =
+        "# HELP api_requests_total Requests sent\n"
+        "# TYPE api_requests_total counter\n"
+        "api_requests_total{source=\"usgs\"} 3\n"
+        "# TYPE api_active gauge\n"
+        "api_active 2\n"
+        "# HELP api_latency_seconds Request latency\n"
+        "# TYPE api_latency_seconds histogram\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"0.001\"} 1\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"0.005\"} 4\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"0.01\"} 4\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"0.025\"} 4\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"0.05\"} 4\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"0.1\"} 4\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"0.25\"} 4\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"0.5\"} 4\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"1\"} 4\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"2.5\"} 5\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"5\"} 5\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"10\"} 5\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"30\"} 5\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"60\"} 5\n"
+        "api_latency_seconds_bucket{stage=\"parse\",le=\"+Inf\"} 6\n"
+        "api_latency_seconds_sum{stage=\"parse\"} 102.01149\n"
+        "api_latency_seconds_count{stage=\"parse\"} 6\n";
+    QCOMPARE(registry.toPrometheusText(), expected);
+
+    QCOMPARE(registry.counterTotal("api_requests_total"), qint64(3));
+    QCOMPARE(registry.labelSets("api_latency_seconds"), QStringList{labels});
+    QCOMPARE(registry.histogram("api_latency_seconds", labels).count(), qint64(6));
+
+    registry.reset();
+    QCOMPARE(registry.toPrometheusText(), QString());
+}
+
+void TestMetricsRegistry::testLabelEscaping() {
+    QCOMPARE(MetricsRegistry::formatLabels({{"source", "usgs"}, {"stage", "first_byte"}}),
+             QString("source=\"usgs\",stage=\"first_byte\""));
+    QCOMPARE(MetricsRegistry::formatLabels({{"path", "C:\\logs \"a\"\nb"}}),
+             QString("path=\"C:\\\\logs \\\"a\\\"\\nb\""));
+
+    MetricsRegistry registry;
+    registry.incrementCounter("plain_total");
+    QCOMPARE(registry.toPrometheusText(), QString("# TYPE plain_total counter\nplain_total 1\n"));
+}
+
+QTEST_MAIN(TestMetricsRegistry)
+#include "testmetricsregistry.moc"
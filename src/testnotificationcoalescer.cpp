@@ -0,0 +1,271 @@
+#include "notification_coalescer.hpp"
+
+#include <QTest>
+
+// Declare the test class
+class TestNotificationCoalescer : public QObject {
+    Q_OBJECT
+private slots:
+    void testClusterByRadius();
+    void testClusterByTimeWindow();
+    void testMoreSevereBreaksThrough();
+    void testRateLimitedAlertBecomesDigest();
+    void testDigestInterval();
+    void testLaterDigestsAreQuiet();
+    void testClustersExpire();
+    void testPerClusterSchedule();
+};
+
+static const qint64 MINUTE_MS = 60 * 1000;
+static const qint64 HOUR_MS = 60 * MINUTE_MS;
+
+static NotificationData makeNotification(const QString &id,
+                                         NotificationPriority priority = NotificationPriority::Normal,
+                                         const QVector<DeliveryChannel> &channels = {DeliveryChannel::SystemTray}) {
+    NotificationData notification;
+    notification.id = id;
+    notification.type = NotificationType::Warning;
+    notification.priority = priority;
+    notification.channels = channels;
+    notification.sourceEventId = id;
+    return notification;
+}
+
+static EarthquakeData makeEvent(const QString &id, double magnitude,
+                                double lat = 35.0, double lon = 139.0, double depth = 10.0) {
+    EarthquakeData eq;
+    eq.eventId = id;
+    eq.latitude = lat;
+    eq.longitude = lon;
+    eq.magnitude = magnitude;
+    eq.depth = depth;
+    eq.alertLevel = 0;
+    eq.place = "Near " + id;
+    return eq;
+}
+
+void TestNotificationCoalescer::testClusterByRadius() {
+    NotificationCoalescer coalescer(100.0, HOUR_MS, MINUTE_MS);
+    QCOMPARE(coalescer.add(makeNotification("a"), makeEvent("a", 5.0), 0, false).size(), 1);
+
+    // About 50 km away: same cluster, whose first digest goes out right away
+    QVector<NotificationData> deliveries = coalescer.add(makeNotification("b"), makeEvent("b", 4.0, 35.45), 1000, false);
+    QCOMPARE(coalescer.clusterCount(), 1);
+    QCOMPARE(deliveries.size(), 1);
+    QVERIFY(NotificationCoalescer::isDigest(deliveries[0]));
+    QCOMPARE(deliveries[0].id, QString("a-digest"));
+    QCOMPARE(deliveries[0].metadata.value("eventCount").toInt(), 2);
+
+    // About 170 km away: a cluster of its own
+    deliveries = coalescer.add(makeNotification("c"), makeEvent("c", 4.0, 36.5), 2000, false);
+    QCOMPARE(coalescer.clusterCount(), 2);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("c"));
+
+    // Within range of both: joins the nearer one
+    deliveries = coalescer.add(makeNotification("d"), makeEvent("d", 3.0, 35.8), 3000, false);
+    QCOMPARE(coalescer.clusterCount(), 2);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("c-digest"));
+
+    // Under the first epicenter but 290 km deeper: apart in 3D
+    deliveries = coalescer.add(makeNotification("e"), makeEvent("e", 4.0, 35.0, 139.0, 300.0), 4000, false);
+    QCOMPARE(coalescer.clusterCount(), 3);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("e"));
+}
+
+void TestNotificationCoalescer::testClusterByTimeWindow() {
+    NotificationCoalescer coalescer(100.0, HOUR_MS, MINUTE_MS);
+    coalescer.add(makeNotification("a"), makeEvent("a", 5.0), 0, false);
+
+    // The window runs from the cluster's last event
+    QVector<NotificationData> deliveries = coalescer.add(makeNotification("b"), makeEvent("b", 4.0), HOUR_MS, false);
+    QCOMPARE(coalescer.clusterCount(), 1);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("a-digest"));
+
+    deliveries = coalescer.add(makeNotification("c"), makeEvent("c", 4.0), 2 * HOUR_MS, false);
+    QCOMPARE(coalescer.clusterCount(), 1);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("a-digest"));
+
+    deliveries = coalescer.add(makeNotification("d"), makeEvent("d", 4.0), 3 * HOUR_MS + 1, false);
+    QCOMPARE(coalescer.clusterCount(), 2);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("d"));
+}
+
+void TestNotificationCoalescer::testMoreSevereBreaksThrough() {
+    NotificationCoalescer coalescer(100.0, HOUR_MS, MINUTE_MS);
+    QVector<NotificationData> deliveries = coalescer.add(makeNotification("a"), makeEvent("a", 4.0), 0, false);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("a"));
+    QVERIFY(!NotificationCoalescer::isDigest(deliveries[0]));
+
+    deliveries = coalescer.add(makeNotification("b"), makeEvent("b", 3.5), 1000, false);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("a-digest"));
+
+    // Smaller events only update the digest until the interval passes
+    QVERIFY(coalescer.add(makeNotification("c"), makeEvent("c", 3.8), 2000, false).isEmpty());
+
+    // A larger event is delivered on its own immediately
+    deliveries = coalescer.add(makeNotification("d", NotificationPriority::High), makeEvent("d", 5.2), 3000, false);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("d"));
+
+    // Emergencies get through a rate limit, other alerts do not
+    deliveries = coalescer.add(makeNotification("e", NotificationPriority::Emergency), makeEvent("e", 4.5), 4000, true);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("e"));
+    QVERIFY(coalescer.add(makeNotification("f"), makeEvent("f", 6.0), 5000, true).isEmpty());
+
+    QVERIFY(coalescer.takeDueDigest("a-digest", 1000 + MINUTE_MS - 1).isEmpty());
+    deliveries = coalescer.takeDueDigest("a-digest", 1000 + MINUTE_MS);
+    QCOMPARE(deliveries.size(), 1);
+    const NotificationData &digest = deliveries[0];
+    QCOMPARE(digest.id, QString("a-digest"));
+    QCOMPARE(digest.metadata.value("eventCount").toInt(), 6);
+    QCOMPARE(digest.metadata.value("maxMagnitude").toDouble(), 6.0);
+    QCOMPARE(digest.metadata.value("maxEventId").toString(), QString("f"));
+    QCOMPARE(digest.priority, NotificationPriority::Emergency);
+    QCOMPARE(digest.type, NotificationType::Critical);
+    QVERIFY(digest.persistent);
+    QVERIFY(digest.message.startsWith("6 events near Near f, max M6.0"));
+}
+
+void TestNotificationCoalescer::testRateLimitedAlertBecomesDigest() {
+    NotificationCoalescer coalescer(100.0, HOUR_MS, MINUTE_MS);
+    const QVector<NotificationData> deliveries = coalescer.add(makeNotification("a"), makeEvent("a", 4.0), 0, true);
+    QCOMPARE(deliveries.size(), 1);
+    QVERIFY(NotificationCoalescer::isDigest(deliveries[0]));
+    QCOMPARE(deliveries[0].id, QString("a-digest"));
+    QCOMPARE(deliveries[0].message, QString("1 event near Near a, M4.0"));
+    QCOMPARE(deliveries[0].type, NotificationType::Warning);
+    QCOMPARE(deliveries[0].expiryTime, QDateTime::fromMSecsSinceEpoch(HOUR_MS));
+}
+
+void TestNotificationCoalescer::testDigestInterval() {
+    NotificationCoalescer coalescer(100.0, HOUR_MS, MINUTE_MS);
+    coalescer.add(makeNotification("a"), makeEvent("a", 5.0), 0, false);
+    QCOMPARE(coalescer.add(makeNotification("b"), makeEvent("b", 3.0), 1000, false).size(), 1);
+
+    // At most one digest per interval, whether from add() or takeDueDigest()
+    for (qint64 now = 2000; now < 1000 + MINUTE_MS; now += 1000) {
+        QVERIFY(coalescer.add(makeNotification("x"), makeEvent("x", 3.0), now, false).isEmpty());
+        QVERIFY(coalescer.takeDueDigest("a-digest", now).isEmpty());
+    }
+    QVector<NotificationData> deliveries = coalescer.add(makeNotification("y"), makeEvent("y", 3.0), 1000 + MINUTE_MS, false);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].metadata.value("eventCount").toInt(), 62);
+    QVERIFY(deliveries[0].message.endsWith("Over the last 1 min"));
+
+    // Nothing pending, nothing due
+    QVERIFY(coalescer.takeDueDigest("a-digest", 10 * MINUTE_MS).isEmpty());
+
+    // The next update waits for the interval from the last digest
+    QVERIFY(coalescer.add(makeNotification("z"), makeEvent("z", 3.0), 10 * MINUTE_MS, false).size() == 1);
+    QVERIFY(coalescer.add(makeNotification("w"), makeEvent("w", 3.0), 10 * MINUTE_MS + 1, false).isEmpty());
+    QVERIFY(coalescer.takeDueDigest("a-digest", 11 * MINUTE_MS - 1).isEmpty());
+    QCOMPARE(coalescer.takeDueDigest("a-digest", 11 * MINUTE_MS).size(), 1);
+}
+
+void TestNotificationCoalescer::testLaterDigestsAreQuiet() {
+    NotificationCoalescer coalescer(100.0, HOUR_MS, MINUTE_MS);
+    coalescer.add(makeNotification("a", NotificationPriority::High,
+                                   {DeliveryChannel::SystemTray, DeliveryChannel::SoundAlert, DeliveryChannel::EmailAlert}),
+                  makeEvent("a", 5.0), 0, false);
+
+    QVector<NotificationData> deliveries = coalescer.add(
+        makeNotification("b", NotificationPriority::Normal,
+                         {DeliveryChannel::SMSAlert, DeliveryChannel::PushNotification, DeliveryChannel::LogFile}),
+        makeEvent("b", 4.0), 1000, false);
+    QCOMPARE(deliveries.size(), 1);
+    const QVector<DeliveryChannel> all = {
+        DeliveryChannel::SystemTray, DeliveryChannel::SoundAlert, DeliveryChannel::EmailAlert,
+        DeliveryChannel::SMSAlert, DeliveryChannel::PushNotification, DeliveryChannel::LogFile
+    };
+    QCOMPARE(deliveries[0].channels, all);
+    QCOMPARE(deliveries[0].priority, NotificationPriority::High);
+
+    // Updates replace the digest without sound, email, SMS or push
+    QVERIFY(coalescer.add(makeNotification("c"), makeEvent("c", 4.0), 2000, false).isEmpty());
+    deliveries = coalescer.takeDueDigest("a-digest", 1000 + MINUTE_MS);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("a-digest"));
+    QCOMPARE(deliveries[0].channels, (QVector<DeliveryChannel>{DeliveryChannel::SystemTray, DeliveryChannel::LogFile}));
+}
+
+void TestNotificationCoalescer::testClustersExpire() {
+    NotificationCoalescer coalescer(100.0, HOUR_MS, MINUTE_MS);
+    coalescer.add(makeNotification("a"), makeEvent("a", 5.0), 0, false);
+    QVERIFY(coalescer.takeDueDigest("a-digest", HOUR_MS).isEmpty());
+    QCOMPARE(coalescer.clusterCount(), 1);
+    QVERIFY(coalescer.takeDueDigest("a-digest", HOUR_MS + 1).isEmpty());
+    QCOMPARE(coalescer.clusterCount(), 0);
+
+    // A pending digest is delivered before its cluster is dropped
+    coalescer.add(makeNotification("b"), makeEvent("b", 5.0), 0, false);
+    coalescer.add(makeNotification("c"), makeEvent("c", 4.0), 1000, false);
+    coalescer.add(makeNotification("d"), makeEvent("d", 4.0), 2000, false);
+    const qint64 idle = 2000 + HOUR_MS + 1;
+    QVector<NotificationData> deliveries = coalescer.takeDueDigest("b-digest", idle);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].metadata.value("eventCount").toInt(), 3);
+    QCOMPARE(coalescer.clusterCount(), 1);
+    QVERIFY(coalescer.takeDueDigest("b-digest", idle).isEmpty());
+    QCOMPARE(coalescer.clusterCount(), 0);
+
+    // The next event starts over with a new digest
+    coalescer.add(makeNotification("e"), makeEvent("e", 3.0), idle, false);
+    deliveries = coalescer.add(makeNotification("f"), makeEvent("f", 3.0), idle + 1, false);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, QString("e-digest"));
+    QCOMPARE(deliveries[0].metadata.value("eventCount").toInt(), 2);
+
+    coalescer.clear();
+    QCOMPARE(coalescer.clusterCount(), 0);
+}
+
+void TestNotificationCoalescer::testPerClusterSchedule() {
+    NotificationCoalescer coalescer(100.0, HOUR_MS, MINUTE_MS);
+    QString first;
+    QString second;
+    coalescer.add(makeNotification("a"), makeEvent("a", 5.0), 0, false, &first);
+    coalescer.add(makeNotification("b"), makeEvent("b", 5.0, 37.0), 0, false, &second);
+    QCOMPARE(first, QString("a-digest"));
+    QCOMPARE(second, QString("b-digest"));
+
+    // Nothing pending: the cluster next needs attention when it expires
+    QCOMPARE(coalescer.nextDueMs(first), HOUR_MS + 1);
+
+    QString joined;
+    QCOMPARE(coalescer.add(makeNotification("c"), makeEvent("c", 4.0), 1000, false, &joined).size(), 1);
+    QCOMPARE(joined, first);
+    QCOMPARE(coalescer.nextDueMs(first), 1000 + HOUR_MS + 1);
+
+    // A pending update is due one interval after the last digest
+    QVERIFY(coalescer.add(makeNotification("d"), makeEvent("d", 3.0), 2000, false).isEmpty());
+    QCOMPARE(coalescer.nextDueMs(first), 1000 + MINUTE_MS);
+    QVERIFY(coalescer.takeDueDigest(first, 1000 + MINUTE_MS - 1).isEmpty());
+    const QVector<NotificationData> deliveries = coalescer.takeDueDigest(first, 1000 + MINUTE_MS);
+    QCOMPARE(deliveries.size(), 1);
+    QCOMPARE(deliveries[0].id, first);
+    QCOMPARE(deliveries[0].metadata.value("eventCount").toInt(), 3);
+    QCOMPARE(coalescer.nextDueMs(first), 2000 + HOUR_MS + 1);
+
+    // Each cluster is woken and dropped on its own
+    QVERIFY(coalescer.takeDueDigest(second, HOUR_MS + 1).isEmpty());
+    QCOMPARE(coalescer.nextDueMs(second), qint64(-1));
+    QCOMPARE(coalescer.clusterCount(), 1);
+    QVERIFY(coalescer.takeDueDigest(first, HOUR_MS + 1).isEmpty());
+    QCOMPARE(coalescer.clusterCount(), 1);
+    QVERIFY(coalescer.takeDueDigest(first, 2000 + HOUR_MS + 1).isEmpty());
+    QCOMPARE(coalescer.clusterCount(), 0);
+    QCOMPARE(coalescer.nextDueMs(first), qint64(-1));
+    QVERIFY(coalescer.takeDueDigest("missing", 0).isEmpty());
+}
+
+QTEST_MAIN(TestNotificationCoalescer)
+#include "testnotificationcoalescer.moc"
@@ -0,0 +1,210 @@
+#include "notification_delivery_worker.hpp"
+#include "notification_queue.hpp"
+
+#include <QtCore/QThread>
+#include <QTest>
+#include <atomic>
+
+// Declare the test class
+class TestNotificationQueue : public QObject {
+    Q_OBJECT
+private slots:
+    void testCapacity();
+    void testFullLaneRejects();
+    void testPriorityOrder();
+    void testEmergencyBypass();
+    void testBatchedDrain();
+    void testConcurrentProducers();
+};
+
+static NotificationData makeNotification(const QString &id, NotificationPriority priority) {
+    NotificationData notification;
+    notification.id = id;
+    notification.type = NotificationType::Info;
+    notification.priority = priority;
+    return notification;
+}
+
+void TestNotificationQueue::testCapacity() {
+    QCOMPARE(NotificationQueue(1).capacityPerLane(), 2);
+    QCOMPARE(NotificationQueue(5).capacityPerLane(), 8);
+    QCOMPARE(NotificationQueue(64).capacityPerLane(), 64);
+}
+
+void TestNotificationQueue::testFullLaneRejects() {
+    NotificationQueue queue(4);
+    const int normal = NotificationQueue::laneFor(NotificationPriority::Normal);
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(queue.tryPush(makeNotification(QString::number(i), NotificationPriority::Normal), 0));
+    }
+    QVERIFY(!queue.tryPush(makeNotification("4", NotificationPriority::Normal), 0));
+    QCOMPARE(queue.size(normal), 4);
+    QCOMPARE(queue.pushedCount(normal), quint64(4));
+    QCOMPARE(queue.rejectedCount(normal), quint64(1));
+
+    // Other lanes are unaffected, and queued notifications are never evicted
+    QVERIFY(queue.tryPush(makeNotification("h", NotificationPriority::High), 0));
+    NotificationData notification;
+    qint64 enqueuedAtUs = 0;
+    QVERIFY(queue.tryPop(notification, enqueuedAtUs));
+    QCOMPARE(notification.id, QString("h"));
+    QVERIFY(queue.tryPop(notification, enqueuedAtUs));
+    QCOMPARE(notification.id, QString("0"));
+
+    // A popped slot can be claimed again
+    QVERIFY(queue.tryPush(makeNotification("5", NotificationPriority::Normal), 0));
+    QCOMPARE(queue.clear(), 4);
+    QCOMPARE(queue.size(), 0);
+    QVERIFY(!queue.tryPop(notification, enqueuedAtUs));
+}
+
+void TestNotificationQueue::testPriorityOrder() {
+    NotificationQueue queue(8);
+    QVERIFY(queue.tryPush(makeNotification("low", NotificationPriority::Low), 1));
+    QVERIFY(queue.tryPush(makeNotification("normal1", NotificationPriority::Normal), 2));
+    QVERIFY(queue.tryPush(makeNotification("critical", NotificationPriority::Critical), 3));
+    QVERIFY(queue.tryPush(makeNotification("normal2", NotificationPriority::Normal), 4));
+    QVERIFY(queue.tryPush(makeNotification("high", NotificationPriority::High), 5));
+
+    const QStringList expected = {"critical", "high", "normal1", "normal2", "low"};
+    const QList<qint64> enqueuedAt = {3, 5, 2, 4, 1};
+    NotificationData notification;
+    qint64 enqueuedAtUs = 0;
+    for (int i = 0; i < expected.size(); ++i) {
+        QVERIFY(queue.tryPop(notification, enqueuedAtUs));
+        QCOMPARE(notification.id, expected[i]);
+        QCOMPARE(enqueuedAtUs, enqueuedAt[i]);
+    }
+    QVERIFY(!queue.tryPop(notification, enqueuedAtUs));
+}
+
+void TestNotificationQueue::testEmergencyBypass() {
+    QVERIFY(NotificationQueue::bypassesQueue(NotificationPriority::Emergency));
+    QVERIFY(!NotificationQueue::bypassesQueue(NotificationPriority::Critical));
+    QVERIFY(!NotificationQueue::bypassesQueue(NotificationPriority::High));
+    QVERIFY(!NotificationQueue::bypassesQueue(NotificationPriority::Normal));
+    QVERIFY(!NotificationQueue::bypassesQueue(NotificationPriority::Low));
+
+    // Queued anyway, it rides the top lane
+    QCOMPARE(NotificationQueue::laneFor(NotificationPriority::Emergency),
+             NotificationQueue::laneFor(NotificationPriority::Critical));
+}
+
+void TestNotificationQueue::testBatchedDrain() {
+    NotificationQueue queue(256);
+    MetricsRegistry metrics;
+    NotificationDeliveryWorker worker(&queue, &metrics);
+
+    QVector<QVector<NotificationData>> batches;
+    connect(&worker, &NotificationDeliveryWorker::batchReady, this,
+            [&batches](const QVector<NotificationData> &batch) { batches.append(batch); }, Qt::DirectConnection);
+
+    for (int i = 0; i < 150; ++i) {
+        QVERIFY(queue.tryPush(makeNotification("n" + QString::number(i), NotificationPriority::Normal),
+                              NotificationQueue::nowUs()));
+        worker.scheduleDrain();
+    }
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(queue.tryPush(makeNotification("h" + QString::number(i), NotificationPriority::High),
+                              NotificationQueue::nowUs()));
+        worker.scheduleDrain();
+    }
+
+    // 160 wake-ups coalesce into one drain per MAX_BATCH_SIZE notifications
+    QTRY_COMPARE(batches.size(), 3);
+    QCoreApplication::processEvents();
+    QCOMPARE(batches.size(), 3);
+    QCOMPARE(batches[0].size(), NotificationDeliveryWorker::MAX_BATCH_SIZE);
+    QCOMPARE(batches[1].size(), NotificationDeliveryWorker::MAX_BATCH_SIZE);
+    QCOMPARE(batches[2].size(), 160 - 2 * NotificationDeliveryWorker::MAX_BATCH_SIZE);
+    for (int i = 0; i < 10; ++i) {
+        QCOMPARE(batches[0][i].id, "h" + QString::number(i));
+    }
+    QCOMPARE(batches[0][10].id, QString("n0"));
+    QCOMPARE(batches[2].last().id, QString("n149"));
+
+    QCOMPARE(metrics.counter("earthquake_notification_batches_total"), qint64(3));
+    QCOMPARE(metrics.counter("earthquake_notifications_drained_total"), qint64(160));
+    const QString normalLabels = NotificationDeliveryWorker::priorityLabel(NotificationPriority::Normal);
+    QCOMPARE(metrics.counter("earthquake_notifications_enqueued_total", normalLabels), qint64(150));
+    QCOMPARE(metrics.histogram("earthquake_notification_queue_wait_seconds", normalLabels).count(), qint64(150));
+    QCOMPARE(metrics.gauge("earthquake_notification_queue_depth", normalLabels), 0.0);
+}
+
+void TestNotificationQueue::testConcurrentProducers() {
+    const int producersPerLane = 3;
+    const int perProducer = 2000;
+    const int producerCount = producersPerLane * NotificationQueue::LANE_COUNT;
+    const int total = producerCount * perProducer;
+
+    // Small lanes, so producers keep finding them full and the rings wrap often
+    NotificationQueue queue(64);
+    MetricsRegistry metrics;
+    NotificationDeliveryWorker worker(&queue, &metrics);
+
+    // Touched only on the delivery thread until it has finished
+    QVector<int> nextSequence(producerCount, 0);
+    QVector<int> batchSizes;
+    bool inOrder = true;
+    std::atomic<int> received{0};
+    connect(&worker, &NotificationDeliveryWorker::batchReady, this,
+            [&](const QVector<NotificationData> &batch) {
+        batchSizes.append(batch.size());
+        for (const NotificationData &notification : batch) {
+            const QStringList parts = notification.id.split(':');
+            const int producer = parts[0].toInt();
+            if (parts[1].toInt() != nextSequence[producer]) inOrder = false;
+            nextSequence[producer] = parts[1].toInt() + 1;
+        }
+        received.fetch_add(batch.size(), std::memory_order_release);
+    }, Qt::DirectConnection);
+
+    QThread deliveryThread;
+    worker.moveToThread(&deliveryThread);
+    deliveryThread.start();
+
+    QVector<QThread *> producers;
+    for (int producer = 0; producer < producerCount; ++producer) {
+        const NotificationPriority priority = NotificationQueue::priorityOf(producer % NotificationQueue::LANE_COUNT);
+        producers.append(QThread::create([&queue, &worker, producer, priority, perProducer]() {
+            for (int i = 0; i < perProducer; ++i) {
+                const NotificationData notification =
+                    makeNotification(QString("%1:%2").arg(producer).arg(i), priority);
+                while (!queue.tryPush(notification, NotificationQueue::nowUs())) {
+                    worker.scheduleDrain();
+                    QThread::yieldCurrentThread();
+                }
+                worker.scheduleDrain();
+            }
+        }));
+    }
+    for (QThread *thread : producers) thread->start();
+    for (QThread *thread : producers) {
+        QVERIFY(thread->wait(60000));
+        delete thread;
+    }
+
+    QTRY_VERIFY_WITH_TIMEOUT(received.load(std::memory_order_acquire) >= total, 60000);
+    deliveryThread.quit();
+    QVERIFY(deliveryThread.wait(10000));
+
+    // Nothing lost or duplicated, and each producer's notifications in order
+    QCOMPARE(received.load(), total);
+    QVERIFY(inOrder);
+    for (int producer = 0; producer < producerCount; ++producer) {
+        QCOMPARE(nextSequence[producer], perProducer);
+    }
+    for (int lane = 0; lane < NotificationQueue::LANE_COUNT; ++lane) {
+        QCOMPARE(queue.pushedCount(lane), quint64(producersPerLane * perProducer));
+    }
+    QCOMPARE(queue.size(), 0);
+
+    // Drained in batches, never more than MAX_BATCH_SIZE at a time
+    QVERIFY(batchSizes.size() < total);
+    for (int size : batchSizes) {
+        QVERIFY(size > 0 && size <= NotificationDeliveryWorker::MAX_BATCH_SIZE);
+    }
+}
+
+QTEST_MAIN(TestNotificationQueue)
+#include "testnotificationqueue.moc"
@@ -0,0 +1,205 @@
+#include "notification_snapshot.hpp"
+#include "alert_rules.hpp"
+#include "seen_event_set.hpp"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QTemporaryDir>
+#include <QTest>
+
+// Declare the test class
+class TestNotificationSnapshot : public QObject {
+    Q_OBJECT
+private slots:
+    void testRoundTrip();
+    void testRejectsDamagedFiles();
+    void testSaveAndLoadFile();
+    void testReplayAfterRestartDoesNotAlert();
+};
+
+static NotificationSnapshot makeSnapshot() {
+    NotificationSnapshot snapshot;
+    snapshot.savedAtMs = 1700006400000LL;
+    snapshot.notificationsToday = 12;
+    snapshot.notificationsThisHour = 3;
+    snapshot.lastHourResetMs = 1700006000000LL;
+    snapshot.lastDayResetMs = 1699920000000LL;
+
+    AlertRule rule;
+    rule.name = "Japan M6+";
+    rule.minMagnitude = 6.0;
+    rule.useLocation = true;
+    rule.centerLatitude = 36.0;
+    rule.centerLongitude = 138.0;
+    rule.regions = {"Japan", "Kuril Islands"};
+    rule.expression = "depth < 70";
+    rule.priority = NotificationPriority::High;
+    rule.channels = {DeliveryChannel::DesktopNotification, DeliveryChannel::SMSAlert};
+    rule.cooldownMinutes = 15;
+    rule.lastTriggered = QDateTime::fromMSecsSinceEpoch(1700006300000LL);
+    snapshot.rules.append(rule);
+    snapshot.rules.append(AlertRule()); // Never triggered
+
+    NotificationData notification;
+    notification.id = "n-1";
+    notification.title = "M 6.4 – Honshū";
+    notification.message = "Strong shaking expected";
+    notification.type = NotificationType::Critical;
+    notification.priority = NotificationPriority::Critical;
+    notification.timestamp = QDateTime::fromMSecsSinceEpoch(1700006350000LL);
+    notification.channels = {DeliveryChannel::DesktopNotification};
+    notification.metadata = QJsonObject{{"magnitude", 6.4}, {"tags", QJsonArray{"tsunami"}}};
+    notification.persistent = true;
+    notification.retryCount = 2;
+    notification.sourceEventId = "us7000abcd";
+    snapshot.activeNotifications.append(notification);
+
+    snapshot.seenEvents = QByteArray("seen\0events", 11);
+    snapshot.subscriberState = QByteArray(100, 'x');
+    snapshot.rateDetectorState = QByteArray(40, 'r');
+    return snapshot;
+}
+
+void TestNotificationSnapshot::testRoundTrip() {
+    const NotificationSnapshot original = makeSnapshot();
+    const QByteArray data = original.serialize();
+
+    NotificationSnapshot copy;
+    QString error;
+    QVERIFY2(copy.deserialize(data.constData(), data.size(), &error), qPrintable(error));
+    QCOMPARE(copy.savedAtMs, original.savedAtMs);
+    QCOMPARE(copy.notificationsToday, 12);
+    QCOMPARE(copy.notificationsThisHour, 3);
+    QCOMPARE(copy.lastDayResetMs, original.lastDayResetMs);
+
+    QCOMPARE(copy.rules.size(), 2);
+    const AlertRule &rule = copy.rules[0];
+    QCOMPARE(rule.name, QString("Japan M6+"));
+    QCOMPARE(rule.minMagnitude, 6.0);
+    QVERIFY(rule.useLocation);
+    QCOMPARE(rule.regions, original.rules[0].regions);
+    QCOMPARE(rule.expression, QString("depth < 70"));
+    QCOMPARE(rule.priority, NotificationPriority::High);
+    QCOMPARE(rule.channels, original.rules[0].channels);
+    QCOMPARE(rule.cooldownMinutes, 15);
+    QCOMPARE(rule.lastTriggered, original.rules[0].lastTriggered);
+    QVERIFY(!copy.rules[1].lastTriggered.isValid());
+
+    QCOMPARE(copy.activeNotifications.size(), 1);
+    const NotificationData &notification = copy.activeNotifications[0];
+    QCOMPARE(notification.title, original.activeNotifications[0].title);
+    QCOMPARE(notification.type, NotificationType::Critical);
+    QCOMPARE(notification.metadata, original.activeNotifications[0].metadata);
+    QVERIFY(notification.persistent);
+    QCOMPARE(notification.retryCount, 2);
+    QVERIFY(!notification.expiryTime.isValid());
+    QCOMPARE(notification.sourceEventId, QString("us7000abcd"));
+
+    QCOMPARE(copy.seenEvents, original.seenEvents);
+    QCOMPARE(copy.subscriberState, original.subscriberState);
+    QCOMPARE(copy.rateDetectorState, original.rateDetectorState);
+}
+
+void TestNotificationSnapshot::testRejectsDamagedFiles() {
+    const QByteArray data = makeSnapshot().serialize();
+    NotificationSnapshot snapshot;
+    snapshot.notificationsToday = -1;
+
+    QVERIFY(!snapshot.deserialize(data.constData(), data.size() - 1));
+    QVERIFY(!snapshot.deserialize(data.constData(), 4));
+
+    QByteArray corrupt = data;
+    corrupt[corrupt.size() / 2] = char(corrupt[corrupt.size() / 2] ^ 0x40);
+    QString error;
+    QVERIFY(!snapshot.deserialize(corrupt.constData(), corrupt.size(), &error));
+    QVERIFY(error.contains("checksum"));
+
+    QByteArray wrongMagic = data;
+    wrongMagic[0] = 'X';
+    QVERIFY(!snapshot.deserialize(wrongMagic.constData(), wrongMagic.size()));
+
+    // Failed loads leave the snapshot untouched
+    QCOMPARE(snapshot.notificationsToday, -1);
+}
+
+void TestNotificationSnapshot::testSaveAndLoadFile() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("state.snapshot");
+
+    QString error;
+    NotificationSnapshot loaded;
+    QVERIFY(!loaded.load(path, &error));
+
+    QVERIFY2(makeSnapshot().save(path, &error), qPrintable(error));
+    QVERIFY2(loaded.load(path, &error), qPrintable(error));
+    QCOMPARE(loaded.rules.size(), 2);
+    QCOMPARE(loaded.activeNotifications[0].id, QString("n-1"));
+
+    // Saving again replaces the file as a whole
+    NotificationSnapshot empty;
+    QVERIFY(empty.save(path, &error));
+    QVERIFY(loaded.load(path, &error));
+    QVERIFY(loaded.rules.isEmpty());
+    QCOMPARE(QFile(path).size(), qint64(empty.serialize().size()));
+}
+
+static EarthquakeData makeEvent(const QString &id, double magnitude) {
+    EarthquakeData eq;
+    eq.eventId = id;
+    eq.latitude = 35.0;
+    eq.longitude = 139.0;
+    eq.magnitude = magnitude;
+    eq.alertLevel = 0;
+    eq.depth = 10.0;
+    eq.timestamp = QDateTime::fromMSecsSinceEpoch(1700006000000LL);
+    return eq;
+}
+
+void TestNotificationSnapshot::testReplayAfterRestartDoesNotAlert() {
+    // The same filtering as NotificationManager::showEarthquakeAlerts
+    AlertRule rule;
+    rule.name = "M5+";
+    rule.minMagnitude = 5.0;
+    CompiledAlertRules rules;
+    rules.compile({rule});
+    const auto noRegions = [](const EarthquakeData &, const QVector<int> &) { return false; };
+
+    QVector<EarthquakeData> batch = {makeEvent("a", 6.1), makeEvent("b", 5.4), makeEvent("c", 3.0)};
+    const qint64 nowMs = 1700006400000LL;
+    SeenEventSet seen;
+    QCOMPARE(rules.evaluate(seen.observe(batch, nowMs), noRegions).size(), 2);
+    QVERIFY(rules.evaluate(seen.observe(batch, nowMs + 60000), noRegions).isEmpty());
+
+    // Saved with the snapshot and restored as on startup
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("state.snapshot");
+    NotificationSnapshot snapshot = makeSnapshot();
+    {
+        QDataStream stream(&snapshot.seenEvents, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_6_0);
+        seen.writeTo(stream);
+    }
+    QString error;
+    QVERIFY2(snapshot.save(path, &error), qPrintable(error));
+
+    NotificationSnapshot loaded;
+    QVERIFY2(loaded.load(path, &error), qPrintable(error));
+    SeenEventSet restored;
+    QDataStream stream(loaded.seenEvents);
+    stream.setVersion(QDataStream::Qt_6_0);
+    QVERIFY(restored.readFrom(stream));
+
+    // Hours later, with every cooldown over, the same feed raises nothing
+    QVERIFY(restored.observe(batch, nowMs + 3600000).isEmpty());
+
+    // A revision still alerts
+    batch[1].magnitude = 5.9;
+    const QVector<EarthquakeData> revised = restored.observe(batch, nowMs + 7200000);
+    QCOMPARE(revised.size(), 1);
+    QCOMPARE(rules.evaluate(revised, noRegions).size(), 1);
+}
+
+QTEST_MAIN(TestNotificationSnapshot)
+#include "testnotificationsnapshot.moc"
@@ -0,0 +1,261 @@
+#include "region_registry.hpp"
+
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QTemporaryDir>
+#include <QTest>
+#include <cmath>
+
+// Declare the test class
+class TestRegionRegistry : public QObject {
+    Q_OBJECT
+private slots:
+    void testBox();
+    void testAntimeridianBox();
+    void testAntimeridianPolygon();
+    void testPolygonWithHole();
+    void testPointOnEdge();
+    void testManyEdgesMatchReference();
+    void testReplaceKeepsId();
+    void testLoadGeoJson();
+    void testLoadMalformedGeoJson();
+};
+
+static QVector<QPointF> square(double west, double south, double east, double north) {
+    return {QPointF(west, south), QPointF(east, south), QPointF(east, north), QPointF(west, north)};
+}
+
+// Plain even-odd test over every edge, without bounding box or bands
+static bool referenceContains(const QVector<QVector<QPointF>> &rings, double latitude, double longitude) {
+    bool inside = false;
+    for (const QVector<QPointF> &ring : rings) {
+        for (int i = 0; i < ring.size(); ++i) {
+            const QPointF &p = ring[i];
+            const QPointF &q = ring[(i + 1) % ring.size()];
+            if ((p.y() <= latitude) != (q.y() <= latitude)) {
+                const double crossing = p.x() + (latitude - p.y()) * (q.x() - p.x()) / (q.y() - p.y());
+                if (longitude < crossing) inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+void TestRegionRegistry::testBox() {
+    RegionRegistry registry;
+    const int id = registry.addBox("Box", 42.0, 32.0, -125.0, -114.0); // Latitudes in either order
+    QCOMPARE(id, 0);
+    QVERIFY(registry.contains(id, 37.0, -120.0));
+    QVERIFY(registry.contains(id, 32.0, -125.0)); // Boxes include their edges
+    QVERIFY(registry.contains(id, 42.0, -114.0));
+    QVERIFY(!registry.contains(id, 31.9, -120.0));
+    QVERIFY(!registry.contains(id, 37.0, -113.9));
+    QVERIFY(!registry.contains(1, 37.0, -120.0));
+    QVERIFY(!registry.contains(-1, 37.0, -120.0));
+}
+
+void TestRegionRegistry::testAntimeridianBox() {
+    RegionRegistry registry;
+    const int id = registry.addBox("Aleutians", 50.0, 55.0, 170.0, -170.0);
+    QVERIFY(registry.contains(id, 52.0, 175.0));
+    QVERIFY(registry.contains(id, 52.0, -175.0));
+    QVERIFY(registry.contains(id, 52.0, 180.0));
+    QVERIFY(registry.contains(id, 52.0, -180.0));
+    QVERIFY(registry.contains(id, 52.0, 170.0));
+    QVERIFY(registry.contains(id, 52.0, -170.0));
+    QVERIFY(!registry.contains(id, 52.0, 169.0));
+    QVERIFY(!registry.contains(id, 52.0, -169.0));
+    QVERIFY(!registry.contains(id, 52.0, 0.0));
+    QVERIFY(!registry.contains(id, 56.0, 180.0));
+
+    registry.addDefaultRegions();
+    const int alaska = registry.regionId("Alaska");
+    QVERIFY(registry.contains(alaska, 52.0, 178.0)); // Western Aleutians
+    QVERIFY(registry.contains(alaska, 61.2, -149.9)); // Anchorage
+    QVERIFY(!registry.contains(alaska, 61.0, 150.0));
+    QCOMPARE(registry.regionsAt(52.0, 179.0), (QVector<int>{id, alaska}));
+}
+
+void TestRegionRegistry::testAntimeridianPolygon() {
+    // Fiji-like triangle written with longitudes past 180
+    RegionRegistry registry;
+    const int id = registry.addPolygon("Fiji", {{QPointF(175.0, -20.0), QPointF(185.0, -20.0), QPointF(180.0, -10.0)}});
+    QVERIFY(registry.contains(id, -18.0, 179.0));
+    QVERIFY(registry.contains(id, -18.0, -179.0));
+    QVERIFY(registry.contains(id, -12.0, 180.0));
+    QVERIFY(registry.contains(id, -12.0, -180.0));
+    QVERIFY(!registry.contains(id, -12.0, 176.0));
+    QVERIFY(!registry.contains(id, -12.0, -176.0));
+    QVERIFY(!registry.contains(id, -21.0, 180.0));
+}
+
+void TestRegionRegistry::testPolygonWithHole() {
+    RegionRegistry registry;
+    const int id = registry.addPolygon("Ring", {square(0.0, 0.0, 10.0, 10.0), square(4.0, 4.0, 6.0, 6.0)});
+    QVERIFY(registry.contains(id, 2.0, 2.0));
+    QVERIFY(registry.contains(id, 8.0, 5.0));
+    QVERIFY(registry.contains(id, 5.0, 3.9));
+    QVERIFY(!registry.contains(id, 5.0, 5.0));
+    QVERIFY(!registry.contains(id, 4.5, 5.5));
+    QVERIFY(!registry.contains(id, 11.0, 5.0));
+
+    // A multipolygon is just more outlines
+    const int islands = registry.addPolygon("Islands", {square(0.0, 0.0, 1.0, 1.0), square(5.0, 5.0, 6.0, 6.0)});
+    QVERIFY(registry.contains(islands, 0.5, 0.5));
+    QVERIFY(registry.contains(islands, 5.5, 5.5));
+    QVERIFY(!registry.contains(islands, 3.0, 3.0)); // Inside the bounding box only
+
+    // Rings with fewer than three points have no area
+    QCOMPARE(registry.addPolygon("Line", {{QPointF(0.0, 0.0), QPointF(1.0, 1.0)}}), -1);
+    QCOMPARE(registry.regionId("Line"), -1);
+}
+
+void TestRegionRegistry::testPointOnEdge() {
+    // Neighbouring polygons share an edge; a point on it belongs to exactly one
+    RegionRegistry registry;
+    const int west = registry.addPolygon("West", {square(0.0, 0.0, 10.0, 10.0)});
+    const int east = registry.addPolygon("East", {square(10.0, 0.0, 20.0, 10.0)});
+    const int north = registry.addPolygon("North", {square(0.0, 10.0, 10.0, 20.0)});
+    const int northEast = registry.addPolygon("NorthEast", {square(10.0, 10.0, 20.0, 20.0)});
+
+    QCOMPARE(registry.regionsAt(5.0, 10.0), QVector<int>{east});
+    QCOMPARE(registry.regionsAt(10.0, 5.0), QVector<int>{north});
+    QCOMPARE(registry.regionsAt(10.0, 10.0), QVector<int>{northEast}); // Corner shared by all four
+    QCOMPARE(registry.regionsAt(0.0, 5.0), QVector<int>{west});
+    QCOMPARE(registry.regionsAt(5.0, 0.0), QVector<int>{west});
+
+    // Vertices where the outline turns are counted once
+    const int diamond = registry.addPolygon("Diamond",
+                                            {{QPointF(30.0, 0.0), QPointF(35.0, 5.0), QPointF(30.0, 10.0), QPointF(25.0, 5.0)}});
+    QVERIFY(registry.contains(diamond, 5.0, 30.0));
+    QVERIFY(registry.contains(diamond, 5.0, 25.0));
+    QVERIFY(!registry.contains(diamond, 5.0, 35.0));
+    QVERIFY(!registry.contains(diamond, 5.0, 24.9));
+}
+
+void TestRegionRegistry::testManyEdgesMatchReference() {
+    // A 400-vertex star spreads its edges over many latitude bands
+    QRandomGenerator random(86);
+    QVector<QPointF> star;
+    for (int i = 0; i < 400; ++i) {
+        const double angle = 2.0 * M_PI * i / 400.0;
+        const double radius = i % 2 == 0 ? 20.0 : 5.0 + random.generateDouble() * 10.0;
+        star.append(QPointF(140.0 + radius * std::cos(angle), 35.0 + radius * std::sin(angle)));
+    }
+    const QVector<QVector<QPointF>> rings = {star, square(135.0, 30.0, 137.0, 32.0)};
+
+    RegionRegistry registry;
+    const int id = registry.addPolygon("Star", rings);
+    for (int i = 0; i < 20000; ++i) {
+        const double latitude = 10.0 + random.generateDouble() * 50.0;
+        const double longitude = 115.0 + random.generateDouble() * 50.0;
+        if (registry.contains(id, latitude, longitude) != referenceContains(rings, latitude, longitude)) {
+            QFAIL(qPrintable(QString("Mismatch at %1, %2").arg(latitude).arg(longitude)));
+        }
+    }
+}
+
+void TestRegionRegistry::testReplaceKeepsId() {
+    RegionRegistry registry;
+    const int first = registry.addBox("Zone", 0.0, 1.0, 0.0, 1.0);
+    const int other = registry.addBox("Other", 0.0, 1.0, 0.0, 1.0);
+    QCOMPARE(registry.addPolygon("ZONE", {square(10.0, 10.0, 11.0, 11.0)}), first);
+    QCOMPARE(registry.size(), 2);
+    QCOMPARE(registry.regionId("zone"), first);
+    QCOMPARE(registry.regionName(first), QString("ZONE"));
+    QCOMPARE(registry.regionNames(), (QStringList{"ZONE", "Other"}));
+    QVERIFY(!registry.contains(first, 0.5, 0.5));
+    QVERIFY(registry.contains(first, 10.5, 10.5));
+    QVERIFY(registry.containsAny({first, other}, 0.5, 0.5));
+    QVERIFY(!registry.containsAny({first}, 0.5, 0.5));
+}
+
+void TestRegionRegistry::testLoadGeoJson() {
+    const QByteArray json = R"({
+        "type": "FeatureCollection",
+        "features": [
+            {"type": "Feature", "properties": {"name": "Ring"},
+             "geometry": {"type": "Polygon", "coordinates": [
+                 [[0, 0], [10, 0], [10, 10], [0, 10], [0, 0]],
+                 [[4, 4], [6, 4], [6, 6], [4, 6], [4, 4]]]}},
+            {"type": "Feature", "properties": {"name": "Islands"},
+             "geometry": {"type": "MultiPolygon", "coordinates": [
+                 [[[20, 0], [21, 0], [21, 1], [20, 1], [20, 0]]],
+                 [[[30, 0], [31, 0], [31, 1], [30, 1], [30, 0]]]]}},
+            {"type": "Feature", "properties": {"name": "Date Line"}, "bbox": [170, -20, -170, -10]}
+        ]
+    })";
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("regions.geojson");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(json);
+    file.close();
+
+    RegionRegistry registry;
+    QString error;
+    QVERIFY2(registry.loadFromFile(path, &error), qPrintable(error));
+    QCOMPARE(registry.size(), 3);
+
+    const int ring = registry.regionId("ring");
+    QVERIFY(registry.contains(ring, 2.0, 2.0));
+    QVERIFY(!registry.contains(ring, 5.0, 5.0));
+
+    const int islands = registry.regionId("Islands");
+    QVERIFY(registry.contains(islands, 0.5, 20.5));
+    QVERIFY(registry.contains(islands, 0.5, 30.5));
+    QVERIFY(!registry.contains(islands, 0.5, 25.0));
+
+    const int dateLine = registry.regionId("Date Line");
+    QVERIFY(registry.contains(dateLine, -15.0, 179.0));
+    QVERIFY(registry.contains(dateLine, -15.0, -179.0));
+    QVERIFY(!registry.contains(dateLine, -15.0, 0.0));
+
+    QVERIFY(!registry.loadFromFile(dir.filePath("missing.geojson"), &error));
+    QVERIFY(error.startsWith("Cannot open region file"));
+    QCOMPARE(registry.size(), 3);
+}
+
+void TestRegionRegistry::testLoadMalformedGeoJson() {
+    RegionRegistry registry;
+    QString error;
+
+    QVERIFY(!registry.loadGeoJson("{\"type\": \"FeatureCollection\", \"features\": [", &error));
+    QVERIFY(error.startsWith("Invalid region file"));
+    QVERIFY(!registry.loadGeoJson("[]", &error));
+    QVERIFY(error.startsWith("Invalid region file"));
+
+    QVERIFY(!registry.loadGeoJson(R"({"type": "Feature"})", &error));
+    QCOMPARE(error, QString("Region file is not a GeoJSON FeatureCollection"));
+
+    QVERIFY(!registry.loadGeoJson(R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "properties": {},
+         "geometry": {"type": "Polygon", "coordinates": [[[0, 0], [1, 0], [1, 1]]]}}]})", &error));
+    QCOMPARE(error, QString("Region feature 0 has no name"));
+    QCOMPARE(registry.size(), 0);
+
+    // Features before the bad one stay loaded
+    QVERIFY(!registry.loadGeoJson(R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "properties": {"name": "Good"},
+         "geometry": {"type": "Polygon", "coordinates": [[[0, 0], [1, 0], [1, 1], [0, 0]]]}},
+        {"type": "Feature", "properties": {"name": "Epicentre"},
+         "geometry": {"type": "Point", "coordinates": [0, 0]}},
+        {"type": "Feature", "properties": {"name": "Never"},
+         "geometry": {"type": "Polygon", "coordinates": [[[0, 0], [1, 0], [1, 1], [0, 0]]]}}]})", &error));
+    QCOMPARE(error, QString("Region 'Epicentre' has unsupported geometry 'Point'"));
+    QCOMPARE(registry.regionNames(), QStringList{"Good"});
+
+    // A bbox needs all four numbers; a degenerate polygon is skipped, not an error
+    QVERIFY(!registry.loadGeoJson(R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "properties": {"name": "Short"}, "bbox": [0, 0, 1]}]})", &error));
+    QCOMPARE(error, QString("Region 'Short' has unsupported geometry ''"));
+    QVERIFY(registry.loadGeoJson(R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "properties": {"name": "Flat"},
+         "geometry": {"type": "Polygon", "coordinates": [[[0, 0], [1, 0], [0, 0]]]}}]})", &error));
+    QCOMPARE(registry.regionId("Flat"), -1);
+    QCOMPARE(registry.size(), 1);
+}
+
+QTEST_MAIN(TestRegionRegistry)
+#include "testregionregistry.moc"
@@ -0,0 +1,187 @@
+#include "seen_event_set.hpp"
+
+#include <QtCore/QTemporaryDir>
+#include <QTest>
+
+// Declare the test class
+class TestSeenEventSet : public QObject {
+    Q_OBJECT
+private slots:
+    void testObserveRevisions();
+    void testEvictionAtCapacity();
+    void testEvictExpired();
+    void testBatchObserve();
+    void testStreamRoundTrip();
+    void testFileRoundTrip();
+    void testKeyWithoutId();
+};
+
+static const qint64 START_MS = 1700006400000LL;
+
+static EarthquakeData makeEvent(const QString &id, double magnitude) {
+    EarthquakeData eq;
+    eq.eventId = id;
+    eq.latitude = 35.0;
+    eq.longitude = 139.0;
+    eq.magnitude = magnitude;
+    eq.depth = 10.0;
+    eq.alertLevel = 0;
+    eq.reviewStatus = "automatic";
+    eq.tsunamiFlag = "No";
+    eq.timestamp = QDateTime::fromMSecsSinceEpoch(START_MS);
+    return eq;
+}
+
+void TestSeenEventSet::testObserveRevisions() {
+    SeenEventSet seen;
+    EarthquakeData eq = makeEvent("a", 5.0);
+    QVERIFY(!seen.contains("a"));
+    QCOMPARE(seen.observe(eq, START_MS), SeenEventSet::Status::New);
+    QVERIFY(seen.contains("a"));
+    QCOMPARE(seen.observe(eq, START_MS + 1000), SeenEventSet::Status::Unchanged);
+
+    // Magnitude counts in 0.1 steps
+    eq.magnitude = 5.04;
+    QCOMPARE(seen.observe(eq, START_MS + 2000), SeenEventSet::Status::Unchanged);
+    eq.magnitude = 5.1;
+    QCOMPARE(seen.observe(eq, START_MS + 3000), SeenEventSet::Status::Updated);
+    QCOMPARE(seen.observe(eq, START_MS + 4000), SeenEventSet::Status::Unchanged);
+
+    eq.reviewStatus = "reviewed";
+    QCOMPARE(seen.observe(eq, START_MS + 5000), SeenEventSet::Status::Updated);
+    eq.tsunamiFlag = "Yes";
+    QCOMPARE(seen.observe(eq, START_MS + 6000), SeenEventSet::Status::Updated);
+    eq.alertLevel = 2;
+    QCOMPARE(seen.observe(eq, START_MS + 7000), SeenEventSet::Status::Updated);
+    QCOMPARE(seen.size(), 1);
+
+    seen.clear();
+    QCOMPARE(seen.size(), 0);
+    QCOMPARE(seen.observe(eq, START_MS + 8000), SeenEventSet::Status::New);
+}
+
+void TestSeenEventSet::testEvictionAtCapacity() {
+    SeenEventSet seen(SeenEventSet::DEFAULT_MAX_AGE_MS, 3);
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(seen.observe(QString::number(i), 1, START_MS + i), SeenEventSet::Status::New);
+    }
+    QCOMPARE(seen.size(), 3);
+
+    // The oldest entry makes room
+    QCOMPARE(seen.observe("3", 1, START_MS + 3), SeenEventSet::Status::New);
+    QCOMPARE(seen.size(), 3);
+    QVERIFY(!seen.contains("0"));
+    QVERIFY(seen.contains("1"));
+    QVERIFY(seen.contains("3"));
+
+    // Seeing an event again does not change its place in line before maxAge / 2
+    QCOMPARE(seen.observe("1", 1, START_MS + 4), SeenEventSet::Status::Unchanged);
+    QCOMPARE(seen.observe("0", 1, START_MS + 5), SeenEventSet::Status::New);
+    QVERIFY(!seen.contains("1"));
+    QCOMPARE(seen.size(), 3);
+}
+
+void TestSeenEventSet::testEvictExpired() {
+    SeenEventSet seen(1000, 100);
+    seen.observe("a", 1, START_MS);
+    seen.observe("b", 1, START_MS);
+
+    // Still in the feed past half maxAge: re-queued
+    seen.observe("b", 1, START_MS + 600);
+
+    QCOMPARE(seen.evictExpired(START_MS + 1100), 1);
+    QVERIFY(!seen.contains("a"));
+    QVERIFY(seen.contains("b"));
+
+    QCOMPARE(seen.evictExpired(START_MS + 1700), 1);
+    QCOMPARE(seen.size(), 0);
+    QCOMPARE(seen.evictExpired(START_MS + 5000), 0);
+}
+
+void TestSeenEventSet::testBatchObserve() {
+    SeenEventSet seen;
+    seen.observe(makeEvent("a", 4.0), START_MS);
+    seen.observe(makeEvent("c", 4.0), START_MS);
+
+    const QVector<EarthquakeData> batch = {
+        makeEvent("a", 4.0), makeEvent("b", 4.5), makeEvent("b", 4.5), makeEvent("c", 4.8)
+    };
+    QVector<EarthquakeData> added;
+    const QVector<EarthquakeData> fresh = seen.observe(batch, START_MS + 1000, &added);
+    QCOMPARE(fresh.size(), 2);
+    QCOMPARE(fresh[0].eventId, QString("b"));
+    QCOMPARE(fresh[1].eventId, QString("c"));
+    QCOMPARE(added.size(), 1);
+    QCOMPARE(added[0].eventId, QString("b"));
+
+    QVERIFY(seen.observe(batch, START_MS + 2000).isEmpty());
+}
+
+void TestSeenEventSet::testStreamRoundTrip() {
+    SeenEventSet seen(1000, 100);
+    seen.observe("a", 1, START_MS);
+    seen.observe("b", 2, START_MS + 800);
+
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        seen.writeTo(out);
+    }
+    SeenEventSet restored(1000, 100);
+    QDataStream in(data);
+    QVERIFY(restored.readFrom(in));
+    QCOMPARE(restored.size(), 2);
+
+    // Eviction order is rebuilt from the stored times
+    QCOMPARE(restored.evictExpired(START_MS + 1100), 1);
+    QVERIFY(!restored.contains("a"));
+    QCOMPARE(restored.observe("b", 2, START_MS + 1200), SeenEventSet::Status::Unchanged);
+    QCOMPARE(restored.observe("b", 3, START_MS + 1300), SeenEventSet::Status::Updated);
+
+    // A smaller capacity keeps the newest entries
+    SeenEventSet small(1000, 1);
+    QDataStream again(data);
+    QVERIFY(small.readFrom(again));
+    QCOMPARE(small.size(), 1);
+    QVERIFY(small.contains("b"));
+
+    QByteArray damaged = data.left(data.size() - 4);
+    QDataStream truncated(damaged);
+    QVERIFY(!restored.readFrom(truncated));
+    QCOMPARE(restored.size(), 0);
+}
+
+void TestSeenEventSet::testFileRoundTrip() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("seen_events.dat");
+
+    SeenEventSet seen;
+    seen.observe(makeEvent("a", 6.0), START_MS);
+    QVERIFY(seen.saveToFile(path));
+
+    SeenEventSet loaded;
+    QVERIFY(loaded.loadFromFile(path));
+    QCOMPARE(loaded.observe(makeEvent("a", 6.0), START_MS + 1000), SeenEventSet::Status::Unchanged);
+
+    QVERIFY(!loaded.loadFromFile(dir.filePath("missing.dat")));
+    QCOMPARE(loaded.size(), 0);
+}
+
+void TestSeenEventSet::testKeyWithoutId() {
+    EarthquakeData eq = makeEvent(QString(), 5.0);
+    EarthquakeData same = eq;
+    EarthquakeData moved = eq;
+    moved.longitude = 139.5;
+    QCOMPARE(SeenEventSet::keyOf(eq), SeenEventSet::keyOf(same));
+    QVERIFY(SeenEventSet::keyOf(eq) != SeenEventSet::keyOf(moved));
+    QCOMPARE(SeenEventSet::keyOf(makeEvent("us1", 5.0)), QString("us1"));
+
+    SeenEventSet seen;
+    QCOMPARE(seen.observe(eq, START_MS), SeenEventSet::Status::New);
+    QCOMPARE(seen.observe(same, START_MS), SeenEventSet::Status::Unchanged);
+    QCOMPARE(seen.observe(moved, START_MS), SeenEventSet::Status::New);
+}
+
+QTEST_MAIN(TestSeenEventSet)
+#include "testseeneventset.moc"
@@ -0,0 +1,153 @@
+#include "seismicity_rate_detector.hpp"
+
+#include <QtCore/QRandomGenerator>
+#include <QTest>
+#include <cmath>
+
+// Declare the test class
+class TestSeismicityRateDetector : public QObject {
+    Q_OBJECT
+private slots:
+    void testLogLikelihoodRatio();
+    void testSwarmInQuietCell();
+    void testBackgroundRate();
+    void testLateEvents();
+    void testStateRoundTrip();
+};
+
+static const qint64 START_MS = 1700006400000LL;
+static const qint64 HOUR_MS = 3600 * 1000LL;
+static const qint64 DAY_MS = 24 * HOUR_MS;
+
+static EarthquakeData makeEvent(const QString &id, double latitude, double longitude, qint64 timeMs) {
+    EarthquakeData eq;
+    eq.eventId = id;
+    eq.latitude = latitude;
+    eq.longitude = longitude;
+    eq.magnitude = 3.0;
+    eq.depth = 10.0;
+    eq.timestamp = QDateTime::fromMSecsSinceEpoch(timeMs);
+    return eq;
+}
+
+// Events spaced evenly over a span, observed as they happen
+static int feed(SeismicityRateDetector &detector, const QString &prefix, double latitude, double longitude,
+                qint64 startMs, qint64 spanMs, int count) {
+    int anomalies = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 timeMs = startMs + spanMs * i / count;
+        if (detector.observe(makeEvent(prefix + QString::number(i), latitude, longitude, timeMs), timeMs + 60000)) {
+            ++anomalies;
+        }
+    }
+    return anomalies;
+}
+
+// One event a month earlier, far away, so the detector is past its warm-up
+static void seedHistory(SeismicityRateDetector &detector) {
+    const qint64 timeMs = START_MS - 30 * DAY_MS;
+    detector.observe(makeEvent("history", -60.0, 0.0, timeMs), timeMs);
+}
+
+void TestSeismicityRateDetector::testLogLikelihoodRatio() {
+    QCOMPARE(SeismicityRateDetector::logLikelihoodRatio(5.0, 5.0), 0.0);
+    QCOMPARE(SeismicityRateDetector::logLikelihoodRatio(2.0, 5.0), 0.0);
+    QVERIFY(qAbs(SeismicityRateDetector::logLikelihoodRatio(12.0, 2.0) - (12.0 * std::log(6.0) - 10.0)) < 1e-12);
+}
+
+void TestSeismicityRateDetector::testSwarmInQuietCell() {
+    SeismicityRateDetector detector;
+    QCOMPARE(feed(detector, "w", 10.3, 20.3, START_MS - DAY_MS, HOUR_MS, 10), 0); // Still warming up
+
+    seedHistory(detector);
+    SeismicityRateDetector::Anomaly anomaly;
+    int count = 0;
+    for (int i = 0; i < 10; ++i) {
+        const qint64 timeMs = START_MS + i * 20 * 60000LL;
+        if (detector.observe(makeEvent(QString::number(i), 37.3, -116.6, timeMs), timeMs, &anomaly)) {
+            ++count;
+            QVERIFY(anomaly.observed >= SeismicityRateDetector::MIN_EVENTS);
+            QVERIFY(anomaly.logLikelihoodRatio >= SeismicityRateDetector::ALERT_LOG_LIKELIHOOD_RATIO);
+            QCOMPARE(anomaly.latitude, 37.5);
+            QCOMPARE(anomaly.longitude, -116.5);
+        }
+    }
+    // Reported once, not for every event of the swarm
+    QCOMPARE(count, 1);
+    QVERIFY(detector.isAnomalous(37.9, -116.1));
+    QVERIFY(!detector.isAnomalous(38.1, -116.1));
+
+    // Re-armed once activity is back to background
+    const qint64 later = START_MS + 60 * DAY_MS;
+    QVERIFY(!detector.observe(makeEvent("later", 37.3, -116.6, later), later));
+    QVERIFY(!detector.isAnomalous(37.3, -116.6));
+}
+
+void TestSeismicityRateDetector::testBackgroundRate() {
+    // About three events a day for most of a year: busy, but not anomalous
+    QRandomGenerator rng(7);
+    SeismicityRateDetector detector;
+    qint64 timeMs = START_MS;
+    for (int i = 0; i < 900; ++i) {
+        timeMs += qint64(-std::log(1.0 - rng.generateDouble()) * DAY_MS / 3.0);
+        QVERIFY(!detector.observe(makeEvent(QString::number(i), 19.4, -155.3, timeMs), timeMs));
+    }
+
+    // A swarm well above that rate stands out against it
+    SeismicityRateDetector::Anomaly anomaly;
+    int count = 0;
+    for (int i = 0; i < 30; ++i) {
+        const qint64 swarmMs = timeMs + HOUR_MS + i * 10 * 60000LL;
+        if (detector.observe(makeEvent("s" + QString::number(i), 19.4, -155.3, swarmMs), swarmMs, &anomaly)) {
+            ++count;
+            QVERIFY(anomaly.expected > 1.5 && anomaly.expected < 5.0);
+            QVERIFY(anomaly.observed > 10.0);
+        }
+    }
+    QCOMPARE(count, 1);
+}
+
+void TestSeismicityRateDetector::testLateEvents() {
+    SeismicityRateDetector detector;
+    seedHistory(detector);
+
+    // A few events in a quiet cell stay below MIN_EVENTS
+    QCOMPARE(feed(detector, "a", 35.2, 139.1, START_MS, HOUR_MS, 3), 0);
+
+    // A swarm that arrives days late is counted but not reported
+    const qint64 nowMs = START_MS + 10 * DAY_MS;
+    QVector<EarthquakeData> backfill;
+    for (int i = 0; i < 20; ++i) {
+        backfill.append(makeEvent("b" + QString::number(i), -15.5, -173.5, START_MS + i * 60000LL));
+    }
+    QVERIFY(detector.observe(backfill, nowMs).isEmpty());
+    QCOMPARE(detector.cellCount(), 3);
+}
+
+void TestSeismicityRateDetector::testStateRoundTrip() {
+    SeismicityRateDetector detector;
+    seedHistory(detector);
+    QCOMPARE(feed(detector, "x", 40.5, 29.5, START_MS, 2 * HOUR_MS, 12), 1);
+
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        detector.writeTo(out);
+    }
+    SeismicityRateDetector restored;
+    QDataStream in(data);
+    QVERIFY(restored.readFrom(in));
+    QCOMPARE(restored.cellCount(), 2);
+    QVERIFY(restored.isAnomalous(40.5, 29.5));
+
+    // The swarm is not reported again
+    QCOMPARE(feed(restored, "y", 40.5, 29.5, START_MS + 2 * HOUR_MS, HOUR_MS, 5), 0);
+
+    QByteArray damaged = data.left(data.size() / 2);
+    QDataStream truncated(damaged);
+    QVERIFY(!restored.readFrom(truncated));
+    QCOMPARE(restored.cellCount(), 0);
+}
+
+QTEST_MAIN(TestSeismicityRateDetector)
+#include "testseismicityratedetector.moc"
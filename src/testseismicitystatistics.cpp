@@ -0,0 +1,214 @@
+#include "seismicity_statistics.hpp"
+#include "seen_event_set.hpp"
+
+#include <QtCore/QRandomGenerator>
+#include <QTest>
+#include <cmath>
+
+// Declare the test class
+class TestSeismicityStatistics : public QObject {
+    Q_OBJECT
+private slots:
+    void testMomentAndRevisions();
+    void testWindowsMatchBruteForce();
+    void testGutenbergRichter();
+    void testOmoriUtsu();
+};
+
+static const qint64 START_MS = 1700006400000LL;
+static const qint64 HOUR_MS = 3600 * 1000LL;
+static const qint64 DAY_MS = 24 * HOUR_MS;
+
+static EarthquakeData makeEvent(const QString &id, double latitude, double longitude, double magnitude, qint64 timeMs) {
+    EarthquakeData eq;
+    eq.eventId = id;
+    eq.latitude = latitude;
+    eq.longitude = longitude;
+    eq.magnitude = magnitude;
+    eq.depth = 10.0;
+    eq.timestamp = QDateTime::fromMSecsSinceEpoch(timeMs);
+    return eq;
+}
+
+static SeismicityStatistics::Window allOf(qint64 startMs, qint64 endMs) {
+    SeismicityStatistics::Window window;
+    window.startMs = startMs;
+    window.endMs = endMs;
+    return window;
+}
+
+void TestSeismicityStatistics::testMomentAndRevisions() {
+    SeismicityStatistics statistics;
+    statistics.add(makeEvent("a", 35.0, 139.0, 6.0, START_MS));
+    const SeismicityStatistics::Window window = allOf(START_MS - DAY_MS, START_MS + DAY_MS);
+    SeismicityStatistics::MomentRelease release = statistics.momentRelease(window);
+    QCOMPARE(release.eventCount, 1);
+    QVERIFY(qAbs(release.equivalentMagnitude - 6.0) < 1e-9);
+
+    // A revision replaces the event rather than adding a second one
+    statistics.add(makeEvent("a", 35.0, 139.0, 6.2, START_MS));
+    statistics.add(makeEvent("b", 35.0, 139.0, 6.2, START_MS + HOUR_MS));
+    QCOMPARE(statistics.size(), 2);
+    release = statistics.momentRelease(window);
+    QCOMPARE(release.eventCount, 2);
+    QVERIFY(qAbs(release.momentNm - 2.0 * SeismicityStatistics::seismicMoment(6.2)) < 1e-6 * release.momentNm);
+    // Two equal events release 2x the moment, 0.2 magnitude units more
+    QVERIFY(qAbs(release.equivalentMagnitude - (6.2 + std::log10(2.0) / 1.5)) < 1e-9);
+
+    QVERIFY(statistics.remove("a"));
+    QVERIFY(!statistics.remove("a"));
+    QCOMPARE(statistics.momentRelease(window).eventCount, 1);
+    QCOMPARE(statistics.momentRelease(allOf(START_MS + 2 * HOUR_MS, START_MS + DAY_MS)).eventCount, 0);
+}
+
+void TestSeismicityStatistics::testWindowsMatchBruteForce() {
+    QRandomGenerator rng(17);
+    SeismicityStatistics statistics;
+    QVector<EarthquakeData> events;
+    for (int i = 0; i < 3000; ++i) {
+        // Clustered in a few regions, one straddling the antimeridian
+        const double latitude = qBound(-90.0, (i % 3 == 0 ? 52.0 : -20.0) + rng.generateDouble() * 8.0 - 4.0, 90.0);
+        double longitude = (i % 3 == 0 ? 178.0 : 120.0) + rng.generateDouble() * 8.0 - 4.0;
+        if (longitude >= 180.0) longitude -= 360.0;
+        const qint64 timeMs = START_MS + qint64(rng.generateDouble() * 1500 * DAY_MS);
+        events.append(makeEvent(QString::number(i), latitude, longitude, 2.0 + rng.generateDouble() * 4.0, timeMs));
+    }
+    statistics.add(events);
+
+    auto check = [&events, &statistics](const SeismicityStatistics::Window &window) {
+        // Reference: every event whose cell and hour touch the window
+        int expected = 0;
+        double expectedMoment = 0.0;
+        for (const EarthquakeData &eq : events) {
+            const double south = std::floor(eq.latitude + 90.0) - 90.0;
+            const double west = std::floor(eq.longitude + 180.0) - 180.0;
+            const qint64 hourMs = eq.timestamp.toMSecsSinceEpoch() / HOUR_MS * HOUR_MS;
+            if (south > window.maxLatitude || south + 1.0 <= window.minLatitude) continue;
+            const bool afterWest = west + 1.0 > window.minLongitude;
+            const bool beforeEast = west <= window.maxLongitude;
+            if (window.minLongitude > window.maxLongitude ? !(afterWest || beforeEast) : !(afterWest && beforeEast)) continue;
+            if (hourMs + HOUR_MS <= window.startMs || hourMs >= window.endMs) continue;
+            ++expected;
+            expectedMoment += SeismicityStatistics::seismicMoment(eq.magnitude);
+        }
+
+        const SeismicityStatistics::MomentRelease release = statistics.momentRelease(window);
+        QCOMPARE(release.eventCount, expected);
+        QVERIFY(qAbs(release.momentNm - expectedMoment) <= 1e-9 * qMax(1.0, expectedMoment));
+    };
+
+    for (int trial = 0; trial < 200; ++trial) {
+        SeismicityStatistics::Window window;
+        window.minLatitude = rng.generateDouble() * 140.0 - 70.0;
+        window.maxLatitude = window.minLatitude + rng.generateDouble() * 40.0;
+        window.minLongitude = rng.generateDouble() * 360.0 - 180.0;
+        window.maxLongitude = rng.generateDouble() * 360.0 - 180.0; // Wraps when less than min
+        window.startMs = START_MS + qint64(rng.generateDouble() * 1000 * DAY_MS) - 30 * DAY_MS;
+        window.endMs = window.startMs + qint64(rng.generateDouble() * (trial % 2 == 0 ? 3 : 900) * DAY_MS);
+        check(window);
+        if (QTest::currentTestFailed()) return;
+    }
+
+    // Windows on cell edges, at the poles and the antimeridian, and wrapping
+    // windows whose ends fall in the same or in neighbouring cells
+    const double bounds[][4] = {
+        {50.0, 54.0, 176.0, 179.0}, {48.0, 56.0, 179.0, -179.0}, {48.0, 56.0, 178.5, 178.2},
+        {48.0, 56.0, 178.0, 177.9}, {48.0, 56.0, -180.0, 180.0}, {48.0, 56.0, 180.0, -180.0},
+        {-90.0, 90.0, 175.0, -176.0}, {-24.0, -16.0, 116.0, 124.0}, {-20.0, -20.0, 120.0, 120.0},
+        {90.0, 90.0, -180.0, 180.0}, {-90.0, -90.0, -180.0, 180.0}, {56.0, 48.0, -180.0, 180.0}
+    };
+    auto checkBounds = [&]() {
+        for (const auto &bound : bounds) {
+            SeismicityStatistics::Window window;
+            window.minLatitude = bound[0];
+            window.maxLatitude = bound[1];
+            window.minLongitude = bound[2];
+            window.maxLongitude = bound[3];
+            window.startMs = START_MS;
+            window.endMs = START_MS + 1500 * DAY_MS;
+            check(window);
+            if (QTest::currentTestFailed()) return;
+        }
+    };
+    checkBounds();
+    if (QTest::currentTestFailed()) return;
+
+    // Cells emptied by removal drop out of the index
+    for (int i = 0; i < events.size(); i += 2) {
+        QVERIFY(statistics.remove(SeenEventSet::keyOf(events[i])));
+    }
+    QVector<EarthquakeData> remaining;
+    for (int i = 1; i < events.size(); i += 2) remaining.append(events[i]);
+    events = remaining;
+    checkBounds();
+}
+
+void TestSeismicityStatistics::testGutenbergRichter() {
+    // b = 1 above M 2.0, with detection falling off below it
+    QRandomGenerator rng(3);
+    SeismicityStatistics statistics;
+    int id = 0;
+    while (statistics.size() < 5000) {
+        const double magnitude = 1.0 - std::log10(1.0 - rng.generateDouble());
+        if (magnitude < 2.0 && rng.generateDouble() > std::pow(magnitude - 1.0, 2.0)) continue;
+        const double rounded = std::round(magnitude * 10.0) / 10.0;
+        statistics.add(makeEvent(QString::number(id++), 36.0, 141.0, rounded, START_MS + id * 60000LL));
+    }
+
+    const SeismicityStatistics::Window window = allOf(START_MS, START_MS + 365 * DAY_MS);
+    const SeismicityStatistics::GutenbergRichter fit = statistics.gutenbergRichter(window);
+    QVERIFY(fit.valid);
+    QCOMPARE(fit.eventCount, 5000);
+    QVERIFY(fit.completeness >= 1.95 && fit.completeness <= 2.45);
+    QVERIFY2(qAbs(fit.bValue - 1.0) < 3.0 * fit.bError + 0.02, qPrintable(QString::number(fit.bValue)));
+    QVERIFY(fit.bError > 0.0 && fit.bError < 0.05);
+
+    // A given completeness is used as is; too few events is not a fit
+    const SeismicityStatistics::GutenbergRichter high = statistics.gutenbergRichter(window, 4.0);
+    QCOMPARE(high.completeness, 4.0);
+    QVERIFY(!high.valid);
+    QVERIFY(!statistics.gutenbergRichter(allOf(START_MS - DAY_MS, START_MS)).valid);
+}
+
+void TestSeismicityStatistics::testOmoriUtsu() {
+    // Aftershock times drawn from K / (c + t)^p over 60 days
+    const double c = 0.2;
+    const double p = 1.15;
+    const double days = 60.0;
+    const double head = std::pow(c, 1.0 - p);
+    const double tail = std::pow(c + days, 1.0 - p);
+    QRandomGenerator rng(29);
+    SeismicityStatistics statistics;
+    statistics.add(makeEvent("main", -36.1, -72.9, 8.0, START_MS));
+    for (int i = 0; i < 4000; ++i) {
+        const double u = rng.generateDouble();
+        const double t = std::pow(head - u * (head - tail), 1.0 / (1.0 - p)) - c;
+        statistics.add(makeEvent(QString::number(i), -36.5 + rng.generateDouble(), -73.0 + rng.generateDouble(),
+                                 3.0 + rng.generateDouble(), START_MS + qint64(t * DAY_MS)));
+    }
+    // Background elsewhere stays out of the fit
+    statistics.add(makeEvent("far", 35.0, 139.0, 5.0, START_MS + DAY_MS));
+
+    SeismicityStatistics::Window window;
+    window.minLatitude = -37.0;
+    window.maxLatitude = -35.0;
+    window.minLongitude = -74.0;
+    window.maxLongitude = -72.0;
+    window.startMs = START_MS;
+    window.endMs = START_MS + qint64(days * DAY_MS);
+
+    const SeismicityStatistics::OmoriUtsu fit = statistics.omoriUtsu(window, 3.0);
+    QVERIFY(fit.valid);
+    QVERIFY(fit.eventCount > 3500 && fit.eventCount < 4000); // Less the first hour
+    QVERIFY2(qAbs(fit.p - p) < 0.05, qPrintable(QString::number(fit.p)));
+    QVERIFY2(fit.cDays > c / 2.0 && fit.cDays < c * 2.0, qPrintable(QString::number(fit.cDays)));
+
+    // K follows from the event count over the fitted decay
+    const double expectedK = 4000.0 / ((head - tail) / (p - 1.0));
+    QVERIFY(qAbs(fit.k - expectedK) < 0.2 * expectedK);
+
+    QVERIFY(!statistics.omoriUtsu(window, 7.0).valid);
+}
+
+QTEST_MAIN(TestSeismicityStatistics)
+#include "testseismicitystatistics.moc"
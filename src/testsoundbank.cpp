@@ -0,0 +1,192 @@
+#include "sound_bank.hpp"
+
+#include <QtCore/QDir>
+#include <QtCore/QRandomGenerator>
+#include <QTest>
+
+// Declare the test class
+class TestSoundBank : public QObject {
+    Q_OBJECT
+private slots:
+    void testIdleVoice();
+    void testStealsSameTypeWhenAllBusy();
+    void testFullBudgetStealsOne();
+    void testPrefersSameTypeOnTies();
+    void testNeverStealsHigherPriority();
+    void testRandomizedBudget();
+    void testPreviewKeepsCustomSource();
+    void testSourceUrl();
+};
+
+using VoiceState = SoundBank::VoiceState;
+
+static VoiceState idleVoice(SoundType type) {
+    return VoiceState{type, NotificationPriority::Low, 0, false, true};
+}
+
+static VoiceState playingVoice(SoundType type, NotificationPriority priority, quint64 startedAt) {
+    return VoiceState{type, priority, startedAt, true, true};
+}
+
+void TestSoundBank::testIdleVoice() {
+    const QVector<VoiceState> voices = {
+        playingVoice(SoundType::Alert, NotificationPriority::High, 1), idleVoice(SoundType::Alert), idleVoice(SoundType::Beep)
+    };
+    int victim = 0;
+    QCOMPARE(SoundBank::selectVoice(voices, SoundType::Alert, NotificationPriority::Low, &victim), 1);
+    QCOMPARE(victim, -1);
+
+    // A voice still decoding is not idle
+    QVector<VoiceState> loading = voices;
+    loading[1].loaded = false;
+    QCOMPARE(SoundBank::selectVoice(loading, SoundType::Alert, NotificationPriority::Low, &victim), -1);
+    QCOMPARE(victim, -1);
+    QCOMPARE(SoundBank::selectVoice(loading, SoundType::Alert, NotificationPriority::High, &victim), 0);
+    QCOMPARE(victim, 0);
+}
+
+void TestSoundBank::testStealsSameTypeWhenAllBusy() {
+    const QVector<VoiceState> voices = {
+        playingVoice(SoundType::Beep, NotificationPriority::Low, 1),
+        playingVoice(SoundType::Alert, NotificationPriority::Normal, 2),
+        playingVoice(SoundType::Alert, NotificationPriority::Normal, 3),
+        idleVoice(SoundType::Beep)
+    };
+
+    // The lower priority Beep keeps playing; the older Alert makes room
+    int victim = -1;
+    QCOMPARE(SoundBank::selectVoice(voices, SoundType::Alert, NotificationPriority::High, &victim), 1);
+    QCOMPARE(victim, 1);
+}
+
+void TestSoundBank::testFullBudgetStealsOne() {
+    QCOMPARE(SoundBank::MAX_ACTIVE_VOICES, 4);
+
+    // Every Alert voice busy: one of them is reused, and nothing else stops
+    const QVector<VoiceState> busy = {
+        playingVoice(SoundType::Beep, NotificationPriority::Low, 1),
+        playingVoice(SoundType::Chime, NotificationPriority::Low, 2),
+        playingVoice(SoundType::Alert, NotificationPriority::Normal, 3),
+        playingVoice(SoundType::Alert, NotificationPriority::Normal, 4)
+    };
+    int victim = -1;
+    QCOMPARE(SoundBank::selectVoice(busy, SoundType::Alert, NotificationPriority::High, &victim), 2);
+    QCOMPARE(victim, 2);
+
+    // An idle Alert voice: the lowest priority voice of any type frees the slot
+    const QVector<VoiceState> idle = {
+        playingVoice(SoundType::Beep, NotificationPriority::Low, 2),
+        playingVoice(SoundType::Chime, NotificationPriority::Low, 1),
+        playingVoice(SoundType::Alert, NotificationPriority::Normal, 3),
+        playingVoice(SoundType::Warning, NotificationPriority::Normal, 4),
+        idleVoice(SoundType::Alert)
+    };
+    QCOMPARE(SoundBank::selectVoice(idle, SoundType::Alert, NotificationPriority::High, &victim), 4);
+    QCOMPARE(victim, 1);
+}
+
+void TestSoundBank::testPrefersSameTypeOnTies() {
+    const QVector<VoiceState> voices = {
+        playingVoice(SoundType::Beep, NotificationPriority::Normal, 1),
+        playingVoice(SoundType::Alert, NotificationPriority::Normal, 5),
+        playingVoice(SoundType::Chime, NotificationPriority::High, 2),
+        playingVoice(SoundType::Warning, NotificationPriority::High, 3),
+        idleVoice(SoundType::Alert)
+    };
+    int victim = -1;
+    QCOMPARE(SoundBank::selectVoice(voices, SoundType::Alert, NotificationPriority::Normal, &victim), 1);
+    QCOMPARE(victim, 1);
+
+    // Priority still comes first
+    QVector<VoiceState> lower = voices;
+    lower[0].priority = NotificationPriority::Low;
+    QCOMPARE(SoundBank::selectVoice(lower, SoundType::Alert, NotificationPriority::Normal, &victim), 4);
+    QCOMPARE(victim, 0);
+}
+
+void TestSoundBank::testNeverStealsHigherPriority() {
+    const QVector<VoiceState> voices = {
+        playingVoice(SoundType::Beep, NotificationPriority::Critical, 1),
+        playingVoice(SoundType::Chime, NotificationPriority::Critical, 2),
+        playingVoice(SoundType::Alert, NotificationPriority::Emergency, 3),
+        playingVoice(SoundType::Warning, NotificationPriority::Critical, 4),
+        idleVoice(SoundType::Alert)
+    };
+    int victim = 0;
+    QCOMPARE(SoundBank::selectVoice(voices, SoundType::Alert, NotificationPriority::High, &victim), -1);
+    QCOMPARE(victim, -1);
+    QCOMPARE(SoundBank::selectVoice(voices, SoundType::Alert, NotificationPriority::Critical, &victim), 4);
+    QCOMPARE(victim, 0);
+}
+
+void TestSoundBank::testRandomizedBudget() {
+    const QVector<SoundType> types = {SoundType::Beep, SoundType::Chime, SoundType::Alert,
+                                      SoundType::Warning, SoundType::Emergency};
+    QVector<VoiceState> voices;
+    for (SoundType type : types) {
+        for (int i = 0; i < SoundBank::VOICES_PER_SOUND; ++i) voices.append(idleVoice(type));
+    }
+
+    QRandomGenerator random(91);
+    quint64 sequence = 0;
+    for (int play = 0; play < 5000; ++play) {
+        // Some sounds finish on their own
+        for (VoiceState &voice : voices) {
+            if (voice.active && random.bounded(4) == 0) voice.active = false;
+        }
+
+        int active = 0;
+        for (const VoiceState &voice : voices) active += voice.active ? 1 : 0;
+
+        const SoundType type = types[random.bounded(types.size())];
+        const auto priority = NotificationPriority(1 + random.bounded(5));
+        int victim = -2;
+        const int index = SoundBank::selectVoice(voices, type, priority, &victim);
+        QVERIFY(victim >= -1 && victim < voices.size());
+        if (index < 0) {
+            QCOMPARE(victim, -1);
+            continue;
+        }
+
+        QCOMPARE(voices[index].type, type);
+        QVERIFY(!voices[index].active || index == victim);
+        if (victim >= 0) {
+            QVERIFY(voices[victim].active);
+            QVERIFY(voices[victim].priority <= priority);
+            QVERIFY(active >= SoundBank::MAX_ACTIVE_VOICES || victim == index);
+            voices[victim].active = false;
+        }
+        voices[index] = playingVoice(type, priority, ++sequence);
+
+        int after = 0;
+        for (const VoiceState &voice : voices) after += voice.active ? 1 : 0;
+        QVERIFY(after <= SoundBank::MAX_ACTIVE_VOICES);
+        QCOMPARE(after, active + (victim >= 0 ? 0 : 1));
+    }
+}
+
+void TestSoundBank::testPreviewKeepsCustomSource() {
+    SoundBank bank;
+    const QString custom = QDir::temp().filePath("custom-alert.wav");
+    const QString preview = QDir::temp().filePath("preview.wav");
+    bank.setSource(SoundType::Custom, custom);
+
+    QVERIFY(bank.playPreview(preview, 0.5f));
+    QCOMPARE(bank.source(SoundType::Custom), custom);
+    QCOMPARE(bank.previewSource(), QUrl::fromLocalFile(preview));
+    QCOMPARE(bank.activeVoiceCount(), 0);
+
+    QVERIFY(!bank.playPreview(QString(), 0.5f));
+    QCOMPARE(bank.previewSource(), QUrl::fromLocalFile(preview));
+    bank.stopAll();
+    QCOMPARE(bank.source(SoundType::Custom), custom);
+}
+
+void TestSoundBank::testSourceUrl() {
+    QCOMPARE(SoundBank::sourceUrl(":/sounds/alert.wav"), QUrl("qrc:/sounds/alert.wav"));
+    QCOMPARE(SoundBank::sourceUrl("qrc:/sounds/alert.wav"), QUrl("qrc:/sounds/alert.wav"));
+    QCOMPARE(SoundBank::sourceUrl("/tmp/alert.wav"), QUrl::fromLocalFile("/tmp/alert.wav"));
+}
+
+QTEST_MAIN(TestSoundBank)
+#include "testsoundbank.moc"
@@ -0,0 +1,219 @@
+#include "spatial_utils.hpp"
+#include "earthquake_data.hpp"
+#include "ground_motion.hpp"
+#include "travel_times.hpp"
+
+#include <QtCore/QRandomGenerator>
+#include <QTest>
+
+// Declare the test class
+class TestSpatialUtils : public QObject {
+    Q_OBJECT
+private slots:
+    void testEcefAgreesWithHaversine();
+    void testHypocentralDistance();
+    void testBatchKernel();
+    void testHypocentralClustering();
+    void testGeodesicDistance();
+    void testWithinDistance();
+    void testGreatCircleInterpolation();
+    void testDistanceReached();
+    void testTravelTimesIasp91();
+};
+
+void TestSpatialUtils::testEcefAgreesWithHaversine() {
+    const EcefPoint origin = SpatialUtils::toEcef(0.0, 0.0);
+    QCOMPARE(origin.x, SpatialUtils::EARTH_RADIUS_KM);
+    QVERIFY(qAbs(SpatialUtils::toEcef(90.0, 0.0).z - SpatialUtils::EARTH_RADIUS_KM) < 1e-9);
+    QVERIFY(qAbs(SpatialUtils::toEcef(0.0, 0.0, 100.0).x - (SpatialUtils::EARTH_RADIUS_KM - 100.0)) < 1e-9);
+
+    // At the surface the straight line is the chord of the great circle
+    const double arc = SpatialUtils::haversineDistance(35.0, 139.0, -33.0, -71.0);
+    const double chord = SpatialUtils::hypocentralSeparation(35.0, 139.0, 0.0, -33.0, -71.0, 0.0);
+    QVERIFY(qAbs(chord - 2.0 * SpatialUtils::EARTH_RADIUS_KM * std::sin(arc / (2.0 * SpatialUtils::EARTH_RADIUS_KM))) < 1e-6);
+}
+
+void TestSpatialUtils::testHypocentralDistance() {
+    QCOMPARE(SpatialUtils::hypocentralDistance(0.0, 35.0), 35.0);
+
+    // Close in it is the flat-Earth hypotenuse; far out, curvature shortens it
+    QVERIFY(qAbs(SpatialUtils::hypocentralDistance(30.0, 40.0) - 50.0) < 0.1);
+    QVERIFY(SpatialUtils::hypocentralDistance(1000.0, 10.0) < 999.0);
+
+    QRandomGenerator rng(5);
+    for (int i = 0; i < 1000; ++i) {
+        const double lat1 = -90.0 + 180.0 * rng.generateDouble();
+        const double lon1 = -180.0 + 360.0 * rng.generateDouble();
+        const double lat2 = -90.0 + 180.0 * rng.generateDouble();
+        const double lon2 = -180.0 + 360.0 * rng.generateDouble();
+        const double depth = 700.0 * rng.generateDouble();
+        const double epicentral = SpatialUtils::haversineDistance(lat1, lon1, lat2, lon2);
+        QVERIFY(qAbs(SpatialUtils::hypocentralDistance(epicentral, depth)
+                     - SpatialUtils::hypocentralSeparation(lat1, lon1, 0.0, lat2, lon2, depth)) < 1e-6);
+    }
+    QCOMPARE(GroundMotionModel::hypocentralDistance(250.0, 20.0), SpatialUtils::hypocentralDistance(250.0, 20.0));
+}
+
+void TestSpatialUtils::testBatchKernel() {
+    QVector<EarthquakeData> earthquakes;
+    for (int i = 0; i < 37; ++i) {
+        EarthquakeData eq;
+        eq.latitude = -60.0 + 3.0 * i;
+        eq.longitude = 170.0 + 0.5 * i;
+        eq.depth = 15.0 * i;
+        earthquakes.append(eq);
+    }
+    const EcefPoints hypocenters = SpatialUtils::toEcef(earthquakes);
+    QCOMPARE(hypocenters.size(), earthquakes.size());
+
+    const EcefPoint site = SpatialUtils::toEcef(-41.3, 174.8);
+    QVector<double> distances;
+    SpatialUtils::distances3D(site, hypocenters, distances);
+    QCOMPARE(distances.size(), earthquakes.size());
+    for (int i = 0; i < earthquakes.size(); ++i) {
+        QVERIFY(qAbs(distances[i] - SpatialUtils::distance3D(site, hypocenters.at(i))) < 1e-9);
+    }
+}
+
+void TestSpatialUtils::testHypocentralClustering() {
+    EcefPoints points;
+    points.append(SpatialUtils::toEcef(36.0, 141.0, 10.0));  // 0: shallow sequence
+    points.append(SpatialUtils::toEcef(36.05, 141.0, 12.0)); // 1
+    points.append(SpatialUtils::toEcef(36.0, 141.0, 400.0)); // 2: deep, same epicenter
+    points.append(SpatialUtils::toEcef(36.1, 141.0, 14.0));  // 3: chained through 1
+    points.append(SpatialUtils::toEcef(-20.0, -70.0, 100.0)); // 4
+
+    const QVector<QVector<int>> clusters = SpatialUtils::hypocentralClustering(points, 10.0);
+    QCOMPARE(clusters.size(), 3);
+    QCOMPARE(clusters[0], QVector<int>({0, 1, 3}));
+    QCOMPARE(clusters[1], QVector<int>({2}));
+    QCOMPARE(clusters[2], QVector<int>({4}));
+
+    QVERIFY(SpatialUtils::hypocentralClustering(EcefPoints(), 10.0).isEmpty());
+}
+
+void TestSpatialUtils::testGeodesicDistance() {
+    // Reference values on WGS84
+    QVERIFY(qAbs(SpatialUtils::geodesicDistance(0.0, 0.0, 0.0, 1.0) - 111.319491) < 1e-5);
+    QVERIFY(qAbs(SpatialUtils::geodesicDistance(0.0, 0.0, 90.0, 0.0) - 10001.965729) < 1e-5);
+    const double flindersToBuninyong = SpatialUtils::geodesicDistance(
+        -37.95103342, 144.42486789, -37.65282114, 143.92649554);
+    QVERIFY(qAbs(flindersToBuninyong - 54.972271) < 1e-5);
+
+    QCOMPARE(SpatialUtils::geodesicDistance(35.0, 139.0, 35.0, 139.0), 0.0);
+    QVERIFY(qAbs(SpatialUtils::geodesicDistance(10.0, 179.5, 10.0, -179.5)
+                 - SpatialUtils::geodesicDistance(10.0, -0.5, 10.0, 0.5)) < 1e-9);
+    // Nearly antipodal points, where Vincenty does not converge (Karney 2013, table 4)
+    QVERIFY(qAbs(SpatialUtils::geodesicDistance(-30.0, 0.0, 29.9, 179.8) - 19989.832827610) < 1e-6);
+    QVERIFY(qAbs(SpatialUtils::geodesicDistance(0.0, 0.0, 0.0, 180.0) - 20003.931458623) < 1e-6);
+    const double antipodal = SpatialUtils::geodesicDistance(0.0, 0.0, 0.5, 179.7);
+    QVERIFY(qAbs(antipodal - 19944.127421) < 1e-5);
+    QVERIFY(SpatialUtils::isWithinDistance(0.0, 0.0, 0.5, 179.7, antipodal + 0.001));
+    QVERIFY(!SpatialUtils::isWithinDistance(0.0, 0.0, 0.5, 179.7, antipodal - 0.001));
+
+    // Distances run on smoothly from the converging side into that band
+    double previous = SpatialUtils::geodesicDistance(0.0, 0.0, 0.3, 179.0);
+    for (double lon = 179.05; lon <= 179.95; lon += 0.05) {
+        const double distance = SpatialUtils::geodesicDistance(0.0, 0.0, 0.3, lon);
+        QVERIFY(distance > previous && distance - previous < 5.0);
+        previous = distance;
+    }
+}
+
+void TestSpatialUtils::testWithinDistance() {
+    QRandomGenerator rng(5);
+    for (int i = 0; i < 20000; ++i) {
+        const double lat1 = rng.generateDouble() * 170.0 - 85.0;
+        const double lon1 = rng.generateDouble() * 360.0 - 180.0;
+        const double lat2 = qBound(-90.0, lat1 + rng.generateDouble() * 20.0 - 10.0, 90.0);
+        const double lon2 = lon1 + rng.generateDouble() * 20.0 - 10.0;
+        const double geodesic = SpatialUtils::geodesicDistance(lat1, lon1, lat2, lon2);
+        if (geodesic < 1.0) continue;
+
+        // Radii either side of the geodesic, inside and outside the haversine band
+        const double factor = (i % 2 == 0) ? 1.0 + rng.generateDouble() * 0.02 : 1.0 - rng.generateDouble() * 0.02;
+        const double radius = geodesic * factor;
+        QCOMPARE(SpatialUtils::isWithinDistance(lat1, lon1, lat2, lon2, radius), geodesic <= radius);
+
+        // The cap bounds bracket the true boundary
+        double cosInner, cosOuter;
+        SpatialUtils::sphericalCapBounds(radius, cosInner, cosOuter);
+        const EcefPoint a = SpatialUtils::toEcef(lat1, lon1);
+        const EcefPoint b = SpatialUtils::toEcef(lat2, lon2);
+        const double r2 = SpatialUtils::EARTH_RADIUS_KM * SpatialUtils::EARTH_RADIUS_KM;
+        const double dot = (a.x * b.x + a.y * b.y + a.z * b.z) / r2;
+        if (dot >= cosInner) QVERIFY(geodesic <= radius);
+        if (dot < cosOuter) QVERIFY(geodesic > radius);
+    }
+}
+
+void TestSpatialUtils::testGreatCircleInterpolation() {
+    QRandomGenerator rng(11);
+    for (int i = 0; i < 1000; ++i) {
+        const double lat1 = rng.generateDouble() * 180.0 - 90.0;
+        const double lon1 = rng.generateDouble() * 360.0 - 180.0;
+        const double lat2 = rng.generateDouble() * 180.0 - 90.0;
+        const double lon2 = rng.generateDouble() * 360.0 - 180.0;
+        const double total = SpatialUtils::haversineDistance(lat1, lon1, lat2, lon2);
+        if (total > 19000.0) continue;
+
+        // On the great circle, the given fraction of the way along
+        const double fraction = rng.generateDouble();
+        const QPointF point = SpatialUtils::interpolateGreatCircle(lat1, lon1, lat2, lon2, fraction);
+        const double fromStart = SpatialUtils::haversineDistance(lat1, lon1, point.x(), point.y());
+        const double toEnd = SpatialUtils::haversineDistance(point.x(), point.y(), lat2, lon2);
+        QVERIFY(qAbs(fromStart - fraction * total) < 1e-3);
+        QVERIFY(qAbs(toEnd - (1.0 - fraction) * total) < 1e-3);
+    }
+
+    // Across the antimeridian the path stays short
+    const QPointF middle = SpatialUtils::interpolateGreatCircle(0.0, 170.0, 0.0, -170.0, 0.5);
+    QVERIFY(qAbs(middle.x()) < 1e-9);
+    QVERIFY(qAbs(qAbs(middle.y()) - 180.0) < 1e-9);
+    QCOMPARE(SpatialUtils::interpolateGreatCircle(10.0, 20.0, 10.0, 20.0, 0.3), QPointF(10.0, 20.0));
+}
+
+void TestSpatialUtils::testDistanceReached() {
+    for (double depth : {10.0, 100.0, 600.0}) {
+        for (double distance = 50.0; distance < 15000.0; distance *= 1.7) {
+            for (TravelTimes::Phase phase : {TravelTimes::Phase::P, TravelTimes::Phase::S}) {
+                const double elapsed = TravelTimes::travelTime(phase, distance, depth);
+                QVERIFY(qAbs(TravelTimes::distanceReached(phase, elapsed, depth) - distance) < 0.01);
+            }
+        }
+    }
+
+    // Nothing at the surface before the first arrival above the hypocenter
+    QCOMPARE(TravelTimes::distanceReached(TravelTimes::Phase::P, 1.0, 100.0), 0.0);
+    QVERIFY(TravelTimes::distanceReached(TravelTimes::Phase::S, 60.0, 10.0)
+            < TravelTimes::distanceReached(TravelTimes::Phase::P, 60.0, 10.0));
+}
+
+void TestSpatialUtils::testTravelTimesIasp91() {
+    // iasp91 first arrivals (Kennett & Engdahl, 1991) in seconds; at 100
+    // degrees P and S are diffracted along the core-mantle boundary
+    struct Case { double degrees; double depth; double p; double s; };
+    const Case cases[] = {
+        {10.0, 0.0, 144.9, 259.1},
+        {30.0, 0.0, 370.3, 670.3},
+        {100.0, 0.0, 826.8, 1522.5},
+        {10.0, 100.0, 140.6, 251.5},
+        {30.0, 100.0, 359.1, 650.5},
+        {100.0, 100.0, 813.5, 1499.3},
+    };
+    const double kmPerDegree = M_PI * SpatialUtils::EARTH_RADIUS_KM / 180.0;
+    for (const Case &c : cases) {
+        const double tolerance = c.degrees > 90.0 ? 1.5 : 0.5;
+        const double p = TravelTimes::travelTime(TravelTimes::Phase::P, c.degrees * kmPerDegree, c.depth);
+        const double s = TravelTimes::travelTime(TravelTimes::Phase::S, c.degrees * kmPerDegree, c.depth);
+        QVERIFY2(qAbs(p - c.p) < tolerance, qPrintable(QString("P at %1 deg, %2 km: %3").arg(c.degrees).arg(c.depth).arg(p)));
+        QVERIFY2(qAbs(s - c.s) < tolerance, qPrintable(QString("S at %1 deg, %2 km: %3").arg(c.degrees).arg(c.depth).arg(s)));
+        QVERIFY(qAbs(TravelTimes::sMinusP(c.degrees * kmPerDegree, c.depth) - (s - p)) < 1e-9);
+    }
+
+    // TauP's iasp91 P for a 55 km source at 67 degrees, between table rows
+    QVERIFY(qAbs(TravelTimes::travelTime(TravelTimes::Phase::P, 67.0 * kmPerDegree, 55.0) - 647.04) < 0.5);
+}
+
+QTEST_MAIN(TestSpatialUtils)
+#include "testspatialutils.moc"
@@ -0,0 +1,290 @@
+#include "streaming_download.hpp"
+
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+#include <QSignalSpy>
+#include <QTest>
+#include <memory>
+
+// Local stand-in for a catalog server. Serves one resource with an ETag and
+// honours "Range: bytes=<start>-" (guarded by If-Range) unless told not to.
+// Each response follows the next scripted Response, then the default.
+class StubRangeServer : public QTcpServer {
+public:
+    struct Response {
+        qint64 cutAfter = -1; // Body bytes sent before the connection drops; -1 sends it all
+        bool chunked = false; // A cut chunked body also loses its terminating chunk
+    };
+
+    QByteArray resource;
+    QByteArray etag = "\"v1\"";
+    bool honourRanges = true;
+    QList<Response> script;
+
+    // Per request, in arrival order
+    QList<QByteArray> ranges;
+    QList<QByteArray> ifRanges;
+    QList<int> statuses;
+
+    StubRangeServer() {
+        connect(this, &QTcpServer::newConnection, this, [this]() {
+            while (hasPendingConnections()) {
+                serve(nextPendingConnection());
+            }
+        });
+        listen(QHostAddress::LocalHost, 0);
+    }
+
+    QUrl url() const { return QUrl(QString("http://127.0.0.1:%1/catalog.csv").arg(serverPort())); }
+
+private:
+    void serve(QTcpSocket *socket) {
+        auto buffer = std::make_shared<QByteArray>();
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, socket, [this, socket, buffer]() {
+            buffer->append(socket->readAll());
+            const qsizetype headerEnd = buffer->indexOf("\r\n\r\n");
+            if (headerEnd < 0) {
+                return;
+            }
+            QByteArray range;
+            QByteArray ifRange;
+            for (const QByteArray &line : buffer->left(headerEnd).split('\n')) {
+                const QByteArray lower = line.toLower();
+                if (lower.startsWith("range:")) range = line.mid(6).trimmed();
+                if (lower.startsWith("if-range:")) ifRange = line.mid(9).trimmed();
+            }
+            buffer->remove(0, headerEnd + 4);
+            respond(socket, range, ifRange);
+        });
+    }
+
+    void respond(QTcpSocket *socket, const QByteArray &range, const QByteArray &ifRange) {
+        ranges.append(range);
+        ifRanges.append(ifRange);
+        const Response response = script.isEmpty() ? Response() : script.takeFirst();
+        const qint64 size = resource.size();
+
+        int status = 200;
+        QByteArray headers;
+        QByteArray body = resource;
+        if (!range.isEmpty() && honourRanges && (ifRange.isEmpty() || ifRange == etag)) {
+            const qint64 start = range.mid(6, range.indexOf('-') - 6).toLongLong();
+            if (start >= size) {
+                status = 416;
+                headers = "Content-Range: bytes */" + QByteArray::number(size) + "\r\n";
+                body.clear();
+            } else {
+                status = 206;
+                headers = "Content-Range: bytes " + QByteArray::number(start) + "-" + QByteArray::number(size - 1)
+                          + "/" + QByteArray::number(size) + "\r\n";
+                body = resource.mid(start);
+            }
+        }
+        statuses.append(status);
+
+        QByteArray head = "HTTP/1.1 " + QByteArray::number(status) + " Stub\r\nETag: " + etag + "\r\n" + headers;
+        const QByteArray sent = response.cutAfter >= 0 ? body.left(response.cutAfter) : body;
+        if (response.chunked) {
+            socket->write(head + "Transfer-Encoding: chunked\r\n\r\n");
+            if (!sent.isEmpty()) {
+                socket->write(QByteArray::number(sent.size(), 16) + "\r\n" + sent + "\r\n");
+            }
+            if (response.cutAfter < 0) {
+                socket->write("0\r\n\r\n");
+            }
+        } else {
+            socket->write(head + "Content-Length: " + QByteArray::number(body.size()) + "\r\n\r\n" + sent);
+        }
+        if (response.cutAfter >= 0) {
+            socket->disconnectFromHost();
+        }
+    }
+};
+
+// Declare the test class
+class TestStreamingDownload : public QObject {
+    Q_OBJECT
+private slots:
+    void init();
+    void testCompleteDownload();
+    void testResumesWithRange();
+    void testIfRangeMismatchRestarts();
+    void testServerIgnoresRange();
+    void testRangeNotSatisfiableCompletes();
+    void testRangeNotSatisfiableRestarts();
+    void testGivesUpAfterMaxRetries();
+
+private:
+    StreamingDownload *download(QNetworkAccessManager *manager, const StubRangeServer &server);
+    QByteArray downloaded() const;
+
+    std::unique_ptr<QTemporaryDir> m_dir;
+};
+
+static QByteArray makeResource(int size, char seed) {
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i) {
+        data[i] = char(seed + (i * 7) % 61);
+    }
+    return data;
+}
+
+void TestStreamingDownload::init() {
+    m_dir = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_dir->isValid());
+}
+
+StreamingDownload *TestStreamingDownload::download(QNetworkAccessManager *manager, const StubRangeServer &server) {
+    auto *download = new StreamingDownload(manager, server.url(), m_dir->filePath("catalog.dat"), manager);
+    download->setChunkSize(16 * 1024);
+    download->setRetryDelay(10);
+    download->setMaxRetries(3);
+    return download;
+}
+
+QByteArray TestStreamingDownload::downloaded() const {
+    QFile file(m_dir->filePath("catalog.dat"));
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+void TestStreamingDownload::testCompleteDownload() {
+    StubRangeServer server;
+    server.resource = makeResource(300000, 'a');
+    QNetworkAccessManager manager;
+    StreamingDownload *transfer = download(&manager, server);
+    QSignalSpy finished(transfer, &StreamingDownload::finished);
+    QSignalSpy progress(transfer, &StreamingDownload::progress);
+    transfer->start();
+
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(downloaded(), server.resource);
+    QCOMPARE(server.ranges, QList<QByteArray>{QByteArray()});
+    QCOMPARE(transfer->resumeCount(), 0);
+    QCOMPARE(progress.last().at(0).toLongLong(), qint64(server.resource.size()));
+    QCOMPARE(progress.last().at(1).toLongLong(), qint64(server.resource.size()));
+    QVERIFY(!QFile::exists(m_dir->filePath("catalog.dat.part")));
+}
+
+void TestStreamingDownload::testResumesWithRange() {
+    StubRangeServer server;
+    server.resource = makeResource(300000, 'a');
+    server.script = {StubRangeServer::Response{100000, false}};
+    QNetworkAccessManager manager;
+    StreamingDownload *transfer = download(&manager, server);
+    QSignalSpy finished(transfer, &StreamingDownload::finished);
+    QSignalSpy resumed(transfer, &StreamingDownload::resumed);
+    transfer->start();
+
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(downloaded(), server.resource);
+    QCOMPARE(resumed.count(), 1);
+    QCOMPARE(resumed.first().at(0).toLongLong(), qint64(100000));
+    QCOMPARE(server.statuses, (QList<int>{200, 206}));
+    QCOMPARE(server.ranges[1], QByteArray("bytes=100000-"));
+    QCOMPARE(server.ifRanges[1], server.etag);
+    QCOMPARE(transfer->resumeCount(), 1);
+}
+
+void TestStreamingDownload::testIfRangeMismatchRestarts() {
+    StubRangeServer server;
+    server.resource = makeResource(300000, 'a');
+    server.script = {StubRangeServer::Response{100000, false}};
+    QNetworkAccessManager manager;
+    StreamingDownload *transfer = download(&manager, server);
+    QSignalSpy finished(transfer, &StreamingDownload::finished);
+
+    // The catalog is regenerated while the transfer is interrupted
+    const QByteArray updated = makeResource(250000, 'A');
+    connect(transfer, &StreamingDownload::resumed, this, [&server, updated]() {
+        server.resource = updated;
+        server.etag = "\"v2\"";
+    });
+    transfer->start();
+
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(downloaded(), updated);
+    QCOMPARE(server.statuses, (QList<int>{200, 200}));
+    QCOMPARE(server.ifRanges[1], QByteArray("\"v1\""));
+}
+
+void TestStreamingDownload::testServerIgnoresRange() {
+    StubRangeServer server;
+    server.resource = makeResource(300000, 'a');
+    server.honourRanges = false;
+    server.script = {StubRangeServer::Response{100000, false}};
+    QNetworkAccessManager manager;
+    StreamingDownload *transfer = download(&manager, server);
+    QSignalSpy finished(transfer, &StreamingDownload::finished);
+    transfer->start();
+
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(downloaded(), server.resource);
+    QCOMPARE(server.statuses, (QList<int>{200, 200}));
+    QCOMPARE(server.ranges[1], QByteArray("bytes=100000-"));
+}
+
+void TestStreamingDownload::testRangeNotSatisfiableCompletes() {
+    // The whole chunked body arrives, then the connection drops before its end
+    StubRangeServer server;
+    server.resource = makeResource(200000, 'a');
+    server.script = {StubRangeServer::Response{200000, true}};
+    QNetworkAccessManager manager;
+    StreamingDownload *transfer = download(&manager, server);
+    QSignalSpy finished(transfer, &StreamingDownload::finished);
+    transfer->start();
+
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(downloaded(), server.resource);
+    QCOMPARE(server.statuses, (QList<int>{200, 416}));
+    QCOMPARE(server.ranges[1], QByteArray("bytes=200000-"));
+}
+
+void TestStreamingDownload::testRangeNotSatisfiableRestarts() {
+    StubRangeServer server;
+    server.resource = makeResource(300000, 'a');
+    server.script = {StubRangeServer::Response{100000, false}};
+    QNetworkAccessManager manager;
+    StreamingDownload *transfer = download(&manager, server);
+    QSignalSpy finished(transfer, &StreamingDownload::finished);
+
+    // Truncated under the same validator: the range now starts past the end
+    const QByteArray truncated = server.resource.left(50000);
+    bool changed = false;
+    connect(transfer, &StreamingDownload::resumed, this, [&server, &changed, truncated]() {
+        if (changed) return;
+        changed = true;
+        server.resource = truncated;
+    });
+    transfer->start();
+
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(downloaded(), truncated);
+    QCOMPARE(server.statuses, (QList<int>{200, 416, 200}));
+    QVERIFY(server.ranges[2].isEmpty());
+}
+
+void TestStreamingDownload::testGivesUpAfterMaxRetries() {
+    StubRangeServer server;
+    server.resource = makeResource(100000, 'a');
+    server.script = {StubRangeServer::Response{1000, false}, StubRangeServer::Response{0, false},
+                     StubRangeServer::Response{0, false}, StubRangeServer::Response{0, false},
+                     StubRangeServer::Response{0, false}};
+    QNetworkAccessManager manager;
+    StreamingDownload *transfer = download(&manager, server);
+    QSignalSpy finished(transfer, &StreamingDownload::finished);
+    QSignalSpy failed(transfer, &StreamingDownload::failed);
+    transfer->start();
+
+    // Attempts without progress count; the first one made some
+    QTRY_COMPARE(failed.count(), 1);
+    QCOMPARE(finished.count(), 0);
+    QCOMPARE(server.ranges.size(), 4);
+    QVERIFY(!QFile::exists(m_dir->filePath("catalog.dat.part")));
+    QVERIFY(!QFile::exists(m_dir->filePath("catalog.dat")));
+}
+
+QTEST_MAIN(TestStreamingDownload)
+#include "teststreamingdownload.moc"
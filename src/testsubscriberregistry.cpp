@@ -0,0 +1,153 @@
+#include "subscriber_registry.hpp"
+#include "spatial_utils.hpp"
+
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QSet>
+#include <QTest>
+
+// Declare the test class
+class TestSubscriberRegistry : public QObject {
+    Q_OBJECT
+private slots:
+    void testMatchesBruteForce();
+    void testCooldownAndRateLimit();
+    void testQuietHours();
+    void testRemoveKeepsOthers();
+    void testJsonRoundTrip();
+};
+
+static const qint64 DAY_MS = 24 * 3600 * 1000LL;
+static const qint64 START_MS = 1700006400000LL; // 2023-11-15 00:00 UTC
+
+static Subscriber makeSubscriber(const QString &id, double latitude, double longitude) {
+    Subscriber subscriber;
+    subscriber.id = id;
+    subscriber.latitude = latitude;
+    subscriber.longitude = longitude;
+    subscriber.channels = {DeliveryChannel::SMSAlert};
+    subscriber.phone = "+1555" + id;
+    return subscriber;
+}
+
+static EarthquakeData makeEvent(double latitude, double longitude, double magnitude) {
+    EarthquakeData eq;
+    eq.latitude = latitude;
+    eq.longitude = longitude;
+    eq.magnitude = magnitude;
+    eq.depth = 10.0;
+    return eq;
+}
+
+void TestSubscriberRegistry::testMatchesBruteForce() {
+    QRandomGenerator rng(7);
+    SubscriberRegistry registry;
+    QVector<Subscriber> subscribers;
+    for (int i = 0; i < 20000; ++i) {
+        // Half clustered around Japan, half anywhere including the poles and the antimeridian
+        const bool clustered = i % 2;
+        Subscriber s = makeSubscriber(QString::number(i),
+                                      clustered ? 30.0 + 15.0 * rng.generateDouble() : -90.0 + 180.0 * rng.generateDouble(),
+                                      clustered ? 130.0 + 15.0 * rng.generateDouble() : -180.0 + 360.0 * rng.generateDouble());
+        s.radiusKm = i % 500 == 0 ? 5000.0 : 50.0 + 700.0 * rng.generateDouble();
+        s.minMagnitude = 3.0 + 3.0 * rng.generateDouble();
+        registry.add(s);
+        subscribers.append(s);
+    }
+
+    const QVector<EarthquakeData> events = {
+        makeEvent(36.0, 141.0, 6.5), makeEvent(0.0, 179.9, 6.5), makeEvent(89.5, 10.0, 6.5),
+        makeEvent(-33.0, -71.0, 5.0), makeEvent(51.0, -179.0, 6.0)};
+    for (int e = 0; e < events.size(); ++e) {
+        const EarthquakeData &eq = events[e];
+        QSet<QString> matched;
+        for (const SubscriberRegistry::Match &match : registry.match(eq, START_MS + e * DAY_MS)) {
+            matched.insert(registry.subscriber(match.index).id);
+        }
+        for (const Subscriber &s : subscribers) {
+            const double distance = SpatialUtils::geodesicDistance(eq.latitude, eq.longitude, s.latitude, s.longitude);
+            if (qAbs(distance - s.radiusKm) < 0.05) continue; // Float precision at the edge
+            const bool expected = eq.magnitude >= s.minMagnitude && distance <= s.radiusKm;
+            QVERIFY2(matched.contains(s.id) == expected, qPrintable(QString("event %1, subscriber %2").arg(e).arg(s.id)));
+        }
+    }
+}
+
+void TestSubscriberRegistry::testCooldownAndRateLimit() {
+    SubscriberRegistry registry;
+    Subscriber s = makeSubscriber("a", 35.0, 139.0);
+    s.cooldownSeconds = 600;
+    s.maxAlertsPerHour = 3;
+    registry.add(s);
+
+    const EarthquakeData eq = makeEvent(35.1, 139.1, 5.5);
+    QCOMPARE(registry.match(eq, START_MS).size(), 1);
+    QCOMPARE(registry.match(eq, START_MS + 1000).size(), 0);                   // Cooling down
+    QCOMPARE(registry.match(makeEvent(35.1, 139.1, 6.6), START_MS + 2000).size(), 1); // A much larger event still goes
+    QCOMPARE(registry.match(eq, START_MS + 700000).size(), 1);
+    QCOMPARE(registry.match(eq, START_MS + 1400000).size(), 0);                // Fourth alert this hour
+    QCOMPARE(registry.match(eq, START_MS + 3700000).size(), 1);
+}
+
+void TestSubscriberRegistry::testQuietHours() {
+    SubscriberRegistry registry;
+    Subscriber s = makeSubscriber("tokyo", 35.0, 139.0);
+    s.quietHoursStart = 22;
+    s.quietHoursEnd = 7;
+    s.utcOffsetMinutes = 9 * 60;
+    s.cooldownSeconds = 0;
+    registry.add(s);
+
+    // 14:00 UTC is 23:00 in Tokyo
+    const qint64 lateEvening = START_MS + 14 * 3600 * 1000LL;
+    QCOMPARE(registry.match(makeEvent(35.1, 139.1, 5.5), lateEvening).size(), 0);
+    QCOMPARE(registry.match(makeEvent(35.1, 139.1, 7.2), lateEvening + 1).size(), 1);
+    // 03:00 UTC is noon
+    QCOMPARE(registry.match(makeEvent(35.1, 139.1, 5.5), START_MS + 3 * 3600 * 1000LL).size(), 1);
+}
+
+void TestSubscriberRegistry::testRemoveKeepsOthers() {
+    SubscriberRegistry registry;
+    registry.add(makeSubscriber("a", 35.0, 139.0));
+    registry.add(makeSubscriber("b", 35.2, 139.2));
+    registry.add(makeSubscriber("c", 35.4, 139.4));
+
+    QVERIFY(registry.remove("a"));
+    QVERIFY(!registry.remove("a"));
+    QCOMPARE(registry.size(), 2);
+    QCOMPARE(registry.subscriber(registry.indexOf("c")).id, QString("c"));
+    QCOMPARE(registry.contact(registry.indexOf("c"), DeliveryChannel::SMSAlert), QString("+1555c"));
+    QCOMPARE(registry.contact(registry.indexOf("c"), DeliveryChannel::EmailAlert), QString());
+    QCOMPARE(registry.match(makeEvent(35.1, 139.1, 6.0), START_MS).size(), 2);
+}
+
+void TestSubscriberRegistry::testJsonRoundTrip() {
+    SubscriberRegistry registry;
+    Subscriber s = makeSubscriber("a", -33.4, -70.6);
+    s.channels = {DeliveryChannel::EmailAlert, DeliveryChannel::PushNotification};
+    s.email = "a@example.com";
+    s.pushToken = "token-a";
+    s.quietHoursStart = 23;
+    s.quietHoursEnd = 6;
+    s.utcOffsetMinutes = -180;
+    s.minIntensity = 4.0;
+    registry.add(s);
+
+    SubscriberRegistry loaded;
+    QString error;
+    QVERIFY2(loaded.loadJson(registry.toJson(), &error), qPrintable(error));
+    const Subscriber copy = loaded.subscriber(0);
+    QCOMPARE(copy.id, s.id);
+    QCOMPARE(copy.latitude, s.latitude);
+    QCOMPARE(copy.channels, s.channels);
+    QCOMPARE(copy.email, s.email);
+    QCOMPARE(copy.pushToken, s.pushToken);
+    QCOMPARE(copy.quietHoursStart, 23);
+    QCOMPARE(copy.utcOffsetMinutes, -180);
+    QCOMPARE(copy.minIntensity, 4.0);
+
+    QVERIFY(!loaded.loadJson("{\"id\": \"x\"}", &error));
+    QVERIFY(!loaded.loadJson("[{\"latitude\": 10}]", &error));
+}
+
+QTEST_MAIN(TestSubscriberRegistry)
+#include "testsubscriberregistry.moc"
@@ -0,0 +1,127 @@
+#include "timing_wheel.hpp"
+
+#include <QtCore/QMap>
+#include <QtCore/QRandomGenerator>
+#include <QTest>
+
+// Declare the test class
+class TestTimingWheel : public QObject {
+    Q_OBJECT
+private slots:
+    void testFiresWhenDue();
+    void testCancel();
+    void testCascadesFromUpperLevels();
+    void testMatchesReference();
+};
+
+static const qint64 START_MS = 1700006400000LL;
+
+void TestTimingWheel::testFiresWhenDue() {
+    TimingWheel wheel(START_MS, 10);
+    QCOMPARE(wheel.nextWakeMs(), qint64(-1));
+
+    wheel.schedule(START_MS + 25, 1, "a");
+    wheel.schedule(START_MS + 5, 2, "b");
+    wheel.schedule(START_MS - 1000, 3, "past");
+    QCOMPARE(wheel.size(), 3);
+
+    QVector<TimingWheel::Timer> fired = wheel.advance(START_MS);
+    QCOMPARE(fired.size(), 1);
+    QCOMPARE(fired[0].key, QString("past"));
+
+    // Due times round up to the 10 ms tick, never down
+    QCOMPARE(wheel.nextWakeMs(), START_MS + 10);
+    fired = wheel.advance(START_MS + 9);
+    QVERIFY(fired.isEmpty());
+    fired = wheel.advance(START_MS + 10);
+    QCOMPARE(fired.size(), 1);
+    QCOMPARE(fired[0].kind, 2);
+
+    QCOMPARE(wheel.nextWakeMs(), START_MS + 30);
+    fired = wheel.advance(START_MS + 1000);
+    QCOMPARE(fired.size(), 1);
+    QCOMPARE(fired[0].key, QString("a"));
+    QCOMPARE(fired[0].dueMs, START_MS + 25);
+    QCOMPARE(wheel.size(), 0);
+}
+
+void TestTimingWheel::testCancel() {
+    TimingWheel wheel(START_MS, 10);
+    const TimingWheel::TimerId a = wheel.schedule(START_MS + 100, 1, "a");
+    const TimingWheel::TimerId b = wheel.schedule(START_MS + 100, 1, "b");
+    QVERIFY(a != 0 && b != 0 && a != b);
+
+    QVERIFY(wheel.cancel(a));
+    QVERIFY(!wheel.cancel(a));
+    const QVector<TimingWheel::Timer> fired = wheel.advance(START_MS + 100);
+    QCOMPARE(fired.size(), 1);
+    QCOMPARE(fired[0].id, b);
+    QVERIFY(!wheel.cancel(b));
+
+    // A reused node gets a new id, so stale ids stay dead
+    const TimingWheel::TimerId c = wheel.schedule(START_MS + 200, 1, "c");
+    QVERIFY(c != a && c != b);
+    QVERIFY(!wheel.cancel(a));
+    QCOMPARE(wheel.size(), 1);
+}
+
+void TestTimingWheel::testCascadesFromUpperLevels() {
+    TimingWheel wheel(START_MS, 10);
+    const qint64 hour = 3600 * 1000LL;
+    const qint64 year = 365 * 24 * hour;
+    wheel.schedule(START_MS + hour, 1, "hour");
+    wheel.schedule(START_MS + 30 * 24 * hour + 7, 1, "month");
+    wheel.schedule(START_MS + 2 * year, 1, "years");
+
+    // Following nextWakeMs() lands on each due tick exactly
+    QStringList order;
+    qint64 now = START_MS;
+    int wakes = 0;
+    while (wheel.size() > 0 && wakes < 1000) {
+        now = wheel.nextWakeMs();
+        for (const TimingWheel::Timer &timer : wheel.advance(now)) {
+            QCOMPARE(now, (timer.dueMs + 9) / 10 * 10);
+            order.append(timer.key);
+        }
+        ++wakes;
+    }
+    QCOMPARE(order, QStringList({"hour", "month", "years"}));
+    QVERIFY(wakes < 100);
+}
+
+void TestTimingWheel::testMatchesReference() {
+    QRandomGenerator rng(11);
+    TimingWheel wheel(START_MS, 10);
+    QMap<TimingWheel::TimerId, qint64> pending;
+    qint64 now = START_MS;
+
+    for (int step = 0; step < 20000; ++step) {
+        const int op = rng.bounded(10);
+        if (op < 5) {
+            const qint64 range = op < 2 ? 1000 : (op < 4 ? 600000 : 7 * 24 * 3600 * 1000LL);
+            const qint64 due = now + qint64(rng.generateDouble() * range);
+            pending.insert(wheel.schedule(due, 0), due);
+        } else if (op < 6 && !pending.isEmpty()) {
+            const TimingWheel::TimerId id = pending.firstKey();
+            QVERIFY(wheel.cancel(id));
+            pending.remove(id);
+        } else {
+            now += rng.bounded(op == 9 ? 3600000 : 2000);
+            qint64 previous = 0;
+            for (const TimingWheel::Timer &timer : wheel.advance(now)) {
+                QVERIFY(pending.contains(timer.id));
+                QVERIFY(timer.dueMs <= now);
+                QVERIFY(timer.dueMs >= previous);
+                previous = timer.dueMs;
+                pending.remove(timer.id);
+            }
+            for (qint64 due : std::as_const(pending)) {
+                QVERIFY(due > now - 10); // Nothing left behind
+            }
+        }
+        QCOMPARE(wheel.size(), pending.size());
+    }
+}
+
+QTEST_MAIN(TestTimingWheel)
+#include "testtimingwheel.moc"
@@ -0,0 +1,240 @@
+#include "timing_wheel.hpp"
+
+#include <QtCore/QtAlgorithms>
+#include <algorithm>
+#include <limits>
+
+
+namespace {
+
+const int SLOT_BITS = 6;
+const int SLOTS_PER_LEVEL = 1 << SLOT_BITS;
+const qint64 SLOT_MASK = SLOTS_PER_LEVEL - 1;
+const int LEVEL_COUNT = 6;
+const qint64 MAX_DELTA_TICKS = (qint64(1) << (SLOT_BITS * LEVEL_COUNT)) - 1;
+
+qint64 levelSpan(int level)
+{
+    return qint64(1) << (SLOT_BITS * level);
+}
+
+qint64 floorDiv(qint64 value, qint64 divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+quint64 rotateRight(quint64 bits, int count)
+{
+    return count == 0 ? bits : (bits >> count) | (bits << (64 - count));
+}
+
+} // namespace
+
+
+TimingWheel::TimingWheel(qint64 nowMs, int resolutionMs)
+    : m_resolutionMs(qMax(1, resolutionMs))
+    , m_nextTick(floorDiv(nowMs, qMax(1, resolutionMs)))
+    , m_freeHead(-1)
+    , m_count(0)
+    , m_heads(LEVEL_COUNT * SLOTS_PER_LEVEL, -1)
+    , m_tails(LEVEL_COUNT * SLOTS_PER_LEVEL, -1)
+    , m_occupied(LEVEL_COUNT, 0)
+{
+}
+
+TimingWheel::TimerId TimingWheel::schedule(qint64 dueMs, int kind, const QString &key)
+{
+    QMutexLocker locker(&m_mutex);
+
+    int index = m_freeHead;
+    if (index >= 0) {
+        m_freeHead = m_nodes[index].next;
+    } else {
+        index = m_nodes.size();
+        m_nodes.append(Node());
+    }
+
+    Node &node = m_nodes[index];
+    node.dueTick = -floorDiv(-dueMs, m_resolutionMs); // Round up
+    node.dueMs = dueMs;
+    node.kind = kind;
+    node.key = key;
+    place(index);
+    ++m_count;
+    return (TimerId(node.generation) << 32) | TimerId(index);
+}
+
+bool TimingWheel::cancel(TimerId id)
+{
+    QMutexLocker locker(&m_mutex);
+
+    const int index = int(id & 0xffffffffu);
+    if (index >= m_nodes.size()) return false;
+    const Node &node = m_nodes[index];
+    if (node.slot < 0 || node.generation != quint32(id >> 32)) return false;
+
+    unlink(index);
+    release(index);
+    return true;
+}
+
+void TimingWheel::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_nodes.clear();
+    m_freeHead = -1;
+    m_count = 0;
+    std::fill(m_heads.begin(), m_heads.end(), -1);
+    std::fill(m_tails.begin(), m_tails.end(), -1);
+    std::fill(m_occupied.begin(), m_occupied.end(), 0);
+}
+
+QVector<TimingWheel::Timer> TimingWheel::advance(qint64 nowMs)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QVector<Timer> fired;
+    const qint64 nowTick = floorDiv(nowMs, m_resolutionMs);
+    while (m_nextTick <= nowTick) {
+        if (m_count == 0) {
+            m_nextTick = nowTick + 1;
+            break;
+        }
+
+        // Slots whose span starts at this tick move down, highest level first
+        const qint64 tick = m_nextTick;
+        int top = 0;
+        while (top + 1 < LEVEL_COUNT && (tick & (levelSpan(top + 1) - 1)) == 0) {
+            ++top;
+        }
+        for (int level = top; level >= 1; --level) {
+            const int slot = level * SLOTS_PER_LEVEL + int((tick >> (SLOT_BITS * level)) & SLOT_MASK);
+            for (int index = detachSlot(slot); index >= 0;) {
+                const int next = m_nodes[index].next;
+                place(index);
+                index = next;
+            }
+        }
+
+        for (int index = detachSlot(int(tick & SLOT_MASK)); index >= 0;) {
+            Node &node = m_nodes[index];
+            const int next = node.next;
+            fired.append(Timer{(TimerId(node.generation) << 32) | TimerId(index), node.kind, node.key, node.dueMs});
+            release(index);
+            index = next;
+        }
+
+        m_nextTick = tick + 1;
+        if (m_count > 0) {
+            m_nextTick = qMin(nextEventTickLocked(), nowTick + 1);
+        }
+    }
+
+    // Timers clamped to the same tick keep their requested order
+    std::stable_sort(fired.begin(), fired.end(), [](const Timer &a, const Timer &b) {
+        return a.dueMs < b.dueMs;
+    });
+    return fired;
+}
+
+qint64 TimingWheel::nextWakeMs() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_count == 0 ? -1 : nextEventTickLocked() * m_resolutionMs;
+}
+
+int TimingWheel::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_count;
+}
+
+void TimingWheel::place(int index)
+{
+    Node &node = m_nodes[index];
+    qint64 tick = qMax(node.dueTick, m_nextTick);
+    // Beyond the top level's reach: park in its last slot and re-place on cascade
+    tick = qMin(tick, m_nextTick + MAX_DELTA_TICKS);
+
+    const qint64 delta = tick - m_nextTick;
+    int level = 0;
+    while (level + 1 < LEVEL_COUNT && delta >= levelSpan(level + 1)) {
+        ++level;
+    }
+    link(index, level * SLOTS_PER_LEVEL + int((tick >> (SLOT_BITS * level)) & SLOT_MASK));
+}
+
+void TimingWheel::link(int index, int slot)
+{
+    Node &node = m_nodes[index];
+    node.slot = slot;
+    node.next = -1;
+    node.prev = m_tails[slot];
+    if (node.prev >= 0) {
+        m_nodes[node.prev].next = index;
+    } else {
+        m_heads[slot] = index;
+    }
+    m_tails[slot] = index;
+    m_occupied[slot / SLOTS_PER_LEVEL] |= quint64(1) << (slot % SLOTS_PER_LEVEL);
+}
+
+void TimingWheel::unlink(int index)
+{
+    Node &node = m_nodes[index];
+    const int slot = node.slot;
+    if (node.prev >= 0) {
+        m_nodes[node.prev].next = node.next;
+    } else {
+        m_heads[slot] = node.next;
+    }
+    if (node.next >= 0) {
+        m_nodes[node.next].prev = node.prev;
+    } else {
+        m_tails[slot] = node.prev;
+    }
+    if (m_heads[slot] < 0) {
+        m_occupied[slot / SLOTS_PER_LEVEL] &= ~(quint64(1) << (slot % SLOTS_PER_LEVEL));
+    }
+    node.slot = -1;
+}
+
+int TimingWheel::detachSlot(int slot)
+{
+    const int head = m_heads[slot];
+    m_heads[slot] = -1;
+    m_tails[slot] = -1;
+    m_occupied[slot / SLOTS_PER_LEVEL] &= ~(quint64(1) << (slot % SLOTS_PER_LEVEL));
+    return head;
+}
+
+void TimingWheel::release(int index)
+{
+    Node &node = m_nodes[index];
+    node.slot = -1;
+    node.key.clear();
+    ++node.generation;
+    node.next = m_freeHead;
+    m_freeHead = index;
+    --m_count;
+}
+
+qint64 TimingWheel::nextEventTickLocked() const
+{
+    qint64 best = std::numeric_limits<qint64>::max();
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        const quint64 bits = m_occupied[level];
+        if (bits == 0) continue;
+
+        // A slot's cascade is due when its span starts; the current span's
+        // cascade is still pending only if we are exactly at its start
+        const int shift = SLOT_BITS * level;
+        qint64 span = m_nextTick >> shift;
+        if (level > 0 && (m_nextTick & (levelSpan(level) - 1)) != 0) {
+            ++span;
+        }
+        const int offset = qCountTrailingZeroBits(rotateRight(bits, int(span & SLOT_MASK)));
+        best = qMin(best, (span + offset) << shift);
+    }
+    return best;
+}
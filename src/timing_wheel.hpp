@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QVector>
+
+
+// Hierarchical timing wheel for one-shot timers keyed by (kind, key).
+//
+// Time is divided into ticks of resolutionMs. Level 0 has one slot per tick
+// for the next 64 ticks; each level above covers 64 times the span of the
+// one below, so six levels reach about 21 years at 10 ms resolution. A timer
+// is linked into the slot of its due tick at the lowest level that can hold
+// it and moves down a level when that slot's span begins (cascade). Schedule
+// and cancel are O(1); advance() only visits occupied slots, skipping idle
+// stretches using the per-level occupancy bitmaps.
+//
+// Timers never fire early: a due time is rounded up to the next tick. The
+// owner arms a single timer for nextWakeMs() and calls advance() when it
+// expires. Thread-safe.
+class TimingWheel
+{
+public:
+    using TimerId = quint64;
+
+    struct Timer {
+        TimerId id;
+        int kind;
+        QString key;
+        qint64 dueMs;
+    };
+
+    explicit TimingWheel(qint64 nowMs, int resolutionMs = 10);
+
+    // Due times before the last advance() fire on the next one
+    TimerId schedule(qint64 dueMs, int kind, const QString &key = QString());
+    // Returns false if the timer already fired or was cancelled
+    bool cancel(TimerId id);
+    void clear();
+
+    // Timers due at or before nowMs, in due order
+    QVector<Timer> advance(qint64 nowMs);
+
+    // When advance() next has work to do (fire or cascade); -1 if empty
+    qint64 nextWakeMs() const;
+    int size() const;
+    int resolutionMs() const { return m_resolutionMs; }
+
+private:
+    struct Node {
+        qint64 dueTick = 0;
+        qint64 dueMs = 0;
+        int kind = 0;
+        QString key;
+        int prev = -1;
+        int next = -1;
+        int slot = -1; // -1 while free
+        quint32 generation = 1; // Ids are never 0
+    };
+
+    void place(int index);
+    void link(int index, int slot);
+    void unlink(int index);
+    int detachSlot(int slot);
+    void release(int index);
+    qint64 nextEventTickLocked() const;
+
+    mutable QMutex m_mutex;
+    const int m_resolutionMs;
+    qint64 m_nextTick; // First tick not yet processed
+
+    QVector<Node> m_nodes;
+    int m_freeHead;
+    int m_count;
+
+    // Per slot (level * 64 + index): first and last node of its list
+    QVector<int> m_heads;
+    QVector<int> m_tails;
+    QVector<quint64> m_occupied; // Per level: bit i set if slot i is non-empty
+};
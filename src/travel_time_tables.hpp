@@ -0,0 +1,1108 @@
+#pragma once
+
+// Generated by tools/generate_travel_time_tables.py; do not edit.
+//
+// First-arrival P and S travel times for the iasp91 Earth model, by source
+// depth (rows) and epicentral distance (columns). Each entry is the travel
+// time minus the straight hypocentral distance over the reference speed,
+// in tenths of a second.
+
+#include <cstdint>
+
+namespace TravelTimeTables {
+
+inline constexpr int DISTANCE_COUNT = 201;
+inline constexpr double DISTANCE_STEP_DEG = 0.5;
+inline constexpr int DEPTH_COUNT = 36;
+inline constexpr double DEPTH_STEP_KM = 20.0;
+inline constexpr double P_REFERENCE_SPEED_KM_S = 6.0;
+inline constexpr double S_REFERENCE_SPEED_KM_S = 3.5;
+inline constexpr double RESIDUAL_SCALE_S = 0.1;
+
+inline constexpr std::int16_t P_RESIDUAL[DEPTH_COUNT][DISTANCE_COUNT] = {
+    { // 0 km
+        0, 3, 6, 4, -20, -44, -68, -92, -116, -140, -164, -188, -212, -236, -260, -284,
+        -308, -332, -356, -380, -404, -428, -453, -477, -501, -525, -550, -574, -599, -623, -648, -674,
+        -702, -730, -759, -789, -820, -852, -890, -928, -966, -1004, -1042, -1081, -1120, -1159, -1199, -1239,
+        -1285, -1332, -1379, -1426, -1473, -1521, -1569, -1616, -1664, -1712, -1760, -1809, -1857, -1906, -1954, -2003,
+        -2052, -2100, -2149, -2199, -2248, -2297, -2347, -2396, -2446, -2496, -2546, -2596, -2647, -2697, -2748, -2799,
+        -2850, -2901, -2953, -3004, -3056, -3108, -3160, -3212, -3265, -3317, -3370, -3423, -3476, -3529, -3583, -3636,
+        -3690, -3744, -3799, -3853, -3907, -3962, -4017, -4072, -4128, -4183, -4239, -4294, -4350, -4407, -4463, -4520,
+        -4576, -4633, -4690, -4748, -4805, -4863, -4921, -4979, -5037, -5095, -5154, -5212, -5271, -5330, -5390, -5449,
+        -5509, -5569, -5629, -5689, -5749, -5810, -5870, -5931, -5992, -6054, -6115, -6177, -6239, -6301, -6363, -6425,
+        -6488, -6551, -6613, -6677, -6740, -6803, -6867, -6931, -6995, -7059, -7124, -7188, -7253, -7318, -7383, -7448,
+        -7514, -7580, -7646, -7712, -7778, -7845, -7911, -7978, -8045, -8113, -8180, -8248, -8316, -8384, -8452, -8520,
+        -8589, -8658, -8727, -8796, -8866, -8935, -9005, -9074, -9144, -9214, -9283, -9353, -9423, -9492, -9562, -9632,
+        -9702, -9772, -9843, -9913, -9983, -10054, -10124, -10195, -10265,
+    },
+    { // 20 km
+        1, 3, -2, -22, -46, -69, -93, -117, -141, -165, -188, -212, -236, -260, -284, -308,
+        -332, -356, -380, -405, -429, -453, -477, -501, -526, -550, -574, -599, -623, -647, -672, -700,
+        -727, -756, -786, -816, -847, -880, -918, -956, -994, -1032, -1071, -1110, -1149, -1188, -1228, -1268,
+        -1315, -1362, -1409, -1457, -1504, -1551, -1599, -1647, -1695, -1743, -1791, -1839, -1888, -1936, -1985, -2034,
+        -2082, -2131, -2180, -2229, -2279, -2328, -2378, -2427, -2477, -2527, -2577, -2627, -2678, -2728, -2779, -2830,
+        -2881, -2932, -2984, -3035, -3087, -3139, -3191, -3244, -3296, -3349, -3401, -3454, -3508, -3561, -3614, -3668,
+        -3722, -3776, -3830, -3885, -3939, -3994, -4049, -4104, -4159, -4215, -4271, -4326, -4382, -4439, -4495, -4552,
+        -4608, -4665, -4722, -4780, -4837, -4895, -4953, -5011, -5069, -5127, -5186, -5245, -5304, -5363, -5422, -5482,
+        -5541, -5601, -5661, -5721, -5782, -5842, -5903, -5964, -6025, -6086, -6148, -6210, -6271, -6333, -6396, -6458,
+        -6521, -6583, -6646, -6709, -6773, -6836, -6900, -6964, -7028, -7092, -7157, -7221, -7286, -7351, -7416, -7482,
+        -7547, -7613, -7679, -7745, -7811, -7878, -7945, -8011, -8079, -8146, -8213, -8281, -8349, -8417, -8485, -8554,
+        -8623, -8692, -8761, -8830, -8899, -8969, -9038, -9108, -9177, -9247, -9317, -9386, -9456, -9526, -9596, -9666,
+        -9736, -9806, -9876, -9946, -10017, -10087, -10158, -10228, -10299,
+    },
+    { // 40 km
+        -3, -7, -22, -42, -64, -87, -110, -133, -157, -180, -204, -228, -252, -276, -300, -324,
+        -348, -372, -396, -420, -444, -468, -492, -516, -541, -565, -589, -614, -638, -663, -690, -717,
+        -745, -774, -804, -835, -866, -902, -940, -978, -1016, -1054, -1093, -1132, -1171, -1211, -1251, -1293,
+        -1340, -1387, -1434, -1481, -1529, -1576, -1624, -1671, -1719, -1768, -1816, -1864, -1913, -1961, -2010, -2058,
+        -2107, -2156, -2205, -2254, -2304, -2353, -2403, -2452, -2502, -2552, -2602, -2653, -2703, -2754, -2805, -2855,
+        -2907, -2958, -3009, -3061, -3113, -3165, -3217, -3269, -3322, -3374, -3427, -3480, -3533, -3587, -3640, -3694,
+        -3748, -3802, -3856, -3911, -3965, -4020, -4075, -4130, -4186, -4241, -4297, -4353, -4409, -4465, -4521, -4578,
+        -4635, -4692, -4749, -4806, -4864, -4921, -4979, -5037, -5096, -5154, -5213, -5271, -5330, -5390, -5449, -5508,
+        -5568, -5628, -5688, -5748, -5809, -5869, -5930, -5991, -6052, -6113, -6175, -6237, -6299, -6361, -6423, -6485,
+        -6548, -6611, -6674, -6737, -6800, -6864, -6927, -6991, -7055, -7120, -7184, -7249, -7314, -7379, -7444, -7509,
+        -7575, -7641, -7707, -7773, -7839, -7906, -7972, -8039, -8106, -8174, -8241, -8309, -8377, -8445, -8513, -8582,
+        -8651, -8720, -8789, -8858, -8928, -8997, -9067, -9136, -9206, -9275, -9345, -9415, -9484, -9554, -9624, -9694,
+        -9764, -9834, -9904, -9975, -10045, -10115, -10186, -10256, -10327,
+    },
+    { // 60 km
+        -11, -17, -30, -49, -70, -92, -114, -137, -160, -184, -208, -231, -255, -279, -303, -327,
+        -351, -375, -399, -423, -447, -472, -496, -520, -544, -569, -593, -618, -644, -671, -698, -726,
+        -756, -785, -816, -847, -880, -918, -956, -994, -1032, -1070, -1109, -1148, -1188, -1227, -1267, -1312,
+        -1359, -1406, -1453, -1500, -1548, -1595, -1643, -1691, -1739, -1787, -1835, -1884, -1932, -1981, -2029, -2078,
+        -2127, -2176, -2225, -2274, -2323, -2373, -2422, -2472, -2522, -2572, -2622, -2673, -2723, -2774, -2825, -2876,
+        -2927, -2978, -3030, -3081, -3133, -3185, -3237, -3290, -3342, -3395, -3448, -3501, -3554, -3607, -3661, -3715,
+        -3769, -3823, -3877, -3932, -3986, -4041, -4096, -4151, -4207, -4262, -4318, -4374, -4430, -4486, -4543, -4599,
+        -4656, -4713, -4770, -4828, -4885, -4943, -5001, -5059, -5117, -5176, -5235, -5293, -5352, -5412, -5471, -5530,
+        -5590, -5650, -5710, -5770, -5831, -5892, -5952, -6013, -6075, -6136, -6197, -6259, -6321, -6383, -6445, -6508,
+        -6570, -6633, -6696, -6759, -6823, -6886, -6950, -7014, -7078, -7143, -7207, -7272, -7337, -7402, -7467, -7532,
+        -7598, -7664, -7730, -7796, -7862, -7929, -7996, -8063, -8130, -8197, -8265, -8332, -8400, -8469, -8537, -8605,
+        -8674, -8743, -8812, -8882, -8951, -9021, -9090, -9160, -9229, -9299, -9368, -9438, -9508, -9578, -9648, -9718,
+        -9788, -9858, -9928, -9998, -10069, -10139, -10210, -10280, -10350,
+    },
+    { // 80 km
+        -20, -25, -38, -55, -75, -97, -119, -141, -164, -188, -211, -235, -258, -282, -306, -330,
+        -354, -378, -402, -427, -451, -475, -499, -524, -548, -573, -599, -625, -652, -680, -708, -737,
+        -767, -797, -828, -859, -896, -934, -972, -1010, -1048, -1087, -1126, -1165, -1204, -1244, -1284, -1331,
+        -1378, -1425, -1473, -1520, -1567, -1615, -1663, -1710, -1758, -1807, -1855, -1903, -1952, -2000, -2049, -2098,
+        -2147, -2196, -2245, -2294, -2343, -2393, -2442, -2492, -2542, -2592, -2642, -2693, -2743, -2794, -2845, -2896,
+        -2947, -2998, -3050, -3102, -3154, -3206, -3258, -3310, -3363, -3416, -3468, -3522, -3575, -3628, -3682, -3736,
+        -3790, -3844, -3898, -3953, -4007, -4062, -4117, -4173, -4228, -4284, -4339, -4395, -4451, -4508, -4564, -4621,
+        -4678, -4735, -4792, -4850, -4907, -4965, -5023, -5081, -5139, -5198, -5256, -5315, -5374, -5434, -5493, -5553,
+        -5612, -5672, -5732, -5793, -5853, -5914, -5975, -6036, -6097, -6158, -6220, -6282, -6344, -6406, -6468, -6530,
+        -6593, -6656, -6719, -6782, -6846, -6909, -6973, -7037, -7101, -7165, -7230, -7295, -7360, -7425, -7490, -7555,
+        -7621, -7687, -7753, -7819, -7885, -7952, -8019, -8086, -8153, -8220, -8288, -8356, -8424, -8492, -8560, -8629,
+        -8698, -8767, -8836, -8905, -8975, -9044, -9114, -9183, -9253, -9322, -9392, -9462, -9532, -9601, -9671, -9741,
+        -9811, -9882, -9952, -10022, -10092, -10163, -10233, -10304, -10374,
+    },
+    { // 100 km
+        -28, -33, -45, -62, -81, -102, -123, -146, -168, -192, -215, -238, -262, -286, -310, -334,
+        -358, -382, -406, -430, -455, -479, -503, -528, -554, -581, -607, -634, -662, -690, -719, -748,
+        -778, -809, -840, -875, -912, -950, -988, -1026, -1065, -1103, -1142, -1181, -1221, -1261, -1304, -1351,
+        -1398, -1445, -1492, -1540, -1587, -1635, -1682, -1730, -1778, -1826, -1875, -1923, -1972, -2020, -2069, -2118,
+        -2166, -2215, -2265, -2314, -2363, -2413, -2462, -2512, -2562, -2612, -2663, -2713, -2764, -2814, -2865, -2916,
+        -2968, -3019, -3070, -3122, -3174, -3226, -3278, -3331, -3384, -3436, -3489, -3542, -3596, -3649, -3703, -3757,
+        -3811, -3865, -3919, -3974, -4029, -4083, -4139, -4194, -4249, -4305, -4361, -4417, -4473, -4529, -4586, -4643,
+        -4699, -4757, -4814, -4871, -4929, -4987, -5045, -5103, -5161, -5220, -5278, -5337, -5396, -5456, -5515, -5575,
+        -5635, -5694, -5755, -5815, -5875, -5936, -5997, -6058, -6119, -6181, -6242, -6304, -6366, -6428, -6491, -6553,
+        -6616, -6679, -6742, -6805, -6868, -6932, -6996, -7060, -7124, -7188, -7253, -7318, -7383, -7448, -7513, -7578,
+        -7644, -7710, -7776, -7842, -7909, -7975, -8042, -8109, -8176, -8244, -8311, -8379, -8447, -8516, -8584, -8653,
+        -8721, -8790, -8860, -8929, -8998, -9068, -9137, -9207, -9277, -9346, -9416, -9486, -9555, -9625, -9695, -9765,
+        -9835, -9905, -9976, -10046, -10116, -10187, -10257, -10328, -10398,
+    },
+    { // 120 km
+        -37, -41, -53, -68, -87, -107, -128, -150, -173, -196, -219, -242, -266, -290, -313, -337,
+        -361, -386, -410, -434, -459, -485, -510, -536, -563, -589, -616, -644, -672, -701, -730, -760,
+        -790, -821, -854, -891, -929, -967, -1005, -1043, -1081, -1120, -1159, -1198, -1238, -1278, -1324, -1371,
+        -1418, -1465, -1512, -1559, -1607, -1654, -1702, -1750, -1798, -1846, -1895, -1943, -1992, -2040, -2089, -2138,
+        -2186, -2236, -2285, -2334, -2383, -2433, -2483, -2532, -2582, -2633, -2683, -2733, -2784, -2835, -2886, -2937,
+        -2988, -3040, -3091, -3143, -3195, -3247, -3299, -3352, -3404, -3457, -3510, -3563, -3617, -3670, -3724, -3778,
+        -3832, -3886, -3940, -3995, -4050, -4105, -4160, -4215, -4271, -4326, -4382, -4438, -4495, -4551, -4608, -4664,
+        -4721, -4778, -4836, -4893, -4951, -5009, -5067, -5125, -5183, -5242, -5301, -5359, -5419, -5478, -5537, -5597,
+        -5657, -5717, -5777, -5837, -5898, -5959, -6020, -6081, -6142, -6203, -6265, -6327, -6389, -6451, -6513, -6576,
+        -6639, -6702, -6765, -6828, -6891, -6955, -7019, -7083, -7147, -7211, -7276, -7341, -7406, -7471, -7536, -7602,
+        -7667, -7733, -7799, -7866, -7932, -7999, -8066, -8133, -8200, -8267, -8335, -8403, -8471, -8539, -8608, -8676,
+        -8745, -8814, -8883, -8953, -9022, -9092, -9161, -9231, -9300, -9370, -9440, -9509, -9579, -9649, -9719, -9789,
+        -9859, -9929, -9999, -10070, -10140, -10210, -10281, -10351, -10422,
+    },
+    { // 140 km
+        -45, -49, -60, -75, -93, -113, -134, -155, -178, -200, -223, -247, -270, -294, -318, -343,
+        -367, -392, -417, -442, -467, -493, -519, -545, -572, -599, -626, -654, -683, -712, -742, -772,
+        -803, -834, -870, -908, -945, -983, -1021, -1060, -1098, -1137, -1176, -1216, -1255, -1297, -1344, -1391,
+        -1438, -1485, -1532, -1579, -1627, -1674, -1722, -1770, -1818, -1866, -1915, -1963, -2012, -2060, -2109, -2158,
+        -2207, -2256, -2305, -2354, -2404, -2453, -2503, -2553, -2603, -2653, -2703, -2754, -2804, -2855, -2906, -2957,
+        -3009, -3060, -3112, -3164, -3216, -3268, -3320, -3373, -3425, -3478, -3531, -3584, -3638, -3691, -3745, -3799,
+        -3853, -3907, -3962, -4016, -4071, -4126, -4181, -4237, -4292, -4348, -4404, -4460, -4516, -4573, -4629, -4686,
+        -4743, -4800, -4857, -4915, -4973, -5031, -5089, -5147, -5205, -5264, -5323, -5382, -5441, -5500, -5560, -5619,
+        -5679, -5739, -5799, -5860, -5920, -5981, -6042, -6103, -6164, -6226, -6288, -6349, -6411, -6474, -6536, -6599,
+        -6661, -6724, -6787, -6851, -6914, -6978, -7042, -7106, -7170, -7234, -7299, -7364, -7429, -7494, -7559, -7625,
+        -7691, -7756, -7823, -7889, -7955, -8022, -8089, -8156, -8223, -8291, -8358, -8426, -8494, -8563, -8631, -8700,
+        -8769, -8838, -8907, -8976, -9046, -9115, -9185, -9254, -9324, -9394, -9463, -9533, -9603, -9673, -9743, -9813,
+        -9883, -9953, -10023, -10093, -10164, -10234, -10305, -10375, -10446,
+    },
+    { // 160 km
+        -54, -58, -68, -82, -100, -119, -139, -161, -183, -206, -229, -252, -276, -300, -324, -349,
+        -374, -399, -424, -449, -475, -501, -527, -554, -581, -608, -636, -665, -694, -724, -754, -785,
+        -816, -850, -887, -924, -962, -1000, -1038, -1076, -1115, -1154, -1193, -1233, -1273, -1317, -1364, -1410,
+        -1457, -1505, -1552, -1599, -1647, -1694, -1742, -1790, -1838, -1886, -1935, -1983, -2032, -2080, -2129, -2178,
+        -2227, -2276, -2325, -2374, -2424, -2473, -2523, -2573, -2623, -2673, -2724, -2774, -2825, -2876, -2927, -2978,
+        -3029, -3081, -3132, -3184, -3236, -3288, -3341, -3393, -3446, -3499, -3552, -3605, -3659, -3712, -3766, -3820,
+        -3874, -3928, -3983, -4038, -4092, -4147, -4203, -4258, -4314, -4369, -4425, -4481, -4538, -4594, -4651, -4708,
+        -4765, -4822, -4879, -4937, -4994, -5052, -5110, -5169, -5227, -5286, -5345, -5404, -5463, -5522, -5582, -5641,
+        -5701, -5761, -5822, -5882, -5943, -6003, -6064, -6125, -6187, -6248, -6310, -6372, -6434, -6496, -6559, -6621,
+        -6684, -6747, -6810, -6873, -6937, -7001, -7065, -7129, -7193, -7257, -7322, -7387, -7452, -7517, -7582, -7648,
+        -7714, -7780, -7846, -7912, -7979, -8045, -8112, -8179, -8247, -8314, -8382, -8450, -8518, -8586, -8655, -8723,
+        -8792, -8861, -8931, -9000, -9069, -9139, -9208, -9278, -9348, -9417, -9487, -9557, -9626, -9696, -9766, -9836,
+        -9906, -9976, -10047, -10117, -10187, -10258, -10328, -10399, -10469,
+    },
+    { // 180 km
+        -63, -66, -76, -90, -107, -125, -146, -167, -189, -212, -235, -258, -282, -306, -331, -356,
+        -381, -406, -431, -457, -483, -509, -536, -563, -590, -619, -647, -676, -706, -736, -766, -797,
+        -829, -866, -903, -941, -979, -1017, -1055, -1093, -1132, -1171, -1210, -1250, -1290, -1337, -1383, -1430,
+        -1477, -1524, -1572, -1619, -1667, -1714, -1762, -1810, -1858, -1906, -1955, -2003, -2052, -2100, -2149, -2198,
+        -2247, -2296, -2345, -2394, -2444, -2493, -2543, -2593, -2643, -2693, -2744, -2794, -2845, -2896, -2947, -2998,
+        -3049, -3101, -3153, -3205, -3257, -3309, -3361, -3414, -3467, -3520, -3573, -3626, -3679, -3733, -3787, -3841,
+        -3895, -3949, -4004, -4059, -4113, -4168, -4224, -4279, -4335, -4391, -4447, -4503, -4559, -4615, -4672, -4729,
+        -4786, -4843, -4901, -4958, -5016, -5074, -5132, -5190, -5249, -5308, -5366, -5425, -5485, -5544, -5604, -5663,
+        -5723, -5783, -5844, -5904, -5965, -6026, -6087, -6148, -6209, -6271, -6332, -6394, -6456, -6519, -6581, -6644,
+        -6706, -6770, -6833, -6896, -6960, -7023, -7087, -7151, -7216, -7280, -7345, -7410, -7475, -7540, -7605, -7671,
+        -7737, -7803, -7869, -7935, -8002, -8068, -8135, -8202, -8270, -8337, -8405, -8473, -8541, -8609, -8678, -8747,
+        -8816, -8885, -8954, -9023, -9093, -9162, -9232, -9301, -9371, -9441, -9510, -9580, -9650, -9720, -9790, -9860,
+        -9930, -10000, -10070, -10141, -10211, -10281, -10352, -10422, -10493,
+    },
+    { // 200 km
+        -72, -75, -84, -97, -114, -132, -152, -173, -195, -218, -241, -265, -289, -313, -338, -363,
+        -388, -413, -439, -465, -491, -518, -545, -573, -601, -629, -658, -688, -717, -748, -779, -810,
+        -846, -883, -920, -958, -995, -1033, -1071, -1110, -1149, -1188, -1227, -1267, -1310, -1357, -1403, -1450,
+        -1497, -1544, -1591, -1639, -1686, -1734, -1782, -1830, -1878, -1926, -1975, -2023, -2071, -2120, -2169, -2218,
+        -2266, -2316, -2365, -2414, -2464, -2513, -2563, -2613, -2663, -2713, -2764, -2814, -2865, -2916, -2967, -3018,
+        -3070, -3121, -3173, -3225, -3277, -3329, -3382, -3434, -3487, -3540, -3593, -3647, -3700, -3754, -3808, -3862,
+        -3916, -3970, -4025, -4080, -4134, -4190, -4245, -4300, -4356, -4412, -4468, -4524, -4580, -4637, -4694, -4750,
+        -4807, -4865, -4922, -4980, -5038, -5096, -5154, -5212, -5271, -5329, -5388, -5447, -5506, -5566, -5625, -5685,
+        -5745, -5805, -5866, -5926, -5987, -6048, -6109, -6170, -6231, -6293, -6355, -6417, -6479, -6541, -6603, -6666,
+        -6729, -6792, -6855, -6919, -6982, -7046, -7110, -7174, -7238, -7303, -7367, -7432, -7497, -7563, -7628, -7694,
+        -7759, -7825, -7892, -7958, -8025, -8091, -8158, -8226, -8293, -8360, -8428, -8496, -8564, -8633, -8701, -8770,
+        -8839, -8908, -8977, -9047, -9116, -9186, -9255, -9325, -9394, -9464, -9534, -9603, -9673, -9743, -9813, -9883,
+        -9953, -10023, -10094, -10164, -10234, -10305, -10375, -10446, -10516,
+    },
+    { // 220 km
+        -81, -84, -93, -105, -121, -140, -159, -180, -202, -225, -248, -272, -296, -320, -345, -370,
+        -395, -421, -447, -474, -500, -527, -555, -583, -611, -640, -669, -699, -729, -760, -791, -825,
+        -862, -899, -937, -974, -1012, -1050, -1088, -1127, -1166, -1205, -1244, -1284, -1330, -1376, -1423, -1470,
+        -1517, -1564, -1611, -1659, -1706, -1754, -1802, -1850, -1898, -1946, -1994, -2043, -2091, -2140, -2188, -2237,
+        -2286, -2335, -2385, -2434, -2484, -2533, -2583, -2633, -2683, -2733, -2784, -2834, -2885, -2936, -2987, -3039,
+        -3090, -3142, -3193, -3245, -3297, -3350, -3402, -3455, -3508, -3561, -3614, -3667, -3721, -3774, -3828, -3882,
+        -3937, -3991, -4046, -4100, -4155, -4210, -4266, -4321, -4377, -4433, -4489, -4545, -4601, -4658, -4715, -4772,
+        -4829, -4886, -4944, -5001, -5059, -5117, -5175, -5234, -5292, -5351, -5410, -5469, -5528, -5588, -5647, -5707,
+        -5767, -5827, -5887, -5948, -6009, -6070, -6131, -6192, -6253, -6315, -6377, -6439, -6501, -6563, -6626, -6688,
+        -6751, -6814, -6877, -6941, -7005, -7068, -7132, -7196, -7261, -7325, -7390, -7455, -7520, -7585, -7651, -7716,
+        -7782, -7848, -7914, -7981, -8047, -8114, -8181, -8248, -8316, -8383, -8451, -8519, -8587, -8656, -8724, -8793,
+        -8862, -8931, -9000, -9070, -9139, -9209, -9278, -9348, -9417, -9487, -9557, -9627, -9696, -9766, -9836, -9906,
+        -9976, -10047, -10117, -10187, -10258, -10328, -10398, -10469, -10539,
+    },
+    { // 240 km
+        -91, -94, -102, -114, -129, -147, -167, -187, -209, -232, -255, -279, -303, -327, -352, -378,
+        -403, -429, -456, -483, -510, -537, -565, -593, -622, -651, -681, -711, -741, -772, -805, -842,
+        -879, -916, -953, -991, -1028, -1066, -1105, -1143, -1182, -1222, -1261, -1303, -1350, -1396, -1443, -1490,
+        -1537, -1584, -1631, -1678, -1726, -1774, -1821, -1869, -1918, -1966, -2014, -2062, -2111, -2159, -2208, -2257,
+        -2306, -2355, -2404, -2454, -2503, -2553, -2603, -2653, -2703, -2753, -2804, -2854, -2905, -2956, -3007, -3059,
+        -3110, -3162, -3213, -3265, -3318, -3370, -3422, -3475, -3528, -3581, -3634, -3688, -3741, -3795, -3849, -3903,
+        -3957, -4012, -4066, -4121, -4176, -4231, -4287, -4342, -4398, -4454, -4510, -4566, -4622, -4679, -4736, -4793,
+        -4850, -4907, -4965, -5022, -5080, -5138, -5197, -5255, -5314, -5372, -5431, -5490, -5550, -5609, -5669, -5729,
+        -5789, -5849, -5909, -5970, -6030, -6091, -6152, -6214, -6275, -6337, -6399, -6461, -6523, -6585, -6648, -6710,
+        -6773, -6836, -6900, -6963, -7027, -7091, -7155, -7219, -7283, -7348, -7412, -7477, -7542, -7608, -7673, -7739,
+        -7805, -7871, -7937, -8004, -8070, -8137, -8204, -8271, -8339, -8406, -8474, -8542, -8610, -8679, -8747, -8816,
+        -8885, -8954, -9023, -9093, -9162, -9232, -9301, -9371, -9441, -9510, -9580, -9650, -9719, -9789, -9859, -9929,
+        -9999, -10070, -10140, -10210, -10281, -10351, -10422, -10492, -10562,
+    },
+    { // 260 km
+        -100, -103, -111, -123, -138, -155, -174, -195, -217, -239, -262, -286, -311, -335, -360, -386,
+        -412, -438, -465, -492, -519, -547, -575, -604, -633, -662, -692, -722, -753, -785, -822, -858,
+        -895, -932, -970, -1007, -1045, -1083, -1121, -1160, -1199, -1238, -1278, -1323, -1369, -1416, -1463, -1509,
+        -1556, -1603, -1651, -1698, -1745, -1793, -1841, -1889, -1937, -1985, -2034, -2082, -2130, -2179, -2228, -2277,
+        -2326, -2375, -2424, -2473, -2523, -2573, -2622, -2672, -2723, -2773, -2823, -2874, -2925, -2976, -3027, -3078,
+        -3130, -3182, -3233, -3285, -3338, -3390, -3443, -3495, -3548, -3601, -3654, -3708, -3761, -3815, -3869, -3923,
+        -3978, -4032, -4087, -4142, -4197, -4252, -4307, -4363, -4418, -4474, -4531, -4587, -4643, -4700, -4757, -4814,
+        -4871, -4928, -4986, -5043, -5101, -5159, -5218, -5276, -5335, -5394, -5453, -5512, -5571, -5630, -5690, -5750,
+        -5810, -5870, -5931, -5991, -6052, -6113, -6174, -6235, -6297, -6359, -6420, -6482, -6545, -6607, -6670, -6732,
+        -6795, -6858, -6922, -6985, -7049, -7113, -7177, -7241, -7305, -7370, -7435, -7500, -7565, -7630, -7696, -7761,
+        -7827, -7893, -7960, -8026, -8093, -8160, -8227, -8294, -8361, -8429, -8497, -8565, -8633, -8701, -8770, -8839,
+        -8908, -8977, -9046, -9116, -9185, -9255, -9324, -9394, -9463, -9533, -9603, -9672, -9742, -9812, -9882, -9952,
+        -10022, -10093, -10163, -10233, -10304, -10374, -10445, -10515, -10585,
+    },
+    { // 280 km
+        -110, -113, -120, -132, -146, -163, -182, -203, -224, -247, -270, -294, -318, -343, -369, -394,
+        -421, -447, -474, -501, -529, -557, -586, -614, -644, -673, -704, -734, -766, -802, -838, -875,
+        -912, -949, -986, -1023, -1061, -1099, -1138, -1176, -1216, -1255, -1297, -1343, -1389, -1436, -1482, -1529,
+        -1576, -1623, -1670, -1717, -1765, -1813, -1861, -1909, -1957, -2005, -2053, -2101, -2150, -2198, -2247, -2296,
+        -2345, -2394, -2443, -2493, -2542, -2592, -2642, -2692, -2742, -2793, -2843, -2894, -2945, -2996, -3047, -3098,
+        -3150, -3201, -3253, -3305, -3358, -3410, -3462, -3515, -3568, -3621, -3675, -3728, -3782, -3835, -3889, -3944,
+        -3998, -4052, -4107, -4162, -4217, -4272, -4328, -4383, -4439, -4495, -4551, -4607, -4664, -4721, -4777, -4834,
+        -4892, -4949, -5007, -5064, -5122, -5180, -5239, -5297, -5356, -5415, -5474, -5533, -5592, -5652, -5711, -5771,
+        -5831, -5892, -5952, -6013, -6074, -6134, -6196, -6257, -6318, -6380, -6442, -6504, -6566, -6629, -6691, -6754,
+        -6817, -6880, -6944, -7007, -7071, -7135, -7199, -7263, -7327, -7392, -7457, -7522, -7587, -7652, -7718, -7784,
+        -7849, -7916, -7982, -8048, -8115, -8182, -8249, -8316, -8384, -8451, -8519, -8587, -8655, -8724, -8793, -8861,
+        -8930, -9000, -9069, -9139, -9208, -9277, -9347, -9416, -9486, -9556, -9625, -9695, -9765, -9835, -9905, -9975,
+        -10045, -10115, -10186, -10256, -10326, -10397, -10467, -10538, -10608,
+    },
+    { // 300 km
+        -120, -123, -130, -141, -155, -172, -191, -211, -232, -255, -278, -302, -327, -352, -377, -403,
+        -429, -456, -483, -511, -539, -567, -596, -625, -655, -685, -715, -747, -782, -818, -855, -891,
+        -928, -965, -1002, -1040, -1077, -1116, -1154, -1193, -1232, -1272, -1316, -1362, -1409, -1455, -1502, -1549,
+        -1595, -1642, -1690, -1737, -1784, -1832, -1880, -1928, -1976, -2024, -2072, -2121, -2169, -2218, -2266, -2315,
+        -2364, -2413, -2463, -2512, -2562, -2611, -2661, -2711, -2762, -2812, -2863, -2913, -2964, -3015, -3066, -3118,
+        -3169, -3221, -3273, -3325, -3377, -3430, -3482, -3535, -3588, -3641, -3694, -3748, -3802, -3855, -3909, -3964,
+        -4018, -4073, -4127, -4182, -4237, -4293, -4348, -4404, -4459, -4515, -4572, -4628, -4684, -4741, -4798, -4855,
+        -4912, -4970, -5027, -5085, -5143, -5201, -5260, -5318, -5377, -5436, -5495, -5554, -5613, -5673, -5733, -5792,
+        -5853, -5913, -5973, -6034, -6095, -6156, -6217, -6278, -6340, -6402, -6464, -6526, -6588, -6650, -6713, -6776,
+        -6839, -6902, -6965, -7029, -7093, -7156, -7220, -7285, -7349, -7414, -7479, -7544, -7609, -7674, -7740, -7806,
+        -7872, -7938, -8004, -8071, -8137, -8204, -8271, -8339, -8406, -8474, -8542, -8610, -8678, -8746, -8815, -8884,
+        -8953, -9022, -9092, -9161, -9230, -9300, -9369, -9439, -9509, -9578, -9648, -9718, -9788, -9858, -9928, -9998,
+        -10068, -10138, -10208, -10279, -10349, -10419, -10490, -10560, -10631,
+    },
+    { // 320 km
+        -131, -133, -140, -150, -164, -181, -199, -219, -241, -263, -286, -310, -335, -360, -386, -412,
+        -438, -465, -493, -521, -549, -577, -606, -636, -666, -696, -728, -763, -799, -835, -871, -907,
+        -944, -981, -1018, -1056, -1094, -1132, -1170, -1209, -1249, -1290, -1336, -1382, -1428, -1475, -1521, -1568,
+        -1615, -1662, -1709, -1756, -1804, -1851, -1899, -1947, -1995, -2043, -2092, -2140, -2188, -2237, -2286, -2334,
+        -2383, -2433, -2482, -2531, -2581, -2631, -2681, -2731, -2781, -2831, -2882, -2933, -2984, -3035, -3086, -3137,
+        -3189, -3241, -3293, -3345, -3397, -3449, -3502, -3555, -3608, -3661, -3714, -3768, -3821, -3875, -3929, -3984,
+        -4038, -4093, -4147, -4202, -4257, -4313, -4368, -4424, -4480, -4536, -4592, -4648, -4705, -4762, -4819, -4876,
+        -4933, -4990, -5048, -5106, -5164, -5222, -5280, -5339, -5398, -5456, -5515, -5575, -5634, -5694, -5754, -5813,
+        -5874, -5934, -5994, -6055, -6116, -6177, -6238, -6300, -6361, -6423, -6485, -6547, -6609, -6672, -6734, -6797,
+        -6860, -6923, -6987, -7050, -7114, -7178, -7242, -7306, -7371, -7436, -7500, -7565, -7631, -7696, -7762, -7828,
+        -7893, -7960, -8026, -8093, -8159, -8226, -8293, -8361, -8428, -8496, -8564, -8632, -8700, -8769, -8837, -8906,
+        -8975, -9045, -9114, -9183, -9253, -9322, -9392, -9461, -9531, -9601, -9670, -9740, -9810, -9880, -9950, -10020,
+        -10090, -10160, -10231, -10301, -10371, -10442, -10512, -10583, -10653,
+    },
+    { // 340 km
+        -141, -143, -150, -160, -174, -190, -208, -228, -249, -272, -295, -319, -344, -369, -395, -421,
+        -448, -475, -503, -531, -559, -588, -617, -647, -677, -710, -745, -780, -815, -851, -887, -923,
+        -960, -997, -1034, -1072, -1110, -1148, -1187, -1226, -1265, -1310, -1356, -1402, -1448, -1494, -1541, -1587,
+        -1634, -1681, -1728, -1776, -1823, -1871, -1919, -1966, -2014, -2062, -2111, -2159, -2207, -2256, -2305, -2354,
+        -2403, -2452, -2501, -2550, -2600, -2650, -2700, -2750, -2800, -2851, -2901, -2952, -3003, -3054, -3105, -3157,
+        -3208, -3260, -3312, -3364, -3416, -3469, -3521, -3574, -3627, -3681, -3734, -3787, -3841, -3895, -3949, -4003,
+        -4058, -4112, -4167, -4222, -4277, -4333, -4388, -4444, -4500, -4556, -4612, -4668, -4725, -4782, -4839, -4896,
+        -4953, -5011, -5068, -5126, -5184, -5242, -5301, -5359, -5418, -5477, -5536, -5595, -5655, -5715, -5774, -5834,
+        -5894, -5955, -6015, -6076, -6137, -6198, -6259, -6321, -6382, -6444, -6506, -6568, -6630, -6693, -6756, -6819,
+        -6882, -6945, -7008, -7072, -7136, -7200, -7264, -7328, -7393, -7457, -7522, -7587, -7652, -7718, -7783, -7849,
+        -7915, -7981, -8048, -8114, -8181, -8248, -8315, -8383, -8450, -8518, -8586, -8654, -8722, -8791, -8859, -8928,
+        -8998, -9067, -9136, -9206, -9275, -9345, -9414, -9484, -9553, -9623, -9693, -9762, -9832, -9902, -9972, -10042,
+        -10112, -10183, -10253, -10323, -10394, -10464, -10535, -10605, -10675,
+    },
+    { // 360 km
+        -152, -154, -160, -170, -183, -199, -217, -237, -258, -281, -304, -328, -353, -378, -404, -430,
+        -457, -484, -512, -541, -569, -598, -628, -658, -692, -726, -761, -796, -831, -867, -903, -939,
+        -976, -1013, -1050, -1088, -1126, -1164, -1203, -1242, -1283, -1329, -1375, -1421, -1467, -1514, -1560, -1607,
+        -1653, -1700, -1747, -1795, -1842, -1890, -1938, -1985, -2033, -2081, -2130, -2178, -2226, -2275, -2324, -2372,
+        -2421, -2471, -2520, -2569, -2619, -2669, -2719, -2769, -2819, -2870, -2920, -2971, -3022, -3073, -3124, -3176,
+        -3227, -3279, -3331, -3383, -3436, -3488, -3541, -3594, -3647, -3700, -3753, -3807, -3861, -3915, -3969, -4023,
+        -4078, -4132, -4187, -4242, -4297, -4353, -4408, -4464, -4520, -4576, -4632, -4689, -4745, -4802, -4859, -4916,
+        -4973, -5031, -5089, -5147, -5205, -5263, -5321, -5380, -5439, -5498, -5557, -5616, -5675, -5735, -5795, -5855,
+        -5915, -5976, -6036, -6097, -6158, -6219, -6280, -6342, -6403, -6465, -6527, -6589, -6652, -6714, -6777, -6840,
+        -6903, -6966, -7029, -7093, -7157, -7221, -7285, -7349, -7414, -7479, -7544, -7609, -7674, -7739, -7805, -7871,
+        -7937, -8003, -8070, -8136, -8203, -8270, -8337, -8404, -8472, -8540, -8608, -8676, -8744, -8813, -8882, -8950,
+        -9020, -9089, -9158, -9228, -9297, -9367, -9436, -9506, -9575, -9645, -9715, -9785, -9854, -9924, -9994, -10064,
+        -10135, -10205, -10275, -10346, -10416, -10486, -10557, -10627, -10697,
+    },
+    { // 380 km
+        -162, -165, -171, -180, -193, -209, -227, -246, -267, -290, -313, -337, -362, -387, -413, -440,
+        -467, -494, -522, -551, -580, -609, -642, -675, -709, -743, -777, -812, -848, -883, -919, -955,
+        -992, -1029, -1066, -1104, -1142, -1180, -1219, -1258, -1303, -1349, -1395, -1440, -1487, -1533, -1579, -1626,
+        -1672, -1719, -1766, -1814, -1861, -1909, -1957, -2004, -2052, -2100, -2148, -2197, -2245, -2294, -2342, -2391,
+        -2440, -2489, -2539, -2588, -2638, -2688, -2738, -2788, -2838, -2889, -2939, -2990, -3041, -3092, -3143, -3195,
+        -3246, -3298, -3350, -3403, -3455, -3507, -3560, -3613, -3666, -3719, -3773, -3826, -3880, -3934, -3988, -4043,
+        -4097, -4152, -4207, -4262, -4317, -4372, -4428, -4484, -4540, -4596, -4652, -4708, -4765, -4822, -4879, -4936,
+        -4994, -5051, -5109, -5167, -5225, -5283, -5342, -5400, -5459, -5518, -5577, -5636, -5696, -5756, -5816, -5876,
+        -5936, -5996, -6057, -6118, -6178, -6240, -6301, -6362, -6424, -6486, -6548, -6610, -6673, -6735, -6798, -6861,
+        -6924, -6987, -7051, -7114, -7178, -7242, -7306, -7371, -7435, -7500, -7565, -7630, -7695, -7761, -7827, -7892,
+        -7958, -8025, -8091, -8158, -8225, -8292, -8359, -8426, -8494, -8562, -8630, -8698, -8766, -8835, -8903, -8972,
+        -9042, -9111, -9180, -9250, -9319, -9389, -9458, -9528, -9597, -9667, -9737, -9806, -9876, -9946, -10016, -10086,
+        -10157, -10227, -10297, -10368, -10438, -10508, -10579, -10649, -10719,
+    },
+    { // 400 km
+        -173, -176, -181, -191, -204, -219, -237, -256, -277, -299, -322, -346, -371, -396, -422, -449,
+        -476, -504, -532, -563, -594, -626, -659, -692, -725, -759, -794, -828, -864, -899, -935, -971,
+        -1008, -1045, -1082, -1120, -1158, -1196, -1235, -1277, -1323, -1368, -1414, -1460, -1506, -1552, -1598, -1645,
+        -1692, -1738, -1785, -1833, -1880, -1928, -1975, -2023, -2071, -2119, -2167, -2215, -2264, -2312, -2361, -2410,
+        -2459, -2508, -2557, -2607, -2657, -2706, -2756, -2807, -2857, -2907, -2958, -3009, -3060, -3111, -3162, -3214,
+        -3265, -3317, -3369, -3422, -3474, -3527, -3579, -3632, -3685, -3739, -3792, -3846, -3899, -3953, -4008, -4062,
+        -4117, -4171, -4226, -4281, -4336, -4392, -4447, -4503, -4559, -4615, -4672, -4728, -4785, -4842, -4899, -4956,
+        -5013, -5071, -5129, -5187, -5245, -5303, -5362, -5420, -5479, -5538, -5597, -5657, -5716, -5776, -5836, -5896,
+        -5956, -6017, -6077, -6138, -6199, -6260, -6322, -6383, -6445, -6507, -6569, -6631, -6693, -6756, -6819, -6882,
+        -6945, -7008, -7072, -7135, -7199, -7263, -7327, -7392, -7456, -7521, -7586, -7651, -7717, -7782, -7848, -7914,
+        -7980, -8046, -8113, -8179, -8246, -8313, -8380, -8448, -8515, -8583, -8651, -8719, -8788, -8856, -8925, -8994,
+        -9063, -9133, -9202, -9271, -9341, -9410, -9480, -9549, -9619, -9689, -9758, -9828, -9898, -9968, -10038, -10108,
+        -10178, -10249, -10319, -10389, -10460, -10530, -10600, -10671, -10741,
+    },
+    { // 420 km
+        -185, -187, -193, -202, -215, -230, -247, -266, -287, -309, -332, -356, -382, -407, -434, -461,
+        -489, -518, -548, -579, -610, -642, -674, -707, -740, -774, -808, -843, -878, -913, -949, -985,
+        -1022, -1059, -1096, -1134, -1172, -1211, -1251, -1296, -1342, -1387, -1433, -1478, -1524, -1570, -1617, -1663,
+        -1710, -1757, -1804, -1851, -1898, -1946, -1994, -2041, -2089, -2137, -2185, -2233, -2282, -2330, -2379, -2428,
+        -2477, -2526, -2575, -2625, -2675, -2724, -2774, -2825, -2875, -2925, -2976, -3027, -3078, -3129, -3180, -3232,
+        -3284, -3336, -3388, -3440, -3492, -3545, -3598, -3651, -3704, -3757, -3811, -3864, -3918, -3972, -4026, -4081,
+        -4135, -4190, -4245, -4300, -4355, -4411, -4466, -4522, -4578, -4634, -4691, -4747, -4804, -4861, -4918, -4975,
+        -5033, -5090, -5148, -5206, -5264, -5323, -5381, -5440, -5499, -5558, -5617, -5676, -5736, -5796, -5856, -5916,
+        -5976, -6037, -6097, -6158, -6219, -6280, -6342, -6403, -6465, -6527, -6589, -6651, -6714, -6776, -6839, -6902,
+        -6965, -7028, -7092, -7156, -7220, -7284, -7348, -7412, -7477, -7542, -7607, -7672, -7737, -7803, -7869, -7934,
+        -8001, -8067, -8133, -8200, -8267, -8334, -8401, -8469, -8536, -8604, -8672, -8740, -8809, -8877, -8946, -9015,
+        -9085, -9154, -9223, -9293, -9362, -9432, -9501, -9571, -9640, -9710, -9780, -9850, -9919, -9989, -10059, -10129,
+        -10200, -10270, -10340, -10411, -10481, -10551, -10622, -10692, -10762,
+    },
+    { // 440 km
+        -197, -199, -205, -214, -226, -241, -258, -277, -298, -320, -343, -368, -393, -419, -446, -474,
+        -502, -531, -561, -591, -623, -654, -687, -719, -753, -787, -821, -856, -891, -926, -962, -999,
+        -1035, -1072, -1110, -1148, -1186, -1225, -1270, -1315, -1360, -1405, -1451, -1496, -1542, -1588, -1634, -1681,
+        -1728, -1774, -1821, -1869, -1916, -1963, -2011, -2059, -2106, -2154, -2202, -2251, -2299, -2348, -2396, -2445,
+        -2494, -2543, -2593, -2642, -2692, -2742, -2792, -2842, -2892, -2943, -2993, -3044, -3095, -3147, -3198, -3250,
+        -3301, -3353, -3405, -3458, -3510, -3563, -3615, -3668, -3722, -3775, -3828, -3882, -3936, -3990, -4044, -4099,
+        -4153, -4208, -4263, -4318, -4374, -4429, -4485, -4541, -4597, -4653, -4709, -4766, -4823, -4880, -4937, -4994,
+        -5051, -5109, -5167, -5225, -5283, -5342, -5400, -5459, -5518, -5577, -5636, -5695, -5755, -5815, -5875, -5935,
+        -5995, -6056, -6116, -6177, -6238, -6300, -6361, -6423, -6484, -6546, -6608, -6671, -6733, -6796, -6859, -6922,
+        -6985, -7048, -7112, -7175, -7239, -7304, -7368, -7432, -7497, -7562, -7627, -7692, -7757, -7823, -7889, -7955,
+        -8021, -8087, -8154, -8220, -8287, -8354, -8422, -8489, -8557, -8625, -8693, -8761, -8829, -8898, -8967, -9036,
+        -9105, -9175, -9244, -9313, -9383, -9452, -9522, -9591, -9661, -9731, -9800, -9870, -9940, -10010, -10080, -10150,
+        -10220, -10291, -10361, -10431, -10502, -10572, -10642, -10713, -10783,
+    },
+    { // 460 km
+        -209, -211, -217, -226, -238, -253, -270, -289, -309, -331, -355, -379, -404, -431, -458, -485,
+        -514, -543, -573, -604, -635, -667, -699, -732, -765, -799, -834, -868, -904, -939, -975, -1012,
+        -1048, -1086, -1123, -1161, -1200, -1243, -1288, -1333, -1378, -1423, -1468, -1514, -1560, -1606, -1652, -1699,
+        -1745, -1792, -1839, -1886, -1933, -1981, -2028, -2076, -2124, -2172, -2220, -2268, -2316, -2365, -2414, -2462,
+        -2511, -2561, -2610, -2659, -2709, -2759, -2809, -2859, -2910, -2960, -3011, -3062, -3113, -3164, -3215, -3267,
+        -3319, -3371, -3423, -3475, -3528, -3580, -3633, -3686, -3739, -3793, -3846, -3900, -3954, -4008, -4062, -4117,
+        -4171, -4226, -4281, -4336, -4392, -4447, -4503, -4559, -4615, -4671, -4728, -4784, -4841, -4898, -4955, -5013,
+        -5070, -5128, -5186, -5244, -5302, -5360, -5419, -5478, -5537, -5596, -5655, -5714, -5774, -5834, -5894, -5954,
+        -6014, -6075, -6136, -6197, -6258, -6319, -6380, -6442, -6504, -6566, -6628, -6690, -6753, -6815, -6878, -6941,
+        -7004, -7068, -7131, -7195, -7259, -7323, -7388, -7452, -7517, -7582, -7647, -7712, -7777, -7843, -7909, -7975,
+        -8041, -8107, -8174, -8241, -8308, -8375, -8442, -8509, -8577, -8645, -8713, -8781, -8850, -8919, -8987, -9057,
+        -9126, -9195, -9265, -9334, -9403, -9473, -9542, -9612, -9682, -9751, -9821, -9891, -9961, -10031, -10101, -10171,
+        -10241, -10311, -10382, -10452, -10522, -10593, -10663, -10733, -10804,
+    },
+    { // 480 km
+        -222, -224, -229, -238, -250, -264, -281, -300, -320, -343, -366, -390, -416, -442, -469, -497,
+        -526, -555, -585, -616, -647, -679, -711, -744, -778, -812, -846, -881, -916, -952, -988, -1025,
+        -1062, -1099, -1137, -1175, -1217, -1262, -1306, -1351, -1396, -1441, -1486, -1532, -1578, -1624, -1670, -1716,
+        -1763, -1809, -1856, -1903, -1951, -1998, -2045, -2093, -2141, -2189, -2237, -2285, -2333, -2382, -2431, -2479,
+        -2528, -2578, -2627, -2677, -2726, -2776, -2826, -2876, -2927, -2977, -3028, -3079, -3130, -3181, -3233, -3284,
+        -3336, -3388, -3440, -3493, -3545, -3598, -3651, -3704, -3757, -3810, -3864, -3918, -3972, -4026, -4080, -4135,
+        -4189, -4244, -4299, -4354, -4410, -4465, -4521, -4577, -4633, -4689, -4746, -4803, -4859, -4916, -4974, -5031,
+        -5089, -5146, -5204, -5262, -5320, -5379, -5438, -5496, -5555, -5614, -5674, -5733, -5793, -5853, -5913, -5973,
+        -6033, -6094, -6155, -6216, -6277, -6338, -6400, -6461, -6523, -6585, -6647, -6710, -6772, -6835, -6898, -6961,
+        -7024, -7087, -7151, -7215, -7279, -7343, -7407, -7472, -7537, -7601, -7667, -7732, -7797, -7863, -7929, -7995,
+        -8061, -8127, -8194, -8261, -8328, -8395, -8462, -8530, -8597, -8665, -8733, -8802, -8870, -8939, -9008, -9077,
+        -9146, -9216, -9285, -9354, -9424, -9493, -9563, -9632, -9702, -9772, -9841, -9911, -9981, -10051, -10121, -10191,
+        -10261, -10332, -10402, -10472, -10543, -10613, -10684, -10754, -10824,
+    },
+    { // 500 km
+        -234, -236, -242, -250, -262, -276, -293, -311, -332, -354, -377, -402, -427, -453, -481, -509,
+        -538, -567, -597, -628, -659, -691, -724, -757, -790, -824, -859, -894, -929, -965, -1001, -1038,
+        -1075, -1112, -1150, -1192, -1236, -1280, -1324, -1369, -1414, -1459, -1504, -1550, -1595, -1641, -1687, -1734,
+        -1780, -1827, -1874, -1921, -1968, -2015, -2063, -2110, -2158, -2206, -2254, -2302, -2350, -2399, -2448, -2496,
+        -2545, -2595, -2644, -2694, -2743, -2793, -2843, -2893, -2944, -2994, -3045, -3096, -3147, -3199, -3250, -3302,
+        -3353, -3405, -3458, -3510, -3563, -3615, -3668, -3721, -3775, -3828, -3882, -3935, -3989, -4044, -4098, -4152,
+        -4207, -4262, -4317, -4372, -4428, -4483, -4539, -4595, -4651, -4708, -4764, -4821, -4878, -4935, -4992, -5049,
+        -5107, -5165, -5223, -5281, -5339, -5397, -5456, -5515, -5574, -5633, -5692, -5752, -5812, -5872, -5932, -5992,
+        -6052, -6113, -6174, -6235, -6296, -6357, -6419, -6480, -6542, -6604, -6666, -6729, -6791, -6854, -6917, -6980,
+        -7043, -7107, -7171, -7234, -7298, -7363, -7427, -7492, -7556, -7621, -7686, -7752, -7817, -7883, -7949, -8015,
+        -8081, -8147, -8214, -8281, -8348, -8415, -8482, -8550, -8618, -8686, -8754, -8822, -8891, -8959, -9028, -9097,
+        -9167, -9236, -9305, -9375, -9444, -9514, -9583, -9653, -9722, -9792, -9862, -9932, -10002, -10071, -10142, -10212,
+        -10282, -10352, -10423, -10493, -10563, -10634, -10704, -10774, -10845,
+    },
+    { // 520 km
+        -247, -249, -254, -263, -274, -288, -305, -323, -343, -365, -389, -413, -438, -465, -492, -520,
+        -549, -579, -609, -640, -671, -703, -736, -769, -803, -837, -871, -906, -942, -978, -1014, -1051,
+        -1088, -1126, -1167, -1210, -1254, -1298, -1343, -1387, -1432, -1477, -1522, -1567, -1613, -1659, -1705, -1751,
+        -1798, -1844, -1891, -1938, -1985, -2032, -2080, -2127, -2175, -2223, -2271, -2319, -2367, -2416, -2464, -2513,
+        -2562, -2612, -2661, -2710, -2760, -2810, -2860, -2910, -2961, -3011, -3062, -3113, -3164, -3216, -3267, -3319,
+        -3371, -3423, -3475, -3527, -3580, -3633, -3686, -3739, -3792, -3845, -3899, -3953, -4007, -4061, -4116, -4170,
+        -4225, -4280, -4335, -4390, -4446, -4501, -4557, -4613, -4669, -4726, -4782, -4839, -4896, -4953, -5010, -5068,
+        -5125, -5183, -5241, -5299, -5357, -5416, -5475, -5533, -5592, -5652, -5711, -5771, -5830, -5890, -5950, -6011,
+        -6071, -6132, -6193, -6254, -6315, -6376, -6438, -6499, -6561, -6623, -6686, -6748, -6811, -6873, -6936, -6999,
+        -7063, -7126, -7190, -7254, -7318, -7382, -7446, -7511, -7576, -7641, -7706, -7771, -7837, -7902, -7968, -8034,
+        -8101, -8167, -8234, -8301, -8368, -8435, -8502, -8570, -8638, -8706, -8774, -8842, -8911, -8979, -9048, -9118,
+        -9187, -9256, -9326, -9395, -9464, -9534, -9603, -9673, -9743, -9812, -9882, -9952, -10022, -10092, -10162, -10232,
+        -10302, -10372, -10443, -10513, -10583, -10654, -10724, -10794, -10865,
+    },
+    { // 540 km
+        -260, -262, -267, -275, -286, -300, -317, -335, -355, -377, -400, -424, -450, -476, -504, -532,
+        -561, -590, -621, -652, -683, -715, -748, -781, -815, -849, -884, -919, -955, -991, -1027, -1064,
+        -1101, -1143, -1186, -1229, -1273, -1317, -1361, -1405, -1450, -1494, -1540, -1585, -1630, -1676, -1722, -1768,
+        -1815, -1861, -1908, -1955, -2002, -2049, -2097, -2144, -2192, -2240, -2288, -2336, -2384, -2433, -2481, -2530,
+        -2579, -2628, -2678, -2727, -2777, -2827, -2877, -2927, -2978, -3028, -3079, -3130, -3181, -3233, -3284, -3336,
+        -3388, -3440, -3492, -3544, -3597, -3650, -3703, -3756, -3809, -3863, -3917, -3970, -4024, -4079, -4133, -4188,
+        -4242, -4297, -4353, -4408, -4463, -4519, -4575, -4631, -4687, -4744, -4800, -4857, -4914, -4971, -5028, -5086,
+        -5143, -5201, -5259, -5317, -5376, -5434, -5493, -5552, -5611, -5670, -5730, -5789, -5849, -5909, -5969, -6029,
+        -6090, -6151, -6211, -6272, -6334, -6395, -6457, -6518, -6580, -6642, -6705, -6767, -6830, -6892, -6955, -7019,
+        -7082, -7146, -7209, -7273, -7337, -7401, -7466, -7531, -7595, -7660, -7725, -7791, -7856, -7922, -7988, -8054,
+        -8120, -8187, -8254, -8320, -8387, -8455, -8522, -8590, -8658, -8726, -8794, -8862, -8931, -9000, -9069, -9138,
+        -9207, -9276, -9346, -9415, -9485, -9554, -9624, -9693, -9763, -9832, -9902, -9972, -10042, -10112, -10182, -10252,
+        -10322, -10393, -10463, -10533, -10604, -10674, -10744, -10815, -10885,
+    },
+    { // 560 km
+        -273, -275, -280, -288, -299, -313, -329, -347, -367, -389, -412, -436, -462, -488, -515, -544,
+        -573, -602, -633, -664, -695, -727, -760, -793, -827, -862, -896, -932, -967, -1003, -1040, -1077,
+        -1119, -1161, -1204, -1248, -1291, -1335, -1379, -1423, -1467, -1512, -1557, -1602, -1648, -1694, -1739, -1786,
+        -1832, -1879, -1925, -1972, -2019, -2066, -2113, -2161, -2209, -2256, -2304, -2352, -2401, -2449, -2498, -2547,
+        -2596, -2645, -2694, -2744, -2794, -2844, -2894, -2944, -2995, -3045, -3096, -3147, -3198, -3250, -3301, -3353,
+        -3405, -3457, -3509, -3562, -3614, -3667, -3720, -3773, -3827, -3880, -3934, -3988, -4042, -4096, -4151, -4205,
+        -4260, -4315, -4370, -4425, -4481, -4537, -4593, -4649, -4705, -4761, -4818, -4875, -4932, -4989, -5046, -5104,
+        -5161, -5219, -5277, -5336, -5394, -5452, -5511, -5570, -5629, -5689, -5748, -5808, -5867, -5927, -5988, -6048,
+        -6108, -6169, -6230, -6291, -6352, -6414, -6475, -6537, -6599, -6661, -6724, -6786, -6849, -6912, -6975, -7038,
+        -7101, -7165, -7228, -7292, -7356, -7421, -7485, -7550, -7615, -7680, -7745, -7810, -7876, -7942, -8008, -8074,
+        -8140, -8207, -8273, -8340, -8407, -8474, -8542, -8610, -8677, -8745, -8814, -8882, -8951, -9020, -9089, -9158,
+        -9227, -9296, -9366, -9435, -9505, -9574, -9644, -9713, -9783, -9852, -9922, -9992, -10062, -10132, -10202, -10272,
+        -10342, -10413, -10483, -10553, -10624, -10694, -10764, -10835, -10905,
+    },
+    { // 580 km
+        -286, -288, -293, -301, -312, -325, -341, -359, -379, -400, -423, -448, -473, -500, -527, -555,
+        -584, -614, -644, -676, -707, -740, -772, -806, -840, -874, -909, -944, -980, -1016, -1054, -1096,
+        -1138, -1180, -1223, -1266, -1309, -1353, -1397, -1441, -1485, -1530, -1575, -1620, -1665, -1711, -1757, -1803,
+        -1849, -1896, -1942, -1989, -2036, -2083, -2130, -2178, -2225, -2273, -2321, -2369, -2417, -2466, -2515, -2563,
+        -2612, -2662, -2711, -2761, -2810, -2860, -2910, -2961, -3011, -3062, -3113, -3164, -3215, -3266, -3318, -3370,
+        -3422, -3474, -3526, -3579, -3631, -3684, -3737, -3790, -3844, -3897, -3951, -4005, -4059, -4113, -4168, -4223,
+        -4277, -4332, -4388, -4443, -4499, -4554, -4610, -4666, -4723, -4779, -4836, -4893, -4950, -5007, -5064, -5122,
+        -5179, -5237, -5295, -5354, -5412, -5471, -5529, -5588, -5647, -5707, -5766, -5826, -5886, -5946, -6006, -6066,
+        -6127, -6188, -6249, -6310, -6371, -6432, -6494, -6556, -6618, -6680, -6742, -6805, -6868, -6930, -6993, -7057,
+        -7120, -7184, -7248, -7311, -7376, -7440, -7504, -7569, -7634, -7699, -7764, -7830, -7895, -7961, -8027, -8093,
+        -8160, -8226, -8293, -8360, -8427, -8494, -8562, -8629, -8697, -8765, -8834, -8902, -8971, -9040, -9109, -9178,
+        -9247, -9316, -9386, -9455, -9525, -9594, -9664, -9733, -9803, -9872, -9942, -10012, -10082, -10152, -10222, -10292,
+        -10362, -10433, -10503, -10573, -10644, -10714, -10784, -10855, -10925,
+    },
+    { // 600 km
+        -299, -301, -306, -314, -324, -338, -353, -371, -391, -413, -435, -460, -485, -511, -539, -567,
+        -596, -626, -656, -688, -719, -752, -785, -818, -852, -887, -921, -957, -993, -1033, -1074, -1115,
+        -1157, -1199, -1242, -1284, -1327, -1371, -1415, -1459, -1503, -1547, -1592, -1637, -1683, -1728, -1774, -1820,
+        -1866, -1912, -1959, -2006, -2053, -2100, -2147, -2194, -2242, -2290, -2337, -2386, -2434, -2482, -2531, -2580,
+        -2629, -2678, -2728, -2777, -2827, -2877, -2927, -2977, -3028, -3078, -3129, -3180, -3232, -3283, -3335, -3386,
+        -3438, -3491, -3543, -3595, -3648, -3701, -3754, -3807, -3861, -3914, -3968, -4022, -4076, -4131, -4185, -4240,
+        -4295, -4350, -4405, -4460, -4516, -4572, -4628, -4684, -4740, -4797, -4853, -4910, -4967, -5024, -5082, -5139,
+        -5197, -5255, -5313, -5372, -5430, -5489, -5547, -5606, -5666, -5725, -5785, -5844, -5904, -5964, -6024, -6085,
+        -6145, -6206, -6267, -6328, -6390, -6451, -6513, -6575, -6637, -6699, -6761, -6824, -6886, -6949, -7012, -7076,
+        -7139, -7203, -7267, -7330, -7395, -7459, -7524, -7588, -7653, -7718, -7784, -7849, -7915, -7980, -8046, -8113,
+        -8179, -8246, -8312, -8379, -8446, -8514, -8581, -8649, -8717, -8785, -8853, -8922, -8990, -9059, -9128, -9198,
+        -9267, -9336, -9406, -9475, -9544, -9614, -9683, -9753, -9823, -9892, -9962, -10032, -10102, -10172, -10242, -10312,
+        -10382, -10453, -10523, -10593, -10663, -10734, -10804, -10874, -10945,
+    },
+    { // 620 km
+        -313, -314, -319, -327, -337, -351, -366, -384, -403, -425, -447, -472, -497, -523, -551, -579,
+        -608, -638, -668, -700, -731, -764, -797, -830, -864, -899, -934, -972, -1012, -1052, -1093, -1134,
+        -1176, -1218, -1260, -1303, -1346, -1389, -1432, -1476, -1520, -1565, -1610, -1655, -1700, -1745, -1791, -1837,
+        -1883, -1929, -1976, -2022, -2069, -2116, -2163, -2211, -2258, -2306, -2354, -2402, -2450, -2499, -2547, -2596,
+        -2645, -2695, -2744, -2794, -2843, -2893, -2943, -2994, -3044, -3095, -3146, -3197, -3248, -3300, -3351, -3403,
+        -3455, -3507, -3560, -3612, -3665, -3718, -3771, -3824, -3878, -3931, -3985, -4039, -4093, -4148, -4202, -4257,
+        -4312, -4367, -4422, -4478, -4533, -4589, -4645, -4701, -4758, -4814, -4871, -4928, -4985, -5042, -5100, -5157,
+        -5215, -5273, -5331, -5389, -5448, -5507, -5565, -5624, -5684, -5743, -5803, -5862, -5922, -5982, -6043, -6103,
+        -6164, -6225, -6285, -6347, -6408, -6470, -6531, -6593, -6655, -6717, -6780, -6842, -6905, -6968, -7031, -7094,
+        -7158, -7222, -7285, -7349, -7414, -7478, -7543, -7607, -7672, -7737, -7803, -7868, -7934, -8000, -8066, -8132,
+        -8198, -8265, -8332, -8399, -8466, -8533, -8601, -8669, -8736, -8805, -8873, -8941, -9010, -9079, -9148, -9217,
+        -9287, -9356, -9425, -9495, -9564, -9634, -9703, -9773, -9842, -9912, -9982, -10052, -10122, -10192, -10262, -10332,
+        -10402, -10472, -10543, -10613, -10683, -10753, -10824, -10894, -10964,
+    },
+    { // 640 km
+        -326, -328, -332, -340, -350, -364, -379, -396, -416, -437, -460, -484, -509, -535, -563, -591,
+        -620, -650, -680, -712, -744, -776, -809, -843, -877, -915, -954, -993, -1032, -1072, -1112, -1153,
+        -1195, -1236, -1278, -1321, -1364, -1407, -1450, -1494, -1538, -1582, -1627, -1672, -1717, -1762, -1808, -1854,
+        -1900, -1946, -1992, -2039, -2086, -2133, -2180, -2227, -2275, -2322, -2370, -2418, -2467, -2515, -2564, -2613,
+        -2662, -2711, -2760, -2810, -2860, -2910, -2960, -3010, -3061, -3111, -3162, -3213, -3265, -3316, -3368, -3420,
+        -3472, -3524, -3576, -3629, -3682, -3735, -3788, -3841, -3894, -3948, -4002, -4056, -4110, -4165, -4219, -4274,
+        -4329, -4384, -4439, -4495, -4551, -4606, -4662, -4719, -4775, -4832, -4888, -4945, -5002, -5060, -5117, -5175,
+        -5233, -5291, -5349, -5407, -5466, -5524, -5583, -5642, -5702, -5761, -5821, -5880, -5940, -6000, -6061, -6121,
+        -6182, -6243, -6304, -6365, -6426, -6488, -6550, -6612, -6674, -6736, -6798, -6861, -6924, -6987, -7050, -7113,
+        -7177, -7240, -7304, -7368, -7432, -7497, -7562, -7626, -7691, -7756, -7822, -7887, -7953, -8019, -8085, -8151,
+        -8218, -8284, -8351, -8418, -8485, -8553, -8620, -8688, -8756, -8824, -8892, -8961, -9030, -9099, -9168, -9237,
+        -9306, -9376, -9445, -9514, -9584, -9653, -9723, -9792, -9862, -9932, -10001, -10071, -10141, -10211, -10281, -10351,
+        -10422, -10492, -10562, -10633, -10703, -10773, -10843, -10914, -10984,
+    },
+    { // 660 km
+        -340, -341, -346, -354, -364, -377, -392, -409, -428, -449, -472, -496, -521, -547, -575, -603,
+        -632, -662, -693, -724, -757, -791, -826, -862, -899, -936, -974, -1013, -1052, -1092, -1132, -1172,
+        -1213, -1255, -1297, -1339, -1382, -1424, -1468, -1511, -1555, -1600, -1644, -1689, -1734, -1779, -1825, -1871,
+        -1916, -1962, -2009, -2055, -2102, -2149, -2196, -2243, -2291, -2338, -2386, -2434, -2483, -2531, -2580, -2629,
+        -2678, -2727, -2776, -2826, -2876, -2926, -2976, -3026, -3077, -3128, -3179, -3230, -3281, -3333, -3384, -3436,
+        -3488, -3540, -3593, -3645, -3698, -3751, -3804, -3858, -3911, -3965, -4019, -4073, -4127, -4182, -4236, -4291,
+        -4346, -4401, -4456, -4512, -4568, -4624, -4680, -4736, -4792, -4849, -4906, -4963, -5020, -5077, -5135, -5192,
+        -5250, -5308, -5366, -5425, -5483, -5542, -5601, -5660, -5719, -5779, -5839, -5898, -5958, -6019, -6079, -6139,
+        -6200, -6261, -6322, -6383, -6445, -6506, -6568, -6630, -6692, -6754, -6817, -6879, -6942, -7005, -7068, -7132,
+        -7195, -7259, -7323, -7387, -7451, -7516, -7580, -7645, -7710, -7775, -7841, -7906, -7972, -8038, -8104, -8170,
+        -8237, -8303, -8370, -8437, -8504, -8572, -8640, -8707, -8775, -8844, -8912, -8980, -9049, -9118, -9187, -9257,
+        -9326, -9395, -9464, -9534, -9603, -9673, -9742, -9812, -9881, -9951, -10021, -10091, -10161, -10231, -10301, -10371,
+        -10441, -10512, -10582, -10652, -10722, -10793, -10863, -10933, -11003,
+    },
+    { // 680 km
+        -355, -356, -361, -368, -378, -391, -406, -423, -443, -464, -486, -510, -535, -562, -589, -618,
+        -647, -678, -709, -741, -774, -808, -842, -878, -915, -952, -989, -1028, -1067, -1106, -1146, -1187,
+        -1228, -1269, -1311, -1353, -1396, -1439, -1482, -1525, -1569, -1614, -1658, -1703, -1748, -1793, -1839, -1884,
+        -1930, -1976, -2022, -2069, -2116, -2162, -2210, -2257, -2304, -2352, -2400, -2448, -2496, -2545, -2594, -2642,
+        -2692, -2741, -2790, -2840, -2890, -2940, -2990, -3040, -3091, -3142, -3193, -3244, -3295, -3347, -3399, -3450,
+        -3503, -3555, -3607, -3660, -3713, -3766, -3819, -3872, -3926, -3980, -4034, -4088, -4142, -4197, -4251, -4306,
+        -4361, -4416, -4472, -4527, -4583, -4639, -4695, -4751, -4808, -4865, -4921, -4978, -5036, -5093, -5151, -5208,
+        -5266, -5324, -5382, -5441, -5500, -5558, -5617, -5676, -5736, -5795, -5855, -5915, -5975, -6035, -6095, -6156,
+        -6217, -6278, -6339, -6400, -6461, -6523, -6585, -6647, -6709, -6771, -6834, -6896, -6959, -7022, -7086, -7149,
+        -7213, -7276, -7340, -7404, -7469, -7533, -7598, -7663, -7728, -7793, -7858, -7924, -7990, -8056, -8122, -8188,
+        -8255, -8321, -8388, -8455, -8522, -8590, -8658, -8725, -8793, -8862, -8930, -8999, -9067, -9136, -9206, -9275,
+        -9344, -9413, -9483, -9552, -9621, -9691, -9760, -9830, -9900, -9969, -10039, -10109, -10179, -10249, -10319, -10389,
+        -10460, -10530, -10600, -10670, -10741, -10811, -10881, -10951, -11022,
+    },
+    { // 700 km
+        -370, -371, -376, -383, -393, -406, -421, -438, -457, -478, -500, -524, -549, -576, -604, -632,
+        -662, -692, -724, -756, -789, -823, -858, -893, -930, -967, -1004, -1043, -1081, -1121, -1161, -1201,
+        -1242, -1283, -1325, -1367, -1410, -1453, -1496, -1540, -1583, -1628, -1672, -1717, -1762, -1807, -1852, -1898,
+        -1944, -1990, -2036, -2082, -2129, -2176, -2223, -2270, -2318, -2366, -2414, -2462, -2510, -2559, -2607, -2656,
+        -2705, -2755, -2804, -2854, -2904, -2954, -3004, -3054, -3105, -3156, -3207, -3258, -3310, -3361, -3413, -3465,
+        -3517, -3569, -3622, -3675, -3727, -3780, -3834, -3887, -3941, -3995, -4049, -4103, -4157, -4212, -4266, -4321,
+        -4376, -4432, -4487, -4543, -4598, -4654, -4711, -4767, -4823, -4880, -4937, -4994, -5051, -5109, -5166, -5224,
+        -5282, -5340, -5398, -5457, -5516, -5574, -5633, -5693, -5752, -5812, -5871, -5931, -5991, -6051, -6112, -6172,
+        -6233, -6294, -6355, -6417, -6478, -6540, -6602, -6664, -6726, -6788, -6851, -6913, -6976, -7039, -7103, -7166,
+        -7230, -7294, -7357, -7422, -7486, -7551, -7615, -7680, -7745, -7810, -7876, -7941, -8007, -8073, -8139, -8206,
+        -8272, -8339, -8406, -8473, -8540, -8608, -8676, -8743, -8811, -8880, -8948, -9017, -9086, -9155, -9224, -9293,
+        -9362, -9432, -9501, -9570, -9640, -9709, -9779, -9848, -9918, -9988, -10057, -10127, -10197, -10267, -10337, -10408,
+        -10478, -10548, -10618, -10688, -10759, -10829, -10899, -10969, -11040,
+    },
+};
+
+inline constexpr std::int16_t S_RESIDUAL[DEPTH_COUNT][DISTANCE_COUNT] = {
+    { // 0 km
+        0, 7, 13, 17, -18, -53, -88, -124, -159, -194, -229, -265, -300, -336, -371, -407,
+        -442, -478, -514, -550, -586, -622, -658, -695, -731, -767, -804, -841, -878, -915, -952, -989,
+        -1027, -1065, -1102, -1140, -1178, -1216, -1254, -1292, -1345, -1404, -1464, -1524, -1585, -1646, -1716, -1793,
+        -1871, -1949, -2028, -2107, -2187, -2267, -2347, -2427, -2507, -2587, -2668, -2748, -2828, -2909, -2990, -3070,
+        -3151, -3232, -3314, -3395, -3477, -3558, -3640, -3722, -3805, -3887, -3970, -4053, -4136, -4219, -4303, -4386,
+        -4470, -4554, -4639, -4723, -4808, -4893, -4979, -5064, -5150, -5236, -5323, -5409, -5496, -5583, -5670, -5758,
+        -5846, -5934, -6022, -6111, -6200, -6289, -6378, -6468, -6558, -6648, -6739, -6830, -6921, -7012, -7104, -7195,
+        -7288, -7380, -7473, -7566, -7659, -7753, -7846, -7940, -8035, -8129, -8224, -8320, -8415, -8511, -8607, -8703,
+        -8800, -8897, -8994, -9091, -9189, -9287, -9386, -9484, -9583, -9682, -9782, -9882, -9982, -10082, -10183, -10284,
+        -10385, -10486, -10588, -10690, -10793, -10896, -10999, -11102, -11206, -11310, -11414, -11518, -11623, -11728, -11834, -11940,
+        -12046, -12152, -12259, -12366, -12473, -12581, -12689, -12797, -12906, -13015, -13124, -13234, -13344, -13454, -13565, -13675,
+        -13787, -13898, -14010, -14123, -14235, -14348, -14462, -14576, -14690, -14804, -14919, -15034, -15149, -15265, -15380, -15496,
+        -15612, -15728, -15844, -15960, -16077, -16193, -16310, -16428, -16545,
+    },
+    { // 20 km
+        2, 7, 8, -26, -60, -95, -130, -165, -200, -235, -270, -305, -341, -376, -412, -447,
+        -483, -519, -554, -590, -626, -662, -699, -735, -771, -808, -845, -881, -918, -956, -993, -1030,
+        -1068, -1105, -1143, -1181, -1219, -1257, -1295, -1335, -1393, -1452, -1512, -1572, -1633, -1695, -1768, -1845,
+        -1923, -2001, -2080, -2159, -2239, -2319, -2399, -2480, -2560, -2640, -2720, -2800, -2881, -2962, -3042, -3123,
+        -3204, -3285, -3366, -3448, -3529, -3611, -3693, -3775, -3858, -3940, -4023, -4106, -4189, -4272, -4356, -4439,
+        -4523, -4608, -4692, -4777, -4862, -4947, -5032, -5118, -5204, -5290, -5376, -5463, -5550, -5637, -5724, -5812,
+        -5900, -5988, -6076, -6165, -6254, -6343, -6433, -6522, -6612, -6703, -6793, -6884, -6975, -7066, -7158, -7250,
+        -7342, -7435, -7527, -7620, -7714, -7807, -7901, -7995, -8090, -8184, -8279, -8375, -8470, -8566, -8662, -8758,
+        -8855, -8952, -9049, -9147, -9245, -9343, -9441, -9540, -9639, -9738, -9837, -9937, -10037, -10138, -10239, -10340,
+        -10441, -10542, -10644, -10746, -10849, -10952, -11055, -11158, -11262, -11366, -11470, -11575, -11680, -11785, -11890, -11996,
+        -12102, -12209, -12315, -12422, -12530, -12638, -12746, -12854, -12963, -13072, -13181, -13291, -13401, -13511, -13622, -13733,
+        -13844, -13956, -14068, -14180, -14293, -14406, -14519, -14633, -14747, -14862, -14976, -15092, -15207, -15322, -15438, -15553,
+        -15669, -15785, -15901, -16018, -16134, -16251, -16368, -16485, -16602,
+    },
+    { // 40 km
+        -4, -9, -29, -58, -90, -123, -157, -191, -226, -261, -296, -331, -366, -401, -437, -472,
+        -508, -544, -579, -615, -651, -688, -724, -760, -797, -833, -870, -907, -944, -981, -1019, -1056,
+        -1094, -1131, -1169, -1207, -1245, -1283, -1321, -1371, -1430, -1489, -1549, -1609, -1671, -1733, -1810, -1888,
+        -1966, -2044, -2123, -2202, -2282, -2362, -2442, -2523, -2603, -2683, -2763, -2844, -2924, -3005, -3085, -3166,
+        -3247, -3328, -3410, -3491, -3573, -3655, -3737, -3819, -3901, -3984, -4066, -4149, -4232, -4316, -4399, -4483,
+        -4567, -4652, -4736, -4821, -4906, -4991, -5076, -5162, -5248, -5334, -5420, -5507, -5594, -5681, -5769, -5856,
+        -5944, -6033, -6121, -6210, -6299, -6388, -6477, -6567, -6657, -6748, -6838, -6929, -7020, -7112, -7203, -7295,
+        -7388, -7480, -7573, -7666, -7759, -7853, -7947, -8041, -8135, -8230, -8325, -8421, -8516, -8612, -8708, -8805,
+        -8901, -8998, -9096, -9193, -9291, -9389, -9488, -9586, -9685, -9785, -9884, -9984, -10084, -10185, -10285, -10386,
+        -10488, -10589, -10691, -10794, -10896, -10999, -11102, -11205, -11309, -11413, -11517, -11622, -11727, -11832, -11938, -12044,
+        -12150, -12256, -12363, -12470, -12578, -12685, -12794, -12902, -13011, -13120, -13229, -13339, -13449, -13559, -13670, -13781,
+        -13892, -14004, -14116, -14228, -14341, -14454, -14568, -14682, -14796, -14910, -15025, -15140, -15256, -15371, -15487, -15602,
+        -15718, -15834, -15950, -16067, -16183, -16300, -16417, -16534, -16652,
+    },
+    { // 60 km
+        -16, -24, -43, -69, -99, -131, -165, -198, -233, -267, -302, -337, -372, -408, -443, -479,
+        -515, -551, -587, -623, -659, -695, -732, -768, -805, -842, -879, -916, -953, -991, -1028, -1066,
+        -1104, -1141, -1179, -1217, -1256, -1294, -1340, -1398, -1457, -1517, -1577, -1638, -1699, -1768, -1845, -1922,
+        -2000, -2079, -2158, -2238, -2318, -2398, -2478, -2558, -2638, -2718, -2799, -2879, -2959, -3040, -3121, -3202,
+        -3283, -3364, -3445, -3527, -3608, -3690, -3772, -3854, -3937, -4019, -4102, -4185, -4268, -4352, -4436, -4519,
+        -4603, -4688, -4772, -4857, -4942, -5027, -5113, -5199, -5285, -5371, -5457, -5544, -5631, -5718, -5806, -5893,
+        -5981, -6070, -6158, -6247, -6336, -6425, -6515, -6605, -6695, -6785, -6876, -6967, -7058, -7150, -7241, -7333,
+        -7426, -7518, -7611, -7704, -7798, -7891, -7985, -8080, -8174, -8269, -8364, -8459, -8555, -8651, -8747, -8844,
+        -8940, -9037, -9135, -9232, -9330, -9428, -9527, -9626, -9725, -9824, -9924, -10024, -10124, -10224, -10325, -10426,
+        -10528, -10629, -10731, -10834, -10936, -11039, -11142, -11246, -11349, -11454, -11558, -11663, -11768, -11873, -11978, -12084,
+        -12191, -12297, -12404, -12511, -12619, -12726, -12835, -12943, -13052, -13161, -13270, -13380, -13490, -13601, -13711, -13822,
+        -13934, -14046, -14158, -14270, -14383, -14496, -14610, -14723, -14838, -14952, -15067, -15182, -15298, -15413, -15529, -15644,
+        -15760, -15876, -15992, -16109, -16226, -16342, -16460, -16577, -16694,
+    },
+    { // 80 km
+        -29, -36, -55, -80, -109, -140, -172, -206, -240, -274, -309, -344, -379, -415, -450, -486,
+        -522, -558, -594, -630, -667, -703, -740, -777, -814, -851, -888, -925, -963, -1000, -1038, -1076,
+        -1113, -1151, -1189, -1228, -1266, -1309, -1368, -1426, -1485, -1545, -1605, -1666, -1728, -1802, -1880, -1957,
+        -2036, -2114, -2194, -2273, -2353, -2433, -2513, -2593, -2674, -2754, -2834, -2914, -2995, -3076, -3156, -3237,
+        -3318, -3400, -3481, -3562, -3644, -3726, -3808, -3890, -3973, -4055, -4138, -4221, -4305, -4388, -4472, -4556,
+        -4640, -4724, -4809, -4894, -4979, -5064, -5149, -5235, -5321, -5408, -5494, -5581, -5668, -5755, -5843, -5931,
+        -6019, -6107, -6196, -6284, -6374, -6463, -6553, -6642, -6733, -6823, -6914, -7005, -7096, -7188, -7279, -7372,
+        -7464, -7557, -7649, -7743, -7836, -7930, -8024, -8118, -8213, -8308, -8403, -8498, -8594, -8690, -8786, -8883,
+        -8979, -9077, -9174, -9272, -9370, -9468, -9566, -9665, -9764, -9864, -9963, -10063, -10164, -10264, -10365, -10466,
+        -10568, -10669, -10771, -10874, -10976, -11079, -11183, -11286, -11390, -11494, -11598, -11703, -11808, -11914, -12019, -12125,
+        -12231, -12338, -12445, -12552, -12660, -12768, -12876, -12984, -13093, -13202, -13312, -13421, -13532, -13642, -13753, -13864,
+        -13975, -14087, -14199, -14312, -14425, -14538, -14651, -14765, -14880, -14994, -15109, -15225, -15340, -15455, -15571, -15687,
+        -15802, -15918, -16035, -16151, -16268, -16385, -16502, -16619, -16736,
+    },
+    { // 100 km
+        -41, -48, -66, -90, -118, -148, -180, -213, -247, -281, -316, -351, -386, -422, -457, -493,
+        -529, -565, -602, -638, -675, -711, -748, -785, -822, -860, -897, -934, -972, -1009, -1047, -1085,
+        -1123, -1161, -1200, -1238, -1279, -1337, -1395, -1454, -1514, -1574, -1634, -1696, -1761, -1838, -1915, -1993,
+        -2071, -2150, -2229, -2309, -2389, -2469, -2549, -2629, -2709, -2789, -2870, -2950, -3031, -3111, -3192, -3273,
+        -3354, -3435, -3517, -3598, -3680, -3762, -3844, -3926, -4009, -4092, -4174, -4258, -4341, -4424, -4508, -4592,
+        -4676, -4761, -4845, -4930, -5015, -5101, -5186, -5272, -5358, -5445, -5531, -5618, -5705, -5792, -5880, -5968,
+        -6056, -6144, -6233, -6322, -6411, -6501, -6590, -6680, -6770, -6861, -6952, -7043, -7134, -7226, -7318, -7410,
+        -7502, -7595, -7688, -7781, -7875, -7968, -8062, -8157, -8251, -8346, -8441, -8537, -8633, -8729, -8825, -8922,
+        -9019, -9116, -9213, -9311, -9409, -9507, -9606, -9705, -9804, -9903, -10003, -10103, -10203, -10304, -10405, -10506,
+        -10608, -10709, -10812, -10914, -11017, -11120, -11223, -11326, -11430, -11534, -11639, -11744, -11849, -11954, -12060, -12166,
+        -12272, -12379, -12486, -12593, -12701, -12809, -12917, -13025, -13134, -13243, -13353, -13463, -13573, -13683, -13794, -13905,
+        -14017, -14129, -14241, -14354, -14467, -14580, -14693, -14807, -14922, -15036, -15151, -15267, -15382, -15497, -15613, -15729,
+        -15845, -15961, -16077, -16193, -16310, -16427, -16544, -16661, -16779,
+    },
+    { // 120 km
+        -54, -60, -77, -100, -128, -157, -189, -221, -255, -289, -323, -358, -393, -429, -464, -500,
+        -537, -573, -609, -646, -683, -719, -756, -793, -831, -868, -905, -943, -981, -1019, -1056, -1094,
+        -1133, -1171, -1209, -1253, -1307, -1365, -1424, -1483, -1542, -1603, -1663, -1725, -1796, -1873, -1951, -2028,
+        -2107, -2186, -2265, -2345, -2425, -2505, -2585, -2665, -2745, -2825, -2906, -2986, -3067, -3147, -3228, -3309,
+        -3390, -3471, -3553, -3634, -3716, -3798, -3880, -3963, -4045, -4128, -4211, -4294, -4377, -4461, -4545, -4629,
+        -4713, -4797, -4882, -4967, -5052, -5137, -5223, -5309, -5395, -5482, -5568, -5655, -5742, -5830, -5917, -6005,
+        -6093, -6182, -6271, -6359, -6449, -6538, -6628, -6718, -6808, -6899, -6990, -7081, -7172, -7264, -7356, -7448,
+        -7540, -7633, -7726, -7819, -7913, -8007, -8101, -8195, -8290, -8385, -8480, -8576, -8672, -8768, -8864, -8961,
+        -9058, -9155, -9252, -9350, -9448, -9547, -9645, -9744, -9843, -9943, -10043, -10143, -10243, -10344, -10445, -10546,
+        -10648, -10750, -10852, -10954, -11057, -11160, -11263, -11367, -11471, -11575, -11679, -11784, -11889, -11995, -12101, -12207,
+        -12313, -12420, -12527, -12634, -12742, -12850, -12958, -13067, -13175, -13285, -13394, -13504, -13614, -13725, -13836, -13947,
+        -14059, -14171, -14283, -14395, -14508, -14622, -14735, -14849, -14964, -15078, -15194, -15309, -15424, -15540, -15655, -15771,
+        -15887, -16003, -16119, -16236, -16352, -16469, -16587, -16704, -16821,
+    },
+    { // 140 km
+        -67, -72, -88, -111, -137, -166, -197, -229, -262, -296, -331, -365, -401, -436, -472, -508,
+        -544, -580, -617, -653, -690, -727, -764, -802, -839, -876, -914, -952, -990, -1027, -1066, -1104,
+        -1142, -1183, -1227, -1278, -1336, -1394, -1452, -1512, -1571, -1632, -1693, -1755, -1832, -1909, -1986, -2064,
+        -2143, -2222, -2302, -2382, -2461, -2541, -2621, -2701, -2781, -2862, -2942, -3022, -3103, -3183, -3264, -3345,
+        -3426, -3508, -3589, -3671, -3752, -3834, -3917, -3999, -4081, -4164, -4247, -4330, -4414, -4497, -4581, -4665,
+        -4749, -4834, -4919, -5004, -5089, -5174, -5260, -5346, -5432, -5519, -5605, -5692, -5779, -5867, -5955, -6043,
+        -6131, -6219, -6308, -6397, -6486, -6576, -6666, -6756, -6846, -6937, -7028, -7119, -7210, -7302, -7394, -7486,
+        -7579, -7672, -7765, -7858, -7952, -8046, -8140, -8234, -8329, -8424, -8519, -8615, -8711, -8807, -8903, -9000,
+        -9097, -9194, -9292, -9390, -9488, -9586, -9685, -9784, -9883, -9983, -10083, -10183, -10283, -10384, -10485, -10586,
+        -10688, -10790, -10892, -10994, -11097, -11200, -11304, -11407, -11511, -11615, -11720, -11825, -11930, -12036, -12141, -12248,
+        -12354, -12461, -12568, -12675, -12783, -12891, -12999, -13108, -13217, -13326, -13436, -13546, -13656, -13766, -13877, -13989,
+        -14100, -14212, -14325, -14437, -14550, -14664, -14777, -14891, -15006, -15121, -15236, -15351, -15466, -15582, -15697, -15813,
+        -15929, -16045, -16162, -16278, -16395, -16512, -16629, -16746, -16863,
+    },
+    { // 160 km
+        -79, -85, -100, -121, -147, -175, -206, -237, -270, -304, -338, -373, -408, -443, -479, -515,
+        -551, -588, -624, -661, -698, -735, -772, -810, -847, -885, -923, -960, -998, -1037, -1075, -1114,
+        -1157, -1202, -1249, -1307, -1364, -1423, -1481, -1541, -1601, -1662, -1723, -1791, -1868, -1945, -2023, -2101,
+        -2180, -2259, -2338, -2418, -2498, -2578, -2658, -2738, -2818, -2898, -2978, -3059, -3139, -3220, -3301, -3382,
+        -3463, -3544, -3625, -3707, -3789, -3871, -3953, -4035, -4118, -4201, -4284, -4367, -4450, -4534, -4618, -4702,
+        -4786, -4871, -4956, -5041, -5126, -5211, -5297, -5383, -5469, -5556, -5643, -5730, -5817, -5904, -5992, -6080,
+        -6168, -6257, -6346, -6435, -6524, -6614, -6704, -6794, -6884, -6975, -7066, -7157, -7249, -7340, -7432, -7525,
+        -7617, -7710, -7803, -7897, -7990, -8084, -8179, -8273, -8368, -8463, -8558, -8654, -8750, -8846, -8943, -9039,
+        -9136, -9234, -9331, -9429, -9527, -9626, -9725, -9824, -9923, -10023, -10122, -10223, -10323, -10424, -10525, -10626,
+        -10728, -10830, -10932, -11035, -11137, -11241, -11344, -11448, -11552, -11656, -11761, -11866, -11971, -12076, -12182, -12288,
+        -12395, -12502, -12609, -12716, -12824, -12932, -13040, -13149, -13258, -13367, -13477, -13587, -13697, -13808, -13919, -14030,
+        -14142, -14254, -14366, -14479, -14592, -14706, -14819, -14933, -15048, -15163, -15278, -15393, -15508, -15624, -15740, -15855,
+        -15971, -16087, -16204, -16320, -16437, -16554, -16671, -16788, -16906,
+    },
+    { // 180 km
+        -92, -97, -111, -132, -156, -184, -214, -246, -278, -312, -346, -380, -415, -451, -487, -523,
+        -559, -595, -632, -669, -706, -743, -780, -818, -856, -893, -931, -969, -1007, -1047, -1089, -1133,
+        -1177, -1222, -1278, -1336, -1394, -1452, -1511, -1571, -1631, -1692, -1754, -1828, -1905, -1982, -2059, -2138,
+        -2216, -2296, -2375, -2455, -2535, -2615, -2694, -2774, -2854, -2935, -3015, -3095, -3176, -3256, -3337, -3418,
+        -3499, -3581, -3662, -3744, -3826, -3908, -3990, -4072, -4155, -4238, -4321, -4404, -4487, -4571, -4655, -4739,
+        -4823, -4908, -4993, -5078, -5163, -5249, -5334, -5420, -5507, -5593, -5680, -5767, -5854, -5942, -6030, -6118,
+        -6206, -6295, -6384, -6473, -6562, -6652, -6742, -6832, -6922, -7013, -7104, -7195, -7287, -7379, -7471, -7563,
+        -7656, -7749, -7842, -7935, -8029, -8123, -8217, -8312, -8407, -8502, -8597, -8693, -8789, -8885, -8982, -9079,
+        -9176, -9273, -9371, -9469, -9567, -9665, -9764, -9863, -9963, -10062, -10162, -10263, -10363, -10464, -10565, -10666,
+        -10768, -10870, -10972, -11075, -11178, -11281, -11385, -11488, -11592, -11697, -11801, -11906, -12012, -12117, -12223, -12329,
+        -12436, -12543, -12650, -12757, -12865, -12973, -13082, -13190, -13300, -13409, -13519, -13629, -13739, -13850, -13961, -14072,
+        -14184, -14296, -14408, -14521, -14634, -14748, -14861, -14976, -15090, -15205, -15320, -15435, -15551, -15666, -15782, -15898,
+        -16014, -16130, -16246, -16363, -16480, -16597, -16714, -16831, -16948,
+    },
+    { // 200 km
+        -105, -110, -123, -142, -167, -194, -223, -254, -286, -320, -354, -388, -423, -458, -494, -530,
+        -567, -603, -640, -677, -714, -751, -789, -826, -864, -902, -941, -981, -1023, -1065, -1108, -1152,
+        -1197, -1251, -1308, -1365, -1423, -1482, -1541, -1601, -1661, -1723, -1788, -1865, -1941, -2019, -2096, -2175,
+        -2254, -2333, -2413, -2492, -2572, -2652, -2731, -2811, -2891, -2971, -3052, -3132, -3213, -3293, -3374, -3455,
+        -3536, -3617, -3699, -3781, -3862, -3944, -4027, -4109, -4192, -4274, -4358, -4441, -4524, -4608, -4692, -4776,
+        -4860, -4945, -5030, -5115, -5200, -5286, -5372, -5458, -5544, -5631, -5718, -5805, -5892, -5980, -6068, -6156,
+        -6244, -6333, -6422, -6511, -6600, -6690, -6780, -6870, -6961, -7051, -7143, -7234, -7325, -7417, -7509, -7602,
+        -7695, -7788, -7881, -7974, -8068, -8162, -8256, -8351, -8446, -8541, -8637, -8732, -8828, -8925, -9021, -9118,
+        -9215, -9313, -9410, -9508, -9607, -9705, -9804, -9903, -10003, -10102, -10202, -10303, -10403, -10504, -10605, -10707,
+        -10808, -10911, -11013, -11115, -11218, -11322, -11425, -11529, -11633, -11738, -11842, -11947, -12053, -12158, -12264, -12370,
+        -12477, -12584, -12691, -12799, -12906, -13015, -13123, -13232, -13341, -13450, -13560, -13670, -13781, -13891, -14003, -14114,
+        -14226, -14338, -14450, -14563, -14676, -14790, -14904, -15018, -15132, -15247, -15362, -15478, -15593, -15709, -15824, -15940,
+        -16056, -16172, -16289, -16405, -16522, -16639, -16756, -16873, -16991,
+    },
+    { // 220 km
+        -118, -122, -135, -153, -177, -203, -232, -263, -295, -328, -362, -396, -431, -467, -502, -538,
+        -575, -612, -648, -686, -723, -761, -799, -838, -877, -917, -958, -999, -1041, -1084, -1128, -1173,
+        -1224, -1281, -1338, -1395, -1453, -1512, -1571, -1632, -1692, -1754, -1825, -1902, -1979, -2056, -2134, -2212,
+        -2291, -2370, -2450, -2529, -2609, -2689, -2769, -2848, -2928, -3008, -3089, -3169, -3250, -3330, -3411, -3492,
+        -3573, -3654, -3736, -3817, -3899, -3981, -4064, -4146, -4229, -4312, -4395, -4478, -4561, -4645, -4729, -4813,
+        -4898, -4982, -5067, -5152, -5238, -5323, -5409, -5495, -5582, -5668, -5755, -5842, -5930, -6018, -6105, -6194,
+        -6282, -6371, -6460, -6549, -6638, -6728, -6818, -6908, -6999, -7090, -7181, -7272, -7364, -7456, -7548, -7641,
+        -7733, -7826, -7920, -8013, -8107, -8201, -8295, -8390, -8485, -8580, -8676, -8772, -8868, -8964, -9061, -9158,
+        -9255, -9352, -9450, -9548, -9646, -9745, -9844, -9943, -10043, -10142, -10242, -10343, -10443, -10544, -10645, -10747,
+        -10849, -10951, -11053, -11156, -11259, -11362, -11466, -11570, -11674, -11778, -11883, -11988, -12094, -12199, -12305, -12412,
+        -12518, -12625, -12732, -12840, -12948, -13056, -13164, -13273, -13382, -13492, -13602, -13712, -13822, -13933, -14044, -14156,
+        -14268, -14380, -14492, -14605, -14718, -14832, -14946, -15060, -15175, -15290, -15405, -15520, -15635, -15751, -15867, -15982,
+        -16098, -16215, -16331, -16448, -16565, -16682, -16799, -16916, -17033,
+    },
+    { // 240 km
+        -131, -135, -147, -165, -188, -214, -242, -273, -305, -337, -371, -406, -441, -476, -512, -548,
+        -585, -622, -659, -697, -735, -774, -813, -853, -893, -934, -975, -1017, -1060, -1104, -1148, -1197,
+        -1254, -1310, -1367, -1425, -1483, -1542, -1602, -1662, -1723, -1786, -1862, -1939, -2016, -2093, -2171, -2249,
+        -2328, -2408, -2487, -2567, -2646, -2726, -2806, -2885, -2965, -3045, -3126, -3206, -3286, -3367, -3448, -3529,
+        -3610, -3691, -3773, -3854, -3936, -4018, -4100, -4183, -4266, -4348, -4431, -4515, -4598, -4682, -4766, -4850,
+        -4935, -5019, -5104, -5190, -5275, -5361, -5447, -5533, -5619, -5706, -5793, -5880, -5967, -6055, -6143, -6231,
+        -6320, -6408, -6497, -6587, -6676, -6766, -6856, -6946, -7037, -7128, -7219, -7311, -7402, -7494, -7586, -7679,
+        -7772, -7865, -7958, -8052, -8146, -8240, -8334, -8429, -8524, -8619, -8715, -8811, -8907, -9003, -9100, -9197,
+        -9294, -9392, -9489, -9587, -9686, -9785, -9883, -9983, -10082, -10182, -10282, -10383, -10483, -10584, -10685, -10787,
+        -10889, -10991, -11093, -11196, -11299, -11403, -11506, -11610, -11714, -11819, -11924, -12029, -12134, -12240, -12346, -12452,
+        -12559, -12666, -12773, -12881, -12989, -13097, -13206, -13314, -13424, -13533, -13643, -13753, -13864, -13975, -14086, -14197,
+        -14309, -14421, -14534, -14647, -14760, -14874, -14988, -15102, -15217, -15332, -15447, -15562, -15677, -15793, -15909, -16025,
+        -16141, -16257, -16373, -16490, -16607, -16724, -16841, -16958, -17075,
+    },
+    { // 260 km
+        -145, -149, -160, -177, -199, -225, -253, -283, -315, -348, -381, -416, -451, -487, -523, -559,
+        -596, -634, -672, -710, -749, -788, -828, -868, -909, -951, -993, -1036, -1079, -1124, -1171, -1227,
+        -1283, -1340, -1397, -1455, -1513, -1572, -1632, -1693, -1754, -1824, -1899, -1976, -2053, -2130, -2208, -2287,
+        -2366, -2445, -2524, -2604, -2683, -2763, -2842, -2922, -3002, -3082, -3162, -3243, -3323, -3404, -3484, -3565,
+        -3646, -3728, -3809, -3891, -3973, -4055, -4137, -4219, -4302, -4385, -4468, -4551, -4635, -4719, -4803, -4887,
+        -4972, -5056, -5141, -5227, -5312, -5398, -5484, -5570, -5656, -5743, -5830, -5917, -6005, -6092, -6180, -6269,
+        -6357, -6446, -6535, -6624, -6714, -6804, -6894, -6984, -7075, -7166, -7257, -7349, -7440, -7532, -7625, -7717,
+        -7810, -7903, -7996, -8090, -8184, -8278, -8373, -8468, -8563, -8658, -8754, -8849, -8946, -9042, -9139, -9236,
+        -9333, -9431, -9529, -9627, -9725, -9824, -9923, -10022, -10122, -10222, -10322, -10422, -10523, -10624, -10725, -10827,
+        -10929, -11031, -11133, -11236, -11339, -11443, -11546, -11650, -11754, -11859, -11964, -12069, -12175, -12280, -12386, -12493,
+        -12600, -12707, -12814, -12922, -13030, -13138, -13246, -13355, -13465, -13574, -13684, -13794, -13905, -14016, -14127, -14239,
+        -14351, -14463, -14575, -14688, -14802, -14915, -15029, -15144, -15258, -15373, -15489, -15604, -15719, -15835, -15950, -16066,
+        -16182, -16299, -16415, -16532, -16649, -16766, -16883, -17000, -17117,
+    },
+    { // 280 km
+        -159, -162, -173, -190, -211, -237, -264, -294, -326, -358, -392, -427, -462, -498, -534, -571,
+        -609, -647, -685, -724, -763, -803, -844, -884, -926, -968, -1011, -1054, -1099, -1146, -1201, -1257,
+        -1313, -1370, -1427, -1485, -1543, -1603, -1662, -1723, -1785, -1861, -1937, -2013, -2090, -2167, -2245, -2324,
+        -2403, -2482, -2561, -2641, -2720, -2800, -2879, -2959, -3039, -3119, -3199, -3279, -3359, -3440, -3521, -3602,
+        -3683, -3764, -3845, -3927, -4009, -4091, -4173, -4256, -4339, -4421, -4505, -4588, -4672, -4755, -4839, -4924,
+        -5008, -5093, -5178, -5263, -5349, -5434, -5520, -5607, -5693, -5780, -5867, -5954, -6042, -6129, -6218, -6306,
+        -6394, -6483, -6572, -6662, -6751, -6841, -6931, -7022, -7113, -7203, -7295, -7386, -7478, -7570, -7662, -7755,
+        -7848, -7941, -8035, -8128, -8222, -8316, -8411, -8506, -8601, -8696, -8792, -8888, -8984, -9081, -9177, -9274,
+        -9372, -9469, -9567, -9666, -9764, -9863, -9962, -10061, -10161, -10261, -10361, -10461, -10562, -10663, -10765, -10866,
+        -10968, -11070, -11173, -11276, -11379, -11482, -11586, -11690, -11794, -11899, -12004, -12109, -12215, -12321, -12427, -12533,
+        -12640, -12747, -12854, -12962, -13070, -13178, -13287, -13396, -13505, -13615, -13725, -13835, -13946, -14057, -14168, -14280,
+        -14392, -14504, -14617, -14730, -14843, -14957, -15071, -15185, -15300, -15415, -15530, -15645, -15761, -15876, -15992, -16108,
+        -16224, -16340, -16457, -16574, -16690, -16808, -16925, -17042, -17159,
+    },
+    { // 300 km
+        -173, -176, -187, -203, -224, -249, -276, -306, -337, -370, -403, -438, -474, -510, -546, -584,
+        -622, -660, -699, -738, -778, -818, -859, -901, -943, -986, -1029, -1073, -1121, -1175, -1230, -1286,
+        -1342, -1399, -1456, -1514, -1573, -1633, -1693, -1754, -1822, -1898, -1974, -2050, -2127, -2204, -2282, -2361,
+        -2440, -2519, -2598, -2678, -2757, -2836, -2916, -2995, -3075, -3155, -3235, -3315, -3396, -3476, -3557, -3638,
+        -3719, -3800, -3882, -3963, -4045, -4127, -4210, -4292, -4375, -4458, -4541, -4624, -4708, -4792, -4876, -4960,
+        -5045, -5129, -5214, -5300, -5385, -5471, -5557, -5643, -5730, -5817, -5904, -5991, -6078, -6166, -6254, -6343,
+        -6431, -6520, -6609, -6699, -6788, -6878, -6969, -7059, -7150, -7241, -7332, -7424, -7516, -7608, -7700, -7793,
+        -7886, -7979, -8072, -8166, -8260, -8354, -8449, -8544, -8639, -8734, -8830, -8926, -9022, -9119, -9216, -9313,
+        -9410, -9508, -9606, -9704, -9803, -9902, -10001, -10100, -10200, -10300, -10400, -10500, -10601, -10702, -10804, -10906,
+        -11008, -11110, -11212, -11315, -11418, -11522, -11626, -11730, -11834, -11939, -12044, -12149, -12255, -12360, -12467, -12573,
+        -12680, -12787, -12895, -13002, -13110, -13219, -13327, -13436, -13546, -13656, -13766, -13876, -13986, -14097, -14209, -14320,
+        -14432, -14545, -14658, -14771, -14884, -14998, -15112, -15226, -15341, -15456, -15571, -15687, -15802, -15918, -16033, -16149,
+        -16265, -16382, -16498, -16615, -16732, -16849, -16966, -17083, -17200,
+    },
+    { // 320 km
+        -187, -191, -201, -217, -237, -261, -288, -318, -349, -382, -415, -450, -486, -522, -559, -597,
+        -635, -674, -713, -753, -793, -834, -876, -918, -960, -1004, -1047, -1096, -1150, -1205, -1260, -1315,
+        -1372, -1429, -1486, -1544, -1603, -1663, -1723, -1784, -1859, -1935, -2011, -2087, -2164, -2241, -2320, -2398,
+        -2477, -2556, -2635, -2714, -2793, -2873, -2952, -3032, -3111, -3191, -3271, -3351, -3432, -3512, -3593, -3674,
+        -3755, -3836, -3918, -3999, -4081, -4163, -4246, -4328, -4411, -4494, -4577, -4660, -4744, -4828, -4912, -4996,
+        -5081, -5166, -5251, -5336, -5421, -5507, -5593, -5680, -5766, -5853, -5940, -6027, -6115, -6203, -6291, -6379,
+        -6468, -6557, -6646, -6736, -6825, -6915, -7006, -7096, -7187, -7278, -7369, -7461, -7553, -7645, -7737, -7830,
+        -7923, -8016, -8110, -8204, -8298, -8392, -8487, -8582, -8677, -8772, -8868, -8964, -9061, -9157, -9254, -9351,
+        -9449, -9546, -9644, -9743, -9841, -9940, -10039, -10139, -10238, -10338, -10439, -10539, -10640, -10741, -10843, -10944,
+        -11047, -11149, -11252, -11354, -11458, -11561, -11665, -11769, -11874, -11978, -12083, -12189, -12294, -12400, -12506, -12613,
+        -12720, -12827, -12934, -13042, -13150, -13259, -13368, -13477, -13586, -13696, -13806, -13916, -14027, -14138, -14249, -14361,
+        -14473, -14585, -14698, -14811, -14925, -15038, -15153, -15267, -15382, -15497, -15612, -15728, -15843, -15959, -16074, -16190,
+        -16306, -16423, -16539, -16656, -16773, -16890, -17007, -17124, -17242,
+    },
+    { // 340 km
+        -202, -206, -215, -231, -250, -274, -301, -330, -361, -394, -428, -463, -498, -535, -572, -610,
+        -649, -688, -728, -768, -809, -850, -892, -935, -978, -1022, -1073, -1126, -1180, -1234, -1289, -1345,
+        -1401, -1458, -1516, -1574, -1633, -1693, -1753, -1821, -1896, -1972, -2048, -2124, -2201, -2279, -2357, -2435,
+        -2514, -2593, -2672, -2751, -2830, -2909, -2988, -3068, -3148, -3227, -3307, -3387, -3468, -3548, -3629, -3710,
+        -3791, -3872, -3953, -4035, -4117, -4199, -4281, -4364, -4447, -4529, -4613, -4696, -4780, -4864, -4948, -5032,
+        -5117, -5201, -5287, -5372, -5458, -5543, -5629, -5716, -5802, -5889, -5976, -6064, -6151, -6239, -6327, -6416,
+        -6505, -6594, -6683, -6772, -6862, -6952, -7042, -7133, -7224, -7315, -7406, -7498, -7590, -7682, -7775, -7867,
+        -7960, -8054, -8147, -8241, -8335, -8430, -8524, -8619, -8715, -8810, -8906, -9002, -9098, -9195, -9292, -9389,
+        -9487, -9584, -9682, -9781, -9879, -9978, -10078, -10177, -10277, -10377, -10477, -10578, -10679, -10780, -10881, -10983,
+        -11085, -11188, -11290, -11393, -11497, -11600, -11704, -11808, -11913, -12017, -12123, -12228, -12334, -12440, -12546, -12652,
+        -12759, -12867, -12974, -13082, -13190, -13299, -13407, -13517, -13626, -13736, -13846, -13956, -14067, -14178, -14290, -14401,
+        -14513, -14626, -14739, -14852, -14965, -15079, -15193, -15308, -15423, -15538, -15653, -15768, -15884, -15999, -16115, -16231,
+        -16347, -16464, -16580, -16697, -16814, -16931, -17048, -17165, -17282,
+    },
+    { // 360 km
+        -217, -221, -230, -245, -264, -288, -314, -343, -374, -407, -440, -475, -511, -548, -586, -624,
+        -663, -702, -742, -783, -824, -866, -909, -952, -999, -1050, -1103, -1156, -1209, -1264, -1318, -1374,
+        -1430, -1487, -1545, -1603, -1663, -1723, -1784, -1858, -1933, -2009, -2085, -2161, -2238, -2316, -2394, -2472,
+        -2551, -2629, -2708, -2787, -2866, -2945, -3025, -3104, -3184, -3263, -3343, -3423, -3504, -3584, -3665, -3745,
+        -3826, -3908, -3989, -4071, -4153, -4235, -4317, -4399, -4482, -4565, -4648, -4732, -4815, -4899, -4983, -5068,
+        -5152, -5237, -5322, -5408, -5493, -5579, -5665, -5752, -5838, -5925, -6012, -6100, -6188, -6275, -6364, -6452,
+        -6541, -6630, -6719, -6809, -6898, -6989, -7079, -7170, -7260, -7352, -7443, -7535, -7627, -7719, -7811, -7904,
+        -7997, -8091, -8184, -8278, -8372, -8467, -8562, -8657, -8752, -8847, -8943, -9039, -9136, -9233, -9330, -9427,
+        -9524, -9622, -9720, -9819, -9917, -10016, -10116, -10215, -10315, -10415, -10515, -10616, -10717, -10818, -10920, -11022,
+        -11124, -11226, -11329, -11432, -11535, -11639, -11743, -11847, -11952, -12056, -12162, -12267, -12373, -12479, -12585, -12692,
+        -12799, -12906, -13014, -13121, -13230, -13338, -13447, -13556, -13666, -13776, -13886, -13996, -14107, -14218, -14330, -14441,
+        -14554, -14666, -14779, -14892, -15006, -15119, -15234, -15348, -15463, -15578, -15694, -15809, -15924, -16040, -16156, -16272,
+        -16388, -16504, -16621, -16738, -16855, -16972, -17089, -17206, -17323,
+    },
+    { // 380 km
+        -233, -236, -245, -260, -279, -302, -328, -357, -387, -420, -454, -489, -525, -562, -600, -638,
+        -677, -717, -758, -799, -840, -883, -928, -978, -1029, -1080, -1132, -1185, -1239, -1293, -1348, -1403,
+        -1460, -1517, -1574, -1633, -1692, -1753, -1821, -1895, -1970, -2046, -2121, -2198, -2275, -2353, -2431, -2509,
+        -2587, -2666, -2745, -2823, -2902, -2981, -3061, -3140, -3219, -3299, -3379, -3459, -3539, -3620, -3700, -3781,
+        -3862, -3943, -4024, -4106, -4188, -4270, -4352, -4435, -4518, -4600, -4684, -4767, -4851, -4935, -5019, -5103,
+        -5188, -5273, -5358, -5443, -5529, -5615, -5701, -5787, -5874, -5961, -6048, -6136, -6223, -6311, -6400, -6488,
+        -6577, -6666, -6755, -6845, -6935, -7025, -7115, -7206, -7297, -7388, -7479, -7571, -7663, -7756, -7848, -7941,
+        -8034, -8127, -8221, -8315, -8409, -8504, -8599, -8694, -8789, -8885, -8981, -9077, -9173, -9270, -9367, -9464,
+        -9562, -9660, -9758, -9856, -9955, -10054, -10153, -10253, -10353, -10453, -10553, -10654, -10755, -10857, -10958, -11060,
+        -11162, -11265, -11367, -11471, -11574, -11678, -11782, -11886, -11990, -12095, -12200, -12306, -12412, -12518, -12624, -12731,
+        -12838, -12945, -13053, -13161, -13269, -13378, -13486, -13596, -13705, -13815, -13925, -14036, -14147, -14258, -14369, -14481,
+        -14593, -14706, -14819, -14932, -15046, -15160, -15274, -15388, -15503, -15619, -15734, -15849, -15965, -16080, -16196, -16312,
+        -16428, -16545, -16661, -16778, -16895, -17012, -17129, -17246, -17364,
+    },
+    { // 400 km
+        -249, -252, -260, -275, -293, -316, -342, -370, -401, -433, -467, -502, -539, -576, -614, -652,
+        -692, -732, -773, -816, -863, -910, -959, -1008, -1059, -1110, -1162, -1214, -1268, -1322, -1377, -1432,
+        -1489, -1546, -1604, -1663, -1722, -1785, -1858, -1933, -2007, -2083, -2158, -2235, -2312, -2390, -2468, -2546,
+        -2624, -2702, -2781, -2860, -2938, -3017, -3096, -3176, -3255, -3335, -3414, -3494, -3575, -3655, -3735, -3816,
+        -3897, -3978, -4060, -4141, -4223, -4305, -4387, -4470, -4553, -4636, -4719, -4802, -4886, -4970, -5054, -5139,
+        -5223, -5308, -5393, -5479, -5564, -5650, -5736, -5823, -5910, -5997, -6084, -6171, -6259, -6347, -6435, -6524,
+        -6613, -6702, -6791, -6881, -6971, -7061, -7151, -7242, -7333, -7424, -7516, -7608, -7700, -7792, -7885, -7977,
+        -8071, -8164, -8258, -8352, -8446, -8541, -8635, -8731, -8826, -8922, -9018, -9114, -9210, -9307, -9404, -9502,
+        -9599, -9697, -9795, -9894, -9993, -10092, -10191, -10291, -10391, -10491, -10591, -10692, -10793, -10894, -10996, -11098,
+        -11200, -11303, -11406, -11509, -11612, -11716, -11820, -11924, -12029, -12134, -12239, -12344, -12450, -12556, -12663, -12770,
+        -12877, -12984, -13092, -13200, -13308, -13417, -13526, -13635, -13744, -13854, -13965, -14075, -14186, -14297, -14409, -14521,
+        -14633, -14746, -14859, -14972, -15085, -15199, -15314, -15428, -15543, -15659, -15774, -15889, -16005, -16120, -16236, -16352,
+        -16468, -16585, -16701, -16818, -16935, -17052, -17170, -17287, -17404,
+    },
+    { // 420 km
+        -266, -269, -277, -291, -309, -332, -357, -386, -416, -449, -483, -518, -555, -593, -631, -671,
+        -712, -755, -799, -844, -890, -937, -986, -1035, -1085, -1136, -1188, -1241, -1294, -1348, -1403, -1459,
+        -1516, -1573, -1631, -1690, -1750, -1821, -1894, -1968, -2043, -2118, -2194, -2271, -2348, -2425, -2503, -2581,
+        -2659, -2737, -2816, -2894, -2973, -3052, -3131, -3210, -3289, -3369, -3449, -3528, -3609, -3689, -3769, -3850,
+        -3931, -4012, -4094, -4175, -4257, -4339, -4421, -4504, -4587, -4670, -4753, -4836, -4920, -5004, -5088, -5172,
+        -5257, -5342, -5427, -5513, -5598, -5684, -5771, -5857, -5944, -6031, -6118, -6206, -6293, -6381, -6470, -6558,
+        -6647, -6736, -6826, -6915, -7005, -7096, -7186, -7277, -7368, -7459, -7551, -7643, -7735, -7827, -7920, -8013,
+        -8106, -8199, -8293, -8387, -8482, -8576, -8671, -8766, -8862, -8957, -9053, -9150, -9246, -9343, -9440, -9538,
+        -9635, -9733, -9831, -9930, -10029, -10128, -10227, -10327, -10427, -10527, -10628, -10729, -10830, -10931, -11033, -11135,
+        -11237, -11340, -11443, -11546, -11649, -11753, -11857, -11961, -12066, -12171, -12276, -12382, -12488, -12594, -12700, -12807,
+        -12914, -13022, -13129, -13237, -13346, -13455, -13564, -13673, -13783, -13892, -14003, -14113, -14224, -14336, -14447, -14559,
+        -14672, -14784, -14897, -15010, -15124, -15238, -15353, -15467, -15582, -15697, -15813, -15928, -16044, -16159, -16275, -16391,
+        -16507, -16624, -16741, -16857, -16974, -17092, -17209, -17326, -17443,
+    },
+    { // 440 km
+        -284, -286, -295, -308, -327, -349, -374, -403, -433, -466, -500, -536, -573, -612, -651, -692,
+        -734, -777, -821, -866, -912, -960, -1008, -1057, -1108, -1159, -1211, -1264, -1317, -1372, -1427, -1483,
+        -1540, -1598, -1656, -1716, -1782, -1855, -1929, -2003, -2077, -2153, -2228, -2305, -2382, -2460, -2537, -2615,
+        -2693, -2771, -2849, -2928, -3006, -3085, -3164, -3243, -3322, -3402, -3481, -3561, -3641, -3721, -3802, -3883,
+        -3964, -4045, -4126, -4208, -4289, -4371, -4454, -4536, -4619, -4702, -4785, -4869, -4952, -5036, -5120, -5205,
+        -5290, -5375, -5460, -5545, -5631, -5717, -5803, -5890, -5977, -6064, -6151, -6239, -6326, -6414, -6503, -6591,
+        -6680, -6770, -6859, -6949, -7039, -7129, -7219, -7310, -7401, -7493, -7584, -7676, -7768, -7861, -7954, -8047,
+        -8140, -8233, -8327, -8421, -8516, -8610, -8705, -8800, -8896, -8992, -9088, -9184, -9281, -9378, -9475, -9572,
+        -9670, -9768, -9866, -9965, -10064, -10163, -10262, -10362, -10462, -10563, -10663, -10764, -10865, -10967, -11068, -11170,
+        -11273, -11375, -11478, -11582, -11685, -11789, -11893, -11997, -12102, -12207, -12312, -12418, -12524, -12630, -12737, -12844,
+        -12951, -13058, -13166, -13274, -13383, -13491, -13600, -13710, -13819, -13929, -14040, -14150, -14261, -14373, -14484, -14596,
+        -14709, -14822, -14935, -15048, -15162, -15276, -15390, -15505, -15620, -15735, -15850, -15966, -16081, -16197, -16313, -16429,
+        -16545, -16662, -16778, -16895, -17012, -17129, -17246, -17364, -17481,
+    },
+    { // 460 km
+        -302, -305, -313, -326, -344, -366, -392, -420, -451, -483, -518, -554, -591, -630, -670, -711,
+        -754, -797, -842, -887, -934, -981, -1030, -1080, -1130, -1181, -1234, -1287, -1341, -1395, -1451, -1507,
+        -1565, -1623, -1681, -1745, -1817, -1890, -1963, -2037, -2112, -2187, -2263, -2339, -2416, -2494, -2571, -2649,
+        -2726, -2804, -2882, -2961, -3039, -3118, -3197, -3276, -3355, -3434, -3514, -3594, -3674, -3754, -3834, -3915,
+        -3996, -4077, -4158, -4240, -4322, -4404, -4486, -4568, -4651, -4734, -4817, -4901, -4984, -5068, -5153, -5237,
+        -5322, -5407, -5492, -5578, -5663, -5749, -5836, -5922, -6009, -6096, -6184, -6271, -6359, -6447, -6536, -6624,
+        -6713, -6802, -6892, -6982, -7072, -7162, -7253, -7343, -7435, -7526, -7618, -7710, -7802, -7894, -7987, -8080,
+        -8173, -8267, -8361, -8455, -8550, -8644, -8739, -8834, -8930, -9026, -9122, -9218, -9315, -9412, -9509, -9607,
+        -9705, -9803, -9901, -10000, -10099, -10198, -10297, -10397, -10497, -10597, -10698, -10799, -10900, -11002, -11104, -11206,
+        -11308, -11411, -11514, -11617, -11721, -11825, -11929, -12033, -12138, -12243, -12348, -12454, -12560, -12666, -12773, -12880,
+        -12987, -13095, -13202, -13311, -13419, -13528, -13637, -13746, -13856, -13966, -14077, -14187, -14298, -14410, -14521, -14634,
+        -14746, -14859, -14972, -15085, -15199, -15313, -15428, -15542, -15657, -15773, -15888, -16003, -16119, -16235, -16350, -16467,
+        -16583, -16699, -16816, -16933, -17050, -17167, -17284, -17401, -17518,
+    },
+    { // 480 km
+        -321, -323, -331, -345, -362, -384, -409, -437, -468, -501, -536, -572, -610, -649, -689, -731,
+        -773, -817, -862, -908, -955, -1003, -1052, -1101, -1152, -1204, -1256, -1310, -1364, -1419, -1475, -1531,
+        -1589, -1647, -1708, -1779, -1851, -1924, -1997, -2071, -2146, -2221, -2297, -2373, -2450, -2527, -2605, -2682,
+        -2760, -2837, -2915, -2994, -3072, -3150, -3229, -3308, -3387, -3466, -3546, -3626, -3706, -3786, -3866, -3947,
+        -4028, -4109, -4190, -4272, -4353, -4435, -4518, -4600, -4683, -4766, -4849, -4933, -5016, -5100, -5185, -5269,
+        -5354, -5439, -5524, -5610, -5696, -5782, -5868, -5955, -6041, -6128, -6216, -6304, -6391, -6480, -6568, -6657,
+        -6746, -6835, -6925, -7014, -7104, -7195, -7285, -7376, -7468, -7559, -7651, -7743, -7835, -7928, -8020, -8113,
+        -8207, -8300, -8394, -8489, -8583, -8678, -8773, -8868, -8964, -9060, -9156, -9252, -9349, -9446, -9543, -9641,
+        -9739, -9837, -9935, -10034, -10133, -10232, -10332, -10432, -10532, -10632, -10733, -10834, -10935, -11037, -11139, -11241,
+        -11343, -11446, -11549, -11652, -11756, -11860, -11964, -12069, -12173, -12279, -12384, -12490, -12596, -12702, -12809, -12916,
+        -13023, -13131, -13238, -13347, -13455, -13564, -13673, -13783, -13892, -14003, -14113, -14224, -14335, -14446, -14558, -14670,
+        -14783, -14896, -15009, -15122, -15236, -15350, -15465, -15580, -15695, -15810, -15925, -16040, -16156, -16272, -16388, -16504,
+        -16620, -16737, -16853, -16970, -17087, -17204, -17321, -17438, -17555,
+    },
+    { // 500 km
+        -340, -342, -350, -363, -381, -402, -427, -455, -486, -519, -553, -590, -628, -667, -708, -750,
+        -793, -837, -882, -928, -976, -1024, -1073, -1123, -1174, -1226, -1279, -1333, -1387, -1442, -1498, -1555,
+        -1613, -1672, -1743, -1814, -1886, -1959, -2032, -2106, -2180, -2255, -2331, -2408, -2484, -2561, -2638, -2715,
+        -2793, -2870, -2948, -3026, -3104, -3183, -3261, -3340, -3419, -3498, -3578, -3658, -3737, -3818, -3898, -3979,
+        -4059, -4140, -4222, -4303, -4385, -4467, -4549, -4632, -4715, -4798, -4881, -4964, -5048, -5132, -5216, -5301,
+        -5386, -5471, -5556, -5642, -5727, -5813, -5900, -5986, -6073, -6160, -6248, -6336, -6424, -6512, -6600, -6689,
+        -6778, -6867, -6957, -7047, -7137, -7227, -7318, -7409, -7500, -7592, -7684, -7776, -7868, -7960, -8053, -8147,
+        -8240, -8334, -8428, -8522, -8616, -8711, -8806, -8902, -8997, -9093, -9190, -9286, -9383, -9480, -9577, -9675,
+        -9773, -9871, -9969, -10068, -10167, -10266, -10366, -10466, -10566, -10667, -10767, -10868, -10970, -11071, -11173, -11276,
+        -11378, -11481, -11584, -11687, -11791, -11895, -11999, -12104, -12209, -12314, -12419, -12525, -12631, -12738, -12844, -12951,
+        -13059, -13166, -13274, -13383, -13491, -13600, -13709, -13819, -13929, -14039, -14149, -14260, -14371, -14483, -14595, -14707,
+        -14819, -14932, -15045, -15159, -15273, -15387, -15502, -15617, -15732, -15847, -15962, -16077, -16193, -16309, -16425, -16541,
+        -16657, -16774, -16891, -17007, -17124, -17242, -17359, -17476, -17593,
+    },
+    { // 520 km
+        -359, -361, -369, -382, -399, -421, -445, -473, -504, -537, -571, -608, -646, -686, -727, -769,
+        -812, -857, -902, -949, -996, -1045, -1094, -1145, -1196, -1248, -1301, -1355, -1410, -1466, -1522, -1579,
+        -1638, -1707, -1777, -1849, -1920, -1993, -2066, -2140, -2214, -2289, -2365, -2441, -2518, -2595, -2671, -2748,
+        -2826, -2903, -2981, -3059, -3137, -3215, -3293, -3372, -3451, -3530, -3610, -3689, -3769, -3849, -3929, -4010,
+        -4091, -4172, -4253, -4335, -4416, -4498, -4581, -4663, -4746, -4829, -4912, -4996, -5079, -5163, -5248, -5332,
+        -5417, -5502, -5587, -5673, -5759, -5845, -5931, -6018, -6105, -6192, -6280, -6367, -6455, -6544, -6632, -6721,
+        -6810, -6899, -6989, -7079, -7169, -7260, -7350, -7441, -7533, -7624, -7716, -7808, -7901, -7993, -8086, -8179,
+        -8273, -8367, -8461, -8555, -8649, -8744, -8839, -8935, -9031, -9127, -9223, -9319, -9416, -9513, -9611, -9708,
+        -9806, -9905, -10003, -10102, -10201, -10300, -10400, -10500, -10600, -10701, -10802, -10903, -11004, -11106, -11208, -11310,
+        -11413, -11515, -11619, -11722, -11826, -11930, -12034, -12139, -12244, -12349, -12454, -12560, -12666, -12773, -12880, -12987,
+        -13094, -13202, -13310, -13418, -13527, -13636, -13745, -13855, -13964, -14075, -14185, -14296, -14407, -14519, -14631, -14743,
+        -14856, -14968, -15082, -15195, -15309, -15424, -15538, -15653, -15768, -15883, -15999, -16114, -16230, -16345, -16461, -16578,
+        -16694, -16811, -16927, -17044, -17161, -17278, -17395, -17512, -17629,
+    },
+    { // 540 km
+        -378, -381, -389, -401, -418, -439, -464, -492, -522, -555, -590, -626, -665, -705, -746, -788,
+        -832, -876, -922, -969, -1017, -1066, -1116, -1166, -1218, -1270, -1324, -1378, -1433, -1489, -1546, -1603,
+        -1672, -1742, -1812, -1883, -1955, -2027, -2100, -2174, -2248, -2323, -2399, -2475, -2551, -2628, -2704, -2781,
+        -2858, -2936, -3013, -3091, -3169, -3247, -3325, -3404, -3483, -3562, -3641, -3721, -3800, -3880, -3961, -4041,
+        -4122, -4203, -4284, -4366, -4447, -4529, -4612, -4694, -4777, -4860, -4943, -5027, -5110, -5195, -5279, -5363,
+        -5448, -5533, -5619, -5704, -5790, -5876, -5963, -6049, -6136, -6224, -6311, -6399, -6487, -6575, -6664, -6753,
+        -6842, -6931, -7021, -7111, -7201, -7292, -7382, -7473, -7565, -7656, -7748, -7840, -7933, -8026, -8119, -8212,
+        -8305, -8399, -8493, -8588, -8682, -8777, -8872, -8968, -9064, -9160, -9256, -9353, -9449, -9547, -9644, -9742,
+        -9840, -9938, -10037, -10136, -10235, -10334, -10434, -10534, -10634, -10735, -10836, -10937, -11038, -11140, -11242, -11344,
+        -11447, -11550, -11653, -11757, -11860, -11964, -12069, -12173, -12278, -12384, -12489, -12595, -12701, -12808, -12915, -13022,
+        -13129, -13237, -13345, -13453, -13562, -13671, -13780, -13890, -14000, -14110, -14221, -14332, -14443, -14555, -14667, -14779,
+        -14892, -15005, -15118, -15232, -15346, -15460, -15575, -15690, -15805, -15920, -16035, -16151, -16266, -16382, -16498, -16614,
+        -16731, -16847, -16964, -17081, -17198, -17315, -17432, -17549, -17666,
+    },
+    { // 560 km
+        -398, -401, -408, -421, -438, -458, -483, -510, -541, -573, -608, -645, -684, -723, -765, -807,
+        -851, -896, -942, -989, -1038, -1087, -1137, -1188, -1240, -1293, -1346, -1401, -1456, -1512, -1570, -1638,
+        -1707, -1777, -1847, -1917, -1989, -2061, -2134, -2208, -2282, -2357, -2433, -2509, -2584, -2661, -2737, -2814,
+        -2891, -2968, -3045, -3123, -3200, -3278, -3357, -3435, -3514, -3593, -3672, -3752, -3831, -3911, -3992, -4072,
+        -4153, -4234, -4315, -4396, -4478, -4560, -4642, -4725, -4808, -4891, -4974, -5057, -5141, -5225, -5310, -5394,
+        -5479, -5564, -5650, -5735, -5821, -5907, -5994, -6081, -6168, -6255, -6342, -6430, -6518, -6607, -6695, -6784,
+        -6873, -6963, -7053, -7143, -7233, -7323, -7414, -7505, -7597, -7688, -7780, -7872, -7965, -8058, -8151, -8244,
+        -8338, -8431, -8526, -8620, -8715, -8810, -8905, -9001, -9096, -9192, -9289, -9385, -9482, -9580, -9677, -9775,
+        -9873, -9971, -10070, -10169, -10268, -10368, -10467, -10567, -10668, -10768, -10869, -10971, -11072, -11174, -11276, -11378,
+        -11481, -11584, -11687, -11791, -11895, -11999, -12103, -12208, -12313, -12418, -12524, -12630, -12736, -12843, -12950, -13057,
+        -13164, -13272, -13380, -13489, -13597, -13706, -13816, -13925, -14035, -14146, -14256, -14367, -14479, -14590, -14702, -14815,
+        -14927, -15040, -15154, -15268, -15382, -15496, -15611, -15726, -15841, -15956, -16071, -16187, -16302, -16418, -16534, -16650,
+        -16767, -16883, -17000, -17117, -17234, -17351, -17468, -17585, -17702,
+    },
+    { // 580 km
+        -418, -421, -428, -441, -457, -478, -502, -529, -560, -592, -627, -664, -702, -743, -784, -827,
+        -871, -916, -963, -1010, -1058, -1108, -1158, -1209, -1262, -1315, -1369, -1423, -1479, -1539, -1606, -1674,
+        -1742, -1811, -1881, -1952, -2023, -2095, -2168, -2242, -2316, -2391, -2466, -2542, -2617, -2693, -2770, -2846,
+        -2923, -3000, -3077, -3154, -3232, -3310, -3388, -3466, -3545, -3624, -3703, -3783, -3862, -3942, -4022, -4103,
+        -4183, -4264, -4346, -4427, -4509, -4591, -4673, -4755, -4838, -4921, -5004, -5088, -5172, -5256, -5340, -5425,
+        -5510, -5595, -5680, -5766, -5852, -5938, -6025, -6111, -6198, -6286, -6373, -6461, -6549, -6638, -6726, -6815,
+        -6905, -6994, -7084, -7174, -7264, -7355, -7446, -7537, -7628, -7720, -7812, -7904, -7997, -8090, -8183, -8276,
+        -8370, -8464, -8558, -8652, -8747, -8842, -8937, -9033, -9129, -9225, -9321, -9418, -9515, -9612, -9710, -9808,
+        -9906, -10004, -10103, -10202, -10301, -10401, -10501, -10601, -10701, -10802, -10903, -11004, -11106, -11207, -11310, -11412,
+        -11515, -11618, -11721, -11825, -11929, -12033, -12137, -12242, -12347, -12453, -12558, -12664, -12771, -12877, -12984, -13091,
+        -13199, -13307, -13415, -13523, -13632, -13741, -13851, -13961, -14071, -14181, -14292, -14403, -14514, -14626, -14738, -14850,
+        -14963, -15076, -15190, -15303, -15417, -15532, -15647, -15762, -15877, -15992, -16107, -16223, -16338, -16454, -16570, -16686,
+        -16803, -16920, -17036, -17153, -17270, -17387, -17504, -17621, -17738,
+    },
+    { // 600 km
+        -439, -441, -449, -461, -477, -498, -522, -549, -579, -611, -646, -683, -722, -762, -803, -846,
+        -891, -936, -983, -1030, -1079, -1129, -1179, -1231, -1283, -1337, -1391, -1446, -1510, -1575, -1642, -1709,
+        -1777, -1846, -1916, -1986, -2057, -2129, -2202, -2276, -2350, -2425, -2500, -2575, -2650, -2726, -2802, -2878,
+        -2955, -3031, -3108, -3186, -3263, -3341, -3419, -3497, -3576, -3655, -3734, -3813, -3893, -3973, -4053, -4133,
+        -4214, -4295, -4376, -4457, -4539, -4621, -4703, -4786, -4868, -4951, -5035, -5118, -5202, -5286, -5371, -5455,
+        -5540, -5625, -5711, -5796, -5882, -5969, -6055, -6142, -6229, -6316, -6404, -6492, -6580, -6669, -6757, -6846,
+        -6936, -7025, -7115, -7205, -7295, -7386, -7477, -7568, -7660, -7751, -7843, -7936, -8028, -8121, -8214, -8308,
+        -8401, -8495, -8590, -8684, -8779, -8874, -8969, -9065, -9161, -9257, -9354, -9450, -9548, -9645, -9742, -9840,
+        -9939, -10037, -10136, -10235, -10334, -10434, -10534, -10634, -10734, -10835, -10936, -11037, -11139, -11241, -11343, -11446,
+        -11548, -11651, -11755, -11858, -11962, -12067, -12171, -12276, -12381, -12487, -12592, -12698, -12805, -12912, -13018, -13126,
+        -13233, -13341, -13449, -13558, -13667, -13776, -13886, -13995, -14106, -14216, -14327, -14438, -14549, -14661, -14773, -14886,
+        -14998, -15112, -15225, -15339, -15453, -15568, -15682, -15797, -15912, -16028, -16143, -16258, -16374, -16490, -16606, -16722,
+        -16839, -16955, -17072, -17189, -17306, -17423, -17540, -17657, -17774,
+    },
+    { // 620 km
+        -460, -462, -469, -481, -497, -518, -541, -568, -598, -631, -666, -702, -741, -781, -823, -866,
+        -911, -956, -1003, -1051, -1100, -1150, -1201, -1253, -1305, -1359, -1418, -1482, -1546, -1611, -1677, -1744,
+        -1812, -1880, -1950, -2020, -2091, -2163, -2236, -2310, -2384, -2458, -2532, -2607, -2683, -2758, -2834, -2910,
+        -2986, -3063, -3140, -3217, -3294, -3372, -3450, -3528, -3606, -3685, -3764, -3843, -3923, -4003, -4083, -4163,
+        -4244, -4325, -4406, -4487, -4569, -4651, -4733, -4816, -4898, -4981, -5065, -5148, -5232, -5316, -5401, -5485,
+        -5570, -5655, -5741, -5827, -5913, -5999, -6085, -6172, -6259, -6347, -6434, -6522, -6611, -6699, -6788, -6877,
+        -6966, -7056, -7146, -7236, -7326, -7417, -7508, -7599, -7691, -7782, -7875, -7967, -8060, -8152, -8246, -8339,
+        -8433, -8527, -8621, -8716, -8811, -8906, -9001, -9097, -9193, -9289, -9386, -9483, -9580, -9677, -9775, -9873,
+        -9971, -10069, -10168, -10267, -10367, -10466, -10566, -10667, -10767, -10868, -10969, -11070, -11172, -11274, -11376, -11479,
+        -11582, -11685, -11788, -11892, -11996, -12100, -12205, -12310, -12415, -12520, -12626, -12732, -12839, -12946, -13053, -13160,
+        -13268, -13376, -13484, -13592, -13701, -13811, -13920, -14030, -14140, -14251, -14362, -14473, -14584, -14696, -14808, -14921,
+        -15034, -15147, -15260, -15374, -15488, -15603, -15718, -15833, -15948, -16063, -16178, -16294, -16410, -16525, -16642, -16758,
+        -16874, -16991, -17108, -17225, -17342, -17459, -17576, -17693, -17810,
+    },
+    { // 640 km
+        -481, -483, -490, -502, -518, -538, -561, -588, -618, -650, -685, -722, -761, -801, -843, -886,
+        -931, -977, -1024, -1072, -1121, -1171, -1222, -1274, -1333, -1394, -1455, -1518, -1582, -1647, -1712, -1779,
+        -1846, -1915, -1984, -2054, -2125, -2197, -2270, -2343, -2417, -2491, -2565, -2640, -2715, -2790, -2865, -2941,
+        -3017, -3094, -3170, -3247, -3325, -3402, -3480, -3558, -3637, -3715, -3794, -3873, -3953, -4033, -4113, -4193,
+        -4274, -4354, -4435, -4517, -4599, -4680, -4763, -4845, -4928, -5011, -5094, -5178, -5262, -5346, -5430, -5515,
+        -5600, -5685, -5771, -5856, -5942, -6029, -6115, -6202, -6289, -6377, -6465, -6553, -6641, -6729, -6818, -6907,
+        -6997, -7086, -7176, -7266, -7357, -7448, -7539, -7630, -7721, -7813, -7905, -7998, -8091, -8184, -8277, -8370,
+        -8464, -8558, -8653, -8747, -8842, -8937, -9033, -9129, -9225, -9321, -9418, -9514, -9612, -9709, -9807, -9905,
+        -10003, -10102, -10201, -10300, -10399, -10499, -10599, -10699, -10800, -10901, -11002, -11103, -11205, -11307, -11409, -11512,
+        -11615, -11718, -11821, -11925, -12029, -12134, -12238, -12343, -12448, -12554, -12660, -12766, -12873, -12979, -13086, -13194,
+        -13302, -13410, -13518, -13627, -13736, -13845, -13954, -14064, -14175, -14285, -14396, -14507, -14619, -14731, -14843, -14956,
+        -15068, -15182, -15295, -15409, -15524, -15638, -15753, -15868, -15983, -16098, -16214, -16329, -16445, -16561, -16677, -16793,
+        -16910, -17026, -17143, -17260, -17377, -17494, -17611, -17728, -17845,
+    },
+    { // 660 km
+        -502, -504, -511, -523, -539, -558, -582, -609, -638, -670, -705, -742, -780, -821, -863, -906,
+        -951, -997, -1044, -1095, -1147, -1200, -1256, -1313, -1371, -1431, -1492, -1554, -1618, -1682, -1747, -1814,
+        -1881, -1949, -2018, -2088, -2159, -2231, -2304, -2377, -2450, -2523, -2598, -2672, -2747, -2821, -2897, -2972,
+        -3048, -3125, -3201, -3278, -3355, -3432, -3510, -3588, -3666, -3745, -3824, -3903, -3982, -4062, -4142, -4222,
+        -4303, -4384, -4465, -4546, -4628, -4710, -4792, -4875, -4957, -5040, -5124, -5207, -5291, -5375, -5460, -5544,
+        -5629, -5715, -5800, -5886, -5972, -6058, -6145, -6232, -6319, -6407, -6494, -6582, -6671, -6759, -6848, -6937,
+        -7027, -7116, -7206, -7297, -7387, -7478, -7569, -7660, -7752, -7844, -7936, -8029, -8121, -8214, -8308, -8401,
+        -8495, -8589, -8684, -8778, -8873, -8969, -9064, -9160, -9256, -9352, -9449, -9546, -9643, -9741, -9839, -9937,
+        -10035, -10134, -10233, -10332, -10431, -10531, -10631, -10731, -10832, -10933, -11034, -11136, -11237, -11340, -11442, -11545,
+        -11648, -11751, -11854, -11958, -12062, -12167, -12271, -12376, -12482, -12587, -12693, -12800, -12906, -13013, -13120, -13228,
+        -13335, -13443, -13552, -13661, -13770, -13879, -13989, -14099, -14209, -14319, -14430, -14542, -14653, -14765, -14878, -14990,
+        -15103, -15216, -15330, -15444, -15558, -15673, -15788, -15903, -16018, -16133, -16249, -16364, -16480, -16596, -16712, -16828,
+        -16945, -17062, -17179, -17295, -17412, -17529, -17646, -17763, -17880,
+    },
+    { // 680 km
+        -526, -528, -535, -546, -562, -582, -605, -632, -661, -694, -728, -765, -804, -845, -888, -932,
+        -978, -1025, -1073, -1124, -1176, -1230, -1285, -1342, -1400, -1460, -1520, -1583, -1646, -1710, -1775, -1842,
+        -1909, -1977, -2047, -2117, -2188, -2259, -2332, -2404, -2477, -2551, -2624, -2698, -2773, -2848, -2923, -2998,
+        -3074, -3150, -3226, -3303, -3380, -3458, -3535, -3613, -3691, -3770, -3849, -3928, -4007, -4087, -4167, -4247,
+        -4328, -4409, -4490, -4571, -4653, -4735, -4817, -4900, -4982, -5065, -5149, -5232, -5316, -5401, -5485, -5570,
+        -5655, -5740, -5826, -5912, -5998, -6084, -6171, -6258, -6345, -6433, -6520, -6609, -6697, -6786, -6874, -6964,
+        -7053, -7143, -7233, -7323, -7414, -7505, -7596, -7687, -7779, -7871, -7963, -8056, -8149, -8242, -8335, -8429,
+        -8523, -8617, -8711, -8806, -8901, -8997, -9092, -9188, -9284, -9381, -9477, -9574, -9672, -9769, -9867, -9965,
+        -10064, -10162, -10261, -10361, -10460, -10560, -10660, -10761, -10861, -10962, -11064, -11165, -11267, -11369, -11472, -11574,
+        -11677, -11781, -11884, -11988, -12092, -12197, -12302, -12407, -12512, -12618, -12724, -12830, -12937, -13044, -13151, -13258,
+        -13366, -13474, -13583, -13692, -13801, -13910, -14020, -14130, -14240, -14351, -14462, -14573, -14685, -14797, -14909, -15022,
+        -15135, -15248, -15362, -15476, -15591, -15705, -15820, -15935, -16050, -16166, -16281, -16397, -16512, -16628, -16744, -16861,
+        -16977, -17094, -17211, -17328, -17445, -17562, -17679, -17795, -17912,
+    },
+    { // 700 km
+        -550, -552, -559, -570, -586, -605, -628, -655, -685, -717, -752, -789, -828, -869, -912, -957,
+        -1003, -1051, -1100, -1151, -1203, -1257, -1313, -1369, -1428, -1487, -1548, -1610, -1674, -1738, -1803, -1870,
+        -1937, -2005, -2075, -2145, -2216, -2287, -2359, -2431, -2504, -2577, -2650, -2724, -2798, -2873, -2948, -3023,
+        -3099, -3175, -3251, -3328, -3405, -3482, -3560, -3637, -3716, -3794, -3873, -3952, -4031, -4111, -4191, -4271,
+        -4352, -4433, -4514, -4595, -4677, -4759, -4841, -4924, -5007, -5090, -5173, -5257, -5341, -5425, -5510, -5595,
+        -5680, -5765, -5851, -5937, -6023, -6109, -6196, -6283, -6371, -6458, -6546, -6634, -6723, -6811, -6900, -6990,
+        -7079, -7169, -7259, -7350, -7440, -7531, -7622, -7714, -7806, -7898, -7990, -8083, -8176, -8269, -8362, -8456,
+        -8550, -8644, -8739, -8834, -8929, -9024, -9120, -9216, -9312, -9409, -9505, -9602, -9700, -9797, -9895, -9994,
+        -10092, -10191, -10290, -10389, -10489, -10589, -10689, -10790, -10890, -10991, -11093, -11194, -11296, -11398, -11501, -11604,
+        -11707, -11810, -11914, -12018, -12122, -12227, -12332, -12437, -12542, -12648, -12754, -12860, -12967, -13074, -13181, -13289,
+        -13397, -13505, -13614, -13722, -13832, -13941, -14051, -14161, -14271, -14382, -14493, -14605, -14717, -14829, -14941, -15054,
+        -15167, -15280, -15394, -15508, -15623, -15737, -15852, -15967, -16082, -16198, -16313, -16429, -16544, -16660, -16777, -16893,
+        -17010, -17126, -17243, -17360, -17477, -17594, -17711, -17828, -17944,
+    },
+};
+
+} // namespace TravelTimeTables
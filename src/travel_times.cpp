@@ -0,0 +1,67 @@
+#include "travel_times.hpp"
+#include "travel_time_tables.hpp"
+
+#include <QtCore/QtGlobal>
+#include <cmath>
+
+namespace {
+
+const double EARTH_RADIUS_KM = 6371.0;
+const double KM_PER_DEGREE = M_PI * EARTH_RADIUS_KM / 180.0;
+
+} // namespace
+
+
+double TravelTimes::travelTime(Phase phase, double epicentralKm, double depthKm)
+{
+    using namespace TravelTimeTables;
+
+    const auto &table = phase == Phase::P ? P_RESIDUAL : S_RESIDUAL;
+    const double referenceSpeed = phase == Phase::P ? P_REFERENCE_SPEED_KM_S : S_REFERENCE_SPEED_KM_S;
+
+    epicentralKm = qMax(0.0, epicentralKm);
+    depthKm = qBound(0.0, depthKm, (DEPTH_COUNT - 1) * DEPTH_STEP_KM);
+
+    // Past the last column the fractional part exceeds 1 and extrapolates
+    const double x = epicentralKm / KM_PER_DEGREE / DISTANCE_STEP_DEG;
+    const double y = depthKm / DEPTH_STEP_KM;
+    const int column = qMin(static_cast<int>(x), DISTANCE_COUNT - 2);
+    const int row = qMin(static_cast<int>(y), DEPTH_COUNT - 2);
+    const double fx = x - column;
+    const double fy = y - row;
+
+    const double shallow = table[row][column] + fx * (table[row][column + 1] - table[row][column]);
+    const double deep = table[row + 1][column] + fx * (table[row + 1][column + 1] - table[row + 1][column]);
+    const double residual = (shallow + fy * (deep - shallow)) * RESIDUAL_SCALE_S;
+
+    return residual + std::hypot(epicentralKm, depthKm) / referenceSpeed;
+}
+
+double TravelTimes::sMinusP(double epicentralKm, double depthKm)
+{
+    return travelTime(Phase::S, epicentralKm, depthKm) - travelTime(Phase::P, epicentralKm, depthKm);
+}
+
+double TravelTimes::distanceReached(Phase phase, double elapsedSeconds, double depthKm)
+{
+    if (elapsedSeconds <= travelTime(phase, 0.0, depthKm)) return 0.0;
+
+    // Travel time grows with distance, so bisect out to the antipode
+    double near = 0.0;
+    double far = M_PI * EARTH_RADIUS_KM;
+    if (elapsedSeconds >= travelTime(phase, far, depthKm)) return far;
+    for (int i = 0; i < 40; ++i) {
+        const double middle = (near + far) / 2.0;
+        if (travelTime(phase, middle, depthKm) < elapsedSeconds) {
+            near = middle;
+        } else {
+            far = middle;
+        }
+    }
+    return (near + far) / 2.0;
+}
+
+double TravelTimes::maxTabulatedDistanceKm()
+{
+    return (TravelTimeTables::DISTANCE_COUNT - 1) * TravelTimeTables::DISTANCE_STEP_DEG * KM_PER_DEGREE;
+}
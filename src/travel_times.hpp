@@ -0,0 +1,23 @@
+#pragma once
+
+
+// First-arrival P and S travel times for the iasp91 Earth model, from the
+// tables in travel_time_tables.hpp. A lookup is a bilinear interpolation
+// over source depth and epicentral distance plus one square root, so it is
+// cheap enough to run per event and per refresh tick. Distances past the
+// table (100 degrees) are extrapolated along the diffracted phase; depths
+// are clamped to 0-700 km.
+class TravelTimes
+{
+public:
+    enum class Phase { P, S };
+
+    // Seconds from origin time to the first arrival
+    static double travelTime(Phase phase, double epicentralKm, double depthKm);
+    static double sMinusP(double epicentralKm, double depthKm);
+    // Epicentral distance the first arrival has reached elapsedSeconds after
+    // origin time, the inverse of travelTime; 0 until it reaches the surface
+    static double distanceReached(Phase phase, double elapsedSeconds, double depthKm);
+
+    static double maxTabulatedDistanceKm();
+};
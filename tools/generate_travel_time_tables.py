@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""Generates src/travel_time_tables.hpp: first-arrival P and S travel times
+for the iasp91 Earth model (Kennett & Engdahl, 1991).
+
+Rays are traced through 1 km spherical shells of constant velocity, where
+each leg is a straight line with impact parameter b = p * v. Times are the
+minimum over the upgoing and downgoing branches at each tabulated distance;
+beyond the core shadow the grazing ray is continued at its slowness, which
+approximates the diffracted phase.
+
+Usage: tools/generate_travel_time_tables.py > src/travel_time_tables.hpp
+"""
+
+import math
+
+EARTH_RADIUS_KM = 6371.0
+CMB_DEPTH_KM = 2889
+DISTANCE_STEP_DEG = 0.5
+DISTANCE_COUNT = 201  # 0 to 100 degrees
+DEPTH_STEP_KM = 20
+DEPTH_COUNT = 36      # 0 to 700 km
+RAY_COUNT = 6000
+# Smooth reference subtracted before storing, so bilinear interpolation does
+# not have to follow the near-source hyperbola (SpatialUtils wave speeds)
+REFERENCE_SPEED_KM_S = {"P": 6.0, "S": 3.5}
+
+
+def iasp91(depth):
+    """(vp, vs) in km/s at a depth in km within the mantle and crust."""
+    x = (EARTH_RADIUS_KM - depth) / EARTH_RADIUS_KM
+    if depth < 20:
+        return 5.80, 3.36
+    if depth < 35:
+        return 6.50, 3.75
+    if depth < 120:
+        return 8.78541 - 0.74953 * x, 6.706231 - 2.248585 * x
+    if depth < 210:
+        return 25.41389 - 17.69722 * x, 5.75020 - 1.27420 * x
+    if depth < 410:
+        return 30.78765 - 23.25415 * x, 15.24213 - 11.08552 * x
+    if depth < 660:
+        return 29.38896 - 21.40656 * x, 17.70732 - 13.50652 * x
+    if depth < 760:
+        return 25.96984 - 16.93412 * x, 20.76890 - 16.53147 * x
+    if depth < 2740:
+        return (25.1486 - 41.1538 * x + 51.9932 * x * x - 26.6083 * x ** 3,
+                12.9303 - 21.2590 * x + 27.8988 * x * x - 14.1080 * x ** 3)
+    return 14.49470 - 1.47089 * x, 8.16616 - 1.58206 * x
+
+
+def trace(phase):
+    """Per depth node, (upgoing, downgoing) lists of (distance deg, time s)."""
+    speeds = [iasp91(k + 0.5)[0 if phase == "P" else 1] for k in range(CMB_DEPTH_KM)]
+    max_p = EARTH_RADIUS_KM / speeds[0]
+    up = [[] for _ in range(DEPTH_COUNT)]
+    down = [[] for _ in range(DEPTH_COUNT)]
+
+    for i in range(RAY_COUNT + 1):
+        p = max_p * i / RAY_COUNT
+        theta = 0.0
+        time = 0.0
+        at_node = [None] * DEPTH_COUNT
+        turned = None
+        for k in range(CMB_DEPTH_KM):
+            if k % DEPTH_STEP_KM == 0 and k // DEPTH_STEP_KM < DEPTH_COUNT:
+                at_node[k // DEPTH_STEP_KM] = (theta, time, k)
+            r_top = EARTH_RADIUS_KM - k
+            r_bottom = r_top - 1.0
+            v = speeds[k]
+            b = p * v
+            if b >= r_top:
+                turned = (theta, time, k)
+                break
+            top = math.sqrt(r_top * r_top - b * b)
+            if b > r_bottom:
+                theta += math.acos(b / r_top)
+                time += top / v
+                turned = (theta, time, k + 1)
+                break
+            theta += math.acos(b / r_top) - math.acos(b / r_bottom)
+            time += (top - math.sqrt(r_bottom * r_bottom - b * b)) / v
+
+        for n, node in enumerate(at_node):
+            if node is None:
+                continue
+            up[n].append((math.degrees(node[0]), node[1]))
+            if turned is not None and turned[2] > node[2]:
+                down[n].append((math.degrees(2 * turned[0] - node[0]), 2 * turned[1] - node[1], p))
+
+    return up, down
+
+
+def first_arrivals(up, down):
+    # One curve by takeoff angle: straight up, horizontal, straight down
+    rays = up + down[::-1]
+    times = [math.inf] * DISTANCE_COUNT
+    for (d0, t0, *_), (d1, t1, *_) in zip(rays, rays[1:]):
+        lo, hi = min(d0, d1), max(d0, d1)
+        first = math.ceil(lo / DISTANCE_STEP_DEG)
+        last = min(DISTANCE_COUNT - 1, math.floor(hi / DISTANCE_STEP_DEG))
+        for j in range(first, last + 1):
+            d = j * DISTANCE_STEP_DEG
+            t = t0 if hi == lo else t0 + (t1 - t0) * (d - d0) / (d1 - d0)
+            times[j] = min(times[j], t)
+
+    # Past the core shadow: continue the grazing ray at its slowness
+    if down:
+        grazing = max(down, key=lambda ray: ray[0])
+        slowness = grazing[2] * math.pi / 180.0  # s/deg
+        for j in range(DISTANCE_COUNT):
+            d = j * DISTANCE_STEP_DEG
+            if d > grazing[0]:
+                times[j] = min(times[j], grazing[1] + slowness * (d - grazing[0]))
+    return times
+
+
+def table(phase):
+    up, down = trace(phase)
+    rows = []
+    for n in range(DEPTH_COUNT):
+        depth = n * DEPTH_STEP_KM
+        times = first_arrivals(up[n], down[n])
+        row = []
+        for j, t in enumerate(times):
+            km = math.radians(j * DISTANCE_STEP_DEG) * EARTH_RADIUS_KM
+            reference = math.hypot(km, depth) / REFERENCE_SPEED_KM_S[phase]
+            row.append(round((t - reference) * 10))
+        rows.append(row)
+    return rows
+
+
+def emit(name, rows):
+    print(f"inline constexpr std::int16_t {name}[DEPTH_COUNT][DISTANCE_COUNT] = {{")
+    for n, row in enumerate(rows):
+        print(f"    {{ // {n * DEPTH_STEP_KM} km")
+        for start in range(0, len(row), 16):
+            print("        " + ", ".join(str(v) for v in row[start:start + 16]) + ",")
+        print("    },")
+    print("};")
+
+
+def main():
+    print("""#pragma once
+
+// Generated by tools/generate_travel_time_tables.py; do not edit.
+//
+// First-arrival P and S travel times for the iasp91 Earth model, by source
+// depth (rows) and epicentral distance (columns). Each entry is the travel
+// time minus the straight hypocentral distance over the reference speed,
+// in tenths of a second.
+
+#include <cstdint>
+
+namespace TravelTimeTables {
+""")
+    print(f"inline constexpr int DISTANCE_COUNT = {DISTANCE_COUNT};")
+    print(f"inline constexpr double DISTANCE_STEP_DEG = {DISTANCE_STEP_DEG};")
+    print(f"inline constexpr int DEPTH_COUNT = {DEPTH_COUNT};")
+    print(f"inline constexpr double DEPTH_STEP_KM = {float(DEPTH_STEP_KM)};")
+    print(f"inline constexpr double P_REFERENCE_SPEED_KM_S = {REFERENCE_SPEED_KM_S['P']};")
+    print(f"inline constexpr double S_REFERENCE_SPEED_KM_S = {REFERENCE_SPEED_KM_S['S']};")
+    print(f"inline constexpr double RESIDUAL_SCALE_S = 0.1;")
+    print()
+    emit("P_RESIDUAL", table("P"))
+    print()
+    emit("S_RESIDUAL", table("S"))
+    print()
+    print("} // namespace TravelTimeTables")
+
+
+if __name__ == "__main__":
+    main()